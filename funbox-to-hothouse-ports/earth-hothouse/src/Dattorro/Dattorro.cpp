@@ -1,6 +1,9 @@
 #include "Dattorro.hpp"
+#include "DattorroMemory.hpp"
 #include <algorithm>
 
+#include "hothouse_tcm.h"
+
 // float scale(float a, float inMin, float inMax, float outMin, float outMax) {
 //     return (a - inMin)/(inMax - inMin) * (outMax - outMin) + outMin;
 // }
@@ -40,55 +43,65 @@ Dattorro1997Tank::Dattorro1997Tank(const float initSampleRate,
     lfo2.setRevPoint(0.5);
     lfo3.setRevPoint(0.5);
     lfo4.setRevPoint(0.5);
+
+    // The first update ramps from the LFOs' starting values
+    setModRateDivisor(EARTH_REVERB_MOD_DIVISOR);
+    if (modRateDivisor > 1) {
+        lfoValues[0] = lfo1.process();
+        lfoValues[1] = lfo2.process();
+        lfoValues[2] = lfo3.process();
+        lfoValues[3] = lfo4.process();
+    }
 }
 
-void Dattorro1997Tank::process(const float leftIn, const float rightIn,
+HOTHOUSE_ITCM void Dattorro1997Tank::process(const float leftIn, const float rightIn,
                                float* leftOut, float* rightOut) {
     tickApfModulation();
 
     //decay = frozen ? 1. : decayParam;
     decay = decayParam;
 
+    // The two halves only meet in the cross-feedback sums below, so they
+    // advance stage by stage in lockstep: each left/right pair is
+    // independent work the M7 can dual-issue.
     leftSum += leftIn;
     rightSum += rightIn;
 
     leftApf1.input = leftSum;
-    leftDelay1.input = leftApf1.process();
-    leftDelay1.process();
-    leftHighCutFilter.input = leftDelay1.output;
-    leftLowCutFilter.input = leftHighCutFilter.process();
-    leftApf2.input = (leftDelay1.output * (1. - fade) + leftLowCutFilter.process() * fade) * decay;
-    leftDelay2.input = leftApf2.process();
-    leftDelay2.process();
-
     rightApf1.input = rightSum;
+    leftDelay1.input = leftApf1.process();
     rightDelay1.input = rightApf1.process();
+    leftDelay1.process();
     rightDelay1.process();
+    leftHighCutFilter.input = leftDelay1.output;
     rightHighCutFilter.input = rightDelay1.output;
+    leftLowCutFilter.input = leftHighCutFilter.process();
     rightLowCutFilter.input =  rightHighCutFilter.process();
+    leftApf2.input = (leftDelay1.output * (1. - fade) + leftLowCutFilter.process() * fade) * decay;
     rightApf2.input = (rightDelay1.output * (1. - fade) + rightLowCutFilter.process() * fade) * decay;
+    leftDelay2.input = leftApf2.process();
     rightDelay2.input = rightApf2.process();
+    leftDelay2.process();
     rightDelay2.process();
 
     rightSum = leftDelay2.output * decay;
     leftSum = rightDelay2.output * decay;
 
     leftOutDCBlock.input = leftApf1.output;
-    leftOutDCBlock.input += leftDelay1.tap(scaledOutputTaps[L_DELAY_1_L_TAP_1]);
-    leftOutDCBlock.input += leftDelay1.tap(scaledOutputTaps[L_DELAY_1_L_TAP_2]);
-    leftOutDCBlock.input -= leftApf2.delay.tap(scaledOutputTaps[L_APF_2_L_TAP]);
-    leftOutDCBlock.input += leftDelay2.tap(scaledOutputTaps[L_DELAY_2_L_TAP]);
-    leftOutDCBlock.input -= rightDelay1.tap(scaledOutputTaps[R_DELAY_1_L_TAP]);
-    leftOutDCBlock.input -= rightApf2.delay.tap(scaledOutputTaps[R_APF_2_L_TAP]);
-    leftOutDCBlock.input -= rightDelay2.tap(scaledOutputTaps[R_DELAY_2_L_TAP]);
-
     rightOutDCBlock.input = rightApf1.output;
+    leftOutDCBlock.input += leftDelay1.tap(scaledOutputTaps[L_DELAY_1_L_TAP_1]);
     rightOutDCBlock.input += rightDelay1.tap(scaledOutputTaps[R_DELAY_1_R_TAP_1]);
+    leftOutDCBlock.input += leftDelay1.tap(scaledOutputTaps[L_DELAY_1_L_TAP_2]);
     rightOutDCBlock.input += rightDelay1.tap(scaledOutputTaps[R_DELAY_1_R_TAP_2]);
+    leftOutDCBlock.input -= leftApf2.delay.tap(scaledOutputTaps[L_APF_2_L_TAP]);
     rightOutDCBlock.input -= rightApf2.delay.tap(scaledOutputTaps[R_APF_2_R_TAP]);
+    leftOutDCBlock.input += leftDelay2.tap(scaledOutputTaps[L_DELAY_2_L_TAP]);
     rightOutDCBlock.input += rightDelay2.tap(scaledOutputTaps[R_DELAY_2_R_TAP]);
+    leftOutDCBlock.input -= rightDelay1.tap(scaledOutputTaps[R_DELAY_1_L_TAP]);
     rightOutDCBlock.input -= leftDelay1.tap(scaledOutputTaps[L_DELAY_1_R_TAP]);
+    leftOutDCBlock.input -= rightApf2.delay.tap(scaledOutputTaps[R_APF_2_L_TAP]);
     rightOutDCBlock.input -= leftApf2.delay.tap(scaledOutputTaps[L_APF_2_R_TAP]);
+    leftOutDCBlock.input -= rightDelay2.tap(scaledOutputTaps[R_DELAY_2_L_TAP]);
     rightOutDCBlock.input -= leftDelay2.tap(scaledOutputTaps[L_DELAY_2_R_TAP]);
 
     *leftOut = leftOutDCBlock.process() * 0.5;
@@ -122,6 +135,9 @@ void Dattorro1997Tank::setSampleRate(const float newSampleRate) {
     rightOutDCBlock.setSampleRate(sampleRate);
 
     rescaleTapTimes();
+    for (int i = 0; i < kNumTimeScales; ++i) {
+        timeScaleTable[i] = scaleTimes(kTimeScales[i]);
+    }
     setTimeScale(timeScale);
     initialiseDelaysAndApfs();
     //clear();
@@ -136,6 +152,24 @@ void Dattorro1997Tank::setTimeScale(const float newTimeScale) {
     rescaleApfAndDelayTimes();
 }
 
+// A precomputed time scale, faded in: every line crossfades from its old
+// delay time to the new one over timeScaleFadeTime rather than jumping.
+void Dattorro1997Tank::selectTimeScale(const int index) {
+    const int fadeSamples = (int)(timeScaleFadeTime * sampleRate);
+    timeScale = kTimeScales[index];
+
+    leftApf1.delay.crossfade(fadeSamples);
+    leftDelay1.crossfade(fadeSamples);
+    leftApf2.delay.crossfade(fadeSamples);
+    leftDelay2.crossfade(fadeSamples);
+    rightApf1.delay.crossfade(fadeSamples);
+    rightDelay1.crossfade(fadeSamples);
+    rightApf2.delay.crossfade(fadeSamples);
+    rightDelay2.crossfade(fadeSamples);
+
+    applyScaledTimes(timeScaleTable[index]);
+}
+
 #pragma GCC pop_options
 
 void Dattorro1997Tank::setDecay(const float newDecay) {
@@ -162,6 +196,19 @@ void Dattorro1997Tank::setModShape(const float shape) {
     lfo4.setRevPoint(shape);
 }
 
+// The LFOs step once per update, so they run at 1/divisor of their rate.
+// The values carry over, and the next update ramps on from them.
+void Dattorro1997Tank::setModRateDivisor(const int divisor) {
+    modRateDivisor = divisor < 1 ? 1 : divisor;
+    modCountdown = 0;
+
+    const float lfoRate = lfoSampleRate / modRateDivisor;
+    lfo1.setSamplerate(lfoRate);
+    lfo2.setSamplerate(lfoRate);
+    lfo3.setSamplerate(lfoRate);
+    lfo4.setSamplerate(lfoRate);
+}
+
 void Dattorro1997Tank::setHighCutFrequency(const float frequency) {
     leftHighCutFilter.setCutoffFreq(frequency);
     rightHighCutFilter.setCutoffFreq(frequency);
@@ -214,6 +261,28 @@ void Dattorro1997Tank::clear() {
     rightSum = 0.;
 }
 
+void Dattorro1997Tank::clearInBackground(clevelandmusicco::MdmaTransfer* clearing) {
+    // The long SDRAM lines first, while channels are free
+    leftDelay1.clearInBackground(clearing[0]);
+    rightDelay1.clearInBackground(clearing[1]);
+    leftDelay2.clearInBackground(clearing[2]);
+    rightDelay2.clearInBackground(clearing[3]);
+    leftApf1.clearInBackground(clearing[4]);
+    rightApf1.clearInBackground(clearing[5]);
+    leftApf2.clearInBackground(clearing[6]);
+    rightApf2.clearInBackground(clearing[7]);
+
+    leftHighCutFilter.clear();
+    leftLowCutFilter.clear();
+    rightHighCutFilter.clear();
+    rightLowCutFilter.clear();
+    leftOutDCBlock.clear();
+    rightOutDCBlock.clear();
+
+    leftSum = 0.;
+    rightSum = 0.;
+}
+
 int maxScaledOutputTap = 0;
 
 inline int Dattorro1997Tank::calcMaxTime(float delayTime) {
@@ -241,21 +310,50 @@ void Dattorro1997Tank::initialiseDelaysAndApfs() {
     const int kRightApf2MaxTime = calcMaxTime(rightApf2Time);
     const int kRightDelay2MaxTime = calcMaxTime(rightDelay2Time);
 
-    leftApf1 = AllpassFilter(kLeftApf1MaxTime);
-    leftDelay1 = InterpDelay(kLeftDelay1MaxTime);
-    leftApf2 = AllpassFilter(kLeftApf2MaxTime);
-    leftDelay2 = InterpDelay(kLeftDelay2MaxTime);
-    rightApf1 = AllpassFilter(kRightApf1MaxTime);
-    rightDelay1 = InterpDelay(kRightDelay1MaxTime);
-    rightApf2 = AllpassFilter(kRightApf2MaxTime);
-    rightDelay2 = InterpDelay(kRightDelay2MaxTime);
+    leftApf1 = ModulatedAllpass(DattorroMemory::leftApf1, DattorroMemory::fit(kLeftApf1MaxTime, DattorroMemory::leftApf1));
+    leftDelay1 = FixedDelay(DattorroMemory::leftDelay1, DattorroMemory::fit(kLeftDelay1MaxTime, DattorroMemory::leftDelay1));
+    leftApf2 = ModulatedAllpass(DattorroMemory::leftApf2, DattorroMemory::fit(kLeftApf2MaxTime, DattorroMemory::leftApf2));
+    leftDelay2 = FixedDelay(DattorroMemory::leftDelay2, DattorroMemory::fit(kLeftDelay2MaxTime, DattorroMemory::leftDelay2));
+    rightApf1 = ModulatedAllpass(DattorroMemory::rightApf1, DattorroMemory::fit(kRightApf1MaxTime, DattorroMemory::rightApf1));
+    rightDelay1 = FixedDelay(DattorroMemory::rightDelay1, DattorroMemory::fit(kRightDelay1MaxTime, DattorroMemory::rightDelay1));
+    rightApf2 = ModulatedAllpass(DattorroMemory::rightApf2, DattorroMemory::fit(kRightApf2MaxTime, DattorroMemory::rightApf2));
+    rightDelay2 = FixedDelay(DattorroMemory::rightDelay2, DattorroMemory::fit(kRightDelay2MaxTime, DattorroMemory::rightDelay2));
 }
 
 void Dattorro1997Tank::tickApfModulation() {
-    leftApf1.delay.setDelayTime(lfo1.process() * lfoExcursion + scaledLeftApf1Time);
-    leftApf2.delay.setDelayTime(lfo2.process() * lfoExcursion + scaledLeftApf2Time);
-    rightApf1.delay.setDelayTime(lfo3.process() * lfoExcursion + scaledRightApf1Time);
-    rightApf2.delay.setDelayTime(lfo4.process() * lfoExcursion + scaledRightApf2Time);
+    if (modRateDivisor == 1) {
+        const double lfo1Value = lfo1.process();
+        const double lfo2Value = lfo2.process();
+        const double lfo3Value = lfo3.process();
+        const double lfo4Value = lfo4.process();
+        leftApf1.delay.setDelayTime(lfo1Value * lfoExcursion + scaledLeftApf1Time);
+        leftApf2.delay.setDelayTime(lfo2Value * lfoExcursion + scaledLeftApf2Time);
+        rightApf1.delay.setDelayTime(lfo3Value * lfoExcursion + scaledRightApf1Time);
+        rightApf2.delay.setDelayTime(lfo4Value * lfoExcursion + scaledRightApf2Time);
+        lfoValues[0] = lfo1Value;
+        lfoValues[1] = lfo2Value;
+        lfoValues[2] = lfo3Value;
+        lfoValues[3] = lfo4Value;
+        return;
+    }
+
+    if (modCountdown == 0) {
+        modCountdown = modRateDivisor;
+        const float perSample = 1.0f / modRateDivisor;
+        lfoSteps[0] = ((float)lfo1.process() - lfoValues[0]) * perSample;
+        lfoSteps[1] = ((float)lfo2.process() - lfoValues[1]) * perSample;
+        lfoSteps[2] = ((float)lfo3.process() - lfoValues[2]) * perSample;
+        lfoSteps[3] = ((float)lfo4.process() - lfoValues[3]) * perSample;
+    }
+    --modCountdown;
+
+    leftApf1.delay.setDelayTime(lfoValues[0] * lfoExcursion + scaledLeftApf1Time);
+    leftApf2.delay.setDelayTime(lfoValues[1] * lfoExcursion + scaledLeftApf2Time);
+    rightApf1.delay.setDelayTime(lfoValues[2] * lfoExcursion + scaledRightApf1Time);
+    rightApf2.delay.setDelayTime(lfoValues[3] * lfoExcursion + scaledRightApf2Time);
+    for (int i = 0; i < 4; ++i) {
+        lfoValues[i] += lfoSteps[i];
+    }
 }
 
 float scaleFactor = 0.;
@@ -265,17 +363,35 @@ float scaleFactor = 0.;
 #pragma GCC optimize ("Ofast")
 
 void Dattorro1997Tank::rescaleApfAndDelayTimes() {
-    scaleFactor = timeScale * sampleRateScale;
+    applyScaledTimes(scaleTimes(timeScale));
+}
+
+Dattorro1997Tank::ScaledTimes Dattorro1997Tank::scaleTimes(const float scale) {
+    scaleFactor = scale * sampleRateScale;
 
-    scaledLeftApf1Time = leftApf1Time * scaleFactor;
-    scaledLeftDelay1Time = leftDelay1Time * scaleFactor;
-    scaledLeftApf2Time = leftApf2Time * scaleFactor;
-    scaledLeftDelay2Time = leftDelay2Time * scaleFactor;
+    ScaledTimes times;
+    times.leftApf1 = leftApf1Time * scaleFactor;
+    times.leftDelay1 = leftDelay1Time * scaleFactor;
+    times.leftApf2 = leftApf2Time * scaleFactor;
+    times.leftDelay2 = leftDelay2Time * scaleFactor;
 
-    scaledRightApf1Time = rightApf1Time * scaleFactor;
-    scaledRightDelay1Time = rightDelay1Time * scaleFactor;
-    scaledRightApf2Time = rightApf2Time * scaleFactor;
-    scaledRightDelay2Time = rightDelay2Time * scaleFactor;
+    times.rightApf1 = rightApf1Time * scaleFactor;
+    times.rightDelay1 = rightDelay1Time * scaleFactor;
+    times.rightApf2 = rightApf2Time * scaleFactor;
+    times.rightDelay2 = rightDelay2Time * scaleFactor;
+    return times;
+}
+
+void Dattorro1997Tank::applyScaledTimes(const ScaledTimes& times) {
+    scaledLeftApf1Time = times.leftApf1;
+    scaledLeftDelay1Time = times.leftDelay1;
+    scaledLeftApf2Time = times.leftApf2;
+    scaledLeftDelay2Time = times.leftDelay2;
+
+    scaledRightApf1Time = times.rightApf1;
+    scaledRightDelay1Time = times.rightDelay1;
+    scaledRightApf2Time = times.rightApf2;
+    scaledRightDelay2Time = times.rightDelay2;
 
     leftDelay1.setDelayTime(scaledLeftDelay1Time);
     leftDelay2.setDelayTime(scaledLeftDelay2Time);
@@ -300,7 +416,7 @@ Dattorro::Dattorro(const float initMaxSampleRate,
     dattorroScaleFactor = sampleRate / dattorroSampleRate;
 
     //preDelay = InterpDelay(192010, 0.);
-    preDelay = InterpDelay(37000, 0.);
+    preDelay = InterpDelay<>(DattorroMemory::preDelay, DattorroMemory::kPreDelayLength, 0.);
     // // 22000 goes outside the range fo the linear function.
     // // inputLpf = OnePoleLPFilter(22000.0);
     // inputLpf = OnePoleLPFilter(-1.);
@@ -309,10 +425,14 @@ Dattorro::Dattorro(const float initMaxSampleRate,
     inputLpf = OnePoleLPFilter(22000.0);
     inputHpf = OnePoleHPFilter(0.0);
 
-    inApf1 = AllpassFilter(dattorroScale(8 * kInApf1Time), dattorroScale(kInApf1Time), inputDiffusion1);
-    inApf2 = AllpassFilter(dattorroScale(8 * kInApf2Time), dattorroScale(kInApf2Time), inputDiffusion1);
-    inApf3 = AllpassFilter(dattorroScale(8 * kInApf3Time), dattorroScale(kInApf3Time), inputDiffusion2);
-    inApf4 = AllpassFilter(dattorroScale(8 * kInApf4Time), dattorroScale(kInApf4Time), inputDiffusion2);
+    inApf1 = FixedAllpass(DattorroMemory::inApf1, DattorroMemory::fit(dattorroScale(8 * kInApf1Time), DattorroMemory::inApf1),
+                           dattorroScale(kInApf1Time), inputDiffusion1);
+    inApf2 = FixedAllpass(DattorroMemory::inApf2, DattorroMemory::fit(dattorroScale(8 * kInApf2Time), DattorroMemory::inApf2),
+                           dattorroScale(kInApf2Time), inputDiffusion1);
+    inApf3 = FixedAllpass(DattorroMemory::inApf3, DattorroMemory::fit(dattorroScale(8 * kInApf3Time), DattorroMemory::inApf3),
+                           dattorroScale(kInApf3Time), inputDiffusion2);
+    inApf4 = FixedAllpass(DattorroMemory::inApf4, DattorroMemory::fit(dattorroScale(8 * kInApf4Time), DattorroMemory::inApf4),
+                           dattorroScale(kInApf4Time), inputDiffusion2);
 
     // // leftInputDCBlock.setCutoffFreq(20.0);
     // // rightInputDCBlock.setCutoffFreq(20.0);
@@ -350,7 +470,139 @@ void Dattorro::process(float leftInput, float rightInput) {
     tank.process(tankFeed, tankFeed, &leftOut, &rightOut);
 }
 
+// process() for a block of samples. The input filters only depend on the
+// input, so each runs over the whole block with its state in registers,
+// and their cutoffs are set once per block rather than per sample. The
+// pre-delay ramps linearly to the last setPreDelay() across the block, so
+// control-rate updates of it don't step.
+HOTHOUSE_ITCM void Dattorro::processBlock(const float* leftInput, const float* rightInput,
+                            float* leftOutput, float* rightOutput, size_t size) {
+    inputLpf.setCutoffFreq(inputHighCut);
+    inputHpf.setCutoffFreq(inputLowCut);
+
+    const float preDelayStep = size > 0 ? (preDelayTarget - preDelaySamples) / size : 0.0f;
+
+    while (size > 0) {
+        const size_t n = size < kMaxBlockSize ? size : kMaxBlockSize;
+
+        // leftOutput holds the right input's DC block output until the
+        // tank overwrites it
+        float* rightBlock = leftOutput;
+        std::copy(leftInput, leftInput + n, blockBuffer);
+        std::copy(rightInput, rightInput + n, rightBlock);
+        leftInputDCBlock.processBlock(blockBuffer, n);
+        rightInputDCBlock.processBlock(rightBlock, n);
+        for (size_t i = 0; i < n; ++i) {
+            blockBuffer[i] += rightBlock[i];
+        }
+        processInputBlock(leftOutput, rightOutput, n, preDelayStep);
+
+        leftInput += n;
+        rightInput += n;
+        leftOutput += n;
+        rightOutput += n;
+        size -= n;
+    }
+    preDelaySamples = preDelayTarget;
+}
+
+// processBlock() with the same signal on both inputs: one DC blocker,
+// doubled, in place of two that would hold the same state. The right one
+// is kept in step so processBlock() can take over at any time.
+HOTHOUSE_ITCM void Dattorro::processMonoBlock(const float* input, float* leftOutput,
+                                float* rightOutput, size_t size) {
+    inputLpf.setCutoffFreq(inputHighCut);
+    inputHpf.setCutoffFreq(inputLowCut);
+
+    const float preDelayStep = size > 0 ? (preDelayTarget - preDelaySamples) / size : 0.0f;
+
+    while (size > 0) {
+        const size_t n = size < kMaxBlockSize ? size : kMaxBlockSize;
+
+        std::copy(input, input + n, blockBuffer);
+        leftInputDCBlock.processBlock(blockBuffer, n);
+        for (size_t i = 0; i < n; ++i) {
+            blockBuffer[i] += blockBuffer[i];
+        }
+        processInputBlock(leftOutput, rightOutput, n, preDelayStep);
+
+        input += n;
+        leftOutput += n;
+        rightOutput += n;
+        size -= n;
+    }
+    rightInputDCBlock = leftInputDCBlock;
+    preDelaySamples = preDelayTarget;
+}
+
+// The summed, DC blocked input in blockBuffer (at most kMaxBlockSize
+// samples) through the input filters, pre-delay, diffusers and tank
+inline void Dattorro::processInputBlock(float* leftOutput, float* rightOutput,
+                                        size_t n, float preDelayStep) {
+    inputLpf.processBlock(blockBuffer, n);
+    inputHpf.processBlock(blockBuffer, n);
+
+    for (size_t i = 0; i < n; ++i) {
+        preDelaySamples += preDelayStep;
+        preDelay.setDelayTime(preDelaySamples);
+        preDelay.input = blockBuffer[i];
+        preDelay.process();
+        inApf1.input = preDelay.output;
+        inApf2.input = inApf1.process();
+        inApf3.input = inApf2.process();
+        inApf4.input = inApf3.process();
+        tankFeed = preDelay.output * (1. - diffuseInput) + inApf4.process() * diffuseInput;
+        tankFeedGain = fmaxf(tankFeedGain - tankFeedStep, 0.0f);
+        tankFeed *= tankFeedGain;
+
+        tank.process(tankFeed, tankFeed, &leftOutput[i], &rightOutput[i]);
+    }
+
+    leftOut = leftOutput[n - 1];
+    rightOut = rightOutput[n - 1];
+}
+
+HOTHOUSE_ITCM void Dattorro::processTankBlock(float* leftOutput, float* rightOutput, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        tank.process(0., 0., &leftOutput[i], &rightOutput[i]);
+    }
+    if (size > 0) {
+        leftOut = leftOutput[size - 1];
+        rightOut = rightOutput[size - 1];
+    }
+    tankFeed = 0.;
+    preDelaySamples = preDelayTarget;
+}
+
 void Dattorro::clear() {
+    clearInput();
+    tank.clear();
+}
+
+void Dattorro::clearInBackground() {
+    tank.clearInBackground(clearing);
+    clevelandmusicco::MdmaTransfer* input = &clearing[Dattorro1997Tank::kLines];
+    preDelay.clearInBackground(input[0]);
+    inApf1.clearInBackground(input[1]);
+    inApf2.clearInBackground(input[2]);
+    inApf3.clearInBackground(input[3]);
+    inApf4.clearInBackground(input[4]);
+
+    leftInputDCBlock.clear();
+    rightInputDCBlock.clear();
+    inputLpf.clear();
+    inputHpf.clear();
+    tankFeedGain = 1.0;
+    tankFeedStep = 0.0;
+}
+
+void Dattorro::finishClear() {
+    for (auto& transfer : clearing) {
+        transfer.Wait();
+    }
+}
+
+void Dattorro::clearInput() {
     leftInputDCBlock.clear();
     rightInputDCBlock.clear();
 
@@ -361,8 +613,12 @@ void Dattorro::clear() {
     inApf2.clear();
     inApf3.clear();
     inApf4.clear();
+    tankFeedGain = 1.0;
+    tankFeedStep = 0.0;
+}
 
-    tank.clear();
+void Dattorro::fadeOutInput(size_t samples) {
+    tankFeedStep = samples > 0 ? tankFeedGain / samples : tankFeedGain;
 }
 
 #pragma GCC push_options
@@ -378,12 +634,17 @@ void Dattorro::setTimeScale(float timeScale) {
     tank.setTimeScale(timeScale);
 }
 
+void Dattorro::selectTimeScale(int index) {
+    tank.selectTimeScale(index);
+}
+
 #pragma GCC pop_options
 #pragma GCC push_options
 #pragma GCC optimize ("Ofast")
 
 void Dattorro::setPreDelay(float t) {
-    preDelay.setDelayTime(t * sampleRate);
+    preDelayTarget = t * sampleRate;
+    preDelay.setDelayTime(preDelayTarget);
 }
 
 // void Dattorro::setPreDelay(float t) {
@@ -410,6 +671,10 @@ void Dattorro::setSampleRate(float newSampleRate) {
     //clear();
 }
 
+void Dattorro::setTankSampleRate(float newSampleRate) {
+    tank.setSampleRate(newSampleRate);
+}
+
 void Dattorro::freeze(bool freezeFlag) {
     tank.freeze(freezeFlag);
 }
@@ -499,6 +764,10 @@ void Dattorro::setTankModShape(const float modShape) {
     tank.setModShape(modShape);
 }
 
+void Dattorro::setTankModRateDivisor(const int divisor) {
+    tank.setModRateDivisor(divisor);
+}
+
 float Dattorro::getLeftOutput() const {
     return leftOut;
 }
@@ -8,6 +8,25 @@
 #include "dsp/modulation/LFO.hpp"
 #include <array>
 
+// Samples per update of the tank's LFOs and modulated allpass times (make
+// REVERB_MOD_DIVISOR=N): the times ramp linearly in between, which follows
+// the triangle LFOs exactly but for their turning points. 1 updates them
+// every sample, as Dattorro's tank does.
+#ifndef EARTH_REVERB_MOD_DIVISOR
+#define EARTH_REVERB_MOD_DIVISOR 16
+#endif
+
+// How the four LFO-swept tank allpasses read between samples (make
+// REVERB_APF_INTERP=Hermite, say; see DelayInterp). Every other line sits
+// at a fixed time, or jumps with a crossfade, and reads whole samples.
+#ifndef EARTH_REVERB_APF_INTERP
+#define EARTH_REVERB_APF_INTERP Linear
+#endif
+
+using FixedDelay = InterpDelay<DelayInterp::None>;
+using FixedAllpass = AllpassFilter<DelayInterp::None>;
+using ModulatedAllpass = AllpassFilter<DelayInterp::EARTH_REVERB_APF_INTERP>;
+
 class Dattorro1997Tank {
 public:
     Dattorro1997Tank(const float initMaxSampleRate = 32000.0,
@@ -21,12 +40,15 @@ public:
 
     void setSampleRate(const float newSampleRate);
     void setTimeScale(const float newTimeScale);
+    // Switches to kTimeScales[index] with a short crossfade
+    void selectTimeScale(const int index);
 
     void setDecay(const float newDecay);
 
     void setModSpeed(const float newModSpeed);
     void setModDepth(const float newModDepth);
     void setModShape(const float shape);
+    void setModRateDivisor(const int divisor);
 
     void setHighCutFrequency(const float frequency);
     void setLowCutFrequency(const float frequency);
@@ -34,6 +56,10 @@ public:
     void setDiffusion(const float diffusion);
 
     void clear();
+    // clear(), with the kLines delay lines zeroed on the MDMA (one
+    // transfer each): process() mustn't run until they are Done()
+    static constexpr int kLines = 8;
+    void clearInBackground(clevelandmusicco::MdmaTransfer* clearing);
 
     int calcMaxTime(float delayTime);
 
@@ -89,9 +115,30 @@ public:
     static constexpr float lfo2Freq = 0.150;
     static constexpr float lfo3Freq = 0.120;
     static constexpr float lfo4Freq = 0.180;
+    // The rate the LFOs' frequencies are set for (TriSawLFO's default)
+    static constexpr float lfoSampleRate = 32000.0;
 
     static constexpr float minTimeScale = 0.0001;
 
+    // Earth's TOGGLESWITCH_1 time scales. setSampleRate() precomputes
+    // their delay times, so selectTimeScale() is a table lookup.
+    static constexpr int kNumTimeScales = 3;
+    static constexpr float kTimeScales[kNumTimeScales] = {1.0, 2.0, 4.0};
+    static constexpr float timeScaleFadeTime = 0.01;
+
+    struct ScaledTimes {
+        float leftApf1;
+        float leftDelay1;
+        float leftApf2;
+        float leftDelay2;
+        float rightApf1;
+        float rightDelay1;
+        float rightApf2;
+        float rightDelay2;
+    };
+
+    ScaledTimes timeScaleTable[kNumTimeScales];
+
     float timePadding = 0.0;
 
     float scaledLeftApf1Time = leftApf1Time;
@@ -131,22 +178,29 @@ public:
     TriSawLFO lfo3;
     TriSawLFO lfo4;
 
+    // Control-rate modulation: each LFO's value for the current sample and
+    // its step per sample towards the next update
+    int modRateDivisor = 1;
+    int modCountdown = 0;
+    float lfoValues[4] = {};
+    float lfoSteps[4] = {};
+
     float leftSum = 0.0;
     float rightSum = 0.0;
 
-    AllpassFilter leftApf1;
-    InterpDelay leftDelay1;
+    // Left/right pairs side by side, as process() steps them together
+    ModulatedAllpass leftApf1;
+    ModulatedAllpass rightApf1;
+    FixedDelay leftDelay1;
+    FixedDelay rightDelay1;
     OnePoleLPFilter leftHighCutFilter;
+    OnePoleLPFilter rightHighCutFilter;
     OnePoleHPFilter leftLowCutFilter;
-    AllpassFilter leftApf2;
-    InterpDelay leftDelay2;
-
-    AllpassFilter rightApf1;
-    InterpDelay rightDelay1;
-    OnePoleLPFilter rightHighCutFilter;;
     OnePoleHPFilter rightLowCutFilter;
-    AllpassFilter rightApf2;
-    InterpDelay rightDelay2;
+    ModulatedAllpass leftApf2;
+    ModulatedAllpass rightApf2;
+    FixedDelay leftDelay2;
+    FixedDelay rightDelay2;
 
     OnePoleHPFilter leftOutDCBlock;
     OnePoleHPFilter rightOutDCBlock;
@@ -156,6 +210,8 @@ public:
     void tickApfModulation();
 
     void rescaleApfAndDelayTimes();
+    ScaledTimes scaleTimes(const float scale);
+    void applyScaledTimes(const ScaledTimes& times);
     void rescaleTapTimes();
 };
 
@@ -165,11 +221,35 @@ public:
              const float initMaxLfoDepth = 16.0,
              const float initMaxTimeScale = 1.0);
     void process(float leftInput, float rightInput);
+    void processBlock(const float* leftInput, const float* rightInput,
+                      float* leftOutput, float* rightOutput, size_t size);
+    // processBlock() with input on both sides, cheaper
+    void processMonoBlock(const float* input, float* leftOutput,
+                          float* rightOutput, size_t size);
+    // Runs only the tank, on silence, so a tail rings out while the input
+    // section is idle
+    void processTankBlock(float* leftOutput, float* rightOutput, size_t size);
     void clear();
+    // clear() for a reverb that won't run for a while (Earth's gate): the
+    // lines are zeroed on the MDMA instead of in the call, and
+    // finishClear() waits for them before the reverb runs again
+    void clearInBackground();
+    void finishClear();
+    // Clears the input filters, pre-delay and input diffusers, keeping the
+    // tank's tail
+    void clearInput();
+    // Fades what the input section feeds the tank out to nothing over the
+    // next samples of processBlock(), ahead of a switch to
+    // processTankBlock() that would cut it; clearInput() restores it
+    void fadeOutInput(size_t samples);
 
     void setTimeScale(float timeScale);
+    // One of Dattorro1997Tank::kTimeScales, crossfaded
+    void selectTimeScale(int index);
     void setPreDelay(float time);
     void setSampleRate(float sampleRate);
+    // The tank alone, after setSampleRate(): see DattorroMemory::kTankSampleRate
+    void setTankSampleRate(float sampleRate);
 
     void freeze(const bool freezeFlag);
 
@@ -185,12 +265,19 @@ public:
     void setTankModSpeed(const float modSpeed);
     void setTankModDepth(const float modDepth);
     void setTankModShape(const float modShape);
+    void setTankModRateDivisor(const int divisor);
 
     float getLeftOutput() const;
     float getRightOutput() const;
 
 // private:
+    // Samples processBlock() runs through the input filters at a time
+    static constexpr size_t kMaxBlockSize = 64;
+
     float preDelayTime = 0.0;
+    // Pre-delay in samples: processBlock()'s ramp position and its target
+    float preDelaySamples = 0.0;
+    float preDelayTarget = 0.0;
     static constexpr int kInApf1Time = 141;
     static constexpr int kInApf2Time = 107;
     static constexpr int kInApf3Time = 379;
@@ -220,17 +307,27 @@ public:
     OnePoleLPFilter inputLpf;
     OnePoleHPFilter inputHpf;
 
-    InterpDelay preDelay;
+    // Glides with setPreDelay()
+    InterpDelay<> preDelay;
 
-    AllpassFilter inApf1;
-    AllpassFilter inApf2;
-    AllpassFilter inApf3;
-    AllpassFilter inApf4;
+    FixedAllpass inApf1;
+    FixedAllpass inApf2;
+    FixedAllpass inApf3;
+    FixedAllpass inApf4;
 
     Dattorro1997Tank tank;
 
     float tankFeed = 0.0;
+    // fadeOutInput()'s ramp on tankFeed
+    float tankFeedGain = 1.0;
+    float tankFeedStep = 0.0;
+    float blockBuffer[kMaxBlockSize];
+    // clearInBackground()'s transfers: the tank's lines, then the
+    // pre-delay's and the input diffusers'
+    clevelandmusicco::MdmaTransfer clearing[Dattorro1997Tank::kLines + 5];
 
     float dattorroScale(float delayTime);
+    void processInputBlock(float* leftOutput, float* rightOutput,
+                           size_t n, float preDelayStep);
 };
 
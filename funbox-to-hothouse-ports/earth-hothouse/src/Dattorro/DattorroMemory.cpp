@@ -0,0 +1,36 @@
+#include "DattorroMemory.hpp"
+
+// Regions as planned in DattorroMemory.hpp; tools/bench overrides them to
+// time the reverb with its lines elsewhere
+#ifndef DATTORRO_INPUT_MEM
+#define DATTORRO_INPUT_MEM DTCM_MEM_SECTION
+#endif
+#ifndef DATTORRO_TANK_MEM
+#define DATTORRO_TANK_MEM
+#endif
+#ifndef DATTORRO_DELAY_MEM
+#define DATTORRO_DELAY_MEM DSY_SDRAM_BSS
+#endif
+
+// Every line is write-back cached (hothouse_cache.h's default): the CPU is
+// all that reads and writes them, but for the gate's MDMA clears, which do
+// their own cache maintenance
+namespace DattorroMemory {
+
+float DATTORRO_INPUT_MEM inApf1[kInApf1Length];
+float DATTORRO_INPUT_MEM inApf2[kInApf2Length];
+float DATTORRO_INPUT_MEM inApf3[kInApf3Length];
+float DATTORRO_INPUT_MEM inApf4[kInApf4Length];
+
+float DATTORRO_TANK_MEM leftApf1[kLeftApf1Length];
+float DATTORRO_TANK_MEM leftApf2[kLeftApf2Length];
+float DATTORRO_TANK_MEM rightApf1[kRightApf1Length];
+float DATTORRO_TANK_MEM rightApf2[kRightApf2Length];
+
+float DATTORRO_DELAY_MEM preDelay[kPreDelayLength];
+float DATTORRO_DELAY_MEM leftDelay1[kLeftDelay1Length];
+float DATTORRO_DELAY_MEM leftDelay2[kLeftDelay2Length];
+float DATTORRO_DELAY_MEM rightDelay1[kRightDelay1Length];
+float DATTORRO_DELAY_MEM rightDelay2[kRightDelay2Length];
+
+} // namespace DattorroMemory
@@ -0,0 +1,105 @@
+//
+// Placement of the plate reverb's delay lines.
+//
+// Each line has its own buffer, sized at build time for the largest reverb
+// the pedal builds (Earth's Dattorro(kMaxSampleRate, 16, 4.0)) and put in
+// the memory that suits how it is used:
+//   DTCM      the input diffusers: short, and all four run every sample
+//   AXI SRAM  the tank allpasses: modulated, read and written every sample
+//   SDRAM     the pre-delay and the long tank delays, which only need room
+// A line asked for longer than its buffer is clamped to it (fit()), so a
+// bigger reverb than planned gets shorter lines rather than overruns.
+// There is one set of buffers, so one Dattorro per firmware.
+//
+// `make memory-report` prints what each region ends up holding.
+//
+
+#pragma once
+#include "Dattorro.hpp"
+#include "daisy_seed.h"
+#include <cstddef>
+
+// The rate Earth runs its reverb at (make REVERB_RATE=32000, say): every
+// line scales with it, so a slower reverb needs less of each region
+#ifndef EARTH_REVERB_RATE
+#define EARTH_REVERB_RATE 48000
+#endif
+
+namespace DattorroMemory {
+
+constexpr float kMaxSampleRate = EARTH_REVERB_RATE;
+constexpr float kMaxLfoDepth = 16.0;
+constexpr float kMaxTimeScale = 4.0;
+
+constexpr float kScale = kMaxSampleRate / Dattorro::dattorroSampleRate;
+
+// The tank clamps its rate to Dattorro1997Tank::maxSampleRate (32 kHz), so
+// at 48 kHz its lines have always run at 2/3 of Dattorro's times. Earth
+// keeps that sound at any reverb rate (Dattorro::setTankSampleRate()),
+// and the tank's lines are sized for it.
+constexpr float kTankSampleRate = kMaxSampleRate * 32000.0f / 48000.0f;
+constexpr float kTankScale = kTankSampleRate / Dattorro1997Tank::dattorroSampleRate;
+
+// Dattorro's input allpass lengths, dattorroScale(8 * time)
+constexpr size_t inputApfLength(int time) {
+    return (size_t)((float)(8 * time) * kScale);
+}
+
+// Dattorro1997Tank::calcMaxTime() at the planned maximums
+constexpr int kMaxOutputTap = (int)((float)Dattorro1997Tank::leftDelay1RightTap2 * kTankScale);
+constexpr size_t tankLength(float delayTime) {
+    return (size_t)(kTankScale * (delayTime * kMaxTimeScale + kMaxOutputTap + kMaxLfoDepth));
+}
+
+constexpr size_t kInApf1Length = inputApfLength(Dattorro::kInApf1Time);
+constexpr size_t kInApf2Length = inputApfLength(Dattorro::kInApf2Time);
+constexpr size_t kInApf3Length = inputApfLength(Dattorro::kInApf3Time);
+constexpr size_t kInApf4Length = inputApfLength(Dattorro::kInApf4Time);
+
+constexpr size_t kLeftApf1Length = tankLength(Dattorro1997Tank::leftApf1Time);
+constexpr size_t kLeftApf2Length = tankLength(Dattorro1997Tank::leftApf2Time);
+constexpr size_t kRightApf1Length = tankLength(Dattorro1997Tank::rightApf1Time);
+constexpr size_t kRightApf2Length = tankLength(Dattorro1997Tank::rightApf2Time);
+
+// 37000 samples at 48 kHz, the same time at any rate
+constexpr size_t kPreDelayLength = (size_t)(37000.0f * kMaxSampleRate / 48000.0f);
+constexpr size_t kLeftDelay1Length = tankLength(Dattorro1997Tank::leftDelay1Time);
+constexpr size_t kLeftDelay2Length = tankLength(Dattorro1997Tank::leftDelay2Time);
+constexpr size_t kRightDelay1Length = tankLength(Dattorro1997Tank::rightDelay1Time);
+constexpr size_t kRightDelay2Length = tankLength(Dattorro1997Tank::rightDelay2Time);
+
+constexpr size_t kDtcmBytes = (kInApf1Length + kInApf2Length + kInApf3Length + kInApf4Length) * sizeof(float);
+constexpr size_t kSramBytes = (kLeftApf1Length + kLeftApf2Length + kRightApf1Length + kRightApf2Length) * sizeof(float);
+constexpr size_t kSdramBytes = (kPreDelayLength + kLeftDelay1Length + kLeftDelay2Length +
+                                kRightDelay1Length + kRightDelay2Length) * sizeof(float);
+
+// DTCM and AXI SRAM are shared with the stack, libDaisy and the rest of
+// the pedal; keep the reverb to half of DTCM and under 320K of SRAM
+static_assert(kDtcmBytes <= 64 * 1024, "input diffusers overflow their DTCM budget");
+static_assert(kSramBytes <= 320 * 1024, "tank allpasses overflow their SRAM budget");
+static_assert(kSdramBytes <= 64 * 1024 * 1024, "delay lines overflow SDRAM");
+
+extern float inApf1[kInApf1Length];
+extern float inApf2[kInApf2Length];
+extern float inApf3[kInApf3Length];
+extern float inApf4[kInApf4Length];
+
+extern float leftApf1[kLeftApf1Length];
+extern float leftApf2[kLeftApf2Length];
+extern float rightApf1[kRightApf1Length];
+extern float rightApf2[kRightApf2Length];
+
+extern float preDelay[kPreDelayLength];
+extern float leftDelay1[kLeftDelay1Length];
+extern float leftDelay2[kLeftDelay2Length];
+extern float rightDelay1[kRightDelay1Length];
+extern float rightDelay2[kRightDelay2Length];
+
+// length, clamped to the samples buffer holds
+template <size_t N>
+inline int fit(float length, const float (&buffer)[N]) {
+    (void)buffer;
+    return length < (float)N ? (int)length : (int)N;
+}
+
+} // namespace DattorroMemory
@@ -1,6 +1,7 @@
 #pragma once
 #include "InterpDelay.hpp"
 
+template <DelayInterp Interp = DelayInterp::Linear>
 class AllpassFilter {
 public:
     AllpassFilter() {
@@ -8,9 +9,9 @@ public:
         gain = 0.;
     }
 
-    AllpassFilter(int maxDelay, int initDelay = 0, float gain = 0.) {
+    AllpassFilter(float* buffer, int maxDelay, int initDelay = 0, float gain = 0.) {
         //clear();
-        delay = InterpDelay(maxDelay, initDelay);
+        delay = InterpDelay<Interp>(buffer, maxDelay, initDelay);
         this->gain = gain;
     }
 
@@ -42,13 +43,21 @@ public:
         delay.clear();
     }
 
+    void clearInBackground(clevelandmusicco::MdmaTransfer& clearing) {
+        input = 0.;
+        output = 0.;
+        _inSum = 0.;
+        _outSum = 0.;
+        delay.clearInBackground(clearing);
+    }
+
     inline void setGain(const float &newGain) {
         gain = newGain;
     }
 
     float input;
     float output;
-    InterpDelay delay;
+    InterpDelay<Interp> delay;
 
 private:
     float gain;
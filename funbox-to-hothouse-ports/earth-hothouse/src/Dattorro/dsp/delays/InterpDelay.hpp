@@ -1,37 +1,42 @@
 #pragma once
 #include <vector>
 #include <cstdint>
+#include "hothouse_mdma.h"
 
-#include "daisy_seed.h" // Needed for DSY_SDRAM_BSS definition
-
-
-//extern float DSY_SDRAM_BSS sdramData[50][144000];
-extern float DSY_SDRAM_BSS sdramData[13][37000];
-//extern float sdramData[50][144000];
-extern unsigned int count;
 extern float hold;
 extern bool triggerClear;
 extern float clearPopCancelValue;
 
+// How a delay reads between samples. Lines at a fixed time need nothing
+// better than None; ones an LFO sweeps need one of the others:
+//   None     the nearest whole sample
+//   Linear   between the two samples either side
+//   Allpass  a first-order allpass over those two: flat, but it has state,
+//            so it suits slow sweeps only
+//   Hermite  a cubic through four samples (DelayLine2Tap::ReadHermite()),
+//            for at least a sample of delay
+enum class DelayInterp { None, Linear, Allpass, Hermite };
+
+template <DelayInterp Interp = DelayInterp::Linear>
 class InterpDelay {
 public:
     float input = 0.;
     float output = 0.;
-    int bufferNumber = 0;
     int r = 0;
     int upperR = 0;
     int j = 0;
     float dataR = 0.;
     float dataUpperR = 0.;
 
-    //InterpDelay () {}
+    InterpDelay() {}
 
-    InterpDelay(unsigned int maxLength = 512, float initDelayTime = 0.) {
+    // buffer holds maxLength samples; see DattorroMemory.hpp for where the
+    // reverb's buffers live
+    InterpDelay(float* buffer, unsigned int maxLength, float initDelayTime = 0.) {
+        data = buffer;
         l = maxLength;
         lDouble = static_cast<float>(maxLength);
 
-        bufferNumber = ++count;
-
         setDelayTime(initDelayTime);
     }
 
@@ -49,7 +54,7 @@ public:
 
     inline void process() {
         //if(!triggerClear) {
-            sdramData[bufferNumber][w] = input;
+            data[w] = input;
             r = w - t;
             
             if (r < 0) {
@@ -61,18 +66,45 @@ public:
                 w = 0;
             }
 
-            upperR = r - 1;
-            if (upperR < 0) {
-                upperR += l;
-            }
-
-            dataR = sdramData[bufferNumber][r];
-            dataUpperR = sdramData[bufferNumber][upperR];
-            
+            dataR = data[r];
             dataR *= clearPopCancelValue;
-            dataUpperR *= clearPopCancelValue;
 
-            output = hold * (dataR + f * (dataUpperR - dataR));
+            if constexpr (Interp == DelayInterp::None) {
+                output = hold * dataR;
+            }
+            else {
+                upperR = r - 1;
+                if (upperR < 0) {
+                    upperR += l;
+                }
+                dataUpperR = data[upperR];
+                dataUpperR *= clearPopCancelValue;
+
+                if constexpr (Interp == DelayInterp::Linear) {
+                    output = hold * (dataR + f * (dataUpperR - dataR));
+                }
+                else if constexpr (Interp == DelayInterp::Allpass) {
+                    allpassOut = allpassEta * (dataR - allpassOut) + dataUpperR;
+                    output = hold * allpassOut;
+                }
+                else {
+                    int newerR = r + 1;
+                    if (newerR >= l) {
+                        newerR -= l;
+                    }
+                    int olderR = upperR - 1;
+                    if (olderR < 0) {
+                        olderR += l;
+                    }
+                    output = hold * hermite(data[newerR] * clearPopCancelValue, dataR, dataUpperR,
+                                            data[olderR] * clearPopCancelValue, f);
+                }
+            }
+
+            if (fadeGain < 1.) {
+                output = fadeGain * output + (1. - fadeGain) * hold * readFadeFrom();
+                fadeGain += fadeStep;
+            }
         //}
     }
 
@@ -85,7 +117,7 @@ public:
         if (j < 0) {
             j += l;
         }
-        return sdramData[bufferNumber][j];
+        return data[j];
     }
 
     #pragma GCC pop_options
@@ -96,28 +128,98 @@ public:
         if (newDelayTime >= lDouble) {
             newDelayTime = lDouble - 1.;
         }
-        if (newDelayTime < 0.) {
-            newDelayTime = 0.;
+        if (newDelayTime < kMinDelayTime) {
+            newDelayTime = kMinDelayTime;
+        }
+        if constexpr (Interp == DelayInterp::None) {
+            t = static_cast<int>(newDelayTime + 0.5f);
+            return;
         }
         t = static_cast<int>(newDelayTime);
         f = newDelayTime - static_cast<float>(t);
+        if constexpr (Interp == DelayInterp::Allpass) {
+            allpassEta = (1.f - f) / (1.f + f);
+        }
     }
 
     #pragma GCC pop_options
 
+    // Fades the output from the current delay time to whatever is set next,
+    // over fadeSamples. The old time is held for the fade.
+    void crossfade(int fadeSamples) {
+        fadeT = t;
+        fadeF = f;
+        fadeGain = 0.;
+        fadeStep = fadeSamples > 0 ? 1. / fadeSamples : 1.;
+    }
+
     void clear() {
-        // uint32_t **tempPtr = (uint32_t**)sdramData;
         for(int i = 0; i < l; ++i) {
-            sdramData[bufferNumber][i] = uint32_t(0);
+            data[i] = 0.;
         }
         input = 0.;
         output = 0.;
+        allpassOut = 0.;
+    }
+
+    // clear(), with the buffer zeroed on the MDMA: the line mustn't run
+    // until clearing is Done()
+    void clearInBackground(clevelandmusicco::MdmaTransfer& clearing) {
+        clevelandmusicco::MdmaFill(clearing, data, 0, l * sizeof(float));
+        input = 0.;
+        output = 0.;
+        allpassOut = 0.;
     }
 
 private:
+    // Hermite reads a sample newer than the delay time
+    static constexpr float kMinDelayTime = Interp == DelayInterp::Hermite ? 1.f : 0.f;
+
+    // The cubic through xm1, x0, x1, x2 (newest first) at f past x0
+    static inline float hermite(float xm1, float x0, float x1, float x2, float f) {
+        const float c = (x1 - xm1) * 0.5f;
+        const float v = x0 - x1;
+        const float w = c + v;
+        const float a = w + v + (x2 - x0) * 0.5f;
+        const float bNeg = w + a;
+        return (((a * f) - bNeg) * f + c) * f + x0;
+    }
+
+    // The crossfade's old read: fadeT behind the sample process() just
+    // wrote, which is r + t
+    inline float readFadeFrom() {
+        int a = r + t - fadeT;
+        if (a >= l) {
+            a -= l;
+        }
+        if (a < 0) {
+            a += l;
+        }
+        int b = a - 1;
+        if (b < 0) {
+            b += l;
+        }
+        const float dataA = data[a] * clearPopCancelValue;
+        if constexpr (Interp == DelayInterp::None) {
+            return dataA;
+        }
+        // The fade is brief: past None, a linear read does
+        const float dataB = data[b] * clearPopCancelValue;
+        return dataA + fadeF * (dataB - dataA);
+    }
+
+    float* data = nullptr;
     int  w = 0;
     int t = 0;
     float f = 0.;
-    int l = 512;
-    float lDouble = 512.;
+    int l = 0;
+    float lDouble = 0.;
+
+    int fadeT = 0;
+    float fadeF = 0.;
+    float fadeGain = 1.;
+    float fadeStep = 0.;
+
+    float allpassEta = 1.;
+    float allpassOut = 0.;
 };
\ No newline at end of file
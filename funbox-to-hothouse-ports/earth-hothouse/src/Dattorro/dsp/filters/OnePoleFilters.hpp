@@ -1,5 +1,6 @@
 #pragma once
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 
 #ifndef  M_PI
@@ -32,6 +33,22 @@ public:
 
     #pragma GCC pop_options
 
+    // Filters size samples in place, the state held in locals. Outside
+    // the Ofast block so the sums keep process()'s order.
+    inline void processBlock(float* buffer, size_t size) {
+        const float a = _a;
+        const float b = _b;
+        float z = _z;
+        for (size_t i = 0; i < size; ++i) {
+            z = a * buffer[i] + z * b;
+            buffer[i] = z;
+        }
+        if (size > 0) {
+            _z = z;
+            output = z;
+        }
+    }
+
     void clear() {
         input = 0.0;
         _z = 0.0;
@@ -113,6 +130,30 @@ public:
 
     #pragma GCC pop_options
 
+    // Filters size samples in place, the state held in locals. Outside
+    // the Ofast block so the sums keep process()'s order.
+    inline void processBlock(float* buffer, size_t size) {
+        const float a0 = _a0;
+        const float a1 = _a1;
+        const float b1 = _b1;
+        float x1 = _x1;
+        float y1 = _y1;
+        for (size_t i = 0; i < size; ++i) {
+            const float x0 = buffer[i];
+            y1 = a0 * x0 + a1 * x1 + b1 * y1;
+            x1 = x0;
+            buffer[i] = y1;
+        }
+        if (size > 0) {
+            _x0 = x1;
+            _x1 = x1;
+            _y0 = y1;
+            _y1 = y1;
+            input = x1;
+            output = y1;
+        }
+    }
+
     void clear() {
         input = 0.0;
         output = 0.0;
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <q/fx/allpass.hpp> // hilbert_quadrature.hpp uses it without including it
+#include <q/fx/biquad.hpp>
+#include <q/fx/dc_block.hpp>
+#include <q/fx/hilbert_quadrature.hpp>
+
+#include "FastSqrt.h"
+
+//=============================================================================
+// Octave up from the whole signal's analytic signal, for when only the
+// octave up is wanted: a low-pass, q's Hilbert all-pass pair and the same
+// phase doubling as BandShifter::update_up1(), Re(z^2) / |z|, then a DC
+// block. About 20 multiply-adds a sample against OctaveGenerator's 80 bands.
+//
+// On one note it tracks as well as the bank. On a chord the square also
+// makes the notes' sum and difference tones, which the bank's one band per
+// note avoids: the bank stays the polyphonic option.
+class HilbertOctave
+{
+public:
+    // Inputs above this would double past the octave rate's Nyquist; it's
+    // about where OctaveGenerator's top band sits
+    static constexpr float input_cutoff = 1800.0f;
+
+    explicit HilbertOctave(float sample_rate)
+        : _lowpass{cycfi::q::frequency(input_cutoff), sample_rate},
+          _dc_block{cycfi::q::frequency(20.0f), sample_rate}
+    {
+    }
+
+    void update(float sample)
+    {
+        const auto [re, im] = _hilbert(_lowpass(sample));
+        const float mag2 = re*re + im*im + 1e-12f;
+        _up1 = _dc_block((re*re - im*im) * fastInvSqrt(mag2));
+    }
+
+    float up1() const
+    {
+        return _up1;
+    }
+
+private:
+    cycfi::q::lowpass _lowpass;
+    cycfi::q::hilbert_quadrature _hilbert;
+    cycfi::q::dc_block _dc_block;
+    float _up1 = 0;
+};
@@ -1,34 +1,92 @@
 #pragma once
 
 #include <array>
+#include <cstring>
 #include <span>
 
-#include <q/utility/ring_buffer.hpp>
-
+// Decimator2 and Interpolator are two-stage equiripple designs for exactly
+// this factor (48 kHz to 16 kHz to 8 kHz and back), so it can't be changed
+// on its own. Other factors have FirDecimator and FirInterpolator in
+// lib/hothouse/hothouse_multirate.h, designed at compile time.
 constexpr size_t resample_factor = 6;
-//constexpr size_t resample_factor = 1; // KAB Note: redefining as 1 to get around DaisySeedProjects effects being set up to process every sample, not every block
-                                      // Not sure what this will do TODO
+
+// Chunks of resample_factor input samples the block calls process between
+// history moves (one 48 sample audio block)
+constexpr size_t max_resample_chunks = 8;
+
+//=============================================================================
+// Linear FIR history: new samples are written downwards below the kept
+// history, so the filters index a plain array, newest first, like
+// ring_buffer[i] (0 = latest) but without the wrap. commit() moves the
+// newest samples back to the top once per call, instead of wrapping on
+// every read.
+template <std::size_t History, std::size_t MaxNew>
+class HistoryBuffer
+{
+public:
+    void push(float s)
+    {
+        _data[--_pos] = s;
+    }
+
+    const float* latest() const
+    {
+        return &_data[_pos];
+    }
+
+    void commit()
+    {
+        std::memmove(&_data[MaxNew], &_data[_pos], History * sizeof(float));
+        _pos = MaxNew;
+    }
+
+private:
+    std::array<float, MaxNew + History> _data{};
+    std::size_t _pos = MaxNew;
+};
+
 //=============================================================================
 class Decimator2
 {
 public:
     float operator()(std::span<const float, resample_factor> s)
     {
-        buffer1.push(s[0]);
-        buffer1.push(s[1]);
-        buffer1.push(s[2]);
-        buffer2.push(filter1());
+        float out;
+        decimate(s.data(), &out, 1);
+        return out;
+    }
 
-        buffer1.push(s[3]);
-        buffer1.push(s[4]);
-        buffer1.push(s[5]);
-        buffer2.push(filter1());
+    // Decimates num_chunks chunks of resample_factor samples from in to
+    // num_chunks samples in out
+    void decimate(const float* in, float* out, size_t num_chunks)
+    {
+        while (num_chunks > 0)
+        {
+            const size_t n = num_chunks < max_resample_chunks ? num_chunks : max_resample_chunks;
+            for (size_t i = 0; i < n; ++i)
+            {
+                buffer1.push(in[0]);
+                buffer1.push(in[1]);
+                buffer1.push(in[2]);
+                buffer2.push(filter1(buffer1.latest()));
 
-        return filter2();
+                buffer1.push(in[3]);
+                buffer1.push(in[4]);
+                buffer1.push(in[5]);
+                buffer2.push(filter1(buffer1.latest()));
+
+                out[i] = filter2(buffer2.latest());
+                in += resample_factor;
+            }
+            buffer1.commit();
+            buffer2.commit();
+            out += n;
+            num_chunks -= n;
+        }
     }
 
 private:
-    float filter1()
+    static float filter1(const float* buffer1)
     {
         // 48000 Hz sample rate
         // 0-1800 Hz pass band (3 dB ripple)
@@ -47,7 +105,7 @@ private:
             0.14270010010002276f * buffer1[offset1+10];
     }
 
-    float filter2()
+    static float filter2(const float* buffer2)
     {
         // Half-band filter
         // 16000 Hz sample rate
@@ -68,8 +126,8 @@ private:
     static constexpr std::size_t fsize2 = 15;
     static constexpr std::size_t offset2 = bsize2 - fsize2;
 
-    cycfi::q::ring_buffer<float> buffer1{bsize1};
-    cycfi::q::ring_buffer<float> buffer2{bsize2};
+    HistoryBuffer<bsize1 - 1, max_resample_chunks * resample_factor> buffer1;
+    HistoryBuffer<bsize2 - 1, max_resample_chunks * 2> buffer2;
 };
 
 
@@ -80,20 +138,37 @@ public:
     std::array<float, resample_factor> operator()(float s)
     {
         std::array<float, resample_factor> output;
+        interpolate(&s, output.data(), 1);
+        return output;
+    }
 
-        buffer1.push(s);
-
-        buffer2.push(filter1a());
-        output[0] = filter2a();
-        output[1] = filter2b();
-        output[2] = filter2c();
+    // Interpolates num_samples samples from in to num_samples chunks of
+    // resample_factor samples in out
+    void interpolate(const float* in, float* out, size_t num_samples)
+    {
+        while (num_samples > 0)
+        {
+            const size_t n = num_samples < max_resample_chunks ? num_samples : max_resample_chunks;
+            for (size_t i = 0; i < n; ++i)
+            {
+                buffer1.push(in[i]);
 
-        buffer2.push(filter1b());
-        output[3] = filter2a();
-        output[4] = filter2b();
-        output[5] = filter2c();
+                buffer2.push(filter1a(buffer1.latest()));
+                out[0] = filter2a(buffer2.latest());
+                out[1] = filter2b(buffer2.latest());
+                out[2] = filter2c(buffer2.latest());
 
-        return output;
+                buffer2.push(filter1b(buffer1.latest()));
+                out[3] = filter2a(buffer2.latest());
+                out[4] = filter2b(buffer2.latest());
+                out[5] = filter2c(buffer2.latest());
+                out += resample_factor;
+            }
+            buffer1.commit();
+            buffer2.commit();
+            in += n;
+            num_samples -= n;
+        }
     }
 
 private:
@@ -103,7 +178,7 @@ private:
     // 4400-8000 Hz stop band (-80 dB)
     // Gain=2 in passband
 
-    float filter1a()
+    static float filter1a(const float* buffer1)
     {
         return
             -0.0028536199247471473f * (buffer1[offset1+0] + buffer1[offset1+24]) +
@@ -121,7 +196,7 @@ private:
             0.9507771467941135f * buffer1[offset1+12];
     }
 
-    float filter1b()
+    static float filter1b(const float* buffer1)
     {
         return
             -0.015961858776449508f * (buffer1[offset1+0] + buffer1[offset1+23]) +
@@ -144,7 +219,7 @@ private:
     // 8000-24000 Hz stop band (-80 dB)
     // Gain=3 in passband
 
-    float filter2a()
+    static float filter2a(const float* buffer2)
     {
         return
             0.00036440608905813593f * buffer2[offset2+0] +
@@ -160,7 +235,7 @@ private:
             0.001762424830497545f * buffer2[offset2+10];
     }
 
-    float filter2b()
+    static float filter2b(const float* buffer2)
     {
         return
             0.001112114188613258f * (buffer2[offset2+0] + buffer2[offset2+10]) +
@@ -171,7 +246,7 @@ private:
             0.590541634315722f * buffer2[offset2+5];
     }
 
-    float filter2c()
+    static float filter2c(const float* buffer2)
     {
         return
             0.001762424830497545f * buffer2[offset2+0] +
@@ -195,6 +270,6 @@ private:
     static constexpr std::size_t fsize2 = 11;
     static constexpr std::size_t offset2 = bsize2 - fsize2;
 
-    cycfi::q::ring_buffer<float> buffer1{bsize1};
-    cycfi::q::ring_buffer<float> buffer2{bsize2};
+    HistoryBuffer<bsize1 - 1, max_resample_chunks> buffer1;
+    HistoryBuffer<bsize2 - 1, max_resample_chunks * 2> buffer2;
 };
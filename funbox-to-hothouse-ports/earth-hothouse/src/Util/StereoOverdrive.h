@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+
+//=============================================================================
+// DaisySP's Overdrive for both channels at once, a block at a time. The
+// curve is the same: a pre-gain into a soft clip, then the post-gain that
+// brings a full-scale input back to about full scale. set_drive() works the
+// gains out once a block, with the caller's makeup gain folded into the
+// post-gain, and process() ramps both from the last block's across this one,
+// so a swelling drive costs two adds a sample instead of an Overdrive's
+// SetDrive() per channel per sample. A block set but not processed is
+// skipped over: the next ramp starts where it would have ended.
+class StereoOverdrive
+{
+public:
+    // drive 0..1 and makeup (applied after the post-gain) for the next
+    // process() of size samples
+    void set_drive(float drive, float makeup, std::size_t size)
+    {
+        drive = drive < 0.0f ? 0.0f : (drive > 1.0f ? 1.0f : drive);
+        const float d = 2.0f * drive;
+        const float d2 = d * d;
+        const float pre_a = d * 0.5f;
+        const float pre_b = d2 * d2 * d * 24.0f;
+        const float pre = pre_a + (pre_b - pre_a) * d2;
+        const float squashed = d * (2.0f - d);
+        const float post = makeup / soft_clip(0.33f + squashed * (pre - 0.33f));
+
+        const float inv = 1.0f / (float)size;
+        _pre = _pre_target;
+        _post = _post_target;
+        _pre_step = (pre - _pre) * inv;
+        _post_step = (post - _post) * inv;
+        _pre_target = pre;
+        _post_target = post;
+    }
+
+    // Sets both gains at once, without a ramp
+    void reset(float drive, float makeup)
+    {
+        set_drive(drive, makeup, 1);
+        _pre = _pre_target;
+        _post = _post_target;
+        _pre_step = _post_step = 0.0f;
+    }
+
+    // In place, input_gain ahead of the pre-gain
+    void process(float* left, float* right, std::size_t size, float input_gain)
+    {
+        float pre = _pre * input_gain;
+        const float pre_step = _pre_step * input_gain;
+        float post = _post;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            pre += pre_step;
+            post += _post_step;
+            left[i] = soft_clip(left[i] * pre) * post;
+            right[i] = soft_clip(right[i] * pre) * post;
+        }
+        _pre = _pre_target;
+        _post = _post_target;
+        _pre_step = _post_step = 0.0f;
+    }
+
+private:
+    // DaisySP's SoftClip
+    static float soft_clip(float x)
+    {
+        if (x < -3.0f)
+            return -1.0f;
+        if (x > 3.0f)
+            return 1.0f;
+        return x * (27.0f + x * x) / (27.0f + 9.0f * x * x);
+    }
+
+    float _pre = 0.0f;
+    float _post = 1.0f;
+    float _pre_step = 0.0f;
+    float _post_step = 0.0f;
+    float _pre_target = 0.0f;
+    float _post_target = 1.0f;
+};
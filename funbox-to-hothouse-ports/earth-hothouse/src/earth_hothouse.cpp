@@ -9,16 +9,21 @@
 #include "daisy_seed.h"
 #include "daisysp.h"
 #include "hothouse.h"
+#include "hothouse_biquad.h"
+#include "hothouse_mixlaw.h"
+#include "hothouse_multirate.h"
 #include "expressionHandler.h"
+#include "hothouse_commands.h"
+#include "hothouse_tempo.h"
 
 #include "Dattorro/Dattorro.hpp"
+#include "Dattorro/DattorroMemory.hpp"
 
-#include <q/support/literals.hpp>
-#include <q/fx/biquad.hpp>
 #include "Util/Multirate.h"
+#include "Util/HilbertOctave.h"
 #include "Util/OctaveGenerator.h"
-namespace q = cycfi::q;
-using namespace q::literals;
+#include "Util/StereoOverdrive.h"
+#include <numeric>
 
 using namespace daisy;
 using namespace daisysp;
@@ -26,15 +31,37 @@ using namespace clevelandmusicco;
 
 // Declare hardware
 Hothouse hw;
+MidiUsbHandler midi;
+
+// What the main loop hands the callback (hothouse_commands.h): MIDI CC
+// knob moves and clock messages, parsed in the main loop, and the toggles
+enum EarthCommand { CMD_MIDI_KNOB, CMD_MIDI_CLOCK, CMD_TIME_SCALE, CMD_EFFECT_MODE, CMD_FOOTSWITCH_MODE };
+enum MidiClockMessage { MIDI_CLOCK_TICK, MIDI_CLOCK_START, MIDI_CLOCK_STOP };
+constexpr uint32_t command_budget = 8;  // commands a block, each costing 1
+CommandQueue<32> commands;
 float pdamp, pmix, pdecay, pmoddepth, pmodspeed, ppredelay;
 bool bypass;
+// Spillover (trails) bypass: the tank rings out under the dry signal.
+// Selected by holding FOOTSWITCH 2 at power-on.
+bool spillover = false;
+// FOOTSWITCH 1 held at power-on: IN R is used, see AudioCallback()
+bool stereo_input = false;
 Led led1, led2;
 
-float dryMix = 0.5f;
-float wetMix = 0.5f;
+// A MIDI clock's beat grid (hothouse_tempo.h): while one is running, LED 1
+// blinks off on each beat for beat_flash_samples
+TempoClock midi_tempo;
+EventScheduler<2> tempo_events;
+enum TempoEvent { BEAT_FLASH_END };
+constexpr uint32_t beat_flash_samples = 2400;
+bool beat_flash = false;
+
+// Dry/wet gains, ramped across each block to the mix knob's
+MixRamp mixRamp;
 
 // Expression
-ExpressionHandler expHandler;
+ExpressionHandler<6> expHandler;
+float vexpression = 0.5f; // Heel-toe position, read at the control rate
 bool expression_pressed;
 
 // Midi
@@ -42,36 +69,179 @@ bool midi_control[6];
 
 // Control Values
 float knobValues[6];
-int toggleValues[3];
+int toggleValues[3];  // main loop, see UpdateSwitches()
 int prev_toggleValues[3] = {-1, -1, -1};
 bool first_start;
 
 float pknobValues[6];
 
-Dattorro reverb(48000, 16, 4.0);
+Dattorro reverb(DattorroMemory::kMaxSampleRate, 16, 4.0);
 int footswitch_mode = 0;
 int effect_mode = 0;
 bool fw2_held = false;
 bool effect_on_momentary = false;
 bool freeze = false;
-
-static Decimator2 decimate;
+// A freeze (footswitch mode 0) closes the tank once its decay has ramped
+// to within this of 1: nothing more goes in, so the octave and the whole
+// input section (DC blockers, input filters, pre-delay, diffusers) stop
+// and the tank runs on what it holds. What the input section feeds the
+// tank fades out over the block that closes it; letting go clears the
+// input section, so no pre-freeze audio is left in the pre-delay, and
+// fades the input back in.
+static constexpr float freeze_closed_decay = 0.999f;
+bool tank_closed = false;
+
+static Decimator2 HOTHOUSE_DTCM_BSS decimate;
 static Interpolator interpolate;
 static const auto sample_rate_temp = 48000;
-static OctaveGenerator octave(sample_rate_temp / resample_factor);
-static q::highshelf eq1(-11, 140_Hz, sample_rate_temp);
-static q::lowshelf eq2(5, 160_Hz, sample_rate_temp);
-float buff[6];
-float buff_out[6];
-int bin_counter = 0;
+static constexpr auto octave_coefficients = OctaveGenerator::coefficients(sample_rate_temp / resample_factor);
+static OctaveGenerator HOTHOUSE_DTCM_BSS octave(octave_coefficients);
+// make HILBERT_OCTAVE=1 takes mode 1's octave up from one analytic signal
+// (Util/HilbertOctave.h) at a fraction of the bank's cycles; chords then
+// intermodulate. Mode 2 keeps the bank.
+#ifndef EARTH_HILBERT_OCTAVE
+#define EARTH_HILBERT_OCTAVE 0
+#endif
+#if EARTH_HILBERT_OCTAVE
+static HilbertOctave octave_up_lite(sample_rate_temp / resample_factor);
+#endif
+// High shelf -11 dB at 140 Hz, then low shelf +5 dB at 160 Hz, over the
+// octaves at the decimated rate: both filters are fixed and linear, so
+// they can run before the interpolator, on one sample in resample_factor
+static BiquadCascade<2> octave_eq;
+// Audio block size per boot-time profile (hold both footswitches at
+// power-up): smaller for latency, larger for CPU headroom. Each is a
+// multiple of 24, so blocks hold whole resample chunks and reverb slices.
+static const Hothouse::AudioProfileTable audio_profiles = {
+    {{24, SaiHandle::Config::SampleRate::SAI_48KHZ},
+     {48, SaiHandle::Config::SampleRate::SAI_48KHZ},
+     {96, SaiHandle::Config::SampleRate::SAI_48KHZ}},
+    Hothouse::AUDIO_PROFILE_BALANCED};
+static constexpr size_t max_block_size = 96;
+size_t audio_block_size = 48;
+size_t octave_block_size = audio_block_size / resample_factor;
+// Controls are scanned about once a millisecond whatever the block size
+size_t control_interval_blocks = 1;
+size_t control_block_counter = 0;
+float octave_in[max_block_size / resample_factor];
+float octave_out[max_block_size / resample_factor];
+float octave_up[max_block_size];
+// Octave + dry mix for the block, after the previous block's last chunk
+float buff_out[resample_factor + max_block_size];
+float buff_out_r[resample_factor + max_block_size]; // stereo input only
+float mono_in[max_block_size];                      // stereo input: octave input
+float reverb_in[max_block_size];
+float reverb_in_r[max_block_size];
+float reverb_out_l[max_block_size];
+float reverb_out_r[max_block_size];
+
+// Signal probes (make PROBE=1): the tank's input and its left output, each
+// the last 2 s
+constexpr size_t probe_frames = 96000;
+int probe_tank_in = -1;
+int probe_reverb_out = -1;
+
+size_t reverb_control_block = 16;
+float reverb_smoothing;
+
+// make REVERB_RATE=32000 or 24000 runs the reverb at that rate, between a
+// polyphase decimator and two interpolators; the dry path stays at 48 kHz.
+// The input high cut rarely opens past a few kHz and the tank's stops at
+// 14 kHz, so 32 kHz costs next to nothing audible and 24 kHz the top
+// octave of the tail, for a third or a half of the reverb's cycles and
+// delay memory.
+static constexpr size_t reverb_rate = EARTH_REVERB_RATE;
+static constexpr size_t reverb_up = reverb_rate / std::gcd(reverb_rate, (size_t)48000);
+static constexpr size_t reverb_down = 48000 / std::gcd(reverb_rate, (size_t)48000);
+static constexpr bool reverb_resampled = reverb_up != reverb_down;
+static_assert(reverb_rate <= 48000, "the reverb runs at the audio rate or below it");
+static_assert(24 * reverb_up % reverb_down == 0, "audio blocks must resample to whole reverb blocks");
+static constexpr size_t max_reverb_block = max_block_size * reverb_up / reverb_down;
+// The wet path's filter: -6 dB at 0.9 of the lower Nyquist rate and -60 dB
+// (beta 5.65) in the stop band, 16 taps a phase at the higher rate. That
+// leaves a little aliasing in the top octave, which the reverb's wet
+// path doesn't mind.
+struct ReverbResamplerSpec
+{
+    static constexpr double cutoff = 0.9;
+    static constexpr double beta = 5.65;
+};
+template <size_t Up, size_t Down>
+using ReverbResampler =
+    Resampler<Up, Down, Up * ((16 * (Up > Down ? Up : Down) + Up - 1) / Up), ReverbResamplerSpec>;
+static ReverbResampler<reverb_up, reverb_down> reverb_decimate;
+static ReverbResampler<reverb_up, reverb_down> reverb_decimate_r;
+static ReverbResampler<reverb_down, reverb_up> reverb_interpolate_l;
+static ReverbResampler<reverb_down, reverb_up> reverb_interpolate_r;
+float reverb_rate_in[max_reverb_block];
+float reverb_rate_in_r[max_reverb_block];
+float reverb_rate_out_l[max_reverb_block];
+float reverb_rate_out_r[max_reverb_block];
+// Tail gate: once the reverb input and its output have both stayed below
+// -90 dBFS for longer than the pre-delay line, the reverb is cleared and
+// skipped until input returns
+static constexpr float reverb_gate_threshold = 3.1623e-5f;
+// The pre-delay line, in audio samples
+static constexpr size_t reverb_gate_hold_samples = DattorroMemory::kPreDelayLength * reverb_down / reverb_up;
+size_t reverb_gate_hold_blocks = reverb_gate_hold_samples / audio_block_size + 1;
+size_t reverb_quiet_blocks = 0;
+bool reverb_gated = false;
 
 float current_predelay, current_moddepth, current_modspeed, current_ODswell, current_freezeDecay;
 float setTimeScale, current_timeScale, setOD;
 
-Overdrive overdrive;
-Overdrive overdrive2;
+// FS2's momentary overdrive in mode 1, on the reverb's output. The swell
+// is the per-sample .000015 one-pole compounded over an audio block
+// (od_smoothing), with the drive and its compensation set once a block.
+StereoOverdrive overdrive;
+float od_smoothing;
 bool odOn = false;
 
+float blockPeak(const float* buffer, size_t size)
+{
+    float peak = 0.0f;
+    for (size_t i = 0; i < size; i++) {
+        peak = fmaxf(peak, fabsf(buffer[i]));
+    }
+    return peak;
+}
+
+// Ramps a block of reverb input in from silence
+void rampBlock(float* buffer, size_t size)
+{
+    const float step = 1.0f / (float)size;
+    for (size_t i = 0; i < size; i++) {
+        buffer[i] *= (float)(i + 1) * step;
+    }
+}
+
+// Called after each block's reverb output is in reverb_out_l/r: zeroes it
+// while gated, and closes the gate after reverb_gate_hold_blocks of silence
+void updateReverbGate(bool input_quiet, size_t size)
+{
+    if (reverb_gated) {
+        for (size_t i = 0; i < size; i++) {
+            reverb_out_l[i] = reverb_out_r[i] = 0.0f;
+        }
+    } else if (input_quiet
+               && blockPeak(reverb_out_l, size) < reverb_gate_threshold
+               && blockPeak(reverb_out_r, size) < reverb_gate_threshold) {
+        if (++reverb_quiet_blocks >= reverb_gate_hold_blocks) {
+            // The tank's lines are zeroed on the MDMA while the gate is
+            // shut, rather than all in this callback
+            reverb.clearInBackground();
+            reverb_decimate.clear();
+            reverb_decimate_r.clear();
+            reverb_interpolate_l.clear();
+            reverb_interpolate_r.clear();
+            reverb_gated = true;
+            reverb_quiet_blocks = 0;
+        }
+    } else {
+        reverb_quiet_blocks = 0;
+    }
+}
+
 bool knobMoved(float old_value, float new_value)
 {
     float tolerance = 0.005;
@@ -82,37 +252,31 @@ bool knobMoved(float old_value, float new_value)
     }
 }
 
+// The toggles, read in the main loop and made by the callback (RunCommand())
 void updateSwitch1()
 {
-    if (toggleValues[0] == 0) {
-        setTimeScale = 1.0;
-    } else if (toggleValues[0] == 2) {
-        setTimeScale = 4.0;
-    } else {
-        setTimeScale = 2.0;
-    }
-    reverb.setTimeScale(setTimeScale);
+    commands.Post(CMD_TIME_SCALE, toggleValues[0]);
 }
 
 void updateSwitch2() 
 {
     if (toggleValues[1] == 0) {
-        effect_mode = 0;
+        commands.Post(CMD_EFFECT_MODE, 0);
     } else if (toggleValues[1] == 2) {
-        effect_mode = 2;
+        commands.Post(CMD_EFFECT_MODE, 2);
     } else {
-        effect_mode = 1;
+        commands.Post(CMD_EFFECT_MODE, 1);
     }
 }
 
 void updateSwitch3() 
 {
     if (toggleValues[2] == 0) {
-        footswitch_mode = 0;
+        commands.Post(CMD_FOOTSWITCH_MODE, 0);
     } else if (toggleValues[2] == 2) {
-        footswitch_mode = 2;
+        commands.Post(CMD_FOOTSWITCH_MODE, 2);
     } else {
-        footswitch_mode = 1;
+        commands.Post(CMD_FOOTSWITCH_MODE, 1);
     }
 }
 
@@ -122,7 +286,13 @@ void UpdateButtons()
     if(hw.switches[Hothouse::FOOTSWITCH_1].RisingEdge())
     {
         bypass = !bypass;
-        led1.Set(bypass ? 0.0f : 1.0f);
+        hw.SetLed(Hothouse::LED_1, bypass ? 0.0f : 1.0f);
+        if (bypass && spillover) {
+            // Only the tail already in the tank rings out
+            reverb.clearInput();
+            reverb_decimate.clear();
+            reverb_decimate_r.clear();
+        }
     }
 
     // Footswitch 2 - momentary
@@ -147,7 +317,7 @@ void UpdateButtons()
         effect_on_momentary = false;
     }
 
-    led2.Set(fw2_held ? 1.0f : 0.0f);
+    hw.SetLed(Hothouse::LED_2, hw.LoadLed(fw2_held ? 1.0f : 0.0f));
 }
 
 void UpdateSwitches()
@@ -174,43 +344,170 @@ void UpdateSwitches()
     first_start = false;
 }
 
+// The tank's LFOs count at a fixed 32 kHz whatever its rate, so their
+// speed is scaled to keep the modulation Earth has at 48 kHz
+static constexpr float reverb_lfo_scale = (float)reverb_down / reverb_up;
+
+// Reverb parameters, at control rate: once per reverb_control_block
+// samples, the per-sample .0002 one-pole compounded over that many
+// (reverb_smoothing), so the curve is the same. The reverb ramps the
+// pre-delay between updates.
 void processSmoothedParameters()
 {
-    fonepole(current_predelay, ppredelay, .0002f);
+    fonepole(current_predelay, ppredelay, reverb_smoothing);
     reverb.setPreDelay(current_predelay);
 
-    fonepole(current_moddepth, pmoddepth, .0002f);
+    fonepole(current_moddepth, pmoddepth, reverb_smoothing);
     reverb.setTankModDepth(current_moddepth * 8);
 
-    fonepole(current_modspeed, pmodspeed, .0002f);
-    reverb.setTankModSpeed(0.3 + current_modspeed * 15);
+    fonepole(current_modspeed, pmodspeed, reverb_smoothing);
+    reverb.setTankModSpeed((0.3 + current_modspeed * 15) * reverb_lfo_scale);
+
+    if (freeze) {
+        fonepole(current_freezeDecay, 1.0, reverb_smoothing); 
+    } else {
+        fonepole(current_freezeDecay, pdecay, reverb_smoothing); 
+    }
+    reverb.setDecay(current_freezeDecay);
+}
 
+// Runs the reverb over a block of input into reverb_out_l/r, with the
+// parameters updated once per reverb_control_block of audio: left and
+// right, left alone (right nullptr) on both sides, or nothing (left
+// nullptr) for the tank alone on silence. While gated only the
+// parameters move.
+void runReverb(const float* left, const float* right, size_t size)
+{
+    if constexpr (!reverb_resampled) {
+        for (size_t i = 0; i < size; i += reverb_control_block)
+        {
+            const size_t n = size - i < reverb_control_block ? size - i : reverb_control_block;
+            processSmoothedParameters();
+            if (reverb_gated) {
+                continue;
+            } else if (right) {
+                reverb.processBlock(&left[i], &right[i], &reverb_out_l[i], &reverb_out_r[i], n);
+            } else if (left) {
+                reverb.processMonoBlock(&left[i], &reverb_out_l[i], &reverb_out_r[i], n);
+            } else {
+                reverb.processTankBlock(&reverb_out_l[i], &reverb_out_r[i], n);
+            }
+        }
+    } else {
+        const size_t slices = (size + reverb_control_block - 1) / reverb_control_block;
+        if (reverb_gated) {
+            for (size_t s = 0; s < slices; s++) {
+                processSmoothedParameters();
+            }
+            return;
+        }
+
+        // Slices of the reverb block to match the audio block's; at
+        // 32 kHz they aren't all the same length
+        const size_t length = left ? reverb_decimate.process(left, size, reverb_rate_in)
+                                   : size * reverb_up / reverb_down;
+        if (right) {
+            reverb_decimate_r.process(right, size, reverb_rate_in_r);
+        }
+        for (size_t s = 0; s < slices; s++)
+        {
+            const size_t i = s * length / slices;
+            const size_t n = (s + 1) * length / slices - i;
+            processSmoothedParameters();
+            if (right) {
+                reverb.processBlock(&reverb_rate_in[i], &reverb_rate_in_r[i], &reverb_rate_out_l[i], &reverb_rate_out_r[i], n);
+            } else if (left) {
+                reverb.processMonoBlock(&reverb_rate_in[i], &reverb_rate_out_l[i], &reverb_rate_out_r[i], n);
+            } else {
+                reverb.processTankBlock(&reverb_rate_out_l[i], &reverb_rate_out_r[i], n);
+            }
+        }
+        reverb_interpolate_l.process(reverb_rate_out_l, length, reverb_out_l);
+        reverb_interpolate_r.process(reverb_rate_out_r, length, reverb_out_r);
+    }
+}
+
+// Select input for reverb. As in the per-chunk original, the last sample
+// of each chunk comes from that chunk and the others from the chunk
+// before it.
+void selectReverbInput(float* reverb_input, const float* mix, const float* dry, size_t size)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        if (effect_mode != 0) {
+            reverb_input[i] = (i % resample_factor == resample_factor - 1) ? mix[resample_factor + i] : mix[i];
+        } else {
+            reverb_input[i] = dry[i];
+        }
+    }
+}
+
+void processOverdriveSwell(size_t size)
+{
     if (odOn) {
-        fonepole(current_ODswell, setOD, .000015f);
-        overdrive.SetDrive(current_ODswell);
-        overdrive2.SetDrive(current_ODswell);
+        fonepole(current_ODswell, setOD, od_smoothing);
+        const float od_compensation = 1.0f - (current_ODswell * current_ODswell * 2.8f - 0.1296f);
+        overdrive.set_drive(current_ODswell, od_compensation, size);
         if (current_ODswell < 0.41 && !fw2_held) {
             odOn = false;
         }
     }
+}
 
-    if (freeze) {
-        fonepole(current_freezeDecay, 1.0, .0002f); 
-    } else {
-        fonepole(current_freezeDecay, pdecay, .0002f); 
+// Applies a command from the main loop, at the top of a block
+void RunCommand(const Command& command)
+{
+    switch (command.type) {
+        case CMD_MIDI_KNOB:
+            // The knob then follows MIDI until it is turned by hand
+            midi_control[command.index] = true;
+            knobValues[command.index] = command.value;
+            break;
+        case CMD_MIDI_CLOCK:
+            if (command.index == MIDI_CLOCK_TICK) {
+                midi_tempo.MidiTick();
+            } else if (command.index == MIDI_CLOCK_START) {
+                midi_tempo.MidiStart();
+            } else {
+                midi_tempo.MidiStop();
+            }
+            break;
+        case CMD_TIME_SCALE:
+            // UP 1x, MIDDLE 2x, DOWN 4x (Dattorro1997Tank::kTimeScales), faded
+            reverb.selectTimeScale(command.index);
+            setTimeScale = Dattorro1997Tank::kTimeScales[command.index];
+            break;
+        case CMD_EFFECT_MODE:
+            effect_mode = command.index;
+            break;
+        case CMD_FOOTSWITCH_MODE:
+            footswitch_mode = command.index;
+            break;
     }
-    reverb.setDecay(current_freezeDecay);
 }
 
-static void AudioCallback(AudioHandle::InputBuffer in,
+HOTHOUSE_ITCM static void AudioCallback(AudioHandle::InputBuffer in,
                           AudioHandle::OutputBuffer out,
                           size_t size)
 {
-    hw.ProcessAllControls();
-    UpdateButtons();
-    UpdateSwitches();
-    led1.Update();
-    led2.Update();
+    commands.Drain(command_budget, RunCommand);
+    tempo_events.Events(midi_tempo, size, [](int id, size_t at) {
+        beat_flash = id == EventSchedulerBase::kBeat;
+        if (beat_flash) {
+            tempo_events.Cancel(BEAT_FLASH_END);
+            tempo_events.Post(midi_tempo, at + beat_flash_samples, BEAT_FLASH_END);
+        }
+        hw.SetLed(Hothouse::LED_1, bypass || beat_flash ? 0.0f : 1.0f);
+    });
+
+    if (++control_block_counter >= control_interval_blocks) {
+        control_block_counter = 0;
+        hw.ProcessAllControls();
+#ifdef EARTH_EXPRESSION_PIN
+        vexpression = hw.expression.Process();
+#endif
+        UpdateButtons();
+    }
 
     // Read knobs
     float newExpressionValues[6];
@@ -224,7 +521,6 @@ static void AudioCallback(AudioHandle::InputBuffer in,
         }
     }
 
-    float vexpression = 0.5f;
     expHandler.Process(vexpression, knobValues, newExpressionValues);
   
     float vpredelay = newExpressionValues[0];
@@ -236,17 +532,10 @@ static void AudioCallback(AudioHandle::InputBuffer in,
 
     if (pmix != vmix) {
         if (knobMoved(pmix, vmix)) {
-            float x2 = 1.0 - vmix;
-            float A = vmix*x2;
-            float B = A * (1.0 + 1.4186 * A);
-            float C = B + vmix;
-            float D = B + x2;
-
-            wetMix = C * C;
-            dryMix = D * D;
             pmix = vmix;
         }
     }
+    mixRamp.SetMix(pmix, size);
 
     if (knobMoved(ppredelay, vpredelay)) {
         ppredelay = vpredelay;
@@ -274,24 +563,53 @@ static void AudioCallback(AudioHandle::InputBuffer in,
     float inputL;
     float inputR;
 
+    // Stereo input: the dry path and the reverb take IN L and IN R, and the
+    // octave runs once, on their sum, so it costs no more than in mono
+    const float* in_l = in[0];
+    const float* in_r = stereo_input ? in[1] : in[0];
+
+    // Full CPU clock back before any DSP; trails count (make POWER_SAVE=1)
+    hw.SetBypassed(bypass && !(spillover && !reverb_gated));
     if(!bypass) {
-        for (size_t i = 0; i < size; i++)
-        {
-            processSmoothedParameters();
-            inputL = inputR = in[0][i];
-            
-            // Buffer input for octave processing
-            buff[bin_counter] = inputL;
-            
-            // Process octave every 6 samples
-            if (bin_counter == 5) {
-                if (effect_mode != 0) {
-                    std::span<const float, resample_factor> in_chunk(&(buff[0]), resample_factor);
-                    const auto sample = decimate(in_chunk); 
-                    
+        const bool close_tank = freeze && footswitch_mode == 0 && current_freezeDecay >= freeze_closed_decay;
+        if (tank_closed && close_tank) {
+            // Frozen: the tank alone, closed on itself
+            runReverb(nullptr, nullptr, size);
+            hw.Probe(probe_reverb_out, reverb_out_l, size);
+            updateReverbGate(true, size);
+        } else {
+            const bool reopening = tank_closed;
+            if (reopening) {
+                reverb.clearInput();
+                reverb_decimate.clear();
+                reverb_decimate_r.clear();
+            }
+            // Octave: the whole block is resampled in one pass
+            if (effect_mode != 0) {
+                const float* octave_source = in_l;
+                if (stereo_input) {
+                    for (size_t j = 0; j < size; ++j) {
+                        mono_in[j] = 0.5f * (in_l[j] + in_r[j]);
+                    }
+                    octave_source = mono_in;
+                }
+                decimate.decimate(octave_source, octave_in, octave_block_size);
+                for (size_t n = 0; n < octave_block_size; ++n) {
                     float octave_mix = 0.0;
-                    octave.update(sample);
-                    
+#if EARTH_HILBERT_OCTAVE
+                    if (effect_mode == 1) {
+                        octave_up_lite.update(octave_in[n]);
+                        octave_out[n] = octave_up_lite.up1() * 2.0;
+                        continue;
+                    }
+#endif
+                    // Mode 1 reads only the octave up
+                    if (effect_mode == 2) {
+                        octave.update(octave_in[n]);
+                    } else {
+                        octave.update<OCTAVE_UP1>(octave_in[n]);
+                    }
+
                     if (effect_mode == 1 || effect_mode == 2) {
                         octave_mix += octave.up1() * 2.0;
                     }
@@ -299,62 +617,98 @@ static void AudioCallback(AudioHandle::InputBuffer in,
                         octave_mix += octave.down1() * 2.0;
                         octave_mix += octave.down2() * 2.0;
                     }
-                    
-                    auto out_chunk = interpolate(octave_mix);
-                    for (size_t j = 0; j < out_chunk.size(); ++j) {
-                        float mix = eq2(eq1(out_chunk[j]));
-                        float dryLevel = 0.5;
-                        mix += dryLevel * buff[j];
-                        buff_out[j] = mix;
-                    }
-                } else {
-                    for (size_t j = 0; j < 6; ++j) {
-                        buff_out[j] = buff[j];
+                    octave_out[n] = octave_mix;
+                }
+                octave_eq.ProcessBlock(octave_out, octave_block_size);
+                interpolate.interpolate(octave_out, octave_up, octave_block_size);
+                const float dryLevel = 0.5;
+                for (size_t j = 0; j < size; ++j) {
+                    buff_out[resample_factor + j] = octave_up[j] + dryLevel * in_l[j];
+                }
+                if (stereo_input) {
+                    for (size_t j = 0; j < size; ++j) {
+                        buff_out_r[resample_factor + j] = octave_up[j] + dryLevel * in_r[j];
                     }
                 }
-            }
-            
-            // Select input for reverb
-            float reverb_in;
-            if (effect_mode != 0 && bin_counter < 6) {
-                reverb_in = buff_out[bin_counter];
             } else {
-                reverb_in = inputL;
+                for (size_t j = 0; j < size; ++j) {
+                    buff_out[resample_factor + j] = in_l[j];
+                }
             }
-            
-            // Process reverb
-            reverb.process(reverb_in, reverb_in);
-            
-            // Get outputs
-            float effectLeftOut = reverb.getLeftOutput();  
-            float effectRightOut = reverb.getRightOutput();
-            
-            // Apply overdrive using original formula
-            if (odOn && footswitch_mode == 1 && fw2_held) {
-                float od_compensation = 1.0f - (current_ODswell * current_ODswell * 2.8f - 0.1296f);
-                effectLeftOut = overdrive.Process(effectLeftOut * 0.25f) * od_compensation;
-                effectRightOut = overdrive2.Process(effectRightOut * 0.25f) * od_compensation;
+
+            selectReverbInput(reverb_in, buff_out, in_l, size);
+            if (reopening) {
+                rampBlock(reverb_in, size);
+            }
+            float input_peak = blockPeak(reverb_in, size);
+            if (stereo_input) {
+                selectReverbInput(reverb_in_r, buff_out_r, in_r, size);
+                if (reopening) {
+                    rampBlock(reverb_in_r, size);
+                }
+                input_peak = fmaxf(input_peak, blockPeak(reverb_in_r, size));
+            }
+            const bool input_quiet = input_peak < reverb_gate_threshold;
+            if (reverb_gated && !input_quiet) {
+                reverb.finishClear();
+                reverb_gated = false;
+            }
+
+            if (close_tank) {
+                reverb.fadeOutInput(size * reverb_up / reverb_down);
+            }
+            hw.Probe(probe_tank_in, reverb_in, size);
+            runReverb(reverb_in, stereo_input ? reverb_in_r : nullptr, size);
+            hw.Probe(probe_reverb_out, reverb_out_l, size);
+            updateReverbGate(input_quiet, size);
+            tank_closed = close_tank;
+
+            for (size_t j = 0; j < resample_factor; ++j) {
+                buff_out[j] = buff_out[size + j];
+                buff_out_r[j] = buff_out_r[size + j]; // unused in mono
             }
+        }
+
+        processOverdriveSwell(size);
+        if (odOn && footswitch_mode == 1 && fw2_held) {
+            overdrive.process(reverb_out_l, reverb_out_r, size, 0.25f);
+        }
+
+        for (size_t i = 0; i < size; i++)
+        {
+            inputL = in_l[i];
+            inputR = in_r[i];
+
+            float effectLeftOut = reverb_out_l[i];
+            float effectRightOut = reverb_out_r[i];
             
             // Mix with freeze reduction
             float freeze_reduction = (freeze && footswitch_mode == 0) ? 0.6f : 1.0f;
-            float leftOutput = inputL * dryMix + effectLeftOut * wetMix * 0.5f * freeze_reduction;
-            float rightOutput = inputR * dryMix + effectRightOut * wetMix * 0.5f * freeze_reduction;
+            mixRamp.Next();
+            float leftOutput = inputL * mixRamp.Dry() + effectLeftOut * mixRamp.Wet() * 0.5f * freeze_reduction;
+            float rightOutput = inputR * mixRamp.Dry() + effectRightOut * mixRamp.Wet() * 0.5f * freeze_reduction;
             
             out[0][i] = leftOutput;
             out[1][i] = rightOutput;
-            
-            // Update bin counter
-            bin_counter++;
-            if (bin_counter >= 6) {
-                bin_counter = 0;
-            }
+        }
+    } else if (spillover && !reverb_gated) {
+        // Trails: the tank runs on silence, octave and overdrive are idle
+        runReverb(nullptr, nullptr, size);
+        updateReverbGate(true, size);
+
+        float freeze_reduction = (freeze && footswitch_mode == 0) ? 0.6f : 1.0f;
+        for (size_t i = 0; i < size; i++)
+        {
+            mixRamp.Next();
+            out[0][i] = in_l[i] + reverb_out_l[i] * mixRamp.Wet() * 0.5f * freeze_reduction;
+            out[1][i] = in_r[i] + reverb_out_r[i] * mixRamp.Wet() * 0.5f * freeze_reduction;
         }
     } else {
+        mixRamp.Finish();
         for (size_t i = 0; i < size; i++)
         {
-            out[0][i] = in[0][i];
-            out[1][i] = in[0][i];
+            out[0][i] = in_l[i];
+            out[1][i] = in_r[i];
         }
     }
 }
@@ -374,37 +728,22 @@ void HandleMidiMessage(MidiEvent m)
         break;
         case ControlChange:
         {
+            // CC 14-19 set knobs 1-6
             ControlChangeEvent p = m.AsControlChange();
-            switch(p.control_number)
-            {
-                case 14:
-                    midi_control[0] = true;
-                    knobValues[0] = ((float)p.value / 127.0f);
-                    break;
-                case 15:
-                    midi_control[1] = true;
-                    knobValues[1] = ((float)p.value / 127.0f);
-                    break;
-                case 16:
-                    midi_control[2] = true;
-                    knobValues[2] = ((float)p.value / 127.0f);
-                    break;
-                case 17:
-                    midi_control[3] = true;
-                    knobValues[3] = ((float)p.value / 127.0f);
-                    break;
-                case 18:
-                    midi_control[4] = true;
-                    knobValues[4] = ((float)p.value / 127.0f);
-                    break;
-                case 19:
-                    midi_control[5] = true;
-                    knobValues[5] = ((float)p.value / 127.0f);
-                    break;
-                default: break;
+            if (p.control_number >= 14 && p.control_number <= 19) {
+                commands.Post(CMD_MIDI_KNOB, p.control_number - 14, (float)p.value / 127.0f);
             }
             break;
         }
+        case SystemRealTime:
+            if (m.srt_type == TimingClock) {
+                commands.Post(CMD_MIDI_CLOCK, MIDI_CLOCK_TICK);
+            } else if (m.srt_type == Start) {
+                commands.Post(CMD_MIDI_CLOCK, MIDI_CLOCK_START);
+            } else if (m.srt_type == Stop) {
+                commands.Post(CMD_MIDI_CLOCK, MIDI_CLOCK_STOP);
+            }
+            break;
         default: break;
     }
 }
@@ -414,10 +753,25 @@ int main(void)
     float samplerate;
 
     hw.Init();
-    hw.SetAudioBlockSize(48);
+    hw.SelectAudioProfile(audio_profiles);
+    audio_block_size = hw.AudioBlockSize();
+    octave_block_size = audio_block_size / resample_factor;
+    control_interval_blocks = audio_block_size < 48 ? 48 / audio_block_size : 1;
+    reverb_control_block = audio_block_size % 16 == 0 ? 16 : 8;
+    reverb_gate_hold_blocks = reverb_gate_hold_samples / audio_block_size + 1;
     samplerate = hw.AudioSampleRate();
-
-    reverb.setSampleRate(samplerate);
+#ifdef EARTH_EXPRESSION_PIN
+    // The expression filter runs at the control scan rate; the knobs are
+    // averaged by the ADC
+    hw.InitExpression(hw.seed.GetPin(EARTH_EXPRESSION_PIN));
+    hw.expression.SetSampleRate(hw.AudioCallbackRate() / control_interval_blocks);
+#endif
+    reverb_smoothing = 1.0f - powf(1.0f - .0002f, reverb_control_block);
+    od_smoothing = 1.0f - powf(1.0f - .000015f, audio_block_size);
+    midi_tempo.Init(samplerate, 0.2f, 2.0f);  // 30 to 300 BPM
+
+    reverb.setSampleRate(samplerate * reverb_up / reverb_down);
+    reverb.setTankSampleRate(DattorroMemory::kTankSampleRate);
     reverb.setTimeScale(2.0);
     reverb.setPreDelay(0.0);
     reverb.setInputFilterLowCutoffPitch(0.0);
@@ -431,20 +785,20 @@ int main(void)
     reverb.setTankModDepth(0.0);
     reverb.setTankModShape(0.5);
     reverb.clear();
+    hw.BootMark("reverb");
 
-    for (int j = 0; j < 6; ++j) {
-        buff[j] = 0.0;
-        buff_out[j] = 0.0;
-    }
+    // Skip the octave maths for bands below -80 dB; the octaves feed the
+    // reverb, so keep the threshold low enough not to thin its tails
+    octave.setCullThreshold(0.0001f);
+    octave_eq.SetStage(0, biquad::HighShelf(-11.0f, 140.0f, sample_rate_temp / resample_factor));
+    octave_eq.SetStage(1, biquad::LowShelf(5.0f, 160.0f, sample_rate_temp / resample_factor));
 
-    overdrive.Init();
-    overdrive.SetDrive(0.4);
-    overdrive2.Init();
-    overdrive2.SetDrive(0.4);
+    overdrive.reset(0.4f, 1.0f - (0.4f * 0.4f * 2.8f - 0.1296f));
     odOn = false;
 
     pdamp = 0.5f;
     pmix = 0.5f;
+    mixRamp.Init(pmix);
     pdecay = 0.5f;
     pmoddepth = 0.1f;
     pmodspeed = 0.5f;
@@ -462,7 +816,7 @@ int main(void)
     current_ODswell = 0.4f;
     setOD = 0.4f;
 
-    expHandler.Init(6);
+    expHandler.Init();
     expression_pressed = false;
 
     for(int i = 0; i < 6; ++i) 
@@ -476,17 +830,77 @@ int main(void)
 
     led2.Init(hw.seed.GetPin(Hothouse::LED_2), false);
     led2.Update();
+    hw.StartLedService();
+
+    // FOOTSWITCH 2 held at power-on selects spillover bypass (the switches
+    // are settled by SelectAudioProfile())
+    spillover = hw.switches[Hothouse::FOOTSWITCH_2].Pressed();
+    // and FOOTSWITCH 1 stereo input
+    stereo_input = hw.switches[Hothouse::FOOTSWITCH_1].Pressed();
+
+    MidiUsbHandler::Config midi_cfg;
+    midi_cfg.transport_config.periph = MidiUsbTransport::Config::INTERNAL;
+    midi.Init(midi_cfg);
+    midi.StartReceive();
+    hw.BootMark("MIDI");
+
+    probe_tank_in = hw.AddProbe("tank in", probe_frames);
+    probe_reverb_out = hw.AddProbe("reverb out L", probe_frames);
+
+    // The tank's feedback loop, for make DENORMAL_CHECK=1
+    hw.WatchDenormals(DattorroMemory::leftApf1, DattorroMemory::kLeftApf1Length, "tank apf 1L");
+    hw.WatchDenormals(DattorroMemory::leftApf2, DattorroMemory::kLeftApf2Length, "tank apf 2L");
+    hw.WatchDenormals(DattorroMemory::rightApf1, DattorroMemory::kRightApf1Length, "tank apf 1R");
+    hw.WatchDenormals(DattorroMemory::rightApf2, DattorroMemory::kRightApf2Length, "tank apf 2R");
+    hw.WatchDenormals(DattorroMemory::leftDelay1, DattorroMemory::kLeftDelay1Length, "tank delay 1L");
+    hw.WatchDenormals(DattorroMemory::leftDelay2, DattorroMemory::kLeftDelay2Length, "tank delay 2L");
+    hw.WatchDenormals(DattorroMemory::rightDelay1, DattorroMemory::kRightDelay1Length, "tank delay 1R");
+    hw.WatchDenormals(DattorroMemory::rightDelay2, DattorroMemory::kRightDelay2Length, "tank delay 2R");
 
     hw.StartAdc();
+    // The toggles' settings play from the first block
+    UpdateSwitches();
     hw.StartAudio(AudioCallback);
     
     while(1)
     {
+        // CPU load over USB serial (make LOAD_METER=1)
+        hw.ServiceLoadMeter();
+        // Callback overruns over USB serial and into QSPI (make WATCHDOG=1)
+        hw.ServiceWatchdog();
+        // Time to each boot phase over USB serial (make BOOT_TIMING=1)
+        hw.ServiceBootTiming();
+        // Heap allocations inside the audio callback over USB serial (make ALLOC_CHECK=1)
+        hw.ServiceAllocCheck();
+        // Stack and heap high-water marks over USB serial (make MEMORY_REPORT=1)
+        hw.ServiceMemoryReport();
+        // Subnormals and NaNs in the callback and the tank (make DENORMAL_CHECK=1)
+        hw.ServiceDenormalCheck();
+        // Half the CPU clock after 5 s in bypass (make POWER_SAVE=1)
+        hw.ServicePower();
+        // Signal probes armed and dumped over USB serial (make PROBE=1)
+        hw.ServiceProbes();
+        // Round-trip latency through a loopback cable (make LATENCY_TEST=1)
+        hw.ServiceLatencyTest();
+        // The reports above as binary records over USB serial (make TELEMETRY=1)
+        hw.ServiceTelemetry();
+
+        // The toggles, as commands to the callback
+        UpdateSwitches();
+
+        midi.Listen();
+        while(midi.HasEvents())
+        {
+            HandleMidiMessage(midi.PopEvent());
+        }
+
+
         // Check for bootloader reset in main loop
         if(hw.switches[Hothouse::FOOTSWITCH_1].TimeHeldMs() >= 2000)
         {
             hw.StopAudio();
             hw.StopAdc();
+            hw.StopLedService();
             
             for(int i = 0; i < 3; i++) 
             {
@@ -506,6 +920,6 @@ int main(void)
             System::ResetToBootloader();
         }
         
-        System::Delay(100);
+        hw.IdleMs(1);
     }
 }
@@ -4,50 +4,45 @@
 #ifndef EXPRESSION_HANDLER_H
 #define EXPRESSION_HANDLER_H
 
+// N parameters, stored inline (no heap). Parameters not assigned to the
+// expression pedal pass their knob value through; with none assigned,
+// Process() is a plain copy.
+template <int N>
 class ExpressionHandler {
 private:
     bool expression_set_mode;
-    int num_params;
-    float* heel_values;
-    float* toe_values;
-    bool* param_active;
+    float heel_values[N];
+    float toe_values[N];
+    bool param_active[N];
+    int num_active;
     float led1_brightness;
     float led2_brightness;
     
 public:
-    ExpressionHandler() : expression_set_mode(false), num_params(0), 
-                          heel_values(nullptr), toe_values(nullptr), 
-                          param_active(nullptr), led1_brightness(0.1f), 
-                          led2_brightness(0.1f) {}
-    
-    void Init(int params) {
-        num_params = params;
-        heel_values = new float[num_params];
-        toe_values = new float[num_params];
-        param_active = new bool[num_params];
-        
-        for(int i = 0; i < num_params; i++) {
-            heel_values[i] = 0.0f;
-            toe_values[i] = 1.0f;
-            param_active[i] = false;
-        }
+    ExpressionHandler() : expression_set_mode(false), num_active(0),
+                          led1_brightness(0.1f), led2_brightness(0.1f) {
+        Reset();
     }
     
-    ~ExpressionHandler() {
-        if(heel_values) delete[] heel_values;
-        if(toe_values) delete[] toe_values;
-        if(param_active) delete[] param_active;
+    void Init() {
+        Reset();
     }
     
-    void Process(float expression_value, float* knob_values, float* output_values) {
-        for(int i = 0; i < num_params; i++) {
-            if(param_active[i]) {
-                // Linear interpolation between heel and toe values
-                output_values[i] = heel_values[i] + (toe_values[i] - heel_values[i]) * expression_value;
-            } else {
-                // Pass through knob value if not controlled by expression
+    void Process(float expression_value, const float* knob_values, float* output_values) {
+        if(num_active == 0) {
+            for(int i = 0; i < N; i++) {
                 output_values[i] = knob_values[i];
             }
+        } else {
+            for(int i = 0; i < N; i++) {
+                if(param_active[i]) {
+                    // Linear interpolation between heel and toe values
+                    output_values[i] = heel_values[i] + (toe_values[i] - heel_values[i]) * expression_value;
+                } else {
+                    // Pass through knob value if not controlled by expression
+                    output_values[i] = knob_values[i];
+                }
+            }
         }
         
         if(expression_set_mode) {
@@ -65,6 +60,11 @@ public:
         return expression_set_mode;
     }
     
+    // True if any parameter follows the expression pedal
+    bool hasActiveParameters() const {
+        return num_active > 0;
+    }
+    
     float returnLed1Brightness() {
         return led1_brightness;
     }
@@ -75,27 +75,29 @@ public:
     
     void Reset() {
         expression_set_mode = false;
-        for(int i = 0; i < num_params; i++) {
+        for(int i = 0; i < N; i++) {
             heel_values[i] = 0.0f;
             toe_values[i] = 1.0f;
             param_active[i] = false;
         }
+        num_active = 0;
     }
     
     void SetParameterActive(int param, bool active) {
-        if(param < num_params) {
+        if(param >= 0 && param < N && param_active[param] != active) {
             param_active[param] = active;
+            num_active += active ? 1 : -1;
         }
     }
     
     void SetHeelValue(int param, float value) {
-        if(param < num_params) {
+        if(param >= 0 && param < N) {
             heel_values[param] = value;
         }
     }
     
     void SetToeValue(int param, float value) {
-        if(param < num_params) {
+        if(param >= 0 && param < N) {
             toe_values[param] = value;
         }
     }
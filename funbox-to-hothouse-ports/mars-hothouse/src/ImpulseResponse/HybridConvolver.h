@@ -0,0 +1,273 @@
+//
+//  HybridConvolver.h
+//
+//  Zero-latency non-uniform partitioned convolution for the Mars IR stage.
+//
+//  The IR is split into three segments:
+//    [0, Head)                direct-form FIR, mirrored ring buffer
+//    [Head, Stage2)           PartitionedConvolver<Head>   (latency Head)
+//    [Stage2, length)         PartitionedConvolver<Stage2> (latency Stage2)
+//
+//  Each FFT segment starts at a tap offset equal to its own latency, so its
+//  buffering delay is exactly absorbed and the summed output is sample-aligned
+//  with the input for any block size, down to a single sample. Short cabinet
+//  IRs (<= Stage2 taps) never touch the large stage.
+//
+//  As with PartitionedConvolver, the coefficients (HybridKernel) are separate
+//  from the running state so IRs can be prepared at boot and swapped by pointer.
+//  The FFT stages' spectra are carved from the Arena given at init.
+
+#pragma once
+
+#include <cstddef>
+#include <algorithm>
+#include "PartitionedConvolver.h"
+
+
+template <size_t Head = 64, size_t Stage2 = 512>
+struct HybridKernel
+{
+  static_assert(Head % 4 == 0, "Head length must be a multiple of 4");
+  static_assert(Stage2 > Head, "Second stage must use larger partitions");
+
+  // weights are in natural order (weights[0] is the first tap). Carves
+  // the FFT stages from arena - call at init, not from the audio callback.
+  // Returns false if they don't all fit: the kernel is then cut to the
+  // stages that did.
+  bool Prepare(const float* weights, size_t len, clevelandmusicco::Arena& arena)
+  {
+    length = len;
+
+    // Head taps stored reversed so the dot product walks forward in time
+    std::fill(headTaps, headTaps + Head, 0.0f);
+    const size_t headCount = std::min(length, Head);
+    for (size_t i = 0; i < headCount; i++)
+      headTaps[Head - 1 - i] = weights[i];
+
+    if (length > Head && !stage1.Prepare(weights + Head, std::min(length, Stage2) - Head, arena))
+      length = Head;
+    if (length > Stage2 && !stage2.Prepare(weights + Stage2, length - Stage2, arena))
+      length = Stage2;
+    return length == len;
+  }
+
+  // Room for a Blend() of kernels of up to len taps, silent until then.
+  // Carves from arena, as Prepare().
+  bool Reserve(size_t len, clevelandmusicco::Arena& arena)
+  {
+    length = 0;
+    std::fill(headTaps, headTaps + Head, 0.0f);
+    const bool fits1 = stage1.Reserve(len > Head ? std::min(len, Stage2) - Head : 0, arena);
+    const bool fits2 = stage2.Reserve(len > Stage2 ? len - Stage2 : 0, arena);
+    return fits1 && fits2;
+  }
+
+  // The most floats Prepare() carves for len taps, and what Reserve() and
+  // HybridConvolver::Init() carve for up to len
+  static constexpr size_t Floats(size_t len)
+  {
+    return PartitionedKernel<Head>::Floats(len > Head ? (len < Stage2 ? len : Stage2) - Head : 0)
+           + PartitionedKernel<Stage2>::Floats(len > Stage2 ? len - Stage2 : 0);
+  }
+
+  // (1 - mix) * a + mix * b, segment by segment: the kernel of the blended
+  // IR. Allocation-free; a and b must fit the Reserve() length.
+  void Blend(const HybridKernel& a, const HybridKernel& b, float mix)
+  {
+    length = std::max(a.length, b.length);
+    for (size_t i = 0; i < Head; i++)
+      headTaps[i] = (1.0f - mix) * a.headTaps[i] + mix * b.headTaps[i];
+    if (UsesStage1())
+      stage1.Blend(a.stage1, b.stage1, mix);
+    if (UsesStage2())
+      stage2.Blend(a.stage2, b.stage2, mix);
+  }
+
+  bool UsesStage1() const { return length > Head; }
+  bool UsesStage2() const { return length > Stage2; }
+
+  float headTaps[Head] = {};
+  PartitionedKernel<Head> stage1;
+  PartitionedKernel<Stage2> stage2;
+  size_t length = 0;
+};
+
+
+template <size_t Head = 64, size_t Stage2 = 512>
+class HybridConvolver
+{
+public:
+  typedef HybridKernel<Head, Stage2> Kernel;
+
+  HybridConvolver() {}
+  ~HybridConvolver() {}
+
+  // Prepares an internally owned kernel and sizes the state for it, both
+  // carved from arena - call at init, not from the audio callback. Returns
+  // false if they don't fit.
+  bool Init(const float* weights, size_t length, clevelandmusicco::Arena& arena)
+  {
+    const bool fits = mOwnKernel.Prepare(weights, length, arena);
+    const bool stagesFit = Init(mOwnKernel.length, arena);
+    SetKernel(&mOwnKernel);
+    return fits && stagesFit;
+  }
+
+  // Sizes the FFT stages for kernels of up to maxLength taps, carved from
+  // arena, and resets. Returns false if they don't fit.
+  bool Init(size_t maxLength, clevelandmusicco::Arena& arena)
+  {
+    const size_t stage1Taps = maxLength > Head ? std::min(maxLength, Stage2) - Head : 0;
+    const size_t stage2Taps = maxLength > Stage2 ? maxLength - Stage2 : 0;
+    const bool fits1 = mStage1.Init((stage1Taps + Head - 1) / Head, arena);
+    const bool fits2 = mStage2.Init((stage2Taps + Stage2 - 1) / Stage2, arena);
+    mKernel = nullptr;
+    Reset();
+    return fits1 && fits2;
+  }
+
+  // Points the convolver at a prepared kernel and clears all history.
+  // Allocation-free; kernel must outlive its use and fit the Init() size.
+  void SetKernel(const Kernel* kernel)
+  {
+    SetKernels(kernel, nullptr);
+  }
+
+  // A second kernel on the same input, for the stereo ProcessBlock(): the
+  // FFT stages transform the input once for both (see
+  // PartitionedConvolver::SetKernels()). Allocation-free, as SetKernel().
+  void SetKernels(const Kernel* kernel, const Kernel* right)
+  {
+    mKernel = kernel;
+    mKernelRight = right;
+    mStage1.SetKernels(kernel && kernel->UsesStage1() ? &kernel->stage1 : nullptr,
+                       right && right->UsesStage1() ? &right->stage1 : nullptr);
+    mStage2.SetKernels(kernel && kernel->UsesStage2() ? &kernel->stage2 : nullptr,
+                       right && right->UsesStage2() ? &right->stage2 : nullptr);
+    Reset();
+  }
+
+  const Kernel* GetKernel() const { return mKernel; }
+
+  void Reset()
+  {
+    std::fill(mRing, mRing + 2 * Head, 0.0f);
+    mRingPos = 0;
+    mStage1.Reset();
+    mStage2.Reset();
+  }
+
+  // Convolve size samples, any size. in and out may alias.
+  void ProcessBlock(const float* in, float* out, size_t size)
+  {
+    if (!mKernel)
+    {
+      std::fill(out, out + size, 0.0f);
+      return;
+    }
+
+    const float* taps = mKernel->headTaps;
+    const bool useStage1 = mKernel->UsesStage1();
+    const bool useStage2 = mKernel->UsesStage2();
+
+    while (size > 0)
+    {
+      const size_t count = std::min(size, kChunk);
+      float chunk[kChunk];
+      std::copy(in, in + count, chunk);
+
+      for (size_t i = 0; i < count; i++)
+        out[i] = _ProcessHead(chunk[i], taps);
+      if (useStage1)
+        mStage1.AccumulateDelayed(chunk, out, count);
+      if (useStage2)
+        mStage2.AccumulateDelayed(chunk, out, count);
+
+      in += count;
+      out += count;
+      size -= count;
+    }
+  }
+
+  // Convolve size samples through both kernels from SetKernels(), which
+  // must both be set, into out and outRight. in may alias out, not outRight.
+  void ProcessBlock(const float* in, float* out, float* outRight, size_t size)
+  {
+    if (!mKernel || !mKernelRight)
+    {
+      std::fill(out, out + size, 0.0f);
+      std::fill(outRight, outRight + size, 0.0f);
+      return;
+    }
+
+    const float* taps = mKernel->headTaps;
+    const float* tapsRight = mKernelRight->headTaps;
+    const bool useStage1 = mKernel->UsesStage1() || mKernelRight->UsesStage1();
+    const bool useStage2 = mKernel->UsesStage2() || mKernelRight->UsesStage2();
+
+    while (size > 0)
+    {
+      const size_t count = std::min(size, kChunk);
+      float chunk[kChunk];
+      std::copy(in, in + count, chunk);
+
+      for (size_t i = 0; i < count; i++)
+      {
+        _Push(chunk[i]);
+        out[i] = _Head(taps);
+        outRight[i] = _Head(tapsRight);
+      }
+      if (useStage1)
+        mStage1.AccumulateDelayed(chunk, out, outRight, count);
+      if (useStage2)
+        mStage2.AccumulateDelayed(chunk, out, outRight, count);
+
+      in += count;
+      out += count;
+      outRight += count;
+      size -= count;
+    }
+  }
+
+private:
+  static constexpr size_t kChunk = Head;
+
+  inline float _ProcessHead(float x, const float* taps)
+  {
+    _Push(x);
+    return _Head(taps);
+  }
+
+  inline void _Push(float x)
+  {
+    // Mirrored ring: every sample is written twice so the last Head samples
+    // are always contiguous at &mRing[mRingPos + 1], oldest first.
+    mRing[mRingPos] = x;
+    mRing[mRingPos + Head] = x;
+    mRingPos = (mRingPos + 1 == Head) ? 0 : mRingPos + 1;
+  }
+
+  inline float _Head(const float* taps) const
+  {
+    const float* window = &mRing[mRingPos];
+    float acc0 = 0.0f, acc1 = 0.0f, acc2 = 0.0f, acc3 = 0.0f;
+    for (size_t k = 0; k < Head; k += 4)
+    {
+      acc0 += window[k]     * taps[k];
+      acc1 += window[k + 1] * taps[k + 1];
+      acc2 += window[k + 2] * taps[k + 2];
+      acc3 += window[k + 3] * taps[k + 3];
+    }
+    return (acc0 + acc1) + (acc2 + acc3);
+  }
+
+  Kernel mOwnKernel;  // used by Init(weights, length)
+  const Kernel* mKernel = nullptr;
+  const Kernel* mKernelRight = nullptr;  // SetKernels() only
+
+  float mRing[2 * Head] = {};
+  size_t mRingPos = 0;
+
+  PartitionedConvolver<Head> mStage1;
+  PartitionedConvolver<Stage2> mStage2;
+};
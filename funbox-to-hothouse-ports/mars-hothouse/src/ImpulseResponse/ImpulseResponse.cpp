@@ -22,10 +22,9 @@ ImpulseResponse::~ImpulseResponse()
 }
 
 
-void ImpulseResponse::Init(std::vector<float> irData)
+bool ImpulseResponse::Init(clevelandmusicco::Span<const float> irData, clevelandmusicco::Arena& arena)
 {
-  mRawAudio = irData;
-  _SetWeights();
+  return _SetWeights(irData.data(), irData.size(), arena);
 }
 
 float ImpulseResponse::Process(float inputs)
@@ -33,35 +32,319 @@ float ImpulseResponse::Process(float inputs)
 
   _UpdateHistory(inputs);
 
-  int j = mHistoryIndex - mHistoryRequired;
-  auto input = Eigen::Map<const Eigen::VectorXf>(&mHistory[j], mHistoryRequired + 1);
-  
+  const float* input = &mHistory[mHistoryIndex - mHistoryRequired];
+  const float* w = mWeight;
+  const size_t n = mWeightCount;
+
+  // Four accumulators so the multiply-adds don't wait on each other
+  float acc0 = 0.0f, acc1 = 0.0f, acc2 = 0.0f, acc3 = 0.0f;
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4)
+  {
+    acc0 += w[i] * input[i];
+    acc1 += w[i + 1] * input[i + 1];
+    acc2 += w[i + 2] * input[i + 2];
+    acc3 += w[i + 3] * input[i + 3];
+  }
+  for (; i < n; i++)
+    acc0 += w[i] * input[i];
+
   _AdvanceHistoryIndex(1); // KAB MOD - for Daisy implementation numFrames is always 1
 
-  return (float)mWeight.dot(input);
+  return (acc0 + acc1) + (acc2 + acc3);
+
+}
+
+bool ImpulseResponse::InitBank(clevelandmusicco::Span<const clevelandmusicco::Span<const float>> irs,
+                               clevelandmusicco::Arena& arena)
+{
+  // The direct-form weights are the preprocessing's workspace: bank mode
+  // never runs Process()
+  mWeightCount = 0;
+  float* ir = mWeight;
+
+  bool fits = true;
+  size_t maxLength = 0;
+  mBank.clear();
+  mBankTaps.clear();
+  for (size_t i = 0; i < irs.size() && mBank.emplace_back(); i++)
+  {
+    size_t length = std::min(irs[i].size(), mMaxLength);
+    std::copy(irs[i].begin(), irs[i].begin() + length, ir);
+    if (mMinimumPhase)
+      IrMinimumPhase(ir, length);
+    length = IrTruncate(ir, length, std::min(IrEffectiveLength(ir, length, mTailDb), mMaxTaps));
+    fits = mBank.back().Prepare(ir, length, arena) && fits;
+    maxLength = std::max(maxLength, mBank.back().length);
+    if (mKeepReference)
+    {
+      // As long as the kernel is: a cut one convolves fewer taps
+      clevelandmusicco::Span<float> taps = arena.CarveSpan<float>(mBank.back().length);
+      if (taps.empty())
+        fits = false;
+      std::copy(ir, ir + taps.size(), taps.begin());
+      mBankTaps.push_back(taps);
+    }
+  }
+
+  if (mBlending)
+  {
+    fits = mBlendKernels[0].Reserve(maxLength, arena) && fits;
+    fits = mBlendKernels[1].Reserve(maxLength, arena) && fits;
+  }
+
+  fits = mEngines[0].Init(maxLength, arena) && fits;
+  fits = mEngines[1].Init(maxLength, arena) && fits;
+  mActiveEngine = 0;
+  mFadePos = kIrFadeSamples;
+  mSelected = -1;
+  return fits;
+}
+
+void ImpulseResponse::Select(size_t index)
+{
+  if (index >= mBank.size() || static_cast<int>(index) == mSelected)
+    return;
+
+  _FadeTo(&mBank[index]);
+  mSelected = static_cast<int>(index);
+  _LoadReference(index);
+}
+
+void ImpulseResponse::Select(size_t left, size_t right)
+{
+  if (left >= mBank.size() || right >= mBank.size()
+      || (static_cast<int>(left) == mSelected && static_cast<int>(right) == mSelectedRight))
+    return;
+
+  _FadeTo(&mBank[left], &mBank[right]);
+  mSelected = static_cast<int>(left);
+  mSelectedRight = static_cast<int>(right);
+  _LoadReference(left);
+}
+
+void ImpulseResponse::ProcessReference(const float* in, float* out, size_t size)
+{
+  for (size_t i = 0; i < size; i++)
+    out[i] = Process(in[i]);
+}
+
+void ImpulseResponse::_LoadReference(size_t index)
+{
+  if (index >= mBankTaps.size())
+    return;
+  // Reversed, as _SetWeights() stores them, and from silent history, as
+  // the engine faded in starts
+  const clevelandmusicco::Span<float> taps = mBankTaps[index];
+  for (size_t i = 0, j = taps.size() - 1; i < taps.size(); i++, j--)
+    mWeight[j] = taps[i];
+  mWeightCount = taps.size();
+  _SetHistoryRequired(taps.size() > 0 ? taps.size() - 1 : 0);
+}
+
+bool ImpulseResponse::Blend(size_t a, size_t b, float mix)
+{
+  if (!mBlending || a >= mBank.size() || b >= mBank.size()
+      || mBlendBusy.load(std::memory_order_acquire))
+    return false;
+
+  const int next = static_cast<int>(mBlendNext);
+  mBlendKernels[next].Blend(mBank[a], mBank[b], mix);
+  mBlendNext = 1 - mBlendNext;
+  mBlendBusy.store(true, std::memory_order_relaxed);
+  mBlendReady.store(next, std::memory_order_release);
+  return true;
+}
+
+void ImpulseResponse::_FadeTo(const HybridEngine::Kernel* kernel, const HybridEngine::Kernel* right)
+{
+  if (mSelected < 0)
+  {
+    // Nothing playing yet, no fade needed
+    mEngines[mActiveEngine].SetKernels(kernel, right);
+    return;
+  }
+
+  // A fade already running is cut short: the incoming engine takes over,
+  // and the kernel the outgoing one had is free again
+  if (mFadePos < kIrFadeSamples)
+  {
+    mActiveEngine = 1 - mActiveEngine;
+    if (mBlendFading)
+    {
+      mBlendFading = false;
+      mBlendBusy.store(false, std::memory_order_release);
+    }
+  }
+
+  // Pointer swap plus a state clear, no allocation
+  mEngines[1 - mActiveEngine].SetKernels(kernel, right);
+  mFadePos = 0;
+}
+
+void ImpulseResponse::_FinishFade()
+{
+  mActiveEngine = 1 - mActiveEngine;
+  if (mBlendFading)
+  {
+    mBlendFading = false;
+    mBlendBusy.store(false, std::memory_order_release);
+  }
+}
+
+void ImpulseResponse::_ServiceBlend()
+{
+  // One fade at a time: a blend waits for a Select() fade to finish
+  if (mFadePos < kIrFadeSamples)
+    return;
+  const int ready = mBlendReady.load(std::memory_order_acquire);
+  if (ready < 0)
+    return;
+  mBlendReady.store(-1, std::memory_order_relaxed);
+
+  _FadeTo(&mBlendKernels[ready]);
+  mSelected = static_cast<int>(mBank.size()); // no bank IR: Select() fades back
+  if (mFadePos < kIrFadeSamples)
+    mBlendFading = true;
+  else
+    mBlendBusy.store(false, std::memory_order_release);
+}
+
+void ImpulseResponse::_ProcessBank(const float* in, float* out, size_t size)
+{
+  if (mBlending)
+    _ServiceBlend();
+
+  if (mFadePos >= kIrFadeSamples)
+  {
+    mEngines[mActiveEngine].ProcessBlock(in, out, size);
+    return;
+  }
+
+  // Run both engines on the same input and crossfade linearly. The incoming
+  // engine starts from silent history, which the fade-in hides.
+  HybridEngine& outgoing = mEngines[mActiveEngine];
+  HybridEngine& incoming = mEngines[1 - mActiveEngine];
+  const float step = 1.0f / static_cast<float>(kIrFadeSamples);
+  constexpr size_t kChunk = 64;
+
+  while (size > 0)
+  {
+    const size_t count = std::min(size, kChunk);
+    float x[kChunk], a[kChunk], b[kChunk];
+    std::copy(in, in + count, x);
+    outgoing.ProcessBlock(x, a, count);
+    incoming.ProcessBlock(x, b, count);
+
+    for (size_t i = 0; i < count; i++)
+    {
+      const float g = mFadePos < kIrFadeSamples ? mFadePos * step : 1.0f;
+      out[i] = a[i] + (b[i] - a[i]) * g;
+      if (mFadePos < kIrFadeSamples)
+        mFadePos++;
+    }
+
+    in += count;
+    out += count;
+    size -= count;
+  }
+
+  if (mFadePos >= kIrFadeSamples)
+    _FinishFade();
+}
+
+void ImpulseResponse::ProcessBlock(const float* in, float* out, float* outRight, size_t size)
+{
+  if (mFadePos >= kIrFadeSamples)
+  {
+    mEngines[mActiveEngine].ProcessBlock(in, out, outRight, size);
+    return;
+  }
+
+  // As _ProcessBank(), a pair of outputs from each engine
+  HybridEngine& outgoing = mEngines[mActiveEngine];
+  HybridEngine& incoming = mEngines[1 - mActiveEngine];
+  const float step = 1.0f / static_cast<float>(kIrFadeSamples);
+  constexpr size_t kChunk = 64;
+
+  while (size > 0)
+  {
+    const size_t count = std::min(size, kChunk);
+    float x[kChunk], a[kChunk], aRight[kChunk], b[kChunk], bRight[kChunk];
+    std::copy(in, in + count, x);
+    outgoing.ProcessBlock(x, a, aRight, count);
+    incoming.ProcessBlock(x, b, bRight, count);
+
+    for (size_t i = 0; i < count; i++)
+    {
+      const float g = mFadePos < kIrFadeSamples ? mFadePos * step : 1.0f;
+      out[i] = a[i] + (b[i] - a[i]) * g;
+      outRight[i] = aRight[i] + (bRight[i] - aRight[i]) * g;
+      if (mFadePos < kIrFadeSamples)
+        mFadePos++;
+    }
+
+    in += count;
+    out += count;
+    outRight += count;
+    size -= count;
+  }
+
+  if (mFadePos >= kIrFadeSamples)
+    _FinishFade();
+}
+
+void ImpulseResponse::ProcessBlock(const float* in, float* out, size_t size)
+{
+  if (!mBank.empty())
+  {
+    _ProcessBank(in, out, size);
+    return;
+  }
+
+  if (mMode == IrMode::kZeroLatency)
+    mHybrid.ProcessBlock(in, out, size);
+  else
+    mConvolver.ProcessBlock(in, out, size);
+}
+
+void ImpulseResponse::Reset()
+{
+  if (mBank.empty())
+  {
+    mHybrid.Reset();
+    mConvolver.Reset();
+    return;
+  }
 
+  if (mFadePos < kIrFadeSamples)
+  {
+    mFadePos = kIrFadeSamples;
+    _FinishFade();
+  }
+  mEngines[mActiveEngine].Reset();
+  if (mSelected >= 0)
+    _LoadReference(static_cast<size_t>(mSelected));
 }
 
-void ImpulseResponse::_SetWeights()
+bool ImpulseResponse::_SetWeights(const float* ir, size_t length, clevelandmusicco::Arena& arena)
 {
 
-  const size_t irLength = std::min(mRawAudio.size(), mMaxLength);
-  mWeight.resize(irLength);
+  const size_t irLength = std::min(length, mMaxLength);
+  mWeightCount = irLength;
   // Gain reduction.
   // https://github.com/sdatkinson/NeuralAmpModelerPlugin/issues/100#issuecomment-1455273839
   // Add sample rate-dependence
   //const float gain = pow(10, -18 * 0.05) * 48000 / mSampleRate;  //KAB NOTE: This made a very bad/loud sound on Daisy Seed
   for (size_t i = 0, j = irLength - 1; i < irLength; i++, j--)
-    //mWeight[j] = gain * mRawAudio[i];  
-    mWeight[j] = mRawAudio[i];
-  mHistoryRequired = irLength - 1;
-
-  // Moved from HISTORY::EnsureHistorySize since only doing once for this module (assuming same size IR's)
-  //   TODO: Maybe find a more efficient method of indexing mHistory,
-  //         rather than copying the end of the vector (length of IR) back to the beginning all at once.
-  const size_t requiredHistoryArraySize = 5 * mHistoryRequired; // Just so we don't spend too much time copying back. // KAB NOTE: was 10 *
-  mHistory.resize(requiredHistoryArraySize);
-  std::fill(mHistory.begin(), mHistory.end(), 0.0f);
-  mHistoryIndex = mHistoryRequired; 
+    //mWeight[j] = gain * ir[i];
+    mWeight[j] = ir[i];
+  // Mirrored ring buffer, see History
+  _SetHistoryRequired(irLength - 1);
+
+  // Same (clamped) IR for the block path, in natural tap order
+  if (mMode == IrMode::kZeroLatency)
+    return mHybrid.Init(ir, irLength, arena);
+  return mConvolver.Init(ir, irLength, arena);
 
 }
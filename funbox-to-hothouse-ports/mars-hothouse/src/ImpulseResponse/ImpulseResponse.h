@@ -12,8 +12,33 @@
 
 #pragma once
 
-#include <Eigen/Dense>
+#include <atomic>
+#include "hothouse_arena.h"
+#include "hothouse_containers.h"
 #include "dsp.h"
+#include "PartitionedConvolver.h"
+#include "HybridConvolver.h"
+#include "ir_prep.h"
+
+// Partition size for the uniform FFT convolver. In kUniform mode audio blocks
+// passed to ProcessBlock must be a multiple of this.
+constexpr size_t kIrPartitionSize = 64;
+
+// Longest IR, in taps. Longer ones are cut to it.
+constexpr size_t kIrMaxLength = kHistoryMaxWindow;
+
+// Most IRs InitBank() takes. Later ones are dropped.
+constexpr size_t kIrBankMax = 8;
+
+// Crossfade length when switching between bank IRs (10 ms at 48 kHz)
+constexpr size_t kIrFadeSamples = 480;
+
+// Block convolution engine used by ProcessBlock
+enum class IrMode
+{
+  kUniform,      // uniform 64-tap partitions, block must be a multiple of 64
+  kZeroLatency,  // 64-tap direct head + growing FFT partitions, any block size
+};
 
 
 class ImpulseResponse : public History
@@ -22,24 +47,126 @@ public:
   ImpulseResponse();
   ~ImpulseResponse();
 
-  void Init(std::vector<float> irData);
+  // The block path's spectra and state are carved from arena (boot time).
+  // Returns false if they don't fit: the block path is then silent.
+  bool Init(clevelandmusicco::Span<const float> irData, clevelandmusicco::Arena& arena);
+  // Cabinet bank for ProcessBlock: every IR is transformed once here (boot
+  // time, carving from arena), then Select() switches between them from the
+  // audio thread by pointer swap with a kIrFadeSamples crossfade. Always
+  // uses the zero-latency engine. Returns false if arena runs out: the IRs
+  // that didn't fit are cut short (see BankArenaFloats()).
+  bool InitBank(clevelandmusicco::Span<const clevelandmusicco::Span<const float>> irs,
+                clevelandmusicco::Arena& arena);
+  // The floats InitBank() carves at most for count IRs of up to length taps,
+  // with SetBlending() and SetReference() as given, for sizing its arena
+  static constexpr size_t BankArenaFloats(size_t count, size_t length, bool blending,
+                                          bool reference = false)
+  {
+    return (count + 2 + (blending ? 2 : 0)) * HybridEngine::Kernel::Floats(length)
+           + (reference ? count * length : 0);
+  }
+  void Select(size_t index);
+  // Stereo cab, for the stereo ProcessBlock(): bank IR left on one output
+  // and right on the other, with the same crossfade
+  void Select(size_t left, size_t right);
+  // Preprocessing for the following InitBank() (see ir_prep.h): convert each
+  // IR to minimum phase, then cut it where its tail falls below tailDb
+  // (e.g. -60; 0 keeps every tap up to the maximum length) or at maxTaps,
+  // whichever comes first
+  void SetPreprocessing(bool minimumPhase, float tailDb, size_t maxTaps = kIrMaxLength)
+  {
+    mMinimumPhase = minimumPhase;
+    mTailDb = tailDb;
+    mMaxTaps = maxTaps;
+  }
+  // Keep each bank IR's taps, as preprocessed, for ProcessReference():
+  // before InitBank(), which carves them from its arena
+  void SetReference(bool keep) { mKeepReference = keep; }
+  // Room for Blend() in the following InitBank(): two more kernels the
+  // length of the longest IR, carved there
+  void SetBlending(bool blending) { mBlending = blending; }
+  // Main loop only: plays (1 - mix) * IR a + mix * IR b through the one
+  // engine, with the same crossfade as Select(). The blend is worked out
+  // here, into whichever of the two blend kernels neither engine is using;
+  // returns false, doing nothing, while the last one is still fading in.
+  bool Blend(size_t a, size_t b, float mix);
+  // Taps the convolver runs for bank IR index, after preprocessing
+  size_t EffectiveLength(size_t index) const { return mBank[index].length; }
+  // Select the block engine. Takes effect at the next Init().
+  void SetMode(IrMode mode) { mMode = mode; }
+  // Direct-form, one sample at a time (reference path)
   float Process(float inputs);
+  // Partitioned FFT convolution over a block (see IrMode for size rules,
+  // bank mode accepts any size).
+  // in and out may alias. Don't mix with Process() on the same instance, the
+  // two paths keep separate history.
+  void ProcessBlock(const float* in, float* out, size_t size);
+  // Bank mode, after the stereo Select(): the two cabs on one input, which
+  // shares its FFTs (HybridConvolver), for about 1.5 times the cost of one.
+  // in may alias out, not outRight.
+  void ProcessBlock(const float* in, float* out, float* outRight, size_t size);
+  // Audio thread: clears the block engines' history, so the next input
+  // starts from no tail. A crossfade still running is finished first.
+  void Reset();
+  // After SetReference(true): the selected bank IR (the left of a stereo
+  // pair) by direct-form convolution, one sample at a time, the exact sum
+  // the block engine computes by FFT, for a null test against it (make
+  // NULL_TEST=1). Changes cab at once where Select() crossfades, and
+  // doesn't follow Blend(). Silent otherwise.
+  void ProcessReference(const float* in, float* out, size_t size);
+  // True while Select() or Blend() is crossfading between engines
+  bool Fading() const { return mFadePos < kIrFadeSamples; }
 
 
 private:
-  // Set the weights, given that the plugin is running at the provided sample
-  // rate.
-  void _SetWeights();
-
-  // State of audio
-  // Keep a copy of the raw audio that was loaded so that it can be resampled
-  std::vector<float> mRawAudio;
-  float mRawAudioSampleRate;
-  float mSampleRate;
-
-  const size_t mMaxLength = 8192;
-  // The weights
-  Eigen::VectorXf mWeight;
+  typedef HybridConvolver<64, 512> HybridEngine;
+
+  void _ProcessBank(const float* in, float* out, size_t size);
+  // Fades to kernel (and right, for a stereo cab), or starts with it if
+  // nothing is playing yet
+  void _FadeTo(const HybridEngine::Kernel* kernel, const HybridEngine::Kernel* right = nullptr);
+  void _FinishFade();
+  // Audio thread: picks up a blend Blend() has finished
+  void _ServiceBlend();
+  // Audio thread: bank IR index's kept taps into the direct-form weights
+  void _LoadReference(size_t index);
+
+  // Set the weights (the first mMaxLength taps of ir) for both paths
+  bool _SetWeights(const float* ir, size_t length, clevelandmusicco::Arena& arena);
+
+  static constexpr size_t mMaxLength = kIrMaxLength;
+  bool mMinimumPhase = false;
+  float mTailDb = 0.0f;
+  size_t mMaxTaps = kIrMaxLength;
+  // The weights, reversed so the dot product with History's window walks
+  // forward in time
+  alignas(16) float mWeight[kIrMaxLength] = {};
+  size_t mWeightCount = 0;
+  // Frequency-domain partitions of the same IR
+  IrMode mMode = IrMode::kUniform;
+  PartitionedConvolver<kIrPartitionSize> mConvolver;
+  HybridEngine mHybrid;
+
+  // Bank mode: prepared kernels and two engines to crossfade between
+  clevelandmusicco::StaticVector<HybridEngine::Kernel, kIrBankMax> mBank;
+  // SetReference(true): each bank IR's taps, in natural order
+  bool mKeepReference = false;
+  clevelandmusicco::StaticVector<clevelandmusicco::Span<float>, kIrBankMax> mBankTaps;
+  HybridEngine mEngines[2];
+  size_t mActiveEngine = 0;
+  size_t mFadePos = 0;      // kIrFadeSamples when no fade is running
+  int mSelected = -1;
+  int mSelectedRight = -1;  // stereo Select() only
+
+  // Blend(): the main loop writes mBlendKernels[mBlendNext], publishes it
+  // in mBlendReady and keeps off both until the audio thread has faded
+  // into it and cleared mBlendBusy; only then is the other one free
+  bool mBlending = false;
+  HybridEngine::Kernel mBlendKernels[2];
+  size_t mBlendNext = 0;
+  bool mBlendFading = false;
+  std::atomic<int> mBlendReady{-1};
+  std::atomic<bool> mBlendBusy{false};
 };
 
 
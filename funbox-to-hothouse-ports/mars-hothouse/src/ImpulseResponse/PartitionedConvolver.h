@@ -0,0 +1,355 @@
+//
+//  PartitionedConvolver.h
+//
+//  Uniformly partitioned overlap-save convolution (UPOLS) for the Mars IR stage.
+//
+//  The IR is split into partitions of PartitionSize taps. Each partition is
+//  transformed once into a 2*PartitionSize point spectrum (PartitionedKernel).
+//  Every PartitionSize input samples the convolver does one forward FFT, one
+//  complex multiply-accumulate per partition over the frequency-domain delay
+//  line (FDL), and one inverse FFT. For an 8192 tap IR and 64 sample
+//  partitions this is ~130 complex MACs per sample instead of 8192 real MACs.
+//
+//  Kernels (IR spectra) and convolver state are separate so several IRs can
+//  be prepared at boot and swapped by pointer on the audio thread. Both
+//  carve their spectra from an Arena (hothouse_arena.h) when they are
+//  prepared, so nothing here touches the heap and the pedal decides which
+//  RAM they live in.
+//  Two kernels can also run on one input (SetKernels()), sharing its
+//  forward FFTs and FDL: a stereo pair of cabs for one FFT per partition.
+//
+//  Output is sample-aligned with the input (no added latency) as long as
+//  ProcessBlock() is always called with a multiple of PartitionSize samples.
+//  AccumulateDelayed() accepts any block size instead, at exactly
+//  PartitionSize samples of latency; HybridConvolver uses it for IR segments
+//  whose first tap is at least PartitionSize samples in.
+//
+//  FFT backend is the ShyFFT used by Venus. Spectra use its packed layout:
+//    [0..P]     real parts of bins 0..P
+//    [P+1..2P-1] imaginary parts of bins 1..P-1
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include "hothouse_arena.h"
+#include "shy_fft.h"
+
+
+// Frequency-domain IR partitions. Immutable once prepared.
+template <size_t PartitionSize>
+struct PartitionedKernel
+{
+  static constexpr size_t kFftSize = 2 * PartitionSize;
+
+  // weights are in natural order (weights[0] is the first tap). Carves
+  // the spectra from arena - call at init, not from the audio callback.
+  // Returns false, leaving an empty kernel, if they don't fit.
+  bool Prepare(const float* weights, size_t length, clevelandmusicco::Arena& arena)
+  {
+    if (!_Carve(length, arena))
+      return false;
+
+    ShyFFT<float, kFftSize, RotationPhasor> fft;
+    fft.Init();
+
+    // Fold the inverse FFT's 1/N scaling into the IR spectra so the output
+    // loop doesn't need a multiply.
+    const float scale = 1.0f / static_cast<float>(kFftSize);
+    float time[kFftSize];
+    for (size_t p = 0; p < numPartitions; p++)
+    {
+      std::fill(time, time + kFftSize, 0.0f);
+      const size_t start = p * PartitionSize;
+      const size_t count = std::min(PartitionSize, length - std::min(length, start));
+      for (size_t i = 0; i < count; i++)
+        time[i] = weights[start + i] * scale;
+      fft.Direct(time, &spectra[p * kFftSize]);
+    }
+    return true;
+  }
+
+  // Room for a Blend() of kernels of up to length taps, and a silent kernel
+  // until then. Carves from arena, as Prepare().
+  bool Reserve(size_t length, clevelandmusicco::Arena& arena)
+  {
+    if (!_Carve(length, arena))
+      return false;
+    std::fill(spectra.begin(), spectra.end(), 0.0f);
+    return true;
+  }
+
+  // (1 - mix) * a + mix * b. The FFT is linear, so these are the spectra of
+  // the blended IR and one convolution plays both. Allocation-free, and cut
+  // to what Reserve() made room for.
+  void Blend(const PartitionedKernel& a, const PartitionedKernel& b, float mix)
+  {
+    const size_t capacity = spectra.size() / kFftSize;
+    numPartitions = std::min(std::max(a.numPartitions, b.numPartitions), capacity);
+    const size_t size = numPartitions * kFftSize;
+    const size_t sizeA = std::min(a.numPartitions * kFftSize, size);
+    const size_t sizeB = std::min(b.numPartitions * kFftSize, size);
+    const float gainA = 1.0f - mix;
+    for (size_t i = 0; i < sizeA; i++)
+      spectra[i] = gainA * a.spectra[i];
+    std::fill(spectra.begin() + sizeA, spectra.begin() + size, 0.0f);
+    for (size_t i = 0; i < sizeB; i++)
+      spectra[i] += mix * b.spectra[i];
+  }
+
+  // The floats a kernel of length taps carves
+  static constexpr size_t Floats(size_t length)
+  {
+    return (length > 0 ? (length + PartitionSize - 1) / PartitionSize : 1) * kFftSize;
+  }
+
+  clevelandmusicco::Span<float> spectra;  // numPartitions spectra of kFftSize
+  size_t numPartitions = 0;
+
+private:
+  bool _Carve(size_t length, clevelandmusicco::Arena& arena)
+  {
+    spectra = arena.CarveSpan<float>(Floats(length));
+    numPartitions = spectra.size() / kFftSize;
+    return numPartitions > 0;
+  }
+};
+
+
+template <size_t PartitionSize>
+class PartitionedConvolver
+{
+public:
+  static constexpr size_t kFftSize = 2 * PartitionSize;
+
+  PartitionedConvolver() {}
+  ~PartitionedConvolver() {}
+
+  // Prepares an internally owned kernel and sizes the state for it, both
+  // carved from arena - call at init, not from the audio callback. Returns
+  // false, and stays silent, if they don't fit.
+  bool Init(const float* weights, size_t length, clevelandmusicco::Arena& arena)
+  {
+    const bool fits = mOwnKernel.Prepare(weights, length, arena)
+                      && Init(mOwnKernel.numPartitions, arena);
+    SetKernel(&mOwnKernel);
+    return fits;
+  }
+
+  // Sizes the FDL for kernels of up to maxPartitions, carved from arena,
+  // and resets state. Returns false, taking no kernels, if it doesn't fit.
+  bool Init(size_t maxPartitions, clevelandmusicco::Arena& arena)
+  {
+    mFft.Init();
+    mFdl = arena.CarveSpan<float>((maxPartitions > 0 ? maxPartitions : 1) * kFftSize);
+    mMaxPartitions = mFdl.size() / kFftSize;
+    std::fill(mFdl.begin(), mFdl.end(), 0.0f);
+    mKernel = nullptr;
+    mKernelRight = nullptr;
+    mNumPartitions = 1;
+    Reset();
+    return mMaxPartitions > 0;
+  }
+
+  // Points the convolver at a prepared kernel and clears the history.
+  // Allocation-free; kernel must outlive its use and fit the Init() size
+  // (one that doesn't, or is empty, is taken as silence).
+  void SetKernel(const PartitionedKernel<PartitionSize>* kernel)
+  {
+    SetKernels(kernel, nullptr);
+  }
+
+  // Two kernels on one input, for AccumulateDelayed(in, out, outRight):
+  // each partition's forward FFT and the FDL are shared, and only the
+  // multiply-accumulate and the inverse FFT are done per kernel.
+  // Allocation-free, as SetKernel().
+  void SetKernels(const PartitionedKernel<PartitionSize>* kernel,
+                  const PartitionedKernel<PartitionSize>* right)
+  {
+    mKernel = _Fits(kernel) ? kernel : nullptr;
+    mKernelRight = _Fits(right) ? right : nullptr;
+    mNumPartitions = std::max(mKernel ? mKernel->numPartitions : 1,
+                              mKernelRight ? mKernelRight->numPartitions : 1);
+    Reset();
+  }
+
+  // Clears the input history and FDL without touching the kernel.
+  void Reset()
+  {
+    std::fill(mInput, mInput + kFftSize, 0.0f);
+    std::fill(mFdl.begin(), mFdl.begin() + std::min(mFdl.size(), mNumPartitions * kFftSize), 0.0f);
+    std::fill(mFifoIn, mFifoIn + PartitionSize, 0.0f);
+    std::fill(mFifoOut, mFifoOut + PartitionSize, 0.0f);
+    std::fill(mFifoOutRight, mFifoOutRight + PartitionSize, 0.0f);
+    mFdlHead = 0;
+    mFifoPos = 0;
+  }
+
+  // Convolve size samples. size must be a multiple of PartitionSize.
+  // in and out may alias.
+  void ProcessBlock(const float* in, float* out, size_t size)
+  {
+    for (size_t offset = 0; offset + PartitionSize <= size; offset += PartitionSize)
+      _ProcessPartition(in + offset, out + offset);
+  }
+
+  // Convolve any number of samples with PartitionSize samples of latency,
+  // adding the result to out. in and out must not alias.
+  void AccumulateDelayed(const float* in, float* out, size_t size)
+  {
+    while (size > 0)
+    {
+      const size_t count = std::min(PartitionSize - mFifoPos, size);
+      for (size_t i = 0; i < count; i++)
+      {
+        mFifoIn[mFifoPos + i] = in[i];
+        out[i] += mFifoOut[mFifoPos + i];
+      }
+      mFifoPos += count;
+      in += count;
+      out += count;
+      size -= count;
+
+      if (mFifoPos == PartitionSize)
+      {
+        _ProcessPartition(mFifoIn, mFifoOut);
+        mFifoPos = 0;
+      }
+    }
+  }
+
+  // The same through both kernels from SetKernels(), into out and
+  // outRight. Neither may alias in.
+  void AccumulateDelayed(const float* in, float* out, float* outRight, size_t size)
+  {
+    while (size > 0)
+    {
+      const size_t count = std::min(PartitionSize - mFifoPos, size);
+      for (size_t i = 0; i < count; i++)
+      {
+        mFifoIn[mFifoPos + i] = in[i];
+        out[i] += mFifoOut[mFifoPos + i];
+        outRight[i] += mFifoOutRight[mFifoPos + i];
+      }
+      mFifoPos += count;
+      in += count;
+      out += count;
+      outRight += count;
+      size -= count;
+
+      if (mFifoPos == PartitionSize)
+      {
+        _ProcessPartition(mFifoIn, mFifoOut, mFifoOutRight);
+        mFifoPos = 0;
+      }
+    }
+  }
+
+  size_t NumPartitions() const { return mNumPartitions; }
+
+private:
+  bool _Fits(const PartitionedKernel<PartitionSize>* kernel) const
+  {
+    return kernel && kernel->numPartitions > 0 && kernel->numPartitions <= mMaxPartitions;
+  }
+
+  void _ProcessPartition(const float* in, float* out)
+  {
+    if (!mKernel)
+    {
+      std::fill(out, out + PartitionSize, 0.0f);
+      return;
+    }
+    _Transform(in);
+    _Output(mKernel, out);
+  }
+
+  // One partition through both kernels: the forward FFT once, then each
+  // kernel's multiply-accumulate and inverse FFT
+  void _ProcessPartition(const float* in, float* out, float* outRight)
+  {
+    if (!mKernel && !mKernelRight)
+    {
+      std::fill(out, out + PartitionSize, 0.0f);
+      std::fill(outRight, outRight + PartitionSize, 0.0f);
+      return;
+    }
+    _Transform(in);
+    _Output(mKernel, out);
+    _Output(mKernelRight, outRight);
+  }
+
+  void _Transform(const float* in)
+  {
+    // Slide the 2P input window: old half moves down, new half appended.
+    std::copy(mInput + PartitionSize, mInput + kFftSize, mInput);
+    std::copy(in, in + PartitionSize, mInput + PartitionSize);
+
+    // Newest spectrum goes into the FDL slot at the head.
+    mFdlHead = (mFdlHead == 0) ? mNumPartitions - 1 : mFdlHead - 1;
+    std::copy(mInput, mInput + kFftSize, mTime);
+    mFft.Direct(mTime, &mFdl[mFdlHead * kFftSize]);
+  }
+
+  void _Output(const PartitionedKernel<PartitionSize>* kernel, float* out)
+  {
+    if (!kernel)
+    {
+      std::fill(out, out + PartitionSize, 0.0f);
+      return;
+    }
+
+    // Y = sum_p X[t - p] * H[p]. Walk the FDL from the head, wrapping once,
+    // so both spans are contiguous; a kernel shorter than the FDL (the
+    // other of two) stops at its own last partition.
+    std::fill(mAccum, mAccum + kFftSize, 0.0f);
+    const float* h = kernel->spectra.data();
+    size_t remaining = kernel->numPartitions;
+    for (size_t slot = mFdlHead; slot < mNumPartitions && remaining > 0; slot++, h += kFftSize, remaining--)
+      _MultiplyAccumulate(&mFdl[slot * kFftSize], h);
+    for (size_t slot = 0; remaining > 0; slot++, h += kFftSize, remaining--)
+      _MultiplyAccumulate(&mFdl[slot * kFftSize], h);
+
+    mFft.Inverse(mAccum, mTime);
+
+    // Overlap-save: only the second half is free of circular wrap.
+    std::copy(mTime + PartitionSize, mTime + kFftSize, out);
+  }
+
+  inline void _MultiplyAccumulate(const float* x, const float* h)
+  {
+    constexpr size_t P = PartitionSize;
+    // DC and Nyquist bins are purely real
+    mAccum[0] += x[0] * h[0];
+    mAccum[P] += x[P] * h[P];
+    for (size_t k = 1; k < P; k++)
+    {
+      const float xr = x[k], xi = x[P + k];
+      const float hr = h[k], hi = h[P + k];
+      mAccum[k]     += xr * hr - xi * hi;
+      mAccum[P + k] += xr * hi + xi * hr;
+    }
+  }
+
+  ShyFFT<float, kFftSize, RotationPhasor> mFft;
+
+  PartitionedKernel<PartitionSize> mOwnKernel;  // used by Init(weights, length)
+  const PartitionedKernel<PartitionSize>* mKernel = nullptr;
+  const PartitionedKernel<PartitionSize>* mKernelRight = nullptr;  // SetKernels() only
+
+  clevelandmusicco::Span<float> mFdl;  // frequency-domain delay line
+  size_t mMaxPartitions = 0;
+  size_t mNumPartitions = 1;
+  size_t mFdlHead = 0;
+
+  float mInput[kFftSize] = {};     // sliding 2P time-domain input window
+  float mTime[kFftSize] = {};      // FFT scratch (ShyFFT uses its input as workspace)
+  float mAccum[kFftSize] = {};     // spectral accumulator
+
+  // AccumulateDelayed() staging
+  float mFifoIn[PartitionSize] = {};
+  float mFifoOut[PartitionSize] = {};
+  float mFifoOutRight[PartitionSize] = {};
+  size_t mFifoPos = 0;
+};
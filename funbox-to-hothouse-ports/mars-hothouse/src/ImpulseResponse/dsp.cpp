@@ -9,6 +9,8 @@
 
 #include "dsp.h"
 
+#include <algorithm>
+
 
 History::History()
 {
@@ -21,24 +23,26 @@ History::~History()
 }
 
 
-void History::_AdvanceHistoryIndex(const size_t bufferSize)
+void History::_SetHistoryRequired(const size_t historyRequired)
 {
-  mHistoryIndex += bufferSize;
+  mWindow = std::min(historyRequired + 1, kHistoryMaxWindow);
+  mHistoryRequired = mWindow - 1;
+  std::fill(mHistory, mHistory + 2 * mWindow, 0.0f);
+  mWritePos = 0;
+  mHistoryIndex = mWritePos + mWindow;
 }
 
-
-void History::_RewindHistory()
+void History::_AdvanceHistoryIndex(const size_t bufferSize)
 {
-  // TODO memcpy?  Should be fine w/ history array being >2x the history length.
-  for (size_t i = 0, j = mHistoryIndex - mHistoryRequired; i < mHistoryRequired; i++, j++)
-    mHistory[i] = mHistory[j];
-  mHistoryIndex = mHistoryRequired;
+  mWritePos += bufferSize;
+  if (mWritePos >= mWindow)
+    mWritePos -= mWindow;
+  mHistoryIndex = mWritePos + mWindow;
 }
 
 void History::_UpdateHistory(float inputs)
 {
-  if (mHistoryIndex + 1 >= mHistory.size())
-    _RewindHistory();
-
+  // Lower copy feeds the window once the write position wraps
+  mHistory[mWritePos] = inputs;
   mHistory[mHistoryIndex] = inputs;
 }
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <vector>
+#include <cstddef>
 
 // A class where a longer buffer of history is needed to correctly calculate
 // the DSP algorithm (e.g. algorithms involving convolution).
@@ -8,30 +8,41 @@
 // Hacky stuff:
 // * Mono
 // * Single-precision floats.
+//
+// Longest window (mHistoryRequired + 1) History holds; longer ones are cut
+constexpr size_t kHistoryMaxWindow = 8192;
+
+// mHistory is a mirrored ring buffer of 2 * (mHistoryRequired + 1) floats,
+// at the start of a fixed array sized for the longest window.
+// Every sample is written twice, one window length apart, so the last
+// mHistoryRequired + 1 samples are always contiguous and end at
+// mHistoryIndex. No periodic rewind/copy is needed.
 class History 
 {
 public:
   History();
   ~History();
 protected:
+  // Size the mirrored history for the given mHistoryRequired and clear it.
+  void _SetHistoryRequired(const size_t historyRequired);
   // Called at the end of the DSP, advance the hsitory index to the next open
   // spot.  Does not ensure that it's at a valid address.
   void _AdvanceHistoryIndex(const size_t bufferSize);
-  // Drop the new samples into the history array.
-  // Manages history array size
+  // Drop the new sample into the history array (both mirror halves).
   void _UpdateHistory(float inputs);
 
   // The history array that's used for DSP calculations.
-  std::vector<float> mHistory;
+  alignas(16) float mHistory[2 * kHistoryMaxWindow] = {};
   // How many samples previous are required.
   // Zero means that no history is required--only the current sample.
   size_t mHistoryRequired = 0;
   // Location of the first sample in the current buffer.
-  // Shall always be in the range [mHistoryRequired, mHistory.size()).
+  // Always in the upper mirror half, [mHistoryRequired + 1, mHistory.size()),
+  // so the window [mHistoryIndex - mHistoryRequired, mHistoryIndex] is valid.
   size_t mHistoryIndex = 0;
 
 private:
-
-  // Copy the end of the history back to the front and reset mHistoryIndex
-  void _RewindHistory();
+  // Window length (mHistoryRequired + 1) and write position in [0, mWindow)
+  size_t mWindow = 1;
+  size_t mWritePos = 0;
 };
@@ -1,8 +1,11 @@
 #pragma once
+
+#include "hothouse_containers.h"
+
 // IR Test Data
 
 // Proteus
-std::vector<float> ir_data1 = { 0.09165135,0.34494776,0.642427,0.8733099,0.9765655,0.90381545,0.64580977,0.26979384,-0.09133818,-0.33001012,-0.38087615,-0.27518257,-0.09180161,0.07009281,0.13477188,0.1134176,0.05394234,0.0002800684,-0.01746423,0.0023448383,0.037010457,0.07013612,0.08224031,0.0646829,0.026357336,-0.0038456772,-0.00917907,0.010505134,0.037371267,0.03840451,0.018965935,-0.020979231,-0.0719064,-0.123280674,-0.17116594,-0.19054614,-0.18061672,-0.14881288,-0.102494515,-0.04864169,0.0048738876,0.04574761,0.069491655,0.073702306,0.06250842,0.037841693,-0.0013760217,-0.0457628,-0.09093866,-0.13268682,-0.1635205,
+const float ir_data1[] = { 0.09165135,0.34494776,0.642427,0.8733099,0.9765655,0.90381545,0.64580977,0.26979384,-0.09133818,-0.33001012,-0.38087615,-0.27518257,-0.09180161,0.07009281,0.13477188,0.1134176,0.05394234,0.0002800684,-0.01746423,0.0023448383,0.037010457,0.07013612,0.08224031,0.0646829,0.026357336,-0.0038456772,-0.00917907,0.010505134,0.037371267,0.03840451,0.018965935,-0.020979231,-0.0719064,-0.123280674,-0.17116594,-0.19054614,-0.18061672,-0.14881288,-0.102494515,-0.04864169,0.0048738876,0.04574761,0.069491655,0.073702306,0.06250842,0.037841693,-0.0013760217,-0.0457628,-0.09093866,-0.13268682,-0.1635205,
                           -0.18142268,-0.18144807,-0.16410044,-0.13526863,-0.10523564,-0.08354254,-0.07703036,-0.07966023,-0.08314092,-0.08711798,-0.082402855,-0.07069823,-0.060387973,-0.05511471,-0.05297593,-0.05506546,-0.061078455,-0.064046904,-0.06443261,-0.06321003,-0.064143464,-0.06725661,-0.06987344,-0.071799636,-0.0710794,-0.06976334,-0.06853695,-0.06835803,-0.0698773,-0.06964096,-0.0669661,-0.06253795,-0.060600787,-0.062732615,-0.06995352,-0.081729166,-0.09046745,-0.09488154,-0.094281204,-0.089662544,-0.08452549,-0.083357014,-0.09053672,-0.10228267,-0.112124674,-0.11511527,-0.109826796,-0.10042146,-0.08960831,-0.079272754,-0.076487735,
                           -0.08254217,-0.094931655,-0.107865356,-0.11363837,-0.11187402,-0.10532005,-0.095720805,-0.08345185,-0.071409926,-0.060202427,-0.04782326,-0.03344093,-0.01948797,-0.009585296,-0.0065911557,-0.011831561,-0.022803213,-0.037139785,-0.049482487,-0.056022998,-0.056035332,-0.051204406,-0.044367153,-0.037329253,-0.031810008,-0.025931384,-0.01798113,-0.0058025466,0.008753816,0.0212772,0.029299777,0.031279836,0.027175553,0.016919078,0.0028551049,-0.011740603,-0.024240287,-0.03401027,-0.04003737,-0.04131747,-0.03749122,-0.02958256,-0.021509392,-0.015716761,-0.0129135195,-0.011967915,-0.011235863,-0.010230864,-0.008329283,-0.00408161,0.0018289342,
                           0.0070602293,0.010045952,0.010475637,0.0092166895,0.007399299,0.005249437,0.0019942587,-0.0023101277,-0.0072071664,-0.012060744,-0.016935531,-0.021020649,-0.022889642,-0.021009525,-0.014375131,-0.0047140247,0.005474857,0.014507624,0.021367949,0.023821149,0.020447709,0.012130102,0.0024319293,-0.004913604,-0.008870569,-0.009489351,-0.007629974,-0.0037156516,0.001060485,0.005665943,0.010041704,0.014878822,0.02112296,0.0273475,0.031416226,0.032417998,0.032098353,0.03296269,0.035877626,0.040683776,0.046800036,0.053564813,0.05914606,0.061286274,0.05919661,0.054442685,0.049703162,0.04636829,0.04396994,0.041776415,0.039922163,
@@ -13,7 +16,7 @@ std::vector<float> ir_data1 = { 0.09165135,0.34494776,0.642427,0.8733099,0.97656
                           };
 
 //US Deluxe
-std::vector<float> ir_data2 = { 0.0034908056,0.3523475,0.60503685,0.95999277,0.9286411,0.9942601,0.5302459,0.29374087,-0.16792,-0.1814208,-0.3856635,-0.28140163,-0.24453771,-0.03430164,-0.014578223,0.028817415,0.053222418,0.05444622,0.016842604,0.032137156,0.066504955,0.082255125,0.04495418,0.086707234,0.08999586,0.07729125,0.008366823,0.006036639,-0.07392311,-0.10841155,-0.15197158,-0.12579143,-0.13457584,-0.1239537,-0.14833474,-0.11523831,-0.13403797,-0.12985802,-0.10929978,-0.044311166,-0.01559937,0.02953422,0.060052276,0.0918895,0.0705477,0.042483687,0.0050832033,-0.011725068,-0.07401705,-0.112733245,-0.1482836,
+const float ir_data2[] = { 0.0034908056,0.3523475,0.60503685,0.95999277,0.9286411,0.9942601,0.5302459,0.29374087,-0.16792,-0.1814208,-0.3856635,-0.28140163,-0.24453771,-0.03430164,-0.014578223,0.028817415,0.053222418,0.05444622,0.016842604,0.032137156,0.066504955,0.082255125,0.04495418,0.086707234,0.08999586,0.07729125,0.008366823,0.006036639,-0.07392311,-0.10841155,-0.15197158,-0.12579143,-0.13457584,-0.1239537,-0.14833474,-0.11523831,-0.13403797,-0.12985802,-0.10929978,-0.044311166,-0.01559937,0.02953422,0.060052276,0.0918895,0.0705477,0.042483687,0.0050832033,-0.011725068,-0.07401705,-0.112733245,-0.1482836,
                           -0.13304639,-0.12432706,-0.06644559,-0.03312707,-0.007929921,-0.030416131,-0.025596976,-0.038918734,-0.026919365,-0.026245475,0.020679593,0.041544914,0.06317687,0.042120457,0.031234264,-0.016168594,-0.058145642,-0.09446871,-0.07810295,-0.06428921,-0.033769846,0.0010832548,0.04238522,0.042004704,0.03635466,0.015765786,0.009633303,-0.011256218,-0.012475491,-0.023204088,-0.029212594,-0.0601542,-0.07464349,-0.09852147,-0.11526668,-0.135095,-0.12136924,-0.10606623,-0.07955718,-0.05698359,-0.02991879,-0.029208183,-0.032895803,-0.051694274,-0.060173273,-0.06856835,-0.060687542,-0.05111146,-0.03369987,-0.03733623,-0.04555881,
                           -0.055636406,-0.05298114,-0.055659056,-0.044862628,-0.028801799,-0.0017154217,0.010845423,0.01713121,0.004822731,-0.011127949,-0.04259026,-0.060756564,-0.07517874,-0.07852352,-0.077587485,-0.053107142,-0.025283217,0.0030859709,0.013730526,0.021886468,0.016690612,-0.0032480955,-0.039693832,-0.06219518,-0.07916355,-0.084699154,-0.08225083,-0.05849719,-0.036077976,-0.020155191,-0.021954179,-0.025768995,-0.039601088,-0.0559026,-0.06732476,-0.05816984,-0.045262575,-0.032297134,-0.021949053,-0.010449767,-0.009745598,-0.019760609,-0.032734036,-0.03770554,-0.039441228,-0.03492737,-0.026156187,-0.018304586,-0.021251917,-0.030637383,-0.04135263,
                           -0.053743124,-0.06294179,-0.060462594,-0.046948075,-0.034631252,-0.02174604,-0.012224555,-0.009338856,-0.01651454,-0.02762568,-0.039643884,-0.04897487,-0.05612707,-0.058932662,-0.052454114,-0.043878555,-0.036735654,-0.03259313,-0.027591348,-0.02599144,-0.024257898,-0.025446773,-0.025572896,-0.028790236,-0.030592084,-0.036227107,-0.039076805,-0.04072857,-0.03416097,-0.026471734,-0.016138554,-0.007434845,0.0017493963,0.0042752028,0.0010277033,-0.005280018,-0.008223057,-0.0075218678,-0.0033237934,0.0017014742,0.0044099092,0.0023477077,-0.006031275,-0.014598489,-0.022361279,-0.029232025,-0.02923143,-0.02336955,-0.01599729,-0.009979725,-0.0057735443,
@@ -24,7 +27,7 @@ std::vector<float> ir_data2 = { 0.0034908056,0.3523475,0.60503685,0.95999277,0.9
                           };
 
 // Vox Bright
-std::vector<float> ir_data3 = { 0.52926904,0.9913671,0.7762714,0.30122554,0.02760484,-0.09334413,-0.17949381,-0.28187993,-0.40910017,-0.47256044,-0.37820905,-0.050660703,0.25327346,0.28935027,0.27218527,0.2686282,0.15352686,0.07436823,0.086013064,0.03662069,-0.03765196,-0.025271958,0.055809543,0.08330272,0.005136005,-0.047806144,-0.046810385,-0.09686475,-0.122591466,-0.038212035,0.082973816,0.10409813,-0.03086842,-0.15451741,-0.08823838,0.057823457,0.10582014,0.104023054,0.123351686,0.11348963,0.05198277,0.012219376,0.0530658,0.10188548,0.06831236,0.02357167,0.003458026,-0.03002572,-0.06139074,-0.07732701,-0.08320034,
+const float ir_data3[] = { 0.52926904,0.9913671,0.7762714,0.30122554,0.02760484,-0.09334413,-0.17949381,-0.28187993,-0.40910017,-0.47256044,-0.37820905,-0.050660703,0.25327346,0.28935027,0.27218527,0.2686282,0.15352686,0.07436823,0.086013064,0.03662069,-0.03765196,-0.025271958,0.055809543,0.08330272,0.005136005,-0.047806144,-0.046810385,-0.09686475,-0.122591466,-0.038212035,0.082973816,0.10409813,-0.03086842,-0.15451741,-0.08823838,0.057823457,0.10582014,0.104023054,0.123351686,0.11348963,0.05198277,0.012219376,0.0530658,0.10188548,0.06831236,0.02357167,0.003458026,-0.03002572,-0.06139074,-0.07732701,-0.08320034,
                           -0.07976689,-0.05513872,-0.027620982,5.9221995e-05,0.03597262,0.10206238,0.1552416,0.119939454,0.052263536,0.04553789,0.047794525,-0.024861239,-0.08589686,-0.06894487,-0.049504116,-0.08097945,-0.091603704,-0.050114006,-0.008138964,0.011634001,0.02815759,0.046459682,0.04021363,-0.0025765595,-0.05292374,-0.063403666,-0.051900905,-0.04517607,-0.040179342,-0.01687591,0.0025827899,0.0015933553,-0.0077868304,-0.011693262,0.0016688746,0.013408942,0.026192946,0.043882515,0.05782675,0.046051428,0.015057223,-0.033069357,-0.087710895,-0.12391825,-0.12685457,-0.107922286,-0.08932046,-0.06736319,-0.04245921,-0.01376761,0.003013659,
                           0.0090396525,0.00580002,0.0088967895,0.012176508,0.009094895,-0.00056891335,-0.025668317,-0.055932987,-0.077429086,-0.07214683,-0.053591814,-0.036590207,-0.035276435,-0.037301477,-0.039745424,-0.03694031,-0.026427237,-0.012534732,-0.0009651981,0.0033178604,0.008918116,0.016139258,0.028735144,0.025887907,0.011255307,-0.009296355,-0.029485876,-0.052700993,-0.070198014,-0.07382528,-0.06756471,-0.057344,-0.04913982,-0.035966925,-0.027394315,-0.01616257,-0.0055658454,0.008349506,0.013733038,0.010655799,0.006627273,0.0061754375,0.005410965,-0.001606019,-0.009299938,-0.021861441,-0.033020556,-0.045208976,-0.04828105,-0.04975661,-0.04553784,
                           -0.038557436,-0.029994765,-0.023018982,-0.017157892,-0.0073536127,0.0016858559,0.0122239655,0.01814008,0.023726355,0.018521804,0.009714624,-0.0039998363,-0.014515867,-0.021151088,-0.02523976,-0.028338034,-0.03162936,-0.031167278,-0.032228053,-0.0294936,-0.027232802,-0.017944131,-0.009939017,-0.00018279706,0.0051716785,0.0065148743,0.0022374608,-0.0036576446,-0.0067219594,-0.011335223,-0.014490279,-0.020637117,-0.02480784,-0.0368385,-0.048281204,-0.057237,-0.05606737,-0.0513736,-0.04256058,-0.029577868,-0.016967624,-0.0071672793,-0.0047189044,-0.0011060799,-0.0015702252,-0.00068193534,-0.0024546364,0.00021605985,-0.00046574697,-0.0032484876,-0.010052465,
@@ -34,5 +37,6 @@ std::vector<float> ir_data3 = { 0.52926904,0.9913671,0.7762714,0.30122554,0.0276
                           0.014446774,0.009726275,0.008847436,0.0059528626,0.0067875218,0.007500149,0.009873512,0.012122091,0.013608628,0.016368914,0.016112251,0.018498972,0.018424312,0.022197433,0.02220375,0.024142576,0.02267084,0.022745766,0.02174164,0.020829141,0.020211931,0.018440062,0.019169701,0.017672582,0.01892792,0.016710838,0.018604191,0.018346699,0.021145618,0.02162157,0.023625748,0.025533015,0.026963178,0.028700838,0.027634833,0.028351722,0.02585701,0.026522428,0.023505192,0.023094479,0.019726042,0.019039115,0.017455809
                           };
 
-std::vector<std::vector<float>> ir_collection = {  ir_data1, ir_data2, ir_data3
-                                                 };
+// Spans, not copies: LoadQspiIrBank() points them at the flash instead
+clevelandmusicco::StaticVector<clevelandmusicco::Span<const float>, 3> ir_collection = {  ir_data1, ir_data2, ir_data3
+                                                                                       };
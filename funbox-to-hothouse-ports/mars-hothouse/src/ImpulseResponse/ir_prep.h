@@ -0,0 +1,148 @@
+//
+//  ir_prep.h
+//
+//  Cabinet IR preprocessing for ImpulseResponse::InitBank(), so the
+//  convolver only runs the taps that are heard:
+//
+//    IrMinimumPhase()     the same magnitude response with the energy moved
+//                         as early as it can go (real cepstrum method)
+//    IrEffectiveLength()  where the tail falls below a threshold
+//    IrTruncate()         cut there, with a short fade-out
+//
+//  tools/mars_ir_gen.py runs the same steps offline (--min-phase,
+//  --tail-db), so a QSPI bank can hold IRs that are already short, and
+//  converts IRs of any length. IrMinimumPhase() allocates its FFT buffers
+//  for as long as it runs: boot time only.
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <vector>
+#include "shy_fft.h"
+
+// Longest minimum-phase FFT (two buffers of it: 128 KB of heap, briefly).
+// IRs are padded to 8x their length, or the cepstrum wraps round and leaves
+// a tail the truncation then has to keep, so on the Seed only IRs up to
+// kIrPrepMaxFft / 8 taps are converted; the offline tool has no limit.
+constexpr size_t kIrPrepMaxFft = 16384;
+
+// Magnitude floor for the log spectrum, relative to the peak (-120 dB)
+constexpr float kIrPrepFloor = 1e-6f;
+
+// Fade-out over the last taps of a truncated IR: at most this many, and at
+// most a quarter of what's kept
+constexpr size_t kIrTruncateFade = 64;
+
+// The shortest length whose tail (the taps after it) holds at most
+// tailDb (e.g. -60) of the IR's energy. tailDb >= 0 keeps every tap.
+inline size_t IrEffectiveLength(const float* ir, size_t length, float tailDb)
+{
+  if (tailDb >= 0.0f)
+    return length;
+  double total = 0.0;
+  for (size_t i = 0; i < length; i++)
+    total += static_cast<double>(ir[i]) * ir[i];
+  const double limit = total * std::pow(10.0, tailDb / 10.0);
+
+  double tail = 0.0;
+  size_t n = length;
+  while (n > 1)
+  {
+    const double e = static_cast<double>(ir[n - 1]) * ir[n - 1];
+    if (tail + e > limit)
+      break;
+    tail += e;
+    n--;
+  }
+  return n;
+}
+
+// Cuts ir (size taps) to length, fading the last ones out with a half
+// cosine so the cut doesn't click, and returns what's kept. Does nothing
+// unless length is shorter.
+inline size_t IrTruncate(float* ir, size_t size, size_t length)
+{
+  if (length >= size)
+    return size;
+  const size_t fade = std::min(kIrTruncateFade, length / 4);
+  for (size_t i = 0; i < fade; i++)
+  {
+    const float phase = static_cast<float>(i + 1) / static_cast<float>(fade + 1);
+    ir[length - 1 - i] *= 0.5f - 0.5f * std::cos(static_cast<float>(M_PI) * phase);
+  }
+  return length;
+}
+
+// One FFT size of IrMinimumPhase(). ShyFFT's spectra hold the real parts
+// of bins 0..N/2 and then the imaginary parts of bins 1..N/2-1.
+template <size_t N>
+void _IrMinimumPhase(float* ir, size_t size)
+{
+  ShyFFT<float, N, RotationPhasor> fft;
+  fft.Init();
+  std::vector<float> a(N, 0.0f), b(N);
+  constexpr size_t H = N / 2;
+
+  // Log magnitude spectrum
+  std::copy(ir, ir + size, a.begin());
+  fft.Direct(a.data(), b.data());
+  float peak = 0.0f;
+  a[0] = std::fabs(b[0]);
+  a[H] = std::fabs(b[H]);
+  for (size_t k = 1; k < H; k++)
+    a[k] = std::sqrt(b[k] * b[k] + b[H + k] * b[H + k]);
+  for (size_t k = 0; k <= H; k++)
+    peak = std::max(peak, a[k]);
+  const float floor = std::max(peak * kIrPrepFloor, 1e-30f);
+  for (size_t k = 0; k <= H; k++)
+    a[k] = std::log(std::max(a[k], floor));
+  std::fill(a.begin() + H + 1, a.end(), 0.0f);
+
+  // Real cepstrum, folded onto positive quefrencies
+  fft.Inverse(a.data(), b.data());
+  const float scale = 1.0f / static_cast<float>(N);
+  a[0] = b[0] * scale;
+  a[H] = b[H] * scale;
+  for (size_t n = 1; n < H; n++)
+    a[n] = 2.0f * b[n] * scale;
+  std::fill(a.begin() + H + 1, a.end(), 0.0f);
+
+  // Back to a spectrum, exponentiated
+  fft.Direct(a.data(), b.data());
+  a[0] = std::exp(b[0]);
+  a[H] = std::exp(b[H]);
+  for (size_t k = 1; k < H; k++)
+  {
+    const float m = std::exp(b[k]);
+    a[k] = m * std::cos(b[H + k]);
+    a[H + k] = m * std::sin(b[H + k]);
+  }
+
+  fft.Inverse(a.data(), b.data());
+  for (size_t i = 0; i < size; i++)
+    ir[i] = b[i] * scale;
+}
+
+// Replaces ir (size taps) with its minimum-phase version: the same
+// magnitude response and length. Returns false, leaving ir as it is, if
+// it's too long.
+inline bool IrMinimumPhase(float* ir, size_t size)
+{
+  if (size == 0 || size > kIrPrepMaxFft / 8)
+    return false;
+  size_t n = 1024;
+  while (n < 8 * size)
+    n *= 2;
+  switch (n)
+  {
+    case 1024:  _IrMinimumPhase<1024>(ir, size);  break;
+    case 2048:  _IrMinimumPhase<2048>(ir, size);  break;
+    case 4096:  _IrMinimumPhase<4096>(ir, size);  break;
+    case 8192:  _IrMinimumPhase<8192>(ir, size);  break;
+    default:    _IrMinimumPhase<kIrPrepMaxFft>(ir, size);  break;
+  }
+  return true;
+}
@@ -71,6 +71,23 @@ namespace modelt_detail
         static void call(T&) { }
     };
 
+    /** Detects layers that provide a batched forwardBlock() */
+    template <typename... Ts>
+    struct make_void
+    {
+        typedef void type;
+    };
+
+    template <typename LayerType, typename = void>
+    struct has_forward_block : std::false_type
+    {
+    };
+
+    template <typename LayerType>
+    struct has_forward_block<LayerType, typename make_void<decltype(LayerType::block_chunk)>::type> : std::true_type
+    {
+    };
+
     template <typename T, typename LayerType>
     void loadLayer(LayerType&, int&, const nlohmann::json&, const std::string&, int, bool debug)
     {
@@ -425,6 +442,22 @@ public:
         return outs[0];
     }
 
+    /**
+     * Performs forward propagation for a block of samples, for models
+     * with a single input and output.
+     *
+     * When the first layer supports it (currently the STL GRULayerT),
+     * its input projection is batched across the block. Otherwise this
+     * is the same as calling forward() once per sample.
+     */
+    template <int N = in_size, int M = out_size>
+    RTNEURAL_REALTIME inline typename std::enable_if<N == 1 && M == 1, void>::type
+    forwardBlock(const T* input, T* output, int numSamples)
+    {
+        using first_layer_type = std::remove_reference_t<decltype(std::get<0>(layers))>;
+        forwardBlock(input, output, numSamples, modelt_detail::has_forward_block<first_layer_type> {});
+    }
+
     /** Returns a pointer to the output of the final layer in the network. */
     RTNEURAL_REALTIME inline const T* getOutputs() const noexcept
     {
@@ -446,6 +479,21 @@ public:
     }
 
 private:
+    void forwardBlock(const T* input, T* output, int numSamples, std::true_type)
+    {
+        std::get<0>(layers).forwardBlock(input, numSamples, [this, output](int n)
+            {
+                modelt_detail::forward_unroll<1, n_layers - 1>::call(layers);
+                output[n] = get<n_layers - 1>().outs[0];
+            });
+    }
+
+    void forwardBlock(const T* input, T* output, int numSamples, std::false_type)
+    {
+        for(int n = 0; n < numSamples; ++n)
+            output[n] = forward(input + n);
+    }
+
 #if RTNEURAL_USE_XSIMD
     using v_type = xsimd::simd_type<T>;
     static constexpr auto v_size = (int)v_type::size;
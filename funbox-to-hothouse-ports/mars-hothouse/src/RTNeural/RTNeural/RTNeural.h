@@ -8,6 +8,7 @@
 // RTNeural includes:
 #include "config.h"
 
+#include "maths/maths_approx.h"
 #include "Model.h"
 #include "ModelT.h"
 #include "model_loader.h"
@@ -205,6 +205,18 @@ public:
                 weights(i, k) = newWeights[i][k];
     }
 
+    /**
+     * Sets the layer weights from a flat, row-major array
+     * laid out as weights[out_size][in_size].
+     */
+    RTNEURAL_REALTIME void setWeights(const T* newWeights)
+    {
+        T* rows[out_size];
+        for(int i = 0; i < out_size; ++i)
+            rows[i] = const_cast<T*>(newWeights + i * in_size); // only read from
+        setWeights(rows);
+    }
+
     /**
      * Sets the layer bias from a given array of size
      * bias[out_size]
@@ -234,6 +234,18 @@ public:
         }
     }
 
+    /**
+     * Sets the layer weights from a flat, row-major array
+     * laid out as weights[out_size][in_size].
+     */
+    RTNEURAL_REALTIME void setWeights(const T* newWeights)
+    {
+        T* rows[out_size];
+        for(int i = 0; i < out_size; ++i)
+            rows[i] = const_cast<T*>(newWeights + i * in_size); // only read from
+        setWeights(rows);
+    }
+
     /**
      * Sets the layer bias from a given array of size
      * bias[out_size]
@@ -333,6 +345,18 @@ public:
         }
     }
 
+    /**
+     * Sets the layer weights from a flat, row-major array
+     * laid out as weights[out_size][in_size].
+     */
+    RTNEURAL_REALTIME void setWeights(const T* newWeights)
+    {
+        T* rows[out_size];
+        for(int i = 0; i < out_size; ++i)
+            rows[i] = const_cast<T*>(newWeights + i * in_size); // only read from
+        setWeights(rows);
+    }
+
 #if RTNEURAL_HAS_CPP17
     template <bool b = has_bias>
     RTNEURAL_REALTIME inline typename std::enable_if<b>::type setBias(const T* bias_vals)
@@ -439,6 +463,18 @@ public:
             weights[i / v_size] = set_value(weights[i / v_size], i % v_size, newWeights[i][0]);
     }
 
+    /**
+     * Sets the layer weights from a flat, row-major array
+     * laid out as weights[out_size][in_size].
+     */
+    RTNEURAL_REALTIME void setWeights(const T* newWeights)
+    {
+        T* rows[out_size];
+        for(int i = 0; i < out_size; ++i)
+            rows[i] = const_cast<T*>(newWeights + i * in_size); // only read from
+        setWeights(rows);
+    }
+
     /**
      * Sets the layer bias from a given array of size
      * bias[out_size]
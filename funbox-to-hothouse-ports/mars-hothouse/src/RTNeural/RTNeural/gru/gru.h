@@ -163,6 +163,9 @@ public:
     static constexpr auto in_size = in_sizet;
     static constexpr auto out_size = out_sizet;
 
+    /** Max samples whose input projection forwardBlock() batches at once. */
+    static constexpr int block_chunk = 16;
+
     GRULayerT();
 
     /** Returns the name of this layer. */
@@ -189,20 +192,19 @@ public:
     RTNEURAL_REALTIME inline typename std::enable_if<(N > 1), void>::type
     forward(const T (&ins)[in_size]) noexcept
     {
+        recurrent_gates_mul(outs);
+
         // compute zt
-        recurrent_mat_mul(outs, Uz, zt);
         kernel_mat_mul(ins, Wz, kernel_outs);
         for(int i = 0; i < out_size; ++i)
             zt[i] = MathsProvider::sigmoid(zt[i] + bz[i] + kernel_outs[i]);
 
         // compute rt
-        recurrent_mat_mul(outs, Ur, rt);
         kernel_mat_mul(ins, Wr, kernel_outs);
         for(int i = 0; i < out_size; ++i)
             rt[i] = MathsProvider::sigmoid(rt[i] + br[i] + kernel_outs[i]);
 
         // compute h_hat
-        recurrent_mat_mul(outs, Uh, ct);
         kernel_mat_mul(ins, Wh, kernel_outs);
         for(int i = 0; i < out_size; ++i)
             ht[i] = MathsProvider::tanh(rt[i] * (ct[i] + bh1[i]) + bh0[i] + kernel_outs[i]);
@@ -215,24 +217,68 @@ public:
     RTNEURAL_REALTIME inline typename std::enable_if<N == 1, void>::type
     forward(const T (&ins)[in_size]) noexcept
     {
+        recurrent_gates_mul(outs);
+
         // compute zt
-        recurrent_mat_mul(outs, Uz, zt);
         for(int i = 0; i < out_size; ++i)
             zt[i] = MathsProvider::sigmoid(zt[i] + bz[i] + (Wz_1[i] * ins[0]));
 
         // compute rt
-        recurrent_mat_mul(outs, Ur, rt);
         for(int i = 0; i < out_size; ++i)
             rt[i] = MathsProvider::sigmoid(rt[i] + br[i] + (Wr_1[i] * ins[0]));
 
         // compute h_hat
-        recurrent_mat_mul(outs, Uh, ct);
         for(int i = 0; i < out_size; ++i)
             ht[i] = MathsProvider::tanh(rt[i] * (ct[i] + bh1[i]) + bh0[i] + (Wh_1[i] * ins[0]));
 
         computeOutput();
     }
 
+    /**
+     * Performs forward propagation for a block of scalar inputs.
+     *
+     * The input projection (W * x + b) is computed for up to `block_chunk`
+     * samples in one pass, leaving only the recurrent mat-mul (fused
+     * across the three gates, see `recurrent_gates_mul()`) in the
+     * per-sample loop. `onSample(n)` is called after each step, while
+     * `outs` holds the output for sample n.
+     */
+    template <typename StepFn, int N = in_size>
+    RTNEURAL_REALTIME inline typename std::enable_if<N == 1, void>::type
+    forwardBlock(const T* ins, int numSamples, StepFn&& onSample) noexcept
+    {
+        for(int start = 0; start < numSamples; start += block_chunk)
+        {
+            const int count = std::min(block_chunk, numSamples - start);
+            for(int n = 0; n < count; ++n)
+            {
+                const T x = ins[start + n];
+                for(int i = 0; i < out_size; ++i)
+                {
+                    kernel_block[n][i] = Wz_1[i] * x + bz[i];
+                    kernel_block[n][i + out_size] = Wr_1[i] * x + br[i];
+                    kernel_block[n][i + 2 * out_size] = Wh_1[i] * x + bh0[i];
+                }
+            }
+
+            for(int n = 0; n < count; ++n)
+            {
+                const T* kernel = kernel_block[n];
+                recurrent_gates_mul(outs);
+
+                for(int i = 0; i < out_size; ++i)
+                {
+                    zt[i] = MathsProvider::sigmoid(zt[i] + kernel[i]);
+                    rt[i] = MathsProvider::sigmoid(rt[i] + kernel[i + out_size]);
+                    ht[i] = MathsProvider::tanh(rt[i] * (ct[i] + bh1[i]) + kernel[i + 2 * out_size]);
+                }
+
+                computeOutput();
+                onSample(start + n);
+            }
+        }
+    }
+
     /**
      * Sets the layer kernel weights.
      *
@@ -254,6 +300,24 @@ public:
      */
     RTNEURAL_REALTIME void setBVals(const std::vector<std::vector<T>>& bVals);
 
+    /**
+     * Sets the layer kernel weights from a flat, row-major array
+     * laid out as weights[in_size][3 * out_size].
+     */
+    RTNEURAL_REALTIME void setWVals(const T* wVals);
+
+    /**
+     * Sets the layer recurrent weights from a flat, row-major array
+     * laid out as weights[out_size][3 * out_size].
+     */
+    RTNEURAL_REALTIME void setUVals(const T* uVals);
+
+    /**
+     * Sets the layer bias from a flat, row-major array
+     * laid out as bias[2][3 * out_size].
+     */
+    RTNEURAL_REALTIME void setBVals(const T* bVals);
+
     T outs alignas(RTNEURAL_DEFAULT_ALIGNMENT)[out_size];
 
 private:
@@ -303,10 +367,31 @@ private:
         }
     }
 
-    static inline void recurrent_mat_mul(const T (&vec)[out_size], const T (&mat)[out_size][out_size], T (&out)[out_size]) noexcept
+    /**
+     * zt, rt and ct = Uz, Ur and Uh times vec, in one pass over U. Each
+     * row of U holds the three gates' weights interleaved (z, r, h for
+     * column 0, then column 1, ...), so the loads of all three run
+     * sequentially from one pointer: on the M7 that is one load stream
+     * instead of three, and the constant row length unrolls fully for the
+     * small hidden sizes amp models use. Each sum runs over k in order, as
+     * three separate inner products would.
+     */
+    inline void recurrent_gates_mul(const T (&vec)[out_size]) noexcept
     {
-        for(int j = 0; j < out_size; ++j)
-            out[j] = std::inner_product(mat[j], mat[j] + out_size, vec, (T)0);
+        for(int i = 0; i < out_size; ++i)
+        {
+            const T* u = U[i];
+            T z = (T)0, r = (T)0, c = (T)0;
+            for(int k = 0; k < out_size; ++k, u += 3)
+            {
+                z += u[0] * vec[k];
+                r += u[1] * vec[k];
+                c += u[2] * vec[k];
+            }
+            zt[i] = z;
+            rt[i] = r;
+            ct[i] = c;
+        }
     }
 
     static inline void kernel_mat_mul(const T (&vec)[in_size], const T (&mat)[out_size][in_size], T (&out)[out_size]) noexcept
@@ -321,15 +406,17 @@ private:
     T Wh alignas(RTNEURAL_DEFAULT_ALIGNMENT)[out_size][in_size];
     T kernel_outs alignas(RTNEURAL_DEFAULT_ALIGNMENT)[out_size];
 
+    // input projections batched by forwardBlock()
+    T kernel_block alignas(RTNEURAL_DEFAULT_ALIGNMENT)[block_chunk][3 * out_size];
+
     // single-input kernel weights
     T Wz_1 alignas(RTNEURAL_DEFAULT_ALIGNMENT)[out_size];
     T Wr_1 alignas(RTNEURAL_DEFAULT_ALIGNMENT)[out_size];
     T Wh_1 alignas(RTNEURAL_DEFAULT_ALIGNMENT)[out_size];
 
-    // recurrent weights
-    T Uz alignas(RTNEURAL_DEFAULT_ALIGNMENT)[out_size][out_size];
-    T Ur alignas(RTNEURAL_DEFAULT_ALIGNMENT)[out_size][out_size];
-    T Uh alignas(RTNEURAL_DEFAULT_ALIGNMENT)[out_size][out_size];
+    // recurrent weights, gate-interleaved: U[i][3 * k + g] is gate g's
+    // (z, r, h) weight from output k into output i
+    T U alignas(RTNEURAL_DEFAULT_ALIGNMENT)[out_size][3 * out_size];
 
     // biases
     T bz alignas(RTNEURAL_DEFAULT_ALIGNMENT)[out_size];
@@ -250,12 +250,8 @@ GRULayerT<T, in_sizet, out_sizet, sampleRateCorr, MathsProvider>::GRULayerT()
     for(int i = 0; i < out_size; ++i)
     {
         // recurrent weights
-        for(int k = 0; k < out_size; ++k)
-        {
-            Uz[i][k] = (T)0;
-            Ur[i][k] = (T)0;
-            Uh[i][k] = (T)0;
-        }
+        for(int k = 0; k < 3 * out_size; ++k)
+            U[i][k] = (T)0;
 
         // kernel weights
         for(int k = 0; k < in_size; ++k)
@@ -339,9 +335,9 @@ void GRULayerT<T, in_sizet, out_sizet, sampleRateCorr, MathsProvider>::setUVals(
     {
         for(int j = 0; j < out_size; ++j)
         {
-            Uz[j][i] = uVals[i][j];
-            Ur[j][i] = uVals[i][j + out_size];
-            Uh[j][i] = uVals[i][j + 2 * out_size];
+            U[j][3 * i] = uVals[i][j];
+            U[j][3 * i + 1] = uVals[i][j + out_size];
+            U[j][3 * i + 2] = uVals[i][j + 2 * out_size];
         }
     }
 }
@@ -359,6 +355,60 @@ void GRULayerT<T, in_sizet, out_sizet, sampleRateCorr, MathsProvider>::setBVals(
     }
 }
 
+// kernel weights (flat)
+template <typename T, int in_sizet, int out_sizet, SampleRateCorrectionMode sampleRateCorr, typename MathsProvider>
+void GRULayerT<T, in_sizet, out_sizet, sampleRateCorr, MathsProvider>::setWVals(const T* wVals)
+{
+    constexpr int stride = 3 * out_size;
+    for(int i = 0; i < in_size; ++i)
+    {
+        for(int j = 0; j < out_size; ++j)
+        {
+            Wz[j][i] = wVals[i * stride + j];
+            Wr[j][i] = wVals[i * stride + j + out_size];
+            Wh[j][i] = wVals[i * stride + j + 2 * out_size];
+        }
+    }
+
+    for(int j = 0; j < out_size; ++j)
+    {
+        Wz_1[j] = wVals[j];
+        Wr_1[j] = wVals[j + out_size];
+        Wh_1[j] = wVals[j + 2 * out_size];
+    }
+}
+
+// recurrent weights (flat)
+template <typename T, int in_sizet, int out_sizet, SampleRateCorrectionMode sampleRateCorr, typename MathsProvider>
+void GRULayerT<T, in_sizet, out_sizet, sampleRateCorr, MathsProvider>::setUVals(const T* uVals)
+{
+    constexpr int stride = 3 * out_size;
+    for(int i = 0; i < out_size; ++i)
+    {
+        for(int j = 0; j < out_size; ++j)
+        {
+            U[j][3 * i] = uVals[i * stride + j];
+            U[j][3 * i + 1] = uVals[i * stride + j + out_size];
+            U[j][3 * i + 2] = uVals[i * stride + j + 2 * out_size];
+        }
+    }
+}
+
+// biases (flat)
+template <typename T, int in_sizet, int out_sizet, SampleRateCorrectionMode sampleRateCorr, typename MathsProvider>
+void GRULayerT<T, in_sizet, out_sizet, sampleRateCorr, MathsProvider>::setBVals(const T* bVals)
+{
+    const T* b0 = bVals;
+    const T* b1 = bVals + 3 * out_size;
+    for(int k = 0; k < out_size; ++k)
+    {
+        bz[k] = b0[k] + b1[k];
+        br[k] = b0[k + out_size] + b1[k + out_size];
+        bh0[k] = b0[k + 2 * out_size];
+        bh1[k] = b1[k + 2 * out_size];
+    }
+}
+
 #endif // !RTNEURAL_USE_EIGEN && !RTNEURAL_USE_XSIMD
 
 } // namespace RTNEURAL_NAMESPACE
@@ -235,6 +235,43 @@ void GRULayerT<T, in_sizet, out_sizet, sampleRateCorr, MathsProvider>::setBVals(
     }
 }
 
+// kernel weights (flat)
+template <typename T, int in_sizet, int out_sizet, SampleRateCorrectionMode sampleRateCorr, typename MathsProvider>
+void GRULayerT<T, in_sizet, out_sizet, sampleRateCorr, MathsProvider>::setWVals(const T* wVals)
+{
+    for(int i = 0; i < in_size; ++i)
+    {
+        for(int k = 0; k < out_size * 3; ++k)
+        {
+            wCombinedWeights(k, i) = wVals[i * out_size * 3 + k];
+        }
+    }
+}
+
+// recurrent weights (flat)
+template <typename T, int in_sizet, int out_sizet, SampleRateCorrectionMode sampleRateCorr, typename MathsProvider>
+void GRULayerT<T, in_sizet, out_sizet, sampleRateCorr, MathsProvider>::setUVals(const T* uVals)
+{
+    for(int i = 0; i < out_size; ++i)
+    {
+        for(int k = 0; k < out_size * 3; ++k)
+        {
+            uCombinedWeights(k, i) = uVals[i * out_size * 3 + k];
+        }
+    }
+}
+
+// biases (flat)
+template <typename T, int in_sizet, int out_sizet, SampleRateCorrectionMode sampleRateCorr, typename MathsProvider>
+void GRULayerT<T, in_sizet, out_sizet, sampleRateCorr, MathsProvider>::setBVals(const T* bVals)
+{
+    for(int k = 0; k < out_size * 3; ++k)
+    {
+        wCombinedWeights(k, in_sizet) = bVals[k];
+        uCombinedWeights(k, out_sizet) = bVals[out_size * 3 + k];
+    }
+}
+
 } // namespace RTNEURAL_NAMESPACE
 
 #endif // RTNEURAL_USE_EIGEN
@@ -273,6 +273,24 @@ public:
      */
     RTNEURAL_REALTIME void setBVals(const std::vector<std::vector<T>>& bVals);
 
+    /**
+     * Sets the layer kernel weights from a flat, row-major array
+     * laid out as weights[in_size][3 * out_size].
+     */
+    RTNEURAL_REALTIME void setWVals(const T* wVals);
+
+    /**
+     * Sets the layer recurrent weights from a flat, row-major array
+     * laid out as weights[out_size][3 * out_size].
+     */
+    RTNEURAL_REALTIME void setUVals(const T* uVals);
+
+    /**
+     * Sets the layer bias from a flat, row-major array
+     * laid out as bias[2][3 * out_size].
+     */
+    RTNEURAL_REALTIME void setBVals(const T* bVals);
+
     v_type outs[v_out_size];
 
 private:
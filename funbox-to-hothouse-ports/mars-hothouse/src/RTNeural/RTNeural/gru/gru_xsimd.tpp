@@ -334,4 +334,58 @@ void GRULayerT<T, in_sizet, out_sizet, sampleRateCorr, MathsProvider>::setBVals(
     }
 }
 
+// kernel weights (flat)
+template <typename T, int in_sizet, int out_sizet, SampleRateCorrectionMode sampleRateCorr, typename MathsProvider>
+void GRULayerT<T, in_sizet, out_sizet, sampleRateCorr, MathsProvider>::setWVals(const T* wVals)
+{
+    constexpr int stride = 3 * out_size;
+    for(int i = 0; i < out_size; ++i)
+    {
+        for(int k = 0; k < in_size; ++k)
+        {
+            Wz[k][i / v_size] = set_value(Wz[k][i / v_size], i % v_size, wVals[k * stride + i]);
+            Wr[k][i / v_size] = set_value(Wr[k][i / v_size], i % v_size, wVals[k * stride + i + out_size]);
+            Wh[k][i / v_size] = set_value(Wh[k][i / v_size], i % v_size, wVals[k * stride + i + 2 * out_size]);
+        }
+    }
+
+    for(int j = 0; j < out_size; ++j)
+    {
+        Wz_1[j / v_size] = set_value(Wz_1[j / v_size], j % v_size, wVals[j]);
+        Wr_1[j / v_size] = set_value(Wr_1[j / v_size], j % v_size, wVals[j + out_size]);
+        Wh_1[j / v_size] = set_value(Wh_1[j / v_size], j % v_size, wVals[j + 2 * out_size]);
+    }
+}
+
+// recurrent weights (flat)
+template <typename T, int in_sizet, int out_sizet, SampleRateCorrectionMode sampleRateCorr, typename MathsProvider>
+void GRULayerT<T, in_sizet, out_sizet, sampleRateCorr, MathsProvider>::setUVals(const T* uVals)
+{
+    constexpr int stride = 3 * out_size;
+    for(int i = 0; i < out_size; ++i)
+    {
+        for(int k = 0; k < out_size; ++k)
+        {
+            Uz[k][i / v_size] = set_value(Uz[k][i / v_size], i % v_size, uVals[k * stride + i]);
+            Ur[k][i / v_size] = set_value(Ur[k][i / v_size], i % v_size, uVals[k * stride + i + out_size]);
+            Uh[k][i / v_size] = set_value(Uh[k][i / v_size], i % v_size, uVals[k * stride + i + 2 * out_size]);
+        }
+    }
+}
+
+// biases (flat)
+template <typename T, int in_sizet, int out_sizet, SampleRateCorrectionMode sampleRateCorr, typename MathsProvider>
+void GRULayerT<T, in_sizet, out_sizet, sampleRateCorr, MathsProvider>::setBVals(const T* bVals)
+{
+    const T* b0 = bVals;
+    const T* b1 = bVals + 3 * out_size;
+    for(int k = 0; k < out_size; ++k)
+    {
+        bz[k / v_size] = set_value(bz[k / v_size], k % v_size, b0[k] + b1[k]);
+        br[k / v_size] = set_value(br[k / v_size], k % v_size, b0[k + out_size] + b1[k + out_size]);
+        bh0[k / v_size] = set_value(bh0[k / v_size], k % v_size, b0[k + 2 * out_size]);
+        bh1[k / v_size] = set_value(bh1[k / v_size], k % v_size, b1[k + 2 * out_size]);
+    }
+}
+
 } // namespace RTNEURAL_NAMESPACE
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cmath>
+#include "maths_approx_tables.h"
+
+namespace RTNEURAL_NAMESPACE
+{
+/**
+ * Approximate MathsProviders for the STL backend.
+ *
+ * Any of these can be passed as the `MathsProvider` template argument of
+ * GRULayerT, LSTMLayerT or the activation layers to trade accuracy for
+ * cycles at compile time. Errors are the max absolute error vs. std::tanh
+ * and the exact sigmoid in single precision, over all inputs. sigmoid is
+ * evaluated as 0.5 + 0.5 * tanh(x / 2) so it has half the tanh error.
+ * exp() stays exact.
+ *
+ * | provider             | tanh error | sigmoid error | per call             |
+ * |----------------------|------------|---------------|----------------------|
+ * | DefaultMathsProvider | exact      | exact         | libm tanh / exp      |
+ * | PadeMathsProvider    | 7.2e-5     | 3.6e-5        | 1 div, 9 mul/add     |
+ * | PolyMathsProvider    | 2.6e-6     | 1.3e-6        | 4 loads, 12 mul/add  |
+ * | LutMathsProvider     | 2.3e-5     | 1.2e-5        | 2 loads, 3 mul/add   |
+ *
+ * The table-based providers also take a branch for |x| past the table.
+ */
+
+/** [7/6] Pade approximant of tanh with a clamped input. */
+struct PadeMathsProvider
+{
+    template <typename T>
+    static T tanh(T x)
+    {
+        // Clamp where the approximant error meets the error of holding it constant
+        constexpr T limit = (T)4.8;
+        x = x > limit ? limit : (x < -limit ? -limit : x);
+        const T x2 = x * x;
+        const T num = x * ((T)135135 + x2 * ((T)17325 + x2 * ((T)378 + x2)));
+        const T den = (T)135135 + x2 * ((T)62370 + x2 * ((T)3150 + x2 * (T)28));
+        return num / den;
+    }
+
+    template <typename T>
+    static T sigmoid(T x)
+    {
+        return (T)0.5 + (T)0.5 * tanh(x * (T)0.5);
+    }
+
+    template <typename T>
+    static T exp(T x)
+    {
+        return std::exp(x);
+    }
+};
+
+/** Piecewise cubic Hermite tanh, 64 segments on [0, 8], odd-symmetric. */
+struct PolyMathsProvider
+{
+    template <typename T>
+    static T tanh(T x)
+    {
+        using namespace approx_tables;
+        const T ax = x < (T)0 ? -x : x;
+        const T pos = ax * (T)tanh_knot_scale;
+        if(pos >= (T)tanh_knots)
+            return x < (T)0 ? (T)-1 : (T)1;
+
+        const int k = (int)pos;
+        const T t = pos - (T)k;
+        const T h = (T)1 / (T)tanh_knot_scale;
+        const T y0 = (T)tanh_knot_value[k];
+        const T y1 = (T)tanh_knot_value[k + 1];
+        const T m0 = (T)tanh_knot_slope[k] * h;
+        const T m1 = (T)tanh_knot_slope[k + 1] * h;
+
+        // Hermite basis in Horner form
+        const T c2 = (T)3 * (y1 - y0) - (T)2 * m0 - m1;
+        const T c3 = (T)2 * (y0 - y1) + m0 + m1;
+        const T y = y0 + t * (m0 + t * (c2 + t * c3));
+        return x < (T)0 ? -y : y;
+    }
+
+    template <typename T>
+    static T sigmoid(T x)
+    {
+        return (T)0.5 + (T)0.5 * tanh(x * (T)0.5);
+    }
+
+    template <typename T>
+    static T exp(T x)
+    {
+        return std::exp(x);
+    }
+};
+
+/** 512 entry tanh table on [0, 8] with linear interpolation, odd-symmetric. */
+struct LutMathsProvider
+{
+    template <typename T>
+    static T tanh(T x)
+    {
+        using namespace approx_tables;
+        const T ax = x < (T)0 ? -x : x;
+        const T pos = ax * (T)tanh_lut_scale;
+        if(pos >= (T)tanh_lut_size)
+            return x < (T)0 ? (T)-1 : (T)1;
+
+        const int k = (int)pos;
+        const T t = pos - (T)k;
+        const T y = (T)tanh_lut[k] + t * ((T)tanh_lut[k + 1] - (T)tanh_lut[k]);
+        return x < (T)0 ? -y : y;
+    }
+
+    template <typename T>
+    static T sigmoid(T x)
+    {
+        return (T)0.5 + (T)0.5 * tanh(x * (T)0.5);
+    }
+
+    template <typename T>
+    static T exp(T x)
+    {
+        return std::exp(x);
+    }
+};
+} // namespace RTNEURAL_NAMESPACE
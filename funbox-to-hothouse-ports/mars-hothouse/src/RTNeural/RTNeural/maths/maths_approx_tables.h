@@ -0,0 +1,130 @@
+#pragma once
+
+// Generated tables for maths_approx.h. tanh sampled on [0, 8], step 1/64
+// (LUT), and tanh with its derivative on [0, 8], step 1/8 (cubic Hermite).
+
+namespace RTNEURAL_NAMESPACE
+{
+namespace approx_tables
+{
+    static constexpr int tanh_lut_size = 512; // + 1 guard entry
+    static constexpr float tanh_lut_scale = 64.0f;
+    alignas(RTNEURAL_DEFAULT_ALIGNMENT) static constexpr float tanh_lut[513] = {
+        0.0f, 0.0156237286f, 0.0312398314f, 0.0468406979f, 0.0624187467f, 0.0779664414f,
+        0.093476304f, 0.10894093f, 0.124353002f, 0.139705303f, 0.15499073f, 0.170202308f,
+        0.1853332f, 0.200376719f, 0.21532634f, 0.230175711f, 0.244918662f, 0.259549215f,
+        0.274061589f, 0.288450213f, 0.302709729f, 0.316835001f, 0.330821117f, 0.344663398f,
+        0.358357398f, 0.37189891f, 0.385283966f, 0.398508842f, 0.411570056f, 0.424464368f,
+        0.437188785f, 0.449740552f, 0.462117157f, 0.474316325f, 0.486336017f, 0.498174426f,
+        0.509829974f, 0.521301305f, 0.532587286f, 0.543686996f, 0.554599722f, 0.565324958f,
+        0.575862391f, 0.586211902f, 0.596373555f, 0.606347593f, 0.616134427f, 0.625734636f,
+        0.635148952f, 0.644378261f, 0.653423588f, 0.662286096f, 0.670967074f, 0.679467935f,
+        0.687790205f, 0.695935517f, 0.703905604f, 0.711702294f, 0.719327501f, 0.72678322f,
+        0.73407152f, 0.741194537f, 0.74815447f, 0.754953575f, 0.761594156f, 0.768078563f,
+        0.774409187f, 0.780588452f, 0.786618812f, 0.792502746f, 0.798242755f, 0.803841353f,
+        0.80930107f, 0.814624443f, 0.819814012f, 0.824872321f, 0.82980191f, 0.834605315f,
+        0.839285062f, 0.84384367f, 0.84828364f, 0.852607461f, 0.856817601f, 0.860916511f,
+        0.864906618f, 0.868790325f, 0.872570011f, 0.876248029f, 0.8798267f, 0.883308319f,
+        0.886695149f, 0.889989423f, 0.89319334f, 0.896309067f, 0.899338735f, 0.902284443f,
+        0.905148254f, 0.907932195f, 0.910638259f, 0.913268402f, 0.915824544f, 0.918308568f,
+        0.920722322f, 0.923067616f, 0.925346225f, 0.927559888f, 0.929710307f, 0.931799149f,
+        0.933828043f, 0.935798587f, 0.937712339f, 0.939570826f, 0.941375538f, 0.943127934f,
+        0.944829436f, 0.946481434f, 0.948085286f, 0.949642317f, 0.95115382f, 0.952621057f,
+        0.95404526f, 0.955427629f, 0.956769334f, 0.958071518f, 0.959335293f, 0.960561744f,
+        0.961751926f, 0.962906871f, 0.96402758f, 0.965115031f, 0.966170173f, 0.967193935f,
+        0.968187217f, 0.969150896f, 0.970085827f, 0.970992841f, 0.971872746f, 0.972726329f,
+        0.973554356f, 0.974357571f, 0.975136698f, 0.975892441f, 0.976625484f, 0.977336493f,
+        0.978026115f, 0.978694978f, 0.979343695f, 0.979972859f, 0.980583047f, 0.981174821f,
+        0.981748725f, 0.98230529f, 0.982845029f, 0.983368443f, 0.983876017f, 0.984368222f,
+        0.984845517f, 0.985308347f, 0.985757143f, 0.986192324f, 0.986614298f, 0.987023461f,
+        0.987420196f, 0.987804876f, 0.988177862f, 0.988539507f, 0.988890151f, 0.989230124f,
+        0.989559749f, 0.989879336f, 0.990189189f, 0.9904896f, 0.990780856f, 0.991063231f,
+        0.991336996f, 0.991602409f, 0.991859725f, 0.992109186f, 0.992351033f, 0.992585494f,
+        0.992812795f, 0.993033152f, 0.993246775f, 0.99345387f, 0.993654634f, 0.99384926f,
+        0.994037935f, 0.994220838f, 0.994398146f, 0.994570029f, 0.994736652f, 0.994898175f,
+        0.995054754f, 0.995206538f, 0.995353675f, 0.995496305f, 0.995634567f, 0.995768593f,
+        0.995898513f, 0.996024452f, 0.996146531f, 0.996264868f, 0.996379578f, 0.996490771f,
+        0.996598555f, 0.996703034f, 0.996804309f, 0.996902478f, 0.996997635f, 0.997089874f,
+        0.997179283f, 0.997265949f, 0.997349955f, 0.997431384f, 0.997510313f, 0.997586821f,
+        0.997660979f, 0.997732862f, 0.997802538f, 0.997870075f, 0.997935538f, 0.997998991f,
+        0.998060496f, 0.998120112f, 0.998177898f, 0.998233908f, 0.998288199f, 0.998340822f,
+        0.998391828f, 0.998441268f, 0.998489189f, 0.998535637f, 0.998580659f, 0.998624298f,
+        0.998666595f, 0.998707593f, 0.998747332f, 0.998785849f, 0.998823182f, 0.998859369f,
+        0.998894443f, 0.998928439f, 0.99896139f, 0.998993329f, 0.999024286f, 0.999054291f,
+        0.999083374f, 0.999111563f, 0.999138886f, 0.999165368f, 0.999191037f, 0.999215916f,
+        0.999240031f, 0.999263404f, 0.999286059f, 0.999308017f, 0.9993293f, 0.999349928f,
+        0.999369923f, 0.999389302f, 0.999408086f, 0.999426292f, 0.999443938f, 0.999461042f,
+        0.999477619f, 0.999493687f, 0.999509261f, 0.999524356f, 0.999538987f, 0.999553167f,
+        0.999566912f, 0.999580234f, 0.999593146f, 0.999605661f, 0.999617791f, 0.999629549f,
+        0.999640944f, 0.999651989f, 0.999662694f, 0.999673071f, 0.999683128f, 0.999692875f,
+        0.999702323f, 0.99971148f, 0.999720356f, 0.999728958f, 0.999737296f, 0.999745378f,
+        0.999753211f, 0.999760803f, 0.999768161f, 0.999775293f, 0.999782206f, 0.999788906f,
+        0.9997954f, 0.999801695f, 0.999807795f, 0.999813708f, 0.999819439f, 0.999824994f,
+        0.999830378f, 0.999835596f, 0.999840654f, 0.999845556f, 0.999850308f, 0.999854913f,
+        0.999859376f, 0.999863703f, 0.999867896f, 0.99987196f, 0.999875899f, 0.999879717f,
+        0.999883417f, 0.999887004f, 0.99989048f, 0.99989385f, 0.999897116f, 0.999900281f,
+        0.999903349f, 0.999906322f, 0.999909204f, 0.999911998f, 0.999914705f, 0.999917329f,
+        0.999919873f, 0.999922338f, 0.999924727f, 0.999927043f, 0.999929287f, 0.999931463f,
+        0.999933572f, 0.999935615f, 0.999937596f, 0.999939516f, 0.999941377f, 0.999943181f,
+        0.999944929f, 0.999946623f, 0.999948265f, 0.999949857f, 0.9999514f, 0.999952895f,
+        0.999954344f, 0.999955749f, 0.99995711f, 0.99995843f, 0.999959709f, 0.999960948f,
+        0.99996215f, 0.999963314f, 0.999964443f, 0.999965537f, 0.999966597f, 0.999967625f,
+        0.999968621f, 0.999969586f, 0.999970522f, 0.999971429f, 0.999972308f, 0.99997316f,
+        0.999973986f, 0.999974786f, 0.999975562f, 0.999976314f, 0.999977042f, 0.999977749f,
+        0.999978433f, 0.999979097f, 0.99997974f, 0.999980363f, 0.999980967f, 0.999981553f,
+        0.999982121f, 0.999982671f, 0.999983204f, 0.999983721f, 0.999984221f, 0.999984707f,
+        0.999985177f, 0.999985633f, 0.999986075f, 0.999986504f, 0.999986919f, 0.999987322f,
+        0.999987712f, 0.99998809f, 0.999988456f, 0.999988811f, 0.999989156f, 0.999989489f,
+        0.999989813f, 0.999990126f, 0.99999043f, 0.999990724f, 0.99999101f, 0.999991286f,
+        0.999991554f, 0.999991814f, 0.999992066f, 0.99999231f, 0.999992547f, 0.999992776f,
+        0.999992998f, 0.999993214f, 0.999993423f, 0.999993625f, 0.999993821f, 0.999994011f,
+        0.999994195f, 0.999994374f, 0.999994547f, 0.999994715f, 0.999994877f, 0.999995035f,
+        0.999995188f, 0.999995336f, 0.999995479f, 0.999995618f, 0.999995753f, 0.999995884f,
+        0.999996011f, 0.999996133f, 0.999996252f, 0.999996368f, 0.999996479f, 0.999996588f,
+        0.999996693f, 0.999996794f, 0.999996893f, 0.999996989f, 0.999997081f, 0.999997171f,
+        0.999997258f, 0.999997342f, 0.999997424f, 0.999997503f, 0.99999758f, 0.999997655f,
+        0.999997727f, 0.999997797f, 0.999997865f, 0.99999793f, 0.999997994f, 0.999998056f,
+        0.999998116f, 0.999998173f, 0.99999823f, 0.999998284f, 0.999998337f, 0.999998388f,
+        0.999998438f, 0.999998486f, 0.999998532f, 0.999998578f, 0.999998621f, 0.999998664f,
+        0.999998705f, 0.999998745f, 0.999998783f, 0.999998821f, 0.999998857f, 0.999998892f,
+        0.999998926f, 0.999998959f, 0.999998991f, 0.999999022f, 0.999999052f, 0.999999082f,
+        0.99999911f, 0.999999137f, 0.999999164f, 0.999999189f, 0.999999214f, 0.999999239f,
+        0.999999262f, 0.999999285f, 0.999999307f, 0.999999328f, 0.999999349f, 0.999999369f,
+        0.999999388f, 0.999999407f, 0.999999425f, 0.999999443f, 0.99999946f, 0.999999477f,
+        0.999999493f, 0.999999508f, 0.999999524f, 0.999999538f, 0.999999552f, 0.999999566f,
+        0.99999958f, 0.999999592f, 0.999999605f, 0.999999617f, 0.999999629f, 0.99999964f,
+        0.999999651f, 0.999999662f, 0.999999673f, 0.999999683f, 0.999999692f, 0.999999702f,
+        0.999999711f, 0.99999972f, 0.999999729f, 0.999999737f, 0.999999745f, 0.999999753f,
+        0.99999976f, 0.999999768f, 0.999999775f
+    };
+
+    static constexpr int tanh_knots = 64; // + 1 guard knot
+    static constexpr float tanh_knot_scale = 8.0f;
+    alignas(RTNEURAL_DEFAULT_ALIGNMENT) static constexpr float tanh_knot_value[65] = {
+        0.0f, 0.124353002f, 0.244918662f, 0.358357398f, 0.462117157f, 0.554599722f,
+        0.635148952f, 0.703905604f, 0.761594156f, 0.80930107f, 0.84828364f, 0.8798267f,
+        0.905148254f, 0.925346225f, 0.941375538f, 0.95404526f, 0.96402758f, 0.971872746f,
+        0.978026115f, 0.982845029f, 0.986614298f, 0.989559749f, 0.991859725f, 0.993654634f,
+        0.995054754f, 0.996146531f, 0.996997635f, 0.997660979f, 0.998177898f, 0.998580659f,
+        0.998894443f, 0.999138886f, 0.9993293f, 0.999477619f, 0.999593146f, 0.999683128f,
+        0.999753211f, 0.999807795f, 0.999850308f, 0.999883417f, 0.999909204f, 0.999929287f,
+        0.999944929f, 0.99995711f, 0.999966597f, 0.999973986f, 0.99997974f, 0.999984221f,
+        0.999987712f, 0.99999043f, 0.999992547f, 0.999994195f, 0.999995479f, 0.999996479f,
+        0.999997258f, 0.999997865f, 0.999998337f, 0.999998705f, 0.999998991f, 0.999999214f,
+        0.999999388f, 0.999999524f, 0.999999629f, 0.999999711f, 0.999999775f
+    };
+    alignas(RTNEURAL_DEFAULT_ALIGNMENT) static constexpr float tanh_knot_slope[65] = {
+        1.0f, 0.984536331f, 0.940014849f, 0.871579975f, 0.786447733f, 0.692419148f,
+        0.596585808f, 0.504516901f, 0.419974342f, 0.345031778f, 0.280414866f, 0.225904979f,
+        0.180706639f, 0.143734363f, 0.113812096f, 0.0897976415f, 0.0706508249f, 0.0554633658f,
+        0.0434649189f, 0.0340156486f, 0.0265922267f, 0.0207715039f, 0.0162142868f, 0.0126504677f,
+        0.00986603717f, 0.00769208943f, 0.00599571483f, 0.00467257004f, 0.00364088472f, 0.00283666707f,
+        0.00220989229f, 0.00172148681f, 0.00134095068f, 0.00104448839f, 0.000813542382f, 0.000633644468f,
+        0.000493517399f, 0.000384372719f, 0.000299362502f, 0.000233151471f, 0.000181583231f, 0.000141420003f,
+        0.000110139732f, 8.57779541e-05f, 6.68045716e-05f, 5.20278371e-05f, 4.05195535e-05f, 3.15568014e-05f,
+        2.45765474e-05f, 1.91402864e-05f, 1.49065016e-05f, 1.16092142e-05f, 9.04127676e-06f, 7.04136046e-06f,
+        5.48382131e-06f, 4.27080692e-06f, 3.32610934e-06f, 2.59037752e-06f, 2.01738862e-06f, 1.57114418e-06f,
+        1.22360853e-06f, 9.52947413e-07f, 7.4215627e-07f, 5.77991931e-07f, 4.50140598e-07f
+    };
+} // namespace approx_tables
+} // namespace RTNEURAL_NAMESPACE
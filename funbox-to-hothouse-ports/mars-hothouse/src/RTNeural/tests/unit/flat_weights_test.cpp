@@ -0,0 +1,95 @@
+#include <gmock/gmock.h>
+
+#include <RTNeural/RTNeural.h>
+
+using namespace testing;
+
+namespace
+{
+std::vector<float> makeWeights(size_t count, float seed)
+{
+    std::vector<float> flat(count);
+    for(size_t i = 0; i < count; ++i)
+        flat[i] = std::sin(seed * (float)(i + 1)) * 0.5f;
+    return flat;
+}
+
+std::vector<std::vector<float>> toRows(const std::vector<float>& flat, size_t rows, size_t cols)
+{
+    std::vector<std::vector<float>> out(rows, std::vector<float>(cols));
+    for(size_t i = 0; i < rows; ++i)
+        for(size_t j = 0; j < cols; ++j)
+            out[i][j] = flat[i * cols + j];
+    return out;
+}
+} // namespace
+
+TEST(FlatWeightsTest, gruFlatSettersMatchVectorSetters)
+{
+    constexpr int in_size = 2;
+    constexpr int out_size = 9;
+
+    const auto w = makeWeights(in_size * 3 * out_size, 0.37f);
+    const auto u = makeWeights(out_size * 3 * out_size, 0.91f);
+    const auto b = makeWeights(2 * 3 * out_size, 1.73f);
+
+    RTNeural::GRULayerT<float, in_size, out_size> fromVectors;
+    fromVectors.setWVals(toRows(w, in_size, 3 * out_size));
+    fromVectors.setUVals(toRows(u, out_size, 3 * out_size));
+    fromVectors.setBVals(toRows(b, 2, 3 * out_size));
+
+    RTNeural::GRULayerT<float, in_size, out_size> fromFlat;
+    fromFlat.setWVals(w.data());
+    fromFlat.setUVals(u.data());
+    fromFlat.setBVals(b.data());
+
+    fromVectors.reset();
+    fromFlat.reset();
+    for(int n = 0; n < 32; ++n)
+    {
+        const float x[in_size] = { std::sin(0.1f * (float)n), std::cos(0.23f * (float)n) };
+#if RTNEURAL_USE_EIGEN
+        const Eigen::Matrix<float, in_size, 1> in { x[0], x[1] };
+        fromVectors.forward(in);
+        fromFlat.forward(in);
+        for(int i = 0; i < out_size; ++i)
+            EXPECT_FLOAT_EQ(fromFlat.outs(i), fromVectors.outs(i));
+#elif RTNEURAL_USE_XSIMD
+        const xsimd::simd_type<float> in[1] = { xsimd::simd_type<float>(x[0]) };
+        fromVectors.forward(in);
+        fromFlat.forward(in);
+        for(int i = 0; i < RTNeural::ceil_div(out_size, (int)xsimd::simd_type<float>::size); ++i)
+            EXPECT_TRUE(xsimd::all(fromFlat.outs[i] == fromVectors.outs[i]));
+#else
+        fromVectors.forward(x);
+        fromFlat.forward(x);
+        for(int i = 0; i < out_size; ++i)
+            EXPECT_FLOAT_EQ(fromFlat.outs[i], fromVectors.outs[i]);
+#endif
+    }
+}
+
+#if !RTNEURAL_USE_EIGEN && !RTNEURAL_USE_XSIMD
+TEST(FlatWeightsTest, denseFlatSetterMatchesVectorSetter)
+{
+    constexpr int in_size = 9;
+    constexpr int out_size = 3;
+
+    const auto w = makeWeights(out_size * in_size, 0.53f);
+
+    RTNeural::DenseT<float, in_size, out_size> fromVectors;
+    fromVectors.setWeights(toRows(w, out_size, in_size));
+
+    RTNeural::DenseT<float, in_size, out_size> fromFlat;
+    fromFlat.setWeights(w.data());
+
+    float x[in_size];
+    for(int k = 0; k < in_size; ++k)
+        x[k] = (float)k * 0.1f - 0.4f;
+
+    fromVectors.forward(x);
+    fromFlat.forward(x);
+    for(int i = 0; i < out_size; ++i)
+        EXPECT_FLOAT_EQ(fromFlat.outs[i], fromVectors.outs[i]);
+}
+#endif
@@ -0,0 +1,73 @@
+#include <gmock/gmock.h>
+
+#include <RTNeural/RTNeural.h>
+
+using namespace testing;
+
+namespace
+{
+using GRUModel = RTNeural::ModelT<float, 1, 1,
+    RTNeural::GRULayerT<float, 1, 9>,
+    RTNeural::DenseT<float, 9, 1>>;
+
+void fillWeights(GRUModel& model)
+{
+    auto& gru = model.get<0>();
+    auto& dense = model.get<1>();
+
+    auto value = [](int i, float seed)
+    { return std::sin(seed * (float)(i + 1)) * 0.5f; };
+
+    std::vector<std::vector<float>> w(1, std::vector<float>(27));
+    std::vector<std::vector<float>> u(9, std::vector<float>(27));
+    std::vector<std::vector<float>> b(2, std::vector<float>(27));
+    for(int k = 0; k < 27; ++k)
+    {
+        w[0][k] = value(k, 0.37f);
+        b[0][k] = value(k, 1.73f);
+        b[1][k] = value(k, 2.11f);
+        for(int j = 0; j < 9; ++j)
+            u[j][k] = value(j * 27 + k, 0.91f);
+    }
+    gru.setWVals(w);
+    gru.setUVals(u);
+    gru.setBVals(b);
+
+    std::vector<std::vector<float>> dw(1, std::vector<float>(9));
+    for(int j = 0; j < 9; ++j)
+        dw[0][j] = value(j, 0.53f);
+    dense.setWeights(dw);
+    const float bias = 0.05f;
+    dense.setBias(&bias);
+}
+} // namespace
+
+TEST(ForwardBlockTest, gruModelBlockMatchesPerSample)
+{
+    GRUModel perSample;
+    GRUModel block;
+    fillWeights(perSample);
+    fillWeights(block);
+    perSample.reset();
+    block.reset();
+
+    // odd block sizes straddle the layer's internal batching chunk
+    const std::vector<int> blockSizes { 1, 7, 16, 33, 256 };
+
+    int n = 0;
+    for(int size : blockSizes)
+    {
+        std::vector<float> input(size);
+        for(auto& x : input)
+            x = 0.8f * std::sin(0.05f * (float)n++);
+
+        std::vector<float> expected(size);
+        for(int i = 0; i < size; ++i)
+            expected[i] = perSample.forward(&input[i]);
+
+        std::vector<float> actual(size);
+        block.forwardBlock(input.data(), actual.data(), size);
+
+        EXPECT_THAT(actual, Pointwise(FloatNear(1e-5f), expected));
+    }
+}
@@ -0,0 +1,82 @@
+#include <gmock/gmock.h>
+
+#include <RTNeural/RTNeural.h>
+
+using namespace testing;
+
+namespace
+{
+template <typename MathsProvider>
+void expectMaxError(float tanhBound, float sigmoidBound)
+{
+    float tanhError = 0.0f;
+    float sigmoidError = 0.0f;
+    for(float x = -12.0f; x <= 12.0f; x += 1.0e-3f)
+    {
+        const auto exactTanh = (float)std::tanh((double)x);
+        const auto exactSigmoid = (float)(1.0 / (1.0 + std::exp(-(double)x)));
+        tanhError = std::max(tanhError, std::abs(MathsProvider::tanh(x) - exactTanh));
+        sigmoidError = std::max(sigmoidError, std::abs(MathsProvider::sigmoid(x) - exactSigmoid));
+    }
+
+    EXPECT_LE(tanhError, tanhBound);
+    EXPECT_LE(sigmoidError, sigmoidBound);
+}
+} // namespace
+
+// bounds are the documented errors in maths_approx.h, rounded up
+TEST(MathsApproxTest, padeStaysWithinDocumentedError)
+{
+    expectMaxError<RTNeural::PadeMathsProvider>(7.5e-5f, 4.0e-5f);
+}
+
+TEST(MathsApproxTest, polyStaysWithinDocumentedError)
+{
+    expectMaxError<RTNeural::PolyMathsProvider>(3.0e-6f, 1.5e-6f);
+}
+
+TEST(MathsApproxTest, lutStaysWithinDocumentedError)
+{
+    expectMaxError<RTNeural::LutMathsProvider>(2.5e-5f, 1.5e-5f);
+}
+
+TEST(MathsApproxTest, approximationsAreOddAndSaturate)
+{
+    EXPECT_FLOAT_EQ(RTNeural::PolyMathsProvider::tanh(-0.3f), -RTNeural::PolyMathsProvider::tanh(0.3f));
+    EXPECT_FLOAT_EQ(RTNeural::LutMathsProvider::tanh(-2.7f), -RTNeural::LutMathsProvider::tanh(2.7f));
+    EXPECT_FLOAT_EQ(RTNeural::PolyMathsProvider::tanh(100.0f), 1.0f);
+    EXPECT_FLOAT_EQ(RTNeural::LutMathsProvider::tanh(-100.0f), -1.0f);
+    EXPECT_NEAR(RTNeural::PadeMathsProvider::tanh(100.0f), 1.0f, 1.0e-4f);
+}
+
+#if !RTNEURAL_USE_EIGEN && !RTNEURAL_USE_XSIMD
+TEST(MathsApproxTest, gruAcceptsApproximateProvider)
+{
+    RTNeural::GRULayerT<float, 1, 4> exact;
+    RTNeural::GRULayerT<float, 1, 4, RTNeural::SampleRateCorrectionMode::None, RTNeural::PolyMathsProvider> approx;
+
+    const float w[12] = { 0.3f, -0.2f, 0.5f, 0.1f, -0.4f, 0.25f, 0.6f, -0.1f, 0.2f, 0.35f, -0.3f, 0.15f };
+    float u[4 * 12];
+    for(int i = 0; i < 4 * 12; ++i)
+        u[i] = 0.1f * std::sin((float)i);
+    const float b[24] = {};
+
+    exact.setWVals(w);
+    exact.setUVals(u);
+    exact.setBVals(b);
+    approx.setWVals(w);
+    approx.setUVals(u);
+    approx.setBVals(b);
+    exact.reset();
+    approx.reset();
+
+    for(int n = 0; n < 256; ++n)
+    {
+        const float x[1] = { std::sin(0.07f * (float)n) };
+        exact.forward(x);
+        approx.forward(x);
+        for(int i = 0; i < 4; ++i)
+            EXPECT_NEAR(approx.outs[i], exact.outs[i], 1.0e-4f);
+    }
+}
+#endif
@@ -0,0 +1,64 @@
+#pragma once
+#ifndef ACTIVITY_GATE_H
+#define ACTIVITY_GATE_H
+#include <stddef.h>
+
+/** Tells the audio callback when there's nothing to hear, so it can skip
+    its expensive stages, from block peaks with hysteresis. It goes idle once
+    every peak it has been shown has stayed under closeLevel for holdSamples,
+    and wakes on the first block whose input peak is over openLevel, which
+    is then processed as normal.
+
+    Usage, once per callback:
+        if (!gate.Awake(inputPeak)) { skip the block; return; }
+        ... process ...
+        gate.Settle(peak of the input, the output and any tail, size);
+*/
+class ActivityGate
+{
+  public:
+    ActivityGate() {}
+    ~ActivityGate() {}
+
+    void Init(float openLevel, float closeLevel, size_t holdSamples)
+    {
+        open_  = openLevel;
+        close_ = closeLevel;
+        hold_  = holdSamples;
+        quiet_ = 0;
+        idle_  = false;
+    }
+
+    /** False while idle and inputPeak hasn't crossed openLevel */
+    inline bool Awake(float inputPeak)
+    {
+        if(idle_ && inputPeak > open_)
+        {
+            idle_  = false;
+            quiet_ = 0;
+        }
+        return !idle_;
+    }
+
+    /** After a processed block: peak is the loudest of everything still
+        sounding. Pass a peak over closeLevel to keep it awake regardless.
+    */
+    inline void Settle(float peak, size_t size)
+    {
+        if(peak > close_)
+            quiet_ = 0;
+        else if((quiet_ += size) >= hold_)
+            idle_ = true;
+    }
+
+    inline bool Idle() const { return idle_; }
+
+  private:
+    float  open_  = 0.0f;
+    float  close_ = 0.0f;
+    size_t hold_  = 0;
+    size_t quiet_ = 0;
+    bool   idle_  = false;
+};
+
+#endif
@@ -1,342 +0,0 @@
-#pragma once
-
-struct modelData {
-  std::vector<std::vector<float>> rec_weight_ih_l0; 
-  std::vector<std::vector<float>> rec_weight_hh_l0;  
-  std::vector<std::vector<float>> lin_weight;
-  std::vector<float> lin_bias;
-  std::vector<std::vector<float>> rec_bias;
-  float levelAdjust;
-};
-
-// ADD YOUR MODEL IDENTIFIER HERE ////////////////////////////////// < -------------------
-modelData Model1; 
-modelData Model2; 
-modelData Model3;
-modelData Model4; 
-modelData Model5; 
-modelData Model6; 
-modelData Model7;
-modelData Model8; 
-
-
-/////////////////////////////////////////////////////////////////
-
-std::vector<modelData> model_collection;
-
-/*========================================================================*/
-
-void setupWeights() {
-
-// COPY AND PASTE YOUR MODEL WEIGHTS BELOW (After converting .json to .h file) ////////////////////////////////// < -------------------
-//   ADD AND REMOVE MODELS AS DESIRED (CAN HOLD AROUND 15-16 MODELS IN FLASH MEMORY)
-
-
-  //========================================================================
-//../newNeuralSeedModel fender57_g5_gru9_p003_shift16 maybe keep
-/*
-model : SimpleRNN
-input_size : 1
-skip : 1
-output_size : 1
-unit_type : GRU
-num_layers : 1
-hidden_size : 9
-bias_fl : True
-*/
-
-  Model1.rec_weight_ih_l0 = {{0.010945625603199005, -0.050199560821056366, -0.06624435633420944, -0.1976807862520218, 0.1158326119184494, -0.06330181658267975, -0.0030009972397238016, 0.010331690311431885, 0.04662841558456421, 0.050783343613147736, -0.14239542186260223, -0.146307110786438, -0.0151847954839468, 0.025679081678390503, -0.1442670226097107, 0.06651495397090912, 0.1271495223045349, 0.13272543251514435, -0.43817561864852905, -1.1551047563552856, -0.03793826326727867, 0.8241645097732544, 0.842648446559906, 0.8103972673416138, -0.01621781662106514, -1.3673923015594482, 0.8390907645225525}}; 
-
-  Model1.rec_weight_hh_l0 = {{0.2660585641860962, -0.06399577111005783, 0.1198706179857254, 0.11052851378917694, 0.20094873011112213, -0.2052612602710724, -0.21146216988563538, -0.12754301726818085, 0.32190588116645813, 0.14035136997699738, -0.07555074989795685, 0.21440546214580536, 0.41187435388565063, 0.0024969112128019333, 0.29178300499916077, 0.24995334446430206, -0.2648366689682007, -0.3174993395805359, 0.9455024600028992, 0.5280759334564209, -0.06975415349006653, -0.5438200235366821, 0.3096756339073181, -0.07702699303627014, 0.7434556484222412, -0.7418537735939026, 0.2919408679008484}, 
-                            { 0.20359723269939423, -0.0020075237844139338, 0.07313552498817444, 0.08402300626039505, 0.04145404323935509, -0.1683993637561798, 0.06027502194046974, -0.1064407229423523, 0.17345184087753296, 0.28747838735580444, 0.1693194955587387, -0.003262239508330822, 0.12429770827293396, 0.17810338735580444, 0.2705853283405304, -0.17416897416114807, 0.06282186508178711, 0.08296966552734375, 0.09632748365402222, 0.331215500831604, -0.8628224730491638, -1.292256474494934, 0.016151534393429756, 0.11461299657821655, 0.07012607902288437, -0.5104307532310486, 0.19750377535820007}, 
-                            { 0.09782777726650238, 0.07248488068580627, -0.05732868239283562, 0.20161516964435577, 0.23006261885166168, -0.01485269796103239, -0.09755771607160568, 0.03590284287929535, 0.7590547800064087, 0.1708788126707077, 0.2563200294971466, 0.43259501457214355, 0.01640007272362709, -0.011161443777382374, 0.46529996395111084, -0.08638856559991837, 0.16832393407821655, -0.9919414520263672, -0.17448554933071136, -0.0019847825169563293, 0.6101245880126953, 0.5585080981254578, -0.08212166279554367, -0.4574209451675415, 0.3841796815395355, 0.005214073695242405, -0.4805544316768646}, 
-                            { -0.06693984568119049, -0.056720852851867676, 0.36993783712387085, -0.15704692900180817, -0.0539880134165287, -0.021962974220514297, 0.14042580127716064, 0.024964187294244766, -0.29775166511535645, 0.16849516332149506, -0.01088637299835682, -0.06409332156181335, -0.0541389025747776, 0.1942768096923828, 0.497659832239151, 0.593319833278656, -0.35418015718460083, 0.656356692314148, 0.051126692444086075, 0.7387368083000183, -1.2711644172668457, 1.1626670360565186, -0.09727691859006882, -0.8460386991500854, -0.7294226288795471, 0.4267534017562866, -0.32049477100372314}, 
-                            { 0.23080605268478394, -0.023852309212088585, 0.06141763925552368, -0.0897858589887619, 0.0008013206534087658, 0.0015967594226822257, 0.10881839692592621, 0.03357997536659241, 0.2687319219112396, -0.22535589337348938, -0.11510293185710907, 0.03981808200478554, -0.07750838249921799, 0.2620641887187958, -0.2039710283279419, 0.2531137466430664, -0.4612753391265869, 0.18919694423675537, -0.6777820587158203, -0.014094461686909199, 0.10291419923305511, 0.7329023480415344, 1.211446762084961, -0.22394385933876038, -0.17840255796909332, -0.25102508068084717, -0.3324175477027893}, 
-                            { 0.010435167700052261, 0.0015351967886090279, -0.11401131004095078, 0.10941295325756073, -0.20254464447498322, 0.06844368577003479, 0.19721657037734985, -0.042450353503227234, 1.1021711826324463, 0.5912654995918274, 0.15679602324962616, -0.25755587220191956, -0.09800519794225693, -0.23541662096977234, -0.5667105913162231, -0.31713664531707764, 0.884737491607666, -0.04421587660908699, -0.0474378727376461, 0.7063164710998535, 0.27078723907470703, 0.08647460490465164, 0.08097056299448013, 0.8081551194190979, -0.7168897986412048, 0.6118642091751099, -0.3913593590259552}, 
-                            { -0.15396474301815033, 0.0874485895037651, -0.056291550397872925, 0.13632695376873016, -0.12412504106760025, -0.044237688183784485, -0.33462369441986084, 0.041841473430395126, -0.24818828701972961, 0.08980405330657959, 0.08572498708963394, 0.13920283317565918, -0.022645220160484314, 0.044136106967926025, 0.08737717568874359, 0.17118299007415771, 0.15596453845500946, -0.032321106642484665, -0.16145028173923492, 0.20161674916744232, 0.850139319896698, 0.2032565474510193, 0.11183350533246994, 0.6000909805297852, 0.8753060102462769, 0.07564043998718262, -0.5152859687805176}, 
-                            { -0.48853522539138794, 0.14787669479846954, 0.05383075028657913, 0.3275996744632721, -0.3504670560359955, 0.24404102563858032, 0.16333617269992828, 0.11575686931610107, -1.1896531581878662, -0.0010165077401325107, 0.12097855657339096, -0.07844194024801254, -0.5467158555984497, -0.18892334401607513, -0.03226330131292343, -0.5207664966583252, 0.6195607781410217, -0.07094912976026535, -0.36437997221946716, -0.06256914138793945, 0.3451904356479645, -0.4454503357410431, -0.3952321708202362, 0.10144739598035812, -0.15387959778308868, 0.052264753729104996, 0.8262813687324524}, 
-                            { -0.08667854964733124, 0.07401089370250702, -0.09816570580005646, 0.013334207236766815, 0.09177997708320618, 0.1842576116323471, 0.28860995173454285, 0.017341729253530502, 0.05852165073156357, 0.343151718378067, 0.16545747220516205, -0.6271731853485107, -0.22290657460689545, -0.18057112395763397, -0.12936334311962128, -0.7296581268310547, 0.45515164732933044, -0.04487355053424835, -0.45728376507759094, -0.19084632396697998, -0.2084663063287735, -0.26941245794296265, 0.0866464152932167, 0.9208748936653137, 0.08087804168462753, 0.8704594373703003, 1.3329368829727173}}; 
-
-  Model1.lin_weight = {{-0.15525458753108978, 0.5315423607826233, 0.8522182703018188, 0.022386819124221802, 0.19309879839420319, -0.518962562084198, 0.580614447593689, 0.37257859110832214, 0.5456886887550354}}; 
-
-  Model1.lin_bias = {0.06967336684465408}; 
-
-  Model1.rec_bias = {{1.1973379850387573, -0.44106385111808777, -0.13644300401210785, -0.3490041494369507, 1.3261643648147583, -0.380979061126709, 0.19212310016155243, -0.24578654766082764, 1.454893708229065, 0.34279128909111023, 0.30362242460250854, 0.3117355704307556, 0.5360283255577087, -0.018552329391241074, 0.3106920123100281, 0.0398116409778595, -0.0714878961443901, 0.07045018672943115, -0.3137598931789398, 0.06450533866882324, 0.0797731876373291, 0.0582866370677948, -0.14376848936080933, 0.27043846249580383, -0.21152986586093903, -0.28778964281082153, 0.2651936709880829}, 
-                    { 1.1973379850387573, -0.44106385111808777, -0.13644300401210785, -0.3490041494369507, 1.3261642456054688, -0.380979061126709, 0.19212310016155243, -0.24578654766082764, 1.454893708229065, 0.3406675457954407, 0.30381959676742554, 0.311753511428833, 0.536015510559082, -0.017991140484809875, 0.3106525242328644, 0.03981161117553711, -0.07112261652946472, 0.07591364532709122, 0.4408111870288849, 0.13189712166786194, 0.2187042236328125, -0.040134504437446594, 0.08460792899131775, -0.19480018317699432, -0.1755005568265915, 0.04271353408694267, -0.5428429841995239}}; 
-  Model1.levelAdjust = 0.9;
-
-  //========================================================================
-//../newNeuralSeedModel matchless_gru9_p02_shift51   keep (sounds better than the ac30 model)
-/*
-model : SimpleRNN
-input_size : 1
-skip : 1
-output_size : 1
-unit_type : GRU
-num_layers : 1
-hidden_size : 9
-bias_fl : True
-*/
-
-  Model2.rec_weight_ih_l0 = {{-0.029231837019324303, -0.3149751126766205, -0.5631013512611389, 0.6397935748100281, -0.03381464630365372, 0.639824390411377, -0.22903455793857574, 0.15575867891311646, -0.30347883701324463, 0.08316066116094589, 0.4032779335975647, -0.10985194146633148, -0.0464772954583168, 0.06623080372810364, 0.3327423632144928, 0.5125880837440491, 0.5497733354568481, 1.3290865421295166, -0.4052441120147705, -0.297264963388443, 0.5754965543746948, 0.44692426919937134, -0.6242079734802246, 0.815628170967102, -0.20662333071231842, -1.0047993659973145, -1.3757998943328857}}; 
-
-  Model2.rec_weight_hh_l0 = {{0.1051379069685936, 0.12829001247882843, 0.2898087501525879, -0.16671307384967804, -0.036237336695194244, 0.21648991107940674, -0.533916711807251, -0.22937588393688202, -0.2554420232772827, 0.4378296136856079, 0.7202093005180359, -0.34362006187438965, -0.03987767547369003, 0.24171796441078186, 0.3179763853549957, -0.08093664795160294, -0.1592325121164322, -0.8755542635917664, 1.0315083265304565, 0.2086344212293625, 0.25012683868408203, -0.42073965072631836, 0.6137024760246277, -0.34524330496788025, -0.11390731483697891, 0.10597434639930725, 0.1194741502404213}, 
-                            { 0.43965113162994385, 0.738184928894043, 0.033683791756629944, 1.0302988290786743, 0.27513888478279114, 0.4837151765823364, -1.6229397058486938, -0.31622952222824097, -0.4863312542438507, 0.4809456467628479, -0.03827214986085892, 0.11768703907728195, 0.3078615367412567, -0.40359431505203247, -0.18817006051540375, -0.04770904406905174, 0.6481425762176514, -0.45995381474494934, -0.19886450469493866, 0.5704367160797119, -0.5202093124389648, 0.3056955635547638, -0.12838459014892578, -0.6685692667961121, 0.16949783265590668, 0.8921375274658203, 0.6648041009902954}, 
-                            { -0.1829013079404831, 0.6881493926048279, -0.8046470284461975, -0.0994800254702568, 0.4374733567237854, -0.37969136238098145, -0.16229309141635895, -0.22432197630405426, 0.4301200211048126, -0.3332682251930237, 0.10536666959524155, -0.25979530811309814, 0.07235642522573471, -0.2359481006860733, 0.24771596491336823, -0.16564849019050598, -0.1100655049085617, 0.2774718701839447, -0.30172452330589294, -0.5792653560638428, 1.020783543586731, -0.5949492454528809, -0.20587550103664398, -0.9724681377410889, 0.4123700261116028, 0.6416595578193665, 0.9461540579795837}, 
-                            { 0.4748248755931854, -0.16523489356040955, -1.0247730016708374, -0.4438347816467285, -0.04162002354860306, 0.6843292713165283, 0.5461495518684387, 0.10365315526723862, -0.12791401147842407, 0.15804877877235413, 0.2241111546754837, 0.3072376549243927, 0.40068063139915466, -0.17062169313430786, -0.24424247443675995, 1.1446821689605713, -0.3338185250759125, 1.318892002105713, -0.01969367079436779, 0.7913597822189331, 0.9232466220855713, 0.8678138852119446, -0.11184750497341156, 0.9066728949546814, -1.6418309211730957, 1.6046421527862549, -0.10345906764268875}, 
-                            { 0.700103759765625, -0.07411743700504303, -0.004179314710199833, -0.03865315392613411, -0.0460720993578434, -0.3688267171382904, 0.19999244809150696, 0.03791762888431549, 0.8113241195678711, 0.11560288071632385, -0.21147534251213074, -0.12836022675037384, 0.13692621886730194, 0.06355466693639755, -0.5095589756965637, -0.5651673674583435, -0.12227161973714828, 0.9299392700195312, -0.787667989730835, -0.2787342667579651, 0.3045952022075653, 0.298406720161438, 1.0309174060821533, 0.25754573941230774, 0.1290983110666275, -0.08116108179092407, -0.4077262580394745}, 
-                            { 0.2238011211156845, -0.22497090697288513, 0.5864197015762329, 0.1324375718832016, 0.4805642366409302, 0.579595685005188, 0.8301312327384949, 0.0739465206861496, -0.06255380064249039, 0.41109150648117065, -0.34577304124832153, 0.4047587513923645, -0.3010903298854828, 0.182509183883667, -0.07516472041606903, -0.9580824375152588, -0.6091054081916809, -0.6514734029769897, -0.3313848674297333, 0.24173544347286224, -0.003753841854631901, -0.6665221452713013, -0.10173103958368301, 1.0094667673110962, 0.1470104604959488, -0.1860351711511612, -0.06416574865579605}, 
-                            { -0.2879454791545868, 0.033979445695877075, -0.7389340996742249, 0.6795883178710938, -0.2216651737689972, -0.6759085059165955, -0.4337523877620697, -0.06621197611093521, 0.43267014622688293, -0.24790766835212708, 0.22508424520492554, -0.020133374258875847, 0.4553159177303314, 0.4158363342285156, 0.45998603105545044, -0.6455892324447632, 0.12036023288965225, -0.548229992389679, -0.4161085784435272, 0.05514499172568321, 0.5517982244491577, 0.934627890586853, -0.4454379379749298, 0.13605183362960815, 0.6199765205383301, 0.5146094560623169, 0.05348629876971245}, 
-                            { 0.13508442044258118, 1.0049550533294678, -0.8912327289581299, -0.2059440165758133, 0.28257760405540466, 0.36072155833244324, -0.5177474617958069, -0.7398079633712769, -0.21730944514274597, 0.05850783362984657, 0.6801514625549316, 0.053404804319143295, 0.2902158498764038, 0.16145165264606476, 0.1559475064277649, 0.5667146444320679, -0.17303906381130219, 0.14446422457695007, -0.7537105083465576, 0.35898104310035706, -0.1059722900390625, -1.456192135810852, -0.7127645611763, -0.2942441403865814, 0.873897135257721, -0.369514524936676, -0.6184043288230896}, 
-                            { 0.07483966648578644, -0.35724133253097534, -0.13003917038440704, 0.03692195191979408, 0.43310803174972534, 0.6603528261184692, 0.8366883397102356, 0.03832339122891426, -0.29808709025382996, 0.20216895639896393, 0.08641715347766876, -0.2782328128814697, -0.8476051688194275, -0.21279795467853546, 0.09541693329811096, -0.24904178082942963, -1.1415947675704956, -1.593221664428711, -0.3557261824607849, -1.6010098457336426, -0.6294101476669312, 0.6125853657722473, -0.07568871974945068, -0.8783455491065979, 0.256775826215744, -0.7667081952095032, 1.3150516748428345}}; 
-
-  Model2.lin_weight = {{1.3266512155532837, 0.34957095980644226, 0.501087486743927, 0.21891072392463684, 1.2271435260772705, 0.43608468770980835, 1.0895591974258423, 0.7009875774383545, 0.630840003490448}}; 
-
-  Model2.lin_bias = {-0.3153194189071655}; 
-
-  Model2.rec_bias = {{1.6665621995925903, 0.11900100111961365, 1.0300720930099487, -0.6648464798927307, 1.8063621520996094, 0.2966279089450836, 0.14621761441230774, -0.6517598628997803, -0.8084750175476074, 0.24817079305648804, 0.30441635847091675, 0.1947382092475891, 0.5575229525566101, -0.010426747612655163, 0.30423736572265625, 0.30738455057144165, 0.3932950794696808, 0.4195604920387268, -0.09829548001289368, -0.046609267592430115, -0.05279914289712906, -0.10833795368671417, -0.0716700553894043, -0.12667514383792877, -0.16283537447452545, 0.5098429918289185, 0.7824194431304932}, 
-                    { 1.6665621995925903, 0.11900100111961365, 1.0300720930099487, -0.6648464798927307, 1.8063621520996094, 0.2966279089450836, 0.14621761441230774, -0.6517598628997803, -0.8084750175476074, 0.24812166392803192, 0.30441638827323914, 0.1947382092475891, 0.5575229525566101, -0.010421093553304672, 0.30423736572265625, 0.30738455057144165, 0.3932950794696808, 0.41956254839897156, 0.3314102292060852, -0.14917393028736115, -0.06163574755191803, 0.43613073229789734, 0.15843312442302704, 0.34317588806152344, 0.2971913814544678, -0.6883634328842163, -1.0945156812667847}}; 
-  Model2.levelAdjust = 0.9;
-
-
-//========================================================================
-//../newNeuralSeedModel klonBB_g5_gru9_p0047  keep
-/*
-model : SimpleRNN
-input_size : 1
-skip : 1
-output_size : 1
-unit_type : GRU
-num_layers : 1
-hidden_size : 9
-bias_fl : True
-*/
-
-  Model3.rec_weight_ih_l0 = {{0.10444662719964981, -0.2509694993495941, -0.18859492242336273, 0.12905894219875336, -0.0213624257594347, -0.016602396965026855, -0.029290301725268364, -0.05750759690999985, 0.1664680391550064, -0.016206733882427216, 0.4715864360332489, -0.31052863597869873, 0.49569058418273926, -0.05896488204598427, -0.48247647285461426, -0.17611847817897797, 0.29290953278541565, -0.05502455681562424, -0.7477683424949646, -0.7449806928634644, -0.08731792122125626, -0.3478814959526062, 0.1061646044254303, 0.34091150760650635, 0.49752071499824524, -1.4278879165649414, -0.04526274651288986}}; 
-
-  Model3.rec_weight_hh_l0 = {{0.11525661498308182, 0.6589143872261047, 0.16308119893074036, -0.44736701250076294, -0.03189338743686676, -0.1479557305574417, 0.18253415822982788, -0.08080007135868073, -0.9788373112678528, -0.3142144978046417, -0.09491956979036331, -0.05581255629658699, 0.016370652243494987, -0.11913515627384186, 1.1204142570495605, -0.038380905985832214, 0.1270095854997635, -0.7609812617301941, 1.4028677940368652, 0.6464325189590454, 0.08162027597427368, 0.0505477711558342, 0.06483519077301025, 0.6837432384490967, 2.1535584926605225, -0.6583212614059448, 0.4137328267097473}, 
-                            { 0.10434745997190475, -0.07272287458181381, 0.18175479769706726, -0.0759267508983612, -0.250637024641037, 0.1128450259566307, 0.17650289833545685, 0.16250360012054443, -0.32939770817756653, -0.1149883046746254, 0.0248476043343544, 0.16434291005134583, -0.08872070908546448, -0.05318576097488403, 0.16114503145217896, -0.0022610824089497328, -0.4355228543281555, 0.11316967010498047, -1.3330628871917725, 0.7218194603919983, -0.024220164865255356, -1.2629354000091553, -0.040130723267793655, 0.05341748893260956, 0.13367657363414764, -1.3404124975204468, 0.17551052570343018}, 
-                            { -0.16618411242961884, 0.04352058097720146, 0.17979450523853302, -0.17440755665302277, 0.5504544377326965, -0.1318121701478958, -0.10564969480037689, -0.08441170305013657, -0.31306663155555725, -0.05909747630357742, 0.644970715045929, -0.044318679720163345, 0.17413204908370972, -0.0146641219034791, 0.11083924025297165, 0.14596912264823914, 0.052627358585596085, -0.30600881576538086, -0.20945565402507782, 0.015016544610261917, 0.31757766008377075, -0.01714519038796425, 0.45605960488319397, -0.32995808124542236, 0.12178229540586472, 0.29139474034309387, -0.5006697773933411}, 
-                            { 0.15023282170295715, 0.1441282480955124, -0.056693267077207565, 0.07040838152170181, -0.8772526383399963, -0.013059881515800953, 0.064817875623703, 0.042674124240875244, 0.5842106938362122, -0.38225069642066956, -0.09134659171104431, -0.16935187578201294, -0.25889405608177185, -0.09202181547880173, 0.49170106649398804, -0.2257867455482483, 0.21876341104507446, -0.1014292761683464, 0.8016671538352966, 0.6441765427589417, -0.28075745701789856, 0.9095850586891174, 0.3206409513950348, 0.20267000794410706, 0.13018423318862915, 0.12309519946575165, -0.2045082151889801}, 
-                            { 0.20832060277462006, -0.9552814960479736, -0.353631854057312, 0.033666305243968964, -1.8303231000900269, 0.26324889063835144, 0.3707353174686432, 0.39020949602127075, -0.16754700243473053, -0.47703686356544495, 0.12975580990314484, -0.3626318573951721, -0.42590445280075073, -0.4810553193092346, -0.3789706528186798, -0.47842657566070557, -0.21484975516796112, 0.05949284881353378, -0.8300167322158813, 0.08073917776346207, -0.04454939812421799, 0.8361613154411316, 1.61894690990448, 0.0567285381257534, -0.2539941668510437, -0.7825270891189575, -0.00472668232396245}, 
-                            { 1.0191640853881836, -1.3472875356674194, 0.09920547157526016, 0.09955485910177231, -0.6341797113418579, 0.11043278872966766, 0.3385234475135803, 0.2581668496131897, 0.5176798701286316, -0.6596070528030396, 0.5119795799255371, 0.30907511711120605, 0.03278370946645737, -0.16609413921833038, -0.2623066008090973, -0.4611562490463257, 0.11427947878837585, 0.26000988483428955, -0.07708374410867691, 0.5731297731399536, 0.029094316065311432, -0.07273133099079132, -0.8601401448249817, 0.41233885288238525, -0.5629586577415466, 0.16659078001976013, -0.14073748886585236}, 
-                            { 0.37509506940841675, 0.1487889140844345, -0.11858949810266495, 0.07087831944227219, 0.2735036611557007, -0.17716388404369354, -0.09307867288589478, 0.11613527685403824, -0.4395287334918976, -0.008842664770781994, -0.1672339290380478, 0.31537315249443054, -0.03520191088318825, -0.2674981951713562, 0.29866844415664673, -0.21457263827323914, -0.07559972256422043, -0.29134422540664673, -0.07632139325141907, 0.16438034176826477, 0.6953585147857666, -0.023105358704924583, 0.7148849368095398, 0.3807709813117981, 1.2270466089248657, 0.1187874972820282, -0.23942866921424866}, 
-                            { 0.11136514693498611, -0.14777833223342896, -0.5078554749488831, -0.1138380840420723, -0.15143068134784698, 0.011278903111815453, 0.02197602204978466, -0.005874227732419968, -0.1660766899585724, 0.02274477109313011, -0.0985950455069542, 0.3909055292606354, -0.23491424322128296, 0.0843939483165741, -0.06675313413143158, 0.16262459754943848, -0.15021303296089172, -0.26822629570961, 1.2526988983154297, 0.34775397181510925, 0.15493448078632355, 0.21143701672554016, 0.006029791198670864, -0.0349152535200119, -0.6845308542251587, -0.06219467148184776, 0.6367154121398926}, 
-                            { 0.406575471162796, -0.8065159916877747, -0.3741682767868042, -0.03588399663567543, -1.5064218044281006, 0.2804104685783386, 0.48911887407302856, 0.43128424882888794, 0.035927824676036835, -0.3943980038166046, 0.2694636285305023, -0.17081515491008759, -0.04263731464743614, -0.16356860101222992, -0.10777611285448074, -0.4365864098072052, -0.05461650714278221, -0.5749713182449341, -0.27074748277664185, -0.06198790296912193, -0.973074734210968, 0.13153722882270813, 0.40570488572120667, 1.3750284910202026, 0.15387660264968872, 0.4259757101535797, 1.1943823099136353}}; 
-
-  Model3.lin_weight = {{0.06555154174566269, 0.585723340511322, 1.1993820667266846, -0.01910593919456005, -0.3254941701889038, -0.18385043740272522, 0.26696881651878357, 0.7222235202789307, 0.28651198744773865}}; 
-
-  Model3.lin_bias = {-0.31255820393562317}; 
-
-  Model3.rec_bias = {{-0.28041866421699524, 1.2571043968200684, 0.6403751373291016, 0.08690151572227478, 1.4934308528900146, -0.35028815269470215, -0.49143001437187195, -0.4895656108856201, 1.1014631986618042, 0.4520479738712311, -0.022474439814686775, -0.048601340502500534, 0.366519957780838, 0.3722822368144989, 0.2166307419538498, 0.5753155946731567, 0.15795785188674927, 0.36920756101608276, -0.8323541283607483, -0.03967277333140373, -0.1421913504600525, 0.18015331029891968, -0.2311353236436844, 0.4627038240432739, -0.18875837326049805, -0.40674322843551636, 0.16267065703868866}, 
-                    { -0.28041866421699524, 1.2571043968200684, 0.6403751373291016, 0.08690151572227478, 1.4934287071228027, -0.35028815269470215, -0.49143001437187195, -0.4895656108856201, 1.1014631986618042, 0.4475357234477997, -0.021434111520648003, -0.04855117201805115, 0.3662669360637665, 0.3732965588569641, 0.21644414961338043, 0.5753154754638672, 0.15866373479366302, 0.37739455699920654, -0.13255757093429565, -0.004366916138678789, -0.009892309084534645, 0.05774591863155365, 0.024283472448587418, 0.0388004370033741, -0.1363939493894577, -0.03807279095053673, -0.8816646337509155}}; 
-  Model3.levelAdjust = 0.6;
-//========================================================================
-//../newNeuralSeedModel messa iic eq original p0128 shift 183 instead of 182  lowest noise, sounds good
-/*
-model : SimpleRNN
-input_size : 1
-skip : 1
-output_size : 1
-unit_type : GRU
-num_layers : 1
-hidden_size : 9
-bias_fl : True
-*/
-
-  Model4.rec_weight_ih_l0 = {{0.2814430296421051, -0.10601122677326202, -0.04945099353790283, 0.07485648989677429, -0.6961054801940918, -0.4910812973976135, -0.2718484401702881, -0.01627524197101593, -0.0374501496553421, 0.3474334478378296, 0.2117074728012085, 0.2299647480249405, -0.33109351992607117, 0.08094002306461334, 0.7625245451927185, -1.2907862663269043, -0.20513100922107697, -0.10652125626802444, 0.13559933006763458, -0.2833845913410187, -0.12616285681724548, 0.9066472053527832, 0.014374015852808952, 2.100292682647705, -0.8516016006469727, 0.06624177098274231, 0.3447319567203522}}; 
-
-  Model4.rec_weight_hh_l0 = {{-0.4776725172996521, 0.1264982968568802, 0.061123594641685486, 0.17677165567874908, 0.3383761942386627, 0.1352197676897049, -0.01300827693194151, -0.2117326408624649, -0.1239427775144577, -0.5578879117965698, -0.2872251570224762, 0.014583979733288288, 0.0511850081384182, -0.36074841022491455, 0.012815308757126331, -0.14097175002098083, 0.2403860092163086, -0.186992347240448, 0.7936009168624878, 0.1315721720457077, -0.09344101697206497, 0.41951870918273926, -1.3414226770401, -0.39534899592399597, -0.5938615798950195, -0.28687548637390137, 0.24592068791389465}, 
-                            { 0.24202969670295715, -0.2961297035217285, -0.28924882411956787, -1.0012589693069458, -0.17016802728176117, 0.637908935546875, 0.22267334163188934, 0.19562414288520813, 0.01677987165749073, -0.1625237762928009, 1.643476963043213, -0.9622370004653931, -0.7528542876243591, 0.020873602479696274, 0.15811631083488464, 0.4471014142036438, -0.13245819509029388, 0.1663859486579895, -1.221631407737732, -0.6764618754386902, -1.9000191688537598, 0.008442327380180359, -1.871943712234497, 0.13248467445373535, 0.2753685712814331, -0.2792471945285797, -0.02284853532910347}, 
-                            { -0.10048265755176544, 0.016355343163013458, 0.8672946691513062, 0.4443272352218628, 0.3368093967437744, 0.3292061388492584, -0.0592413954436779, -0.12017639726400375, -0.06966695189476013, -0.022676851600408554, -0.08634122461080551, -0.5051179528236389, -2.070610523223877, -0.5154240131378174, 0.010548273101449013, -0.0167708657681942, -0.19948066771030426, 0.23814602196216583, 0.02274813875555992, 0.09759709239006042, 0.7298426032066345, -2.269831895828247, 0.06186548247933388, 0.004698357544839382, -0.02190471813082695, -0.04125196114182472, 0.01881636306643486}, 
-                            { -0.19136415421962738, -0.23815757036209106, 0.6888819932937622, 0.7656270861625671, -0.06635772436857224, 0.3588086664676666, -0.032963160425424576, -0.24218307435512543, 0.0018060131696984172, 0.11984527111053467, 0.13627071678638458, -1.386063575744629, 1.327043890953064, -0.01954427920281887, -0.003544121515005827, -0.07933732122182846, 0.10343629866838455, 0.27592796087265015, 0.07041879743337631, -0.09671662747859955, 0.21126490831375122, 0.95865398645401, -0.041025493294000626, 0.0013416317524388433, -0.0005313330329954624, 0.007090425118803978, -0.2991381585597992}, 
-                            { 0.10009195655584335, 0.5169633626937866, -0.0015973434783518314, -1.2178750038146973, 1.277948260307312, -0.6836581826210022, -0.09380525350570679, 0.023678060621023178, -0.0625782310962677, 0.05080469697713852, -1.1588910818099976, -1.781064748764038, -0.07479068636894226, -0.1542879045009613, -0.05529066175222397, -0.10945872962474823, -0.11709138751029968, -0.002788121346384287, 0.7342593669891357, 1.2173552513122559, -1.0994430780410767, 0.4908110499382019, 2.2181060314178467, -0.0679241269826889, -0.17445135116577148, 0.19577476382255554, 0.07862482219934464}, 
-                            { 0.40284812450408936, -1.2446483373641968, -0.3397694230079651, 0.22191479802131653, -0.3410000205039978, -0.5218013525009155, -0.022151784971356392, 0.2559012472629547, -0.06550517678260803, -0.2747061252593994, -0.9056085348129272, -0.7935614585876465, 0.23361186683177948, 0.5094031095504761, -0.05706151947379112, -1.2930928468704224, 0.052306149154901505, -0.12074967473745346, 0.5355346202850342, -1.5286816358566284, -1.0710783004760742, -0.9931448698043823, 2.0995211601257324, 1.0013189315795898, -0.37779292464256287, 0.3131645917892456, 0.009836643002927303}, 
-                            { 0.06881941109895706, -0.47228384017944336, 0.03586467355489731, 0.1897205114364624, -0.5709006786346436, 0.6212071776390076, -0.06678985804319382, 0.13542155921459198, -0.31338632106781006, -0.14245696365833282, -0.1893080174922943, -0.027418246492743492, -0.6684828996658325, -0.20925787091255188, -0.1796063929796219, 1.0326935052871704, 0.0007892892463132739, 0.10186822712421417, 0.5076878666877747, -1.319150447845459, -0.32685545086860657, 0.7667765021324158, 1.724655032157898, 3.5752015113830566, 0.34944823384284973, 0.3560718595981598, 0.38612157106399536}, 
-                            { -0.26963722705841064, 0.1306147575378418, -0.0420653261244297, 0.12350305914878845, 0.043301060795784, -0.1247343122959137, 0.29557833075523376, -0.1791735589504242, -0.2697601020336151, 0.36782175302505493, 0.020023252815008163, 0.3946547210216522, 0.04103904962539673, -0.06274614483118057, -0.10222409665584564, 0.25905218720436096, -0.3254704475402832, -0.24696402251720428, 0.056852009147405624, 0.12636516988277435, 0.3546000123023987, 0.11819493025541306, 0.040822941809892654, -0.3929901719093323, -0.43078282475471497, 1.2384212017059326, -0.7772414684295654}, 
-                            { -0.2201954424381256, 0.36120977997779846, -0.055914536118507385, 0.2594129145145416, 0.23586688935756683, 0.16859330236911774, -0.10293246060609818, 0.056883350014686584, -0.19537100195884705, 0.14842155575752258, 0.1398843377828598, -0.08113209903240204, 0.2720661163330078, -0.1036592572927475, 0.041199710220098495, -0.003946354147046804, -0.15092526376247406, 0.17666849493980408, -0.5239841938018799, 0.048218898475170135, 0.45783737301826477, 0.21446239948272705, 0.18674954771995544, -0.10356154292821884, -0.18619294464588165, 0.5749920010566711, 1.1640300750732422}}; 
-
-  Model4.lin_weight = {{0.559700608253479, 0.05602197349071503, 0.037872590124607086, -0.5296688079833984, 0.040486838668584824, -0.345439612865448, 0.6072275638580322, -1.1746656894683838, -1.3116488456726074}}; 
-
-  Model4.lin_bias = {-0.009952176362276077}; 
-
-  Model4.rec_bias = {{1.4544556140899658, 0.3116452097892761, 0.2023361623287201, -0.7783133387565613, 0.1474064290523529, -0.37509268522262573, 1.2265702486038208, 1.5453016757965088, 1.5517385005950928, -0.0994311198592186, 0.7627780437469482, 0.6167539358139038, 0.4681053161621094, 0.8334406614303589, 0.31196537613868713, -0.9086094498634338, 0.4087037742137909, 0.3023912012577057, -0.04329086095094681, -1.0118701457977295, 0.10204429924488068, 0.6014783382415771, -0.31283214688301086, 0.016538623720407486, -0.1563028246164322, -0.05946138873696327, -0.03175334632396698}, 
-                    { 1.4544686079025269, 0.3116452097892761, 0.2023361623287201, -0.7783133387565613, 0.1474064290523529, -0.37509268522262573, 1.2265706062316895, 1.5453016757965088, 1.5517358779907227, -0.09944087266921997, 0.7628083825111389, 0.6167539358139038, 0.4681053161621094, 0.8334406614303589, 0.31196537613868713, -0.9086100459098816, 0.4087037742137909, 0.3023912012577057, -0.1834275722503662, 1.4153164625167847, -0.03216709941625595, -0.6119195222854614, 0.3455105423927307, 0.4000234603881836, -0.5442468523979187, 0.027705200016498566, 0.006273994687944651}}; 
-  Model4.levelAdjust = 0.6;
-
-
-//========================================================================
-//../newNeuralSeedModel hak_clean_gru9_p01_shift74
-/*
-model : SimpleRNN
-input_size : 1
-skip : 1
-output_size : 1
-unit_type : GRU
-num_layers : 1
-hidden_size : 9
-bias_fl : True
-*/
-
-  Model5.rec_weight_ih_l0 = {{-0.012616475112736225, -0.7235372066497803, -0.4347362816333771, 0.1892153024673462, -0.08144751191139221, 0.036260172724723816, -0.6552191972732544, 0.22501792013645172, -0.21257677674293518, -0.10840824246406555, 0.3135877847671509, 0.1433219611644745, 0.5612328052520752, 0.12199562788009644, 0.24716418981552124, 0.04816562682390213, -0.19276079535484314, -0.07039432227611542, -0.021911803632974625, -0.6911193132400513, -0.03611823171377182, 1.1240495443344116, -0.24010713398456573, 0.38096800446510315, -0.06465018540620804, -0.04449412226676941, -0.8703638315200806}}; 
-
-  Model5.rec_weight_hh_l0 = {{-0.06873027235269547, -0.16898947954177856, -0.0444570891559124, -0.05785595253109932, 0.18334859609603882, -0.06899290531873703, -0.02134804241359234, -0.08113344013690948, 0.3541274666786194, -0.17101676762104034, 0.4329218864440918, -0.01149047538638115, -0.24853231012821198, 0.018187738955020905, 0.1724725216627121, -0.23232418298721313, 0.5164659023284912, -0.29107412695884705, 1.2529988288879395, 0.530044674873352, 0.7836939096450806, -0.3416409194469452, 0.9708663821220398, -0.0037755602970719337, -0.04013848677277565, -0.19462473690509796, -0.4484274983406067}, 
-                            { 0.2299157977104187, -0.0008343359222635627, 0.255938857793808, 0.02885049395263195, -0.34060558676719666, 0.33023902773857117, -0.18781906366348267, -0.19321434199810028, -0.8284543752670288, 0.41753146052360535, -0.11070365458726883, -0.05010388419032097, -0.6573538184165955, -0.007941516116261482, 0.151602640748024, -0.4048653244972229, 0.06196979433298111, 0.3122237026691437, 0.01598399691283703, 1.1304174661636353, -0.11414197087287903, 0.7169473171234131, 0.40345078706741333, -0.10171397030353546, 0.6032255291938782, 1.2270222902297974, 0.9702175855636597}, 
-                            { -0.18242232501506805, 0.024363812059164047, -0.37241166830062866, -0.17790614068508148, 0.4241403639316559, 0.1978207677602768, 0.2086690366268158, 0.22681792080402374, 0.3215771019458771, -0.3545038104057312, -0.19558987021446228, -0.10655679553747177, -0.2435087114572525, 0.3202384114265442, 0.4003159701824188, 0.5471120476722717, 0.7150876522064209, 0.038987256586551666, -0.15816999971866608, 0.5413448214530945, 0.8321393728256226, -0.7883877754211426, -0.020647753030061722, -0.6130058169364929, 0.33783018589019775, 0.08001288026571274, 0.5918266773223877}, 
-                            { 0.17112889885902405, 0.6130213141441345, 0.2753067910671234, 0.006752648390829563, 0.18762080371379852, 0.10355701297521591, -0.11331449449062347, 0.20572535693645477, -0.4727368950843811, 0.5247183442115784, -0.1399528980255127, 0.0004754884575959295, 0.09635354578495026, -0.09567287564277649, 0.13437438011169434, -0.1533748060464859, 0.5540616512298584, -0.15705454349517822, -0.19679249823093414, 0.8184275031089783, 0.13392741978168488, 0.14058230817317963, 0.4944375455379486, -0.5550168752670288, -0.7396768927574158, 1.6954541206359863, -0.932230532169342}, 
-                            { -0.023668676614761353, 0.675629734992981, -0.05441974848508835, -0.08879932761192322, 0.06921596080064774, -0.03723474591970444, -0.5281131267547607, 0.056799259036779404, -0.2135927975177765, -0.12000534683465958, 0.24137315154075623, 0.2535630464553833, 0.6757538914680481, 0.23991157114505768, 0.006120685487985611, 0.128733828663826, -0.3265807330608368, -0.15207244455814362, -0.9915776252746582, -0.048092491924762726, -0.16116130352020264, 0.011816311627626419, 0.976834774017334, 0.9241310358047485, 0.2659417688846588, -0.16820001602172852, -0.571212112903595}, 
-                            { -0.15575340390205383, 0.8410375118255615, 0.5819616913795471, 1.1550382375717163, -0.24565434455871582, 0.45346152782440186, -0.46146947145462036, 0.2695299983024597, -0.3470086455345154, -0.32895931601524353, -0.5937108397483826, -0.36337947845458984, -0.07259009778499603, -1.082977056503296, -0.03971315175294876, -0.23174071311950684, 1.4528745412826538, -0.10911118239164352, -0.06137029826641083, -0.2458679974079132, 1.062893271446228, 0.3962229788303375, -0.03130790963768959, 1.4496126174926758, -0.5609147548675537, -0.047182660549879074, 0.8052042126655579}, 
-                            { 0.04714835062623024, 0.40541428327560425, 0.5441996455192566, -0.4562903940677643, 0.469580739736557, -0.16537420451641083, 0.2539088726043701, -0.2202642261981964, -0.08087678998708725, -0.08381014317274094, -0.7338921427726746, 0.07680122554302216, -0.2654757499694824, 0.035828523337841034, -0.045658178627491, -0.3060373365879059, 1.8292217254638672, 0.31486812233924866, 0.02849375270307064, 0.20961076021194458, 0.042317356914281845, 1.1231101751327515, -0.5564850568771362, 0.6778684854507446, 0.6849967241287231, 0.7233251929283142, -0.5829063653945923}, 
-                            { 0.35141289234161377, 0.23598448932170868, -0.41445428133010864, -0.24126484990119934, 0.18743441998958588, 0.05150998756289482, 0.4099934995174408, -0.9526417255401611, 0.029875000938773155, 0.047494735568761826, 0.11841512471437454, 0.4339196979999542, -0.524913489818573, -0.12553243339061737, 0.19548968970775604, -0.9040718078613281, -1.000753402709961, 0.5055684447288513, -0.4720092713832855, 0.21881863474845886, -0.5808384418487549, -0.7905953526496887, -0.205072820186615, -0.10105918347835541, 0.4416336417198181, 0.149427130818367, -0.5902734398841858}, 
-                            { -0.1265595704317093, -0.6974983215332031, -0.589733362197876, -0.5631420016288757, -0.08098999410867691, 0.2909519672393799, 0.02365815080702305, 0.8123101592063904, 0.13241107761859894, -0.31863632798194885, 0.05568883940577507, -0.14763833582401276, -0.20235863327980042, -0.44001731276512146, -0.08792872726917267, 0.1786840707063675, -0.08953036367893219, -0.14256595075130463, -0.3567928969860077, -1.005600094795227, -0.5854975581169128, 0.8719106912612915, 0.6969981789588928, -1.66796875, 0.6714034676551819, 0.008103599771857262, 0.2715536653995514}}; 
-
-  Model5.lin_weight = {{0.1435343325138092, -0.09214991331100464, 0.15903472900390625, -0.7055106163024902, 2.0855002403259277, 0.31089720129966736, 0.5753178596496582, 0.7696769833564758, 0.886979341506958}}; 
-
-  Model5.lin_bias = {-0.2638515532016754}; 
-
-  Model5.rec_bias = {{2.1089799404144287, 1.9147611856460571, 1.5510637760162354, -0.7253775596618652, 1.7663995027542114, -0.9079530239105225, 0.5809383988380432, -0.8258703947067261, -0.5019692778587341, 0.36737382411956787, 0.34815865755081177, 0.5241528749465942, 0.14285992085933685, 0.35320430994033813, 0.7185850739479065, 0.14766588807106018, -0.11754479259252548, 0.4157218635082245, -0.11846643686294556, -0.08839821070432663, 0.00039527364424429834, -0.0651460811495781, 0.009713355451822281, -0.3718374967575073, -0.0006777336238883436, 0.1377447545528412, 0.37929025292396545}, 
-                    { 2.1089799404144287, 1.9147611856460571, 1.5510637760162354, -0.7253775596618652, 1.7663995027542114, -0.9079530239105225, 0.5809383988380432, -0.8258703947067261, -0.5019692778587341, 0.36721888184547424, 0.34815871715545654, 0.524152934551239, 0.14285992085933685, 0.3532487452030182, 0.7185850739479065, 0.14766588807106018, -0.11754470318555832, 0.41572752594947815, 0.35338062047958374, -0.19249482452869415, 0.03288188576698303, 0.49657508730888367, 0.14461812376976013, 0.18022337555885315, 0.3506242036819458, 0.1633845865726471, -0.0913025364279747}}; 
-  Model5.levelAdjust = 1.7;
-
-//========================================================================
-//../newNeuralSeedModel bassman_g25_gru9_p0072_shift29  keep
-/*
-model : SimpleRNN
-input_size : 1
-skip : 1
-output_size : 1
-unit_type : GRU
-num_layers : 1
-hidden_size : 9
-bias_fl : True
-*/
-
-  Model6.rec_weight_ih_l0 = {{-0.0552828311920166, -0.030351951718330383, -0.15669558942317963, -0.015707779675722122, 0.1726430356502533, 0.02735975757241249, 0.10895262658596039, -0.05913861468434334, 0.058854252099990845, -0.06770405173301697, -0.13166548311710358, -0.0541447214782238, -0.2306060492992401, 0.06153033301234245, -0.030178779736161232, 0.36140143871307373, -0.02121734619140625, 0.08116284012794495, 0.37203648686408997, 0.47551172971725464, -0.11820589005947113, -0.5386384725570679, -0.40045833587646484, 2.2536823749542236, 0.7497175335884094, -0.2842807173728943, -0.7832939624786377}}; 
-
-  Model6.rec_weight_hh_l0 = {{0.15995670855045319, -0.14914067089557648, -0.2789002060890198, -0.002169999061152339, 0.3963034451007843, 0.04536328464746475, 0.06132527440786362, -0.30639609694480896, -0.021007409319281578, -0.036907680332660675, 0.06018674373626709, -0.2205009162425995, 0.39237722754478455, 0.07671437412500381, -0.02492983639240265, -0.5298923850059509, -0.45884284377098083, -0.3652490973472595, 0.5445352792739868, 0.8665704727172852, -0.1771935224533081, -0.06727180629968643, 0.22730723023414612, -0.060933828353881836, 0.49356961250305176, -0.54501873254776, 0.2752610146999359}, 
-                            { -0.08952616900205612, -0.03914886713027954, 0.1616847962141037, 0.13940176367759705, 0.22367902100086212, 0.009372193366289139, 0.003930886276066303, -0.07484900206327438, -0.020995359867811203, -0.15763244032859802, -0.011754914186894894, 0.222540020942688, -0.4027211666107178, 0.08694323897361755, -0.25667136907577515, -0.29867294430732727, -0.5745465755462646, -0.15196749567985535, 0.06080205738544464, 0.594179630279541, 0.8187887072563171, 0.04399093613028526, 0.33194610476493835, 0.1430671066045761, -0.07333245873451233, -1.069273591041565, 1.1513386964797974}, 
-                            { -0.00018313375767320395, -0.05375399813055992, 0.04037374258041382, -0.059257857501506805, -0.07088220864534378, -0.034494295716285706, 0.019554760307073593, 0.13507592678070068, 0.12269067764282227, 0.03980719670653343, 0.041075028479099274, -0.019312413409352303, -0.190115824341774, 0.30218103528022766, -0.022742291912436485, 0.6968958377838135, 0.9035422801971436, 0.3567427098751068, -0.13775227963924408, -0.5396113395690918, 0.8584436774253845, -1.1192741394042969, 0.28346291184425354, -1.4756187200546265, -0.22917082905769348, 0.7323234677314758, -0.47046229243278503}, 
-                            { -0.2616998851299286, -0.06324409693479538, -0.022242508828639984, -0.12825201451778412, 0.022545108571648598, -0.08264908939599991, -0.013395559042692184, 0.1430538296699524, 0.041660621762275696, -0.4740407466888428, 0.14680759608745575, -0.337575227022171, 0.16390672326087952, 0.26086148619651794, -0.12935954332351685, 0.4676373600959778, 0.9574460983276367, 0.33745962381362915, -0.9613723158836365, 0.27394357323646545, -0.020663153380155563, 0.9768266081809998, -0.22922095656394958, -0.0470949187874794, -0.32898861169815063, 0.9502826929092407, -0.1762983798980713}, 
-                            { -0.13162046670913696, 0.543434202671051, -0.1689695417881012, -0.19010430574417114, 0.26236337423324585, -0.054490044713020325, 0.0186367928981781, -0.2210935652256012, 0.05643231421709061, -0.07073281705379486, 0.09232844412326813, 0.16085593402385712, 1.0859546661376953, -0.07566172629594803, 0.22670158743858337, 0.1670699119567871, 0.19761493802070618, -0.006477236747741699, 0.04430670291185379, 0.032578833401203156, 0.3071563243865967, 0.4319645166397095, 1.4101715087890625, 0.5148190855979919, 0.28692811727523804, -0.18651056289672852, -0.3288233280181885}, 
-                            { -0.1188168153166771, 0.07647890597581863, -0.1500750631093979, 0.11532825976610184, -0.08173280954360962, 0.11618198454380035, 0.07612345367670059, -0.012127196416258812, 0.15218470990657806, -0.13484826683998108, -0.16330991685390472, -0.19506894052028656, -0.09772591292858124, 0.18209309875965118, -0.04956690967082977, 0.37695959210395813, 0.3947259485721588, 0.08312486112117767, -0.06945481151342392, 0.2764538824558258, 0.9861345291137695, 2.241938352584839, -0.3337174654006958, 0.29682543873786926, -0.8206092119216919, 0.37482330203056335, 0.6865255236625671}, 
-                            { -0.05214996263384819, -0.006532440893352032, -0.06864612549543381, -0.17452780902385712, 0.06455828994512558, -0.04602034017443657, 0.040857743471860886, -0.06944781541824341, 0.01985010877251625, -0.04277738183736801, -0.003929737955331802, -0.5229294896125793, 0.14630544185638428, -0.1452445387840271, 0.01590707339346409, 0.06615550071001053, -0.621452808380127, -0.2950851321220398, -0.1286786049604416, -0.022745059803128242, 0.15557511150836945, -0.009798585437238216, -0.047067806124687195, 0.14802446961402893, 1.2390681505203247, -0.1838175505399704, 0.1953406184911728}, 
-                            { 0.05667920038104057, -0.0283050574362278, 0.03178250789642334, -0.09574665129184723, -0.17807775735855103, -0.22665703296661377, -0.35343578457832336, 0.4144156575202942, -0.09480272978544235, 0.45682981610298157, 0.01373417116701603, 0.4367183744907379, 0.1680774986743927, -0.04792090132832527, -0.008556200191378593, -0.22920013964176178, -0.40071094036102295, -0.3322775661945343, -0.26314595341682434, 0.16624504327774048, -0.2236584722995758, -0.23046697676181793, 0.012646827846765518, -0.30076971650123596, 0.8004752993583679, 0.4815657138824463, -0.0629228949546814}, 
-                            { -0.1768117994070053, 0.31786710023880005, -0.023084886372089386, 0.07907523214817047, 0.04217776283621788, 0.06982579082250595, 0.06828603148460388, -0.19491459429264069, -0.08487904816865921, -0.235983207821846, -0.13642166554927826, 0.4358243942260742, -0.11376588046550751, 0.053209174424409866, -0.05504632368683815, -0.3834777772426605, -1.2233458757400513, -0.30505573749542236, 0.3453841507434845, 0.3678337335586548, -0.45556241273880005, 0.45243704319000244, -0.05878376588225365, -1.026667833328247, 0.7402567863464355, -0.7902718186378479, 0.5626970529556274}}; 
-
-  Model6.lin_weight = {{-0.35878172516822815, -0.35143688321113586, 0.0438566580414772, 0.09557642787694931, 0.35244128108024597, -0.5041103959083557, 0.6719605922698975, 1.4568132162094116, 0.5651177763938904}}; 
-
-  Model6.lin_bias = {-0.39557117223739624}; 
-
-  Model6.rec_bias = {{1.4791090488433838, 0.8872252106666565, 1.255505084991455, -0.6273059844970703, 2.0530476570129395, -0.8202617764472961, -0.6621493101119995, -0.2523471713066101, -0.0486859567463398, 0.15896804630756378, 0.14054542779922485, 0.10158023238182068, 0.6378490924835205, 0.16620376706123352, 0.3358059227466583, 0.22175993025302887, 0.23002469539642334, 0.4394044876098633, -0.23089683055877686, 0.027949901297688484, 0.007241227198392153, 0.015315423719584942, -0.04764167219400406, -0.10548243671655655, -0.11819690465927124, 0.08399385958909988, 0.3320634663105011}, 
-                    { 1.4791090488433838, 0.8872252106666565, 1.255505084991455, -0.6273059844970703, 2.0530476570129395, -0.8202617764472961, -0.6621493101119995, -0.2523471713066101, -0.0486859567463398, 0.15723247826099396, 0.1405564695596695, 0.10158234089612961, 0.6378490924835205, 0.16658557951450348, 0.3358058035373688, 0.22175993025302887, 0.23002585768699646, 0.4395991861820221, 0.5436006784439087, -0.1353028416633606, 0.10029082000255585, 0.18212758004665375, 0.10946966707706451, 0.13357312977313995, 0.030321570113301277, -0.07347753643989563, -0.41494783759117126}}; 
-  Model6.levelAdjust = 0.8;
-
-  //========================================================================
-//../newNeuralSeedModel 5150_g5_gru9_p005_shift26
-/*
-model : SimpleRNN
-input_size : 1
-skip : 1
-output_size : 1
-unit_type : GRU
-num_layers : 1
-hidden_size : 9
-bias_fl : True
-*/
-
-  Model7.rec_weight_ih_l0 = {{-0.10029491037130356, 0.39539408683776855, -0.003912642132490873, 0.15781715512275696, 0.30069857835769653, -0.13050690293312073, 0.15909086167812347, 0.19767779111862183, -0.14876919984817505, 0.010837454348802567, 0.08312078565359116, 0.010858718305826187, -0.12213930487632751, 0.13805551826953888, 0.002928786678239703, 0.12726815044879913, -0.047198496758937836, 0.1211603507399559, 2.087261199951172, 2.8326735496520996, -0.9548537135124207, -0.15895815193653107, 0.10418925434350967, 0.3447468876838684, -0.34842681884765625, 0.4084584712982178, -0.3318082392215729}}; 
-
-  Model7.rec_weight_hh_l0 = {{0.279853880405426, 0.4110238254070282, -0.02184336632490158, -0.026962880045175552, -0.07450610399246216, -0.101193867623806, 0.5569225549697876, 0.051143400371074677, 0.021359063684940338, 0.14612971246242523, 0.11226102709770203, -0.15400274097919464, -0.33306899666786194, 0.014791703782975674, 0.21884165704250336, 0.168436661362648, -0.3421862721443176, 0.21781663596630096, 0.5456551313400269, 2.0199341773986816, 0.25395116209983826, 0.662376880645752, -0.1667630672454834, 0.6593583226203918, -0.029065201058983803, 1.4691778421401978, -0.8024289608001709}, 
-                            { 0.6153132319450378, -0.7782852053642273, -0.08894426375627518, 0.041232433170080185, -0.09748302400112152, 0.01737213507294655, -0.1788269430398941, -0.4382805824279785, 0.03455343097448349, -0.18443253636360168, 0.11979273706674576, 0.3620227873325348, -0.3429383337497711, 0.32085514068603516, -0.21725447475910187, 0.2532190978527069, 0.21321140229701996, -0.15920071303844452, -0.34196215867996216, 1.3450170755386353, -0.41629987955093384, -0.05839737132191658, 0.14980284869670868, 0.2088697850704193, 0.09886208921670914, 3.2822296619415283, 0.04207422956824303}, 
-                            { 0.19099770486354828, 0.4569742977619171, 0.10507544875144958, -0.08591914921998978, -0.4043618142604828, -0.22017423808574677, -0.14538314938545227, 0.282324880361557, -0.1931607723236084, 0.09280673414468765, -0.35044506192207336, -0.008585312403738499, -0.26311779022216797, -0.34506574273109436, 0.12011848390102386, 0.0844358578324318, -0.8067481517791748, 0.1039697676897049, -0.24600349366664886, -0.4671876132488251, 0.30354297161102295, -0.3676024377346039, -0.10936274379491806, -0.30869895219802856, 0.37636929750442505, -0.19903483986854553, 0.2858554720878601}, 
-                            { -0.1372983306646347, -0.11246408522129059, 0.024203550070524216, 0.03544182330369949, 0.015402376651763916, -0.11344555765390396, 0.23464994132518768, 0.012833056971430779, 0.006977436598390341, -0.07682888954877853, 0.009238757193088531, -0.10515128076076508, 0.3502405881881714, 0.26007577776908875, -0.025113027542829514, -0.07813632488250732, 1.2120518684387207, -0.06614027917385101, -0.16352851688861847, 0.034074317663908005, -0.3733396828174591, 1.2140898704528809, 0.0671117752790451, -0.1901351660490036, 0.12513042986392975, -0.1401376724243164, -0.22061866521835327}, 
-                            { -0.09837669879198074, -0.07296714931726456, 0.07415425777435303, 0.12249387055635452, 0.19059647619724274, -0.2786470949649811, -0.17998622357845306, -0.0587153322994709, 0.15234634280204773, -0.32049474120140076, 0.1664508730173111, -0.14225755631923676, 0.15546996891498566, 0.2856215834617615, 0.38924160599708557, -0.5475407838821411, 0.6039764881134033, 0.669295608997345, -0.07302369922399521, -0.21606475114822388, -0.38145944476127625, 0.6767429113388062, 1.1490588188171387, 0.23141732811927795, -0.3881435692310333, -0.3343243896961212, 0.029835257679224014}, 
-                            { 0.10364783555269241, 0.20524707436561584, -0.12378998845815659, 0.09323004633188248, 0.5847142934799194, -0.11467412859201431, -0.19085516035556793, 0.20209373533725739, -0.08638408780097961, 0.01776629127562046, -0.15625716745853424, 0.075813427567482, 0.18972429633140564, 0.25511687994003296, 0.29399004578590393, -0.29910117387771606, -0.10164934396743774, -0.042859964072704315, -0.8418867588043213, -0.8348802328109741, 0.5251724720001221, 0.5052580833435059, 0.12604670226573944, 1.0433142185211182, 0.384372740983963, -0.30932149291038513, -0.19716787338256836}, 
-                            { 0.33046185970306396, 0.4767293632030487, -0.1625777781009674, 0.19637633860111237, 0.2989841103553772, 0.07176392525434494, 0.11505020409822464, 0.4257659614086151, 0.08635949343442917, 0.3250618577003479, -0.1283242553472519, 0.11305569112300873, -0.2142220139503479, 0.2456805258989334, 0.24307163059711456, 0.1461387276649475, -0.5634647011756897, -0.05678092688322067, 0.5646246075630188, -0.0471145324409008, -0.039803069084882736, 0.0685255229473114, -0.28412994742393494, -0.031454917043447495, 1.2988535165786743, -0.3542329967021942, -0.2897058129310608}, 
-                            { 0.2751341462135315, -0.28562626242637634, -0.01655545085668564, -0.14892946183681488, -0.055001065135002136, -0.006849923171103001, 0.006312100682407618, 0.1873953640460968, -0.10183747857809067, 0.07786726206541061, -0.11563515663146973, -0.02083977311849594, 0.025995932519435883, -0.07936025410890579, 0.18506909906864166, -0.10047942399978638, -0.17354829609394073, -0.2230573147535324, 0.1424405872821808, -0.22878959774971008, 0.23047930002212524, 0.42666730284690857, 0.027816172689199448, -0.3525228202342987, 0.016032511368393898, 0.3477236330509186, -0.38176479935646057}, 
-                            { -0.33333343267440796, -0.6075897812843323, 0.01697651669383049, -0.378978431224823, -0.19345541298389435, 0.149247407913208, 0.2778279781341553, -0.5271709561347961, 0.3874778747558594, 0.12028679251670837, 0.35273537039756775, 0.3670301139354706, 0.4426630139350891, -0.04335176572203636, -0.07593750208616257, -0.15744592249393463, 0.33702242374420166, -0.20504538714885712, 0.9893298745155334, 0.5818567276000977, -0.36911237239837646, 1.0018742084503174, -0.3915467858314514, -0.483379065990448, 0.025392325595021248, -0.32757896184921265, 0.3506688177585602}}; 
-
-  Model7.lin_weight = {{-0.21571148931980133, 0.009336142800748348, 1.1046335697174072, 0.7788750529289246, -0.7268757224082947, 0.008250449784100056, -0.15866594016551971, 0.5746699571609497, 0.7435592412948608}}; 
-
-  Model7.lin_bias = {0.1311880350112915}; 
-
-  Model7.rec_bias = {{-0.6570056676864624, -0.7625259757041931, -0.4935401380062103, 0.3882617950439453, 1.6678688526153564, 1.1328665018081665, 0.7226774096488953, -0.6539076566696167, 1.1644433736801147, 0.4385550320148468, 0.7962636947631836, 0.10724996030330658, 0.36334332823753357, 0.2530021369457245, 0.17276468873023987, 0.22074736654758453, 0.5745679140090942, 0.11506269872188568, -0.12087058275938034, -0.22438204288482666, -0.12205783277750015, -0.3330017924308777, 0.12413868308067322, -0.07059116661548615, 0.06413894891738892, -0.21534445881843567, 0.1563182920217514}, 
-                    { -0.6570056676864624, -0.7625259757041931, -0.4935401380062103, 0.3882596790790558, 1.672628402709961, 1.1337413787841797, 0.7226774096488953, -0.6539076566696167, 1.1628081798553467, 0.4378686547279358, 0.7965229153633118, 0.09567991644144058, 0.36506515741348267, 0.2470959722995758, 0.13386721909046173, 0.22055870294570923, 0.574568510055542, 0.05572935566306114, -0.1475081890821457, 0.05165950208902359, -0.1899762749671936, 0.09854485094547272, -0.2138112634420395, 0.10794822871685028, -0.09042128175497055, 0.1349363476037979, 0.09115724265575409}}; 
-  Model7.levelAdjust = 0.6;
-//========================================================================
-//../newNeuralSeedModel klon gain 80% tone 100% out 50% Ge p0042
-/*
-model : SimpleRNN
-input_size : 1
-skip : 1
-output_size : 1
-unit_type : GRU
-num_layers : 1
-hidden_size : 9
-bias_fl : True
-*/
-/*
-  Model7.rec_weight_ih_l0 = {{-0.18043585121631622, -0.005189934745430946, -0.002160801086574793, -0.006357795558869839, 0.3391801118850708, -0.12098570913076401, -0.12226471304893494, -0.012685575522482395, 0.07492392510175705, -0.20374572277069092, 0.042514193803071976, 0.11463820934295654, 0.40782469511032104, -0.07003690302371979, 0.19397641718387604, 0.21598996222019196, 0.0005840400117449462, 0.20110803842544556, 0.7026249766349792, 0.9762355089187622, 0.2138972282409668, -0.5434147715568542, -0.48171862959861755, 1.6679104566574097, -0.07779663056135178, 0.19563819468021393, -1.3216689825057983}}; 
-
-  Model7.rec_weight_hh_l0 = {{0.2311597317457199, -0.17885564267635345, 0.10682596266269684, -0.10970864444971085, -0.12408424913883209, -0.009406747296452522, 0.05407236889004707, -0.21162445843219757, -0.07556428015232086, -0.08075032383203506, -0.35276147723197937, 0.05934688821434975, -0.5210113525390625, 0.005945448763668537, 0.25298866629600525, 0.27263766527175903, 0.4124540686607361, 0.4367275834083557, 0.5065749883651733, -0.18931278586387634, -0.4964720606803894, 0.2593480944633484, 0.30517110228538513, -0.6568215489387512, 0.2164522111415863, 0.06002960726618767, -0.05505460500717163}, 
-                            { 0.2009611278772354, 0.1612265557050705, 0.21440762281417847, -0.10203954577445984, 0.5682570934295654, -0.14643603563308716, -0.033524271100759506, 0.12665843963623047, -0.01896229013800621, 0.04551883414387703, 0.19205521047115326, 0.21673887968063354, 0.4215225279331207, -0.0481296107172966, 0.16461637616157532, 0.07600083947181702, -0.01047545950859785, 0.1649155467748642, -0.38546276092529297, 0.01485608983784914, -0.314727246761322, 0.08884149044752121, -0.44662779569625854, -1.2127010822296143, -0.41818535327911377, 0.16998668015003204, 1.8449808359146118}, 
-                            { -0.1677922159433365, -0.01967926323413849, -0.09959826618432999, -0.06788790971040726, 0.19643659889698029, -0.19559346139431, -0.19153085350990295, 0.14430876076221466, -0.018631698563694954, -0.7311710715293884, 0.03206133469939232, -0.2754767835140228, 0.19717496633529663, 0.007319906260818243, -0.06037876754999161, -0.02364257723093033, -0.5908451676368713, -0.02879975363612175, -0.5862044095993042, -0.7914515137672424, 0.7944039106369019, -0.5024320483207703, -0.23686428368091583, -1.040961742401123, 0.28646159172058105, -0.3814395070075989, 0.8072326183319092}, 
-                            { -0.00040533492574468255, 0.020906945690512657, 0.1164717897772789, -0.011546606197953224, 0.23979003727436066, -0.222573384642601, -0.08093560487031937, -0.12071042507886887, 0.07520577311515808, 0.048872482031583786, 0.04764065518975258, 0.3108421266078949, 0.643166184425354, 0.06041087582707405, 0.07190041244029999, 0.21546784043312073, 0.5067742466926575, 0.06765620410442352, -0.20685094594955444, -0.1565602421760559, 0.3649269938468933, 1.5548990964889526, -0.35153669118881226, -0.3156576454639435, -0.14056912064552307, 0.8753264546394348, -0.2237645983695984}, 
-                            { 0.32113057374954224, 0.5112467408180237, 0.5536764860153198, -0.6330170631408691, 1.9460808038711548, -0.6049872636795044, -0.1747814118862152, -0.046527199447155, -0.5162708759307861, -0.24195845425128937, -0.3178587257862091, 0.37873029708862305, 0.16782157123088837, 0.6203312873840332, 0.7381593585014343, -0.051133159548044205, 0.1837819665670395, 0.3517162799835205, 0.12884728610515594, 0.48082828521728516, -0.06294602155685425, 0.27713578939437866, 1.4332419633865356, 1.2991527318954468, -0.6617611050605774, 0.4485947787761688, -0.041519422084093094}, 
-                            { -0.06304455548524857, 0.04967137426137924, -0.1882299780845642, -0.021279238164424896, 0.36238178610801697, -0.14673462510108948, -0.08333669602870941, 0.13999946415424347, -0.0919635146856308, -0.22390958666801453, 0.009745440445840359, 0.34752169251441956, 1.4770954847335815, -0.006536287255585194, -0.0886169895529747, -1.2505643367767334, -0.18313376605510712, -0.06668906658887863, -0.88137286901474, 0.29897502064704895, 0.9604712724685669, 2.2861053943634033, -0.03760473430156708, 1.2928084135055542, 0.3011414706707001, -0.4922350347042084, 0.3412003219127655}, 
-                            { -0.24023254215717316, -0.16064856946468353, -0.2658691704273224, 0.32243651151657104, -0.693996012210846, 0.1851450800895691, -0.06480073928833008, -0.006548306904733181, 0.23934419453144073, 0.2884000539779663, -0.1794411838054657, -0.7244924306869507, 0.3910689353942871, -0.12126459926366806, -0.04814409464597702, -0.10687661170959473, -0.3209397792816162, -0.12533468008041382, 0.6377098560333252, -0.16189642250537872, 0.44851258397102356, -0.14274583756923676, 0.23059408366680145, 0.19323638081550598, 1.335464596748352, -0.6007033586502075, 0.09901580959558487}, 
-                            { -0.04734373092651367, 0.001593829714693129, 0.18053431808948517, -0.2895701229572296, 0.20389589667320251, -0.08133326470851898, 0.051314037293195724, 0.12422414869070053, -0.20304325222969055, -0.13149327039718628, -0.05295436456799507, 0.5576544404029846, 0.09162339568138123, 0.10542793571949005, 0.12533850967884064, 0.15600520372390747, 0.1724330335855484, -0.1018604263663292, -0.06348198652267456, 0.15767012536525726, -0.11357893794775009, -0.0004982720129191875, -0.39103174209594727, 0.18428927659988403, 0.19723999500274658, 0.2536754608154297, 0.15175160765647888}, 
-                            { 0.05511222779750824, 0.09521769732236862, 0.04106590896844864, -0.05662987753748894, 0.588483989238739, -0.13185273110866547, -0.023513590916991234, -0.02692342922091484, 0.03819248080253601, 0.028292261064052582, -0.11320330947637558, 0.022171972319483757, 0.37900951504707336, 0.04089069738984108, 0.11234364658594131, -0.4019130766391754, -0.29887765645980835, 0.38755717873573303, -0.6028042435646057, -0.4017237722873688, -0.35074377059936523, -0.5048794150352478, -0.12440623342990875, -1.366324543952942, -0.11867781728506088, -0.17781420052051544, 0.044197846204042435}}; 
-
-  Model7.lin_weight = {{-1.3437188863754272, -0.14130647480487823, -0.20946507155895233, 0.09097113460302353, 0.9024709463119507, -0.24769724905490875, 0.6127280592918396, 0.8327569365501404, 0.5802141427993774}}; 
-
-  Model7.lin_bias = {-0.5175260901451111}; 
-
-  Model7.rec_bias = {{0.9454379081726074, 1.0111050605773926, 1.7379424571990967, -0.812536895275116, 1.9219712018966675, -0.7111067771911621, -0.17454193532466888, 0.0925256758928299, -0.6529195308685303, 0.24089780449867249, -0.08137478679418564, 0.0011466082651168108, 0.7246109247207642, 0.34632575511932373, 0.6989007592201233, 0.32421979308128357, 0.09360983967781067, 0.3550436496734619, -0.03625684231519699, 0.06105056777596474, 0.17840023338794708, -0.22359372675418854, 0.13778617978096008, -0.37832605838775635, 0.11530635505914688, -0.007704046554863453, 0.20048649609088898}, 
-                    { 0.9454379081726074, 1.0111050605773926, 1.7379424571990967, -0.812536895275116, 1.9219712018966675, -0.7111067771911621, -0.17454193532466888, 0.0925256758928299, -0.6529195308685303, 0.23995091021060944, -0.08137262612581253, 0.0011471601901575923, 0.7246109247207642, 0.34645894169807434, 0.6989007592201233, 0.32421979308128357, 0.09360996633768082, 0.35506999492645264, 0.5445544719696045, -0.2650964856147766, 0.11731084436178207, -0.037565138190984726, 0.23611372709274292, -0.17997492849826813, 0.18465599417686462, -0.14797592163085938, -0.3827133774757385}}; 
-
-  Model7.levelAdjust = 0.7;
-
-*/
-
-//========================================================================
-//../newNeuralSeedModel splawn lesseq p016
-/*
-model : SimpleRNN
-input_size : 1
-skip : 1
-output_size : 1
-unit_type : GRU
-num_layers : 1
-hidden_size : 9
-bias_fl : True
-*/
-
-  Model8.rec_weight_ih_l0 = {{-0.1962304264307022, -0.1355326771736145, -0.2770193815231323, -0.026640359312295914, -0.32773613929748535, -0.032444391399621964, -0.19838671386241913, -0.03420368954539299, 0.07451529055833817, -0.15546947717666626, -0.0015930901281535625, -0.14246152341365814, -0.31645432114601135, 0.09271357953548431, 0.28320756554603577, -0.16182054579257965, 0.038472067564725876, -0.14872537553310394, 0.4264770746231079, -0.9290569424629211, 0.33339518308639526, 0.36250436305999756, 2.993844985961914, 3.2608554363250732, -1.0870774984359741, -0.008460208773612976, 0.16107945144176483}}; 
-
-  Model8.rec_weight_hh_l0 = {{-0.027524592354893684, 0.22197243571281433, -1.139214038848877, -0.4078858196735382, -0.47172272205352783, -0.11344176530838013, 0.7284901142120361, 0.20500048995018005, -0.04185975342988968, 0.31803059577941895, 0.37160950899124146, 0.05201788246631622, 0.01207520067691803, 0.29934701323509216, 0.26072925329208374, -0.04065680876374245, 0.10075835883617401, 0.03044736757874489, 0.7957772016525269, -0.16138383746147156, 1.057283878326416, -0.5710352063179016, -1.6380332708358765, -1.2685195207595825, 0.7969703078269958, 0.013082528486847878, 0.05098795145750046}, 
-                            { 0.9031445384025574, -0.6511954069137573, 0.13682380318641663, -0.5169990062713623, -1.4459470510482788, 0.49328991770744324, 0.9079595804214478, 0.011867444962263107, 0.0033708014525473118, 0.16404539346694946, 1.489447832107544, -0.376074880361557, 0.7988923788070679, -1.1219359636306763, -0.0711074098944664, 0.7222583889961243, -0.010381923988461494, 0.15066640079021454, -0.14460253715515137, -1.0689893960952759, -0.2610788345336914, -0.4348083734512329, -2.319446086883545, 0.4771786332130432, 0.7259414196014404, -0.06709892302751541, 0.042649801820516586}, 
-                            { 0.3229622542858124, -0.07200372219085693, 0.14209279417991638, -0.17696869373321533, -0.13050910830497742, -0.12933368980884552, 0.2067319005727768, 0.3414038419723511, 0.12222814559936523, 0.10561681538820267, -0.07987423241138458, 0.6149351000785828, -0.23609435558319092, 0.14508233964443207, 0.04395386576652527, -0.27764689922332764, 0.4104359745979309, 0.11053051054477692, -0.0364856980741024, 0.15137460827827454, 1.217787742614746, -0.7010959386825562, 0.08042117208242416, -3.828636181424372e-05, -0.026667427271604538, 0.21672670543193817, -0.3421209156513214}, 
-                            { 0.26511773467063904, -0.5924402475357056, 0.3209276497364044, -0.19019196927547455, -0.5278565883636475, -0.5044956803321838, 0.18484970927238464, 0.2133544534444809, 0.2489071488380432, 0.32209277153015137, -0.13611194491386414, -0.3602774441242218, -0.051932621747255325, 0.39190927147865295, 0.0822751447558403, -0.42682692408561707, 0.058555517345666885, 0.4296930730342865, 0.21663546562194824, 0.3250330686569214, 0.09410503506660461, 0.11239167302846909, 0.002089698100462556, 0.06054902449250221, 0.11345445364713669, 0.3847461938858032, -0.38146063685417175}, 
-                            { 0.12650994956493378, 0.08593269437551498, -0.21439945697784424, 0.13020479679107666, -1.7263695001602173, -1.7269773483276367, 0.019987022504210472, 0.11445435881614685, -0.07362867146730423, 0.3690851926803589, -2.465437173843384, -1.2924649715423584, 0.26227304339408875, -0.6523703932762146, 0.3553270697593689, -0.22717048227787018, 0.08542075008153915, -0.27077484130859375, 0.8103504180908203, 1.9631215333938599, -2.5850296020507812, 1.547258973121643, 2.975011110305786, -0.4287436604499817, -0.39541375637054443, -0.032461997121572495, -0.022953007370233536}, 
-                            { 0.26470470428466797, -0.22158563137054443, 0.0028730689082294703, -0.34109601378440857, -0.7592737674713135, -0.5777950882911682, 0.3360382914543152, -0.09993843734264374, -0.05681144818663597, -0.2873036861419678, -0.4406214952468872, 0.17392390966415405, 0.4898023307323456, -0.3069523274898529, 0.3198238015174866, 0.6525458693504333, 0.06391310691833496, 0.02406768687069416, 0.6604233980178833, -0.3841896951198578, 0.8002927303314209, -0.2679363787174225, 3.402167320251465, -0.44198116660118103, -1.1851885318756104, 0.14807407557964325, -0.07971101254224777}, 
-                            { 0.01752319000661373, 0.18374748528003693, -0.7158287763595581, -0.02686416544020176, -0.6746514439582825, -0.33210137486457825, 0.42791885137557983, -0.009503907524049282, -0.0272202268242836, 0.31841230392456055, -0.48059898614883423, 0.2830291986465454, -0.5168306231498718, -0.054303884506225586, -0.09494924545288086, 0.12672720849514008, -0.011610278859734535, 0.040327899158000946, 0.6102017164230347, -0.7066671252250671, 0.021327031776309013, 0.41988107562065125, 1.9918591976165771, 3.4591245651245117, 0.6946906447410583, -0.02234477363526821, 0.17047686874866486}, 
-                            { -0.13662776350975037, -0.01768340729176998, -0.20407211780548096, 0.1330774575471878, -0.028080351650714874, 0.00451979273930192, 0.21728071570396423, -0.027602363377809525, 0.04410528391599655, -0.3046717643737793, 0.017058949917554855, -0.04613382741808891, 0.19609542191028595, -0.2186194360256195, -0.6114206314086914, -0.42649370431900024, 0.24700169265270233, -0.0056807068176567554, 0.22170479595661163, 0.06457627564668655, -0.26201027631759644, -0.050230804830789566, -0.21863198280334473, -0.29225125908851624, 0.12402655184268951, 1.1420036554336548, -0.9628114700317383}, 
-                            { 0.03353501111268997, -0.04973694682121277, 0.1617184579372406, 0.2387598603963852, -0.07009554654359818, 0.052098993211984634, -0.21875831484794617, 0.12748116254806519, 0.11153358221054077, 0.13384290039539337, 0.15491782128810883, -1.9108493328094482, -0.6965234875679016, 0.1296902447938919, -0.0025165663100779057, 0.2260102927684784, 0.21223454177379608, 0.14853651821613312, -0.5169532895088196, -0.22295399010181427, 0.34596478939056396, 0.20344090461730957, -0.014062924310564995, -0.1367579847574234, -0.10022738575935364, 0.662987232208252, 1.4477633237838745}}; 
-
-  Model8.lin_weight = {{-0.18492355942726135, 0.1578197330236435, -0.9123080372810364, -1.2465184926986694, 0.05437188595533371, -0.3180641233921051, 0.8285513520240784, -0.3889249265193939, -0.9665180444717407}}; 
-
-  Model8.lin_bias = {0.7220124006271362}; 
-
-  Model8.rec_bias = {{2.0609941482543945, -0.6399329304695129, -0.08864486217498779, 0.20826853811740875, -0.9970732927322388, -0.7389999032020569, 1.6598868370056152, 1.9578510522842407, 1.6268224716186523, 0.17324931919574738, 0.8972873091697693, 0.9106922149658203, 0.2138533890247345, 1.1183505058288574, 0.8165175318717957, -0.19522859156131744, 0.21931886672973633, 0.5094407796859741, 0.20262053608894348, -1.2791446447372437, 0.37031975388526917, 0.5160494446754456, -0.14140361547470093, 0.08626745641231537, -0.047812435775995255, -0.11191973835229874, 0.12530671060085297}, 
-                    { 2.061035633087158, -0.6399329304695129, -0.08864486217498779, 0.20826853811740875, -0.9970732927322388, -0.7389999032020569, 1.659889817237854, 1.9578510522842407, 1.6267966032028198, 0.17323251068592072, 0.8974360227584839, 0.9106932878494263, 0.21385356783866882, 1.1183505058288574, 0.8165175318717957, -0.19522970914840698, 0.2193187177181244, 0.5094400644302368, -0.17801499366760254, 1.1853747367858887, -0.49953359365463257, -0.07018504291772842, 0.5975275635719299, 0.43096187710762024, -0.22361980378627777, -0.03789837658405304, -0.008905002847313881}}; 
-
-  Model8.levelAdjust = 0.5;
-
-
-  /*========================================================================*/
-
-  // ADD YOUR MODEL IDENTIFIER HERE ////////////////////////////////// < -------------------------
-  model_collection = {  Model1, Model2, Model3, Model4, Model5, Model6, Model7, Model8
-                     };
-}
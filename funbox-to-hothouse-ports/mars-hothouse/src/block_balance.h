@@ -0,0 +1,79 @@
+#pragma once
+#ifndef BLOCK_BALANCE_H
+#define BLOCK_BALANCE_H
+#include <math.h>
+#include <stddef.h>
+#include "control_param.h"
+
+/** DaisySP Balance's level matching, worked out once per block: the mean
+    squares of the signal and of the reference over the block go through
+    the same 10 Hz one-pole RMS followers, stepped a block at a time, and
+    the gain sqrt(reference / signal) they give is ramped across the block.
+    Two multiply-adds a sample and one divide and square root a block,
+    against Balance's two followers, divide and square root a sample.
+    It isn't sample-exact with Balance: tools/host/unit/block_balance_test
+    measures how far apart the two are.
+
+    Usage, once per callback:
+        bal.Analyse(sig, comp, size);
+        for each sample: out = sig * bal.Next();
+*/
+class BlockBalance
+{
+  public:
+    BlockBalance() {}
+    ~BlockBalance() {}
+
+    void Init(float sampleRate, float cutoffHz = 10.0f)
+    {
+        // Balance's follower coefficient, per sample
+        const float b = 2.0f - cosf(cutoffHz * (6.28318531f / sampleRate));
+        c2_    = b - sqrtf(b * b - 1.0f);
+        size_  = 0;
+        sig_   = 0.0f;
+        comp_  = 0.0f;
+        gain_.Init(1.0f);
+    }
+
+    /** Sets the gain ramp for the block of size samples at sig, to match
+        its level to comp's
+    */
+    void Analyse(const float* sig, const float* comp, size_t size)
+    {
+        if(size == 0)
+            return;
+        if(size != size_)
+        {
+            size_      = size;
+            blockPole_ = powf(c2_, (float)size);
+        }
+
+        float sigSq  = 0.0f;
+        float compSq = 0.0f;
+        for(size_t i = 0; i < size; i++)
+        {
+            sigSq += sig[i] * sig[i];
+            compSq += comp[i] * comp[i];
+        }
+        const float scale = (1.0f - blockPole_) / (float)size;
+        sig_              = blockPole_ * sig_ + scale * sigSq;
+        comp_             = blockPole_ * comp_ + scale * compSq;
+
+        // Nothing to match to yet: hold the last gain
+        if(sig_ > 1e-20f)
+            gain_.SetTarget(sqrtf(comp_ / sig_), size);
+    }
+
+    /** The gain for the next sample of the block */
+    inline float Next() { return gain_.Next(); }
+
+  private:
+    float        c2_        = 0.0f;
+    float        blockPole_ = 0.0f;
+    size_t       size_      = 0;
+    float        sig_       = 0.0f;
+    float        comp_      = 0.0f;
+    ControlParam gain_;
+};
+
+#endif
@@ -0,0 +1,90 @@
+#pragma once
+#ifndef CONTROL_PARAM_H
+#define CONTROL_PARAM_H
+#include <stddef.h>
+
+/** Control-rate parameter: takes one target per audio block and ramps to it
+    linearly across the block, so knob moves don't zipper and nothing derived
+    from the parameter has to be recomputed per sample when it isn't moving.
+
+    Usage, once per callback:
+        bool moving = param.SetTarget(knobValue, size);
+        for each sample: float v = param.Next();
+    and recompute filter coefficients etc. only while moving is true.
+*/
+class ControlParam
+{
+  public:
+    ControlParam() {}
+    ~ControlParam() {}
+
+    /** Jumps to value with no ramp. threshold is the smallest target change
+        that starts a new ramp, to keep ADC noise from counting as a move.
+    */
+    void Init(float value, float threshold = 0.0f)
+    {
+        current_   = value;
+        target_    = value;
+        step_      = 0.0f;
+        remaining_ = 0;
+        threshold_ = threshold;
+    }
+
+    /** Sets this block's target and ramps to it over rampSamples.
+        Returns true if the value will change during the block (a new ramp,
+        or one still in progress).
+    */
+    inline bool SetTarget(float target, size_t rampSamples)
+    {
+        float delta = target - target_;
+        if(delta < 0.0f)
+            delta = -delta;
+        if(delta > threshold_ && rampSamples > 0)
+        {
+            target_    = target;
+            step_      = (target_ - current_) / rampSamples;
+            remaining_ = rampSamples;
+        }
+        return remaining_ > 0;
+    }
+
+    /** Advances the ramp by one sample and returns the new value. */
+    inline float Next()
+    {
+        if(remaining_ > 0)
+        {
+            current_ += step_;
+            if(--remaining_ == 0)
+                current_ = target_; // land exactly on the target
+        }
+        return current_;
+    }
+
+    /** Advances by n samples nobody reads: exactly n calls to Next(), but
+        only a jump when the ramp ends within them.
+    */
+    inline void Skip(size_t n)
+    {
+        if(n >= remaining_)
+        {
+            current_   = target_;
+            remaining_ = 0;
+            return;
+        }
+        while(n-- > 0)
+            Next();
+    }
+
+    inline float Value() const { return current_; }
+    inline float Target() const { return target_; }
+    inline bool  IsRamping() const { return remaining_ > 0; }
+
+  private:
+    float  current_   = 0.0f;
+    float  target_    = 0.0f;
+    float  step_      = 0.0f;
+    size_t remaining_ = 0;
+    float  threshold_ = 0.0f;
+};
+
+#endif
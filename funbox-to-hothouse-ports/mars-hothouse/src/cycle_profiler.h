@@ -0,0 +1,104 @@
+#pragma once
+#ifndef CYCLE_PROFILER_H
+#define CYCLE_PROFILER_H
+#include <stdint.h>
+#include "daisy_seed.h"
+
+// Cortex-M7 DWT cycle counter, used by the model tier selector and by the
+// opt-in per-stage profiler below.
+inline void enableCycleCounter()
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+inline uint32_t cycleCount()
+{
+    return DWT->CYCCNT;
+}
+
+/** min / avg / max of a stage's cycles per block */
+struct StageStats
+{
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint32_t count;
+
+    void Reset()
+    {
+        min   = UINT32_MAX;
+        max   = 0;
+        sum   = 0;
+        count = 0;
+    }
+
+    inline void Add(uint32_t cycles)
+    {
+        if(cycles < min)
+            min = cycles;
+        if(cycles > max)
+            max = cycles;
+        sum += cycles;
+        count++;
+    }
+
+    uint32_t Avg() const { return count ? static_cast<uint32_t>(sum / count) : 0; }
+};
+
+/** Per-stage cycle counts for the audio callback. The callback calls
+    Begin() at the top and Mark(stage) at the end of each stage, which
+    charges the cycles since the previous mark to that stage. The main loop
+    calls RequestSnapshot(), waits for SnapshotReady(), then reads
+    Snapshot(stage): the callback hands over its totals and starts afresh,
+    so the two sides never touch the same stats.
+*/
+template <int NumStages>
+class StageProfiler
+{
+  public:
+    void Init()
+    {
+        for(int i = 0; i < NumStages; i++)
+        {
+            live_[i].Reset();
+            snapshot_[i].Reset();
+        }
+        snapshot_requested_ = false;
+    }
+
+    inline void Begin() { lap_ = cycleCount(); }
+
+    inline void Mark(int stage)
+    {
+        const uint32_t now = cycleCount();
+        live_[stage].Add(now - lap_);
+        lap_ = now;
+    }
+
+    // Callback, after the last Mark()
+    inline void End()
+    {
+        if(!snapshot_requested_)
+            return;
+        for(int i = 0; i < NumStages; i++)
+        {
+            snapshot_[i] = live_[i];
+            live_[i].Reset();
+        }
+        snapshot_requested_ = false;
+    }
+
+    void RequestSnapshot() { snapshot_requested_ = true; }
+    bool SnapshotReady() const { return !snapshot_requested_; }
+    const StageStats& Snapshot(int stage) const { return snapshot_[stage]; }
+
+  private:
+    StageStats    live_[NumStages];
+    StageStats    snapshot_[NumStages];
+    uint32_t      lap_ = 0;
+    volatile bool snapshot_requested_ = false;
+};
+
+#endif
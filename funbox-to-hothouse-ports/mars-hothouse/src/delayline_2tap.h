@@ -3,6 +3,7 @@
 #define DELAYLINE_2TAP_H
 #include <stdlib.h>
 #include <stdint.h>
+#include <math.h>
 
 template <typename T, size_t max_size>
 class DelayLine2Tap
@@ -13,11 +14,14 @@ class DelayLine2Tap
     /** initializes the delay line by clearing the values within, and setting delay to 1 sample.
     */
     void Init() { Reset(); }
+    /** the max_size samples of the line, for inspection
+    */
+    const T* Buffer() const { return line_; }
     /** clears buffer, sets write ptr to 0, and delay to 1 sample.
     */
     void Reset()
     {
-        for(size_t i = 0; i < max_size; i++)
+        for(size_t i = 0; i <= max_size; i++)
         {
             line_[i] = T(0);
         }
@@ -77,9 +81,210 @@ class DelayLine2Tap
     inline void Write(const T sample)
     {
         line_[write_ptr_] = sample;
+        if(write_ptr_ == 0)
+            line_[max_size] = sample; // guard copy for the block reads
         write_ptr_        = (write_ptr_ - 1 + max_size) % max_size;
     }
 
+    /** writes size samples, oldest first, exactly like size calls to Write().
+        The buffer runs backwards, so this is at most two contiguous spans
+        split at index 0 - no per-sample wrap.
+    */
+    inline void WriteBlock(const T* in, size_t size)
+    {
+        size_t n = 0;
+        while(n < size)
+        {
+            size_t run = write_ptr_ + 1 < size - n ? write_ptr_ + 1 : size - n;
+            T*     dst = &line_[write_ptr_];
+            for(size_t k = 0; k < run; k++)
+            {
+                *dst-- = in[n + k];
+            }
+            n += run;
+            if(write_ptr_ + 1 == run)
+            {
+                line_[max_size] = line_[0];
+                write_ptr_      = max_size - 1;
+            }
+            else
+            {
+                write_ptr_ -= run;
+            }
+        }
+    }
+
+    /** reads size samples, as if Read() were called before each of size
+        Write() calls, with the delay (in samples) ramped linearly from
+        delayStart at the first sample towards delayEnd, which is where the
+        next block starts. The block is written after it is read, so the
+        delay must be at least size samples.
+        The read position moves monotonically, so this streams at most two
+        contiguous spans of the line, split where it wraps.
+    */
+    inline void ReadBlock(T* out, size_t size, float delayStart, float delayEnd) const
+    {
+        _ReadRamp(out, size, _ClampDelay(delayStart), _ClampDelay(delayEnd));
+    }
+
+    /** ReadBlock() for the second tap, with the same delay ramp. The tap sits
+        at the integer part of the delay plus delay * 2ndTapFraction, wrapping
+        round the line past max_size, as in ReadSecondTap().
+    */
+    inline void ReadSecondTapBlock(T* out, size_t size, float delayStart, float delayEnd) const
+    {
+        const float start = _SecondTapDelay(delayStart);
+        const float end   = _SecondTapDelay(delayEnd);
+        const float wrap  = start >= static_cast<float>(max_size) ? static_cast<float>(max_size) : 0.0f;
+        _ReadRamp(out, size, start - wrap, end - wrap);
+    }
+
+    /** ReadBlock() through ReadHermite()'s 4-point interpolation, for a
+        delay that moves within the block (a modulated one), where the
+        linear read's varying high-frequency loss would be heard. Reads
+        that stay clear of the ends of the line index it directly; the few
+        whose points straddle the wrap take the modulo. The delay must be
+        at least size + 1 samples, so every point has been written.
+    */
+    inline void ReadHermiteBlock(T* out, size_t size, float delayStart, float delayEnd) const
+    {
+        delayStart = _ClampDelay(delayStart);
+        delayEnd   = _ClampDelay(delayEnd);
+        const int32_t delayInt = static_cast<int32_t>(delayStart);
+        const float   frac0    = delayStart - static_cast<float>(delayInt);
+        const float   rate     = (delayEnd - delayStart) / size - 1.0f;
+        const int32_t base     = static_cast<int32_t>(write_ptr_) + delayInt;
+        const int32_t last     = static_cast<int32_t>(max_size) - 2; // + 2 is the guard copy
+
+        for(size_t n = 0; n < size; n++)
+        {
+            const float pos   = frac0 + n * rate;
+            int32_t     whole = static_cast<int32_t>(floorf(pos));
+            const float f     = pos - static_cast<float>(whole);
+            whole += base;
+            if(whole >= static_cast<int32_t>(max_size))
+                whole -= max_size;
+            else if(whole < 0)
+                whole += max_size;
+
+            T xm1, x0, x1, x2;
+            if(whole >= 1 && whole <= last)
+            {
+                const T* p = &line_[whole];
+                xm1        = p[-1];
+                x0         = p[0];
+                x1         = p[1];
+                x2         = p[2];
+            }
+            else
+            {
+                const size_t t = static_cast<size_t>(whole) + max_size;
+                xm1            = line_[(t - 1) % max_size];
+                x0             = line_[t % max_size];
+                x1             = line_[(t + 1) % max_size];
+                x2             = line_[(t + 2) % max_size];
+            }
+            const float c     = (x1 - xm1) * 0.5f;
+            const float v     = x0 - x1;
+            const float w     = c + v;
+            const float a     = w + v + (x2 - x0) * 0.5f;
+            const float b_neg = w + a;
+            out[n]            = (((a * f) - b_neg) * f + c) * f + x0;
+        }
+    }
+
+    /** reads size samples backwards through the line, for a reverse delay:
+        as if Read() were called before each of size Write() calls with the
+        delay starting at delayStart and growing by 2 a sample. The read
+        starts offset samples into the block, for a run that begins
+        mid-block, and whole delays need no interpolation: the index just
+        counts up, in at most two contiguous spans. delayStart must be more
+        than offset plus the rest of the block, which has yet to be written,
+        and delayStart + 2 * size must stay within the line.
+    */
+    inline void ReadReverseBlock(T* out, size_t size, size_t delayStart, size_t offset = 0) const
+    {
+        size_t index = write_ptr_ + delayStart - offset;
+        if(index >= max_size)
+            index -= max_size;
+        size_t n = 0;
+        while(n < size)
+        {
+            const size_t run = max_size - index < size - n ? max_size - index : size - n;
+            for(size_t k = 0; k < run; k++)
+            {
+                out[n + k] = line_[index + k];
+            }
+            n += run;
+            index = 0;
+        }
+    }
+
+    /** Most taps ReadTapsBlock() takes */
+    static const int kMaxTaps = 4;
+
+    /** reads up to kMaxTaps taps of the one line in a single pass over the
+        block. Tap t sits at tapMultiple[t] times the delay (ramped as in
+        ReadBlock()), wrapping round the line past max_size; out gets the sum
+        of the taps scaled by tapGain[t]. If tap0 isn't NULL, it gets tap 0
+        unscaled, e.g. for feedback. The delay must be at least size samples.
+    */
+    inline void ReadTapsBlock(T*           out,
+                              T*           tap0,
+                              size_t       size,
+                              float        delayStart,
+                              float        delayEnd,
+                              const float* tapMultiple,
+                              const float* tapGain,
+                              int          numTaps) const
+    {
+        numTaps = numTaps < kMaxTaps ? numTaps : kMaxTaps;
+        delayStart = _ClampDelay(delayStart);
+        delayEnd   = _ClampDelay(delayEnd);
+
+        int32_t base[kMaxTaps];
+        float   frac0[kMaxTaps];
+        float   rate[kMaxTaps];
+        for(int t = 0; t < numTaps; t++)
+        {
+            float start = delayStart * tapMultiple[t];
+            float end   = delayEnd * tapMultiple[t];
+            while(start >= static_cast<float>(max_size))
+            {
+                start -= static_cast<float>(max_size);
+                end -= static_cast<float>(max_size);
+            }
+            const int32_t whole = static_cast<int32_t>(start);
+            frac0[t]            = start - static_cast<float>(whole);
+            rate[t]             = (end - start) / size - 1.0f;
+            base[t]             = static_cast<int32_t>(write_ptr_) + whole;
+            if(base[t] >= static_cast<int32_t>(max_size))
+                base[t] -= max_size;
+        }
+
+        for(size_t n = 0; n < size; n++)
+        {
+            T sum = T(0);
+            for(int t = 0; t < numTaps; t++)
+            {
+                const float pos   = frac0[t] + n * rate[t];
+                int32_t     whole = static_cast<int32_t>(floorf(pos));
+                const float frac  = pos - static_cast<float>(whole);
+                whole += base[t];
+                if(whole < 0)
+                    whole += max_size;
+                else if(whole >= static_cast<int32_t>(max_size))
+                    whole -= max_size;
+                const T* p   = &line_[whole]; // guard copy covers p[1]
+                const T  tap = p[0] + (p[1] - p[0]) * frac;
+                if(t == 0 && tap0)
+                    tap0[n] = tap;
+                sum += tap * tapGain[t];
+            }
+            out[n] = sum;
+        }
+    }
+
     /** returns the next sample of type T in the delay line, interpolated if necessary.
     */
     inline const T Read() const
@@ -135,10 +340,88 @@ class DelayLine2Tap
     }
 
   private:
+    // Index of sample n for a ramped read: base + floor(frac0 + n * rate).
+    // Monotonic in n, which is what lets _ReadRamp() find the wrap point.
+    static inline int32_t _RampIndex(int32_t base, float frac0, float rate, size_t n)
+    {
+        return base + static_cast<int32_t>(floorf(frac0 + n * rate));
+    }
+
+    static inline bool _InLine(int32_t index)
+    {
+        return index >= 0 && index < static_cast<int32_t>(max_size);
+    }
+
+    static inline float _ClampDelay(float delay)
+    {
+        const float maxDelay = static_cast<float>(max_size - 1);
+        return delay < 0.0f ? 0.0f : (delay > maxDelay ? maxDelay : delay);
+    }
+
+    // Same clamping as SetDelay() applies to delay_ and delay_secondTap
+    inline float _SecondTapDelay(float delay) const
+    {
+        const float   main = floorf(_ClampDelay(delay));
+        const float   tap  = delay * secondTapFraction;
+        const int32_t whole = static_cast<int32_t>(tap);
+        const float   clampedWhole
+            = static_cast<size_t>(whole) < max_size ? static_cast<float>(whole) : static_cast<float>(max_size - 1);
+        return main + clampedWhole + (tap - static_cast<float>(whole));
+    }
+
+    // delayStart must be in [0, max_size); delayEnd may run a little past
+    // either end, the index wraps
+    void _ReadRamp(T* out, size_t size, float delayStart, float delayEnd) const
+    {
+        // The write pointer moves back one sample per sample, the delay
+        // forward by step: the read index moves by step - 1
+        const int32_t delayInt = static_cast<int32_t>(delayStart);
+        const float   frac0    = delayStart - static_cast<float>(delayInt);
+        const float   rate     = (delayEnd - delayStart) / size - 1.0f;
+        int32_t       base     = static_cast<int32_t>(write_ptr_) + delayInt;
+        if(base >= static_cast<int32_t>(max_size))
+            base -= max_size;
+
+        size_t n = 0;
+        while(n < size)
+        {
+            // Find where this span leaves the line (binary search, as the
+            // index is monotonic)
+            size_t end = size;
+            if(!_InLine(_RampIndex(base, frac0, rate, size - 1)))
+            {
+                size_t lo = n, hi = size - 1;
+                while(hi - lo > 1)
+                {
+                    size_t mid = (lo + hi) / 2;
+                    if(_InLine(_RampIndex(base, frac0, rate, mid)))
+                        lo = mid;
+                    else
+                        hi = mid;
+                }
+                end = hi;
+            }
+
+            // line_[max_size] mirrors line_[0], so index + 1 needs no wrap
+            for(; n < end; n++)
+            {
+                const float   pos   = frac0 + n * rate;
+                const int32_t whole = static_cast<int32_t>(floorf(pos));
+                const T*      p     = &line_[base + whole];
+                const float   frac  = pos - static_cast<float>(whole);
+                out[n]              = p[0] + (p[1] - p[0]) * frac;
+            }
+
+            if(n < size)
+                base += _RampIndex(base, frac0, rate, n) < 0 ? static_cast<int32_t>(max_size)
+                                                             : -static_cast<int32_t>(max_size);
+        }
+    }
+
     float  frac_;
     size_t write_ptr_;
     size_t delay_;
-    T      line_[max_size];
+    T      line_[max_size + 1]; // + guard copy of line_[0]
 
     float  frac_secondTap;
     size_t delay_secondTap;
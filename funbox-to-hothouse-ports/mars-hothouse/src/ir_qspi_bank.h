@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include "hothouse_containers.h"
+#include "model_qspi_bank.h"
+
+// Cabinet IRs in QSPI flash (tools/mars_ir_gen.py, then make program-irs or,
+// with make UPLOAD=1, tools/hothouse_upload.py), in place of ir_data.h's.
+// Same framing as the model bank, with its own magic:
+//
+//   QspiBankHeader                      magic, version, counts, checksum
+//   QspiIrEntry[count]                  where each IR's samples are
+//   float[length] ...                   at entry.offset from the header
+//
+// The IRs are prepared (ImpulseResponse::InitBank()) at boot only, so a bank
+// written while the pedal runs is heard from the next power-up.
+
+static constexpr uint32_t QSPI_IR_BANK_MAGIC = 0x5249524Du;  // "MRIR"
+static constexpr uint32_t QSPI_IR_BANK_VERSION = 1;
+
+struct QspiIrEntry
+{
+    uint32_t offset;  // from the header, 4-byte aligned
+    uint32_t length;  // samples at 48 kHz
+    char name[24];    // for the serial log, not always terminated
+};
+
+// Points irs[0..] at the bank's IRs at base (a QSPI address, memory-mapped,
+// so nothing is copied), as many as irs holds, if the header, every entry
+// and the checksum are good. Returns the number replaced: 0 leaves irs as
+// they were.
+inline int LoadQspiIrBank(const void* base, clevelandmusicco::Span<clevelandmusicco::Span<const float>> irs)
+{
+    static constexpr uint32_t kMaxSize = 1024 * 1024;
+    static constexpr uint32_t kMaxLength = 65536;
+
+    const uint8_t* bytes = static_cast<const uint8_t*>(base);
+    QspiBankHeader header;
+    memcpy(&header, bytes, sizeof(header));
+    if (header.magic != QSPI_IR_BANK_MAGIC || header.version != QSPI_IR_BANK_VERSION)
+        return 0;
+    if (header.count == 0 || header.count > irs.size() || header.size > kMaxSize)
+        return 0;
+    const uint32_t directoryEnd = sizeof(header) + header.count * sizeof(QspiIrEntry);
+    if (directoryEnd > header.size)
+        return 0;
+
+    const QspiIrEntry* entries = reinterpret_cast<const QspiIrEntry*>(bytes + sizeof(header));
+    for (uint32_t i = 0; i < header.count; i++)
+    {
+        const QspiIrEntry& e = entries[i];
+        if (e.length == 0 || e.length > kMaxLength || e.length * sizeof(float) > header.size
+            || e.offset < directoryEnd || e.offset % 4 != 0
+            || e.offset > header.size - e.length * sizeof(float))
+            return 0;
+    }
+    if (QspiBankChecksum(bytes, header.size) != header.checksum)
+        return 0;
+
+    for (uint32_t i = 0; i < header.count; i++)
+    {
+        const float* samples = reinterpret_cast<const float*>(bytes + entries[i].offset);
+        irs[i] = clevelandmusicco::Span<const float>(samples, entries[i].length);
+    }
+    return (int)header.count;
+}
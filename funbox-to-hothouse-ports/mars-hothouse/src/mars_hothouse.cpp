@@ -1,11 +1,29 @@
 #include "daisy_seed.h"
 #include "daisysp.h"
 #include "hothouse.h"
+#include "hothouse_arena.h"
+#include "hothouse_commands.h"
+#include "hothouse_curves.h"
+#include "hothouse_fastmath.h"
+#include "hothouse_mixlaw.h"
+#include "hothouse_tempo.h"
 #include <RTNeural/RTNeural.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <new>
 
 // Include the Mars-specific headers that define the types
 #include "delayline_2tap.h"
-#include "all_model_data_gru9_4count.h"
+#include "control_param.h"
+#include "activity_gate.h"
+#include "noise_gate.h"
+#include "block_balance.h"
+#include "cycle_profiler.h"
+#include "model_bank.h"
+#include "model_tiers.h"
+#include "model_qspi_bank.h"
+#include "ir_qspi_bank.h"
 #include "ImpulseResponse/ImpulseResponse.h"
 #include "ImpulseResponse/ir_data.h"
 
@@ -34,26 +52,146 @@ Hothouse hw;
 // Audio processing objects
 Tone tone;        // Low Pass
 ATone toneHP;     // High Pass - ATone like original Mars.cpp
-Balance bal;      // Balance for volume correction in filtering
+BlockBalance bal; // Balance for volume correction in filtering, per block
+
+// Block-rate knob parameters, ramped across each block
+ControlParam gainParam;   // model input gain
+ControlParam filterParam; // cubic-curved filter knob
+ControlParam wetParam;    // delay wet/dry mix
+ControlParam dryParam;
+ControlParam levelParam;  // output level
+#define TONE_UPDATE_SAMPLES 16 // filter coefficient update interval while the filter knob moves
+bool toneLowPass = true;
+
+// Filter knob -> tone frequency, exactly like the original Mars.cpp. Only
+// the filter for the current mode is retuned.
+inline void setToneFreq(float vfilter)
+{
+    if (vfilter <= 0.5f) {
+        // Low pass mode: 100Hz to ~20kHz like original
+        tone.SetFreq((vfilter * 39800.0f) + 100.0f);
+    } else {
+        // High pass mode: 40Hz to 440Hz like original
+        toneHP.SetFreq((vfilter - 0.5f) * 800.0f + 40.0f);
+    }
+    toneLowPass = vfilter <= 0.5f;
+}
 
 // Delay Max Definitions (Assumes 48kHz samplerate)
 #define MAX_DELAY static_cast<size_t>(48000.0f * 1.f)  // MODIFIED: 1 second max delay
 // Original 2 second delay: #define MAX_DELAY static_cast<size_t>(48000.0f * 2.f)
-DelayLine2Tap<float, MAX_DELAY> DSY_SDRAM_BSS delayLine;
+typedef DelayLine2Tap<float, MAX_DELAY> MarsDelayLine;
+// Built in the shared SDRAM arena in main() (make SDRAM_ARENA_MB)
+MarsDelayLine* delayLine = nullptr;
+static_assert(sizeof(MarsDelayLine) <= kSdramArenaBytes,
+              "the delay line needs a bigger SDRAM arena (SDRAM_ARENA_MB)");
 
 // Impulse Response - REPLICATED from original Mars
 ImpulseResponse mIR;
 int m_currentIRindex;
+// Each cab is cut where its tail is this far below its energy, so the
+// convolver skips taps nobody hears, and at Eco quality after 256 taps
+// (5.3 ms) at the latest; High doesn't cut. make IR_MIN_PHASE=1 also
+// converts the cabs to minimum phase first, which makes the cut come sooner.
+struct IrQuality {
+    float tailDb;
+    size_t maxTaps;
+};
+static const IrQuality irQuality[Hothouse::QUALITY_LAST] = {
+    {-40.0f, 256}, {-60.0f, kIrMaxLength}, {0.0f, kIrMaxLength}};
+#ifdef MARS_IR_MIN_PHASE
+#define IR_MINIMUM_PHASE true
+#else
+#define IR_MINIMUM_PHASE false
+#endif
+
+// make IR_BLEND=1: Knob 4 blends TOGGLESWITCH_2's cab into the next one (UP
+// 1 into 2, MIDDLE 2 into 3, DOWN 3 into 1) in place of the tone filter,
+// which stays open. The main loop mixes the pair into one kernel when the
+// knob moves (ImpulseResponse::Blend()), so a blend costs one convolution.
+#ifdef MARS_IR_BLEND
+#define IR_BLEND true
+#else
+#define IR_BLEND false
+#endif
+// make STEREO_CAB=1: the right output gets the cab after TOGGLESWITCH_2's
+// (as IR_BLEND pairs them) and the left keeps its own. Both run off one
+// input transform (ImpulseResponse's stereo ProcessBlock()), about 1.5
+// times the cost of one cab.
+#ifdef MARS_STEREO_CAB
+#define STEREO_CAB true
+#else
+#define STEREO_CAB false
+#endif
+#if defined(MARS_IR_BLEND) && defined(MARS_STEREO_CAB)
+#error "IR_BLEND and STEREO_CAB both pair TOGGLESWITCH_2's cab with the next: pick one"
+#endif
+// make NULL_TEST=1: the cab's zero-latency FFT engine against the same cab
+// convolved sample by sample, the way the original Mars ran it, on the live
+// input (ImpulseResponse::ProcessReference()); the difference replaces the
+// right output. Blends have no reference to check against.
+#if HOTHOUSE_NULL_TEST && defined(MARS_IR_BLEND)
+#error "NULL_TEST checks the bank's cabs, which IR_BLEND plays only through blends: build without it"
+#endif
+// The cabs' spectra and the IR engines' FFT state, carved by InitBank()
+// from a static pool in AXI SRAM (make IR_POOL_KB=n). Room for the built-in
+// cabs is checked here; a QSPI bank that doesn't fit has its longest cabs
+// cut short, and the boot timing report says so.
+#ifndef MARS_IR_POOL_KB
+#define MARS_IR_POOL_KB 128
+#endif
+alignas(Arena::kAlign) static uint8_t irPool[MARS_IR_POOL_KB << 10];
+Arena irArena(irPool, sizeof(irPool));
+static_assert(ImpulseResponse::BankArenaFloats(decltype(ir_collection)::kCapacity,
+                                               std::max({sizeof(ir_data1), sizeof(ir_data2),
+                                                         sizeof(ir_data3)}) / sizeof(float),
+                                               IR_BLEND, HOTHOUSE_NULL_TEST)
+                  * sizeof(float) <= sizeof(irPool),
+              "the built-in cabs need a bigger IR pool (IR_POOL_KB)");
+int irBlendPair = 0;                  // main loop: the first cab
+std::atomic<float> irBlendMix{0.0f};  // callback -> main loop: how far into the next one
+int irBlendAppliedPair = -1;          // main loop: the blend playing
+float irBlendAppliedMix = 0.0f;
+
+// Audio block size - the zero-latency IR engine accepts any block size.
+// Buffers are sized for AUDIO_BLOCK_SIZE, the Max-Headroom profile; the
+// smaller profiles (hold both footswitches at power-up, or FS2 alone for
+// Low-Latency on this boot only) cut latency to ~1 ms from ~5.3 ms at 48 kHz,
+// paid for in per-block overhead, which the model tier selector absorbs.
+#define AUDIO_BLOCK_SIZE 256
+static const Hothouse::AudioProfileTable audioProfiles = {
+    {{48, SaiHandle::Config::SampleRate::SAI_48KHZ},
+     {128, SaiHandle::Config::SampleRate::SAI_48KHZ},
+     {AUDIO_BLOCK_SIZE, SaiHandle::Config::SampleRate::SAI_48KHZ}},
+    Hothouse::AUDIO_PROFILE_MAX_HEADROOM};
+size_t audioBlockSize = AUDIO_BLOCK_SIZE;
+float irBuffer[AUDIO_BLOCK_SIZE];
+float irRight[AUDIO_BLOCK_SIZE];   // the right cab, make STEREO_CAB=1
+#if HOTHOUSE_NULL_TEST
+float irReference[AUDIO_BLOCK_SIZE];  // the cab by direct form, make NULL_TEST=1
+#endif
+float modelIn[AUDIO_BLOCK_SIZE];   // gained input, shared by both model slots
+float modelOut[AUDIO_BLOCK_SIZE];  // active slot
+float modelNext[AUDIO_BLOCK_SIZE]; // incoming slot while crossfading
+float delayIn[AUDIO_BLOCK_SIZE];   // filtered signal into the delay
+float delayOut[AUDIO_BLOCK_SIZE];  // mono, or left in ping-pong mode
+float delayOutR[AUDIO_BLOCK_SIZE]; // ping-pong right
 
 // Control variables
 float knobValues[6] = {0.0f};
-int toggleValues[3] = {1};
+int toggleValues[3] = {1};             // main loop, see serviceToggles()
 int prev_toggleValues[3] = {-1, -1, -1};
+
+// The cab and delay pattern the toggles pick, handed from the main loop to
+// the callback (hothouse_commands.h)
+enum MarsCommand { CMD_SELECT_IR, CMD_DELAY_PATTERN };
+#define COMMAND_BUDGET 4  // commands a block, each costing 1
+CommandQueue<> commands;
 bool dipValues[4] = {true, true, false, false};
 
 // Effect parameters
-float nnLevelAdjust = 1.0f;
 float mix_effects = 0.5f;
+float wet_gain = 0.0f, dry_gain = 0.0f;  // mix law at mix_effects
 int blink = 0;
 bool trigger_save = false;
 bool bypass = true;
@@ -63,6 +201,78 @@ bool first_start = true;
 // LEDs
 Led led1, led2;
 
+// A bypassed delay's tail counts as gone below this (-120 dB)
+#define DELAY_SILENCE 1e-6f
+
+// Silence-aware idle: once the input, both outputs and the delay line have
+// stayed under IDLE_CLOSE for IDLE_HOLD samples, the callback skips the
+// amp, tone, delay and cab and writes silence, until an input block peaks
+// over IDLE_OPEN. That block is processed in full. The GRU's state is kept
+// as it was, so the amp picks up from its own settled silence; the cab's
+// history is cleared once, on the first idle block.
+#define IDLE_OPEN 1e-4f   // -80 dB
+#define IDLE_CLOSE 5e-5f  // -86 dB
+#define IDLE_HOLD 24000   // 500 ms, longer than any cab IR
+ActivityGate activity;
+bool idleFlushed = false; // the cab has been reset for this idle stretch
+
+// make NOISE_GATE=1: a gate on the amp model's input, decided per block
+// (see NoiseGate). It opens on a block whose RMS is over GATE_DB and closes
+// once the blocks have stayed 10 dB under that for 50 ms. While it's shut
+// the input counts as silence for the idle gate, so a high-gain model's
+// hiss doesn't keep the GRU and the cab running between notes.
+#ifdef MARS_NOISE_GATE
+#define NOISE_GATE true
+#else
+#define NOISE_GATE false
+#endif
+#ifndef MARS_GATE_DB
+#define MARS_GATE_DB -60
+#endif
+NoiseGate noiseGate;
+
+// Signal probes (make PROBE=1): the amp model's output, before the tone,
+// and the cab's input, each the last 2 s
+#define PROBE_FRAMES 96000
+int probeModel = -1;
+int probeCab = -1;
+
+// make REVERSE_DELAY=1: TOGGLESWITCH_3 DOWN plays the mono delay backwards
+// instead of the triplet tap
+#ifdef MARS_REVERSE_DELAY
+#define REVERSE_DELAY true
+#else
+#define REVERSE_DELAY false
+#endif
+
+// make DELAY_MOD=1: the repeats wander by up to DELAY_MOD_MS on a
+// DELAY_MOD_HZ sine, for a touch of tape wow. The LFO steps once a block
+// and the offset is ramped across the block with the delay time, so the
+// only per-sample cost is the repeats' read becoming a Hermite one.
+#ifdef MARS_DELAY_MOD
+#define DELAY_MOD true
+#else
+#define DELAY_MOD false
+#endif
+#ifndef MARS_DELAY_MOD_MS
+#define MARS_DELAY_MOD_MS 1.0f
+#endif
+#ifndef MARS_DELAY_MOD_HZ
+#define MARS_DELAY_MOD_HZ 0.5f
+#endif
+
+// Reverse delay: each grain plays the last delay time of the line backwards,
+// from REVERSE_START samples back (more than a block, as the block is read
+// before it is written), and the next one crossfades in over its last
+// REVERSE_FADE samples. A grain reads back twice its length, so grains are
+// at most REVERSE_MAX_GRAIN, just under 500 ms.
+#define REVERSE_START AUDIO_BLOCK_SIZE
+#define REVERSE_FADE 1024
+#define REVERSE_MAX_GRAIN ((MAX_DELAY - 1 - REVERSE_START) / 2)
+// Equal-power fade-in, sin(pi/2 x) at the middle of each sample; run
+// backwards it is the fade-out. Filled at boot.
+float reverseFade[REVERSE_FADE];
+
 // Enhanced delay structure with 2-tap capability - BASED ON original Mars (modified for 1-second buffer)
 struct delay
 {
@@ -72,88 +282,599 @@ struct delay
     float                        feedback = 0.0;
     float                        active = false;
     float                        level = 1.0;      // Level multiplier of output
-    bool                         secondTapOn = false;
-    
-    float Process(float in)
+    const float*                 tapMultiple = nullptr; // block taps, see DelayPattern
+    const float*                 tapGain = nullptr;
+    int                          numTaps = 1;
+    size_t                       silentSamples = MAX_DELAY; // the line is zeroed at Init
+    size_t                       quietSamples = MAX_DELAY;  // same, at IDLE_CLOSE
+
+    // Same smoothing of the delay time as the original per-sample Process(),
+    // applied once per block and ramped across it. Returns the block's
+    // starting delay time.
+    float Glide(size_t size)
     {
-        //set delay times
-        fonepole(currentDelay, delayTarget, .0002f);
-        del->SetDelay(currentDelay);
+        // size steps of fonepole(currentDelay, delayTarget, .0002f)
+        const float blockCoeff = 1.0f - fastmath::Pow(1.0f - .0002f, (float)size);
+        const float startDelay = currentDelay;
+        fonepole(currentDelay, delayTarget, blockCoeff);
+        return startDelay;
+    }
 
-        float read = del->Read();
+    // Switched off, with nothing written to the line above DELAY_SILENCE for
+    // a whole line length: every tap reads (close enough to) zero, so the
+    // callback can leave the line alone and call Idle() instead
+    bool Silent() const { return !active && silentSamples >= MAX_DELAY; }
 
-        float secondTap = 0.0;
-        if (secondTapOn) {
-            secondTap = del->ReadSecondTap();
+    // Nothing over IDLE_CLOSE written for a line length, switched on or
+    // not: the delay adds nothing the idle gate would have to wait for
+    bool Quiet() const { return Silent() || quietSamples >= MAX_DELAY; }
+
+    // make DELAY_MOD=1: the modulation's offset in samples, by modDepth on
+    // a sine of modStep cycles a sample. Steps the LFO by a block and
+    // returns the block's starting offset; the end's is modOffset.
+    float Modulate(size_t size)
+    {
+        const float startOffset = modOffset;
+        modPhase += modStep * size;
+        if (modPhase >= 1.0f)
+            modPhase -= 1.0f;
+        modOffset = modDepth * fastmath::Sin(6.28318531f * modPhase);
+        return startOffset;
+    }
+
+    // A block of a Silent() delay: only the delay time keeps gliding, so the
+    // echoes come back at the right time when the delay is switched on
+    void Idle(size_t size)
+    {
+        Glide(size);
+        Modulate(size);
+    }
+
+    // Every tap read in one pass over the line. The delay is always longer
+    // than a block here.
+    void ProcessBlock(const float* in, float* out, size_t size)
+    {
+        const float startDelay = Glide(size);
+
+        if (modDepth > 0.0f) {
+            // The main tap, which feeds back, read modulated; the others
+            // at the steady delay
+            const float startOffset = Modulate(size);
+            del->ReadHermiteBlock(readBuffer, size, startDelay * tapMultiple[0] + startOffset,
+                                  currentDelay * tapMultiple[0] + modOffset);
+            if (numTaps > 1) {
+                del->ReadTapsBlock(tapBuffer, nullptr, size, startDelay, currentDelay,
+                                   tapMultiple + 1, tapGain + 1, numTaps - 1);
+            } else {
+                memset(tapBuffer, 0, size * sizeof(float));
+            }
+            for (size_t i = 0; i < size; i++)
+                tapBuffer[i] += readBuffer[i] * tapGain[0];
+        } else {
+            del->ReadTapsBlock(tapBuffer, readBuffer, size, startDelay, currentDelay,
+                               tapMultiple, tapGain, numTaps);
         }
 
-        if (active) {
-            del->Write((feedback * read) + in);
+        float peak = 0.0f;
+        for (size_t i = 0; i < size; i++) {
+            float read = readBuffer[i];
+            // if not active, don't write any new sound to buffer
+            writeBuffer[i] = active ? (feedback * read) + in[i] : feedback * read;
+            peak = fmaxf(peak, fabsf(writeBuffer[i]));
+            out[i] = tapBuffer[i] * level;
+        }
+        del->WriteBlock(writeBuffer, size);
+        TrackSilence(peak, size);
+    }
+
+    // Stereo ping-pong on the same mono line: echoes alternate left (odd
+    // bounces) and right (even bounces), each bounce scaled by feedback.
+    // Left reads the line at half the delay time and right at the full
+    // delay time, and the right tap feeds back at feedback^2. Both sides
+    // stay within the 1-second line, so one bounce is at most 500 ms.
+    void ProcessPingPongBlock(const float* in, float* outL, float* outR, size_t size)
+    {
+        const float startDelay = Glide(size);
+
+        del->ReadBlock(tapBuffer, size, startDelay * 0.5f, currentDelay * 0.5f);
+        if (modDepth > 0.0f) {
+            // The right tap feeds back, so every bounce carries the wow
+            const float startOffset = Modulate(size);
+            del->ReadHermiteBlock(readBuffer, size, startDelay + startOffset, currentDelay + modOffset);
         } else {
-            del->Write(feedback * read); // if not active, don't write any new sound to buffer
+            del->ReadBlock(readBuffer, size, startDelay, currentDelay);
         }
 
-        return (read + secondTap) * level;
+        const float loopFeedback = feedback * feedback;
+        float peak = 0.0f;
+        for (size_t i = 0; i < size; i++) {
+            float read = readBuffer[i];
+            writeBuffer[i] = active ? (loopFeedback * read) + in[i] : loopFeedback * read;
+            peak = fmaxf(peak, fabsf(writeBuffer[i]));
+            outL[i] = tapBuffer[i] * level;
+            outR[i] = read * feedback * level;
+        }
+        del->WriteBlock(writeBuffer, size);
+        TrackSilence(peak, size);
+    }
+
+    // The line played backwards in grains of the delay time, crossfaded by
+    // two heads; feedback as in ProcessBlock(), so repeats flip direction.
+    // The delay is always longer than a block here.
+    void ProcessReverseBlock(const float* in, float* out, size_t size)
+    {
+        Glide(size);
+        size_t grain = (size_t)currentDelay;
+        grain = grain < REVERSE_MAX_GRAIN ? grain : REVERSE_MAX_GRAIN;
+        const size_t period = grain - REVERSE_FADE; // between grain starts
+
+        size_t n = 0;
+        while (n < size) {
+            if (grainPos >= period) {
+                head = 1 - head;
+                headDelay[head] = REVERSE_START;
+                grainPos = 0;
+                fadePos = 0;
+            }
+            size_t run = size - n < period - grainPos ? size - n : period - grainPos;
+            if (fadePos < REVERSE_FADE && REVERSE_FADE - fadePos < run)
+                run = REVERSE_FADE - fadePos;
 
+            del->ReadReverseBlock(&readBuffer[n], run, headDelay[head], n);
+            headDelay[head] += 2 * run;
+            if (fadePos < REVERSE_FADE) {
+                const int old = 1 - head;
+                del->ReadReverseBlock(&tapBuffer[n], run, headDelay[old], n);
+                headDelay[old] += 2 * run;
+                for (size_t k = 0; k < run; k++) {
+                    readBuffer[n + k] = readBuffer[n + k] * reverseFade[fadePos + k]
+                                      + tapBuffer[n + k] * reverseFade[REVERSE_FADE - 1 - fadePos - k];
+                }
+                fadePos += run;
+            }
+            grainPos += run;
+            n += run;
+        }
+
+        float peak = 0.0f;
+        for (size_t i = 0; i < size; i++) {
+            float read = readBuffer[i];
+            writeBuffer[i] = active ? (feedback * read) + in[i] : feedback * read;
+            peak = fmaxf(peak, fabsf(writeBuffer[i]));
+            out[i] = read * level;
+        }
+        del->WriteBlock(writeBuffer, size);
+        TrackSilence(peak, size);
     }
+
+    // The mono delay, forwards or backwards
+    void ProcessMonoBlock(const float* in, float* out, size_t size)
+    {
+        if (reverse) {
+            ProcessReverseBlock(in, out, size);
+        } else {
+            ProcessBlock(in, out, size);
+        }
+    }
+
+    // Switching to reverse starts a grain at once, with nothing to fade from
+    void SetReverse(bool r)
+    {
+        if (r && !reverse) {
+            head = 0;
+            headDelay[0] = REVERSE_START;
+            grainPos = 0;
+            fadePos = REVERSE_FADE;
+        }
+        reverse = r;
+    }
+
+    void TrackSilence(float peak, size_t size)
+    {
+        if (active || peak > DELAY_SILENCE) {
+            silentSamples = 0;
+        } else if (silentSamples < MAX_DELAY) {
+            silentSamples += size;
+        }
+        if (peak > IDLE_CLOSE) {
+            quietSamples = 0;
+        } else if (quietSamples < MAX_DELAY) {
+            quietSamples += size;
+        }
+    }
+
+    // make DELAY_MOD=1 (0 depth leaves the reads as they were)
+    float                        modDepth = 0.0f;  // samples
+    float                        modStep = 0.0f;   // LFO cycles a sample
+    float                        modPhase = 0.0f;
+    float                        modOffset = 0.0f; // at the start of the next block
+
+    float readBuffer[AUDIO_BLOCK_SIZE];
+    float tapBuffer[AUDIO_BLOCK_SIZE];
+    float writeBuffer[AUDIO_BLOCK_SIZE];
+
+    // Reverse heads: headDelay[head] is the newer grain
+    bool                         reverse = false;
+    int                          head = 0;
+    size_t                       headDelay[2] = {REVERSE_START, REVERSE_START};
+    size_t                       grainPos = 0;     // samples into the newer grain
+    size_t                       fadePos = REVERSE_FADE;
 };
 
 delay delay1;
 
+// Delay tap patterns for TOGGLESWITCH_3, as multiples of the delay time.
+// Tap 0 is the main tap and feeds back; the rest only go to the output.
+// The original Mars second tap sits the fraction past the main one.
+struct DelayPattern
+{
+    int   numTaps;
+    float multiple[DelayLine2Tap<float, MAX_DELAY>::kMaxTaps];
+    float gain[DelayLine2Tap<float, MAX_DELAY>::kMaxTaps];
+};
+
+const DelayPattern delayPatterns[3] = {
+    {1, {1.0f}, {1.0f}},                   // UP: single tap
+    {2, {1.0f, 1.75f}, {1.0f, 1.0f}},      // MIDDLE: + dotted eighth
+    {2, {1.0f, 1.6666667f}, {1.0f, 1.0f}}, // DOWN: + triplet
+};
+
+// FS2 tap tempo: presses less than a second apart after the one that
+// switched the delay on set the delay time, until Knob 5 moves. While it
+// does, LED 2 blinks off on the beat (tempoEvents, every callback).
+TempoClock tapTempo;
+EventScheduler<2> tempoEvents;
+enum TempoEvent { TEMPO_FLASH_END };
+#define TEMPO_FLASH_SAMPLES 2400 // LED 2 is off for 50 ms a beat
+bool tempoFlash = false;
+float tapKnobPosition = 0.0f;
+#define TAP_KNOB_RELEASE 0.05f // Knob 5 travel that hands the delay time back to the knob
+
+// make DELAY_POST_CAB=1: the mono delay repeats the cab's output, as
+// ping-pong always does, instead of feeding the cab with the dry signal
+#ifdef MARS_DELAY_POST_CAB
+#define DELAY_POST_CAB true
+#else
+#define DELAY_POST_CAB false
+#endif
+
+// Hold FS2 to switch between the mono delay and stereo ping-pong
+#define PING_PONG_HOLD_MS 1000
+bool ping_pong = false;
+bool fs2_toggled_delay = false; // this FS2 press switched the delay on/off
+bool fs2_hold_handled = false;
+
+// Opt-in per-stage cycle profile of AudioCallback (make PROFILE=1), printed
+// over USB serial every PROFILE_REPORT_MS
+#ifdef MARS_PROFILE
+enum ProfileStage {
+    STAGE_CONTROLS, // controls, mix and bypass
+    STAGE_MODEL,    // gain + GRU(s)
+    STAGE_TONE,     // model crossfade + LP/HP tone
+    STAGE_BALANCE,
+    STAGE_DELAY,
+    STAGE_IR,       // + the dry/wet mix when the cab comes last
+    STAGE_OUTPUT,   // output level (+ dry/wet mix when the cab comes first)
+    NUM_PROFILE_STAGES
+};
+const char* profileStageNames[NUM_PROFILE_STAGES] = {
+    "controls", "model", "tone", "balance", "delay", "ir", "output"};
+StageProfiler<NUM_PROFILE_STAGES> profiler;
+#define PROFILE_REPORT_MS 5000
+#define PROFILE_BEGIN() profiler.Begin()
+#define PROFILE_MARK(stage) profiler.Mark(stage)
+#define PROFILE_END() profiler.End()
+#else
+#define PROFILE_BEGIN()
+#define PROFILE_MARK(stage)
+#define PROFILE_END()
+#endif
+
 // Neural Network Model - Real RTNeural implementation
-RTNeural::ModelT<float, 1, 1,
-    RTNeural::GRULayerT<float, 1, 9>,
-    RTNeural::DenseT<float, 9, 1>> model;
+// Banks per GRU size; only the 9-unit models exist so far. Add the other
+// sizes with tools/mars_model_gen.py and they become selectable tiers.
+const ModelBankSet modelBanks = {
+    nullptr, 0,
+    model_bank, model_bank_size,
+    nullptr, 0,
+    nullptr, 0,
+};
+// A bank in QSPI (make program-models) takes over from the one in
+// internal flash when its checksum is good
+#define MODEL_BANK_OFFSET 0x400000  // 4 MB in: above a BOOT_QSPI app
+#define IR_BANK_OFFSET 0x600000     // cabinet IRs, read at boot
+QspiModelBank qspiBank;
+StagedModelWeights stagedModel;     // main loop: QSPI -> idle slot
+bool modelStale = false;            // the bank changed under the active slot
+
+// What tools/hothouse_upload.py may write while the pedal runs (make UPLOAD=1)
+enum UploadSlots { UPLOAD_MODELS, UPLOAD_IRS, NUM_UPLOAD_SLOTS };
+const Hothouse::UploadSlot uploadSlots[NUM_UPLOAD_SLOTS] = {
+    {MODEL_BANK_OFFSET, IR_BANK_OFFSET - MODEL_BANK_OFFSET},
+    {IR_BANK_OFFSET, 0x100000},
+};
+ModelTierInfo modelTiers[NUM_MODEL_TIERS] = {{6, {}}, {9, {}}, {12, {}}, {16, {}}};
+
+// Two model slots: the callback runs the active one while the main loop loads
+// the next amp into the idle one, then the callback crossfades across.
+#define MODEL_FADE_SAMPLES 240  // 5 ms at 48 kHz
+AmpSlot HOTHOUSE_DTCM_BSS ampSlots[2];
+int activeModel = 0;                    // flipped by the callback only
+size_t modelFadePos = MODEL_FADE_SAMPLES;
+
+// Swap handshake. The main loop only touches the idle slot (and reads
+// activeModel) in MODEL_IDLE; the callback owns both slots otherwise.
+enum ModelSwapState { MODEL_IDLE, MODEL_LOADED, MODEL_FADING };
+std::atomic<int> modelSwapState{MODEL_IDLE};
+int selectedAmp = -1;                   // main loop: amp the switch asks for
+
+// CPU budget for model tiering. The callback measures its own cost minus the
+// model's, per delay/IR configuration, as a peak that decays over seconds.
+// The main loop then picks the largest tier that fits what's left.
+#define CPU_BUDGET 0.85f                // fraction of the block period
+#define CPU_LOAD_DECAY 0.999f           // per 256 samples, ~5 s
+float cyclesPerBlock = 1.0f;
+float cpuLoadDecay = CPU_LOAD_DECAY;    // per block at audioBlockSize
+volatile float otherLoad[4] = {0.5f, 0.5f, 0.5f, 0.5f}; // pessimistic until measured
+
+inline int loadConfig()
+{
+    return (delay_bypassed ? 0 : 1) | (dipValues[1] ? 2 : 0);
+}
+
+// Time each tier's forwardBlock() on the Seed, at each model rate, so the
+// selector works from real numbers. Runs before StartAudio, in a slot that
+// is not yet loaded.
+void measureModelTiers(AmpSlot& slot)
+{
+    enableCycleCounter();
+
+    for (size_t i = 0; i < AUDIO_BLOCK_SIZE; i++) {
+        modelIn[i] = 0.5f * sinf(i * 0.05f);
+    }
+    for (int tier = 0; tier < NUM_MODEL_TIERS; tier++) {
+        for (int rate = 0; rate < NUM_MODEL_RATES; rate++) {
+            slot.SetTierForMeasurement(tier, rate);
+            slot.ProcessBlock(modelIn, modelOut, AUDIO_BLOCK_SIZE); // warm caches
+            uint32_t start = cycleCount();
+            slot.ProcessBlock(modelIn, modelOut, AUDIO_BLOCK_SIZE);
+            modelTiers[tier].cyclesPerSample[rate] = (float)(cycleCount() - start) / AUDIO_BLOCK_SIZE;
+        }
+    }
+}
+
+// Copy an amp's weights from the QSPI or flash bank into a slot. Main loop
+// (or before StartAudio) only - model.reset() is not click-free.
+bool loadModel(int slot, int amp, int tier)
+{
+    if (!qspiBank.Valid())
+        return ampSlots[slot].Load(modelBanks, amp, tier);
+    if (!qspiBank.Stage(amp, tier, stagedModel))
+        return false;
+    ampSlots[slot].Load(stagedModel, amp, tier);
+    return true;
+}
+
+// The largest tier of amp that fits the CPU budget, from either bank
+int selectTier(int amp, const AmpSlot& active)
+{
+    if (qspiBank.Valid())
+        return selectModelTier(qspiBank, modelTiers, amp, active.Tier(), active.Rate(),
+                               otherLoad[loadConfig()], cyclesPerBlock, audioBlockSize, CPU_BUDGET);
+    return selectModelTier(modelBanks, modelTiers, amp, active.Tier(), active.Rate(),
+                           otherLoad[loadConfig()], cyclesPerBlock, audioBlockSize, CPU_BUDGET);
+}
+
+#ifdef MARS_PROFILE
+// Main loop: grabs the callback's stage stats every PROFILE_REPORT_MS and
+// prints min/avg/max cycles per block, and avg as a share of the block
+void serviceProfiler()
+{
+    static uint32_t lastReport = 0;
+    static bool pending = false;
+    uint32_t now = System::GetNow();
+    if (!pending) {
+        if (now - lastReport >= PROFILE_REPORT_MS) {
+            profiler.RequestSnapshot();
+            pending = true;
+        }
+        return;
+    }
+    if (!profiler.SnapshotReady())
+        return;
+    pending = false;
+    lastReport = now;
+
+    hw.seed.PrintLine("stage       min      avg      max   avg%% (blocks)");
+    uint32_t total = 0;
+    for (int i = 0; i < NUM_PROFILE_STAGES; i++) {
+        const StageStats& st = profiler.Snapshot(i);
+        uint32_t permille = (uint32_t)(st.Avg() * 1000.0f / cyclesPerBlock);
+        total += st.Avg();
+        hw.seed.PrintLine("%-8s %8u %8u %8u  %3u.%u (%u)", profileStageNames[i],
+                          (unsigned)(st.count ? st.min : 0), (unsigned)st.Avg(),
+                          (unsigned)st.max, (unsigned)(permille / 10),
+                          (unsigned)(permille % 10), (unsigned)st.count);
+    }
+    uint32_t permille = (uint32_t)(total * 1000.0f / cyclesPerBlock);
+    hw.seed.PrintLine("total             %8u        %3u.%u", (unsigned)total,
+                      (unsigned)(permille / 10), (unsigned)(permille % 10));
+}
+#endif
+
+// Main loop side of make IR_BLEND=1: mixes the pair the callback asked for
+// into the idle blend kernel once the last blend has faded in
+void serviceIrBlend()
+{
+    if (!IR_BLEND)
+        return;
+    const int pair = irBlendPair;
+    const float mix = irBlendMix.load(std::memory_order_relaxed);
+    if (pair == irBlendAppliedPair && mix == irBlendAppliedMix)
+        return;
+    const size_t count = ir_collection.size();
+    if (mIR.Blend(pair % count, (pair + 1) % count, mix)) {
+        irBlendAppliedPair = pair;
+        irBlendAppliedMix = mix;
+    }
+}
+
+// Main loop side of the model swap: follows TOGGLESWITCH_1 and the CPU budget
+void serviceModelSwap()
+{
+    // Wait for a pending or running crossfade before touching the idle slot
+    if (modelSwapState.load(std::memory_order_acquire) != MODEL_IDLE)
+        return;
+    if (selectedAmp < 0)
+        return;
+
+    const AmpSlot& active = ampSlots[activeModel];
+    int tier = selectTier(selectedAmp, active);
+    if (tier < 0 || (!modelStale && selectedAmp == active.Amp() && tier == active.Tier()))
+        return;
+    if (loadModel(1 - activeModel, selectedAmp, tier)) {
+        modelStale = false;
+        modelSwapState.store(MODEL_LOADED, std::memory_order_release);
+    }
+}
+
+// Main loop side of uploads: the flash bank stands in while the QSPI one is
+// rewritten (the slots keep what they hold), and a good new bank replaces
+// the current amp straight away
+void serviceUpload()
+{
+    int slot = -1;
+    switch (hw.ServiceUpload(&slot)) {
+        case Hothouse::UPLOAD_STARTED:
+            if (slot == UPLOAD_MODELS)
+                qspiBank.Clear();
+            break;
+        case Hothouse::UPLOAD_DONE:
+            if (slot == UPLOAD_MODELS) {
+                const bool valid = qspiBank.Init(hw.seed.qspi.GetData(MODEL_BANK_OFFSET));
+                hw.seed.PrintLine("model bank %s", valid ? "loaded" : "rejected");
+                modelStale = true;
+            } else {
+                // The IRs are prepared at boot only
+                hw.seed.PrintLine("IR bank written: power cycle to hear it");
+            }
+            break;
+        default:
+            break;
+    }
+}
 
 // Neural model selection - RESTORED ORIGINAL from Mars.cpp with Hothouse switch mapping
 void updateSwitch1() 
 {
     // Hothouse switch mapping: 0=UP, 1=MIDDLE, 2=DOWN
     // Original Mars used toggleValues[0] + 1 for model index
-    int modelIndex = toggleValues[0] + 1;
-
-    auto& gru = (model).template get<0>();
-    auto& dense = (model).template get<1>();
-    gru.setWVals(model_collection[modelIndex].rec_weight_ih_l0);
-    gru.setUVals(model_collection[modelIndex].rec_weight_hh_l0);
-    gru.setBVals(model_collection[modelIndex].rec_bias);
-    dense.setWeights(model_collection[modelIndex].lin_weight);
-    dense.setBias(model_collection[modelIndex].lin_bias.data());
-    model.reset();
-
-    // RESTORED: Original model level adjust without test multipliers
-    nnLevelAdjust = model_collection[modelIndex].levelAdjust;
+    // Weights are loaded by serviceModelSwap(), next in the same pass
+    selectedAmp = toggleValues[0] + 1;
 }
 
-// REPLICATED EXACTLY from original Mars
+// Same IR selection as original Mars, made by the callback (runCommand())
 void updateSwitch2() 
 {
     int irIndex = toggleValues[1];
-    mIR.Init(ir_collection[irIndex]);  // ir_data is from ir_data.h
+    if (IR_BLEND) {
+        irBlendPair = irIndex; // see serviceIrBlend()
+        return;
+    }
+    commands.Post(CMD_SELECT_IR, irIndex);
 }
 
-// REPLICATED EXACTLY from original Mars
+// REPLICATED EXACTLY from original Mars, made by the callback (runCommand())
 void updateSwitch3() 
 {
-    if (toggleValues[2] == 0) {
-        delay1.secondTapOn = false;
+    commands.Post(CMD_DELAY_PATTERN, toggleValues[2]);
+}
+
+// Main loop side of the toggles, ahead of serviceModelSwap(). A command only
+// fails to post with 15 waiting, which a pass's three can't reach.
+void serviceToggles()
+{
+    int newToggle1 = hw.GetToggleswitchPosition(Hothouse::TOGGLESWITCH_1);
+    int newToggle2 = hw.GetToggleswitchPosition(Hothouse::TOGGLESWITCH_2);
+    int newToggle3 = hw.GetToggleswitchPosition(Hothouse::TOGGLESWITCH_3);
+    
+    if (newToggle1 != toggleValues[0] || first_start) {
+        toggleValues[0] = newToggle1;
+        updateSwitch1(); // Update neural model
+    }
+    
+    if (newToggle2 != toggleValues[1] || first_start) {
+        toggleValues[1] = newToggle2;
+        updateSwitch2(); // Update IR
+    }
+    
+    if (newToggle3 != toggleValues[2] || first_start) {
+        toggleValues[2] = newToggle3;
+        updateSwitch3(); // Update delay mode
+    }
+    
+    first_start = false;
+}
 
-    } else if (toggleValues[2] == 2) {
-        delay1.secondTapOn = true;
-        delay1.del->set2ndTapFraction(0.6666667); // triplett
+// Callback side: what the toggles asked for, at the top of a block
+void runCommand(const Command& command)
+{
+    switch (command.type) {
+        case CMD_SELECT_IR: {
+            // All cabs are prepared at boot, so this is a pointer swap with
+            // a short crossfade - no allocation on the audio thread
+            const int irIndex = command.index;
+            if (STEREO_CAB) {
+                mIR.Select(irIndex, (irIndex + 1) % ir_collection.size());
+                break;
+            }
+            mIR.Select(irIndex);  // ir_data is from ir_data.h
+            break;
+        }
+        case CMD_DELAY_PATTERN: {
+            // Same taps as the original second tap modes:
+            // off, dotted eighth (0.75), triplett (0.6666667)
+            const DelayPattern& pattern = delayPatterns[command.index];
+            delay1.tapMultiple = pattern.multiple;
+            delay1.tapGain = pattern.gain;
+            delay1.numTaps = pattern.numTaps;
+            delay1.SetReverse(REVERSE_DELAY && command.index == 2);
+            break;
+        }
+    }
+}
 
+// The cab over buf in place, when the IR is on, and the gain to follow it.
+// right is where the right output reads: irRight, holding the second cab,
+// with make STEREO_CAB=1, and buf itself otherwise.
+inline float processCab(float* buf, const float*& right, size_t size)
+{
+    hw.Probe(probeCab, buf, size);
+    right = buf;
+    if (!dipValues[1])
+        return 1.0f;
+#if HOTHOUSE_NULL_TEST
+    // Compared except while the engines crossfade, which the reference
+    // doesn't, but run throughout so its history keeps up
+    const bool nullTest = !mIR.Fading();
+    mIR.ProcessReference(buf, irReference, size);
+#endif
+    if (STEREO_CAB) {
+        mIR.ProcessBlock(buf, buf, irRight, size);
+        right = irRight;
     } else {
-        delay1.secondTapOn = true;
-        delay1.del->set2ndTapFraction(0.75); // dotted eighth
-
+        mIR.ProcessBlock(buf, buf, size);
     }
+#if HOTHOUSE_NULL_TEST
+    if (nullTest)
+        hw.NullTest(irReference, buf, size);
+#endif
+    return 0.2f;
 }
 
 void UpdateLEDs() {
-    led1.Set(bypass ? 0.0f : 1.0f);
-    led2.Set(delay_bypassed ? 0.0f : 1.0f);  // NEW: Show delay state
-    led1.Update();
-    led2.Update();
+    hw.SetLed(Hothouse::LED_1, bypass ? 0.0f : 1.0f);
+    hw.SetLed(Hothouse::LED_2, hw.LoadLed(delay_bypassed || tempoFlash ? 0.0f : 1.0f));  // NEW: Show delay state
 }
 
 void ProcessControls() {
@@ -166,32 +887,19 @@ void ProcessControls() {
     
     // Apply cubic curve to filter knob for more natural response like original Mars.cpp
     float raw_filter = hw.GetKnobValue(Hothouse::KNOB_4);
-    knobValues[3] = raw_filter * raw_filter * raw_filter; // Cubic curve
+    knobValues[3] = KnobCube(raw_filter); // Cubic curve
+    if (IR_BLEND) {
+        // The knob is the cab blend; 0.5 is the low-pass wide open
+        if (hw.KnobChanged(Hothouse::KNOB_4))
+            irBlendMix.store(raw_filter, std::memory_order_relaxed);
+        knobValues[3] = 0.5f;
+    }
     
     knobValues[4] = hw.GetKnobValue(Hothouse::KNOB_5);  // Delay Time
     knobValues[5] = hw.GetKnobValue(Hothouse::KNOB_6);  // Delay Feedback
     
-    // Read toggle switches and update models if changed
-    int newToggle1 = hw.GetToggleswitchPosition(Hothouse::TOGGLESWITCH_1);
-    int newToggle2 = hw.GetToggleswitchPosition(Hothouse::TOGGLESWITCH_2);
-    int newToggle3 = hw.GetToggleswitchPosition(Hothouse::TOGGLESWITCH_3);
-    
-    if (newToggle1 != toggleValues[0] || first_start) {
-        toggleValues[0] = newToggle1;
-        updateSwitch1(); // Update neural model
-    }
-    
-    if (newToggle2 != toggleValues[1] || first_start) {
-        toggleValues[1] = newToggle2;
-        updateSwitch2(); // Update IR
-    }
-    
-    if (newToggle3 != toggleValues[2] || first_start) {
-        toggleValues[2] = newToggle3;
-        updateSwitch3(); // Update delay mode
-    }
-    
-    first_start = false;
+    // The cab and delay pattern the toggles picked (serviceToggles())
+    commands.Drain(COMMAND_BUDGET, runCommand);
     
     // MODIFIED delay control logic - NEW: FS2 controls enable only
     // delay is active when FS2 enables it (no knob threshold check)
@@ -199,6 +907,15 @@ void ProcessControls() {
 
     // MODIFIED: Linear scaling from 50ms to 1 second (2400 to 48000 samples)
     delay1.delayTarget = 2400 + knobValues[4] * 45600; // 50ms to 1000ms range
+    if (tapTempo.HasTempo()) {
+        float knobTravel = fabsf(knobValues[4] - tapKnobPosition);
+        if (knobTravel > TAP_KNOB_RELEASE) {
+            tapTempo.Clear();
+        } else {
+            float tapped = tapTempo.Period();
+            delay1.delayTarget = fclamp(tapped, 2400.0f, 48000.0f);
+        }
+    }
     
     /* Original 2-second delay code with two-range system:
     // From 0 to 75% knob is 0 to 1 second, 75% to 100% knob is 1 to 2 seconds
@@ -219,7 +936,20 @@ void ProcessControls() {
     
     delay1.feedback = knobValues[5];
     
-    mix_effects = knobValues[1];
+    // Calculate mix parameters - Modified for more gradual transition
+    // Only when K2 has moved; the gains hold in between
+    if (hw.KnobChanged(Hothouse::KNOB_2)) {
+        mix_effects = knobValues[1];
+        
+        // Apply curve to make wet signal come in more gradually
+        float curved_mix = mix_effects * mix_effects; // Square the mix for more gradual wet transition
+        
+        // The shared mix law (hothouse_mixlaw.h); wetParam and dryParam ramp
+        // the callback to it
+        const MixGains gains = MixLaw(curved_mix);
+        wet_gain = gains.wet;
+        dry_gain = gains.dry;
+    }
     
     // Read footswitches - PRESERVE EXACT FS1 functionality from working mars_hothouse.cpp
     if (hw.switches[Hothouse::FOOTSWITCH_1].RisingEdge()) {
@@ -227,119 +957,389 @@ void ProcessControls() {
     }
     
     // NEW: FS2 as delay enable/disable latch
+    // Quick repeat presses are tempo taps instead
     if (hw.switches[Hothouse::FOOTSWITCH_2].RisingEdge()) {
-        delay_bypassed = !delay_bypassed;
+        fs2_toggled_delay = false;
+        fs2_hold_handled = false;
+        if (tapTempo.Tap()) {
+            tapKnobPosition = knobValues[4];
+        } else {
+            delay_bypassed = !delay_bypassed;
+            fs2_toggled_delay = true;
+        }
+    }
+
+    // A long FS2 hold flips ping-pong instead, undoing the press's toggle
+    if (hw.switches[Hothouse::FOOTSWITCH_2].Pressed() && !fs2_hold_handled
+        && hw.switches[Hothouse::FOOTSWITCH_2].TimeHeldMs() >= PING_PONG_HOLD_MS) {
+        fs2_hold_handled = true;
+        ping_pong = !ping_pong;
+        if (fs2_toggled_delay) {
+            delay_bypassed = !delay_bypassed;
+        }
+        tapTempo.Clear();
     }
     
     UpdateLEDs();
 }
 
-void AudioCallback(AudioHandle::InputBuffer in, AudioHandle::OutputBuffer out, size_t size) {
+HOTHOUSE_ITCM void AudioCallback(AudioHandle::InputBuffer in, AudioHandle::OutputBuffer out, size_t size) {
+    const uint32_t callbackStart = cycleCount();
+    PROFILE_BEGIN();
     ProcessControls();
+    tempoEvents.Events(tapTempo, size, [](int id, size_t at) {
+        if (id == EventSchedulerBase::kBeat) {
+            tempoFlash = true;
+            tempoEvents.Cancel(TEMPO_FLASH_END);
+            tempoEvents.Post(tapTempo, at + TEMPO_FLASH_SAMPLES, TEMPO_FLASH_END);
+        } else {
+            tempoFlash = false;
+        }
+    });
+
+    // Idle model slot has been loaded by the main loop - start the crossfade
+    if (modelSwapState.load(std::memory_order_acquire) == MODEL_LOADED) {
+        if (!dipValues[0] || bypass) {
+            // Model not audible, nothing to fade
+            activeModel = 1 - activeModel;
+            modelSwapState.store(MODEL_IDLE, std::memory_order_release);
+        } else {
+            modelFadePos = 0;
+            modelSwapState.store(MODEL_FADING, std::memory_order_release);
+        }
+    } else if (modelSwapState.load(std::memory_order_acquire) == MODEL_FADING && !dipValues[0]) {
+        // Model switched off mid-fade - finish the swap immediately
+        activeModel = 1 - activeModel;
+        modelFadePos = MODEL_FADE_SAMPLES;
+        modelSwapState.store(MODEL_IDLE, std::memory_order_release);
+    }
     
-    // Calculate mix parameters - Modified for more gradual transition
-    // Apply curve to make wet signal come in more gradually
-    float curved_mix = mix_effects * mix_effects; // Square the mix for more gradual wet transition
-    
-    float x2 = 1.0 - curved_mix;
-    float A = curved_mix*x2;
-    float B = A * (1.0 + 1.4186 * A);
-    float C = B + curved_mix;
-    float D = B + x2;
-
-    float wetMix = C * C;
-    float dryMix = D * D;
-    
+    wetParam.SetTarget(wet_gain, size);
+    dryParam.SetTarget(dry_gain, size);
+
+    // Full CPU clock back before any DSP (make POWER_SAVE=1)
+    hw.SetBypassed(bypass);
+    if (bypass) {
+        // Bypass - just pass dry signal through
+        for (size_t i = 0; i < size; i++) {
+            out[0][i] = in[0][i];
+            out[1][i] = in[0][i];
+        }
+        PROFILE_MARK(STAGE_CONTROLS);
+        PROFILE_END();
+        return;
+    }
+    PROFILE_MARK(STAGE_CONTROLS);
+
+    const int current = activeModel;
+    const int incoming = 1 - current;
+    const bool fading = modelFadePos < MODEL_FADE_SAMPLES;
+
+    // Nothing to hear and nothing still ringing (see IDLE_OPEN). The knob
+    // ramps that aren't set yet pick up from where they were on the way out.
+    float inPeak = 0.0f;
+    float inSquares = 0.0f;
+    for (size_t i = 0; i < size; i++) {
+        inPeak = fmaxf(inPeak, fabsf(in[0][i]));
+        if (NOISE_GATE) {
+            inSquares += in[0][i] * in[0][i];
+        }
+    }
+    if (NOISE_GATE) {
+        noiseGate.Detect(inSquares / size, size);
+        if (noiseGate.Shut()) {
+            inPeak = 0.0f; // The block is muted before the model
+        }
+    }
+    if (!activity.Awake(inPeak) && !fading) {
+        if (!idleFlushed) {
+            mIR.Reset();
+            idleFlushed = true;
+        }
+        for (size_t i = 0; i < size; i++) {
+            out[0][i] = 0.0f;
+            out[1][i] = 0.0f;
+        }
+        delay1.Idle(size);
+        wetParam.Skip(size);
+        dryParam.Skip(size);
+        noiseGate.Skip(size);
+        PROFILE_END();
+        return;
+    }
+    idleFlushed = false;
+
+    // RESTORED: Original Mars.cpp baseline gain range (0.1 to 2.5). A
+    // conditioned model takes the knob as its second input instead, at
+    // unity gain; both slots share modelIn, so during a fade between the
+    // two kinds the incoming model gets the current one's input for 5 ms.
+    const bool conditioned = dipValues[0] && ampSlots[current].Conditioned();
+    gainParam.SetTarget(conditioned ? 1.0f : knobValues[0] * 2.4f + 0.1f, size); // Convert 0.0-1.0 to 0.1-2.5 range
+    if (NOISE_GATE) {
+        for (size_t i = 0; i < size; i++) {
+            modelIn[i] = in[0][i] * gainParam.Next() * noiseGate.Next();
+        }
+    } else {
+        for (size_t i = 0; i < size; i++) {
+            modelIn[i] = in[0][i] * gainParam.Next();
+        }
+    }
+    ampSlots[current].SetCondition(knobValues[0]);
+    if (fading) {
+        ampSlots[incoming].SetCondition(knobValues[0]);
+    }
+
+    // Filter coefficients only move with the knob, and then only every
+    // TONE_UPDATE_SAMPLES (plus at the end of the ramp and on a mode change)
+    bool toneMoving = filterParam.SetTarget(knobValues[3], size);
+    int toneCountdown = 0;
+
+    // Run the amp model(s) over the whole block: the GRU's input projection
+    // is batched, leaving only the recurrent part per sample
+    const uint32_t modelStart = cycleCount();
+    if (dipValues[0]) { // Neural model enabled
+        ampSlots[current].ProcessBlock(modelIn, modelOut, size);
+        if (fading) {
+            ampSlots[incoming].ProcessBlock(modelIn, modelNext, size);
+        }
+    }
+    const uint32_t modelCycles = cycleCount() - modelStart;
+    PROFILE_MARK(STAGE_MODEL);
+
     for (size_t i = 0; i < size; i++) {
-        float input = in[0][i];
-        float dry_signal = input; // Store clean dry signal
-        float wet_signal = input; // Process wet signal separately
+        float wet_signal;
+
+        if (dipValues[0]) { // Neural model enabled
+            wet_signal = modelOut[i] + modelIn[i]; // Add clean signal
+            wet_signal *= ampSlots[current].LevelAdjust(); // RESTORED: Simple level adjust from model
+
+            if (fading) {
+                float next = (modelNext[i] + modelIn[i]) * ampSlots[incoming].LevelAdjust();
+                if (modelFadePos < MODEL_FADE_SAMPLES) {
+                    // Crossfade into the newly loaded slot
+                    wet_signal += (next - wet_signal) * (modelFadePos * (1.0f / MODEL_FADE_SAMPLES));
+                    if (++modelFadePos == MODEL_FADE_SAMPLES) {
+                        activeModel = incoming;
+                        modelSwapState.store(MODEL_IDLE, std::memory_order_release);
+                    }
+                } else {
+                    wet_signal = next; // Fade finished earlier in this block
+                }
+            }
+        } else {
+            wet_signal = modelIn[i];
+        }
         
-        if (!bypass) {
-            // RESTORED: Original Mars.cpp baseline gain range (0.1 to 2.5)
-            float vgain = knobValues[0] * 2.4f + 0.1f; // Convert 0.0-1.0 to 0.1-2.5 range
-            float input_arr[1] = {wet_signal * vgain};
-            
-            if (dipValues[0]) { // Neural model enabled
-                wet_signal = model.forward(input_arr) + input_arr[0]; // Add clean signal
-                wet_signal *= nnLevelAdjust; // RESTORED: Simple level adjust from model
-            } else {
-                wet_signal = input_arr[0];
+        // ORIGINAL MARS.CPP FILTER PROCESSING - exactly like the original
+        // (Balance runs in its own pass below, on the same signals)
+        float filter_in = wet_signal;
+        modelOut[i] = filter_in;
+        
+        float vfilter = filterParam.Next(); // Use the cubic-curved filter value
+        if (toneMoving) {
+            if (--toneCountdown <= 0 || !filterParam.IsRamping()
+                || (vfilter <= 0.5f) != toneLowPass) {
+                setToneFreq(vfilter);
+                toneCountdown = TONE_UPDATE_SAMPLES;
+                toneMoving = filterParam.IsRamping();
             }
-            
-            // ORIGINAL MARS.CPP FILTER PROCESSING - exactly like the original
-            float filter_in = wet_signal;
-            float filter_out;
-            float balanced_out;
-            
-            float vfilter = knobValues[3]; // Use the cubic-curved filter value
-            if (vfilter <= 0.5f) {
-                // Low pass mode: 100Hz to ~20kHz like original
-                float filter_value = (vfilter * 39800.0f) + 100.0f;
-                tone.SetFreq(filter_value);
-                filter_out = tone.Process(filter_in);
-                balanced_out = bal.Process(filter_out, filter_in);
-            } else {
-                // High pass mode: 40Hz to 440Hz like original  
-                float filter_value = (vfilter - 0.5f) * 800.0f + 40.0f;
-                toneHP.SetFreq(filter_value);
-                filter_out = toneHP.Process(filter_in);
-                balanced_out = bal.Process(filter_out, filter_in);
+        }
+        if (vfilter <= 0.5f) {
+            delayIn[i] = tone.Process(filter_in);
+        } else {
+            delayIn[i] = toneHP.Process(filter_in);
+        }
+    }
+    PROFILE_MARK(STAGE_TONE);
+    hw.Probe(probeModel, modelOut, size);
+
+    // Stereo ping-pong, and the mono delay with make DELAY_POST_CAB=1, run
+    // the cab first, once, on the dry signal alone; otherwise the mono
+    // delay's repeats go through the cab with it
+    const bool cabFirst = ping_pong || DELAY_POST_CAB;
+
+    // Delay off and its tail gone: amp -> tone -> cab straight through, with
+    // no pass over the line or for the dry/wet mix (the dry gain is folded
+    // into the balance pass when the cab comes last)
+    const bool delaySilent = delay1.Silent();
+    bal.Analyse(delayIn, modelOut, size);
+    if (delaySilent && !cabFirst) {
+        for (size_t i = 0; i < size; i++) {
+            irBuffer[i] = delayIn[i] * bal.Next() * dryParam.Next();
+        }
+    } else {
+        for (size_t i = 0; i < size; i++) {
+            delayIn[i] *= bal.Next();
+        }
+    }
+    PROFILE_MARK(STAGE_BALANCE);
+
+    // Output level - MODIFIED: Increased from 0.4 to 0.5 for more output
+    levelParam.SetTarget(knobValues[2] * 0.5f, size); // Original: 0.4f
+
+    if (delaySilent && !cabFirst) {
+        delay1.Idle(size);
+        wetParam.Skip(size);
+        PROFILE_MARK(STAGE_DELAY);
+
+        const float* right;
+        const float ir_gain = processCab(irBuffer, right, size);
+        PROFILE_MARK(STAGE_IR);
+
+        for (size_t i = 0; i < size; i++) {
+            const float level = levelParam.Next();
+            out[0][i] = irBuffer[i] * ir_gain * level;
+            out[1][i] = right[i] * ir_gain * level;
+        }
+    } else if (cabFirst) {
+        // The delay repeats the cab's output, so the echoes of a long IR
+        // cost no more than the dry signal's one pass through it
+        // (with make STEREO_CAB=1 the echoes are the left cab's)
+        const float* right;
+        const float ir_gain = processCab(delayIn, right, size);
+        PROFILE_MARK(STAGE_IR);
+        if (delaySilent) {
+            delay1.Idle(size);
+            wetParam.Skip(size);
+            PROFILE_MARK(STAGE_DELAY);
+
+            for (size_t i = 0; i < size; i++) {
+                const float dryGain = dryParam.Next();
+                const float gain = ir_gain * levelParam.Next();
+                out[0][i] = delayIn[i] * dryGain * gain;
+                out[1][i] = right[i] * dryGain * gain;
             }
-            
-            // EXACT REPLICATION of Mars audio chain: Gain -> Neural Model -> Tone -> Delay -> IR
-            float delay_out = delay1.Process(balanced_out);   // Moved delay prior to IR
-            
-            // IMPULSE RESPONSE - EXACT REPLICATION from original Mars
-            float impulse_out = 0.0;
-            
-            if (dipValues[1]) // If IR is enabled by dip switch
-            {
-                impulse_out = mIR.Process(balanced_out * dryMix + delay_out * wetMix) * 0.2;  
-            } else {
-                impulse_out = balanced_out * dryMix + delay_out * wetMix; 
+        } else if (ping_pong) {
+            // Stereo: the delay splits the echoes across the outputs
+            delay1.ProcessPingPongBlock(delayIn, delayOut, delayOutR, size);
+            PROFILE_MARK(STAGE_DELAY);
+
+            for (size_t i = 0; i < size; i++) {
+                const float dryGain = dryParam.Next();
+                float wet = wetParam.Next();
+                float gain = ir_gain * levelParam.Next();
+                out[0][i] = (delayIn[i] * dryGain + delayOut[i] * wet) * gain;
+                out[1][i] = (right[i] * dryGain + delayOutR[i] * wet) * gain;
             }
-            
-            // Output level - MODIFIED: Increased from 0.4 to 0.5 for more output
-            float output = impulse_out * knobValues[2] * 0.5f; // Original: 0.4f
-            
-            out[0][i] = output;
-            out[1][i] = output; // Mono to stereo
         } else {
-            // Bypass - just pass dry signal through
-            out[0][i] = dry_signal;
-            out[1][i] = dry_signal;
+            delay1.ProcessMonoBlock(delayIn, delayOut, size);
+            PROFILE_MARK(STAGE_DELAY);
+
+            for (size_t i = 0; i < size; i++) {
+                const float dryGain = dryParam.Next();
+                float wet = wetParam.Next();
+                const float gain = ir_gain * levelParam.Next();
+                out[0][i] = (delayIn[i] * dryGain + delayOut[i] * wet) * gain;
+                out[1][i] = (right[i] * dryGain + delayOut[i] * wet) * gain;
+            }
+        }
+    } else {
+        // EXACT REPLICATION of Mars audio chain: Gain -> Neural Model -> Tone -> Delay -> IR
+        delay1.ProcessMonoBlock(delayIn, delayOut, size);   // Moved delay prior to IR
+        PROFILE_MARK(STAGE_DELAY);
+
+        // IR input is collected for the whole block and convolved below
+        for (size_t i = 0; i < size; i++) {
+            irBuffer[i] = delayIn[i] * dryParam.Next() + delayOut[i] * wetParam.Next();
         }
+
+        // IMPULSE RESPONSE - zero-latency partitioned convolution, same IR as original Mars
+        const float* right;
+        const float ir_gain = processCab(irBuffer, right, size); // If IR is enabled by dip switch
+        PROFILE_MARK(STAGE_IR);
+
+        for (size_t i = 0; i < size; i++) {
+            const float level = levelParam.Next();
+            out[0][i] = irBuffer[i] * ir_gain * level;
+            out[1][i] = right[i] * ir_gain * level; // Mono to stereo, or the right cab
+        }
+    }
+    PROFILE_MARK(STAGE_OUTPUT);
+
+    // The loudest of what's still sounding, for the idle gate; a delay tail
+    // or a model crossfade keeps it awake
+    float peak = inPeak;
+    for (size_t i = 0; i < size; i++) {
+        peak = fmaxf(peak, fmaxf(fabsf(out[0][i]), fabsf(out[1][i])));
     }
+    activity.Settle(delay1.Quiet() && !fading ? peak : 1.0f, size);
+
+    // Everything but the model, for the tier selector
+    const float load = (float)(cycleCount() - callbackStart - modelCycles) / cyclesPerBlock;
+    const int config = loadConfig();
+    const float decayed = otherLoad[config] * cpuLoadDecay;
+    otherLoad[config] = load > decayed ? load : decayed;
+    PROFILE_END();
 }
 
 int main(void) {
     // Initialize hardware using Hothouse library
     hw.Init(true); // CPU boost for performance
     
-    // Setup model weights FIRST
-    setupWeights();
-    
+    hw.SelectAudioProfile(audioProfiles); // 256 by default: performance optimization from Mars developer
+
     // Initialize audio processing objects
     float samplerate = hw.AudioSampleRate();
-    hw.SetAudioBlockSize(256); // Performance optimization from Mars developer
+
+    // FS2 held at power-up (SelectAudioProfile() has settled the switches):
+    // Low-Latency for this boot. Its hold must not also count as the
+    // ping-pong hold once audio starts.
+    if (hw.switches[Hothouse::FOOTSWITCH_2].Pressed()) {
+        hw.SetAudioBlockSize(audioProfiles.formats[Hothouse::AUDIO_PROFILE_LOW_LATENCY].block_size);
+        fs2_hold_handled = true;
+    }
+    audioBlockSize = hw.AudioBlockSize();
     
     tone.Init(samplerate);      // Low pass
     toneHP.Init(samplerate);    // High pass
     bal.Init(samplerate);       // Balance for volume correction
+
+    // Knob parameters start at the knob defaults below; the filter ignores
+    // changes under ADC noise so it isn't retuned every block
+    gainParam.Init(0.1f);
+    filterParam.Init(0.0f, 0.0001f);
+    wetParam.Init(0.0f);
+    dryParam.Init(1.0f);
+    levelParam.Init(0.0f);
+    setToneFreq(filterParam.Value());
     
+    // Prepare all cabinet IRs up front (direct-form head plus FFT tail: no
+    // added latency at any block size), from QSPI when a good bank is there
+    LoadQspiIrBank(hw.seed.qspi.GetData(IR_BANK_OFFSET), ir_collection.span());
+    const IrQuality& irLevel = irQuality[hw.GetQuality()];
+    mIR.SetPreprocessing(IR_MINIMUM_PHASE, irLevel.tailDb, irLevel.maxTaps);
+    mIR.SetBlending(IR_BLEND);
+    mIR.SetReference(HOTHOUSE_NULL_TEST);
+    const bool irsFit = mIR.InitBank(ir_collection.span(), irArena);
+    serviceIrBlend(); // the first blend plays from the first block, unfaded
+    hw.BootMark(irsFit ? "cabinet IRs" : "cabinet IRs, cut to fit IR_POOL_KB");
+
     // Initialize enhanced delay - EXACT REPLICATION from original Mars
-    delayLine.Init();
-    delay1.del = &delayLine;
+    delayLine = new (sdramArena.Carve<MarsDelayLine>()) MarsDelayLine;
+    delayLine->Init();
+    tapTempo.Init(48000.0f, 0.05f, 1.0f); // the delay time range
+    activity.Init(IDLE_OPEN, IDLE_CLOSE, IDLE_HOLD);
+    noiseGate.Init(samplerate, (float)MARS_GATE_DB);
+    probeModel = hw.AddProbe("model out", PROBE_FRAMES);
+    probeCab = hw.AddProbe("cab in", PROBE_FRAMES);
+    delay1.del = delayLine;
+    for (int i = 0; i < REVERSE_FADE; i++) {
+        reverseFade[i] = sinf((i + 0.5f) / REVERSE_FADE * (float)M_PI_2);
+    }
     delay1.delayTarget = 2400; // in samples
     delay1.feedback = 0.0;
     delay1.active = true;
+    if (DELAY_MOD) {
+        delay1.modDepth = (float)MARS_DELAY_MOD_MS * 0.001f * samplerate;
+        delay1.modStep = (float)MARS_DELAY_MOD_HZ / samplerate;
+    }
     
     // Initialize LEDs
     led1.Init(hw.seed.GetPin(Hothouse::LED_1), false);
     led2.Init(hw.seed.GetPin(Hothouse::LED_2), false);
     led1.Update();
     led2.Update();
+    hw.StartLedService();
     
     // Initialize default settings
     for(int i = 0; i < 6; i++) {
@@ -353,17 +1353,61 @@ int main(void) {
     }
     
     // Initialize first neural model and IR
-    first_start = true; // Will trigger all switch updates on first ProcessControls call
+    first_start = true; // Will trigger all switch updates on the first serviceToggles()
     
-    nnLevelAdjust = 1.0f;
+    // Time each model size, then the first amp goes straight into slot 0
+    // before audio starts
+    cyclesPerBlock = (float)SystemCoreClock * audioBlockSize / samplerate;
+    cpuLoadDecay = powf(CPU_LOAD_DECAY, (float)audioBlockSize / AUDIO_BLOCK_SIZE);
+    measureModelTiers(ampSlots[1]);
+    hw.BootMark("model tiers");
+    qspiBank.Init(hw.seed.qspi.GetData(MODEL_BANK_OFFSET));
+    hw.BootMark("QSPI models");
+    selectedAmp = toggleValues[0] + 1;
+    // A QSPI bank need not have every amp at GRU9
+    if (!loadModel(0, selectedAmp, TIER_GRU9))
+        loadModel(0, selectedAmp, selectTier(selectedAmp, ampSlots[0]));
+    hw.BootMark("amp model");
     mix_effects = 0.5f;
     bypass = true;
     delay_bypassed = true; // Start with delay off
     
     hw.StartAdc();
+#ifdef MARS_PROFILE
+    profiler.Init();
+    hw.StartLog(); // don't wait for a serial monitor
+#endif
+    hw.StartUpload(uploadSlots, NUM_UPLOAD_SLOTS);
+    // The delay's feedback loop, for make DENORMAL_CHECK=1
+    hw.WatchDenormals(delayLine->Buffer(), MAX_DELAY, "delay line");
+    // The toggles' cab and delay pattern play from the first block
+    serviceToggles();
     hw.StartAudio(AudioCallback);
     
     while(1) {
+        // CPU load over USB serial (make LOAD_METER=1)
+        hw.ServiceLoadMeter();
+        // Callback overruns over USB serial and into QSPI (make WATCHDOG=1)
+        hw.ServiceWatchdog();
+        // Time to each boot phase over USB serial (make BOOT_TIMING=1)
+        hw.ServiceBootTiming();
+        // Heap allocations inside the audio callback over USB serial (make ALLOC_CHECK=1)
+        hw.ServiceAllocCheck();
+        // Stack and heap high-water marks over USB serial (make MEMORY_REPORT=1)
+        hw.ServiceMemoryReport();
+        // Subnormals and NaNs in the callback and the delay (make DENORMAL_CHECK=1)
+        hw.ServiceDenormalCheck();
+        // Half the CPU clock after 5 s in bypass (make POWER_SAVE=1)
+        hw.ServicePower();
+        // Signal probes armed and dumped over USB serial (make PROBE=1)
+        hw.ServiceProbes();
+        // Round-trip latency through a loopback cable (make LATENCY_TEST=1)
+        hw.ServiceLatencyTest();
+        // The cab's FFT engine against its direct-form reference (make NULL_TEST=1)
+        hw.ServiceNullTest();
+        // The reports above as binary records over USB serial (make TELEMETRY=1)
+        hw.ServiceTelemetry();
+
         // Settings save functionality
         if(trigger_save) {
             // Save settings functionality - placeholder
@@ -371,9 +1415,22 @@ int main(void) {
             blink = 0;
         }
         
+        // The toggles: the amp for serviceModelSwap(), the rest as commands
+        serviceToggles();
+        // Load the next amp model into the idle slot when TOGGLESWITCH_1 moves
+        serviceModelSwap();
+        // The cab blend's kernel when Knob 4 or TOGGLESWITCH_2 moves (make IR_BLEND=1)
+        serviceIrBlend();
+        // Model and IR banks over USB serial into QSPI (make UPLOAD=1)
+        serviceUpload();
+
+#ifdef MARS_PROFILE
+        serviceProfiler();
+#endif
+
         // Hothouse DFU entry
         hw.CheckResetToBootloader();
         
-        System::Delay(10);
+        hw.IdleMs(10);
     }
 }
\ No newline at end of file
@@ -0,0 +1,598 @@
+// model_bank.h
+//
+// Generated by tools/mars_model_gen.py from all_model_data_gru9_4count.h - do not edit by hand.
+// One entry per amp, stored in flash; loadModelWeights() copies an
+// entry into a model slot.
+
+#pragma once
+
+#include "model_weights.h"
+
+static const GruModelWeights<9> model_bank[] = {
+  // Model1
+  {
+    {
+      0.0109456256f, -0.0501995608f, -0.0662443563f, -0.197680786f, 0.115832612f, -0.0633018166f,
+      -0.00300099724f, 0.0103316903f, 0.0466284156f, 0.0507833436f, -0.142395422f, -0.146307111f,
+      -0.0151847955f, 0.0256790817f, -0.144267023f, 0.066514954f, 0.127149522f, 0.132725433f,
+      -0.438175619f, -1.15510476f, -0.0379382633f, 0.82416451f, 0.842648447f, 0.810397267f,
+      -0.0162178166f, -1.3673923f, 0.839090765f
+    },
+    {
+      0.266058564f, -0.0639957711f, 0.119870618f, 0.110528514f, 0.20094873f, -0.20526126f,
+      -0.21146217f, -0.127543017f, 0.321905881f, 0.14035137f, -0.0755507499f, 0.214405462f,
+      0.411874354f, 0.00249691121f, 0.291783005f, 0.249953344f, -0.264836669f, -0.31749934f,
+      0.94550246f, 0.528075933f, -0.0697541535f, -0.543820024f, 0.309675634f, -0.077026993f,
+      0.743455648f, -0.741853774f, 0.291940868f, 0.203597233f, -0.00200752378f, 0.073135525f,
+      0.0840230063f, 0.0414540432f, -0.168399364f, 0.0602750219f, -0.106440723f, 0.173451841f,
+      0.287478387f, 0.169319496f, -0.00326223951f, 0.124297708f, 0.178103387f, 0.270585328f,
+      -0.174168974f, 0.0628218651f, 0.0829696655f, 0.0963274837f, 0.331215501f, -0.862822473f,
+      -1.29225647f, 0.0161515344f, 0.114612997f, 0.070126079f, -0.510430753f, 0.197503775f,
+      0.0978277773f, 0.0724848807f, -0.0573286824f, 0.20161517f, 0.230062619f, -0.014852698f,
+      -0.0975577161f, 0.0359028429f, 0.75905478f, 0.170878813f, 0.256320029f, 0.432595015f,
+      0.0164000727f, -0.0111614438f, 0.465299964f, -0.0863885656f, 0.168323934f, -0.991941452f,
+      -0.174485549f, -0.00198478252f, 0.610124588f, 0.558508098f, -0.0821216628f, -0.457420945f,
+      0.384179682f, 0.0052140737f, -0.480554432f, -0.0669398457f, -0.0567208529f, 0.369937837f,
+      -0.157046929f, -0.0539880134f, -0.0219629742f, 0.140425801f, 0.0249641873f, -0.297751665f,
+      0.168495163f, -0.010886373f, -0.0640933216f, -0.0541389026f, 0.19427681f, 0.497659832f,
+      0.593319833f, -0.354180157f, 0.656356692f, 0.0511266924f, 0.738736808f, -1.27116442f,
+      1.16266704f, -0.0972769186f, -0.846038699f, -0.729422629f, 0.426753402f, -0.320494771f,
+      0.230806053f, -0.0238523092f, 0.0614176393f, -0.089785859f, 0.000801320653f, 0.00159675942f,
+      0.108818397f, 0.0335799754f, 0.268731922f, -0.225355893f, -0.115102932f, 0.039818082f,
+      -0.0775083825f, 0.262064189f, -0.203971028f, 0.253113747f, -0.461275339f, 0.189196944f,
+      -0.677782059f, -0.0140944617f, 0.102914199f, 0.732902348f, 1.21144676f, -0.223943859f,
+      -0.178402558f, -0.251025081f, -0.332417548f, 0.0104351677f, 0.00153519679f, -0.11401131f,
+      0.109412953f, -0.202544644f, 0.0684436858f, 0.19721657f, -0.0424503535f, 1.10217118f,
+      0.5912655f, 0.156796023f, -0.257555872f, -0.0980051979f, -0.235416621f, -0.566710591f,
+      -0.317136645f, 0.884737492f, -0.0442158766f, -0.0474378727f, 0.706316471f, 0.270787239f,
+      0.0864746049f, 0.080970563f, 0.808155119f, -0.716889799f, 0.611864209f, -0.391359359f,
+      -0.153964743f, 0.0874485895f, -0.0562915504f, 0.136326954f, -0.124125041f, -0.0442376882f,
+      -0.334623694f, 0.0418414734f, -0.248188287f, 0.0898040533f, 0.0857249871f, 0.139202833f,
+      -0.0226452202f, 0.044136107f, 0.0873771757f, 0.17118299f, 0.155964538f, -0.0323211066f,
+      -0.161450282f, 0.201616749f, 0.85013932f, 0.203256547f, 0.111833505f, 0.600090981f,
+      0.87530601f, 0.07564044f, -0.515285969f, -0.488535225f, 0.147876695f, 0.0538307503f,
+      0.327599674f, -0.350467056f, 0.244041026f, 0.163336173f, 0.115756869f, -1.18965316f,
+      -0.00101650774f, 0.120978557f, -0.0784419402f, -0.546715856f, -0.188923344f, -0.0322633013f,
+      -0.520766497f, 0.619560778f, -0.0709491298f, -0.364379972f, -0.0625691414f, 0.345190436f,
+      -0.445450336f, -0.395232171f, 0.101447396f, -0.153879598f, 0.0522647537f, 0.826281369f,
+      -0.0866785496f, 0.0740108937f, -0.0981657058f, 0.0133342072f, 0.0917799771f, 0.184257612f,
+      0.288609952f, 0.0173417293f, 0.0585216507f, 0.343151718f, 0.165457472f, -0.627173185f,
+      -0.222906575f, -0.180571124f, -0.129363343f, -0.729658127f, 0.455151647f, -0.0448735505f,
+      -0.457283765f, -0.190846324f, -0.208466306f, -0.269412458f, 0.0866464153f, 0.920874894f,
+      0.0808780417f, 0.870459437f, 1.33293688f
+    },
+    {
+      1.19733799f, -0.441063851f, -0.136443004f, -0.349004149f, 1.32616436f, -0.380979061f,
+      0.1921231f, -0.245786548f, 1.45489371f, 0.342791289f, 0.303622425f, 0.31173557f,
+      0.536028326f, -0.0185523294f, 0.310692012f, 0.039811641f, -0.0714878961f, 0.0704501867f,
+      -0.313759893f, 0.0645053387f, 0.0797731876f, 0.0582866371f, -0.143768489f, 0.270438462f,
+      -0.211529866f, -0.287789643f, 0.265193671f, 1.19733799f, -0.441063851f, -0.136443004f,
+      -0.349004149f, 1.32616425f, -0.380979061f, 0.1921231f, -0.245786548f, 1.45489371f,
+      0.340667546f, 0.303819597f, 0.311753511f, 0.536015511f, -0.0179911405f, 0.310652524f,
+      0.0398116112f, -0.0711226165f, 0.0759136453f, 0.440811187f, 0.131897122f, 0.218704224f,
+      -0.0401345044f, 0.084607929f, -0.194800183f, -0.175500557f, 0.0427135341f, -0.542842984f
+    },
+    {
+      -0.155254588f, 0.531542361f, 0.85221827f, 0.0223868191f, 0.193098798f, -0.518962562f,
+      0.580614448f, 0.372578591f, 0.545688689f
+    },
+    {
+      0.0696733668f
+    },
+    0.9f,
+    MODEL_RATE_NATIVE,
+  },
+  // Model2
+  {
+    {
+      -0.029231837f, -0.314975113f, -0.563101351f, 0.639793575f, -0.0338146463f, 0.63982439f,
+      -0.229034558f, 0.155758679f, -0.303478837f, 0.0831606612f, 0.403277934f, -0.109851941f,
+      -0.0464772955f, 0.0662308037f, 0.332742363f, 0.512588084f, 0.549773335f, 1.32908654f,
+      -0.405244112f, -0.297264963f, 0.575496554f, 0.446924269f, -0.624207973f, 0.815628171f,
+      -0.206623331f, -1.00479937f, -1.37579989f
+    },
+    {
+      0.105137907f, 0.128290012f, 0.28980875f, -0.166713074f, -0.0362373367f, 0.216489911f,
+      -0.533916712f, -0.229375884f, -0.255442023f, 0.437829614f, 0.720209301f, -0.343620062f,
+      -0.0398776755f, 0.241717964f, 0.317976385f, -0.080936648f, -0.159232512f, -0.875554264f,
+      1.03150833f, 0.208634421f, 0.250126839f, -0.420739651f, 0.613702476f, -0.345243305f,
+      -0.113907315f, 0.105974346f, 0.11947415f, 0.439651132f, 0.738184929f, 0.0336837918f,
+      1.03029883f, 0.275138885f, 0.483715177f, -1.62293971f, -0.316229522f, -0.486331254f,
+      0.480945647f, -0.0382721499f, 0.117687039f, 0.307861537f, -0.403594315f, -0.188170061f,
+      -0.0477090441f, 0.648142576f, -0.459953815f, -0.198864505f, 0.570436716f, -0.520209312f,
+      0.305695564f, -0.12838459f, -0.668569267f, 0.169497833f, 0.892137527f, 0.664804101f,
+      -0.182901308f, 0.688149393f, -0.804647028f, -0.0994800255f, 0.437473357f, -0.379691362f,
+      -0.162293091f, -0.224321976f, 0.430120021f, -0.333268225f, 0.10536667f, -0.259795308f,
+      0.0723564252f, -0.235948101f, 0.247715965f, -0.16564849f, -0.110065505f, 0.27747187f,
+      -0.301724523f, -0.579265356f, 1.02078354f, -0.594949245f, -0.205875501f, -0.972468138f,
+      0.412370026f, 0.641659558f, 0.946154058f, 0.474824876f, -0.165234894f, -1.024773f,
+      -0.443834782f, -0.0416200235f, 0.684329271f, 0.546149552f, 0.103653155f, -0.127914011f,
+      0.158048779f, 0.224111155f, 0.307237655f, 0.400680631f, -0.170621693f, -0.244242474f,
+      1.14468217f, -0.333818525f, 1.318892f, -0.0196936708f, 0.791359782f, 0.923246622f,
+      0.867813885f, -0.111847505f, 0.906672895f, -1.64183092f, 1.60464215f, -0.103459068f,
+      0.70010376f, -0.074117437f, -0.00417931471f, -0.0386531539f, -0.0460720994f, -0.368826717f,
+      0.199992448f, 0.0379176289f, 0.81132412f, 0.115602881f, -0.211475343f, -0.128360227f,
+      0.136926219f, 0.0635546669f, -0.509558976f, -0.565167367f, -0.12227162f, 0.92993927f,
+      -0.78766799f, -0.278734267f, 0.304595202f, 0.29840672f, 1.03091741f, 0.257545739f,
+      0.129098311f, -0.0811610818f, -0.407726258f, 0.223801121f, -0.224970907f, 0.586419702f,
+      0.132437572f, 0.480564237f, 0.579595685f, 0.830131233f, 0.0739465207f, -0.0625538006f,
+      0.411091506f, -0.345773041f, 0.404758751f, -0.30109033f, 0.182509184f, -0.0751647204f,
+      -0.958082438f, -0.609105408f, -0.651473403f, -0.331384867f, 0.241735443f, -0.00375384185f,
+      -0.666522145f, -0.10173104f, 1.00946677f, 0.14701046f, -0.186035171f, -0.0641657487f,
+      -0.287945479f, 0.0339794457f, -0.7389341f, 0.679588318f, -0.221665174f, -0.675908506f,
+      -0.433752388f, -0.0662119761f, 0.432670146f, -0.247907668f, 0.225084245f, -0.0201333743f,
+      0.455315918f, 0.415836334f, 0.459986031f, -0.645589232f, 0.120360233f, -0.548229992f,
+      -0.416108578f, 0.0551449917f, 0.551798224f, 0.934627891f, -0.445437938f, 0.136051834f,
+      0.619976521f, 0.514609456f, 0.0534862988f, 0.13508442f, 1.00495505f, -0.891232729f,
+      -0.205944017f, 0.282577604f, 0.360721558f, -0.517747462f, -0.739807963f, -0.217309445f,
+      0.0585078336f, 0.680151463f, 0.0534048043f, 0.29021585f, 0.161451653f, 0.155947506f,
+      0.566714644f, -0.173039064f, 0.144464225f, -0.753710508f, 0.358981043f, -0.10597229f,
+      -1.45619214f, -0.712764561f, -0.29424414f, 0.873897135f, -0.369514525f, -0.618404329f,
+      0.0748396665f, -0.357241333f, -0.13003917f, 0.0369219519f, 0.433108032f, 0.660352826f,
+      0.83668834f, 0.0383233912f, -0.29808709f, 0.202168956f, 0.0864171535f, -0.278232813f,
+      -0.847605169f, -0.212797955f, 0.0954169333f, -0.249041781f, -1.14159477f, -1.59322166f,
+      -0.355726182f, -1.60100985f, -0.629410148f, 0.612585366f, -0.0756887197f, -0.878345549f,
+      0.256775826f, -0.766708195f, 1.31505167f
+    },
+    {
+      1.6665622f, 0.119001001f, 1.03007209f, -0.66484648f, 1.80636215f, 0.296627909f,
+      0.146217614f, -0.651759863f, -0.808475018f, 0.248170793f, 0.304416358f, 0.194738209f,
+      0.557522953f, -0.0104267476f, 0.304237366f, 0.307384551f, 0.393295079f, 0.419560492f,
+      -0.09829548f, -0.0466092676f, -0.0527991429f, -0.108337954f, -0.0716700554f, -0.126675144f,
+      -0.162835374f, 0.509842992f, 0.782419443f, 1.6665622f, 0.119001001f, 1.03007209f,
+      -0.66484648f, 1.80636215f, 0.296627909f, 0.146217614f, -0.651759863f, -0.808475018f,
+      0.248121664f, 0.304416388f, 0.194738209f, 0.557522953f, -0.0104210936f, 0.304237366f,
+      0.307384551f, 0.393295079f, 0.419562548f, 0.331410229f, -0.14917393f, -0.0616357476f,
+      0.436130732f, 0.158433124f, 0.343175888f, 0.297191381f, -0.688363433f, -1.09451568f
+    },
+    {
+      1.32665122f, 0.34957096f, 0.501087487f, 0.218910724f, 1.22714353f, 0.436084688f,
+      1.0895592f, 0.700987577f, 0.630840003f
+    },
+    {
+      -0.315319419f
+    },
+    0.9f,
+    MODEL_RATE_NATIVE,
+  },
+  // Model3
+  {
+    {
+      0.104446627f, -0.250969499f, -0.188594922f, 0.129058942f, -0.0213624258f, -0.016602397f,
+      -0.0292903017f, -0.0575075969f, 0.166468039f, -0.0162067339f, 0.471586436f, -0.310528636f,
+      0.495690584f, -0.058964882f, -0.482476473f, -0.176118478f, 0.292909533f, -0.0550245568f,
+      -0.747768342f, -0.744980693f, -0.0873179212f, -0.347881496f, 0.106164604f, 0.340911508f,
+      0.497520715f, -1.42788792f, -0.0452627465f
+    },
+    {
+      0.115256615f, 0.658914387f, 0.163081199f, -0.447367013f, -0.0318933874f, -0.147955731f,
+      0.182534158f, -0.0808000714f, -0.978837311f, -0.314214498f, -0.0949195698f, -0.0558125563f,
+      0.0163706522f, -0.119135156f, 1.12041426f, -0.038380906f, 0.127009585f, -0.760981262f,
+      1.40286779f, 0.646432519f, 0.081620276f, 0.0505477712f, 0.0648351908f, 0.683743238f,
+      2.15355849f, -0.658321261f, 0.413732827f, 0.10434746f, -0.0727228746f, 0.181754798f,
+      -0.0759267509f, -0.250637025f, 0.112845026f, 0.176502898f, 0.1625036f, -0.329397708f,
+      -0.114988305f, 0.0248476043f, 0.16434291f, -0.0887207091f, -0.053185761f, 0.161145031f,
+      -0.00226108241f, -0.435522854f, 0.11316967f, -1.33306289f, 0.72181946f, -0.0242201649f,
+      -1.2629354f, -0.0401307233f, 0.0534174889f, 0.133676574f, -1.3404125f, 0.175510526f,
+      -0.166184112f, 0.043520581f, 0.179794505f, -0.174407557f, 0.550454438f, -0.13181217f,
+      -0.105649695f, -0.0844117031f, -0.313066632f, -0.0590974763f, 0.644970715f, -0.0443186797f,
+      0.174132049f, -0.0146641219f, 0.11083924f, 0.145969123f, 0.0526273586f, -0.306008816f,
+      -0.209455654f, 0.0150165446f, 0.31757766f, -0.0171451904f, 0.456059605f, -0.329958081f,
+      0.121782295f, 0.29139474f, -0.500669777f, 0.150232822f, 0.144128248f, -0.0566932671f,
+      0.0704083815f, -0.877252638f, -0.0130598815f, 0.0648178756f, 0.0426741242f, 0.584210694f,
+      -0.382250696f, -0.0913465917f, -0.169351876f, -0.258894056f, -0.0920218155f, 0.491701066f,
+      -0.225786746f, 0.218763411f, -0.101429276f, 0.801667154f, 0.644176543f, -0.280757457f,
+      0.909585059f, 0.320640951f, 0.202670008f, 0.130184233f, 0.123095199f, -0.204508215f,
+      0.208320603f, -0.955281496f, -0.353631854f, 0.0336663052f, -1.8303231f, 0.263248891f,
+      0.370735317f, 0.390209496f, -0.167547002f, -0.477036864f, 0.12975581f, -0.362631857f,
+      -0.425904453f, -0.481055319f, -0.378970653f, -0.478426576f, -0.214849755f, 0.0594928488f,
+      -0.830016732f, 0.0807391778f, -0.0445493981f, 0.836161315f, 1.61894691f, 0.0567285381f,
+      -0.253994167f, -0.782527089f, -0.00472668232f, 1.01916409f, -1.34728754f, 0.0992054716f,
+      0.0995548591f, -0.634179711f, 0.110432789f, 0.338523448f, 0.25816685f, 0.51767987f,
+      -0.659607053f, 0.51197958f, 0.309075117f, 0.0327837095f, -0.166094139f, -0.262306601f,
+      -0.461156249f, 0.114279479f, 0.260009885f, -0.0770837441f, 0.573129773f, 0.0290943161f,
+      -0.072731331f, -0.860140145f, 0.412338853f, -0.562958658f, 0.16659078f, -0.140737489f,
+      0.375095069f, 0.148788914f, -0.118589498f, 0.0708783194f, 0.273503661f, -0.177163884f,
+      -0.0930786729f, 0.116135277f, -0.439528733f, -0.00884266477f, -0.167233929f, 0.315373152f,
+      -0.0352019109f, -0.267498195f, 0.298668444f, -0.214572638f, -0.0755997226f, -0.291344225f,
+      -0.0763213933f, 0.164380342f, 0.695358515f, -0.0231053587f, 0.714884937f, 0.380770981f,
+      1.22704661f, 0.118787497f, -0.239428669f, 0.111365147f, -0.147778332f, -0.507855475f,
+      -0.113838084f, -0.151430681f, 0.0112789031f, 0.021976022f, -0.00587422773f, -0.16607669f,
+      0.0227447711f, -0.0985950455f, 0.390905529f, -0.234914243f, 0.0843939483f, -0.0667531341f,
+      0.162624598f, -0.150213033f, -0.268226296f, 1.2526989f, 0.347753972f, 0.154934481f,
+      0.211437017f, 0.0060297912f, -0.0349152535f, -0.684530854f, -0.0621946715f, 0.636715412f,
+      0.406575471f, -0.806515992f, -0.374168277f, -0.0358839966f, -1.5064218f, 0.280410469f,
+      0.489118874f, 0.431284249f, 0.0359278247f, -0.394398004f, 0.269463629f, -0.170815155f,
+      -0.0426373146f, -0.163568601f, -0.107776113f, -0.43658641f, -0.0546165071f, -0.574971318f,
+      -0.270747483f, -0.061987903f, -0.973074734f, 0.131537229f, 0.405704886f, 1.37502849f,
+      0.153876603f, 0.42597571f, 1.19438231f
+    },
+    {
+      -0.280418664f, 1.2571044f, 0.640375137f, 0.0869015157f, 1.49343085f, -0.350288153f,
+      -0.491430014f, -0.489565611f, 1.1014632f, 0.452047974f, -0.0224744398f, -0.0486013405f,
+      0.366519958f, 0.372282237f, 0.216630742f, 0.575315595f, 0.157957852f, 0.369207561f,
+      -0.832354128f, -0.0396727733f, -0.14219135f, 0.18015331f, -0.231135324f, 0.462703824f,
+      -0.188758373f, -0.406743228f, 0.162670657f, -0.280418664f, 1.2571044f, 0.640375137f,
+      0.0869015157f, 1.49342871f, -0.350288153f, -0.491430014f, -0.489565611f, 1.1014632f,
+      0.447535723f, -0.0214341115f, -0.048551172f, 0.366266936f, 0.373296559f, 0.21644415f,
+      0.575315475f, 0.158663735f, 0.377394557f, -0.132557571f, -0.00436691614f, -0.00989230908f,
+      0.0577459186f, 0.0242834724f, 0.038800437f, -0.136393949f, -0.038072791f, -0.881664634f
+    },
+    {
+      0.0655515417f, 0.585723341f, 1.19938207f, -0.0191059392f, -0.32549417f, -0.183850437f,
+      0.266968817f, 0.72222352f, 0.286511987f
+    },
+    {
+      -0.312558204f
+    },
+    0.6f,
+    MODEL_RATE_NATIVE,
+  },
+  // Model4
+  {
+    {
+      0.28144303f, -0.106011227f, -0.0494509935f, 0.0748564899f, -0.69610548f, -0.491081297f,
+      -0.27184844f, -0.016275242f, -0.0374501497f, 0.347433448f, 0.211707473f, 0.229964748f,
+      -0.33109352f, 0.0809400231f, 0.762524545f, -1.29078627f, -0.205131009f, -0.106521256f,
+      0.13559933f, -0.283384591f, -0.126162857f, 0.906647205f, 0.0143740159f, 2.10029268f,
+      -0.851601601f, 0.066241771f, 0.344731957f
+    },
+    {
+      -0.477672517f, 0.126498297f, 0.0611235946f, 0.176771656f, 0.338376194f, 0.135219768f,
+      -0.0130082769f, -0.211732641f, -0.123942778f, -0.557887912f, -0.287225157f, 0.0145839797f,
+      0.0511850081f, -0.36074841f, 0.0128153088f, -0.14097175f, 0.240386009f, -0.186992347f,
+      0.793600917f, 0.131572172f, -0.093441017f, 0.419518709f, -1.34142268f, -0.395348996f,
+      -0.59386158f, -0.286875486f, 0.245920688f, 0.242029697f, -0.296129704f, -0.289248824f,
+      -1.00125897f, -0.170168027f, 0.637908936f, 0.222673342f, 0.195624143f, 0.0167798717f,
+      -0.162523776f, 1.64347696f, -0.962237f, -0.752854288f, 0.0208736025f, 0.158116311f,
+      0.447101414f, -0.132458195f, 0.166385949f, -1.22163141f, -0.676461875f, -1.90001917f,
+      0.00844232738f, -1.87194371f, 0.132484674f, 0.275368571f, -0.279247195f, -0.0228485353f,
+      -0.100482658f, 0.0163553432f, 0.867294669f, 0.444327235f, 0.336809397f, 0.329206139f,
+      -0.0592413954f, -0.120176397f, -0.0696669519f, -0.0226768516f, -0.0863412246f, -0.505117953f,
+      -2.07061052f, -0.515424013f, 0.0105482731f, -0.0167708658f, -0.199480668f, 0.238146022f,
+      0.0227481388f, 0.0975970924f, 0.729842603f, -2.2698319f, 0.0618654825f, 0.00469835754f,
+      -0.0219047181f, -0.0412519611f, 0.0188163631f, -0.191364154f, -0.23815757f, 0.688881993f,
+      0.765627086f, -0.0663577244f, 0.358808666f, -0.0329631604f, -0.242183074f, 0.00180601317f,
+      0.119845271f, 0.136270717f, -1.38606358f, 1.32704389f, -0.0195442792f, -0.00354412152f,
+      -0.0793373212f, 0.103436299f, 0.275927961f, 0.0704187974f, -0.0967166275f, 0.211264908f,
+      0.958653986f, -0.0410254933f, 0.00134163175f, -0.000531333033f, 0.00709042512f, -0.299138159f,
+      0.100091957f, 0.516963363f, -0.00159734348f, -1.217875f, 1.27794826f, -0.683658183f,
+      -0.0938052535f, 0.0236780606f, -0.0625782311f, 0.050804697f, -1.15889108f, -1.78106475f,
+      -0.0747906864f, -0.154287905f, -0.0552906618f, -0.10945873f, -0.117091388f, -0.00278812135f,
+      0.734259367f, 1.21735525f, -1.09944308f, 0.49081105f, 2.21810603f, -0.067924127f,
+      -0.174451351f, 0.195774764f, 0.0786248222f, 0.402848125f, -1.24464834f, -0.339769423f,
+      0.221914798f, -0.341000021f, -0.521801353f, -0.022151785f, 0.255901247f, -0.0655051768f,
+      -0.274706125f, -0.905608535f, -0.793561459f, 0.233611867f, 0.50940311f, -0.0570615195f,
+      -1.29309285f, 0.0523061492f, -0.120749675f, 0.53553462f, -1.52868164f, -1.0710783f,
+      -0.99314487f, 2.09952116f, 1.00131893f, -0.377792925f, 0.313164592f, 0.009836643f,
+      0.0688194111f, -0.47228384f, 0.0358646736f, 0.189720511f, -0.570900679f, 0.621207178f,
+      -0.066789858f, 0.135421559f, -0.313386321f, -0.142456964f, -0.189308017f, -0.0274182465f,
+      -0.6684829f, -0.209257871f, -0.179606393f, 1.03269351f, 0.000789289246f, 0.101868227f,
+      0.507687867f, -1.31915045f, -0.326855451f, 0.766776502f, 1.72465503f, 3.57520151f,
+      0.349448234f, 0.35607186f, 0.386121571f, -0.269637227f, 0.130614758f, -0.0420653261f,
+      0.123503059f, 0.0433010608f, -0.124734312f, 0.295578331f, -0.179173559f, -0.269760102f,
+      0.367821753f, 0.0200232528f, 0.394654721f, 0.0410390496f, -0.0627461448f, -0.102224097f,
+      0.259052187f, -0.325470448f, -0.246964023f, 0.0568520091f, 0.12636517f, 0.354600012f,
+      0.11819493f, 0.0408229418f, -0.392990172f, -0.430782825f, 1.2384212f, -0.777241468f,
+      -0.220195442f, 0.36120978f, -0.0559145361f, 0.259412915f, 0.235866889f, 0.168593302f,
+      -0.102932461f, 0.05688335f, -0.195371002f, 0.148421556f, 0.139884338f, -0.081132099f,
+      0.272066116f, -0.103659257f, 0.0411997102f, -0.00394635415f, -0.150925264f, 0.176668495f,
+      -0.523984194f, 0.0482188985f, 0.457837373f, 0.214462399f, 0.186749548f, -0.103561543f,
+      -0.186192945f, 0.574992001f, 1.16403008f
+    },
+    {
+      1.45445561f, 0.31164521f, 0.202336162f, -0.778313339f, 0.147406429f, -0.375092685f,
+      1.22657025f, 1.54530168f, 1.5517385f, -0.0994311199f, 0.762778044f, 0.616753936f,
+      0.468105316f, 0.833440661f, 0.311965376f, -0.90860945f, 0.408703774f, 0.302391201f,
+      -0.043290861f, -1.01187015f, 0.102044299f, 0.601478338f, -0.312832147f, 0.0165386237f,
+      -0.156302825f, -0.0594613887f, -0.0317533463f, 1.45446861f, 0.31164521f, 0.202336162f,
+      -0.778313339f, 0.147406429f, -0.375092685f, 1.22657061f, 1.54530168f, 1.55173588f,
+      -0.0994408727f, 0.762808383f, 0.616753936f, 0.468105316f, 0.833440661f, 0.311965376f,
+      -0.908610046f, 0.408703774f, 0.302391201f, -0.183427572f, 1.41531646f, -0.0321670994f,
+      -0.611919522f, 0.345510542f, 0.40002346f, -0.544246852f, 0.0277052f, 0.00627399469f
+    },
+    {
+      0.559700608f, 0.0560219735f, 0.0378725901f, -0.529668808f, 0.0404868387f, -0.345439613f,
+      0.607227564f, -1.17466569f, -1.31164885f
+    },
+    {
+      -0.00995217636f
+    },
+    0.6f,
+    MODEL_RATE_NATIVE,
+  },
+  // Model5
+  {
+    {
+      -0.0126164751f, -0.723537207f, -0.434736282f, 0.189215302f, -0.0814475119f, 0.0362601727f,
+      -0.655219197f, 0.22501792f, -0.212576777f, -0.108408242f, 0.313587785f, 0.143321961f,
+      0.561232805f, 0.121995628f, 0.24716419f, 0.0481656268f, -0.192760795f, -0.0703943223f,
+      -0.0219118036f, -0.691119313f, -0.0361182317f, 1.12404954f, -0.240107134f, 0.380968004f,
+      -0.0646501854f, -0.0444941223f, -0.870363832f
+    },
+    {
+      -0.0687302724f, -0.16898948f, -0.0444570892f, -0.0578559525f, 0.183348596f, -0.0689929053f,
+      -0.0213480424f, -0.0811334401f, 0.354127467f, -0.171016768f, 0.432921886f, -0.0114904754f,
+      -0.24853231f, 0.018187739f, 0.172472522f, -0.232324183f, 0.516465902f, -0.291074127f,
+      1.25299883f, 0.530044675f, 0.78369391f, -0.341640919f, 0.970866382f, -0.0037755603f,
+      -0.0401384868f, -0.194624737f, -0.448427498f, 0.229915798f, -0.000834335922f, 0.255938858f,
+      0.028850494f, -0.340605587f, 0.330239028f, -0.187819064f, -0.193214342f, -0.828454375f,
+      0.417531461f, -0.110703655f, -0.0501038842f, -0.657353818f, -0.00794151612f, 0.151602641f,
+      -0.404865324f, 0.0619697943f, 0.312223703f, 0.0159839969f, 1.13041747f, -0.114141971f,
+      0.716947317f, 0.403450787f, -0.10171397f, 0.603225529f, 1.22702229f, 0.970217586f,
+      -0.182422325f, 0.0243638121f, -0.372411668f, -0.177906141f, 0.424140364f, 0.197820768f,
+      0.208669037f, 0.226817921f, 0.321577102f, -0.35450381f, -0.19558987f, -0.106556796f,
+      -0.243508711f, 0.320238411f, 0.40031597f, 0.547112048f, 0.715087652f, 0.0389872566f,
+      -0.15817f, 0.541344821f, 0.832139373f, -0.788387775f, -0.020647753f, -0.613005817f,
+      0.337830186f, 0.0800128803f, 0.591826677f, 0.171128899f, 0.613021314f, 0.275306791f,
+      0.00675264839f, 0.187620804f, 0.103557013f, -0.113314494f, 0.205725357f, -0.472736895f,
+      0.524718344f, -0.139952898f, 0.000475488458f, 0.0963535458f, -0.0956728756f, 0.13437438f,
+      -0.153374806f, 0.554061651f, -0.157054543f, -0.196792498f, 0.818427503f, 0.13392742f,
+      0.140582308f, 0.494437546f, -0.555016875f, -0.739676893f, 1.69545412f, -0.932230532f,
+      -0.0236686766f, 0.675629735f, -0.0544197485f, -0.0887993276f, 0.0692159608f, -0.0372347459f,
+      -0.528113127f, 0.056799259f, -0.213592798f, -0.120005347f, 0.241373152f, 0.253563046f,
+      0.675753891f, 0.239911571f, 0.00612068549f, 0.128733829f, -0.326580733f, -0.152072445f,
+      -0.991577625f, -0.0480924919f, -0.161161304f, 0.0118163116f, 0.976834774f, 0.924131036f,
+      0.265941769f, -0.168200016f, -0.571212113f, -0.155753404f, 0.841037512f, 0.581961691f,
+      1.15503824f, -0.245654345f, 0.453461528f, -0.461469471f, 0.269529998f, -0.347008646f,
+      -0.328959316f, -0.59371084f, -0.363379478f, -0.0725900978f, -1.08297706f, -0.0397131518f,
+      -0.231740713f, 1.45287454f, -0.109111182f, -0.0613702983f, -0.245867997f, 1.06289327f,
+      0.396222979f, -0.0313079096f, 1.44961262f, -0.560914755f, -0.0471826605f, 0.805204213f,
+      0.0471483506f, 0.405414283f, 0.544199646f, -0.456290394f, 0.46958074f, -0.165374205f,
+      0.253908873f, -0.220264226f, -0.08087679f, -0.0838101432f, -0.733892143f, 0.0768012255f,
+      -0.26547575f, 0.0358285233f, -0.0456581786f, -0.306037337f, 1.82922173f, 0.314868122f,
+      0.0284937527f, 0.20961076f, 0.0423173569f, 1.12311018f, -0.556485057f, 0.677868485f,
+      0.684996724f, 0.723325193f, -0.582906365f, 0.351412892f, 0.235984489f, -0.414454281f,
+      -0.24126485f, 0.18743442f, 0.0515099876f, 0.4099935f, -0.952641726f, 0.0298750009f,
+      0.0474947356f, 0.118415125f, 0.433919698f, -0.52491349f, -0.125532433f, 0.19548969f,
+      -0.904071808f, -1.0007534f, 0.505568445f, -0.472009271f, 0.218818635f, -0.580838442f,
+      -0.790595353f, -0.20507282f, -0.101059183f, 0.441633642f, 0.149427131f, -0.59027344f,
+      -0.12655957f, -0.697498322f, -0.589733362f, -0.563142002f, -0.0809899941f, 0.290951967f,
+      0.0236581508f, 0.812310159f, 0.132411078f, -0.318636328f, 0.0556888394f, -0.147638336f,
+      -0.202358633f, -0.440017313f, -0.0879287273f, 0.178684071f, -0.0895303637f, -0.142565951f,
+      -0.356792897f, -1.00560009f, -0.585497558f, 0.871910691f, 0.696998179f, -1.66796875f,
+      0.671403468f, 0.00810359977f, 0.271553665f
+    },
+    {
+      2.10897994f, 1.91476119f, 1.55106378f, -0.72537756f, 1.7663995f, -0.907953024f,
+      0.580938399f, -0.825870395f, -0.501969278f, 0.367373824f, 0.348158658f, 0.524152875f,
+      0.142859921f, 0.35320431f, 0.718585074f, 0.147665888f, -0.117544793f, 0.415721864f,
+      -0.118466437f, -0.0883982107f, 0.000395273644f, -0.0651460811f, 0.00971335545f, -0.371837497f,
+      -0.000677733624f, 0.137744755f, 0.379290253f, 2.10897994f, 1.91476119f, 1.55106378f,
+      -0.72537756f, 1.7663995f, -0.907953024f, 0.580938399f, -0.825870395f, -0.501969278f,
+      0.367218882f, 0.348158717f, 0.524152935f, 0.142859921f, 0.353248745f, 0.718585074f,
+      0.147665888f, -0.117544703f, 0.415727526f, 0.35338062f, -0.192494825f, 0.0328818858f,
+      0.496575087f, 0.144618124f, 0.180223376f, 0.350624204f, 0.163384587f, -0.0913025364f
+    },
+    {
+      0.143534333f, -0.0921499133f, 0.159034729f, -0.705510616f, 2.08550024f, 0.310897201f,
+      0.57531786f, 0.769676983f, 0.886979342f
+    },
+    {
+      -0.263851553f
+    },
+    1.7f,
+    MODEL_RATE_NATIVE,
+  },
+  // Model6
+  {
+    {
+      -0.0552828312f, -0.0303519517f, -0.156695589f, -0.0157077797f, 0.172643036f, 0.0273597576f,
+      0.108952627f, -0.0591386147f, 0.0588542521f, -0.0677040517f, -0.131665483f, -0.0541447215f,
+      -0.230606049f, 0.061530333f, -0.0301787797f, 0.361401439f, -0.0212173462f, 0.0811628401f,
+      0.372036487f, 0.47551173f, -0.11820589f, -0.538638473f, -0.400458336f, 2.25368237f,
+      0.749717534f, -0.284280717f, -0.783293962f
+    },
+    {
+      0.159956709f, -0.149140671f, -0.278900206f, -0.00216999906f, 0.396303445f, 0.0453632846f,
+      0.0613252744f, -0.306396097f, -0.0210074093f, -0.0369076803f, 0.0601867437f, -0.220500916f,
+      0.392377228f, 0.0767143741f, -0.0249298364f, -0.529892385f, -0.458842844f, -0.365249097f,
+      0.544535279f, 0.866570473f, -0.177193522f, -0.0672718063f, 0.22730723f, -0.0609338284f,
+      0.493569613f, -0.545018733f, 0.275261015f, -0.089526169f, -0.0391488671f, 0.161684796f,
+      0.139401764f, 0.223679021f, 0.00937219337f, 0.00393088628f, -0.0748490021f, -0.0209953599f,
+      -0.15763244f, -0.0117549142f, 0.222540021f, -0.402721167f, 0.086943239f, -0.256671369f,
+      -0.298672944f, -0.574546576f, -0.151967496f, 0.0608020574f, 0.59417963f, 0.818788707f,
+      0.0439909361f, 0.331946105f, 0.143067107f, -0.0733324587f, -1.06927359f, 1.1513387f,
+      -0.000183133758f, -0.0537539981f, 0.0403737426f, -0.0592578575f, -0.0708822086f, -0.0344942957f,
+      0.0195547603f, 0.135075927f, 0.122690678f, 0.0398071967f, 0.0410750285f, -0.0193124134f,
+      -0.190115824f, 0.302181035f, -0.0227422919f, 0.696895838f, 0.90354228f, 0.35674271f,
+      -0.13775228f, -0.53961134f, 0.858443677f, -1.11927414f, 0.283462912f, -1.47561872f,
+      -0.229170829f, 0.732323468f, -0.470462292f, -0.261699885f, -0.0632440969f, -0.0222425088f,
+      -0.128252015f, 0.0225451086f, -0.0826490894f, -0.013395559f, 0.14305383f, 0.0416606218f,
+      -0.474040747f, 0.146807596f, -0.337575227f, 0.163906723f, 0.260861486f, -0.129359543f,
+      0.46763736f, 0.957446098f, 0.337459624f, -0.961372316f, 0.273943573f, -0.0206631534f,
+      0.976826608f, -0.229220957f, -0.0470949188f, -0.328988612f, 0.950282693f, -0.17629838f,
+      -0.131620467f, 0.543434203f, -0.168969542f, -0.190104306f, 0.262363374f, -0.0544900447f,
+      0.0186367929f, -0.221093565f, 0.0564323142f, -0.0707328171f, 0.0923284441f, 0.160855934f,
+      1.08595467f, -0.0756617263f, 0.226701587f, 0.167069912f, 0.197614938f, -0.00647723675f,
+      0.0443067029f, 0.0325788334f, 0.307156324f, 0.431964517f, 1.41017151f, 0.514819086f,
+      0.286928117f, -0.186510563f, -0.328823328f, -0.118816815f, 0.076478906f, -0.150075063f,
+      0.11532826f, -0.0817328095f, 0.116181985f, 0.0761234537f, -0.0121271964f, 0.15218471f,
+      -0.134848267f, -0.163309917f, -0.195068941f, -0.0977259129f, 0.182093099f, -0.0495669097f,
+      0.376959592f, 0.394725949f, 0.0831248611f, -0.0694548115f, 0.276453882f, 0.986134529f,
+      2.24193835f, -0.333717465f, 0.296825439f, -0.820609212f, 0.374823302f, 0.686525524f,
+      -0.0521499626f, -0.00653244089f, -0.0686461255f, -0.174527809f, 0.0645582899f, -0.0460203402f,
+      0.0408577435f, -0.0694478154f, 0.0198501088f, -0.0427773818f, -0.00392973796f, -0.52292949f,
+      0.146305442f, -0.145244539f, 0.0159070734f, 0.0661555007f, -0.621452808f, -0.295085132f,
+      -0.128678605f, -0.0227450598f, 0.155575112f, -0.00979858544f, -0.0470678061f, 0.14802447f,
+      1.23906815f, -0.183817551f, 0.195340618f, 0.0566792004f, -0.0283050574f, 0.0317825079f,
+      -0.0957466513f, -0.178077757f, -0.226657033f, -0.353435785f, 0.414415658f, -0.0948027298f,
+      0.456829816f, 0.0137341712f, 0.436718374f, 0.168077499f, -0.0479209013f, -0.00855620019f,
+      -0.22920014f, -0.40071094f, -0.332277566f, -0.263145953f, 0.166245043f, -0.223658472f,
+      -0.230466977f, 0.0126468278f, -0.300769717f, 0.800475299f, 0.481565714f, -0.062922895f,
+      -0.176811799f, 0.3178671f, -0.0230848864f, 0.0790752321f, 0.0421777628f, 0.0698257908f,
+      0.0682860315f, -0.194914594f, -0.0848790482f, -0.235983208f, -0.136421666f, 0.435824394f,
+      -0.11376588f, 0.0532091744f, -0.0550463237f, -0.383477777f, -1.22334588f, -0.305055737f,
+      0.345384151f, 0.367833734f, -0.455562413f, 0.452437043f, -0.0587837659f, -1.02666783f,
+      0.740256786f, -0.790271819f, 0.562697053f
+    },
+    {
+      1.47910905f, 0.887225211f, 1.25550508f, -0.627305984f, 2.05304766f, -0.820261776f,
+      -0.66214931f, -0.252347171f, -0.0486859567f, 0.158968046f, 0.140545428f, 0.101580232f,
+      0.637849092f, 0.166203767f, 0.335805923f, 0.22175993f, 0.230024695f, 0.439404488f,
+      -0.230896831f, 0.0279499013f, 0.0072412272f, 0.0153154237f, -0.0476416722f, -0.105482437f,
+      -0.118196905f, 0.0839938596f, 0.332063466f, 1.47910905f, 0.887225211f, 1.25550508f,
+      -0.627305984f, 2.05304766f, -0.820261776f, -0.66214931f, -0.252347171f, -0.0486859567f,
+      0.157232478f, 0.14055647f, 0.101582341f, 0.637849092f, 0.16658558f, 0.335805804f,
+      0.22175993f, 0.230025858f, 0.439599186f, 0.543600678f, -0.135302842f, 0.10029082f,
+      0.18212758f, 0.109469667f, 0.13357313f, 0.0303215701f, -0.0734775364f, -0.414947838f
+    },
+    {
+      -0.358781725f, -0.351436883f, 0.043856658f, 0.0955764279f, 0.352441281f, -0.504110396f,
+      0.671960592f, 1.45681322f, 0.565117776f
+    },
+    {
+      -0.395571172f
+    },
+    0.8f,
+    MODEL_RATE_NATIVE,
+  },
+  // Model7
+  {
+    {
+      -0.10029491f, 0.395394087f, -0.00391264213f, 0.157817155f, 0.300698578f, -0.130506903f,
+      0.159090862f, 0.197677791f, -0.1487692f, 0.0108374543f, 0.0831207857f, 0.0108587183f,
+      -0.122139305f, 0.138055518f, 0.00292878668f, 0.12726815f, -0.0471984968f, 0.121160351f,
+      2.0872612f, 2.83267355f, -0.954853714f, -0.158958152f, 0.104189254f, 0.344746888f,
+      -0.348426819f, 0.408458471f, -0.331808239f
+    },
+    {
+      0.27985388f, 0.411023825f, -0.0218433663f, -0.02696288f, -0.074506104f, -0.101193868f,
+      0.556922555f, 0.0511434004f, 0.0213590637f, 0.146129712f, 0.112261027f, -0.154002741f,
+      -0.333068997f, 0.0147917038f, 0.218841657f, 0.168436661f, -0.342186272f, 0.217816636f,
+      0.545655131f, 2.01993418f, 0.253951162f, 0.662376881f, -0.166763067f, 0.659358323f,
+      -0.0290652011f, 1.46917784f, -0.802428961f, 0.615313232f, -0.778285205f, -0.0889442638f,
+      0.0412324332f, -0.097483024f, 0.0173721351f, -0.178826943f, -0.438280582f, 0.034553431f,
+      -0.184432536f, 0.119792737f, 0.362022787f, -0.342938334f, 0.320855141f, -0.217254475f,
+      0.253219098f, 0.213211402f, -0.159200713f, -0.341962159f, 1.34501708f, -0.41629988f,
+      -0.0583973713f, 0.149802849f, 0.208869785f, 0.0988620892f, 3.28222966f, 0.0420742296f,
+      0.190997705f, 0.456974298f, 0.105075449f, -0.0859191492f, -0.404361814f, -0.220174238f,
+      -0.145383149f, 0.28232488f, -0.193160772f, 0.0928067341f, -0.350445062f, -0.0085853124f,
+      -0.26311779f, -0.345065743f, 0.120118484f, 0.0844358578f, -0.806748152f, 0.103969768f,
+      -0.246003494f, -0.467187613f, 0.303542972f, -0.367602438f, -0.109362744f, -0.308698952f,
+      0.376369298f, -0.19903484f, 0.285855472f, -0.137298331f, -0.112464085f, 0.0242035501f,
+      0.0354418233f, 0.0154023767f, -0.113445558f, 0.234649941f, 0.012833057f, 0.0069774366f,
+      -0.0768288895f, 0.00923875719f, -0.105151281f, 0.350240588f, 0.260075778f, -0.0251130275f,
+      -0.0781363249f, 1.21205187f, -0.0661402792f, -0.163528517f, 0.0340743177f, -0.373339683f,
+      1.21408987f, 0.0671117753f, -0.190135166f, 0.12513043f, -0.140137672f, -0.220618665f,
+      -0.0983766988f, -0.0729671493f, 0.0741542578f, 0.122493871f, 0.190596476f, -0.278647095f,
+      -0.179986224f, -0.0587153323f, 0.152346343f, -0.320494741f, 0.166450873f, -0.142257556f,
+      0.155469969f, 0.285621583f, 0.389241606f, -0.547540784f, 0.603976488f, 0.669295609f,
+      -0.0730236992f, -0.216064751f, -0.381459445f, 0.676742911f, 1.14905882f, 0.231417328f,
+      -0.388143569f, -0.33432439f, 0.0298352577f, 0.103647836f, 0.205247074f, -0.123789988f,
+      0.0932300463f, 0.584714293f, -0.114674129f, -0.19085516f, 0.202093735f, -0.0863840878f,
+      0.0177662913f, -0.156257167f, 0.0758134276f, 0.189724296f, 0.25511688f, 0.293990046f,
+      -0.299101174f, -0.101649344f, -0.0428599641f, -0.841886759f, -0.834880233f, 0.525172472f,
+      0.505258083f, 0.126046702f, 1.04331422f, 0.384372741f, -0.309321493f, -0.197167873f,
+      0.33046186f, 0.476729363f, -0.162577778f, 0.196376339f, 0.29898411f, 0.0717639253f,
+      0.115050204f, 0.425765961f, 0.0863594934f, 0.325061858f, -0.128324255f, 0.113055691f,
+      -0.214222014f, 0.245680526f, 0.243071631f, 0.146138728f, -0.563464701f, -0.0567809269f,
+      0.564624608f, -0.0471145324f, -0.0398030691f, 0.0685255229f, -0.284129947f, -0.031454917f,
+      1.29885352f, -0.354232997f, -0.289705813f, 0.275134146f, -0.285626262f, -0.0165554509f,
+      -0.148929462f, -0.0550010651f, -0.00684992317f, 0.00631210068f, 0.187395364f, -0.101837479f,
+      0.0778672621f, -0.115635157f, -0.0208397731f, 0.0259959325f, -0.0793602541f, 0.185069099f,
+      -0.100479424f, -0.173548296f, -0.223057315f, 0.142440587f, -0.228789598f, 0.2304793f,
+      0.426667303f, 0.0278161727f, -0.35252282f, 0.0160325114f, 0.347723633f, -0.381764799f,
+      -0.333333433f, -0.607589781f, 0.0169765167f, -0.378978431f, -0.193455413f, 0.149247408f,
+      0.277827978f, -0.527170956f, 0.387477875f, 0.120286793f, 0.35273537f, 0.367030114f,
+      0.442663014f, -0.0433517657f, -0.0759375021f, -0.157445922f, 0.337022424f, -0.205045387f,
+      0.989329875f, 0.581856728f, -0.369112372f, 1.00187421f, -0.391546786f, -0.483379066f,
+      0.0253923256f, -0.327578962f, 0.350668818f
+    },
+    {
+      -0.657005668f, -0.762525976f, -0.493540138f, 0.388261795f, 1.66786885f, 1.1328665f,
+      0.72267741f, -0.653907657f, 1.16444337f, 0.438555032f, 0.796263695f, 0.10724996f,
+      0.363343328f, 0.253002137f, 0.172764689f, 0.220747367f, 0.574567914f, 0.115062699f,
+      -0.120870583f, -0.224382043f, -0.122057833f, -0.333001792f, 0.124138683f, -0.0705911666f,
+      0.0641389489f, -0.215344459f, 0.156318292f, -0.657005668f, -0.762525976f, -0.493540138f,
+      0.388259679f, 1.6726284f, 1.13374138f, 0.72267741f, -0.653907657f, 1.16280818f,
+      0.437868655f, 0.796522915f, 0.0956799164f, 0.365065157f, 0.247095972f, 0.133867219f,
+      0.220558703f, 0.57456851f, 0.0557293557f, -0.147508189f, 0.0516595021f, -0.189976275f,
+      0.0985448509f, -0.213811263f, 0.107948229f, -0.0904212818f, 0.134936348f, 0.0911572427f
+    },
+    {
+      -0.215711489f, 0.0093361428f, 1.10463357f, 0.778875053f, -0.726875722f, 0.00825044978f,
+      -0.15866594f, 0.574669957f, 0.743559241f
+    },
+    {
+      0.131188035f
+    },
+    0.6f,
+    MODEL_RATE_NATIVE,
+  },
+  // Model8
+  {
+    {
+      -0.196230426f, -0.135532677f, -0.277019382f, -0.0266403593f, -0.327736139f, -0.0324443914f,
+      -0.198386714f, -0.0342036895f, 0.0745152906f, -0.155469477f, -0.00159309013f, -0.142461523f,
+      -0.316454321f, 0.0927135795f, 0.283207566f, -0.161820546f, 0.0384720676f, -0.148725376f,
+      0.426477075f, -0.929056942f, 0.333395183f, 0.362504363f, 2.99384499f, 3.26085544f,
+      -1.0870775f, -0.00846020877f, 0.161079451f
+    },
+    {
+      -0.0275245924f, 0.221972436f, -1.13921404f, -0.40788582f, -0.471722722f, -0.113441765f,
+      0.728490114f, 0.20500049f, -0.0418597534f, 0.318030596f, 0.371609509f, 0.0520178825f,
+      0.0120752007f, 0.299347013f, 0.260729253f, -0.0406568088f, 0.100758359f, 0.0304473676f,
+      0.795777202f, -0.161383837f, 1.05728388f, -0.571035206f, -1.63803327f, -1.26851952f,
+      0.796970308f, 0.0130825285f, 0.0509879515f, 0.903144538f, -0.651195407f, 0.136823803f,
+      -0.516999006f, -1.44594705f, 0.493289918f, 0.90795958f, 0.011867445f, 0.00337080145f,
+      0.164045393f, 1.48944783f, -0.37607488f, 0.798892379f, -1.12193596f, -0.0711074099f,
+      0.722258389f, -0.010381924f, 0.150666401f, -0.144602537f, -1.0689894f, -0.261078835f,
+      -0.434808373f, -2.31944609f, 0.477178633f, 0.72594142f, -0.067098923f, 0.0426498018f,
+      0.322962254f, -0.0720037222f, 0.142092794f, -0.176968694f, -0.130509108f, -0.12933369f,
+      0.206731901f, 0.341403842f, 0.122228146f, 0.105616815f, -0.0798742324f, 0.6149351f,
+      -0.236094356f, 0.14508234f, 0.0439538658f, -0.277646899f, 0.410435975f, 0.110530511f,
+      -0.0364856981f, 0.151374608f, 1.21778774f, -0.701095939f, 0.0804211721f, -3.82863618e-05f,
+      -0.0266674273f, 0.216726705f, -0.342120916f, 0.265117735f, -0.592440248f, 0.32092765f,
+      -0.190191969f, -0.527856588f, -0.50449568f, 0.184849709f, 0.213354453f, 0.248907149f,
+      0.322092772f, -0.136111945f, -0.360277444f, -0.0519326217f, 0.391909271f, 0.0822751448f,
+      -0.426826924f, 0.0585555173f, 0.429693073f, 0.216635466f, 0.325033069f, 0.0941050351f,
+      0.112391673f, 0.0020896981f, 0.0605490245f, 0.113454454f, 0.384746194f, -0.381460637f,
+      0.12650995f, 0.0859326944f, -0.214399457f, 0.130204797f, -1.7263695f, -1.72697735f,
+      0.0199870225f, 0.114454359f, -0.0736286715f, 0.369085193f, -2.46543717f, -1.29246497f,
+      0.262273043f, -0.652370393f, 0.35532707f, -0.227170482f, 0.0854207501f, -0.270774841f,
+      0.810350418f, 1.96312153f, -2.5850296f, 1.54725897f, 2.97501111f, -0.42874366f,
+      -0.395413756f, -0.0324619971f, -0.0229530074f, 0.264704704f, -0.221585631f, 0.00287306891f,
+      -0.341096014f, -0.759273767f, -0.577795088f, 0.336038291f, -0.0999384373f, -0.0568114482f,
+      -0.287303686f, -0.440621495f, 0.17392391f, 0.489802331f, -0.306952327f, 0.319823802f,
+      0.652545869f, 0.0639131069f, 0.0240676869f, 0.660423398f, -0.384189695f, 0.80029273f,
+      -0.267936379f, 3.40216732f, -0.441981167f, -1.18518853f, 0.148074076f, -0.0797110125f,
+      0.01752319f, 0.183747485f, -0.715828776f, -0.0268641654f, -0.674651444f, -0.332101375f,
+      0.427918851f, -0.00950390752f, -0.0272202268f, 0.318412304f, -0.480598986f, 0.283029199f,
+      -0.516830623f, -0.0543038845f, -0.0949492455f, 0.126727208f, -0.0116102789f, 0.0403278992f,
+      0.610201716f, -0.706667125f, 0.0213270318f, 0.419881076f, 1.9918592f, 3.45912457f,
+      0.694690645f, -0.0223447736f, 0.170476869f, -0.136627764f, -0.0176834073f, -0.204072118f,
+      0.133077458f, -0.0280803517f, 0.00451979274f, 0.217280716f, -0.0276023634f, 0.0441052839f,
+      -0.304671764f, 0.0170589499f, -0.0461338274f, 0.196095422f, -0.218619436f, -0.611420631f,
+      -0.426493704f, 0.247001693f, -0.00568070682f, 0.221704796f, 0.0645762756f, -0.262010276f,
+      -0.0502308048f, -0.218631983f, -0.292251259f, 0.124026552f, 1.14200366f, -0.96281147f,
+      0.0335350111f, -0.0497369468f, 0.161718458f, 0.23875986f, -0.0700955465f, 0.0520989932f,
+      -0.218758315f, 0.127481163f, 0.111533582f, 0.1338429f, 0.154917821f, -1.91084933f,
+      -0.696523488f, 0.129690245f, -0.00251656631f, 0.226010293f, 0.212234542f, 0.148536518f,
+      -0.51695329f, -0.22295399f, 0.345964789f, 0.203440905f, -0.0140629243f, -0.136757985f,
+      -0.100227386f, 0.662987232f, 1.44776332f
+    },
+    {
+      2.06099415f, -0.63993293f, -0.0886448622f, 0.208268538f, -0.997073293f, -0.738999903f,
+      1.65988684f, 1.95785105f, 1.62682247f, 0.173249319f, 0.897287309f, 0.910692215f,
+      0.213853389f, 1.11835051f, 0.816517532f, -0.195228592f, 0.219318867f, 0.50944078f,
+      0.202620536f, -1.27914464f, 0.370319754f, 0.516049445f, -0.141403615f, 0.0862674564f,
+      -0.0478124358f, -0.111919738f, 0.125306711f, 2.06103563f, -0.63993293f, -0.0886448622f,
+      0.208268538f, -0.997073293f, -0.738999903f, 1.65988982f, 1.95785105f, 1.6267966f,
+      0.173232511f, 0.897436023f, 0.910693288f, 0.213853568f, 1.11835051f, 0.816517532f,
+      -0.195229709f, 0.219318718f, 0.509440064f, -0.178014994f, 1.18537474f, -0.499533594f,
+      -0.0701850429f, 0.597527564f, 0.430961877f, -0.223619804f, -0.0378983766f, -0.00890500285f
+    },
+    {
+      -0.184923559f, 0.157819733f, -0.912308037f, -1.24651849f, 0.054371886f, -0.318064123f,
+      0.828551352f, -0.388924927f, -0.966518044f
+    },
+    {
+      0.722012401f
+    },
+    0.5f,
+    MODEL_RATE_NATIVE,
+  },
+};
+
+static constexpr int model_bank_size = sizeof(model_bank) / sizeof(model_bank[0]);
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "model_tiers.h"
+
+// An amp model bank in QSPI flash, written there separately from the
+// firmware (tools/mars_model_gen.py --blob, then make program-models or,
+// with make UPLOAD=1, tools/hothouse_upload.py while it runs), so
+// the number of amps and sizes isn't bounded by internal flash.
+//
+// The blob is a header, a directory of entries and their weights, all
+// little-endian and 8-byte aligned:
+//
+//   QspiBankHeader                      magic, version, counts, checksum
+//   QspiBankEntry[count]                amp, hidden size, where its data is
+//   GruModelWeights<hiddenSize> ...     each exactly as the struct lays out,
+//                                       at entry.offset from the header
+//
+// QSPI is memory-mapped, so the directory is read in place; the main loop
+// copies one entry at a time into SRAM (Stage()) before loading it into a
+// slot, and the audio callback never reads QSPI.
+
+static constexpr uint32_t QSPI_BANK_MAGIC = 0x4B42524Du;  // "MRBK"
+static constexpr uint32_t QSPI_BANK_VERSION = 2;  // 2: GruModelWeights gained gruCondition
+
+struct QspiBankHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t count;     // directory entries
+    uint32_t size;      // bytes, header included
+    uint32_t checksum;  // FNV-1a over everything after the header
+    uint32_t reserved;
+};
+
+struct QspiBankEntry
+{
+    int32_t amp;         // TOGGLESWITCH_1 picks amps 1..3, as in model_bank.h
+    int32_t hiddenSize;  // 6, 9, 12 or 16: the tier
+    uint32_t offset;     // from the header
+    uint32_t size;       // sizeof(GruModelWeights<hiddenSize>)
+    char name[16];       // for the serial log, not always terminated
+};
+
+// FNV-1a over a blob of size bytes, after its header
+inline uint32_t QspiBankChecksum(const uint8_t* bytes, uint32_t size)
+{
+    uint32_t hash = 2166136261u;
+    for (uint32_t i = sizeof(QspiBankHeader); i < size; i++)
+        hash = (hash ^ bytes[i]) * 16777619u;
+    return hash;
+}
+
+class QspiModelBank
+{
+  public:
+    // Checks the blob at base (a QSPI address). Returns false, leaving the
+    // bank empty, unless the header, every entry and the checksum are good.
+    bool Init(const void* base)
+    {
+        Clear();
+        const uint8_t* bytes = static_cast<const uint8_t*>(base);
+        QspiBankHeader header;
+        memcpy(&header, bytes, sizeof(header));
+        if (header.magic != QSPI_BANK_MAGIC || header.version != QSPI_BANK_VERSION)
+            return false;
+        if (header.count == 0 || header.count > kMaxEntries || header.size > kMaxSize)
+            return false;
+        const uint32_t directoryEnd = sizeof(header) + header.count * sizeof(QspiBankEntry);
+        if (directoryEnd > header.size)
+            return false;
+
+        const QspiBankEntry* entries = reinterpret_cast<const QspiBankEntry*>(bytes + sizeof(header));
+        for (uint32_t i = 0; i < header.count; i++)
+        {
+            const QspiBankEntry& e = entries[i];
+            if (_Tier(e.hiddenSize) < 0 || e.size != _WeightsSize(e.hiddenSize)
+                || e.offset < directoryEnd || e.offset % 8 != 0 || e.offset > header.size - e.size)
+                return false;
+        }
+
+        if (QspiBankChecksum(bytes, header.size) != header.checksum)
+            return false;
+
+        mBase = bytes;
+        mEntries = entries;
+        mCount = (int)header.count;
+        return true;
+    }
+
+    // Back to empty, e.g. while the blob is being rewritten
+    void Clear()
+    {
+        mBase = nullptr;
+        mCount = 0;
+    }
+
+    bool Valid() const { return mCount > 0; }
+    int Count() const { return mCount; }
+    const QspiBankEntry& Entry(int index) const { return mEntries[index]; }
+
+    // The same queries as ModelBankSet, so selectModelTier() takes either
+    bool Has(int amp, int tier) const { return _Find(amp, tier) != nullptr; }
+
+    int Rate(int amp, int tier) const
+    {
+        const QspiBankEntry* e = _Find(amp, tier);
+        int32_t rate = MODEL_RATE_NATIVE;
+        if (e != nullptr)
+            memcpy(&rate, mBase + e->offset + _RateOffset(e->hiddenSize), sizeof(rate));
+        return rate >= 0 && rate < NUM_MODEL_RATES ? rate : MODEL_RATE_NATIVE;
+    }
+
+    // Copies amp at tier out of QSPI. Main loop only, like every QSPI read:
+    // while a settings or watchdog save has the flash out of memory-mapped
+    // mode it can't be read. Returns false if there's no such entry.
+    bool Stage(int amp, int tier, StagedModelWeights& staged) const
+    {
+        const QspiBankEntry* e = _Find(amp, tier);
+        if (e == nullptr)
+            return false;
+        memcpy(&staged, mBase + e->offset, e->size);
+        return true;
+    }
+
+  private:
+    static constexpr uint32_t kMaxEntries = 1024;
+    static constexpr uint32_t kMaxSize = 4 * 1024 * 1024;
+
+    static int _Tier(int hiddenSize)
+    {
+        switch (hiddenSize)
+        {
+            case 6:  return TIER_GRU6;
+            case 9:  return TIER_GRU9;
+            case 12: return TIER_GRU12;
+            case 16: return TIER_GRU16;
+            default: return -1;
+        }
+    }
+
+    static uint32_t _WeightsSize(int hiddenSize)
+    {
+        switch (hiddenSize)
+        {
+            case 6:  return sizeof(GruModelWeights<6>);
+            case 9:  return sizeof(GruModelWeights<9>);
+            case 12: return sizeof(GruModelWeights<12>);
+            default: return sizeof(GruModelWeights<16>);
+        }
+    }
+
+    static uint32_t _RateOffset(int hiddenSize)
+    {
+        switch (hiddenSize)
+        {
+            case 6:  return offsetof(GruModelWeights<6>, rate);
+            case 9:  return offsetof(GruModelWeights<9>, rate);
+            case 12: return offsetof(GruModelWeights<12>, rate);
+            default: return offsetof(GruModelWeights<16>, rate);
+        }
+    }
+
+    const QspiBankEntry* _Find(int amp, int tier) const
+    {
+        for (int i = 0; i < mCount; i++)
+        {
+            if (mEntries[i].amp == amp && _Tier(mEntries[i].hiddenSize) == tier)
+                return &mEntries[i];
+        }
+        return nullptr;
+    }
+
+    const uint8_t* mBase = nullptr;
+    const QspiBankEntry* mEntries = nullptr;
+    int mCount = 0;
+};
@@ -0,0 +1,19 @@
+#pragma once
+
+// 2:1 rate changes around the amp model, for models that run at half or
+// twice the pedal's rate (ModelRate in model_weights.h).
+//
+// Both directions use the same 47-tap half-band low-pass (Kaiser, beta 8,
+// lib/hothouse/hothouse_multirate.h builds it at compile time): flat to
+// within 0.01 dB up to 0.2 of the higher rate (9.6 kHz around a 24 kHz
+// model), -6 dB at 0.25 and below -56 dB from 0.3. In a half-band filter
+// every other tap is zero and the centre tap is 0.5, so each output costs
+// halfband_pairs multiply-adds: the symmetric pairs share one multiply.
+// Each filter delays by 23 samples at the higher rate.
+
+#include "hothouse_multirate.h"
+
+static constexpr size_t halfband_pairs = 12;
+
+typedef clevelandmusicco::HalfbandDecimator<halfband_pairs> ModelDecimator;
+typedef clevelandmusicco::HalfbandInterpolator<halfband_pairs> ModelInterpolator;
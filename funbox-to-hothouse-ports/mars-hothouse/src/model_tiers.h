@@ -0,0 +1,325 @@
+#pragma once
+
+#include <cstddef>
+#include "model_weights.h"
+#include "model_rate.h"
+#include "hothouse_tcm.h"
+#include "hothouse_fastmath.h"
+
+// The shared fast maths (lib/hothouse/hothouse_fastmath.h) as an RTNeural
+// MathsProvider: tanh within 1.5e-7 of libm, sigmoid within 7.5e-8.
+struct HothouseMathsProvider
+{
+    template <typename T>
+    static T tanh(T x) { return fastmath::Tanh(x); }
+    template <typename T>
+    static T sigmoid(T x) { return (T)0.5 + (T)0.5 * fastmath::Tanh(x * (T)0.5); }
+    template <typename T>
+    static T exp(T x) { return fastmath::Exp(x); }
+};
+
+// GRU activation maths, chosen at compile time. DefaultMathsProvider is exact
+// libm; HothouseMathsProvider is within a few ulp of it for a fraction of
+// the cycles. PadeMathsProvider, PolyMathsProvider and LutMathsProvider trade
+// more accuracy, with their max errors listed in RTNeural/maths/maths_approx.h.
+typedef HothouseMathsProvider MarsMaths;
+
+template <int HiddenSize>
+using MarsModelT = RTNeural::ModelT<float, 1, 1,
+    RTNeural::GRULayerT<float, 1, HiddenSize, RTNeural::SampleRateCorrectionMode::None, MarsMaths>,
+    RTNeural::DenseT<float, HiddenSize, 1>>;
+
+// Model architectures the firmware can run, cheapest first
+enum ModelTier { TIER_GRU6, TIER_GRU9, TIER_GRU12, TIER_GRU16, NUM_MODEL_TIERS };
+
+// Per-architecture descriptor. cyclesPerSample is measured on the Seed at
+// boot for each ModelRate, resampling included (see measureModelTiers() in
+// mars_hothouse.cpp), not hardcoded.
+struct ModelTierInfo
+{
+    int hiddenSize;
+    float cyclesPerSample[NUM_MODEL_RATES];
+};
+
+// One bank per architecture. Entry i of every bank is the same amp trained
+// at that size; a bank that is shorter (or empty) just doesn't offer amp i
+// at that tier.
+struct ModelBankSet
+{
+    const GruModelWeights<6>* gru6;   int gru6Size;
+    const GruModelWeights<9>* gru9;   int gru9Size;
+    const GruModelWeights<12>* gru12; int gru12Size;
+    const GruModelWeights<16>* gru16; int gru16Size;
+
+    bool Has(int amp, int tier) const
+    {
+        const int sizes[NUM_MODEL_TIERS] = {gru6Size, gru9Size, gru12Size, gru16Size};
+        return amp >= 0 && tier >= 0 && tier < NUM_MODEL_TIERS && amp < sizes[tier];
+    }
+
+    // The ModelRate amp runs at in tier, which Has() must allow
+    int Rate(int amp, int tier) const
+    {
+        int rate;
+        switch (tier)
+        {
+            case TIER_GRU6:  rate = gru6[amp].rate; break;
+            case TIER_GRU9:  rate = gru9[amp].rate; break;
+            case TIER_GRU12: rate = gru12[amp].rate; break;
+            default:         rate = gru16[amp].rate; break;
+        }
+        return rate >= 0 && rate < NUM_MODEL_RATES ? rate : MODEL_RATE_NATIVE;
+    }
+};
+
+// One model of any tier, staged in SRAM on its way from the QSPI bank
+// (model_qspi_bank.h) to a slot
+union StagedModelWeights
+{
+    GruModelWeights<6> gru6;
+    GruModelWeights<9> gru9;
+    GruModelWeights<12> gru12;
+    GruModelWeights<16> gru16;
+};
+
+// A model slot that can hold an amp at any tier. Only the model for the
+// loaded tier is run; the others sit idle.
+class AmpSlot
+{
+  public:
+    // Loads amp at tier from the banks. Main loop only (model.reset() is
+    // not click-free). Returns false if the banks don't have it.
+    bool Load(const ModelBankSet& banks, int amp, int tier)
+    {
+        if (!banks.Has(amp, tier))
+            return false;
+        switch (tier)
+        {
+            case TIER_GRU6:  _Load(mGru6, banks.gru6[amp]); break;
+            case TIER_GRU9:  _Load(mGru9, banks.gru9[amp]); break;
+            case TIER_GRU12: _Load(mGru12, banks.gru12[amp]); break;
+            default:         _Load(mGru16, banks.gru16[amp]); break;
+        }
+        mAmp = amp;
+        mTier = tier;
+        mRate = banks.Rate(amp, tier);
+        _ResetRate();
+        return true;
+    }
+
+    // Loads amp at tier from staged, which holds that tier's weights: as a
+    // one-amp bank of every tier, only one of them real
+    void Load(const StagedModelWeights& staged, int amp, int tier)
+    {
+        const ModelBankSet one = {&staged.gru6, 1, &staged.gru9, 1, &staged.gru12, 1, &staged.gru16, 1};
+        Load(one, 0, tier);
+        mAmp = amp;
+    }
+
+    // Selects a tier and rate without loading weights, for timing them at boot
+    void SetTierForMeasurement(int tier, int rate)
+    {
+        mTier = tier;
+        mRate = rate;
+        _ResetRate();
+    }
+
+    // In ITCM with TCM=1, the RTNeural forward passes inlined into it. out
+    // is the model's output less in, the clean signal the callback adds
+    // back; away from MODEL_RATE_NATIVE it includes the resamplers' delay
+    // (46 samples at half rate, 23 at double), and size must be even.
+    HOTHOUSE_ITCM_FLATTEN void ProcessBlock(const float* in, float* out, size_t size)
+    {
+        switch (mTier)
+        {
+            case TIER_GRU6:  _Process(mGru6, in, out, size); break;
+            case TIER_GRU9:  _Process(mGru9, in, out, size); break;
+            case TIER_GRU12: _Process(mGru12, in, out, size); break;
+            default:         _Process(mGru16, in, out, size); break;
+        }
+    }
+
+    // Sets a conditioned model's knob input, 0 to 1. The knob holds still
+    // within a block, so rather than run a two-input GRU its share of the
+    // input projection is added to the input bias once, here, and the block
+    // runs as a one-input model. Costs nothing unless condition changed;
+    // does nothing for a snapshot model.
+    void SetCondition(float condition)
+    {
+        if (!mConditioned || condition == mCondition)
+            return;
+        mCondition = condition;
+        switch (mTier)
+        {
+            case TIER_GRU6:  _ApplyCondition<6>(mGru6); break;
+            case TIER_GRU9:  _ApplyCondition<9>(mGru9); break;
+            case TIER_GRU12: _ApplyCondition<12>(mGru12); break;
+            default:         _ApplyCondition<16>(mGru16); break;
+        }
+    }
+
+    // A conditioned model takes the gain knob through SetCondition() and its
+    // input at unity; a snapshot model has the knob as an input gain
+    bool Conditioned() const { return mConditioned; }
+
+    int Amp() const { return mAmp; }
+    int Tier() const { return mTier; }
+    int Rate() const { return mRate; }
+    float LevelAdjust() const { return mLevelAdjust; }
+
+  private:
+    // Samples resampled per pass, at the pedal's rate: sizes the scratch on
+    // the audio stack
+    static constexpr int rate_chunk = 32;
+
+    template <typename ModelType, typename WeightsType>
+    void _Load(ModelType& model, const WeightsType& weights)
+    {
+        loadModelWeights(model, weights);
+        mLevelAdjust = weights.levelAdjust;
+
+        // setBVals() reads bias_ih then bias_hh at a stride of 3H, so keep
+        // them in the same layout at this model's size
+        constexpr int H = sizeof(weights.denseWeights) / sizeof(float);
+        for (int k = 0; k < 2 * 3 * H; k++)
+            mBias[k] = weights.gruBias[k];
+        for (int k = 0; k < 3 * H; k++)
+            mConditionWeights[k] = weights.gruCondition[k];
+        mConditioned = isConditionedModel(weights);
+        mCondition = -1.0f; // none yet: the next SetCondition() applies
+    }
+
+    template <int H, typename ModelType>
+    void _ApplyCondition(ModelType& model)
+    {
+        float bias[2 * 3 * H];
+        for (int k = 0; k < 2 * 3 * H; k++)
+            bias[k] = mBias[k];
+        for (int k = 0; k < 3 * H; k++)
+            bias[k] += mConditionWeights[k] * mCondition;
+        model.template get<0>().setBVals(bias);
+    }
+
+    void _ResetRate()
+    {
+        mDecimator.Reset();
+        mInterpolator.Reset();
+        for (float& v : mOddState)
+            v = 0.0f;
+    }
+
+    template <typename ModelType>
+    inline void _Process(ModelType& model, const float* in, float* out, size_t size)
+    {
+        if (mRate == MODEL_RATE_NATIVE)
+        {
+            model.forwardBlock(in, out, (int)size);
+            return;
+        }
+
+        // The clean signal is added at the model's rate, so that what the
+        // callback adds back matches it once resampled and delayed
+        float x[2][rate_chunk];
+        float y[2][rate_chunk];
+        for (size_t start = 0; start < size; start += rate_chunk)
+        {
+            const int n = (int)(size - start < rate_chunk ? size - start : rate_chunk);
+            if (mRate == MODEL_RATE_HALF)
+            {
+                mDecimator.Process(in + start, in + start + 1, 2, x[0], n / 2);
+                model.forwardBlock(x[0], y[0], n / 2);
+                for (int k = 0; k < n / 2; k++)
+                    y[0][k] += x[0][k];
+                mInterpolator.Process(y[0], out + start, out + start + 1, 2, n / 2);
+            }
+            else
+            {
+                // RTNeural's NoInterp correction for a delay of two samples
+                // is two recurrences, one over the even samples at 96 kHz
+                // and one over the odd: run them a block each, swapping the
+                // odd phase's state in. Unlike the corrected layer type this
+                // keeps the batched forwardBlock() and no heap, and skips its
+                // extra sample of output delay.
+                mInterpolator.Process(in + start, x[0], x[1], 1, n);
+                model.forwardBlock(x[0], y[0], n);
+                _SwapOddState(model);
+                model.forwardBlock(x[1], y[1], n);
+                _SwapOddState(model);
+                for (int k = 0; k < n; k++)
+                {
+                    y[0][k] += x[0][k];
+                    y[1][k] += x[1][k];
+                }
+                mDecimator.Process(y[0], y[1], 1, out + start, n);
+            }
+            for (int k = 0; k < n; k++)
+                out[start + k] -= in[start + k];
+        }
+    }
+
+    template <typename ModelType>
+    inline void _SwapOddState(ModelType& model)
+    {
+        float* state = model.template get<0>().outs;
+        constexpr int hiddenSize = sizeof(model.template get<0>().outs) / sizeof(float);
+        static_assert(hiddenSize <= 16, "mOddState holds up to 16 units");
+        for (int i = 0; i < hiddenSize; i++)
+        {
+            const float even = state[i];
+            state[i] = mOddState[i];
+            mOddState[i] = even;
+        }
+    }
+
+    MarsModelT<6> mGru6;
+    MarsModelT<9> mGru9;
+    MarsModelT<12> mGru12;
+    MarsModelT<16> mGru16;
+
+    // MODEL_RATE_HALF and MODEL_RATE_DOUBLE only
+    ModelDecimator mDecimator;
+    ModelInterpolator mInterpolator;
+    float mOddState[16] = {};  // the idle phase's GRU state at double rate
+
+    int mAmp = -1;
+    int mTier = TIER_GRU9;
+    int mRate = MODEL_RATE_NATIVE;
+    float mLevelAdjust = 1.0f;
+
+    // The loaded model's bias and conditioning weights, as in
+    // GruModelWeights at its size: SetCondition() rebuilds the bias from them
+    float mBias[2 * 3 * 16] = {};
+    float mConditionWeights[3 * 16] = {};
+    bool mConditioned = false;
+    float mCondition = -1.0f;
+};
+
+// Picks the largest tier the banks offer for amp that fits the CPU budget,
+// each at the rate its model runs at. otherLoad is the measured load of
+// everything but the model (fraction of the block period); cyclesPerBlock is
+// the block period in core cycles.
+// While crossfading both the current and the new model run, so a candidate
+// must fit alongside the current tier. If nothing fits, the cheapest
+// available tier is returned so the pedal degrades instead of glitching.
+// banks is a ModelBankSet or a QspiModelBank.
+template <typename Banks>
+inline int selectModelTier(const Banks& banks, const ModelTierInfo* tiers,
+                           int amp, int currentTier, int currentRate, float otherLoad,
+                           float cyclesPerBlock, size_t blockSize, float budget)
+{
+    const float currentLoad = tiers[currentTier].cyclesPerSample[currentRate] * blockSize
+                              / cyclesPerBlock;
+    int cheapest = -1;
+    for (int tier = NUM_MODEL_TIERS - 1; tier >= 0; tier--)
+    {
+        if (!banks.Has(amp, tier))
+            continue;
+        const float load = tiers[tier].cyclesPerSample[banks.Rate(amp, tier)] * blockSize
+                           / cyclesPerBlock;
+        if (tier == currentTier ? otherLoad + load <= budget
+                                : otherLoad + load + currentLoad <= budget)
+            return tier;
+        cheapest = tier;
+    }
+    return cheapest;
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstdint>
+#include <RTNeural/RTNeural.h>
+
+// Rate an amp model runs at, relative to the pedal's, set per model when
+// its bank is generated. MODEL_RATE_HALF is for a capture trained at half
+// the rate: heavier sizes for less CPU, with the top octave cut. With
+// MODEL_RATE_DOUBLE a capture trained at the pedal's rate runs oversampled,
+// using RTNeural's delay-based correction (two interleaved recurrences), for
+// less aliasing from its nonlinearity at about twice the cost.
+enum ModelRate { MODEL_RATE_NATIVE, MODEL_RATE_HALF, MODEL_RATE_DOUBLE, NUM_MODEL_RATES };
+
+// One GRU amp model in the flat layout RTNeural's GRULayerT<float,1,H> and
+// DenseT<float,H,1> flat setters consume. Banks of these are generated into
+// model_bank.h by tools/mars_model_gen.py and live in flash as static const
+// data - no vectors, nothing built at boot.
+//
+// A conditioned model (one capture covering the whole gain range, trained
+// with the knob as a second input) has that input's column of weight_ih in
+// gruCondition; AmpSlot folds it into the input bias per block. It is last
+// so that banks of snapshot models, which leave it out, get zeros.
+template <int HiddenSize>
+struct alignas(RTNEURAL_DEFAULT_ALIGNMENT) GruModelWeights
+{
+    float gruKernel[3 * HiddenSize];                // weight_ih [1][3H], z|r|h
+    float gruRecurrent[HiddenSize * 3 * HiddenSize]; // weight_hh [H][3H], z|r|h
+    float gruBias[2 * 3 * HiddenSize];               // bias_ih, bias_hh [2][3H]
+    float denseWeights[HiddenSize];                  // lin.weight [1][H]
+    float denseBias[1];
+    float levelAdjust;                               // output trim for this amp
+    int32_t rate;                                    // ModelRate
+    float gruCondition[3 * HiddenSize];              // weight_ih [1][3H] of the knob input, z|r|h
+};
+
+// True if weights has a conditioning input: not a snapshot model
+template <int HiddenSize>
+bool isConditionedModel(const GruModelWeights<HiddenSize>& weights)
+{
+    for (float w : weights.gruCondition)
+        if (w != 0.0f)
+            return true;
+    return false;
+}
+
+// Copies a bank entry from flash into a model's layers and resets its state.
+// Allocation-free, but reset() is not click-free - load an idle model only.
+template <typename ModelType, int HiddenSize>
+void loadModelWeights(ModelType& model, const GruModelWeights<HiddenSize>& weights)
+{
+    auto& gru = model.template get<0>();
+    auto& dense = model.template get<1>();
+    gru.setWVals(weights.gruKernel);
+    gru.setUVals(weights.gruRecurrent);
+    gru.setBVals(weights.gruBias);
+    dense.setWeights(weights.denseWeights);
+    dense.setBias(weights.denseBias);
+    model.reset();
+}
+
+// Q15 variant of GruModelWeights at a little over half the flash. Each
+// run of H values (one gate of one weight row) shares a float scale:
+// value = q * scale, scale = max|run| / 32767. The dense row has one scale.
+template <int HiddenSize>
+struct alignas(RTNEURAL_DEFAULT_ALIGNMENT) GruModelWeightsQ15
+{
+    int16_t gruKernel[3 * HiddenSize];
+    int16_t gruRecurrent[HiddenSize * 3 * HiddenSize];
+    int16_t gruBias[2 * 3 * HiddenSize];
+    int16_t denseWeights[HiddenSize];
+    float gruKernelScale[3];
+    float gruRecurrentScale[3 * HiddenSize];
+    float gruBiasScale[6];
+    float denseWeightsScale[1];
+    float denseBias[1];
+    float levelAdjust;
+    int32_t rate;
+    int16_t gruCondition[3 * HiddenSize];
+    float gruConditionScale[3];
+};
+
+// Dequantizes a Q15 bank entry into a model slot. The layers run in float,
+// so this only costs time at load (main loop), never per sample. Uses
+// ~1.3 kB of stack for H = 9.
+template <typename ModelType, int HiddenSize>
+void loadModelWeights(ModelType& model, const GruModelWeightsQ15<HiddenSize>& weights)
+{
+    constexpr int H = HiddenSize;
+    GruModelWeights<H> unpacked;
+    for (int k = 0; k < 3 * H; k++)
+        unpacked.gruKernel[k] = weights.gruKernel[k] * weights.gruKernelScale[k / H];
+    for (int k = 0; k < H * 3 * H; k++)
+        unpacked.gruRecurrent[k] = weights.gruRecurrent[k] * weights.gruRecurrentScale[k / H];
+    for (int k = 0; k < 2 * 3 * H; k++)
+        unpacked.gruBias[k] = weights.gruBias[k] * weights.gruBiasScale[k / H];
+    for (int k = 0; k < H; k++)
+        unpacked.denseWeights[k] = weights.denseWeights[k] * weights.denseWeightsScale[0];
+    unpacked.denseBias[0] = weights.denseBias[0];
+    unpacked.levelAdjust = weights.levelAdjust;
+    unpacked.rate = weights.rate;
+    for (int k = 0; k < 3 * H; k++)
+        unpacked.gruCondition[k] = weights.gruCondition[k] * weights.gruConditionScale[k / H];
+    loadModelWeights(model, unpacked);
+}
@@ -0,0 +1,91 @@
+#pragma once
+#ifndef NOISE_GATE_H
+#define NOISE_GATE_H
+#include <math.h>
+#include <stddef.h>
+#include "control_param.h"
+
+/** Noise gate for the amp model's input, decided once per block from the
+    block's RMS. A block over the open level opens it at once; once the
+    blocks have stayed under the close level (the open level less the
+    hysteresis) for holdMs, it closes, fading out over releaseMs. The gain
+    is ramped across each block, so opening takes one block and nothing
+    clicks. RMS rather than peak, so the odd noise spike doesn't reopen it.
+
+    Usage, once per callback:
+        gate.Detect(meanSquare, size);
+        for each sample: modelIn = in * gate.Next();
+    and while Shut(), the block is silence to everything after the gate.
+*/
+class NoiseGate
+{
+  public:
+    NoiseGate() {}
+    ~NoiseGate() {}
+
+    void Init(float sampleRate,
+              float openDb,
+              float hysteresisDb = 10.0f,
+              float holdMs       = 50.0f,
+              float releaseMs    = 120.0f)
+    {
+        openSq_  = powf(10.0f, openDb / 10.0f);
+        closeSq_ = powf(10.0f, (openDb - hysteresisDb) / 10.0f);
+        hold_    = (size_t)(holdMs * 0.001f * sampleRate);
+        release_ = 1.0f / (releaseMs * 0.001f * sampleRate);
+        quiet_   = 0;
+        isOpen_  = true;
+        gain_.Init(1.0f);
+    }
+
+    /** Sets the gain ramp for the block of size samples, from its input's
+        mean square
+    */
+    inline void Detect(float meanSquare, size_t size)
+    {
+        if(meanSquare > openSq_)
+        {
+            isOpen_ = true;
+            quiet_  = 0;
+        }
+        else if(isOpen_)
+        {
+            if(meanSquare >= closeSq_)
+                quiet_ = 0;
+            else if((quiet_ += size) >= hold_)
+                isOpen_ = false;
+        }
+
+        float target = 1.0f;
+        if(!isOpen_)
+        {
+            target = gain_.Target() - release_ * (float)size;
+            if(target < 0.0f)
+                target = 0.0f;
+        }
+        gain_.SetTarget(target, size);
+    }
+
+    /** The gain for the next sample of the block */
+    inline float Next() { return gain_.Next(); }
+
+    /** Advances over a block nobody hears */
+    inline void Skip(size_t size) { gain_.Skip(size); }
+
+    /** Closed and faded out: the whole block is muted */
+    inline bool Shut() const
+    {
+        return !isOpen_ && gain_.Value() == 0.0f && gain_.Target() == 0.0f;
+    }
+
+  private:
+    float        openSq_  = 0.0f;
+    float        closeSq_ = 0.0f;
+    size_t       hold_    = 0;
+    float        release_ = 0.0f;
+    size_t       quiet_   = 0;
+    bool         isOpen_  = true;
+    ControlParam gain_;
+};
+
+#endif
@@ -0,0 +1,209 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+#include <utility>
+#include "hothouse_fastmath.h"
+
+// Dilated causal convolution stacks ("WaveNet-lite"): the shape of NAM's
+// nano captures cut down to what a Seed block can afford, as an alternative
+// to the GRU models. Every size is a template parameter, so there is no
+// heap and no Eigen; each layer keeps its own ring of past inputs, just long
+// enough for its taps. With C channels, kernel K and a dilation d per layer:
+//
+//   h = Win x + bin                                          (1 -> C)
+//   per layer:  a  = tanh(bconv + sum_k Wconv[k] h[n - (K-1-k) d])
+//               h += Wmix a + bmix                           (residual)
+//               s += a                                       (skip)
+//   y = Whead s + bhead                                      (C -> 1)
+//
+// The receptive field is 1 + (K-1) * sum(d) samples.
+
+// One layer's weights, laid out for sequential loads: conv[out][tap][in],
+// tap K-1 being the newest sample
+template <int C, int K>
+struct TcnLayerWeights
+{
+    float conv[C][K][C];
+    float convBias[C];
+    float mix[C][C];  // [out][in]
+    float mixBias[C];
+};
+
+// One TCN model in the flat layout TcnModelT::Load() takes. Banks of these
+// are generated into a header by tools/mars_tcn_gen.py and live in flash as
+// static const data, like GruModelWeights.
+template <int C, int K, int Layers>
+struct TcnModelWeights
+{
+    int32_t dilations[Layers];  // Checked against the model's on loading
+    float inputWeights[C];
+    float inputBias[C];
+    TcnLayerWeights<C, K> layers[Layers];
+    float headWeights[C];
+    float headBias[1];
+    float levelAdjust;  // output trim for this amp
+};
+
+template <int C, int K, int Dilation>
+class TcnLayerT
+{
+  public:
+    static_assert(C > 0 && K > 0 && Dilation > 0, "TCN sizes must be positive");
+
+    // The ring is the taps' span rounded up to a power of two, so wrapping
+    // is a mask
+    static constexpr int span = (K - 1) * Dilation + 1;
+    static constexpr int ring = span <= 1 ? 1 : 2 << (31 - __builtin_clz(span - 1));
+
+    void Load(const TcnLayerWeights<C, K>& weights) { memcpy(&w_, &weights, sizeof(w_)); }
+
+    void Reset()
+    {
+        memset(history_, 0, sizeof(history_));
+        pos_ = 0;
+    }
+
+    // Runs count samples of h (C values each) through the layer in place,
+    // adding the activations into skip
+    inline void Process(float (*h)[C], float (*skip)[C], int count) noexcept
+    {
+        constexpr int mask = ring - 1;
+        for (int n = 0; n < count; n++) {
+            pos_ = (pos_ + 1) & mask;
+            for (int c = 0; c < C; c++)
+                history_[pos_][c] = h[n][c];
+
+            const float* taps[K];
+            for (int k = 0; k < K; k++)
+                taps[k] = history_[(pos_ - (K - 1 - k) * Dilation) & mask];
+
+            float a[C];
+            for (int o = 0; o < C; o++) {
+                float acc = w_.convBias[o];
+                for (int k = 0; k < K; k++) {
+                    const float* weight = w_.conv[o][k];
+                    for (int i = 0; i < C; i++)
+                        acc += weight[i] * taps[k][i];
+                }
+                a[o] = fastmath::Tanh(acc);
+            }
+
+            for (int o = 0; o < C; o++) {
+                float acc = w_.mixBias[o];
+                for (int i = 0; i < C; i++)
+                    acc += w_.mix[o][i] * a[i];
+                h[n][o] += acc;
+                skip[n][o] += a[o];
+            }
+        }
+    }
+
+  private:
+    TcnLayerWeights<C, K> w_ = {};
+    float history_[ring][C] = {};
+    int pos_ = 0;
+};
+
+namespace tcn_detail {
+constexpr int Sum() { return 0; }
+template <typename... Rest>
+constexpr int Sum(int first, Rest... rest) { return first + Sum(rest...); }
+}  // namespace tcn_detail
+
+template <int C, int K, int... Dilations>
+class TcnModelT
+{
+  public:
+    static constexpr int channels = C;
+    static constexpr int kernel = K;
+    static constexpr int num_layers = sizeof...(Dilations);
+    static constexpr int receptive_field = 1 + (K - 1) * tcn_detail::Sum(Dilations...);
+    typedef TcnModelWeights<C, K, num_layers> Weights;
+
+    // Samples forwardBlock() runs through each layer at a time: long enough
+    // to keep a layer's weights hot, short enough for the stack
+    static constexpr int block_chunk = 16;
+
+    // Copies a bank entry into the layers and clears their history. Returns
+    // false, loading nothing, if the entry was generated for other dilations.
+    bool Load(const Weights& weights)
+    {
+        constexpr int dilations[] = {Dilations...};
+        for (int l = 0; l < num_layers; l++) {
+            if (weights.dilations[l] != dilations[l])
+                return false;
+        }
+        memcpy(inputWeights_, weights.inputWeights, sizeof(inputWeights_));
+        memcpy(inputBias_, weights.inputBias, sizeof(inputBias_));
+        memcpy(headWeights_, weights.headWeights, sizeof(headWeights_));
+        headBias_ = weights.headBias[0];
+        LoadLayers(weights, std::index_sequence_for<decltype(Dilations)...>{});
+        Reset();
+        return true;
+    }
+
+    void Reset() { ResetLayers(std::index_sequence_for<decltype(Dilations)...>{}); }
+
+    // The same interface as RTNeural's ModelT::forwardBlock(), so AmpSlot-style
+    // code can run either
+    void forwardBlock(const float* in, float* out, int numSamples) noexcept
+    {
+        for (int start = 0; start < numSamples; start += block_chunk) {
+            const int count = numSamples - start < block_chunk ? numSamples - start : block_chunk;
+            for (int n = 0; n < count; n++) {
+                const float x = in[start + n];
+                for (int c = 0; c < C; c++) {
+                    h_[n][c] = inputWeights_[c] * x + inputBias_[c];
+                    skip_[n][c] = 0.0f;
+                }
+            }
+
+            ProcessLayers(count, std::index_sequence_for<decltype(Dilations)...>{});
+
+            for (int n = 0; n < count; n++) {
+                float y = headBias_;
+                for (int c = 0; c < C; c++)
+                    y += headWeights_[c] * skip_[n][c];
+                out[start + n] = y;
+            }
+        }
+    }
+
+  private:
+    template <size_t... I>
+    void LoadLayers(const Weights& weights, std::index_sequence<I...>)
+    {
+        int each[] = {(std::get<I>(layers_).Load(weights.layers[I]), 0)...};
+        (void)each;
+    }
+
+    template <size_t... I>
+    void ResetLayers(std::index_sequence<I...>)
+    {
+        int each[] = {(std::get<I>(layers_).Reset(), 0)...};
+        (void)each;
+    }
+
+    template <size_t... I>
+    void ProcessLayers(int count, std::index_sequence<I...>) noexcept
+    {
+        // In order: a braced list is evaluated left to right
+        int each[] = {(std::get<I>(layers_).Process(h_, skip_, count), 0)...};
+        (void)each;
+    }
+
+    std::tuple<TcnLayerT<C, K, Dilations>...> layers_;
+    float inputWeights_[C] = {};
+    float inputBias_[C] = {};
+    float headWeights_[C] = {};
+    float headBias_ = 0.0f;
+    float h_[block_chunk][C];
+    float skip_[block_chunk][C];
+};
+
+// A nano-sized stack: 4 channels, kernel 3, dilations 1 to 512 (2047
+// samples of receptive field, about 43 ms at 48 kHz)
+typedef TcnModelT<4, 3, 1, 2, 4, 8, 16, 32, 64, 128, 256, 512> TcnNanoT;
@@ -0,0 +1,73 @@
+// fast_math.h // cheap stand-ins for rand(), sin/cos and sqrt in spectral kernels
+#ifndef FAST_MATH
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include "hothouse_fastmath.h"
+
+namespace soundmath
+{
+	// Marsaglia's xorshift32; three shifts and xors per draw, and the state
+	// is never zero as long as the seed isn't
+	class XorShift32
+	{
+	public:
+		XorShift32(uint32_t seed = 2463534242u) : state(seed) { }
+
+		uint32_t next()
+		{
+			state ^= state << 13;
+			state ^= state >> 17;
+			state ^= state << 5;
+			return state;
+		}
+
+	private:
+		uint32_t state;
+	};
+
+	// Unit phasors at 2^Bits equally spaced angles, tabulated at compile time.
+	// Indexed by the top Bits of a 32-bit draw, it gives a uniformly random
+	// phase for the price of two loads.
+	template <typename T, int Bits = 10> class PhaseTable
+	{
+	public:
+		static const int size = 1 << Bits;
+		static const int shift = 32 - Bits;
+
+		constexpr PhaseTable() : cosines(), sines()
+		{
+			for (int i = 0; i < size; i++)
+			{
+				cosines[i] = cos(2 * M_PI * i / size);
+				sines[i] = sin(2 * M_PI * i / size);
+			}
+		}
+
+		T cosine(uint32_t draw) const
+		{
+			return cosines[draw >> shift];
+		}
+
+		T sine(uint32_t draw) const
+		{
+			return sines[draw >> shift];
+		}
+
+	private:
+		T cosines[size];
+		T sines[size];
+	};
+
+	// https://en.wikipedia.org/wiki/Fast_inverse_square_root, with one Newton
+	// step (relative error under 0.2%); exact at 0, as spectra often are.
+	// The estimate itself is shared, in lib/hothouse/hothouse_fastmath.h
+	inline float fastSqrt(float x)
+	{
+		return x * fastmath::RsqrtEstimate(x);
+	}
+}
+
+#define FAST_MATH
+#endif
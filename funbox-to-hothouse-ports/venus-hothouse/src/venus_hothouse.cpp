@@ -4,9 +4,23 @@
 
 #include <cmath>
 #include <complex>
-#include "shy_fft.h"
-#include "fourier.h"
-#include "wave.h"
+#include <new>
+#include <type_traits>
+#include "hothouse_stft.h"
+#ifndef VENUS_FFT_BACKEND
+#define VENUS_FFT_BACKEND 0
+#endif
+#if VENUS_FFT_BACKEND != 1
+#include "hothouse_fft.h"
+#endif
+#include "hothouse_wave.h"
+#include "hothouse_half.h"
+#include "fast_math.h"
+#include "hothouse_curves.h"
+#include "hothouse_fastmath.h"
+#include "hothouse_multirate.h"
+#include "hothouse_modmatrix.h"
+#include "hothouse_envelope.h"
 
 #define PI 3.1415926535897932384626433832795
 
@@ -19,6 +33,8 @@ using namespace soundmath;
 Hothouse hw;
 
 float samplerate = 32000;
+// The STFT's rate: the codec's, or two thirds of it in 48 kHz mode
+float stft_rate = 32000;
 bool bypass = true;
 bool freeze = false;
 bool first_start = true;
@@ -35,36 +51,220 @@ float vshimmer = 0.0, vshimmer_tone = 0.0, vdetune = 0.0;
 int shimmer_mode = 0, reverb_mode = 0, drift_mode = 1;  // Original defaults
 int detune_mode = 1, detune_multiplier = 1;
 
-// STFT components
-const size_t order = 12;
-const size_t N = (1 << order);
-const float sqrtN = sqrt(N);
-const size_t laps = 4;
-const size_t buffsize = 2 * laps * N;
-float in[buffsize], middle[buffsize], out[buffsize];
-float reverb_energy[N/2];
+// STFT components. The frame size and overlap come from the profile picked
+// at boot (see stft_profiles); the buffers are sized for the largest frame.
+const size_t max_order = 13;
+const size_t max_N = (1 << max_order);
+size_t stft_size = 4096;
+size_t laps = 4;
+// Input and overlap-add rings of a frame plus a hop (no profile has a
+// longer ring than max_N at 4 laps), and one frame of scratch. The scratch,
+// which each FFT passes over log2(N) times, is in DTCM, which the FFT reads
+// and writes without wait states (see Fourier); the rings, touched about
+// once per sample, are in SRAM, as all of it wouldn't fit in DTCM
+const size_t buffsize = max_N + max_N / 4;
 
-ShyFFT<float, N, RotationPhasor>* fft;
-Fourier<float, N>* stft;
-Wave<float> hann([] (float phase) -> float { return 0.5 * (1 - cos(2 * PI * phase)); });
+// Spectral state precision (make HALF_STATE=1): by default the overlap-add
+// rings and reverb_energy are floats; in half, they are stored as halves
+// (see hothouse_half.h), which saves 28K at the largest profile (48K in
+// stereo). The rings then hold the output already scaled, with rounding
+// about 66 dB under the signal. reverb_energy holds energy times
+// energy_scale, which leaves a long full-scale tail some 13 dB under the
+// top of the range (stores clamp there), and bins that decay under the
+// smallest normal half are cleared, which ends tails about 60 dB under a
+// full-scale note.
+#ifndef VENUS_HALF_STATE
+#define VENUS_HALF_STATE 0
+#endif
+#if VENUS_HALF_STATE
+typedef half state_t;
+#else
+typedef float state_t;
+#endif
+
+float in[buffsize];
+state_t overlap[buffsize];
+DTCM_MEM_SECTION float middle[max_N], out[max_N];
+state_t reverb_energy[max_N/2];
+float energy_scale = 1, energy_unscale = 1;  // Set for the profile's frame size
+
+inline float loadEnergy(size_t i)
+{
+#if VENUS_HALF_STATE
+    return reverb_energy[i] * energy_unscale;
+#else
+    return reverb_energy[i];
+#endif
+}
+
+inline void storeEnergy(size_t i, float energy)
+{
+#if VENUS_HALF_STATE
+    const float scaled = energy * energy_scale;
+    reverb_energy[i] = scaled < kHalfMin ? 0.0f : (scaled > kHalfMax ? kHalfMax : scaled);
+#else
+    reverb_energy[i] = energy;
+#endif
+}
+
+// STFT frame scheduling (make STFT_AMORTIZED=1): by default the main loop
+// transforms each frame; amortized, the audio callbacks do, a few pieces
+// each: the FFT, one of stft_slices slices of reverb()'s bins, or the
+// inverse FFT. They have to be done by the frame's first read, delay
+// (hop - 1) samples after it completes, which leaves (hop - 1) / block_size
+// callbacks.
+#ifndef VENUS_STFT_AMORTIZED
+#define VENUS_STFT_AMORTIZED 0
+#endif
+const size_t max_block_size = 256;
+size_t block_size = max_block_size;  // From the boot-time audio profile
+const size_t stft_slices = 4;
+float wet_buf[max_block_size + 1];  // The STFT's output for the block
+
+// Stereo wet path (make STEREO=1): each frame's one analysis and energy
+// update drive a second resynthesis at independent random phases, for a
+// decorrelated right channel. It costs a second inverse FFT and
+// overlap-add, plus the right channel's frame and output ring (in SRAM, as
+// DTCM already holds the two frames of scratch and the stack). The left
+// channel is what mono gives.
+#ifndef VENUS_STEREO
+#define VENUS_STEREO 0
+#endif
+#if VENUS_STEREO
+float middle_right[max_N];
+state_t overlap_right[buffsize];
+float wet_buf_right[max_block_size + 1];
+#else
+float* const wet_buf_right = nullptr;  // the STFT then reads no right channel
+#endif
+
+// Codec rate (make RATE_48K=1): by default the whole pedal runs at 32 kHz,
+// where the STFT is tuned. At 48 kHz the dry path keeps the full rate and
+// only the wet path is resampled, 3:2 into the STFT and 2:3 back out. The
+// interpolator's output runs up to one sample ahead of the blocks, and
+// wet_count carries that sample over to the next one.
+#ifndef VENUS_48K
+#define VENUS_48K 0
+#endif
+#if VENUS_48K
+const size_t max_stft_block_size = (max_block_size * 2 + 2) / 3 + 1;  // most decimated samples per block
+size_t stft_block_size = max_stft_block_size;
+Resampler<2, 3, 96> decimator;
+Resampler<3, 2, 96> interpolator;
+float stft_in[max_stft_block_size], stft_out[max_stft_block_size];
+#if VENUS_STEREO
+Resampler<3, 2, 96> interpolator_right;
+float stft_out_right[max_stft_block_size];
+#else
+float* const stft_out_right = nullptr;
+#endif
+size_t wet_count = 0;
+const SaiHandle::Config::SampleRate codec_rate = SaiHandle::Config::SampleRate::SAI_48KHZ;
+#else
+size_t stft_block_size = max_block_size;
+const SaiHandle::Config::SampleRate codec_rate = SaiHandle::Config::SampleRate::SAI_32KHZ;
+#endif
+
+// Block size per boot-time profile (hold both footswitches at power-up);
+// the codec rate is fixed, as the STFT is tuned to it
+const Hothouse::AudioProfileTable audio_profiles = {
+    {{64, codec_rate}, {128, codec_rate}, {max_block_size, codec_rate}},
+    Hothouse::AUDIO_PROFILE_MAX_HEADROOM};
+
+// FFT backend (make FFT_BACKEND=auto|shy|cmsis): auto times ShyFFT and
+// CMSIS-DSP's rfft at boot and keeps the faster. CMSIS's rfft stops at 4096
+// points, so larger frames always use ShyFFT.
+#if VENUS_FFT_BACKEND == 1
+template <size_t N> using FFTBackend = ShyFFT<float, N, RotationPhasor>;
+#elif VENUS_FFT_BACKEND == 2
+template <size_t N> using FFTBackend = typename std::conditional<(N > 4096), ShyFFT<float, N, RotationPhasor>, CmsisFFT<N>>::type;
+#else
+template <size_t N> using FFTBackend = typename std::conditional<(N > 4096), ShyFFT<float, N, RotationPhasor>, SelectableFFT<N>>::type;
+#endif
+
+// The running STFT behind plain functions, so the audio callback and main
+// loop don't depend on its frame size: stft_block writes a block and reads
+// the block back out (to y_right too in stereo), stft_work is step() when
+// amortized, else service()
+void (*stft_block)(const float* x, float* y, float* y_right, size_t size);
+void (*stft_work)();
+
+// Boot benchmark: cycles per transform, the mean of a forward and an
+// inverse, for ShyFFT and CMSIS (0 if not built in)
+uint32_t fft_cycles[2];
+const char* fft_names[2] = {"ShyFFT", "CMSIS"};
+int fft_selected = 0;
+
+// The STFT window, a table in flash
+constexpr Wave<float, Hann> hann{};
+
+// Random phases for the reverb kernel, one draw per bin per frame
+XorShift32 phase_noise;
+#if VENUS_STEREO
+XorShift32 phase_noise_right(0x9e3779b9u);  // The right channel's phases
+#endif
+constexpr PhaseTable<float> phases{};
 
 // Audio processing objects
 SampleRateReducer samplerateReducer;
 Tone lowpass;  // Low Pass for lofi mode
+#if VENUS_STEREO
+SampleRateReducer samplerateReducer_right;
+Tone lowpass_right;
+#endif
 
-// Drift oscillators
-Oscillator drift_osc, drift_osc2, drift_osc3, drift_osc4;
-float drift_multiplier = 1.0, drift_multiplier2 = 1.0;
-float drift_multiplier3 = 1.0, drift_multiplier4 = 1.0;
+// Drift: four LFOs, only read by ProcessControls(), so stepped once per
+// block, each scaling one parameter while toggle 3 is off its middle
+enum DriftDestination { DRIFT_DAMP, DRIFT_SHIMMER, DRIFT_SHIMMER_TONE, DRIFT_DETUNE, DRIFT_COUNT };
+ModMatrix<4, 0, DRIFT_COUNT> drift;
+int drift_routes[DRIFT_COUNT + 1];
+
+// Ducking (make DUCK=1): the wet level drops by up to VENUS_DUCK_DB while
+// the player picks. The level is the dry input's RMS over each block, one
+// step a block of an attack/release follower, so it costs a sum of squares
+// and a square root rather than another analysis; the wet gain ramps from
+// the last block's value to the new one across the block. The duck is full
+// from duck_full (-20 dBFS RMS) up.
+#ifndef VENUS_DUCK
+#define VENUS_DUCK 0
+#endif
+#ifndef VENUS_DUCK_DB
+#define VENUS_DUCK_DB 12
+#endif
+#if VENUS_DUCK
+const float duck_attack_ms = 10.0f, duck_release_ms = 300.0f;
+const float duck_full = 0.1f;
+EnvelopeFollower duck_follower;
+float duck_floor = 1.0f;  // the wet gain at a full duck
+float duck_gain = 1.0f;   // where the last block's ramp ended
+
+// The block's RMS into the follower; returns the wet gain to ramp to
+float updateDuck(const float* in, size_t size)
+{
+    float sum = 0.0f;
+    for (size_t i = 0; i < size; i++) {
+        sum += in[i] * in[i];
+    }
+    const float rms = sqrtf(sum / size);
+    duck_follower.ProcessBlock(&rms, 1, nullptr);
+    const float depth = std::min(1.0f, duck_follower.GetEnvelopeLevel() / duck_full);
+    return 1.0f - depth * (1.0f - duck_floor);
+}
+#endif
 
 // Effect calculation variables
-float fft_size = N / 2;
+float fft_size = 4096 / 2;
 float octave_up_rate_persecond, octave_up_rate_perinterval;
 float shimmer_double, shimmer_triple, shimmer_remainder;
 float detune_rate_persecond, detune_rate_perinterval;
 float detune_double, detune_remainder;
-float window_samples = 32768;
+float window_samples = 8 * 4096;
 float interval_samples = ceil(window_samples/laps);
+// Hop relative to the default profile's; decay per frame is scaled by it
+// so tails last as long (in seconds) with any profile. The wet level goes
+// as 1 / sqrt(N * laps), which amp_scale makes up to the default's.
+float hop_ratio = 1;
+float amp_scale = 1;
 
 void updateSwitch1()
 {
@@ -84,41 +284,45 @@ void updateSwitch2()
     // Original: left=less lofi, center=normal, right=more lofi
     if (toggle2_pos == Hothouse::TOGGLESWITCH_DOWN) {      // case 2 = physical DOWN
         reverb_mode = 0;  // less lofi
-        samplerateReducer.SetFreq(0.3);
+        samplerateReducer.SetFreq(0.3 * stft_rate / samplerate);
         lowpass.SetFreq(8000.0);
+#if VENUS_STEREO
+        samplerateReducer_right.SetFreq(0.3 * stft_rate / samplerate);
+        lowpass_right.SetFreq(8000.0);
+#endif
     } else if (toggle2_pos == Hothouse::TOGGLESWITCH_MIDDLE) { // case 1 = physical MIDDLE
         reverb_mode = 1;  // normal
     } else if (toggle2_pos == Hothouse::TOGGLESWITCH_UP) {     // case 0 = physical UP
         reverb_mode = 2;  // more lofi
-        samplerateReducer.SetFreq(0.2);
+        samplerateReducer.SetFreq(0.2 * stft_rate / samplerate);
+#if VENUS_STEREO
+        samplerateReducer_right.SetFreq(0.2 * stft_rate / samplerate);
+#endif
     }
 }
 
 void updateSwitch3()
 {
     // Original: left=slower drift, center=no drift, right=faster drift
+    static const float slow_freqs[4] = {0.009f, 0.01f, 0.011f, 0.012f};
+    static const float fast_freqs[4] = {0.020f, 0.025f, 0.03f, 0.035f};
     if (toggle3_pos == Hothouse::TOGGLESWITCH_DOWN) {      // case 2 = physical DOWN
         drift_mode = 0;  // slower drift
-        drift_osc.SetFreq(0.009);
-        drift_osc.SetWaveform(0);  // WAVE_SIN
-        drift_osc2.SetFreq(0.01);
-        drift_osc2.SetWaveform(0);
-        drift_osc3.SetFreq(0.011);
-        drift_osc3.SetWaveform(0);
-        drift_osc4.SetFreq(0.012);
-        drift_osc4.SetWaveform(0);
+        for (size_t i = 0; i < 4; i++) {
+            drift.lfo(i).SetFreq(slow_freqs[i]);
+            drift.lfo(i).SetWaveform(ModLfo::WAVE_SIN);
+        }
     } else if (toggle3_pos == Hothouse::TOGGLESWITCH_MIDDLE) { // case 1 = physical MIDDLE
         drift_mode = 1;  // no drift
     } else if (toggle3_pos == Hothouse::TOGGLESWITCH_UP) {     // case 0 = physical UP
         drift_mode = 2;  // faster drift
-        drift_osc.SetFreq(0.020);
-        drift_osc.SetWaveform(1);  // WAVE_TRI
-        drift_osc2.SetFreq(0.025);
-        drift_osc2.SetWaveform(1);
-        drift_osc3.SetFreq(0.03);
-        drift_osc3.SetWaveform(1);
-        drift_osc4.SetFreq(0.035);
-        drift_osc4.SetWaveform(1);
+        for (size_t i = 0; i < 4; i++) {
+            drift.lfo(i).SetFreq(fast_freqs[i]);
+            drift.lfo(i).SetWaveform(ModLfo::WAVE_TRI);
+        }
+    }
+    for (int route : drift_routes) {
+        drift.SetEnabled(route, drift_mode != 1);
     }
 }
 
@@ -129,7 +333,7 @@ void ProcessControls()
     // Process footswitches - matching original behavior
     if(hw.switches[Hothouse::FOOTSWITCH_1].RisingEdge()) {
         bypass = !bypass;
-        led1.Set(bypass ? 0.0f : 1.0f);
+        hw.SetLed(Hothouse::LED_1, bypass ? 0.0f : 1.0f);
     }
     
     // Freeze on footswitch 2 press (momentary)
@@ -138,7 +342,7 @@ void ProcessControls()
     } else {
         freeze = false;
     }
-    led2.Set(freeze ? 1.0f : 0.0f);
+    hw.SetLed(Hothouse::LED_2, hw.LoadLed(freeze ? 1.0f : 0.0f));
     
     // Process toggle switches
     toggle1_pos = hw.GetToggleswitchPosition(Hothouse::TOGGLESWITCH_1);
@@ -155,10 +359,16 @@ void ProcessControls()
         prev_toggle2_pos = toggle2_pos;
     }
     
+    // Shimmer and detune follow K4-K6, and the drift LFOs while they run;
+    // otherwise they only need working out again when one of those moves
+    bool derive = first_start;
     if (toggle3_pos != prev_toggle3_pos || first_start) {
         updateSwitch3();
         prev_toggle3_pos = toggle3_pos;
+        derive = true;
     }
+    derive = derive || drift_mode != 1 || hw.KnobChanged(Hothouse::KNOB_4) ||
+             hw.KnobChanged(Hothouse::KNOB_5) || hw.KnobChanged(Hothouse::KNOB_6);
     
     first_start = false;
     
@@ -169,7 +379,7 @@ void ProcessControls()
     
     // CRITICAL: Apply exponential curve to damp (matches original Parameter::EXPONENTIAL)
     float raw_damp = hw.GetKnobValue(Hothouse::KNOB_3);
-    knobValues[2] = powf(raw_damp, 2.0f);  // Exponential approximation
+    knobValues[2] = KnobSquare(raw_damp);  // Exponential approximation
     
     knobValues[3] = hw.GetKnobValue(Hothouse::KNOB_4);  // Linear for shimmer
     knobValues[4] = hw.GetKnobValue(Hothouse::KNOB_5);  // Linear for shimmer_tone
@@ -186,14 +396,23 @@ void ProcessControls()
     float vdetune_temp = (knobValues[5] - 0.5f) * 0.3f;  // Maps 0-1 to -0.15 to +0.15
     vdetune = abs(vdetune_temp);  // Take absolute value like original
     
-    // Apply drift automation (matching original exactly)
-    if (drift_mode == 0 || drift_mode == 2) {
-        vdamp = vdamp * abs(drift_multiplier) * 0.7f + 0.3f;
-        vshimmer *= abs(drift_multiplier2);
-        vshimmer_tone *= abs(drift_multiplier3);
-        vdetune *= abs(drift_multiplier4);  // If detune set to noon, this should have no effect
+    // Apply drift automation (matching original exactly); with detune at
+    // noon its drift has no effect
+    drift.SetBase(DRIFT_DAMP, vdamp);
+    drift.SetBase(DRIFT_SHIMMER, vshimmer);
+    drift.SetBase(DRIFT_SHIMMER_TONE, vshimmer_tone);
+    drift.SetBase(DRIFT_DETUNE, vdetune);
+    drift.Update();
+    vdamp = drift.Value(DRIFT_DAMP);
+    
+    if (!derive) {
+        return;
     }
     
+    vshimmer = drift.Value(DRIFT_SHIMMER);
+    vshimmer_tone = drift.Value(DRIFT_SHIMMER_TONE);
+    vdetune = drift.Value(DRIFT_DETUNE);
+    
     // Calculate detune mode (matching original logic exactly)
     if (vdetune > 0.03f) {  // gives a 10% knob range at noon for no detuning
         vdetune = vdetune - 0.029f;  // account for reduced range
@@ -209,148 +428,412 @@ void ProcessControls()
     }
     
     // Calculate shimmer parameters (exact original formulas)
-    octave_up_rate_persecond = std::pow(8.0f, vshimmer) - 1;
-    octave_up_rate_perinterval = std::min(0.75f, octave_up_rate_persecond/samplerate*interval_samples);
+    octave_up_rate_persecond = fastmath::Exp2(3.0f * vshimmer) - 1;
+    octave_up_rate_perinterval = std::min(0.75f, octave_up_rate_persecond/stft_rate*interval_samples);
     
     // Make 5ths independent of shimmer control
-    float octave_up_rate_persecond2 = std::pow(8.0f, vshimmer_tone) - 1;
-    float octave_up_rate_perinterval2 = std::min(0.75f, octave_up_rate_persecond2/samplerate*interval_samples);
+    float octave_up_rate_persecond2 = fastmath::Exp2(3.0f * vshimmer_tone) - 1;
+    float octave_up_rate_perinterval2 = std::min(0.75f, octave_up_rate_persecond2/stft_rate*interval_samples);
     
     shimmer_double = octave_up_rate_perinterval*(1 - vshimmer_tone/1.58f);
     shimmer_triple = (octave_up_rate_perinterval2/1.58f) * vshimmer_tone;
     shimmer_remainder = (1 - shimmer_double - shimmer_triple);
     
-    detune_rate_persecond = std::pow(8.0f, vdetune) - 1;
-    detune_rate_perinterval = std::min(0.75f, detune_rate_persecond/samplerate*interval_samples);
+    detune_rate_persecond = fastmath::Exp2(3.0f * vdetune) - 1;
+    detune_rate_perinterval = std::min(0.75f, detune_rate_persecond/stft_rate*interval_samples);
     detune_double = detune_rate_perinterval;
     detune_remainder = 1 - detune_double;
 }
 
-void AudioCallback(AudioHandle::InputBuffer in_buf, AudioHandle::OutputBuffer out_buf, size_t size)
+// The lofi modes on one channel of the wet signal
+inline float lofi(float wet, SampleRateReducer& reducer, Tone& filter)
+{
+    if (reverb_mode == 0) {  // less lofi
+        return filter.Process(reducer.Process(wet));
+    } else if (reverb_mode == 2) {  // more lofi
+        return reducer.Process(wet);
+    }
+    return wet;  // normal
+}
+
+HOTHOUSE_ITCM void AudioCallback(AudioHandle::InputBuffer in_buf, AudioHandle::OutputBuffer out_buf, size_t size)
 {
     // Update LEDs at start of callback (matching original)
-    led1.Update();
-    led2.Update();
     
     ProcessControls();
-    
+
+    // Full CPU clock back before any DSP (make POWER_SAVE=1)
+    hw.SetBypassed(bypass);
+    if(!bypass) {
+        // The block through the STFT
+#if VENUS_48K
+        const size_t decimated = decimator.process(in_buf[0], size, stft_in);
+        stft_block(stft_in, stft_out, stft_out_right, decimated);
+#if VENUS_STEREO
+        interpolator_right.process(stft_out_right, decimated, wet_buf_right + wet_count);
+#endif
+        wet_count += interpolator.process(stft_out, decimated, wet_buf + wet_count);
+#else
+        stft_block(in_buf[0], wet_buf, wet_buf_right, size);
+#endif
+    }
+
+    // Process drift oscillators, for the next block's controls
+    drift.Advance(size);
+
+#if VENUS_DUCK
+    // vmix times the duck, stepped over the block
+    const float duck_target = bypass ? duck_gain : updateDuck(in_buf[0], size);
+    float wet_level = vmix * duck_gain;
+    const float wet_step = vmix * (duck_target - duck_gain) / size;
+    duck_gain = duck_target;
+#endif
+
     for(size_t i = 0; i < size; i++) {
-        // Process drift oscillators
-        drift_multiplier = drift_osc.Process();
-        drift_multiplier2 = drift_osc2.Process();
-        drift_multiplier3 = drift_osc3.Process();
-        drift_multiplier4 = drift_osc4.Process();
-        
         if(bypass) {
             out_buf[0][i] = in_buf[0][i];
             out_buf[1][i] = in_buf[1][i];
         } else {
-            stft->write(in_buf[0][i]);  // put a new sample in the STFT
-            
-            float wet = 0.0;
-            if (reverb_mode == 0) {  // less lofi
-                wet = lowpass.Process(samplerateReducer.Process(stft->read()));
-            } else if (reverb_mode == 1) {  // normal
-                wet = stft->read();
-            } else if (reverb_mode == 2) {  // more lofi
-                wet = samplerateReducer.Process(stft->read());
-            }
+            float wet = lofi(wet_buf[i], samplerateReducer, lowpass);
+#if VENUS_DUCK
+            wet_level += wet_step;
+#else
+            const float wet_level = vmix;
+#endif
             
             // Mix wet and dry signals
-            out_buf[0][i] = wet * vmix + in_buf[0][i] * (1.0f - vmix);
+            out_buf[0][i] = wet * wet_level + in_buf[0][i] * (1.0f - vmix);
+#if VENUS_STEREO
+            float wet_right = lofi(wet_buf_right[i], samplerateReducer_right, lowpass_right);
+            out_buf[1][i] = wet_right * wet_level + in_buf[0][i] * (1.0f - vmix);
+#else
             out_buf[1][i] = out_buf[0][i];  // Mono processing
+#endif
         }
     }
+
+#if VENUS_48K
+    if(!bypass) {
+        wet_count -= size;
+        memmove(wet_buf, wet_buf + size, sizeof(float) * wet_count);
+#if VENUS_STEREO
+        memmove(wet_buf_right, wet_buf_right + size, sizeof(float) * wet_count);
+#endif
+    }
+#endif
+
+#if VENUS_STFT_AMORTIZED
+    stft_work();
+#endif
+}
+
+// Energy each bin hands on to the shimmer, octave-down, fifth and detune
+// targets, by frame parity: the bins of one frame write theirs, and the next
+// frame's gather into each bin reads them. Only bins below
+// spill_limit (set for the profile) scatter.
+int spill_limit = 4096 / 4 - 2;
+float reverb_spill[2][max_N/4];
+size_t spill_parity = 0;
+
+// Freeze as latched for the frame being transformed. A frozen frame skips
+// its forward FFT, since the kernel then only synthesizes from the
+// reverb_energy it holds, which saves about a third of the frame's work.
+bool frame_frozen = false;
+
+bool analyzeFrame()
+{
+    frame_frozen = freeze;
+    return !frame_frozen;
 }
 
-// Reverb processing function
-inline void reverb(const float* in_freq, float* out_freq)
+// A source's spilled energy, or 0 outside the bins [lo, hi) that scatter
+inline float spilled(const float* spill, int i, int lo = 1, int hi = spill_limit)
+{
+    return (i >= lo && i < hi) ? spill[i] : 0;
+}
+
+// The energy the previous frame's scatter sends into bin j, gathered from
+// the bins that target it, so no bin depends on the order bins are visited
+inline float gatherSpill(const float* spill, int j)
+{
+    float sum = 0;
+
+    // Morph reverb up by octaves up or down
+    if (shimmer_mode == 1 || shimmer_mode == 2) {  // up octave, from j/2
+        if (j % 2)
+            sum += 0.123f*shimmer_double*(spilled(spill, (j - 1)/2) + spilled(spill, (j + 1)/2));
+        else
+            sum += 0.25f*shimmer_double*spilled(spill, j/2);
+    } else if (shimmer_mode == 0) {  // down octave, from even bins past 1
+        sum += 0.75f*shimmer_double*(spilled(spill, 2*j - 2, 2) + spilled(spill, 2*j + 2, 2));
+        sum += 1.5f*shimmer_double*spilled(spill, 2*j, 2);
+    }
+
+    // Morph reverb up by octave+5th, from bins i with 3*i + 1 < N/4
+    const int fifth_limit = (stft_size / 4 + 1) / 3;
+    switch (j % 3) {
+        case 0:
+            sum += 0.17f*shimmer_triple*spilled(spill, j/3, 1, fifth_limit);
+            break;
+        case 1:
+            sum += 0.11f*shimmer_triple*spilled(spill, (j - 1)/3, 1, fifth_limit);
+            sum += 0.055f*shimmer_triple*spilled(spill, (j + 2)/3, 1, fifth_limit);
+            break;
+        case 2:
+            sum += 0.105f*shimmer_triple*spilled(spill, (j - 2)/3, 1, fifth_limit);
+            sum += 0.11f*shimmer_triple*spilled(spill, (j + 1)/3, 1, fifth_limit);
+            break;
+    }
+
+    // Detune up or down based on detune knob, from bins past 2
+    if (detune_mode != 1) {
+        sum += 0.123f*detune_double*spilled(spill, j - 3*detune_multiplier, 3);
+        sum += 0.25f*detune_double*spilled(spill, j - 2*detune_multiplier, 3);
+        sum += 0.123f*detune_double*spilled(spill, j - 1*detune_multiplier, 3);
+    }
+
+    return sum;
+}
+
+// Reverb processing function, over bins [begin, end). Running consecutive
+// ranges in order is the same as one pass over all N / 2 bins. Each bin
+// first gathers what the previous frame scattered into it, then leaves its
+// own spill for the next frame, so bins are independent within a frame.
+// In stereo, the right channel's bins go over in_freq once each is read.
+inline void reverb_bins(float* in_freq, float* out_freq, size_t begin, size_t end)
 {
     // convenient constant for grabbing imaginary parts
-    static const size_t offset = N / 2;
-    
-    for (size_t i = 0; i < N / 2; i++) {
+    const size_t offset = stft_size / 2;
+
+    if (begin == 0)
+        spill_parity ^= 1;
+    const float* spill_in = reverb_spill[spill_parity ^ 1];
+    float* spill_out = reverb_spill[spill_parity];
+
+    // Decay and remainder factors, the same for every bin; the decay is
+    // per default-profile hop
+    float reverb_decay_factor = 1.0f/vdecay;
+    float reverb_keep = fastmath::Pow(1.0f - reverb_decay_factor, hop_ratio);
+    if (detune_mode == 1)
+        detune_remainder = 1;
+    
+    for (size_t i = begin; i < end; i++) {
         float fft_bin = i + 1;
-        float real = in_freq[i];
-        float imag = in_freq[i + offset];
-        float energy = real * real + imag * imag;
+
+        float bin_energy = loadEnergy(i) + gatherSpill(spill_in, i);
         
         // Amplitude from energy
-        float reverb_amp = sqrt(reverb_energy[i]);
+        float reverb_amp = fastSqrt(bin_energy) * amp_scale;
         if (fft_bin / fft_size > vdamp) {
             // Reduce amplitude by 1/f
             reverb_amp *= vdamp * fft_size/fft_bin;
         }
         
-        // Add random phase reverb energy
-        // CRITICAL: Match original - no division by RAND_MAX
-        float random_phase = rand()*2*PI;
-        real = reverb_amp * cos(random_phase);
-        imag = reverb_amp * sin(random_phase);
+        // Add random phase reverb energy. The original's rand()*2*PI, taken
+        // as a float, is just a scrambled angle; a uniform one drawn from the
+        // table sounds the same without the libm calls
+        uint32_t draw = phase_noise.next();
+        const float real = reverb_amp * phases.cosine(draw);
+        const float imag = reverb_amp * phases.sine(draw);
         
-        // If frozen, don't add new energy or decay the reverb
-        if (!freeze) {
+        // If frozen, don't add new energy or decay the reverb; the frame
+        // wasn't analyzed, so there is no input spectrum to read
+        float current = 0;
+        if (!frame_frozen) {
+            float energy = in_freq[i] * in_freq[i] + in_freq[i + offset] * in_freq[i + offset];
+
             // Add current energy to reverb
-            reverb_energy[i] += energy / laps;  // laps=4 "overlap factor"
+            bin_energy += energy / laps;  // laps=4 "overlap factor"
             
             // Decay reverb
-            float reverb_decay_factor = 1.0f/vdecay;
-            reverb_energy[i] *= 1.0f - reverb_decay_factor;
-            
-            float half_fft_size = fft_size/2;
-            float current = reverb_energy[i];
-            
-            if (i > 0 && i < half_fft_size - 2) {  // Prevents accessing outside of array index
-                // Morph reverb up by octaves up or down
-                if (shimmer_mode == 1 || shimmer_mode == 2) {  // up octave
-                    reverb_energy[2*i - 1] += 0.123f*shimmer_double*current;
-                    reverb_energy[2*i] += 0.25f*shimmer_double*current;
-                    reverb_energy[2*i + 1] += 0.123f*shimmer_double*current;
-                } else if ((shimmer_mode == 0 || shimmer_mode == 2) && i > 1 && !(i % 2)) {  // down octave
-                    reverb_energy[i/2 - 1] += 0.75f*shimmer_double*current;
-                    reverb_energy[i/2] += 1.5f*shimmer_double*current;
-                    reverb_energy[i/2 + 1] += 0.75f*shimmer_double*current;
-                }
-                
-                // Morph reverb up by octave+5th
-                if (3*i + 1 < half_fft_size) {
-                    reverb_energy[3*i - 2] += 0.055f*shimmer_triple*current;
-                    reverb_energy[3*i - 1] += 0.11f*shimmer_triple*current;
-                    reverb_energy[3*i] += 0.17f*shimmer_triple*current;
-                    reverb_energy[3*i + 1] += 0.11f*shimmer_triple*current;
-                    reverb_energy[3*i + 2] += 0.105f*shimmer_triple*current;
-                }
-                
-                // Detune up or down based on detune knob
-                if (i > 2 && i < half_fft_size - 2 && detune_mode != 1) {
-                    reverb_energy[i + (3*detune_multiplier)] += 0.123f*detune_double*current;
-                    reverb_energy[i + (2*detune_multiplier)] += 0.25f*detune_double*current;
-                    reverb_energy[i + (1*detune_multiplier)] += 0.123f*detune_double*current;
-                }
-            }
+            bin_energy *= reverb_keep;
+            current = bin_energy;
             
-            // Apply remainder factors
-            if (detune_mode == 1)
-                detune_remainder = 1;
-            reverb_energy[i] = detune_remainder * shimmer_remainder * current;
+            // Apply remainder factors; the rest spills to other bins
+            bin_energy = detune_remainder * shimmer_remainder * current;
         }
+        storeEnergy(i, bin_energy);
+        if (i < offset / 2)
+            spill_out[i] = current;
         
         out_freq[i] = real;
         out_freq[i + offset] = imag;
+#if VENUS_STEREO
+        // The same amplitude at the right channel's own phase
+        uint32_t draw_right = phase_noise_right.next();
+        in_freq[i] = reverb_amp * phases.cosine(draw_right);
+        in_freq[i + offset] = reverb_amp * phases.sine(draw_right);
+#endif
+    }
+}
+
+inline void reverb(float* in_freq, float* out_freq)
+{
+    reverb_bins(in_freq, out_freq, 0, stft_size / 2);
+}
+
+// Cycles per transform, timed on the STFT buffers before audio starts. The
+// transforms' timing doesn't depend on the data, so one windowed test frame,
+// built in out, is copied in for every run rather than recomputed.
+template <size_t N, typename Backend>
+uint32_t benchmarkFFT(Backend& backend)
+{
+    const int runs = 8;
+    uint32_t cycles = 0;
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    for (size_t i = 0; i < N; i++) {
+        out[i] = hann((float)i / N) * sinf(0.05f * i);
+    }
+    for (int r = 0; r < runs; r++) {
+        std::copy(out, out + N, in);
+        uint32_t start = DWT->CYCCNT;
+        backend.Direct(in, middle);
+        backend.Inverse(middle, in);
+        cycles += DWT->CYCCNT - start;
+    }
+
+    std::fill(in, in + N, 0.0f);
+    std::fill(middle, middle + N, 0.0f);
+    std::fill(out, out + N, 0.0f);
+    return cycles / (2 * runs);
+}
+
+// Boot benchmark of the backend built for frames of N; with both built,
+// keeps the faster
+template <size_t N>
+void benchmarkBackends(ShyFFT<float, N, RotationPhasor>& fft)
+{
+    fft_cycles[0] = benchmarkFFT<N>(fft);
+    fft_selected = 0;
+}
+
+#if VENUS_FFT_BACKEND != 1
+template <size_t N>
+void benchmarkBackends(CmsisFFT<N>& fft)
+{
+    fft_cycles[1] = benchmarkFFT<N>(fft);
+    fft_selected = 1;
+}
+
+template <size_t N>
+void benchmarkBackends(SelectableFFT<N>& fft)
+{
+    fft.Select(SelectableFFT<N>::SHY);
+    fft_cycles[0] = benchmarkFFT<N>(fft);
+    fft.Select(SelectableFFT<N>::CMSIS);
+    fft_cycles[1] = benchmarkFFT<N>(fft);
+    fft.Select(fft_cycles[1] < fft_cycles[0] ? SelectableFFT<N>::CMSIS : SelectableFFT<N>::SHY);
+    fft_selected = fft.Selected();
+}
+#endif
+
+// The STFT at frames of N: its FFT, and the Fourier on the shared buffers
+template <size_t N> struct Stft
+{
+    FFTBackend<N> fft;
+    Fourier<float, N, FFTBackend<N>, state_t> fourier;
+
+    Stft(size_t laps) : fourier(reverb, &fft, hann, laps, in, middle, out, overlap) { }
+};
+
+// Room for whichever Stft the profile builds, so none is on the heap
+typename std::aligned_union<0, Stft<2048>, Stft<4096>, Stft<8192>>::type stft_storage;
+
+template <size_t N> Stft<N>& stftAt()
+{
+    return *reinterpret_cast<Stft<N>*>(&stft_storage);
+}
+
+template <size_t N> void stftBlock(const float* x, float* y, float* y_right, size_t size)
+{
+    stftAt<N>().fourier.write(x, size);
+    stftAt<N>().fourier.read(y, y_right, size);
+}
+
+template <size_t N> void stftWork()
+{
+#if VENUS_STFT_AMORTIZED
+    stftAt<N>().fourier.step();
+#else
+    stftAt<N>().fourier.service();
+#endif
+}
+
+// Builds the STFT for frames of N in stft_storage and points stft_block and
+// stft_work at it
+template <size_t N> void startStft(size_t laps)
+{
+    Stft<N>* stft = new (&stft_storage) Stft<N>(laps);
+    stft->fourier.analyze = analyzeFrame;
+#if VENUS_STEREO
+    stft->fourier.stereo(middle_right, overlap_right);
+#endif
+    stft->fft.Init();
+    benchmarkBackends(stft->fft);
+#if VENUS_STFT_AMORTIZED
+    stft->fourier.amortize(reverb_bins, stft_slices, (stft->fourier.stride - 1) / stft_block_size);
+#endif
+
+    stft_size = N;
+    stft_block = stftBlock<N>;
+    stft_work = stftWork<N>;
+}
+
+// STFT profiles, trading latency and CPU for smoothness. Holding FOOTSWITCH
+// 2 at power-on picks one by TOGGLE 1's position (up: low latency, middle:
+// lush, down: ambient); otherwise the quality level picks: Eco the half
+// size frames, Normal the default, High the doubled overlap.
+struct StftProfile
+{
+    const char* name;
+    size_t laps;
+    void (*start)(size_t laps);
+};
+const StftProfile stft_profiles[] = {
+    {"low latency (2048 x 4)", 4, startStft<2048>},
+    {"default (4096 x 4)", 4, startStft<4096>},
+    {"lush (4096 x 8)", 8, startStft<4096>},
+    {"ambient (8192 x 4)", 4, startStft<8192>},
+};
+size_t stft_profile = 1;
+
+#ifdef VENUS_FFT_REPORT
+// Prints the boot benchmark over USB serial every two seconds
+void reportFFT()
+{
+    static uint32_t last_report = 0;
+    const uint32_t now = System::GetNow();
+    if (now - last_report < 2000)
+        return;
+    last_report = now;
+
+    for (int b = 0; b < 2; b++) {
+        if (fft_cycles[b])
+            hw.seed.PrintLine("%s: %lu cycles per transform", fft_names[b], (unsigned long)fft_cycles[b]);
     }
+#if VENUS_FFT_BACKEND == 0
+    hw.seed.PrintLine("Using %s", fft_names[fft_selected]);
+#endif
+    hw.seed.PrintLine("Profile: %s", stft_profiles[stft_profile].name);
 }
+#endif
 
 int main(void)
 {
     hw.Init();
-    hw.SetAudioSampleRate(SaiHandle::Config::SampleRate::SAI_32KHZ);
+    hw.SelectAudioProfile(audio_profiles);  // 256 by default, matching original
     samplerate = hw.AudioSampleRate();
-    hw.SetAudioBlockSize(256);  // Matching original
-    
-    // Initialize reverb energy array
-    for (size_t i = 0; i < N / 2; i++) {
-        reverb_energy[i] = 0.0;
-    }
+    block_size = hw.AudioBlockSize();
+#if VENUS_48K
+    stft_rate = samplerate * 2 / 3;
+    stft_block_size = (block_size * 2 + 2) / 3 + 1;
+#else
+    stft_rate = samplerate;
+    stft_block_size = block_size;
+#endif
     
     // Initialize toggle positions to unknown
     prev_toggle1_pos = Hothouse::TOGGLESWITCH_UNKNOWN;
@@ -362,30 +845,69 @@ int main(void)
     led2.Init(hw.seed.GetPin(Hothouse::LED_2), false);
     led1.Update();
     led2.Update();
+    hw.StartLedService();
     
     // Set initial bypass state
     bypass = true;
     
-    // Initialize FFT and STFT objects
-    fft = new ShyFFT<float, N, RotationPhasor>();
-    fft->Init();
-    stft = new Fourier<float, N>(reverb, fft, &hann, laps, in, middle, out);
+    // FOOTSWITCH 2 held at power-on picks the STFT profile with TOGGLE 1
+    // (SelectAudioProfile() has settled the switches), over the quality's
+    static const size_t quality_profiles[Hothouse::QUALITY_LAST] = {0, 1, 2};
+    stft_profile = quality_profiles[hw.GetQuality()];
+    if (hw.switches[Hothouse::FOOTSWITCH_2].Pressed()) {
+        Hothouse::ToggleswitchPosition position = hw.GetToggleswitchPosition(Hothouse::TOGGLESWITCH_1);
+        if (position == Hothouse::TOGGLESWITCH_UP) {
+            stft_profile = 0;  // low latency
+        } else if (position == Hothouse::TOGGLESWITCH_MIDDLE) {
+            stft_profile = 2;  // lush
+        } else if (position == Hothouse::TOGGLESWITCH_DOWN) {
+            stft_profile = 3;  // ambient
+        }
+    }
+
+    // Initialize FFT and STFT objects for the profile, and the effect
+    // variables that follow its frame size and hop
+    laps = stft_profiles[stft_profile].laps;
+    stft_profiles[stft_profile].start(laps);
+    hw.BootMark("STFT");
+    fft_size = stft_size / 2;
+    spill_limit = stft_size / 4 - 2;
+    window_samples = 8 * stft_size;
+    interval_samples = ceil(window_samples/laps);
+    hop_ratio = (stft_size / laps) / 1024.0f;
+    amp_scale = sqrtf(stft_size * laps / 16384.0f);
+    // A full-scale sine peaks a bin at about (N / 4)^2
+    energy_scale = 2048.0f / ((float)stft_size * stft_size);
+    energy_unscale = 1.0f / energy_scale;
     
     // Initialize audio processing objects
     samplerateReducer.Init();
-    samplerateReducer.SetFreq(0.3);
+    samplerateReducer.SetFreq(0.3 * stft_rate / samplerate);
     lowpass.Init(samplerate);
     lowpass.SetFreq(8000.0);
-    
-    // Initialize drift oscillators
-    drift_osc.Init(samplerate);
-    drift_osc.SetAmp(1.0);
-    drift_osc2.Init(samplerate);
-    drift_osc2.SetAmp(1.0);
-    drift_osc3.Init(samplerate);
-    drift_osc3.SetAmp(1.0);
-    drift_osc4.Init(samplerate);
-    drift_osc4.SetAmp(1.0);
+#if VENUS_STEREO
+    samplerateReducer_right.Init();
+    samplerateReducer_right.SetFreq(0.3 * stft_rate / samplerate);
+    lowpass_right.Init(samplerate);
+    lowpass_right.SetFreq(8000.0);
+#endif
+    
+    // Drift: damp * |lfo 0| * 0.7 + 0.3, and the other three times |their lfo|;
+    // the multipliers are 1 until the LFOs have stepped a block
+    drift.Init(samplerate);
+#if VENUS_DUCK
+    // Stepped once a block, so its times are at the block rate
+    duck_follower.Init(samplerate / block_size, duck_attack_ms, duck_release_ms);
+    duck_floor = powf(10.0f, -(float)VENUS_DUCK_DB / 20.0f);
+#endif
+    drift_routes[0] = drift.Connect(drift.Lfo(0), DRIFT_DAMP, 0.7f, ModShape::kRectified, ModOp::kScale);
+    drift_routes[1] = drift.Connect(drift.kOne, DRIFT_DAMP, 0.3f);
+    for (size_t i = 1; i < 4; i++) {
+        drift_routes[i + 1] = drift.Connect(drift.Lfo(i), i, 1.0f, ModShape::kRectified, ModOp::kScale);
+    }
+    for (size_t i = 0; i < 4; i++) {
+        drift.SetSource(drift.Lfo(i), 1.0f);
+    }
     
     // Set initial parameter values to match original
     vdecay = 10;
@@ -395,16 +917,51 @@ int main(void)
     vshimmer_tone = 0.0;
     vdetune = 0.0;
     
+    // The decaying spectral reverb, for make DENORMAL_CHECK=1
+#if !VENUS_HALF_STATE
+    hw.WatchDenormals(reverb_energy, max_N / 2, "reverb_energy");
+#endif
+
     hw.StartAdc();
+#ifdef VENUS_FFT_REPORT
+    hw.StartLog(); // don't wait for a serial monitor
+#endif
     hw.StartAudio(AudioCallback);
     
     while(1) {
+        // CPU load over USB serial (make LOAD_METER=1)
+        hw.ServiceLoadMeter();
+        // Callback overruns over USB serial and into QSPI (make WATCHDOG=1)
+        hw.ServiceWatchdog();
+        // Time to each boot phase over USB serial (make BOOT_TIMING=1)
+        hw.ServiceBootTiming();
+        // Heap allocations inside the audio callback over USB serial (make ALLOC_CHECK=1)
+        hw.ServiceAllocCheck();
+        // Stack and heap high-water marks over USB serial (make MEMORY_REPORT=1)
+        hw.ServiceMemoryReport();
+        // Subnormals and NaNs in the callback and the reverb (make DENORMAL_CHECK=1)
+        hw.ServiceDenormalCheck();
+        // Half the CPU clock after 5 s in bypass (make POWER_SAVE=1)
+        hw.ServicePower();
+        // Signal probes armed and dumped over USB serial (make PROBE=1)
+        hw.ServiceProbes();
+        // Round-trip latency through a loopback cable (make LATENCY_TEST=1)
+        hw.ServiceLatencyTest();
+        // The reports above as binary records over USB serial (make TELEMETRY=1)
+        hw.ServiceTelemetry();
+
+#if !VENUS_STFT_AMORTIZED
+        // Transform the STFT frames the audio callback has queued
+        stft_work();
+#endif
+
+#ifdef VENUS_FFT_REPORT
+        reportFFT();
+#endif
+
         // Check for Hothouse built-in DFU entry method
         hw.CheckResetToBootloader();
         
-        hw.DelayMs(1);
+        hw.IdleMs(1);
     }
-    
-    delete stft;
-    delete fft;
 }
\ No newline at end of file
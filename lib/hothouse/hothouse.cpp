@@ -0,0 +1,2152 @@
+// Hardware proxy for Hothouse DIY DSP Platform
+// Copyright (C) 2024  Cleveland Music Co.  <code@clevelandmusicco.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "hothouse.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <new>
+
+#if HOTHOUSE_MEMORY_REPORT && defined(__arm__)
+#include <malloc.h>
+#endif
+#if HOTHOUSE_DENORMAL_CHECK && !defined(__arm__)
+#include <cfenv>
+#endif
+
+#include "hothouse_arena.h"
+#include "hothouse_fastmath.h"
+#include "optional"
+
+using clevelandmusicco::Hothouse;
+using daisy::PersistentStorage;
+using daisy::System;
+
+#ifndef SAMPLE_RATE
+// #define SAMPLE_RATE DSY_AUDIO_SAMPLE_RATE
+#define SAMPLE_RATE 48014.f
+#endif
+
+// Hardware related defines.
+// Switches
+constexpr Pin PIN_SW_1_UP = daisy::seed::D9;
+constexpr Pin PIN_SW_1_DOWN = daisy::seed::D10;
+constexpr Pin PIN_SW_2_UP = daisy::seed::D7;
+constexpr Pin PIN_SW_2_DOWN = daisy::seed::D8;
+constexpr Pin PIN_SW_3_UP = daisy::seed::D5;
+constexpr Pin PIN_SW_3_DOWN = daisy::seed::D6;
+constexpr Pin PIN_FSW_1 = daisy::seed::D25;
+constexpr Pin PIN_FSW_2 = daisy::seed::D26;
+
+// Knobs
+constexpr Pin PIN_KNOB_1 = daisy::seed::D16;
+constexpr Pin PIN_KNOB_2 = daisy::seed::D17;
+constexpr Pin PIN_KNOB_3 = daisy::seed::D18;
+constexpr Pin PIN_KNOB_4 = daisy::seed::D19;
+constexpr Pin PIN_KNOB_5 = daisy::seed::D20;
+constexpr Pin PIN_KNOB_6 = daisy::seed::D21;
+
+const uint32_t Hothouse::HOLD_THRESHOLD_MS;
+
+#if HOTHOUSE_ALLOC_CHECK
+#ifndef HOTHOUSE_ALLOC_WRAP
+#define HOTHOUSE_ALLOC_WRAP 0  // hothouse.mk wraps malloc, calloc and realloc
+#endif
+
+// Whether this thread is inside the audio callback. The Seed has no threads
+// (the callback is an interrupt, and the main loop never allocates inside
+// it); the host harness runs the main loop and the callback on two.
+#if defined(__arm__)
+static bool in_audio_callback = false;
+#else
+static thread_local bool in_audio_callback = false;
+#endif
+static std::atomic<uint32_t> audio_allocations{0};
+static std::atomic<void *> first_audio_allocation{nullptr};
+
+static void NoteAllocation(void *caller) {
+  if (!in_audio_callback) {
+    return;
+  }
+#if HOTHOUSE_ALLOC_CHECK >= 2
+  (void)caller;
+  __builtin_trap();
+#else
+  void *none = nullptr;
+  first_audio_allocation.compare_exchange_strong(none, caller,
+                                                 std::memory_order_relaxed);
+  audio_allocations.fetch_add(1, std::memory_order_relaxed);
+#endif
+}
+
+#if HOTHOUSE_ALLOC_WRAP
+extern "C" void *__real_malloc(size_t size);
+extern "C" void *__real_calloc(size_t count, size_t size);
+extern "C" void *__real_realloc(void *ptr, size_t size);
+
+extern "C" void *__wrap_malloc(size_t size) {
+  NoteAllocation(__builtin_return_address(0));
+  return __real_malloc(size);
+}
+
+extern "C" void *__wrap_calloc(size_t count, size_t size) {
+  NoteAllocation(__builtin_return_address(0));
+  return __real_calloc(count, size);
+}
+
+extern "C" void *__wrap_realloc(void *ptr, size_t size) {
+  NoteAllocation(__builtin_return_address(0));
+  return __real_realloc(ptr, size);
+}
+
+#define HOTHOUSE_HEAP_ALLOC __real_malloc
+#else
+#define HOTHOUSE_HEAP_ALLOC malloc
+#endif
+
+// Replacements for the global operator new, counted where they're called
+// from; malloc underneath, as the default ones, so the default deletes match
+static void *AllocateOrFail(size_t size, void *caller) {
+  NoteAllocation(caller);
+  void *p = HOTHOUSE_HEAP_ALLOC(size ? size : 1);
+  if (p == nullptr) {
+#if __cpp_exceptions
+    throw std::bad_alloc();
+#else
+    abort();
+#endif
+  }
+  return p;
+}
+
+void *operator new(size_t size) {
+  return AllocateOrFail(size, __builtin_return_address(0));
+}
+
+void *operator new[](size_t size) {
+  return AllocateOrFail(size, __builtin_return_address(0));
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept {
+  NoteAllocation(__builtin_return_address(0));
+  return HOTHOUSE_HEAP_ALLOC(size ? size : 1);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept {
+  NoteAllocation(__builtin_return_address(0));
+  return HOTHOUSE_HEAP_ALLOC(size ? size : 1);
+}
+
+#define HOTHOUSE_ALLOC_ENTER() (in_audio_callback = true)
+#define HOTHOUSE_ALLOC_LEAVE() (in_audio_callback = false)
+#else
+#define HOTHOUSE_ALLOC_ENTER() ((void)0)
+#define HOTHOUSE_ALLOC_LEAVE() ((void)0)
+#endif
+
+#if HOTHOUSE_MEMORY_REPORT && defined(__arm__)
+// From libDaisy's linker script: the top of the stack (the top of DTCM),
+// AXI SRAM's .data and .bss, and the start of the heap
+extern "C" uint32_t _estack[];
+extern "C" uint8_t _sdata[], _edata[], _sbss[], _ebss[], end[];
+
+static const uint32_t kStackPaint = 0xC5C5C5C5;
+
+static uint32_t *StackPaintBottom() {
+  return _estack - Hothouse::STACK_PAINT_BYTES / sizeof(uint32_t);
+}
+
+// Paints the window from its bottom up to a little under this frame, with
+// interrupts off so none has a frame down there meanwhile. A plain loop,
+// not memset: nothing may be called below the frame being painted under.
+__attribute__((noinline)) static void PaintStack() {
+  uint32_t here = 0;
+  volatile uint32_t *const top = &here - 16;
+  const uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  for (volatile uint32_t *p = StackPaintBottom(); p < top; p++) {
+    *p = kStackPaint;
+  }
+  __set_PRIMASK(primask);
+}
+
+// Bytes of the window ever written: up from its lowest overwritten word
+static uint32_t StackHighWater() {
+  const volatile uint32_t *p = StackPaintBottom();
+  while (p < _estack && *p == kStackPaint) {
+    p++;
+  }
+  return (uint32_t)((const volatile uint8_t *)_estack - (const volatile uint8_t *)p);
+}
+#endif
+
+#if HOTHOUSE_FLUSH_TO_ZERO && defined(__arm__)
+// Flush-to-zero and default NaN: subnormal inputs and results read as 0 and
+// every NaN is the default one. FPSCR takes them for the main loop;
+// FPDSCR is what each exception handler's FPSCR starts from, so it covers
+// the audio callback, which runs in the DMA interrupt.
+static void FlushSubnormalsToZero() {
+  const uint32_t modes = FPU_FPDSCR_FZ_Msk | FPU_FPDSCR_DN_Msk;
+  FPU->FPDSCR |= modes;
+  __set_FPSCR(__get_FPSCR() | modes);  // The bits sit in the same places
+}
+#endif
+
+#if HOTHOUSE_DENORMAL_CHECK
+#if defined(__arm__)
+// FPSCR's cumulative exception flags: IOC, DZC, OFC, UFC, IXC and IDC
+static constexpr uint32_t kFpscrFlags = 0x9F;
+static constexpr uint32_t kFpscrIoc = 1u << 0;
+static constexpr uint32_t kFpscrUfc = 1u << 3;
+static constexpr uint32_t kFpscrIdc = 1u << 7;
+#endif
+
+void Hothouse::BeginDenormalBlock() {
+#if defined(__arm__)
+  __set_FPSCR(__get_FPSCR() & ~kFpscrFlags);
+#else
+  feclearexcept(FE_UNDERFLOW | FE_INVALID);
+#endif
+}
+
+void Hothouse::EndDenormalBlock() {
+#if defined(__arm__)
+  const uint32_t flags = __get_FPSCR();
+  const bool flushed_in = flags & kFpscrIdc;
+  const bool flushed_out = flags & kFpscrUfc;
+  const bool invalid = flags & kFpscrIoc;
+#else
+  const bool flushed_in = false;
+  const bool flushed_out = fetestexcept(FE_UNDERFLOW);
+  const bool invalid = fetestexcept(FE_INVALID);
+#endif
+  if (flushed_in) {
+    denormal_blocks[0].fetch_add(1, std::memory_order_relaxed);
+  }
+  if (flushed_out) {
+    denormal_blocks[1].fetch_add(1, std::memory_order_relaxed);
+  }
+  if (invalid) {
+    denormal_blocks[2].fetch_add(1, std::memory_order_relaxed);
+  }
+}
+#endif
+
+#if HOTHOUSE_TCM
+// Section bounds, from hothouse_tcm.ld
+extern "C" uint32_t __hothouse_itcm_start[], __hothouse_itcm_end[],
+    __hothouse_itcm_load[];
+extern "C" uint32_t __hothouse_dtcm_data_start[], __hothouse_dtcm_data_end[],
+    __hothouse_dtcm_data_load[];
+extern "C" uint32_t __hothouse_dtcm_bss_start[], __hothouse_dtcm_bss_end[];
+
+/** Copies the ITCM code and DTCM data from where the image was loaded, and
+    clears the DTCM zero-init section. Priority 101 runs it ahead of every
+    other static constructor, so objects built in DTCM find it ready. */
+__attribute__((constructor(101))) static void LoadTightlyCoupledMemory() {
+  memcpy(__hothouse_itcm_start, __hothouse_itcm_load,
+         (char *)__hothouse_itcm_end - (char *)__hothouse_itcm_start);
+  memcpy(__hothouse_dtcm_data_start, __hothouse_dtcm_data_load,
+         (char *)__hothouse_dtcm_data_end - (char *)__hothouse_dtcm_data_start);
+  memset(__hothouse_dtcm_bss_start, 0,
+         (char *)__hothouse_dtcm_bss_end - (char *)__hothouse_dtcm_bss_start);
+  // The copied code must be visible to instruction fetch before any call
+  __DSB();
+  __ISB();
+}
+#endif
+
+#if HOTHOUSE_SDRAM_ARENA_MB > 0
+// The region in hothouse_arena.h, when the pedal asks for one. Write-back
+// cached as a whole; blocks carved with a CachePolicy get their own
+alignas(32) static uint8_t DSY_SDRAM_BSS
+    sdramArenaStorage[clevelandmusicco::kSdramArenaBytes];
+clevelandmusicco::Arena clevelandmusicco::sdramArena(
+    sdramArenaStorage, clevelandmusicco::kSdramArenaBytes);
+#endif
+
+void Hothouse::Init(bool boost) {
+#if HOTHOUSE_MEMORY_REPORT && defined(__arm__)
+  PaintStack();  // First, while main() is all that has run on the stack
+#endif
+#if HOTHOUSE_FLUSH_TO_ZERO && defined(__arm__)
+  FlushSubnormalsToZero();
+#endif
+  // Initialize the hardware.
+  seed.Configure();
+  seed.Init(boost);
+  InitSwitches();
+  InitFootswitchIrq();
+  InitAnalogControls();
+  SetAudioBlockSize(48);
+  BootMark("Hothouse::Init");
+}
+
+void Hothouse::DelayMs(size_t del) { seed.DelayMs(del); }
+
+void Hothouse::IdleMs(uint32_t ms) {
+#if HOTHOUSE_POWER_SAVE && defined(__arm__)
+  const uint32_t start = System::GetNow();
+  while (System::GetNow() - start < ms) {
+    __WFI();
+  }
+#else
+  System::Delay(ms);
+#endif
+}
+
+void Hothouse::SetHidUpdateRates() {
+  for (size_t i = 0; i < KNOB_LAST; i++) {
+    knobs[i].SetSampleRate(HidUpdateRate());
+  }
+}
+
+// Knobs are filtered at the rate they are processed
+float Hothouse::HidUpdateRate() {
+  return control_rate > 0.0f ? control_rate : AudioCallbackRate();
+}
+
+#if HOTHOUSE_LOAD_METER || HOTHOUSE_WATCHDOG || HOTHOUSE_ALLOC_CHECK || \
+    HOTHOUSE_DENORMAL_CHECK || HOTHOUSE_LATENCY_TEST || HOTHOUSE_NULL_TEST
+Hothouse *Hothouse::metered = nullptr;
+
+void Hothouse::StartAudio(AudioHandle::InterleavingAudioCallback cb) {
+  MeterAudio();
+  metered_interleaving_cb = cb;
+  seed.StartAudio(MeteredInterleavingCallback);
+  BootMark("StartAudio");
+}
+
+void Hothouse::StartAudio(AudioHandle::AudioCallback cb) {
+  MeterAudio();
+  metered_cb = cb;
+  seed.StartAudio(MeteredCallback);
+  BootMark("StartAudio");
+}
+
+void Hothouse::ChangeAudioCallback(AudioHandle::InterleavingAudioCallback cb) {
+  metered_interleaving_cb = cb;
+  seed.ChangeAudioCallback(MeteredInterleavingCallback);
+}
+
+void Hothouse::ChangeAudioCallback(AudioHandle::AudioCallback cb) {
+  metered_cb = cb;
+  seed.ChangeAudioCallback(MeteredCallback);
+}
+
+void Hothouse::MeterAudio() {
+  metered = this;
+#if HOTHOUSE_LOAD_METER
+  load_meter.Init(AudioSampleRate(), AudioBlockSize());
+  load_last_report = System::GetNow();
+#endif
+#if HOTHOUSE_WATCHDOG
+  StartWatchdog();
+#endif
+#if HOTHOUSE_ALLOC_CHECK
+  alloc_last_report = System::GetNow();
+#endif
+#if HOTHOUSE_DENORMAL_CHECK
+  denormal_last_report = System::GetNow();
+#endif
+#if HOTHOUSE_LATENCY_TEST
+  latency_period = (uint32_t)(AudioSampleRate() * LATENCY_PERIOD_MS / 1000);
+  latency_clock = 0;
+#endif
+#if HOTHOUSE_NULL_TEST
+  null_period = (uint32_t)(AudioSampleRate() * NULL_TEST_PERIOD_MS / 1000);
+  null_clock = 0;
+#endif
+  StartLog();
+}
+
+void Hothouse::MeteredCallback(AudioHandle::InputBuffer in,
+                               AudioHandle::OutputBuffer out, size_t size) {
+  metered->BeginMeteredBlock();
+#if HOTHOUSE_LATENCY_TEST
+  in = metered->BeginLatencyBlock(in, size);
+#endif
+  HOTHOUSE_ALLOC_ENTER();
+  metered->metered_cb(in, out, size);
+  HOTHOUSE_ALLOC_LEAVE();
+#if HOTHOUSE_NULL_TEST
+  metered->EndNullTestBlock(out[1], 1, size);
+#endif
+#if HOTHOUSE_LATENCY_TEST
+  metered->EndLatencyBlock(out[0], 1);
+  metered->EndLatencyBlock(out[1], 1);
+#endif
+  metered->EndMeteredBlock();
+}
+
+void Hothouse::MeteredInterleavingCallback(
+    AudioHandle::InterleavingInputBuffer in,
+    AudioHandle::InterleavingOutputBuffer out, size_t size) {
+  metered->BeginMeteredBlock();
+#if HOTHOUSE_LATENCY_TEST
+  in = metered->BeginLatencyBlock(in, size);
+#endif
+  HOTHOUSE_ALLOC_ENTER();
+  metered->metered_interleaving_cb(in, out, size);
+  HOTHOUSE_ALLOC_LEAVE();
+#if HOTHOUSE_NULL_TEST
+  metered->EndNullTestBlock(out + 1, 2, size);
+#endif
+#if HOTHOUSE_LATENCY_TEST
+  metered->EndLatencyBlock(out, 2);
+#endif
+  metered->EndMeteredBlock();
+}
+#else
+void Hothouse::StartAudio(AudioHandle::InterleavingAudioCallback cb) {
+  seed.StartAudio(cb);
+  BootMark("StartAudio");
+}
+
+void Hothouse::StartAudio(AudioHandle::AudioCallback cb) {
+  seed.StartAudio(cb);
+  BootMark("StartAudio");
+}
+
+void Hothouse::ChangeAudioCallback(AudioHandle::InterleavingAudioCallback cb) {
+  seed.ChangeAudioCallback(cb);
+}
+
+void Hothouse::ChangeAudioCallback(AudioHandle::AudioCallback cb) {
+  seed.ChangeAudioCallback(cb);
+}
+#endif
+
+bool Hothouse::WatchdogStats::operator==(const WatchdogStats &other) const {
+  return memcmp(this, &other, sizeof(*this)) == 0;
+}
+
+#if HOTHOUSE_WATCHDOG
+// Reads the last session's stats and starts this one's. A restart of audio
+// (ChangeAudioCallback() doesn't restart) keeps counting into the same
+// session.
+void Hothouse::StartWatchdog() {
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+  watchdog_stats.version = WATCHDOG_VERSION;
+  watchdog_stats.block_size = (uint32_t)AudioBlockSize();
+  watchdog_stats.sample_rate = (uint32_t)AudioSampleRate();
+  watchdog_stats.quality = (uint32_t)quality;
+  watchdog_stats.period_cycles =
+      (uint32_t)((uint64_t)SystemCoreClock * watchdog_stats.block_size /
+                 watchdog_stats.sample_rate);
+  watchdog_late_cycles =
+      watchdog_stats.period_cycles + watchdog_stats.period_cycles / 2;
+  watchdog_timed = false;
+  if (watchdog_started) {
+    return;
+  }
+
+  const WatchdogStats none = {};
+  watchdog_storage.Init(none, WATCHDOG_OFFSET);
+  const WatchdogStats &stored = watchdog_storage.GetSettings();
+  if (stored.version == WATCHDOG_VERSION) {
+    watchdog_last = stored;
+  }
+  watchdog_start_ms = System::GetNow();
+  watchdog_last_report = watchdog_start_ms;
+  watchdog_last_save = watchdog_start_ms;
+  watchdog_started = true;
+}
+
+// True once an overrun or late start count, or a worst case by more than
+// 1/32, has grown since the last save
+bool Hothouse::WatchdogStatsGrew() const {
+  for (uint32_t m = 0; m < WATCHDOG_MODES; m++) {
+    const WatchdogModeStats &now = watchdog_stats.modes[m];
+    const WatchdogModeStats &saved = watchdog_saved.modes[m];
+    if (now.overruns != saved.overruns || now.late_starts != saved.late_starts ||
+        now.worst_cycles > saved.worst_cycles + saved.worst_cycles / 32) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// session 0 is the last, 1 this one
+void Hothouse::PrintWatchdogStats(int session, const WatchdogStats &stats) {
+#if !HOTHOUSE_TELEMETRY
+  seed.PrintLine("watchdog %s: %u samples at %u Hz, %s quality, %u s, "
+                 "%u cycles a block",
+                 session ? "this session" : "last session",
+                 (unsigned)stats.block_size, (unsigned)stats.sample_rate,
+                 QualityName((Quality)stats.quality), (unsigned)stats.seconds,
+                 (unsigned)stats.period_cycles);
+#endif
+  for (uint32_t m = 0; m < WATCHDOG_MODES; m++) {
+    const WatchdogModeStats &mode = stats.modes[m];
+    if (mode.blocks == 0) {
+      continue;
+    }
+#if HOTHOUSE_TELEMETRY
+    const TelemetryWatchdog record = {
+        (uint8_t)session,    (uint8_t)m,         (uint16_t)stats.block_size,
+        stats.sample_rate,   stats.seconds,      stats.period_cycles,
+        mode.blocks,         mode.overruns,      mode.late_starts,
+        mode.worst_cycles,   stats.quality};
+    telemetry.Post(TELEMETRY_WATCHDOG, &record, sizeof(record));
+#else
+    // Tenths of a percent of the period; the log's printf has no floats
+    uint32_t worst = (uint32_t)((uint64_t)mode.worst_cycles * 1000 /
+                                (stats.period_cycles ? stats.period_cycles : 1));
+    seed.PrintLine("  mode %2u  blocks %10lu  overruns %6lu  late %6lu  "
+                   "worst %8lu cycles %3u.%u%%",
+                   (unsigned)m, (unsigned long)mode.blocks,
+                   (unsigned long)mode.overruns, (unsigned long)mode.late_starts,
+                   (unsigned long)mode.worst_cycles, (unsigned)(worst / 10),
+                   (unsigned)(worst % 10));
+#endif
+  }
+}
+#endif
+
+void Hothouse::ServiceWatchdog(uint32_t report_ms, uint32_t save_ms) {
+#if HOTHOUSE_WATCHDOG
+  if (!watchdog_started) {
+    return;  // Audio not started yet
+  }
+  uint32_t now = System::GetNow();
+  watchdog_stats.seconds = (now - watchdog_start_ms) / 1000;
+
+  if (now - watchdog_last_report >= report_ms) {
+    watchdog_last_report = now;
+    if (watchdog_last.version == WATCHDOG_VERSION) {
+      PrintWatchdogStats(0, watchdog_last);
+    }
+    PrintWatchdogStats(1, watchdog_stats);
+  }
+
+  // The first save replaces the last session's stats with this one's
+  if (now - watchdog_last_save >= save_ms &&
+      (!watchdog_ever_saved || WatchdogStatsGrew())) {
+    watchdog_last_save = now;
+    watchdog_hold.store(true, std::memory_order_release);
+    watchdog_saved = watchdog_stats;
+    watchdog_storage.GetSettings() = watchdog_saved;
+    watchdog_storage.Save();
+    watchdog_hold.store(false, std::memory_order_release);
+    watchdog_ever_saved = true;
+  }
+#else
+  (void)report_ms;
+  (void)save_ms;
+#endif
+}
+
+void Hothouse::StartLog() {
+  if (!log_started) {
+    seed.StartLog(false);
+    log_started = true;
+  }
+}
+
+void Hothouse::ServiceLoadMeter(uint32_t report_ms) {
+#if HOTHOUSE_LOAD_METER
+  if (metered == nullptr) {
+    return;  // Audio not started yet
+  }
+  peak_load = load_meter.GetMaxCpuLoad();
+
+  uint32_t now = System::GetNow();
+  if (now - load_last_report < report_ms) {
+    return;
+  }
+  load_last_report = now;
+
+#if HOTHOUSE_TELEMETRY
+  const TelemetryLoad record = {load_meter.GetAvgCpuLoad(), peak_load};
+  telemetry.Post(TELEMETRY_LOAD, &record, sizeof(record));
+#else
+  // Tenths of a percent; the log's printf has no float support
+  uint32_t avg = (uint32_t)(load_meter.GetAvgCpuLoad() * 1000.0f);
+  uint32_t peak = (uint32_t)(peak_load * 1000.0f);
+  seed.PrintLine("cpu avg %3u.%u%%  peak %3u.%u%%", (unsigned)(avg / 10),
+                 (unsigned)(avg % 10), (unsigned)(peak / 10),
+                 (unsigned)(peak % 10));
+#endif
+  load_meter_reset.store(true, std::memory_order_release);
+#else
+  (void)report_ms;
+#endif
+}
+
+void Hothouse::ServiceBootTiming(uint32_t report_ms) {
+#if HOTHOUSE_BOOT_TIMING
+  uint32_t now = System::GetNow();
+  if (!boot_reported) {
+    StartLog();  // The first call reports straight away
+    boot_reported = true;
+  } else if (now - boot_last_report < report_ms) {
+    return;
+  }
+  boot_last_report = now;
+
+#if !HOTHOUSE_TELEMETRY
+  // Microseconds as ms with three places; the log's printf has no floats
+  seed.PrintLine("boot        at ms      took ms");
+#endif
+  uint32_t previous = 0;
+  for (int i = 0; i < boot_mark_count; i++) {
+    const uint32_t at = boot_marks[i].us;
+    const uint32_t took = at - previous;
+    previous = at;
+#if HOTHOUSE_TELEMETRY
+    TelemetryBoot record = {at, took, {}};
+    telemetry.Post(TELEMETRY_BOOT, &record,
+                   TelemetryText(&record, 8, boot_marks[i].phase));
+#else
+    seed.PrintLine("  %5lu.%03lu  %5lu.%03lu  %s", (unsigned long)(at / 1000),
+                   (unsigned long)(at % 1000), (unsigned long)(took / 1000),
+                   (unsigned long)(took % 1000), boot_marks[i].phase);
+#endif
+  }
+#else
+  (void)report_ms;
+#endif
+}
+
+void Hothouse::ServiceAllocCheck(uint32_t report_ms) {
+#if HOTHOUSE_ALLOC_CHECK
+  if (metered == nullptr) {
+    return;  // Audio not started yet
+  }
+  uint32_t now = System::GetNow();
+  if (now - alloc_last_report < report_ms) {
+    return;
+  }
+  alloc_last_report = now;
+
+  const uint32_t count = audio_allocations.load(std::memory_order_relaxed);
+#if HOTHOUSE_TELEMETRY
+  if (count > 0) {
+    const TelemetryAlloc record = {
+        count, (uint32_t)(uintptr_t)first_audio_allocation.load(
+                   std::memory_order_relaxed)};
+    telemetry.Post(TELEMETRY_ALLOC, &record, sizeof(record));
+  }
+#else
+  if (count > 0) {
+    seed.PrintLine("alloc %lu in the audio callback, first from %p",
+                   (unsigned long)count,
+                   first_audio_allocation.load(std::memory_order_relaxed));
+  }
+#endif
+#else
+  (void)report_ms;
+#endif
+}
+
+void Hothouse::ServiceDenormalCheck(uint32_t report_ms) {
+#if HOTHOUSE_DENORMAL_CHECK
+  if (metered == nullptr) {
+    return;  // Audio not started yet
+  }
+  uint32_t now = System::GetNow();
+  if (now - denormal_last_report < report_ms) {
+    return;
+  }
+  denormal_last_report = now;
+
+  const TelemetryDenormalBlocks blocks = {
+      denormal_blocks[0].exchange(0, std::memory_order_relaxed),
+      denormal_blocks[1].exchange(0, std::memory_order_relaxed),
+      denormal_blocks[2].exchange(0, std::memory_order_relaxed)};
+#if HOTHOUSE_TELEMETRY
+  telemetry.Post(TELEMETRY_DENORMAL_BLOCKS, &blocks, sizeof(blocks));
+#else
+  seed.PrintLine("fpu blocks  %lu flushed in, %lu flushed out, %lu invalid",
+                 (unsigned long)blocks.flushed_in,
+                 (unsigned long)blocks.flushed_out,
+                 (unsigned long)blocks.invalid);
+#endif
+  for (int w = 0; w < denormal_watch_count; w++) {
+    const DenormalWatch &watch = denormal_watches[w];
+    uint32_t subnormal = 0;
+    uint32_t non_finite = 0;
+    for (size_t i = 0; i < watch.count; i++) {
+      uint32_t bits;
+      memcpy(&bits, &watch.data[i], sizeof(bits));
+      const uint32_t exponent = bits & 0x7F800000;
+      if (exponent == 0 && (bits & 0x007FFFFF) != 0) {
+        subnormal++;
+      } else if (exponent == 0x7F800000) {
+        non_finite++;
+      }
+    }
+#if HOTHOUSE_TELEMETRY
+    TelemetryDenormalWatch record = {subnormal, non_finite,
+                                     (uint32_t)watch.count, {}};
+    telemetry.Post(TELEMETRY_DENORMAL_WATCH, &record,
+                   TelemetryText(&record, 12, watch.name));
+#else
+    seed.PrintLine("  %-14s %lu subnormal, %lu nan or inf, of %lu", watch.name,
+                   (unsigned long)subnormal, (unsigned long)non_finite,
+                   (unsigned long)watch.count);
+#endif
+  }
+#else
+  (void)report_ms;
+#endif
+}
+
+#if HOTHOUSE_LATENCY_TEST
+// The click, and the least of it that counts as coming back: a single
+// sample keeps most of its height through the codec's filters
+static const float LATENCY_CLICK = 0.5f;
+static const float LATENCY_THRESHOLD = 0.05f;
+
+// The test's clock runs a sample at a time across blocks: a click at 0,
+// the loudest input sample after it kept until the period is up, then the
+// result published and a click of the other kind at 0 again. Returns
+// where in this block the click goes, -1 for nowhere.
+int Hothouse::ScanLatency(const float *in, size_t stride, size_t size) {
+  int click_at = -1;
+  for (size_t i = 0; i < size; i++) {
+    if (latency_clock == 0) {
+      click_at = (int)i;
+      latency_click_through = latency_through;
+      latency_peak = 0.0f;
+      latency_peak_at = 0;
+    }
+    const float x = fabsf(in[i * stride]);
+    if (x > latency_peak) {
+      latency_peak = x;
+      latency_peak_at = latency_clock;
+    }
+    if (++latency_clock >= latency_period) {
+      const bool found = latency_peak >= LATENCY_THRESHOLD;
+      latency_result[latency_through].store(
+          found ? (int32_t)latency_peak_at : -1, std::memory_order_relaxed);
+      latency_found.store(found, std::memory_order_relaxed);
+      if (latency_through) {
+        latency_pairs.fetch_add(1, std::memory_order_release);
+      }
+      latency_through = !latency_through;
+      latency_clock = 0;
+    }
+  }
+  return click_at;
+}
+
+AudioHandle::InputBuffer Hothouse::BeginLatencyBlock(
+    AudioHandle::InputBuffer in, size_t size) {
+  if (size > LATENCY_MAX_BLOCK) {
+    latency_click_at = -1;
+    return in;
+  }
+  latency_click_at = ScanLatency(in[0], 1, size);
+  memset(latency_in, 0, size * sizeof(float));
+  memset(latency_in + LATENCY_MAX_BLOCK, 0, size * sizeof(float));
+  if (latency_click_at >= 0 && latency_click_through) {
+    latency_in[latency_click_at] = LATENCY_CLICK;
+    latency_in[LATENCY_MAX_BLOCK + latency_click_at] = LATENCY_CLICK;
+  }
+  return latency_channels;
+}
+
+AudioHandle::InterleavingInputBuffer Hothouse::BeginLatencyBlock(
+    AudioHandle::InterleavingInputBuffer in, size_t size) {
+  if (size > LATENCY_MAX_BLOCK) {
+    latency_click_at = -1;
+    return in;
+  }
+  latency_click_at = ScanLatency(in, 2, size);
+  memset(latency_in, 0, 2 * size * sizeof(float));
+  if (latency_click_at >= 0 && latency_click_through) {
+    latency_in[2 * latency_click_at] = LATENCY_CLICK;
+    latency_in[2 * latency_click_at + 1] = LATENCY_CLICK;
+  }
+  return latency_in;
+}
+
+// channels is also the stride: 1 for each of a non-interleaved block's
+// buffers, 2 for an interleaved one
+void Hothouse::EndLatencyBlock(float *out, size_t channels) {
+  if (latency_click_at >= 0 && !latency_click_through) {
+    for (size_t c = 0; c < channels; c++) {
+      out[channels * latency_click_at + c] += LATENCY_CLICK;
+    }
+  }
+}
+#endif
+
+void Hothouse::ServiceLatencyTest() {
+#if HOTHOUSE_LATENCY_TEST
+  if (metered == nullptr) {
+    return;  // Audio not started yet
+  }
+  const uint32_t pairs = latency_pairs.load(std::memory_order_acquire);
+  if (pairs == latency_reported) {
+    return;
+  }
+  latency_reported = pairs;
+
+  const int32_t bare = latency_result[0].load(std::memory_order_relaxed);
+  const int32_t through = latency_result[1].load(std::memory_order_relaxed);
+#if HOTHOUSE_TELEMETRY
+  const TelemetryLatency record = {through, bare, (uint32_t)AudioSampleRate(),
+                                   (uint32_t)AudioBlockSize()};
+  telemetry.Post(TELEMETRY_LATENCY, &record, sizeof(record));
+#else
+  if (bare < 0) {
+    seed.PrintLine("latency  no click back: loop output 1 to input 1");
+    return;
+  }
+  if (through < 0) {
+    // Or its wet path spreads the click too thin to find, as a reverb does
+    seed.PrintLine("latency  no click back through the pedal: set it fully wet");
+    return;
+  }
+  // Microseconds as ms with three places; the log's printf has no floats
+  const uint32_t rate = (uint32_t)AudioSampleRate();
+  const int32_t added = through - bare;
+  const uint32_t us[3] = {
+      (uint32_t)((uint64_t)through * 1000000 / rate),
+      (uint32_t)((uint64_t)bare * 1000000 / rate),
+      (uint32_t)((uint64_t)(added < 0 ? -added : added) * 1000000 / rate)};
+  seed.PrintLine(
+      "latency  round trip %ld samples (%lu.%03lu ms), codec alone %ld "
+      "(%lu.%03lu ms), pedal %s%ld (%s%lu.%03lu ms), block %u",
+      (long)through, (unsigned long)(us[0] / 1000),
+      (unsigned long)(us[0] % 1000), (long)bare,
+      (unsigned long)(us[1] / 1000), (unsigned long)(us[1] % 1000),
+      added < 0 ? "-" : "+", (long)(added < 0 ? -added : added),
+      added < 0 ? "-" : "+", (unsigned long)(us[2] / 1000),
+      (unsigned long)(us[2] % 1000), (unsigned)AudioBlockSize());
+#endif
+#endif
+}
+
+#if HOTHOUSE_NULL_TEST
+void Hothouse::CompareNull(const float *reference, const float *candidate,
+                           size_t size) {
+  float peak = null_peak;
+  float signal = 0.0f;  // This call's, in float; the period's in double
+  float error = 0.0f;
+  for (size_t i = 0; i < size; i++) {
+    const float difference = candidate[i] - reference[i];
+    const float magnitude = fabsf(difference);
+    if (magnitude > peak) {
+      peak = magnitude;
+    }
+    signal += reference[i] * reference[i];
+    error += difference * difference;
+    if (null_filled < NULL_TEST_MAX_BLOCK) {
+      null_difference[null_filled++] = difference * NULL_TEST_GAIN;
+    }
+  }
+  null_peak = peak;
+  null_signal += signal;
+  null_error += error;
+  null_samples += (uint32_t)size;
+}
+
+void Hothouse::EndNullTestBlock(float *out, size_t stride, size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    out[i * stride] = i < null_filled ? null_difference[i] : 0.0f;
+  }
+  null_filled = 0;
+
+  null_clock += (uint32_t)size;
+  if (null_clock < null_period) {
+    return;
+  }
+  const float samples = null_samples > 0 ? (float)null_samples : 1.0f;
+  null_result_peak.store(null_peak, std::memory_order_relaxed);
+  null_result_signal.store((float)(null_signal / samples),
+                           std::memory_order_relaxed);
+  null_result_error.store((float)(null_error / samples),
+                          std::memory_order_relaxed);
+  null_result_samples.store(null_samples, std::memory_order_relaxed);
+  null_periods.fetch_add(1, std::memory_order_release);
+  null_clock = 0;
+  null_peak = 0.0f;
+  null_signal = 0.0;
+  null_error = 0.0;
+  null_samples = 0;
+}
+
+// Tenths of a dB as a sign, units and a digit, for the log's printf
+static void TenthsDb(float db, char *sign, long *units, long *tenths) {
+  const long t = (long)(db * 10.0f + (db < 0.0f ? -0.5f : 0.5f));
+  *sign = t < 0 ? '-' : ' ';
+  *units = (t < 0 ? -t : t) / 10;
+  *tenths = (t < 0 ? -t : t) % 10;
+}
+#endif
+
+void Hothouse::ServiceNullTest() {
+#if HOTHOUSE_NULL_TEST
+  if (metered == nullptr) {
+    return;  // Audio not started yet
+  }
+  const uint32_t periods = null_periods.load(std::memory_order_acquire);
+  if (periods == null_reported) {
+    return;
+  }
+  null_reported = periods;
+
+  const float peak = null_result_peak.load(std::memory_order_relaxed);
+  const float signal = null_result_signal.load(std::memory_order_relaxed);
+  const float error = null_result_error.load(std::memory_order_relaxed);
+  const uint32_t samples = null_result_samples.load(std::memory_order_relaxed);
+#if HOTHOUSE_TELEMETRY
+  const TelemetryNullTest record = {peak, signal, error, samples};
+  telemetry.Post(TELEMETRY_NULL_TEST, &record, sizeof(record));
+#else
+  if (samples == 0) {
+    seed.PrintLine("null test  nothing compared: is the stage running?");
+    return;
+  }
+  if (error == 0.0f) {
+    seed.PrintLine("null test  bit-exact over %lu samples",
+                   (unsigned long)samples);
+    return;
+  }
+  char peak_sign, snr_sign;
+  long peak_units, peak_tenths, snr_units, snr_tenths;
+  TenthsDb(20.0f * log10f(peak), &peak_sign, &peak_units, &peak_tenths);
+  TenthsDb(signal > 0.0f ? 10.0f * log10f(signal / error) : 0.0f, &snr_sign,
+           &snr_units, &snr_tenths);
+  seed.PrintLine(
+      "null test  peak difference %c%ld.%ld dBFS  snr %c%ld.%ld dB  over %lu "
+      "samples",
+      peak_sign, peak_units, peak_tenths, snr_sign, snr_units, snr_tenths,
+      (unsigned long)samples);
+#endif
+#endif
+}
+
+void Hothouse::ServiceMemoryReport(uint32_t report_ms) {
+#if HOTHOUSE_MEMORY_REPORT
+  uint32_t now = System::GetNow();
+  if (!memory_reported) {
+    memory_reported = true;  // The first call reports straight away
+  } else if (report_ms == 0 || now - memory_last_report < report_ms) {
+    return;
+  }
+  memory_last_report = now;
+  ReportMemory();
+#else
+  (void)report_ms;
+#endif
+}
+
+void Hothouse::ReportMemory() {
+#if HOTHOUSE_MEMORY_REPORT
+  StartLog();
+  TelemetryMemory memory = {};
+#if defined(__arm__)
+  memory.stack_used = StackHighWater();
+  memory.stack_painted = STACK_PAINT_BYTES;
+  // newlib-nano's heap only grows: arena is its high-water mark
+  const struct mallinfo heap = mallinfo();
+  memory.heap_arena = (uint32_t)heap.arena;
+  memory.heap_in_use = (uint32_t)heap.uordblks;
+  memory.sram_data = (uint32_t)(_edata - _sdata);
+  memory.sram_bss = (uint32_t)(_ebss - _sbss);
+#endif
+#if HOTHOUSE_TCM
+  memory.dtcm_data = (uint32_t)((char *)__hothouse_dtcm_data_end -
+                                (char *)__hothouse_dtcm_data_start);
+  memory.dtcm_bss = (uint32_t)((char *)__hothouse_dtcm_bss_end -
+                               (char *)__hothouse_dtcm_bss_start);
+  memory.itcm =
+      (uint32_t)((char *)__hothouse_itcm_end - (char *)__hothouse_itcm_start);
+#endif
+#if HOTHOUSE_SDRAM_ARENA_MB > 0
+  memory.sdram_used = (uint32_t)clevelandmusicco::sdramArena.Used();
+  memory.sdram_capacity = (uint32_t)clevelandmusicco::sdramArena.Capacity();
+#endif
+
+#if HOTHOUSE_TELEMETRY
+  telemetry.Post(TELEMETRY_MEMORY, &memory, sizeof(memory));
+#else
+  seed.PrintLine("memory         bytes");
+#if defined(__arm__)
+  seed.PrintLine("  stack   %8lu most used, of %lu painted%s",
+                 (unsigned long)memory.stack_used,
+                 (unsigned long)memory.stack_painted,
+                 memory.stack_used >= memory.stack_painted
+                     ? ": all of it, so more"
+                     : "");
+  seed.PrintLine("  heap    %8lu from %p, %lu in use now",
+                 (unsigned long)memory.heap_arena, (void *)end,
+                 (unsigned long)memory.heap_in_use);
+  seed.PrintLine("  sram    %8lu .data, %lu .bss",
+                 (unsigned long)memory.sram_data,
+                 (unsigned long)memory.sram_bss);
+#else
+  seed.PrintLine("  stack and heap are measured on the Seed only");
+#endif
+#if HOTHOUSE_TCM
+  seed.PrintLine("  dtcm    %8lu data, %lu bss, from hothouse_tcm.h",
+                 (unsigned long)memory.dtcm_data,
+                 (unsigned long)memory.dtcm_bss);
+  seed.PrintLine("  itcm    %8lu code", (unsigned long)memory.itcm);
+#endif
+#if HOTHOUSE_SDRAM_ARENA_MB > 0
+  seed.PrintLine("  sdram   %8lu carved from the arena's %lu",
+                 (unsigned long)memory.sdram_used,
+                 (unsigned long)memory.sdram_capacity);
+#endif
+#endif
+#endif
+}
+
+void Hothouse::ServicePower(uint32_t reduce_after_ms) {
+#if HOTHOUSE_POWER_SAVE
+  const uint32_t now = System::GetNow();
+  if (!power_bypassed.load(std::memory_order_relaxed)) {
+    power_bypass_since = now;
+  } else if (!power_reduced.load(std::memory_order_relaxed) &&
+             now - power_bypass_since >= reduce_after_ms) {
+    SetCpuClockReduced(true);
+  }
+#else
+  (void)reduce_after_ms;
+#endif
+}
+
+#if HOTHOUSE_POWER_SAVE
+// Halves the core clock with D1CPRE and takes HPRE from /2 to /1, so HCLK
+// and the APB, timer and SAI clocks under it don't change: only the core
+// and SysTick (which it clocks) slow down. In each direction the first
+// write lowers HCLK, so it never passes its limit in between. The main
+// loop reduces with interrupts off; the callback restores from its
+// interrupt, so neither can run inside the other.
+void Hothouse::SetCpuClockReduced(bool reduced) {
+#if defined(__arm__)
+  const uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  const uint32_t d1cfgr = RCC->D1CFGR;
+  const uint32_t prescalers = d1cfgr & (RCC_D1CFGR_D1CPRE_Msk | RCC_D1CFGR_HPRE_Msk);
+  const uint32_t others = d1cfgr & ~(RCC_D1CFGR_D1CPRE_Msk | RCC_D1CFGR_HPRE_Msk);
+  if (reduced && power_bypassed.load(std::memory_order_relaxed) &&
+      prescalers == (RCC_D1CFGR_D1CPRE_DIV1 | RCC_D1CFGR_HPRE_DIV2)) {
+    RCC->D1CFGR = others | RCC_D1CFGR_D1CPRE_DIV2 | RCC_D1CFGR_HPRE_DIV2;
+    RCC->D1CFGR = others | RCC_D1CFGR_D1CPRE_DIV2 | RCC_D1CFGR_HPRE_DIV1;
+    SystemCoreClock /= 2;
+    power_reduced.store(true, std::memory_order_relaxed);
+  } else if (!reduced &&
+             prescalers == (RCC_D1CFGR_D1CPRE_DIV2 | RCC_D1CFGR_HPRE_DIV1)) {
+    RCC->D1CFGR = others | RCC_D1CFGR_D1CPRE_DIV2 | RCC_D1CFGR_HPRE_DIV2;
+    RCC->D1CFGR = others | RCC_D1CFGR_D1CPRE_DIV1 | RCC_D1CFGR_HPRE_DIV2;
+    SystemCoreClock *= 2;
+    power_reduced.store(false, std::memory_order_relaxed);
+  } else {
+    __set_PRIMASK(primask);
+    return;  // Already there, out of bypass again, or not clocked as Init() left it
+  }
+  // Keep HAL's 1 ms tick at 1 ms
+  SysTick->LOAD = SystemCoreClock / 1000 - 1;
+  SysTick->VAL = 0;
+  __set_PRIMASK(primask);
+#else
+  // The host has no clock tree: only the state changes
+  power_reduced.store(reduced && power_bypassed.load(std::memory_order_relaxed),
+                      std::memory_order_relaxed);
+#endif
+}
+#endif
+
+#if HOTHOUSE_PROBE
+#if HOTHOUSE_UPLOAD
+#error "PROBE=1 and UPLOAD=1 both read USB serial"
+#endif
+#if HOTHOUSE_SDRAM_ARENA_MB == 0
+#error "PROBE=1 records into the SDRAM arena (hothouse.mk gives it 16 MB)"
+#endif
+Hothouse *Hothouse::probing = nullptr;
+
+// Probe dump, a line each among whatever else the log prints, for
+// tools/hothouse_probe.py:
+//   probe begin <count>
+//   probe tap <id> <frames> <rate_hz> <name>
+//   probe data <id> <first frame> <up to 8 samples, IEEE-754 bits in hex>
+//   probe end
+// Each tap's frames come oldest first.
+
+void Hothouse::WriteProbe(SignalProbe &probe, const float *data, size_t size) {
+  if (size > probe.frames) {
+    data += size - probe.frames;  // Only the end of the block fits
+    size = probe.frames;
+  }
+  const size_t room = probe.frames - probe.write;
+  const size_t first = size < room ? size : room;
+  memcpy(probe.ring + probe.write, data, first * sizeof(float));
+  memcpy(probe.ring, data + first, (size - first) * sizeof(float));
+  probe.write += size;
+  if (probe.write >= probe.frames) {
+    probe.write -= probe.frames;
+  }
+  probe.filled = probe.frames - probe.filled > size ? probe.filled + size
+                                                    : probe.frames;
+}
+
+// USB interrupt: keeps the latest command
+void Hothouse::ProbeReceive(uint8_t *buf, uint32_t *len) {
+  for (uint32_t i = 0; i < *len; i++) {
+    if (buf[i] == 'a' || buf[i] == 'd' || buf[i] == 'x') {
+      probing->probe_command.store(buf[i], std::memory_order_release);
+    }
+  }
+}
+
+#if HOTHOUSE_TELEMETRY
+// With telemetry the dump is records instead: PROBE_STATE begin, then per
+// tap a PROBE_TAP and its PROBE_DATA oldest first, then PROBE_STATE end.
+// probe_dumped is PROBE_TAP_NEXT until the tap's PROBE_TAP is queued.
+static const size_t PROBE_TAP_NEXT = (size_t)-1;
+
+void Hothouse::PostProbeState(uint8_t state) {
+  const TelemetryProbeState record = {state, (uint8_t)probe_count};
+  telemetry.Post(TELEMETRY_PROBE_STATE, &record, sizeof(record));
+}
+
+// Queues the dump's next record; false once the queue is full or the dump
+// is over
+bool Hothouse::OfferProbeRecord() {
+  if (probe_dumping >= probe_count) {
+    const TelemetryProbeState end = {TELEMETRY_PROBE_END, (uint8_t)probe_count};
+    if (telemetry.Offer(TELEMETRY_PROBE_STATE, &end, sizeof(end))) {
+      probe_dumping = -1;
+    }
+    return false;
+  }
+  const SignalProbe &probe = probes[probe_dumping];
+  if (probe_dumped == PROBE_TAP_NEXT) {
+    TelemetryProbeTap tap = {(uint8_t)probe_dumping, {},
+                             (uint32_t)probe.filled, (uint32_t)probe.rate_hz,
+                             {}};
+    if (!telemetry.Offer(TELEMETRY_PROBE_TAP, &tap,
+                         TelemetryText(&tap, 12, probe.name))) {
+      return false;
+    }
+    probe_dumped = 0;
+    return true;
+  }
+  if (probe_dumped >= probe.filled) {
+    probe_dumping++;
+    probe_dumped = PROBE_TAP_NEXT;
+    return true;
+  }
+
+  TelemetryProbeData data = {(uint8_t)probe_dumping, {},
+                             (uint32_t)probe_dumped, {}};
+  const size_t oldest = probe.write + probe.frames - probe.filled;
+  const size_t most = sizeof(data.samples) / sizeof(data.samples[0]);
+  size_t n = 0;
+  for (; n < most && probe_dumped + n < probe.filled; n++) {
+    data.samples[n] = probe.ring[(oldest + probe_dumped + n) % probe.frames];
+  }
+  if (!telemetry.Offer(TELEMETRY_PROBE_DATA, &data, 8 + n * sizeof(float))) {
+    return false;
+  }
+  probe_dumped += n;
+  return true;
+}
+#endif
+
+// Disarms, then waits out a block so no WriteProbe() is still running
+void Hothouse::StopProbes() {
+  if (probes_armed.exchange(false, std::memory_order_acq_rel)) {
+    System::Delay((uint32_t)(1000.0f / AudioCallbackRate()) + 1);
+  }
+}
+#endif
+
+int Hothouse::AddProbe(const char *name, size_t frames, float rate_hz) {
+#if HOTHOUSE_PROBE
+  float *ring = probe_count < PROBES && frames > 0
+                    ? clevelandmusicco::sdramArena.Carve<float>(frames)
+                    : nullptr;
+  if (ring == nullptr) {
+    StartLog();
+    seed.PrintLine("probe %s: no room", name);
+    return -1;
+  }
+  probes[probe_count] = {name,   ring, frames, 0, 0,
+                         rate_hz > 0.0f ? rate_hz : AudioSampleRate()};
+  return probe_count++;
+#else
+  (void)name;
+  (void)frames;
+  (void)rate_hz;
+  return -1;
+#endif
+}
+
+void Hothouse::ArmProbes(bool armed) {
+#if HOTHOUSE_PROBE
+  StopProbes();
+  probe_dumping = -1;
+  if (armed) {
+    for (int p = 0; p < probe_count; p++) {
+      probes[p].write = 0;
+      probes[p].filled = 0;
+    }
+    probes_armed.store(true, std::memory_order_release);
+  }
+#else
+  (void)armed;
+#endif
+}
+
+void Hothouse::ServiceProbes(uint32_t lines_per_call) {
+#if HOTHOUSE_PROBE
+  if (probing == nullptr) {
+    probing = this;
+    StartLog();
+    seed.usb_handle.SetReceiveCallback(ProbeReceive,
+                                       daisy::UsbHandle::FS_INTERNAL);
+  }
+#if HOTHOUSE_TELEMETRY
+  switch (probe_command.exchange(0, std::memory_order_acquire)) {
+    case 'a':
+      ArmProbes(true);
+      PostProbeState(TELEMETRY_PROBE_ARMED);
+      break;
+    case 'd':
+      ArmProbes(false);
+      PostProbeState(TELEMETRY_PROBE_BEGIN);
+      probe_dumping = 0;
+      probe_dumped = PROBE_TAP_NEXT;
+      break;
+    case 'x':
+      ArmProbes(false);
+      PostProbeState(TELEMETRY_PROBE_STOPPED);
+      break;
+    default:
+      break;
+  }
+
+  // As many records as the queue takes, up to lines_per_call
+  for (uint32_t records = 0; probe_dumping >= 0 && records < lines_per_call;
+       records++) {
+    if (!OfferProbeRecord()) {
+      break;
+    }
+  }
+#else
+  auto print_tap = [this](int id) {
+    seed.PrintLine("probe tap %d %lu %lu %s", id,
+                   (unsigned long)probes[id].filled,
+                   (unsigned long)probes[id].rate_hz, probes[id].name);
+  };
+  switch (probe_command.exchange(0, std::memory_order_acquire)) {
+    case 'a':
+      ArmProbes(true);
+      seed.PrintLine("probe armed");
+      break;
+    case 'd':
+      ArmProbes(false);
+      seed.PrintLine("probe begin %d", probe_count);
+      probe_dumping = 0;
+      probe_dumped = 0;
+      if (probe_count > 0) {
+        print_tap(0);
+      }
+      break;
+    case 'x':
+      ArmProbes(false);
+      seed.PrintLine("probe stopped");
+      break;
+    default:
+      break;
+  }
+
+  static const char hex[] = "0123456789abcdef";
+  uint32_t lines = 0;
+  while (probe_dumping >= 0 && lines < lines_per_call) {
+    if (probe_dumping >= probe_count) {
+      seed.PrintLine("probe end");
+      probe_dumping = -1;
+      break;
+    }
+    const SignalProbe &probe = probes[probe_dumping];
+    if (probe_dumped >= probe.filled) {
+      if (++probe_dumping < probe_count) {
+        print_tap(probe_dumping);
+      }
+      probe_dumped = 0;
+      continue;
+    }
+    const size_t oldest = probe.write + probe.frames - probe.filled;
+    char words[8 * 9 + 1];
+    char *c = words;
+    for (int n = 0; n < 8 && probe_dumped + n < probe.filled; n++) {
+      uint32_t bits;
+      memcpy(&bits, &probe.ring[(oldest + probe_dumped + n) % probe.frames],
+             sizeof(bits));
+      for (int d = 7; d >= 0; d--) {
+        *c++ = hex[(bits >> (d * 4)) & 0xF];
+      }
+      *c++ = ' ';
+    }
+    c[-1] = '\0';
+    seed.PrintLine("probe data %d %lu %s", probe_dumping,
+                   (unsigned long)probe_dumped, words);
+    probe_dumped += 8;
+    lines++;
+  }
+#endif
+#else
+  (void)lines_per_call;
+#endif
+}
+
+bool Hothouse::PostTelemetry(uint8_t type, const void *payload,
+                             size_t length) {
+#if HOTHOUSE_TELEMETRY
+  return telemetry.Post(type, payload, length);
+#else
+  (void)type;
+  (void)payload;
+  (void)length;
+  return false;
+#endif
+}
+
+void Hothouse::ServiceTelemetry(size_t bytes_per_call) {
+#if HOTHOUSE_TELEMETRY
+  if (!telemetry_started) {
+    StartLog();  // Brings up USB serial
+    telemetry_started = true;
+  }
+  telemetry.Drain(bytes_per_call, [this](uint8_t *data, size_t size) {
+    return seed.usb_handle.TransmitInternal(data, size) ==
+           daisy::UsbHandle::Result::OK;
+  });
+#else
+  (void)bytes_per_call;
+#endif
+}
+
+#if HOTHOUSE_UPLOAD
+// Upload protocol. The host sends frames, each an UploadHeader and its
+// payload, and waits for the pedal's reply line before sending the next:
+//   BEGIN  slot, size and CRC-32 of the whole upload (uint32 each)
+//   DATA   chunk seq = 0, 1, ...: UPLOAD_CHUNK bytes, the last one short
+//   END    no payload: the pedal checks the slot against BEGIN's CRC
+//   ABORT  no payload
+// The reply is "upload ok <seq>" or "upload error <seq> <why>", seq 0 for
+// all but DATA. A frame that fails its own CRC is answered "crc" and may be
+// sent again, and so may a DATA frame whose reply was lost: it isn't
+// written twice.
+Hothouse *Hothouse::uploading = nullptr;
+
+// zlib's CRC-32; crc is 0 or the CRC of the bytes before
+static uint32_t UploadCrc(uint32_t crc, const uint8_t *data, uint32_t length) {
+  crc = ~crc;
+  for (uint32_t i = 0; i < length; i++) {
+    crc ^= data[i];
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+    }
+  }
+  return ~crc;
+}
+
+// USB interrupt: buffer only
+void Hothouse::UploadReceive(uint8_t *buf, uint32_t *len) {
+  Hothouse *hh = uploading;
+  const uint32_t have = hh->upload_rx_len.load(std::memory_order_relaxed);
+  if (have + *len > sizeof(hh->upload_rx)) {
+    hh->upload_rx_overflow.store(true, std::memory_order_relaxed);
+    return;
+  }
+  memcpy(hh->upload_rx + have, buf, *len);
+  hh->upload_rx_len.store(have + *len, std::memory_order_release);
+}
+
+Hothouse::UploadEvent Hothouse::FailUpload(int *slot) {
+  *slot = upload_slot;
+  upload_slot = -1;
+  return UPLOAD_FAILED;
+}
+
+bool Hothouse::WriteUploadChunk(uint32_t offset, uint8_t *data,
+                                uint32_t length) {
+  const uint32_t base = upload_slots[upload_slot].offset;
+  // Erase each sector as the writes reach it
+  while (upload_erased < offset + length) {
+    if (seed.qspi.Erase(base + upload_erased,
+                        base + upload_erased + UPLOAD_SECTOR) !=
+        daisy::QSPIHandle::OK) {
+      return false;
+    }
+    upload_erased += UPLOAD_SECTOR;
+  }
+  if (seed.qspi.Write(base + offset, length, data) != daisy::QSPIHandle::OK) {
+    return false;
+  }
+
+  // Check what landed rather than what was sent, past any cached copy of
+  // the old contents
+  const uint8_t *written =
+      static_cast<const uint8_t *>(seed.qspi.GetData(base + offset));
+  const uintptr_t line = reinterpret_cast<uintptr_t>(written) & ~(uintptr_t)31;
+  SCB_InvalidateDCache_by_Addr(
+      reinterpret_cast<uint32_t *>(line),
+      (int32_t)(reinterpret_cast<uintptr_t>(written) + length - line));
+  upload_readback_crc = UploadCrc(upload_readback_crc, written, length);
+  return true;
+}
+
+Hothouse::UploadEvent Hothouse::HandleUploadFrame(const UploadHeader &header,
+                                                  uint8_t *payload,
+                                                  int *slot) {
+  const unsigned long seq = header.type == UPLOAD_DATA ? header.seq : 0;
+  upload_last_ms = System::GetNow();
+  if (UploadCrc(0, payload, header.length) != header.crc) {
+    seed.PrintLine("upload error %lu crc", seq);
+    return UPLOAD_NONE;
+  }
+
+  switch (header.type) {
+    case UPLOAD_BEGIN: {
+      uint32_t begin[3];  // Slot, size, CRC
+      memcpy(begin, payload, sizeof(begin));
+      if (header.length != sizeof(begin)) {
+        seed.PrintLine("upload error 0 frame");
+      } else if (upload_slot == (int)begin[0] && upload_size == begin[1] &&
+                 upload_crc == begin[2] && upload_next_seq == 0) {
+        seed.PrintLine("upload ok 0");  // Our reply was lost
+      } else if (upload_slot >= 0) {
+        seed.PrintLine("upload error 0 busy");
+      } else if (begin[0] >= (uint32_t)upload_slot_count) {
+        seed.PrintLine("upload error 0 slot");
+      } else if (begin[1] == 0 || begin[1] > upload_slots[begin[0]].size) {
+        seed.PrintLine("upload error 0 size");
+      } else {
+        upload_slot = (int)begin[0];
+        upload_size = begin[1];
+        upload_crc = begin[2];
+        upload_readback_crc = 0;
+        upload_next_seq = 0;
+        upload_erased = 0;
+        seed.PrintLine("upload ok 0");
+        *slot = upload_slot;
+        return UPLOAD_STARTED;
+      }
+      return UPLOAD_NONE;
+    }
+
+    case UPLOAD_DATA: {
+      if (upload_slot < 0) {
+        seed.PrintLine("upload error %lu idle", seq);
+        return UPLOAD_NONE;
+      }
+      if (header.seq + 1 == upload_next_seq) {
+        seed.PrintLine("upload ok %lu", seq);  // Our reply was lost
+        return UPLOAD_NONE;
+      }
+      const uint32_t offset = header.seq * UPLOAD_CHUNK;
+      if (header.seq != upload_next_seq || header.length == 0 ||
+          header.length > upload_size - offset ||
+          (header.length < UPLOAD_CHUNK &&
+           offset + header.length != upload_size)) {
+        seed.PrintLine("upload error %lu seq", seq);
+        return FailUpload(slot);
+      }
+      if (!WriteUploadChunk(offset, payload, header.length)) {
+        seed.PrintLine("upload error %lu qspi", seq);
+        return FailUpload(slot);
+      }
+      upload_next_seq++;
+      seed.PrintLine("upload ok %lu", seq);
+      return UPLOAD_NONE;
+    }
+
+    case UPLOAD_END:
+      if (upload_slot < 0) {
+        seed.PrintLine("upload error 0 idle");
+        return UPLOAD_NONE;
+      }
+      if (upload_next_seq * UPLOAD_CHUNK < upload_size) {
+        seed.PrintLine("upload error 0 short");
+        return FailUpload(slot);
+      }
+      if (upload_readback_crc != upload_crc) {
+        seed.PrintLine("upload error 0 verify");
+        return FailUpload(slot);
+      }
+      seed.PrintLine("upload ok 0");
+      *slot = upload_slot;
+      upload_slot = -1;
+      return UPLOAD_DONE;
+
+    case UPLOAD_ABORT:
+      seed.PrintLine("upload ok 0");
+      return upload_slot >= 0 ? FailUpload(slot) : UPLOAD_NONE;
+
+    default:
+      seed.PrintLine("upload error 0 frame");
+      return UPLOAD_NONE;
+  }
+}
+#endif
+
+void Hothouse::StartUpload(const UploadSlot *slots, int count) {
+#if HOTHOUSE_UPLOAD
+  upload_slots = slots;
+  upload_slot_count = count;
+  uploading = this;
+  StartLog();
+  seed.usb_handle.SetReceiveCallback(UploadReceive,
+                                     daisy::UsbHandle::FS_INTERNAL);
+#else
+  (void)slots;
+  (void)count;
+#endif
+}
+
+Hothouse::UploadEvent Hothouse::ServiceUpload(int *slot) {
+#if HOTHOUSE_UPLOAD
+  if (uploading == nullptr) {
+    return UPLOAD_NONE;  // Not started
+  }
+  const uint32_t now = System::GetNow();
+  if (upload_rx_overflow.exchange(false, std::memory_order_relaxed)) {
+    // More than a frame arrived: the host isn't waiting for replies
+    upload_rx_len.store(0, std::memory_order_relaxed);
+    seed.PrintLine("upload error 0 overflow");
+    return upload_slot >= 0 ? FailUpload(slot) : UPLOAD_NONE;
+  }
+
+  const uint32_t have = upload_rx_len.load(std::memory_order_acquire);
+  if (have != upload_rx_seen) {
+    upload_rx_seen = have;
+    upload_rx_seen_ms = now;
+  }
+  if (have >= sizeof(UploadHeader)) {
+    UploadHeader header;
+    memcpy(&header, upload_rx, sizeof(header));
+    if (header.magic != UPLOAD_MAGIC || header.length > UPLOAD_CHUNK) {
+      upload_rx_len.store(0, std::memory_order_relaxed);
+      upload_rx_seen = 0;
+      seed.PrintLine("upload error 0 frame");
+      return upload_slot >= 0 ? FailUpload(slot) : UPLOAD_NONE;
+    }
+    if (have >= sizeof(header) + header.length) {
+      const UploadEvent event =
+          HandleUploadFrame(header, upload_rx + sizeof(header), slot);
+      upload_rx_len.store(0, std::memory_order_relaxed);
+      upload_rx_seen = 0;
+      return event;
+    }
+  }
+
+  // Part of a frame, and then nothing: start again from the next one
+  if (have > 0 && now - upload_rx_seen_ms > 500) {
+    upload_rx_len.store(0, std::memory_order_relaxed);
+    upload_rx_seen = 0;
+    seed.PrintLine("upload error 0 frame");
+  }
+  if (upload_slot >= 0 && now - upload_last_ms > UPLOAD_TIMEOUT_MS) {
+    seed.PrintLine("upload error 0 timeout");
+    return FailUpload(slot);
+  }
+#else
+  (void)slot;
+#endif
+  return UPLOAD_NONE;
+}
+
+void Hothouse::StartLedService(float tick_hz) {
+  if (led_service_running) {
+    return;
+  }
+  const Pin pins[2] = {seed.GetPin(LED_1), seed.GetPin(LED_2)};
+  for (int i = 0; i < 2; i++) {
+    service_leds[i].Init(pins[i], false, tick_hz);
+    service_leds[i].Set(0.0f);
+    service_leds[i].Update();
+  }
+  led_ticks_per_ms = tick_hz / 1000.0f;
+  led_pattern_interval = led_ticks_per_ms > 1.0f ? (uint32_t)led_ticks_per_ms : 1;
+  led_pattern_countdown = 0;
+
+  TimerHandle::Config config;
+  config.periph = TimerHandle::Config::Peripheral::TIM_5;
+  config.dir = TimerHandle::Config::CounterDir::UP;
+  config.enable_irq = true;
+  led_timer.Init(config);
+  led_timer.SetPeriod((uint32_t)(led_timer.GetFreq() / tick_hz) - 1);
+  led_timer.SetCallback(LedTimerCallback, this);
+  led_timer.Start();
+  led_service_running = true;
+}
+
+void Hothouse::StopLedService() {
+  if (led_service_running) {
+    led_timer.Stop();
+    led_service_running = false;
+  }
+}
+
+void Hothouse::SetLedPattern(Led led, const LedPattern &pattern, bool restart) {
+  LedChannel &channel = led_channels[led == LED_2 ? 1 : 0];
+  int live = channel.live.load(std::memory_order_relaxed);
+  if (!restart && channel.published[live] == pattern) {
+    return;
+  }
+  int idle = live == 0 ? 1 : 0;
+  channel.published[idle] = pattern;
+  channel.restart[idle] = restart;
+  channel.live.store(idle, std::memory_order_release);
+  channel.sequence.fetch_add(1, std::memory_order_release);
+}
+
+void Hothouse::LedTimerCallback(void *data) {
+  static_cast<Hothouse *>(data)->LedTick();
+}
+
+void Hothouse::LedTick() {
+  led_ticks++;
+  if (led_pattern_countdown == 0) {
+    led_pattern_countdown = led_pattern_interval;
+    for (int i = 0; i < 2; i++) {
+      service_leds[i].Set(LedLevel(led_channels[i]));
+    }
+  }
+  led_pattern_countdown--;
+  service_leds[0].Update();
+  service_leds[1].Update();
+}
+
+// Picks up a newly published pattern, then works out the brightness for
+// the time since the pattern started
+float Hothouse::LedLevel(LedChannel &channel) {
+  uint32_t sequence = channel.sequence.load(std::memory_order_acquire);
+  if (sequence != channel.seen) {
+    channel.seen = sequence;
+    int live = channel.live.load(std::memory_order_acquire);
+    const LedPattern &pattern = channel.published[live];
+    if (channel.restart[live] || pattern != channel.shown) {
+      channel.shown = pattern;
+      channel.start_tick = led_ticks;
+    }
+    if (pattern.shape != LedPattern::BLINK) {
+      channel.resume = pattern;
+    }
+  }
+
+  const LedPattern &shown = channel.shown;
+  if (shown.shape == LedPattern::STEADY || shown.period_ms == 0) {
+    return shown.level;
+  }
+  uint32_t elapsed_ms = (uint32_t)((led_ticks - channel.start_tick) / led_ticks_per_ms);
+  if (shown.shape == LedPattern::BLINK &&
+      elapsed_ms >= shown.count * shown.period_ms) {
+    channel.shown = channel.resume;
+    channel.start_tick = led_ticks;
+    return LedLevel(channel);
+  }
+  float phase = (float)(elapsed_ms % shown.period_ms) / shown.period_ms;
+  switch (shown.shape) {
+    case LedPattern::BREATHE:
+      return shown.level * 0.5f * (1.0f - fastmath::Cos(6.28318531f * phase));
+    case LedPattern::BLINK:
+    case LedPattern::FLASH:
+      return phase < shown.duty ? shown.level : 0.0f;
+    default:
+      return shown.level;
+  }
+}
+
+void Hothouse::StopAudio() { seed.StopAudio(); }
+
+void Hothouse::SetAudioBlockSize(size_t size) {
+  seed.SetAudioBlockSize(size);
+  SetHidUpdateRates();
+}
+
+size_t Hothouse::AudioBlockSize() { return seed.AudioBlockSize(); }
+
+void Hothouse::SetAudioSampleRate(SaiHandle::Config::SampleRate samplerate) {
+  seed.SetAudioSampleRate(samplerate);
+  SetHidUpdateRates();
+}
+
+float Hothouse::AudioSampleRate() { return seed.AudioSampleRate(); }
+
+float Hothouse::AudioCallbackRate() { return seed.AudioCallbackRate(); }
+
+// What SelectAudioProfile() keeps in QSPI
+struct StoredAudioProfile {
+  uint32_t profile;
+  uint32_t quality;
+
+  bool operator==(const StoredAudioProfile &other) const {
+    return profile == other.profile && quality == other.quality;
+  }
+  bool operator!=(const StoredAudioProfile &other) const {
+    return !(*this == other);
+  }
+};
+
+const char *Hothouse::QualityName(Quality quality) {
+  static const char *const names[QUALITY_LAST] = {"Eco", "Normal", "High"};
+  return quality < QUALITY_LAST ? names[quality] : "?";
+}
+
+// One page of the power-up selector: the LEDs show choice of count (LED 1
+// the first, both in between, LED 2 the last), blinking for the second
+// page, until FOOTSWITCH 1 keeps it. Presses count once both footswitches
+// have been let go.
+uint32_t Hothouse::BootSelect(uint32_t choice, uint32_t count, bool blink) {
+  Switch &fs1 = switches[FOOTSWITCH_1];
+  Switch &fs2 = switches[FOOTSWITCH_2];
+  bool released = false;
+  for (;;) {
+    const bool lit = !blink || (System::GetNow() / 125) % 2 == 0;
+    service_leds[0].Set(lit && choice != count - 1 ? 1.0f : 0.0f);
+    service_leds[1].Set(lit && choice != 0 ? 1.0f : 0.0f);
+    service_leds[0].Update();
+    service_leds[1].Update();
+    System::Delay(1);
+    fs1.Debounce();
+    fs2.Debounce();
+    if (!released) {
+      released = !fs1.Pressed() && !fs2.Pressed();
+    } else if (fs2.RisingEdge()) {
+      choice = (choice + 1) % count;
+    } else if (fs1.RisingEdge()) {
+      return choice;
+    }
+  }
+}
+
+Hothouse::AudioProfile Hothouse::SelectAudioProfile(
+    const AudioProfileTable &table) {
+  PersistentStorage<StoredAudioProfile> storage(seed.qspi);
+  storage.Init({(uint32_t)table.default_profile, (uint32_t)QUALITY_NORMAL},
+               AUDIO_PROFILE_OFFSET);
+  const bool stored =
+      storage.GetState() == PersistentStorage<StoredAudioProfile>::State::USER;
+  AudioProfile profile = table.default_profile;
+  if (stored && storage.GetSettings().profile < AUDIO_PROFILE_LAST) {
+    profile = (AudioProfile)storage.GetSettings().profile;
+  }
+  // A record saved before there were levels has none
+  uint32_t picked = QUALITY_NORMAL;
+  if (stored && storage.GetSettings().quality < QUALITY_LAST) {
+    picked = storage.GetSettings().quality;
+  }
+
+  // Settles every switch, not just the footswitches, so the pedal can read
+  // its own power-up holds straight after without another 20 ms wait
+  for (int i = 0; i < 10; i++) {
+    for (size_t s = 0; s < SWITCH_LAST; s++) {
+      switches[s].Debounce();
+    }
+    System::Delay(2);
+  }
+  Switch &fs1 = switches[FOOTSWITCH_1];
+  Switch &fs2 = switches[FOOTSWITCH_2];
+  if (fs1.Pressed() && fs2.Pressed()) {
+    const Pin pins[2] = {seed.GetPin(LED_1), seed.GetPin(LED_2)};
+    for (int i = 0; i < 2; i++) {
+      service_leds[i].Init(pins[i], false);
+    }
+    const AudioProfile entered = profile;
+    const uint32_t entered_quality = picked;
+    profile = (AudioProfile)BootSelect(profile, AUDIO_PROFILE_LAST, false);
+#if HOTHOUSE_QUALITY < 0
+    picked = BootSelect(picked, QUALITY_LAST, true);
+#endif
+    if (profile != entered || picked != entered_quality || !stored) {
+      storage.GetSettings().profile = profile;
+      storage.GetSettings().quality = picked;
+      storage.Save();
+    }
+    while (fs1.Pressed() || fs2.Pressed()) {
+      System::Delay(1);
+      fs1.Debounce();
+      fs2.Debounce();
+    }
+    service_leds[0].Set(0.0f);
+    service_leds[1].Set(0.0f);
+    service_leds[0].Update();
+    service_leds[1].Update();
+  }
+#if HOTHOUSE_QUALITY >= 0
+  static_assert(HOTHOUSE_QUALITY < QUALITY_LAST, "HOTHOUSE_QUALITY is 0, 1 or 2");
+  quality = (Quality)HOTHOUSE_QUALITY;
+#else
+  quality = (Quality)picked;
+#endif
+
+  const AudioProfileTable::Format &format = table.formats[profile];
+  SetAudioSampleRate(format.sample_rate);
+  SetAudioBlockSize(format.block_size);
+  BootMark("SelectAudioProfile");
+  return profile;
+}
+
+void Hothouse::StartAdc() { seed.adc.Start(); }
+
+void Hothouse::StopAdc() { seed.adc.Stop(); }
+
+void Hothouse::ProcessDigitalControls() {
+  for (size_t i = 0; i < SWITCH_LAST; i++) {
+    switches[i].Debounce();
+  }
+  ProcessFootswitchPresses(FOOTSWITCH_1);
+  ProcessFootswitchPresses(FOOTSWITCH_2);
+#if HOTHOUSE_WATCHDOG
+  if (!watchdog_mode_fixed) {
+    uint32_t mode = 0;
+    for (int t = TOGGLESWITCH_1; t <= TOGGLESWITCH_3; t++) {
+      ToggleswitchPosition position = GetToggleswitchPosition((Toggleswitch)t);
+      if (position == TOGGLESWITCH_UNKNOWN) {
+        mode = 27;
+        break;
+      }
+      mode = mode * 3 + position;
+    }
+    watchdog_mode.store(mode, std::memory_order_relaxed);
+  }
+#endif
+}
+
+void Hothouse::SetControlRate(float rate_hz) {
+  control_rate = rate_hz > 0.0f ? rate_hz : 0.0f;
+  control_period_us = control_rate > 0.0f ? (uint32_t)(1e6f / control_rate) : 0;
+  SetHidUpdateRates();
+  control_last_us = System::GetUs();
+  ProcessAllControls();
+  PublishControls();
+}
+
+bool Hothouse::ServiceControls() {
+  if (control_rate <= 0.0f) {
+    return false;
+  }
+  uint32_t now = System::GetUs();
+  if (now - control_last_us < control_period_us) {
+    return false;
+  }
+  // Keep the grid, but don't burst to catch up after a long stall
+  control_last_us = now - control_last_us < 2 * control_period_us
+                        ? control_last_us + control_period_us
+                        : now;
+
+  ProcessAllControls();
+  PublishControls();
+  return true;
+}
+
+// Only ever written from the control task, which the audio callback
+// interrupts rather than the other way round, so the slot being filled is
+// never the one the callback is reading.
+void Hothouse::PublishControls() {
+  int live = control_live.load(std::memory_order_relaxed);
+  ControlSnapshot &snapshot = control_snapshots[live == 0 ? 1 : 0];
+
+  for (size_t i = 0; i < KNOB_LAST; i++) {
+    snapshot.knobs[i] = ReadKnob(i);
+    if (KnobChanged(static_cast<Knob>(i))) {
+      knob_changes[i]++;
+    }
+    snapshot.knob_changes[i] = knob_changes[i];
+  }
+  snapshot.toggleswitches[0] = GetToggleswitchPosition(TOGGLESWITCH_1);
+  snapshot.toggleswitches[1] = GetToggleswitchPosition(TOGGLESWITCH_2);
+  snapshot.toggleswitches[2] = GetToggleswitchPosition(TOGGLESWITCH_3);
+  for (int f = 0; f < 2; f++) {
+    Switches footswitch = f == 0 ? FOOTSWITCH_1 : FOOTSWITCH_2;
+    if (switches[footswitch].RisingEdge()) {
+      footswitch_presses[f]++;
+    }
+    snapshot.footswitch_pressed[f] = switches[footswitch].Pressed();
+    snapshot.footswitch_presses[f] = footswitch_presses[f];
+  }
+  snapshot.sequence = control_snapshots[live].sequence + 1;
+
+  control_live.store(live == 0 ? 1 : 0, std::memory_order_release);
+}
+
+void Hothouse::InitSwitches() {
+  constexpr Pin pin_numbers[SWITCH_LAST] = {
+      PIN_SW_1_UP, PIN_SW_1_DOWN, PIN_SW_2_UP, PIN_SW_2_DOWN,
+      PIN_SW_3_UP, PIN_SW_3_DOWN, PIN_FSW_1,   PIN_FSW_2,
+  };
+
+  for (size_t i = 0; i < SWITCH_LAST; i++) {
+    switches[i].Init(pin_numbers[i]);
+  }
+}
+
+Hothouse *Hothouse::footswitch_irq = nullptr;
+
+// Both edges of both footswitch pins raise an EXTI interrupt, at the audio
+// DMA's priority so it stamps an edge as it comes unless a callback is
+// running, and then as that returns. The host has no EXTI: every edge is
+// found by ProcessFootswitchPresses() reading the pin.
+void Hothouse::InitFootswitchIrq() {
+  footswitch_irq = this;
+#if defined(__arm__)
+  const Pin pins[2] = {PIN_FSW_1, PIN_FSW_2};
+  __HAL_RCC_SYSCFG_CLK_ENABLE();
+  for (int f = 0; f < 2; f++) {
+    const uint32_t line = pins[f].pin;
+    const uint32_t shift = (line & 3) * 4;
+    SYSCFG->EXTICR[line >> 2] =
+        (SYSCFG->EXTICR[line >> 2] & ~(0xFu << shift)) |
+        ((uint32_t)pins[f].port << shift);
+    EXTI->RTSR1 |= 1u << line;
+    EXTI->FTSR1 |= 1u << line;
+    EXTI_D1->PR1 = 1u << line;
+    EXTI_D1->IMR1 |= 1u << line;
+    const IRQn_Type irq = line <= 4   ? (IRQn_Type)(EXTI0_IRQn + line)
+                          : line <= 9 ? EXTI9_5_IRQn
+                                      : EXTI15_10_IRQn;
+    HAL_NVIC_SetPriority(irq, 0, 0);
+    HAL_NVIC_EnableIRQ(irq);
+  }
+#endif
+}
+
+void Hothouse::FootswitchIrq() {
+#if defined(__arm__)
+  Hothouse *hw = footswitch_irq;
+  const uint32_t now = System::GetUs();
+  const uint32_t lines[2] = {PIN_FSW_1.pin, PIN_FSW_2.pin};
+  for (int f = 0; f < 2; f++) {
+    const uint32_t mask = 1u << lines[f];
+    if (!(EXTI_D1->PR1 & mask)) {
+      continue;
+    }
+    EXTI_D1->PR1 = mask;
+    // A bounce: the pin is read again once it has settled
+    if (now - hw->footswitch_edge_us[f].load(std::memory_order_relaxed) <
+        FOOTSWITCH_DEBOUNCE_US) {
+      continue;
+    }
+    hw->footswitch_edge_us[f].store(now, std::memory_order_relaxed);
+    const uint32_t head = hw->footswitch_edge_head[f].load(std::memory_order_relaxed);
+    if (head - hw->footswitch_edge_tail[f].load(std::memory_order_acquire) >=
+        FOOTSWITCH_EDGES) {
+      continue;  // Full: the drain will see the pin instead
+    }
+    Switches footswitch = f == 0 ? FOOTSWITCH_1 : FOOTSWITCH_2;
+    hw->footswitch_edges[f][head % FOOTSWITCH_EDGES] = {
+        now, hw->switches[footswitch].RawState()};
+    hw->footswitch_edge_head[f].store(head + 1, std::memory_order_release);
+  }
+#endif
+}
+
+#if defined(__arm__)
+// PIN_FSW_1 is PA0 (EXTI line 0) and PIN_FSW_2 PD11 (line 11)
+extern "C" void EXTI0_IRQHandler() { Hothouse::FootswitchIrq(); }
+extern "C" void EXTI15_10_IRQHandler() { Hothouse::FootswitchIrq(); }
+#endif
+
+void Hothouse::InitAnalogControls() {
+  constexpr Pin knob_pins[KNOB_LAST] = {PIN_KNOB_1, PIN_KNOB_2, PIN_KNOB_3,
+                                        PIN_KNOB_4, PIN_KNOB_5, PIN_KNOB_6};
+
+  // Set order of ADCs based on CHANNEL NUMBER
+  AdcChannelConfig cfg[KNOB_LAST];
+
+  // Initialize ADC configuration with Single Pins
+  for (size_t i = 0; i < KNOB_LAST; ++i) {
+    cfg[i].InitSingle(knob_pins[i]);
+  }
+
+  // Initialize ADC with configuration
+  seed.adc.Init(cfg, KNOB_LAST, KNOB_OVERSAMPLING);
+
+  // Get the knob update rate once
+  float callback_rate = HidUpdateRate();
+
+  // Initialize knobs with ADC pointers and callback rate
+  for (size_t i = 0; i < KNOB_LAST; ++i) {
+    knob_adc[i] = seed.adc.GetPtr(i);
+    knobs[i].Init(seed.adc.GetPtr(i), callback_rate);
+  }
+}
+
+#if HOTHOUSE_EXPRESSION
+void Hothouse::InitExpression(Pin pin) {
+  constexpr Pin knob_pins[KNOB_LAST] = {PIN_KNOB_1, PIN_KNOB_2, PIN_KNOB_3,
+                                        PIN_KNOB_4, PIN_KNOB_5, PIN_KNOB_6};
+
+  // Knobs keep channels 0-5, expression is the last channel
+  AdcChannelConfig cfg[KNOB_LAST + 1];
+  for (size_t i = 0; i < KNOB_LAST; ++i) {
+    cfg[i].InitSingle(knob_pins[i]);
+  }
+  cfg[KNOB_LAST].InitSingle(pin);
+  seed.adc.Init(cfg, KNOB_LAST + 1, KNOB_OVERSAMPLING);
+
+  float callback_rate = HidUpdateRate();
+  for (size_t i = 0; i < KNOB_LAST; ++i) {
+    knob_adc[i] = seed.adc.GetPtr(i);
+    knobs[i].Init(seed.adc.GetPtr(i), callback_rate);
+  }
+  expression.Init(seed.adc.GetPtr(KNOB_LAST), callback_rate);
+}
+#endif
+
+// Public convenience function to get position of toggleswitches 1-3.
+Hothouse::ToggleswitchPosition Hothouse::GetToggleswitchPosition(
+    Toggleswitch tsw) {
+  switch (tsw) {
+    case (TOGGLESWITCH_1):
+      return GetLogicalSwitchPosition(switches[SWITCH_1_UP],
+                                      switches[SWITCH_1_DOWN]);
+    case (TOGGLESWITCH_2):
+      return GetLogicalSwitchPosition(switches[SWITCH_2_UP],
+                                      switches[SWITCH_2_DOWN]);
+    case (TOGGLESWITCH_3):
+      return GetLogicalSwitchPosition(switches[SWITCH_3_UP],
+                                      switches[SWITCH_3_DOWN]);
+    default:
+      seed.PrintLine(
+          "ERROR: Unexpected value provided for Toggleswitch 'tsw'. "
+          "Returning TOGGLESWITCH_UNKNOWN by default.");
+      return TOGGLESWITCH_UNKNOWN;
+  }
+}
+
+void Hothouse::CheckResetToBootloader() {
+  if (switches[Hothouse::FOOTSWITCH_1].Pressed()) {
+    if (footswitch_start_time[0] == 0) {
+      footswitch_start_time [0]= System::GetNow();
+    } else if (System::GetNow() - footswitch_start_time[0] >= HOLD_THRESHOLD_MS) {
+      // Shut 'er down so the LEDs always flash
+      StopAdc();
+      StopAudio();
+      StopLedService();
+      
+      daisy::Led _led_1, _led_2;
+      _led_1.Init(seed.GetPin(22), false);
+      _led_2.Init(seed.GetPin(23), false);
+
+      // Alternately flash the LEDs 3 times
+      for (int i = 0; i < 3; i++) {
+        _led_1.Set(1);
+        _led_2.Set(0);
+        _led_1.Update();
+        _led_2.Update();
+        System::Delay(100);
+
+        _led_1.Set(0);
+        _led_2.Set(1);
+        _led_1.Update();
+        _led_2.Update();
+        System::Delay(100);
+      }
+
+      // Reset system to bootloader after LED flashing
+      System::ResetToBootloader();
+    }
+  } else {
+    // Reset the hold timer if the footswitch is released
+    footswitch_start_time[0] = 0;
+  }
+}
+
+Hothouse::ToggleswitchPosition Hothouse::GetLogicalSwitchPosition(
+    const Switch &up, const Switch &down) {
+  return up.Pressed()
+             ? TOGGLESWITCH_UP
+             : (down.Pressed() ? TOGGLESWITCH_DOWN : TOGGLESWITCH_MIDDLE);
+}
+
+void Hothouse::RegisterFootswitchCallbacks(FootswitchCallbacks *callbacks) {
+  footswitchCallbacks = callbacks;
+}
+
+// Watches for normal, double, and long presses of the footswitches, timed
+// from the stamped edges FootswitchIrq() queues. Once the pin has been
+// quiet for the debounce time, a state the queue doesn't show (an edge
+// inside a bounce, a full queue, or any edge on the host) is taken from the
+// pin, stamped now.
+void Hothouse::ProcessFootswitchPresses(Switches footswitch) {
+  const int f = footswitch == Hothouse::FOOTSWITCH_1 ? 0 : 1;
+
+  const uint32_t head = footswitch_edge_head[f].load(std::memory_order_acquire);
+  uint32_t tail = footswitch_edge_tail[f].load(std::memory_order_relaxed);
+  for (; tail != head; tail++) {
+    const FootswitchEdge &edge = footswitch_edges[f][tail % FOOTSWITCH_EDGES];
+    FootswitchTransition(footswitch, edge.pressed, edge.us);
+  }
+  footswitch_edge_tail[f].store(tail, std::memory_order_release);
+
+  const uint32_t last_edge = footswitch_edge_us[f].load(std::memory_order_relaxed);
+  const uint32_t now = System::GetUs();
+  const bool pressed = switches[footswitch].RawState();
+  if (pressed != footswitch_down[f] && now - last_edge >= FOOTSWITCH_DEBOUNCE_US) {
+    FootswitchTransition(footswitch, pressed, now);
+  }
+
+  if (footswitch_down[f] && !footswitch_long_press_triggered[f] &&
+      now - footswitch_press_us[f] >= HOLD_THRESHOLD_MS * 1000) {
+    // Footswitch is being held down
+    if (footswitchCallbacks != NULL && footswitchCallbacks->HandleLongPress != NULL) {
+      footswitchCallbacks->HandleLongPress(footswitch);
+    }
+    footswitch_long_press_triggered[f] = true; // Ensure long press is only triggered once
+  }
+}
+
+// A press fires the normal or double press callback at once; a release
+// only ends the hold.
+void Hothouse::FootswitchTransition(Switches footswitch, bool pressed,
+                                    uint32_t us) {
+  const int f = footswitch == Hothouse::FOOTSWITCH_1 ? 0 : 1;
+  if (pressed == footswitch_down[f]) {
+    return;
+  }
+  footswitch_down[f] = pressed;
+  if (!pressed) {
+    return;
+  }
+
+  if (us - footswitch_press_us[f] <= DOUBLE_PRESS_THRESHOLD_MS * 1000) {
+    footswitch_press_count[f]++;
+  } else {
+    footswitch_press_count[f] = 1;
+  }
+  footswitch_press_us[f] = us;
+  footswitch_long_press_triggered[f] = false; // Reset long press trigger when pressed
+
+  if (footswitchCallbacks == NULL) {
+    return; // Nothing to do if callbacks have not been registered
+  }
+  if (footswitch_press_count[f] >= 2) {
+    if (footswitchCallbacks->HandleDoublePress != NULL) {
+      footswitchCallbacks->HandleDoublePress(footswitch);
+    }
+    footswitch_press_count[f] = 0;
+  } else if (footswitchCallbacks->HandleNormalPress != NULL) {
+    footswitchCallbacks->HandleNormalPress(footswitch);
+  }
+}
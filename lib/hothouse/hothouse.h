@@ -0,0 +1,1245 @@
+// Hardware proxy for Hothouse DIY DSP Platform
+// Copyright (C) 2024  Cleveland Music Co.  <code@clevelandmusicco.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// Shared by every pedal: list $(HOTHOUSE_DIR)/hothouse.cpp in CPP_SOURCES
+// and include $(HOTHOUSE_DIR)/hothouse.mk after the libDaisy core Makefile.
+
+#pragma once
+#ifndef HOTHOUSE_H
+#define HOTHOUSE_H
+
+#include <atomic>
+
+#include "daisy_seed.h"
+#include "hothouse_tcm.h"
+#include "hothouse_telemetry.h"
+#include "optional"
+
+/** Optional hardware, enabled per pedal from its Makefile */
+#ifndef HOTHOUSE_EXPRESSION
+#define HOTHOUSE_EXPRESSION 0  // InitExpression() and the expression control
+#endif
+#ifndef HOTHOUSE_LOAD_METER
+#define HOTHOUSE_LOAD_METER 0  // 1 = callback CPU load over USB serial, 2 = also on LED 2
+#endif
+#ifndef HOTHOUSE_WATCHDOG
+#define HOTHOUSE_WATCHDOG 0  // 1 = callback deadline stats, kept in QSPI
+#endif
+#ifndef HOTHOUSE_BOOT_TIMING
+#define HOTHOUSE_BOOT_TIMING 0  // 1 = time to each boot phase over USB serial
+#endif
+#ifndef HOTHOUSE_UPLOAD
+#define HOTHOUSE_UPLOAD 0  // 1 = blobs over USB serial into QSPI slots
+#endif
+#ifndef HOTHOUSE_ALLOC_CHECK
+#define HOTHOUSE_ALLOC_CHECK 0  // 1 = count heap allocations in the audio callback, 2 = trap on one
+#endif
+#ifndef HOTHOUSE_FLUSH_TO_ZERO
+#define HOTHOUSE_FLUSH_TO_ZERO 1  // 0 = keep IEEE subnormals and NaN propagation
+#endif
+#ifndef HOTHOUSE_DENORMAL_CHECK
+#define HOTHOUSE_DENORMAL_CHECK 0  // 1 = count flushed subnormals and NaNs over USB serial
+#endif
+#ifndef HOTHOUSE_MEMORY_REPORT
+#define HOTHOUSE_MEMORY_REPORT 0  // 1 = stack and heap high-water marks over USB serial
+#endif
+#ifndef HOTHOUSE_PROBE
+#define HOTHOUSE_PROBE 0  // 1 = named signal taps recorded into SDRAM, dumped over USB serial
+#endif
+#ifndef HOTHOUSE_LATENCY_TEST
+#define HOTHOUSE_LATENCY_TEST 0  // 1 = round-trip latency through a loopback cable, over USB serial
+#endif
+#ifndef HOTHOUSE_NULL_TEST
+#define HOTHOUSE_NULL_TEST 0  // 1 = an optimized stage against its reference, the difference on the right output
+#endif
+#ifndef HOTHOUSE_POWER_SAVE
+#define HOTHOUSE_POWER_SAVE 0  // 1 = sleep between main loop passes, half CPU clock in bypass
+#endif
+#ifndef HOTHOUSE_QUALITY
+#define HOTHOUSE_QUALITY -1  // 0-2 = the quality level fixed at Eco, Normal or High, -1 = the player's pick
+#endif
+#ifndef HOTHOUSE_TELEMETRY
+#define HOTHOUSE_TELEMETRY 0  // 1 = the reports as framed binary records over USB serial
+#endif
+
+using daisy::AdcChannelConfig;
+using daisy::AdcHandle;
+using daisy::AnalogControl;
+using daisy::AudioHandle;
+using daisy::CpuLoadMeter;
+using daisy::DaisySeed;
+using daisy::Led;
+using daisy::Pin;
+using daisy::SaiHandle;
+using daisy::Switch;
+using daisy::TimerHandle;
+
+namespace clevelandmusicco {
+class Hothouse {
+ public:
+  /** Switches */
+  enum Switches {
+    SWITCH_1_UP,   /** Up position of toggleswitch 1 */
+    SWITCH_1_DOWN, /** Down position of toggleswitch 1 */
+    SWITCH_2_UP,   /** Up position of toggleswitch 2 */
+    SWITCH_2_DOWN, /** Down position of toggleswitch 2 */
+    SWITCH_3_UP,   /** Up position of toggleswitch 3 */
+    SWITCH_3_DOWN, /** Down position of toggleswitch 3 */
+    FOOTSWITCH_1,  /** Footswitch 1 */
+    FOOTSWITCH_2,  /** Footswitch 2 */
+    SWITCH_LAST,   /**< Last enum item */
+  };
+
+  /** Knobs */
+  enum Knob {
+    KNOB_1,    /**< & */
+    KNOB_2,    /**< & */
+    KNOB_3,    /**< & */
+    KNOB_4,    /**< & */
+    KNOB_5,    /**< & */
+    KNOB_6,    /**< & */
+    KNOB_LAST, /**< & */
+  };
+
+  /** footswitch leds */
+  enum Led {
+    LED_1 = 22, /**< & */
+    LED_2 = 23, /**< & */
+    LED_LAST,   /**< & */
+  };
+
+  enum ToggleswitchPosition {
+    TOGGLESWITCH_UP,
+    TOGGLESWITCH_MIDDLE,
+    TOGGLESWITCH_DOWN,
+    TOGGLESWITCH_UNKNOWN,
+  };
+
+  enum Toggleswitch {
+    TOGGLESWITCH_1,
+    TOGGLESWITCH_2,
+    TOGGLESWITCH_3,
+  };
+
+  struct FootswitchCallbacks {
+    /** Called when a single footswitch press is detected. */
+    void (*HandleNormalPress)(Switches footswitch);
+
+    /** Called when a double footswitch press is detected. */
+    void (*HandleDoublePress)(Switches footswitch);
+
+    /** Called when a long footswitch press is detected. */
+    void (*HandleLongPress)(Switches footswitch);
+  };
+
+  /** Controls as the audio callback sees them when they are scanned at a
+   ** fixed rate outside it (see SetControlRate()). */
+  struct ControlSnapshot {
+    float knobs[KNOB_LAST];                /**< GetKnobValue() per knob */
+    ToggleswitchPosition toggleswitches[3]; /**< Per TOGGLESWITCH_1..3 */
+    bool footswitch_pressed[2];            /**< Debounced state */
+    uint32_t footswitch_presses[2]; /**< Rising edges so far; compare with the
+                                       last count seen to catch every press */
+    uint32_t knob_changes[KNOB_LAST]; /**< KnobChanged() scans so far; as
+                                         with footswitch_presses */
+    uint32_t sequence;              /**< Incremented on every publish */
+  };
+
+  /** What the LED service shows on one LED. Build one with the factories
+   ** below; times are in milliseconds. */
+  struct LedPattern {
+    enum Shape {
+      STEADY,  /**< level */
+      BLINK,   /**< count flashes of period_ms (half on), then back to the
+                    last pattern that wasn't a BLINK */
+      BREATHE, /**< A raised-cosine swell from 0 to level and back every
+                    period_ms */
+      FLASH,   /**< level for duty of every period_ms, e.g. a tempo */
+    };
+
+    Shape shape;
+    float level;        /**< Brightness 0-1 */
+    uint32_t period_ms; /**< BLINK, BREATHE and FLASH */
+    uint32_t count;     /**< BLINK: flashes before it ends */
+    float duty;         /**< FLASH: on fraction of the period */
+
+    static constexpr LedPattern Steady(float level) {
+      return {STEADY, level, 0, 0, 0.0f};
+    }
+    static constexpr LedPattern Blink(uint32_t count, uint32_t period_ms = 200,
+                                      float level = 1.0f) {
+      return {BLINK, level, period_ms, count, 0.5f};
+    }
+    static constexpr LedPattern Breathe(uint32_t period_ms,
+                                        float level = 1.0f) {
+      return {BREATHE, level, period_ms, 0, 0.0f};
+    }
+    static constexpr LedPattern Flash(uint32_t period_ms, float duty = 0.25f,
+                                      float level = 1.0f) {
+      return {FLASH, level, period_ms, 0, duty};
+    }
+
+    bool operator==(const LedPattern &other) const {
+      return shape == other.shape && level == other.level &&
+             period_ms == other.period_ms && count == other.count &&
+             duty == other.duty;
+    }
+    bool operator!=(const LedPattern &other) const { return !(*this == other); }
+  };
+
+  /** Boot-time audio profiles, from the lowest latency to the most CPU
+   ** headroom. The player picks one at power-up (see SelectAudioProfile()). */
+  enum AudioProfile {
+    AUDIO_PROFILE_LOW_LATENCY,  /**< Smallest block the DSP supports */
+    AUDIO_PROFILE_BALANCED,     /**< In between */
+    AUDIO_PROFILE_MAX_HEADROOM, /**< Largest block: least per-block overhead */
+    AUDIO_PROFILE_LAST,
+  };
+
+  /** System-wide quality levels, for the DSP that trades quality for CPU.
+   ** The player picks one at power-up along with the audio profile; each
+   ** pedal maps it to its own settings (its README says which), and a pedal
+   ** with nothing to trade runs the same at every level. */
+  enum Quality {
+    QUALITY_ECO,    /**< Least CPU: for stacking heavy modes without dropouts */
+    QUALITY_NORMAL, /**< The pedal's usual settings */
+    QUALITY_HIGH,   /**< The most the pedal has headroom for */
+    QUALITY_LAST,
+  };
+
+  /** The block size and sample rate a pedal's DSP runs at in each profile.
+   ** Every size must fit the pedal's buffers; a pedal whose DSP only works
+   ** at one rate repeats it. */
+  struct AudioProfileTable {
+    struct Format {
+      size_t block_size;
+      SaiHandle::Config::SampleRate sample_rate;
+    };
+    Format formats[AUDIO_PROFILE_LAST]; /**< Per AUDIO_PROFILE_* */
+    AudioProfile default_profile;       /**< Until the player picks one */
+  };
+
+  /** Modes the callback watchdog keeps separate stats for: by default the
+   ** toggle combination (SetWatchdogMode()) */
+  static const uint32_t WATCHDOG_MODES = 32;
+
+  /** One mode's callback timings. Each field is a single word the callback
+   ** writes and the main loop reads. */
+  struct WatchdogModeStats {
+    uint32_t blocks;       /**< Callbacks timed */
+    uint32_t overruns;     /**< Callbacks longer than the block period */
+    uint32_t late_starts;  /**< Callbacks that started more than 1.5 block
+                                periods after the last: a block was lost */
+    uint32_t worst_cycles; /**< Longest callback */
+  };
+
+  /** A session's watchdog stats, as kept in QSPI */
+  struct WatchdogStats {
+    uint32_t version;       /**< WATCHDOG_VERSION once written */
+    uint32_t block_size;
+    uint32_t sample_rate;
+    uint32_t period_cycles; /**< CPU cycles in one block period */
+    uint32_t quality;       /**< The session's Quality */
+    uint32_t seconds;       /**< Session length at the last save */
+    WatchdogModeStats modes[WATCHDOG_MODES];
+
+    bool operator==(const WatchdogStats &other) const;
+    bool operator!=(const WatchdogStats &other) const {
+      return !(*this == other);
+    }
+  };
+
+  // Constructor and Destructor
+  Hothouse() = default;
+  ~Hothouse() = default;
+
+  /** Initialize Hothouse */
+  void Init(bool boost = false);
+
+  /**
+     Wait before moving on.
+     \param del Delay time in ms.
+   */
+  void DelayMs(size_t del);
+
+  /** The main loop's wait between passes: System::Delay(), or with
+   ** HOTHOUSE_POWER_SAVE the same wait asleep in WFI, woken by each
+   ** interrupt (the 1 ms tick, audio DMA, USB) to check the time.
+   \param ms Wait in ms.
+   */
+  void IdleMs(uint32_t ms);
+
+  /** Starts the callback
+  \param cb Interleaved callback function
+  */
+  void StartAudio(AudioHandle::InterleavingAudioCallback cb);
+
+  /** Starts the callback
+  \param cb multichannel callback function
+  */
+  void StartAudio(AudioHandle::AudioCallback cb);
+
+  /**
+     Switch callback functions
+     \param cb New interleaved callback function.
+  */
+  void ChangeAudioCallback(AudioHandle::InterleavingAudioCallback cb);
+
+  /**
+     Switch callback functions
+     \param cb New multichannel callback function.
+  */
+  void ChangeAudioCallback(AudioHandle::AudioCallback cb);
+
+  /** Stops the audio if it is running. */
+  void StopAudio();
+
+  /** Updates the Audio Sample Rate, and reinitializes.
+   ** Audio must be stopped for this to work.
+   */
+  void SetAudioSampleRate(SaiHandle::Config::SampleRate samplerate);
+
+  /** Returns the audio sample rate in Hz as a floating point number.
+   */
+  float AudioSampleRate();
+
+  /** Sets the number of samples processed per channel by the audio callback.
+     \param size Audio block size
+   */
+  void SetAudioBlockSize(size_t size);
+
+  /** Returns the number of samples per channel in a block of audio. */
+  size_t AudioBlockSize();
+
+  /** Returns the rate in Hz that the Audio callback is called */
+  float AudioCallbackRate();
+
+  /** Applies the audio profile the player last picked, or the table's
+   ** default. Holding both footswitches at power-up opens the selector: the
+   ** LEDs show the profile (LED 1 Low-Latency, both Balanced, LED 2
+   ** Max-Headroom), FOOTSWITCH 2 steps through them and FOOTSWITCH 1 keeps
+   ** the one shown. The LEDs then blink the quality level the same way
+   ** (LED 1 Eco, both Normal, LED 2 High), stepped and kept with the same
+   ** footswitches. Both choices are saved in QSPI, at AUDIO_PROFILE_OFFSET;
+   ** with HOTHOUSE_QUALITY set the level is fixed and not offered.
+   ** Call it after Init() and before StartLedService() and StartAudio(); it
+   ** returns once both footswitches are released, with every switch
+   ** debounced, so Pressed() and GetToggleswitchPosition() already read the
+   ** positions held at power-up.
+   ** \return The profile in use
+   */
+  AudioProfile SelectAudioProfile(const AudioProfileTable &table);
+
+  /** The quality level SelectAudioProfile() picked (QUALITY_NORMAL before
+   ** it runs), for the pedal to set its DSP up from at boot */
+  Quality GetQuality() const { return quality; }
+
+  /** "Eco", "Normal" or "High", for logs */
+  static const char *QualityName(Quality quality);
+
+  /** The QSPI sector SelectAudioProfile() keeps the choice in: the last of
+   ** the 8MB, clear of the pedals' own settings */
+  static const uint32_t AUDIO_PROFILE_OFFSET = 0x7FF000;
+
+  /** Start analog to digital conversion. */
+  void StartAdc();
+
+  /** Stops Transfering data from the ADC */
+  void StopAdc();
+
+  /** How far a knob must move from where it was last flagged before
+   ** KnobChanged() reports it: about the filtered ADC's resting jitter */
+  static constexpr float KNOB_CHANGE_TOLERANCE = 0.005f;
+
+  /** The ADC's hardware oversampling. It scans the knobs continuously into
+   ** its DMA buffer, each reading the mean of this many conversions, so the
+   ** knobs need no filtering in software: GetKnobValue() reads the buffer. */
+  static constexpr AdcHandle::OverSampling KNOB_OVERSAMPLING = AdcHandle::OVS_128;
+
+  /** Updates the knob change flags (KnobChanged()). Call at the same
+   ** frequency as controls are read. */
+  inline void ProcessAnalogControls() {
+    knobs_changed = 0;
+    for (size_t i = 0; i < KNOB_LAST; i++) {
+      float value = ReadKnob(i);
+      if (!knobs_scanned || value > knob_reference[i] + KNOB_CHANGE_TOLERANCE ||
+          value < knob_reference[i] - KNOB_CHANGE_TOLERANCE) {
+        knob_reference[i] = value;
+        knobs_changed |= 1u << i;
+      }
+    }
+    knobs_scanned = true;
+  }
+
+  /** Process Analog and Digital Controls */
+  inline void ProcessAllControls() {
+    ProcessAnalogControls();
+    ProcessDigitalControls();
+  }
+
+  /** Scan the controls at a fixed rate from ServiceControls() instead of
+   ** calling ProcessAllControls() in the audio callback, so the scanning
+   ** cost no longer follows the block size. Retunes knobs[] to this rate
+   ** and publishes a first snapshot. 0 returns to scanning once
+   ** per callback.
+   \param rate_hz Control rate, e.g. 1000.
+   */
+  void SetControlRate(float rate_hz);
+
+  /** Call from the main loop, or a timer that cannot interrupt the audio
+   ** callback. When a control period has passed, processes all controls
+   ** (footswitch callbacks then fire here) and publishes a snapshot.
+   \return true if the controls were scanned.
+   */
+  bool ServiceControls();
+
+  /** The latest snapshot published by ServiceControls(). Lock-free: the
+   ** audio callback reads it in place, and it stays valid until the
+   ** callback returns.
+   */
+  const ControlSnapshot &Controls() const {
+    return control_snapshots[control_live.load(std::memory_order_acquire)];
+  }
+
+  /** Get value per knobs.
+  \param k Which knobs to get
+  \return Floating point knobs position.
+  */
+  inline float GetKnobValue(Knob k) {
+    return ReadKnob(k < KNOB_LAST ? k : KNOB_1);
+  }
+
+  /** Whether a knob moved more than KNOB_CHANGE_TOLERANCE in the last scan,
+   ** counted from where it was last flagged, so a slow turn is caught and
+   ** a resting knob never is. Every knob is flagged on the first scan.
+   ** Recompute what a knob's value feeds only when this is true.
+   \param k Which knob
+   */
+  inline bool KnobChanged(Knob k) const {
+    return k < KNOB_LAST && (knobs_changed & (1u << k)) != 0;
+  }
+
+  /** Whether any knob was flagged by the last scan */
+  inline bool AnyKnobChanged() const { return knobs_changed != 0; }
+
+  /** Process digital controls */
+  void ProcessDigitalControls();
+
+  /** Get the current position of a toggleswitch (up, down, or middle).
+  \param tsw Which toggleswitch to interogate (TOGGLESWITCH_1, TOGGLESWITCH_2,
+  or TOGGLESWITCH_3) \return TOGGLESWITCH_UP (0), TOGGLESWITCH_MIDDLE (1), or
+  TOGGLESWITCH_DOWN (2). \note If the toggleswitch in question is ON-ON (rather
+  than ON-OFF-ON), TOGGLESWITCH_MIDDLE can never be the return value. Write
+  your code with this in mind.
+  */
+  ToggleswitchPosition GetToggleswitchPosition(Toggleswitch tsw);
+
+  /** Check whether FOOTSWITCH_1 (the left foot switch) has been held down for 2
+   * seconds and, if it has, call System::ResetToBootloader(). This has the same
+   * effect as pressing the Daisy Seed RESET and BOOT buttons to get into
+   * flashable (DFU)) mode. \note The LEDs will alternately flash three times
+   * before the reset. */
+  void CheckResetToBootloader();
+
+  /** Register/Deregister footswitch press callbacks. This provides an
+   * alternative way of handling foot switch presses and allows effects to make
+   * use of double and long presses. Presses are timed from edges the EXTI
+   * interrupt stamps, without the Switch's polled debounce: normal and double
+   * presses fire at the next control scan after the foot goes down, whatever
+   * the block size (within 1 ms with SetControlRate(1000)).
+   * \param callbacks A pointer to the struct that defines the callbacks or NULL
+   * to deregister all callbacks.
+   */
+  void RegisterFootswitchCallbacks(FootswitchCallbacks *callbacks);
+
+  /** For the EXTI handlers in hothouse.cpp: stamps and queues an edge on
+   ** either footswitch for ProcessFootswitchPresses(). */
+  static void FootswitchIrq();
+
+  /** Starts the USB serial log (without waiting for a monitor) unless it is
+   ** already running, so the pedal and the load meter can both ask for it. */
+  void StartLog();
+
+  /** Call from the main loop. With HOTHOUSE_LOAD_METER, StartAudio() and
+   ** ChangeAudioCallback() wrap the callback in a CpuLoadMeter; this prints
+   ** its average and peak load over USB serial every report_ms and then
+   ** starts a new peak window. Does nothing otherwise.
+   \param report_ms Time between reports.
+   */
+  void ServiceLoadMeter(uint32_t report_ms = 2000);
+
+  /** Brightness for LED 2: status as given, or with HOTHOUSE_LOAD_METER=2
+   ** the callback's peak load in the current report window (full = 100%),
+   ** or with HOTHOUSE_LATENCY_TEST lit while its clicks come back.
+   \param status The pedal's own LED 2 brightness.
+   */
+  inline float LoadLed(float status) const {
+#if HOTHOUSE_LATENCY_TEST
+    (void)status;
+    return latency_found.load(std::memory_order_relaxed) ? 1.0f : 0.0f;
+#elif HOTHOUSE_LOAD_METER >= 2
+    (void)status;
+    return peak_load;
+#else
+    return status;
+#endif
+  }
+
+  /** The pedal mode the watchdog files the following callbacks under, below
+   ** WATCHDOG_MODES. Until a pedal calls this the mode follows the toggles:
+   ** TOGGLESWITCH_1 * 9 + TOGGLESWITCH_2 * 3 + TOGGLESWITCH_3 (UP = 0), 27
+   ** while one reads unknown. Safe from the callback. */
+  inline void SetWatchdogMode(uint32_t mode) {
+#if HOTHOUSE_WATCHDOG
+    watchdog_mode_fixed = true;
+    watchdog_mode.store(mode < WATCHDOG_MODES ? mode : WATCHDOG_MODES - 1,
+                        std::memory_order_relaxed);
+#else
+    (void)mode;
+#endif
+  }
+
+  /** Call from the main loop. With HOTHOUSE_WATCHDOG, StartAudio() and
+   ** ChangeAudioCallback() time every callback against the block period;
+   ** this prints the last session's stats and this one's over USB serial
+   ** every report_ms, and saves this session's to QSPI (WATCHDOG_OFFSET)
+   ** after save_ms and then whenever an overrun count or a worst case has
+   ** grown, at most once per save_ms: one sector erase each time. Does
+   ** nothing otherwise.
+   ** With APP_TYPE = BOOT_QSPI a save stalls the callback too; the blocks
+   ** it stalls aren't counted.
+   \param report_ms Time between reports.
+   \param save_ms Shortest time between saves.
+   */
+  void ServiceWatchdog(uint32_t report_ms = 10000, uint32_t save_ms = 120000);
+
+  /** The stats the last session saved, with version 0 if there are none
+   ** (read when audio starts) */
+  const WatchdogStats &WatchdogLastSession() const { return watchdog_last; }
+
+  /** Layout of WatchdogStats in QSPI */
+  static const uint32_t WATCHDOG_VERSION = 2;
+
+  /** The QSPI sector the watchdog keeps its stats in, below
+   ** AUDIO_PROFILE_OFFSET */
+  static const uint32_t WATCHDOG_OFFSET = 0x7FE000;
+
+  /** Notes the time since libDaisy started its clock against phase (a
+   ** string literal), for ServiceBootTiming(). Init(), SelectAudioProfile()
+   ** and StartAudio() mark their own ends; a pedal marks the steps between.
+   ** Keeps the first BOOT_MARKS. Does nothing unless HOTHOUSE_BOOT_TIMING. */
+  inline void BootMark(const char *phase) {
+#if HOTHOUSE_BOOT_TIMING
+    if (boot_mark_count < BOOT_MARKS) {
+      boot_marks[boot_mark_count].phase = phase;
+      boot_marks[boot_mark_count].us = daisy::System::GetUs();
+      boot_mark_count++;
+    }
+#else
+    (void)phase;
+#endif
+  }
+
+  /** Call from the main loop. With HOTHOUSE_BOOT_TIMING, prints the boot
+   ** marks over USB serial on the first call and every report_ms after: the
+   ** time at each and the time its phase took. Does nothing otherwise.
+   \param report_ms Time between reports, for a monitor that connects late.
+   */
+  void ServiceBootTiming(uint32_t report_ms = 5000);
+
+  /** Call from the main loop. With HOTHOUSE_ALLOC_CHECK, StartAudio() and
+   ** ChangeAudioCallback() mark the time spent in the callback, and every
+   ** heap allocation made there is counted: operator new, and on the Seed
+   ** malloc, calloc and realloc too (hothouse.mk wraps them at link time).
+   ** This prints the count and the return address of the first (for
+   ** addr2line) over USB serial every report_ms once there is one.
+   ** HOTHOUSE_ALLOC_CHECK=2 traps on the first instead, which stops a
+   ** debugger at the allocating call. Does nothing otherwise.
+   \param report_ms Time between reports.
+   */
+  void ServiceAllocCheck(uint32_t report_ms = 2000);
+
+  /** With HOTHOUSE_DENORMAL_CHECK, adds count floats at data (a delay
+   ** line, a filter's state) to what ServiceDenormalCheck() scans, under
+   ** name (a string literal). Keeps the first DENORMAL_WATCHES. Does
+   ** nothing otherwise. */
+  inline void WatchDenormals(const float *data, size_t count,
+                             const char *name) {
+#if HOTHOUSE_DENORMAL_CHECK
+    if (denormal_watch_count < DENORMAL_WATCHES) {
+      denormal_watches[denormal_watch_count++] = {data, count, name};
+    }
+#else
+    (void)data;
+    (void)count;
+    (void)name;
+#endif
+  }
+
+  /** Call from the main loop. With HOTHOUSE_DENORMAL_CHECK, StartAudio()
+   ** and ChangeAudioCallback() clear the FPU's cumulative exception flags
+   ** before each callback and count the callbacks that leave them set: IDC
+   ** (a subnormal input flushed to zero), UFC (a result flushed or
+   ** underflowed) and IOC (an invalid operation, so a NaN). Every
+   ** report_ms this prints the counts since the last report over USB
+   ** serial, and the subnormals, NaNs and infinities in each watched array
+   ** (read while the callback writes them: a sample, not a snapshot). On
+   ** the host fenv's underflow and invalid flags stand in and IDC reads 0.
+   ** Does nothing otherwise.
+   \param report_ms Time between reports.
+   */
+  void ServiceDenormalCheck(uint32_t report_ms = 1000);
+
+  static const int DENORMAL_WATCHES = 8;
+
+  /** Call from the main loop. With HOTHOUSE_MEMORY_REPORT, Init() paints the
+   ** STACK_PAINT_BYTES under the top of the stack (the audio callback runs
+   ** on the same one), and this prints over USB serial, on the first call
+   ** and every report_ms after: the most of it ever used, the heap's size
+   ** and what is in use of it now, the static data in AXI SRAM and, with
+   ** their make options, the SDRAM arena and the DTCM and ITCM sections.
+   ** `make memory-report` lists what the link put in each region. Does
+   ** nothing otherwise.
+   \param report_ms Time between reports, 0 for only the first.
+   */
+  void ServiceMemoryReport(uint32_t report_ms = 10000);
+
+  /** The same report at once, for a pedal to print on demand (a footswitch
+   ** hold, say). Main loop only. Does nothing unless HOTHOUSE_MEMORY_REPORT. */
+  void ReportMemory();
+
+  /** How deep Init() paints the stack for ServiceMemoryReport(): well clear
+   ** of the statics at the bottom of DTCM unless `make tcm-report` shows
+   ** them within this of the top */
+  static const uint32_t STACK_PAINT_BYTES = 16384;
+
+  /** With HOTHOUSE_PROBE, a named tap point on a signal, recording its
+   ** latest frames samples at rate_hz (0 for the audio rate) into a ring
+   ** carved from sdramArena. Call from main() before StartAudio(); name
+   ** must outlive the probe (a string literal).
+   \return The id for Probe(), or -1 without HOTHOUSE_PROBE, after PROBES
+   ** or once the arena is full.
+   */
+  int AddProbe(const char *name, size_t frames, float rate_hz = 0.0f);
+
+  /** Callback: while the probes are armed, copies the block at data into
+   ** probe id's ring, in at most two memcpys. Disarmed it is a load and a
+   ** branch; without HOTHOUSE_PROBE, nothing. Ids of -1 are ignored. */
+  inline void Probe(int id, const float *data, size_t size) {
+#if HOTHOUSE_PROBE
+    if (id >= 0 && probes_armed.load(std::memory_order_relaxed)) {
+      WriteProbe(probes[id], data, size);
+    }
+#else
+    (void)id;
+    (void)data;
+    (void)size;
+#endif
+  }
+
+  /** Starts every probe recording afresh, or stops them. Main loop. */
+  void ArmProbes(bool armed);
+
+  /** Call from the main loop. With HOTHOUSE_PROBE, takes one-letter
+   ** commands over USB serial, from tools/hothouse_probe.py: a arms the
+   ** probes, d stops them and dumps what they hold, x stops them. A dump
+   ** goes out lines_per_call lines at a time, so the pedal plays on. Not
+   ** with HOTHOUSE_UPLOAD, which reads USB serial too. Does nothing
+   ** otherwise.
+   \param lines_per_call Dump lines (8 samples each) per call.
+   */
+  void ServiceProbes(uint32_t lines_per_call = 32);
+
+  static const int PROBES = 8;
+
+  /** Call from the main loop. With HOTHOUSE_LATENCY_TEST, StartAudio() and
+   ** ChangeAudioCallback() take over the callback's input for a loopback
+   ** cable from output 1 to input 1: every LATENCY_PERIOD_MS a click goes
+   ** out, alternately added to the pedal's output (the codec and block
+   ** buffering alone) and fed to the pedal as its input (through its DSP
+   ** too), and the loudest input sample in the period after it marks its
+   ** return. The pedal otherwise hears silence, so the cable doesn't feed
+   ** back. After each pair this prints both round trips in samples and ms
+   ** and the pedal's own share, the difference, over USB serial; LoadLed()
+   ** lights while clicks are coming back. Set the pedal fully wet: a dry
+   ** path returns the click at the codec's latency. Does nothing otherwise.
+   */
+  void ServiceLatencyTest();
+
+  static const uint32_t LATENCY_PERIOD_MS = 500;
+  static const size_t LATENCY_MAX_BLOCK = 512;  // Longer blocks pass through
+
+  /** Callback. With HOTHOUSE_NULL_TEST, compares size samples of a stage's
+   ** candidate output (an optimized kernel's) with its reference (the same
+   ** input through the original code), for ServiceNullTest(): the peak of
+   ** the difference and its energy against the reference's. After the
+   ** pedal's callback returns, the right output is overwritten with
+   ** (candidate - reference) * NULL_TEST_GAIN, silent in blocks that
+   ** compared nothing. Calls in one block fill the difference in order, up
+   ** to NULL_TEST_MAX_BLOCK. Does nothing otherwise.
+   */
+  inline void NullTest(const float *reference, const float *candidate,
+                       size_t size) {
+#if HOTHOUSE_NULL_TEST
+    CompareNull(reference, candidate, size);
+#else
+    (void)reference;
+    (void)candidate;
+    (void)size;
+#endif
+  }
+
+  /** Call from the main loop. With HOTHOUSE_NULL_TEST, prints over USB
+   ** serial, every NULL_TEST_PERIOD_MS of audio, what NullTest() compared
+   ** in it: the peak difference in dBFS and the reference's SNR against
+   ** the difference, or that the two were bit-exact. Does nothing
+   ** otherwise.
+   */
+  void ServiceNullTest();
+
+  static const uint32_t NULL_TEST_PERIOD_MS = 1000;
+  static const size_t NULL_TEST_MAX_BLOCK = 512;
+  static constexpr float NULL_TEST_GAIN = 1000.0f;  // +60 dB, to hear it
+
+  /** With HOTHOUSE_TELEMETRY, queues a record of type (kTelemetryUser up
+   ** for a pedal's own) for ServiceTelemetry(): length bytes of payload, at
+   ** most kTelemetryPayload. Main loop only. Returns false if it was
+   ** dropped (counted in the next DROPPED record), and always without
+   ** HOTHOUSE_TELEMETRY. */
+  bool PostTelemetry(uint8_t type, const void *payload, size_t length);
+
+  /** PostTelemetry() from the audio callback: a copy into a queue of its
+   ** own, nothing more */
+  inline bool PostTelemetryFromAudio(uint8_t type, const void *payload,
+                                     size_t length) {
+#if HOTHOUSE_TELEMETRY
+    return telemetry.PostFromAudio(type, payload, length);
+#else
+    (void)type;
+    (void)payload;
+    (void)length;
+    return false;
+#endif
+  }
+
+  /** Call from the main loop, after the other Service calls. With
+   ** HOTHOUSE_TELEMETRY the load meter, watchdog, boot timing, allocation
+   ** and denormal checks, memory report, latency and null tests and probe
+   ** dumps post
+   ** framed records (hothouse_telemetry.h) instead of printing lines, and
+   ** this sends up to bytes_per_call of them over USB serial, without
+   ** waiting: when the port is still busy with the last batch it returns
+   ** and offers the same batch next time. tools/hothouse_telemetry.py
+   ** decodes them. Does nothing otherwise.
+   \param bytes_per_call Most bytes framed and handed to USB per call.
+   */
+  void ServiceTelemetry(size_t bytes_per_call = 256);
+
+  /** Records each of the telemetry queues holds (callback and main loop) */
+  static const size_t TELEMETRY_RECORDS = 64;
+
+  /** Whether the pedal is passing its input straight through, for
+   ** ServicePower(). Call it from the callback every block, before the
+   ** DSP: on false it puts the CPU back at full clock at once, so the
+   ** block that leaves bypass already runs at full speed. Does nothing
+   ** unless HOTHOUSE_POWER_SAVE. */
+  inline void SetBypassed(bool bypassed) {
+#if HOTHOUSE_POWER_SAVE
+    power_bypassed.store(bypassed, std::memory_order_relaxed);
+    if (!bypassed && power_reduced.load(std::memory_order_relaxed)) {
+      SetCpuClockReduced(false);
+    }
+#else
+    (void)bypassed;
+#endif
+  }
+
+  /** Call from the main loop. With HOTHOUSE_POWER_SAVE, halves the CPU
+   ** clock once SetBypassed(true) has held for reduce_after_ms. Only the
+   ** core's prescaler changes: the bus, timer and audio clocks stay as
+   ** they were, so the codec and System::GetNow() keep running. Does
+   ** nothing otherwise.
+   \param reduce_after_ms Time in bypass before the clock drops.
+   */
+  void ServicePower(uint32_t reduce_after_ms = 5000);
+
+  /** True while ServicePower() has the CPU clock halved */
+  inline bool CpuClockReduced() const {
+#if HOTHOUSE_POWER_SAVE
+    return power_reduced.load(std::memory_order_relaxed);
+#else
+    return false;
+#endif
+  }
+
+  static const int BOOT_MARKS = 16;
+
+  /** A QSPI region StartUpload() lets the host write */
+  struct UploadSlot {
+    uint32_t offset;  // From the start of QSPI, on a 4 KB sector boundary
+    uint32_t size;    // Largest upload it takes, erased in whole sectors
+  };
+
+  /** What one ServiceUpload() call did */
+  enum UploadEvent {
+    UPLOAD_NONE,
+    UPLOAD_STARTED,  // The slot is erased and written from the next call on
+    UPLOAD_DONE,     // The slot holds the whole upload, read back and CRC-checked
+    UPLOAD_FAILED,   // Given up on (error, abort or timeout): the slot is junk
+  };
+
+  /** With HOTHOUSE_UPLOAD, starts the USB serial log (StartLog()) and takes
+   ** uploads into slots from tools/hothouse_upload.py over it. slots is
+   ** kept, not copied. The USB interrupt only buffers what arrives; the
+   ** erasing and writing happen in ServiceUpload(). Does nothing otherwise.
+   \param slots The regions the host may write, by index.
+   \param count Number of slots.
+   */
+  void StartUpload(const UploadSlot *slots, int count);
+
+  /** Call from the main loop. With HOTHOUSE_UPLOAD, handles the next frame
+   ** from the host: at most one chunk's erase and write per call, so audio
+   ** runs on through an upload. UPLOAD_STARTED comes before anything in a
+   ** slot is erased, so the pedal can stop reading it; it should only read
+   ** it again after UPLOAD_DONE. An upload that stops for UPLOAD_TIMEOUT_MS
+   ** fails. Returns UPLOAD_NONE otherwise.
+   ** With APP_TYPE = BOOT_QSPI every erase and write stalls the callback,
+   ** so audio drops out while uploading.
+   \param slot Set to the slot the event is about.
+   */
+  UploadEvent ServiceUpload(int *slot);
+
+  /** Payload bytes per data frame: every chunk but an upload's last is full */
+  static const uint32_t UPLOAD_CHUNK = 1024;
+  static const uint32_t UPLOAD_TIMEOUT_MS = 5000;
+
+  /** Drives LED_1 and LED_2 from a TIM5 interrupt at tick_hz: software PWM
+   ** on every tick and the patterns at 1 kHz. libDaisy runs timer interrupts
+   ** below the audio DMA, so this never delays a block, and the pedal only
+   ** publishes what to show (SetLed(), SetLedPattern()) instead of calling
+   ** Led::Update() in the callback. Call after Init().
+   \param tick_hz PWM tick rate; Led's 120 Hz PWM has tick_hz / 120 steps.
+   */
+  void StartLedService(float tick_hz = 8000.0f);
+
+  /** Stops the LED interrupt, e.g. so the bootloader flash can drive the
+   ** pins directly. The LEDs keep their last state. */
+  void StopLedService();
+
+  /** Steady brightness 0-1 for LED_1 or LED_2 */
+  inline void SetLed(Led led, float brightness) {
+    SetLedPattern(led, LedPattern::Steady(brightness));
+  }
+
+  /** Shows a pattern on LED_1 or LED_2. Setting the pattern already shown is
+   ** a compare and nothing else, so the callback can set its LEDs every
+   ** block. Set each LED from one context (the callback or the main loop).
+   \param restart Start the pattern's period over even if it is unchanged,
+   e.g. to line a tempo FLASH up with a tap.
+   */
+  void SetLedPattern(Led led, const LedPattern &pattern, bool restart = false);
+
+#if HOTHOUSE_EXPRESSION
+  /** Adds an expression pedal input on a spare Seed ADC pin (the Hothouse
+   ** has no expression jack). Reconfigures the ADC with the knobs plus this
+   ** channel; call after Init() and before StartAdc(). It re-inits the
+   ** knobs[] readers and the expression control at the library's control
+   ** rate, so call it before any SetSampleRate() on them, or that rate is
+   ** lost.
+   \param pin Seed pin wired to the expression jack's wiper.
+   */
+  void InitExpression(Pin pin);
+#endif
+
+  DaisySeed seed; /**< & */
+
+  AnalogControl knobs[KNOB_LAST]; /**< Slewed readers on the same channels,
+                                     for a pedal that wants one; the
+                                     library reads the ADC directly */
+  Switch switches[SWITCH_LAST];   /**< & */
+#if HOTHOUSE_EXPRESSION
+  AnalogControl expression;       /**< Valid after InitExpression() */
+#endif
+
+ private:
+  void SetHidUpdateRates();
+  float HidUpdateRate();
+  void PublishControls();
+  void InitSwitches();
+  void InitAnalogControls();
+  ToggleswitchPosition GetLogicalSwitchPosition(const Switch &up,
+                                                const Switch &down);
+  void ProcessFootswitchPresses(Switches footswitch);
+  void FootswitchTransition(Switches footswitch, bool pressed, uint32_t us);
+  void InitFootswitchIrq();
+
+  uint32_t footswitch_start_time[2] = {0, 0};  // For CheckResetToBootloader()
+  uint8_t footswitch_press_count[2] = {0, 0};
+  bool footswitch_long_press_triggered[2] = {false, false};
+  static const uint32_t HOLD_THRESHOLD_MS = 2000;  // 2 second hold time
+  static const uint32_t DOUBLE_PRESS_THRESHOLD_MS = 600;
+
+  // Footswitch edges. The EXTI interrupt stamps each one that isn't a
+  // bounce and queues it; ProcessFootswitchPresses() drains the queue and
+  // times presses from the stamps, on the System::GetUs() clock.
+  struct FootswitchEdge {
+    uint32_t us;
+    bool pressed;
+  };
+  static const uint32_t FOOTSWITCH_EDGES = 8;  // Queued per footswitch
+  static const uint32_t FOOTSWITCH_DEBOUNCE_US = 5000;
+  static Hothouse *footswitch_irq;
+  FootswitchEdge footswitch_edges[2][FOOTSWITCH_EDGES] = {};
+  std::atomic<uint32_t> footswitch_edge_head[2] = {};  // Interrupt writes
+  std::atomic<uint32_t> footswitch_edge_tail[2] = {};  // Drain writes
+  std::atomic<uint32_t> footswitch_edge_us[2] = {};    // Last taken, for debounce
+  bool footswitch_down[2] = {false, false};  // As the edges have it
+  uint32_t footswitch_press_us[2] = {0, 0};  // The latest press's stamp
+
+  inline uint16_t* adc_ptr(const uint8_t chn) { return seed.adc.GetPtr(chn); }
+
+  // Knob k straight from the ADC's DMA buffer, 0 to 1
+  inline float ReadKnob(size_t k) const {
+    return *knob_adc[k] * (1.0f / 65535.0f);
+  }
+  const volatile uint16_t *knob_adc[KNOB_LAST] = {};
+
+  FootswitchCallbacks *footswitchCallbacks = NULL;
+
+  // Change flags: the value each knob was last flagged at, and the knobs
+  // flagged by the latest ProcessAnalogControls()
+  float knob_reference[KNOB_LAST] = {};
+  uint32_t knobs_changed = 0;
+  bool knobs_scanned = false;
+
+  // Fixed-rate control scanning. The callback reads the live snapshot; the
+  // scan writes the other one and then swaps.
+  float control_rate = 0.0f;  // 0 = scanned in the audio callback
+  uint32_t control_period_us = 0;
+  uint32_t control_last_us = 0;
+  uint32_t footswitch_presses[2] = {0, 0};
+  uint32_t knob_changes[KNOB_LAST] = {};
+  ControlSnapshot control_snapshots[2] = {};
+  std::atomic<int> control_live{0};
+
+  Quality quality = QUALITY_NORMAL;  // SelectAudioProfile()'s pick
+  uint32_t BootSelect(uint32_t choice, uint32_t count, bool blink);
+
+  bool log_started = false;
+
+#if HOTHOUSE_LOAD_METER || HOTHOUSE_WATCHDOG || HOTHOUSE_ALLOC_CHECK || \
+    HOTHOUSE_DENORMAL_CHECK || HOTHOUSE_LATENCY_TEST || HOTHOUSE_NULL_TEST
+  // The pedal's callback, run inside the meter, the watchdog, the
+  // allocation check, the denormal check and the latency and null tests by
+  // the Metered* trampolines
+  static void MeteredCallback(AudioHandle::InputBuffer in,
+                              AudioHandle::OutputBuffer out, size_t size);
+  static void MeteredInterleavingCallback(
+      AudioHandle::InterleavingInputBuffer in,
+      AudioHandle::InterleavingOutputBuffer out, size_t size);
+  void MeterAudio();
+  inline void BeginMeteredBlock() {
+#if HOTHOUSE_WATCHDOG
+    BeginWatchdogBlock();
+#endif
+#if HOTHOUSE_DENORMAL_CHECK
+    BeginDenormalBlock();
+#endif
+#if HOTHOUSE_LOAD_METER
+    if (load_meter_reset.exchange(false, std::memory_order_acquire)) {
+      load_meter.Reset();
+    }
+    load_meter.OnBlockStart();
+#endif
+  }
+  inline void EndMeteredBlock() {
+#if HOTHOUSE_DENORMAL_CHECK
+    EndDenormalBlock();
+#endif
+#if HOTHOUSE_LOAD_METER
+    load_meter.OnBlockEnd();
+#endif
+#if HOTHOUSE_WATCHDOG
+    EndWatchdogBlock();
+#endif
+  }
+
+  static Hothouse *metered;
+  AudioHandle::AudioCallback metered_cb = nullptr;
+  AudioHandle::InterleavingAudioCallback metered_interleaving_cb = nullptr;
+#endif
+#if HOTHOUSE_LOAD_METER
+  CpuLoadMeter load_meter;
+  std::atomic<bool> load_meter_reset{false};  // Main loop asks, callback resets
+  uint32_t load_last_report = 0;
+#endif
+  float peak_load = 0.0f;
+
+  // Callback watchdog. The callback fills in watchdog_stats; the main loop
+  // reports and saves it, holding the timing off while it writes QSPI.
+#if HOTHOUSE_WATCHDOG
+  void StartWatchdog();
+  inline void BeginWatchdogBlock() {
+    const uint32_t now = DWT->CYCCNT;
+    const bool hold = watchdog_hold.load(std::memory_order_acquire);
+    watchdog_block_mode = watchdog_mode.load(std::memory_order_relaxed);
+    if (!hold && watchdog_timed &&
+        (now - watchdog_entry) << CpuClockShift() > watchdog_late_cycles) {
+      watchdog_stats.modes[watchdog_block_mode].late_starts++;
+    }
+    watchdog_timed = !hold;
+    watchdog_entry = now;
+  }
+  inline void EndWatchdogBlock() {
+    const uint32_t cycles = (DWT->CYCCNT - watchdog_entry) << CpuClockShift();
+    if (watchdog_hold.load(std::memory_order_acquire)) {
+      watchdog_timed = false;
+      return;
+    }
+    WatchdogModeStats &stats = watchdog_stats.modes[watchdog_block_mode];
+    stats.blocks++;
+    if (cycles > stats.worst_cycles) {
+      stats.worst_cycles = cycles;
+    }
+    if (cycles > watchdog_stats.period_cycles) {
+      stats.overruns++;
+#if HOTHOUSE_TELEMETRY
+      const TelemetryOverrun overrun = {watchdog_block_mode, cycles,
+                                        watchdog_stats.period_cycles};
+      telemetry.PostFromAudio(TELEMETRY_OVERRUN, &overrun, sizeof(overrun));
+#endif
+    }
+  }
+  bool WatchdogStatsGrew() const;
+  void PrintWatchdogStats(int session, const WatchdogStats &stats);
+
+  WatchdogStats watchdog_stats = {};  // This session
+  WatchdogStats watchdog_saved = {};  // This session as last saved
+  daisy::PersistentStorage<WatchdogStats> watchdog_storage{seed.qspi};
+  std::atomic<uint32_t> watchdog_mode{0};
+  std::atomic<bool> watchdog_hold{false};
+  bool watchdog_mode_fixed = false;
+  bool watchdog_started = false;
+  bool watchdog_ever_saved = false;
+  bool watchdog_timed = false;  // watchdog_entry holds the last block's start
+  uint32_t watchdog_block_mode = 0;
+  uint32_t watchdog_entry = 0;
+  uint32_t watchdog_late_cycles = 0;
+  uint32_t watchdog_start_ms = 0;
+  uint32_t watchdog_last_report = 0;
+  uint32_t watchdog_last_save = 0;
+#endif
+  WatchdogStats watchdog_last = {};  // From QSPI, the session before this
+
+#if HOTHOUSE_BOOT_TIMING
+  struct BootPhase {
+    const char *phase;
+    uint32_t us;
+  };
+  BootPhase boot_marks[BOOT_MARKS] = {};
+  int boot_mark_count = 0;
+  bool boot_reported = false;
+  uint32_t boot_last_report = 0;
+#endif
+
+#if HOTHOUSE_ALLOC_CHECK
+  uint32_t alloc_last_report = 0;
+#endif
+
+#if HOTHOUSE_DENORMAL_CHECK
+  struct DenormalWatch {
+    const float *data;
+    size_t count;
+    const char *name;
+  };
+  DenormalWatch denormal_watches[DENORMAL_WATCHES] = {};
+  int denormal_watch_count = 0;
+  // Callbacks that left IDC, UFC and IOC set, since the last report
+  std::atomic<uint32_t> denormal_blocks[3] = {};
+  uint32_t denormal_last_report = 0;
+  static void BeginDenormalBlock();
+  void EndDenormalBlock();
+#endif
+
+#if HOTHOUSE_MEMORY_REPORT
+  bool memory_reported = false;
+  uint32_t memory_last_report = 0;
+#endif
+
+  // Signal probes. The callback writes the rings while probes_armed; the
+  // main loop reads them only once it has disarmed and waited out a block.
+#if HOTHOUSE_PROBE
+  struct SignalProbe {
+    const char *name;
+    float *ring;
+    size_t frames;
+    size_t write;   // Next frame written
+    size_t filled;  // Frames recorded since armed, up to frames
+    float rate_hz;
+  };
+  static void WriteProbe(SignalProbe &probe, const float *data, size_t size);
+  static void ProbeReceive(uint8_t *buf, uint32_t *len);
+  void StopProbes();
+
+  static Hothouse *probing;
+  SignalProbe probes[PROBES] = {};
+  int probe_count = 0;
+  std::atomic<bool> probes_armed{false};
+  std::atomic<uint8_t> probe_command{0};  // From USB: the latest command
+  int probe_dumping = -1;                 // Probe being dumped, -1 if none
+  size_t probe_dumped = 0;                // Its frames sent so far
+#if HOTHOUSE_TELEMETRY
+  bool OfferProbeRecord();
+  void PostProbeState(uint8_t state);
+#endif
+#endif
+
+  // Telemetry. Reports queue records from the main loop, the watchdog from
+  // the callback too; ServiceTelemetry() frames and sends them.
+#if HOTHOUSE_TELEMETRY
+  Telemetry<TELEMETRY_RECORDS> telemetry;
+  bool telemetry_started = false;
+#endif
+
+  // Latency test. The callback runs it all and publishes each period's
+  // result; the main loop prints them as they change.
+#if HOTHOUSE_LATENCY_TEST
+  int ScanLatency(const float *in, size_t stride, size_t size);
+  AudioHandle::InputBuffer BeginLatencyBlock(AudioHandle::InputBuffer in,
+                                             size_t size);
+  AudioHandle::InterleavingInputBuffer BeginLatencyBlock(
+      AudioHandle::InterleavingInputBuffer in, size_t size);
+  void EndLatencyBlock(float *out, size_t channels);
+
+  int latency_click_at = -1;     // This block's click, -1 for none
+  bool latency_through = false;  // Clicks into the pedal, else its output
+  bool latency_click_through = false;  // Which this block's is
+  uint32_t latency_clock = 0;    // Samples since the last click
+  uint32_t latency_period = 0;
+  float latency_peak = 0.0f;  // Loudest input since the click, and when
+  uint32_t latency_peak_at = 0;
+  float latency_in[2 * LATENCY_MAX_BLOCK] = {};
+  const float *latency_channels[2] = {latency_in,
+                                      latency_in + LATENCY_MAX_BLOCK};
+  // Round trips in samples, bare and through the pedal, -1 with no return
+  std::atomic<int32_t> latency_result[2] = {{-1}, {-1}};
+  std::atomic<uint32_t> latency_pairs{0};
+  std::atomic<bool> latency_found{false};
+  uint32_t latency_reported = 0;
+#endif
+
+  // Null test. The callback sums each period's comparisons and publishes
+  // them; the main loop prints each period as it ends.
+#if HOTHOUSE_NULL_TEST
+  void CompareNull(const float *reference, const float *candidate,
+                   size_t size);
+  void EndNullTestBlock(float *out, size_t stride, size_t size);
+
+  float null_difference[NULL_TEST_MAX_BLOCK] = {};
+  size_t null_filled = 0;  // Of null_difference, this block
+  uint32_t null_clock = 0;  // Samples of audio into the period
+  uint32_t null_period = 0;
+  float null_peak = 0.0f;
+  double null_signal = 0.0;  // Sums of squares: the reference, the difference
+  double null_error = 0.0;
+  uint32_t null_samples = 0;
+  // The last period's: its peak, mean squares and samples compared
+  std::atomic<float> null_result_peak{0.0f};
+  std::atomic<float> null_result_signal{0.0f};
+  std::atomic<float> null_result_error{0.0f};
+  std::atomic<uint32_t> null_result_samples{0};
+  std::atomic<uint32_t> null_periods{0};
+  uint32_t null_reported = 0;
+#endif
+
+  // Power save. The callback sets power_bypassed and restores the clock;
+  // the main loop reduces it, with interrupts off so the two can't cross.
+#if HOTHOUSE_POWER_SAVE
+  void SetCpuClockReduced(bool reduced);
+  std::atomic<bool> power_bypassed{false};
+  std::atomic<bool> power_reduced{false};
+  uint32_t power_bypass_since = 0;
+#endif
+  // DWT cycles count at the core clock: full-clock cycles are these << this
+  inline uint32_t CpuClockShift() const { return CpuClockReduced() ? 1 : 0; }
+
+#if HOTHOUSE_UPLOAD
+  // Uploads. The USB interrupt appends to upload_rx; the main loop empties
+  // it after each frame. The host sends a frame only once it has the reply
+  // to the last, so the interrupt never appends while the main loop reads.
+  struct UploadHeader {
+    uint32_t magic;  // UPLOAD_MAGIC
+    uint16_t type;   // UploadFrameType
+    uint16_t length; // Payload bytes after the header
+    uint32_t seq;    // Data frames: chunk index
+    uint32_t crc;    // CRC-32 of the payload
+  };
+  enum UploadFrameType { UPLOAD_BEGIN = 1, UPLOAD_DATA, UPLOAD_END, UPLOAD_ABORT };
+  static const uint32_t UPLOAD_MAGIC = 0x50554848;  // "HHUP"
+  static const uint32_t UPLOAD_SECTOR = 4096;        // QSPI erase unit
+  static void UploadReceive(uint8_t *buf, uint32_t *len);
+  UploadEvent HandleUploadFrame(const UploadHeader &header,
+                                uint8_t *payload, int *slot);
+  UploadEvent FailUpload(int *slot);
+  bool WriteUploadChunk(uint32_t offset, uint8_t *data, uint32_t length);
+
+  static Hothouse *uploading;
+  const UploadSlot *upload_slots = nullptr;
+  int upload_slot_count = 0;
+  uint8_t upload_rx[sizeof(UploadHeader) + UPLOAD_CHUNK];
+  std::atomic<uint32_t> upload_rx_len{0};
+  std::atomic<bool> upload_rx_overflow{false};
+  uint32_t upload_rx_seen = 0;     // upload_rx_len at upload_rx_seen_ms
+  uint32_t upload_rx_seen_ms = 0;
+  int upload_slot = -1;            // Being written, -1 if none
+  uint32_t upload_size = 0;
+  uint32_t upload_crc = 0;         // Promised by the host
+  uint32_t upload_readback_crc = 0;  // Of what QSPI holds so far
+  uint32_t upload_next_seq = 0;
+  uint32_t upload_erased = 0;      // Bytes of the slot erased so far
+  uint32_t upload_last_ms = 0;
+#endif
+
+  // LED service. The setter writes the idle slot of a channel and swaps;
+  // the interrupt picks a new pattern up by its sequence number.
+  struct LedChannel {
+    LedPattern published[2];
+    std::atomic<int> live{0};
+    std::atomic<uint32_t> sequence{0};
+    bool restart[2] = {false, false};  // Per slot
+    // Interrupt side
+    uint32_t seen = 0;
+    LedPattern shown;
+    LedPattern resume;  // Where a BLINK goes back to
+    uint32_t start_tick = 0;
+  };
+  static void LedTimerCallback(void *data);
+  void LedTick();
+  float LedLevel(LedChannel &channel);
+
+  TimerHandle led_timer;
+  daisy::Led service_leds[2];
+  LedChannel led_channels[2];
+  bool led_service_running = false;
+  uint32_t led_ticks = 0;
+  uint32_t led_pattern_interval = 1;  // Ticks between pattern updates
+  uint32_t led_pattern_countdown = 0;
+  float led_ticks_per_ms = 1.0f;
+};
+
+}  // namespace clevelandmusicco
+
+#endif  // HOTHOUSE_H
@@ -0,0 +1,166 @@
+# Shared Hothouse hardware library
+# Include after the libDaisy core Makefile, with HOTHOUSE_DIR pointing here
+# and $(HOTHOUSE_DIR)/hothouse.cpp already in CPP_SOURCES (the core Makefile
+# sets up its source search paths as it is read).
+
+C_INCLUDES += -I$(HOTHOUSE_DIR)
+
+# HOTHOUSE_EXPRESSION=1 builds Hothouse::InitExpression() and the expression control
+HOTHOUSE_EXPRESSION ?= 0
+CPPFLAGS += -DHOTHOUSE_EXPRESSION=$(HOTHOUSE_EXPRESSION)
+
+# The control scanning and LED paths are built at the same optimisation in
+# every pedal, whatever the pedal's own OPT
+HOTHOUSE_OPT ?= -O3
+$(BUILD_DIR)/hothouse.o: OPT = $(HOTHOUSE_OPT)
+
+# LOAD_METER=1 measures the audio callback's CPU load and prints average
+# and peak over USB serial (Hothouse::ServiceLoadMeter() in the main loop);
+# LOAD_METER=2 also shows the peak on LED 2 (Hothouse::LoadLed())
+LOAD_METER ?= 0
+CPPFLAGS += -DHOTHOUSE_LOAD_METER=$(LOAD_METER)
+
+# WATCHDOG=1 times every audio callback against the block period and counts
+# overruns, lost blocks and the worst case per toggle combination (or pedal
+# mode); Hothouse::ServiceWatchdog() in the main loop prints them over USB
+# serial along with the last session's, and keeps them in QSPI
+WATCHDOG ?= 0
+CPPFLAGS += -DHOTHOUSE_WATCHDOG=$(WATCHDOG)
+
+# QUALITY=0, 1 or 2 fixes the quality level (Eco, Normal, High) that the
+# pedal sets its DSP up from, in place of the one the player picks at
+# power-up, for benching each level (Hothouse::GetQuality(); the watchdog's
+# report names the level it ran at)
+QUALITY ?= -1
+CPPFLAGS += -DHOTHOUSE_QUALITY=$(QUALITY)
+
+# BOOT_TIMING=1 stamps the end of each boot phase (Hothouse::BootMark(); the
+# library marks Init, SelectAudioProfile and StartAudio) and
+# Hothouse::ServiceBootTiming() in the main loop prints them over USB serial
+BOOT_TIMING ?= 0
+CPPFLAGS += -DHOTHOUSE_BOOT_TIMING=$(BOOT_TIMING)
+
+# ALLOC_CHECK=1 counts heap allocations made inside the audio callback
+# (operator new, and malloc, calloc and realloc wrapped at link time) and
+# Hothouse::ServiceAllocCheck() in the main loop prints the count and the
+# first caller over USB serial; ALLOC_CHECK=2 traps on the first instead
+ALLOC_CHECK ?= 0
+CPPFLAGS += -DHOTHOUSE_ALLOC_CHECK=$(ALLOC_CHECK)
+ifneq ($(ALLOC_CHECK),0)
+CPPFLAGS += -DHOTHOUSE_ALLOC_WRAP=1
+LDFLAGS += -Wl,--wrap=malloc -Wl,--wrap=calloc -Wl,--wrap=realloc
+endif
+
+# Hothouse::Init() sets the FPU to flush subnormals to zero and return the
+# default NaN, in the main loop and in the audio callback. FLUSH_TO_ZERO=0
+# keeps IEEE behaviour. DENORMAL_CHECK=1 counts the callbacks that flushed
+# a subnormal or made a NaN, and Hothouse::ServiceDenormalCheck() in the
+# main loop prints them every second over USB serial along with the
+# subnormals and NaNs in the arrays passed to Hothouse::WatchDenormals()
+FLUSH_TO_ZERO ?= 1
+CPPFLAGS += -DHOTHOUSE_FLUSH_TO_ZERO=$(FLUSH_TO_ZERO)
+DENORMAL_CHECK ?= 0
+CPPFLAGS += -DHOTHOUSE_DENORMAL_CHECK=$(DENORMAL_CHECK)
+
+# MEMORY_REPORT=1 paints the top of the stack at boot and
+# Hothouse::ServiceMemoryReport() in the main loop prints the stack and heap
+# high-water marks and the static and arena use per region over USB serial
+MEMORY_REPORT ?= 0
+CPPFLAGS += -DHOTHOUSE_MEMORY_REPORT=$(MEMORY_REPORT)
+
+# POWER_SAVE=1 sleeps in WFI between main loop passes (Hothouse::IdleMs())
+# and, once the pedal has reported itself bypassed (Hothouse::SetBypassed())
+# for 5 s, halves the CPU clock from Hothouse::ServicePower() in the main
+# loop; leaving bypass restores it in the same callback
+POWER_SAVE ?= 0
+CPPFLAGS += -DHOTHOUSE_POWER_SAVE=$(POWER_SAVE)
+
+# LATENCY_TEST=1 measures the round trip through a loopback cable from
+# output 1 to input 1: clicks go out on the output and into the pedal by
+# turns, and Hothouse::ServiceLatencyTest() in the main loop prints both
+# returns over USB serial. The pedal hears nothing else while it runs
+LATENCY_TEST ?= 0
+CPPFLAGS += -DHOTHOUSE_LATENCY_TEST=$(LATENCY_TEST)
+
+# NULL_TEST=1 has the pedal run a stage's reference and optimized versions
+# on the same input (Hothouse::NullTest(); the pedal's README says which
+# stage): their difference, +60 dB, replaces the right output, and
+# Hothouse::ServiceNullTest() in the main loop prints each second's peak
+# difference and SNR over USB serial
+NULL_TEST ?= 0
+CPPFLAGS += -DHOTHOUSE_NULL_TEST=$(NULL_TEST)
+
+# UPLOAD=1 takes blobs from tools/hothouse_upload.py over USB serial into
+# the QSPI slots the pedal names (Hothouse::StartUpload()), erasing and
+# writing them from Hothouse::ServiceUpload() in the main loop
+UPLOAD ?= 0
+CPPFLAGS += -DHOTHOUSE_UPLOAD=$(UPLOAD)
+
+# PROBE=1 builds the signal probes: tap points a pedal names with
+# Hothouse::AddProbe() record their blocks into SDRAM rings while armed, and
+# Hothouse::ServiceProbes() in the main loop arms them and dumps them over
+# USB serial for tools/hothouse_probe.py. The rings are carved from the
+# SDRAM arena, which a pedal without one gets 16 MB of
+PROBE ?= 0
+CPPFLAGS += -DHOTHOUSE_PROBE=$(PROBE)
+ifneq ($(PROBE),0)
+SDRAM_ARENA_MB ?= 16
+endif
+
+# TELEMETRY=1 turns the reports above into framed binary records
+# (hothouse_telemetry.h): they queue instead of printing, the watchdog's
+# overruns are queued from the callback as they happen, and
+# Hothouse::ServiceTelemetry() in the main loop sends a bounded batch of
+# them over USB serial each pass, for tools/hothouse_telemetry.py
+TELEMETRY ?= 0
+CPPFLAGS += -DHOTHOUSE_TELEMETRY=$(TELEMETRY)
+
+# SDRAM_ARENA_MB=n reserves n MB of SDRAM as sdramArena (hothouse_arena.h),
+# which the pedal carves its large buffers from at init; 0 leaves it out.
+# A pedal that carves from it sets this in its own Makefile (64 is all of it)
+SDRAM_ARENA_MB ?= 0
+CPPFLAGS += -DHOTHOUSE_SDRAM_ARENA_MB=$(SDRAM_ARENA_MB)
+
+# TCM=1 links the code and state tagged in hothouse_tcm.h into ITCM and
+# DTCM (make clean first): the linker script becomes libDaisy's with the
+# hothouse_tcm.ld sections added, loading from wherever the image does
+TCM ?= 0
+CPPFLAGS += -DHOTHOUSE_TCM=$(TCM)
+ifeq ($(TCM),1)
+ifeq ($(APP_TYPE),BOOT_QSPI)
+TCM_LOAD_REGION ?= QSPIFLASH
+else ifeq ($(APP_TYPE),BOOT_SRAM)
+TCM_LOAD_REGION ?= SRAM
+else
+TCM_LOAD_REGION ?= FLASH
+endif
+TCM_BASE_LDSCRIPT := $(LDSCRIPT)
+LDSCRIPT = $(BUILD_DIR)/hothouse_tcm.lds
+$(BUILD_DIR)/$(TARGET).elf: $(LDSCRIPT)
+$(BUILD_DIR)/hothouse_tcm.lds: $(TCM_BASE_LDSCRIPT) $(HOTHOUSE_DIR)/hothouse_tcm.ld
+	@mkdir -p $(BUILD_DIR)
+	awk -v frag=$(HOTHOUSE_DIR)/hothouse_tcm.ld -v region=$(TCM_LOAD_REGION) \
+	  '!done && /^[ \t]*\.rodata[ \t]*:/ { while ((getline line < frag) > 0) { gsub(/LOAD_REGION/, region, line); print line } done = 1 } { print } END { exit !done }' \
+	  $< > $@ || { rm -f $@; echo "hothouse.mk: no .rodata section in $<" >&2; false; }
+endif
+
+# What each tightly coupled memory holds: section totals, then the symbols
+# in ITCM (below 0x10000) and DTCM (0x20000000 to 0x2001ffff), largest last
+NM ?= $(SZ:size=nm)
+.PHONY: tcm-report
+tcm-report: $(BUILD_DIR)/$(TARGET).elf
+	$(SZ) -A $< | grep -E "^\.(itcm_text|dtcm_data|dtcm_bss|dtcmram_bss) "
+	$(NM) -C -S --size-sort $< | awk '{ a = substr($$1, length($$1) - 7) } a < "00010000" || (a >= "20000000" && a < "20020000")'
+
+# What the link put in each memory region: its sections, largest last, and
+# their total. The heap and stack grow at run time: make MEMORY_REPORT=1.
+.PHONY: memory-report
+memory-report: $(BUILD_DIR)/$(TARGET).elf
+	$(SZ) -A $< | awk '\
+	  NF == 3 && $$3 ~ /^[0-9]+$$/ && $$2 > 0 && $$1 !~ /^\.(debug|comment|ARM|stab)/ { \
+	    a = $$3; r = a < 65536 ? "itcm" : a < 134217728 ? "" : a < 536870912 ? "flash" : \
+	        a < 603979776 ? "dtcm" : a < 805306368 ? "sram" : a < 939524096 ? "sram_d2" : \
+	        a < 1073741824 ? "sram_d3" : a < 2415919104 ? "" : a < 3221225472 ? "qspi" : "sdram"; \
+	    if (r != "") { total[r] += $$2; list[r] = list[r] sprintf("  %-22s %9d\n", $$1, $$2) } } \
+	  END { for (r in total) { printf "%s %d\n", r, total[r]; \
+	    printf "%s", list[r] | "sort -k2 -n"; close("sort -k2 -n") } }'
@@ -0,0 +1,110 @@
+// One SDRAM region for a pedal's large buffers
+//
+// A pedal carves its delay lines and slice buffers from sdramArena in
+// main(), before StartAudio(), rather than declaring each as a
+// DSY_SDRAM_BSS static of its own. Nothing is freed one at a time; Reset()
+// hands the whole region out again. That is what lets a firmware holding
+// several pedals give all of the SDRAM to whichever one boots, where
+// separate statics would have to fit side by side.
+//
+// `make SDRAM_ARENA_MB=n` (hothouse.mk) reserves n MB and defines
+// sdramArena in hothouse.cpp; a pedal that uses it sets the size in its
+// Makefile. kSdramArenaBytes is 0 without it, so a pedal's static_assert
+// that its buffers fit catches a missing setting at compile time.
+//
+// Carved memory is not cleared (libDaisy leaves the SDRAM as it found
+// it): build objects in it with placement new and clear buffers that need
+// it. Every block starts on a D-cache line, and is write-back cached like
+// the rest of the SDRAM unless it is carved with a CachePolicy
+// (hothouse_cache.h) for the MPU to give it.
+
+#pragma once
+#ifndef HOTHOUSE_ARENA_H
+#define HOTHOUSE_ARENA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hothouse_cache.h"
+#include "hothouse_containers.h"
+
+#ifndef HOTHOUSE_SDRAM_ARENA_MB
+#define HOTHOUSE_SDRAM_ARENA_MB 0
+#endif
+
+namespace clevelandmusicco {
+
+class Arena
+{
+public:
+  static constexpr size_t kAlign = 32;
+
+  Arena(void* base, size_t bytes) : base_(static_cast<uint8_t*>(base)), size_(bytes) {}
+
+  // Room for count Ts, or nullptr once the region is used up
+  template <typename T>
+  T* Carve(size_t count = 1)
+  {
+    const size_t start = (used_ + kAlign - 1) & ~(kAlign - 1);
+    const size_t bytes = count * sizeof(T);
+    if (start > size_ || bytes > size_ - start)
+    {
+      return nullptr;
+    }
+    used_ = start + bytes;
+    return reinterpret_cast<T*>(base_ + start);
+  }
+
+  // Carve() as a Span of count Ts, empty once the region is used up
+  template <typename T>
+  Span<T> CarveSpan(size_t count)
+  {
+    T* data = Carve<T>(count);
+    return data ? Span<T>(data, count) : Span<T>();
+  }
+
+  // Carve() for a buffer another bus master shares, given policy: it is
+  // rounded up to a power of two and aligned to it, as an MPU region must
+  // be. nullptr when it doesn't fit or no region is left for it. Reset()
+  // doesn't give the regions back.
+  template <typename T>
+  T* Carve(size_t count, CachePolicy policy)
+  {
+    if (policy == CachePolicy::WriteBack)
+    {
+      return Carve<T>(count);
+    }
+    size_t region = kCacheLine;
+    while (region < count * sizeof(T))
+    {
+      region <<= 1;
+    }
+    const uintptr_t at = (uintptr_t)(base_ + used_);
+    const size_t start = used_ + (((at + region - 1) & ~(uintptr_t)(region - 1)) - at);
+    if (start > size_ || region > size_ - start || !SetCachePolicy(base_ + start, region, policy))
+    {
+      return nullptr;
+    }
+    used_ = start + region;
+    return reinterpret_cast<T*>(base_ + start);
+  }
+
+  // Everything carved so far may be handed out again
+  void Reset() { used_ = 0; }
+
+  size_t Used() const { return used_; }
+  size_t Capacity() const { return size_; }
+
+private:
+  uint8_t* base_;
+  size_t size_;
+  size_t used_ = 0;
+};
+
+constexpr size_t kSdramArenaBytes = (size_t)HOTHOUSE_SDRAM_ARENA_MB << 20;
+
+extern Arena sdramArena;
+
+} // namespace clevelandmusicco
+
+#endif
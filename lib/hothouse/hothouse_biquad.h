@@ -0,0 +1,195 @@
+// Biquad cascades run a block at a time, and the coefficients to fill them
+//
+// BiquadCascade<Stages> runs up to four second-order sections over one
+// buffer in place, each section over the whole block before the next, in
+// transposed direct form II. A section's two state values and five
+// coefficients then stay in registers for the whole block, where a filter
+// object called per sample loads and stores them on every call, and a
+// shelf pair or an LP/HP band costs one call per block. On the Seed the
+// pass is CMSIS-DSP's arm_biquad_cascade_df2T_f32; on the host it is the
+// same recurrence in C++. Active() and ProcessBlock() make a cascade a
+// Chain stage (hothouse_chain.h) as it is.
+//
+// The biquad:: designers return the Audio EQ Cookbook sections that
+// q::biquad's filters use, worked out in double and normalised by a0. They
+// call sin, cos and pow: run them at boot or when a control moves, not per
+// block.
+
+#pragma once
+#ifndef HOTHOUSE_BIQUAD_H
+#define HOTHOUSE_BIQUAD_H
+
+#include <math.h>
+#include <stddef.h>
+
+#ifndef HOTHOUSE_BIQUAD_CMSIS
+#if defined(__arm__) && defined(__ARM_FP)
+#define HOTHOUSE_BIQUAD_CMSIS 1
+#else
+#define HOTHOUSE_BIQUAD_CMSIS 0
+#endif
+#endif
+
+#if HOTHOUSE_BIQUAD_CMSIS
+#include "arm_math.h"
+#endif
+
+namespace clevelandmusicco {
+
+// y = b0 x + b1 x[-1] + b2 x[-2] - a1 y[-1] - a2 y[-2]
+struct BiquadCoefficients
+{
+  float b0, b1, b2, a1, a2;
+};
+
+namespace biquad {
+
+namespace detail {
+
+inline BiquadCoefficients Normalise(double b0, double b1, double b2, double a0, double a1, double a2)
+{
+  return {(float)(b0 / a0), (float)(b1 / a0), (float)(b2 / a0), (float)(a1 / a0), (float)(a2 / a0)};
+}
+
+inline double Omega(float freq, float sample_rate) { return 2.0 * 3.14159265358979323846 * freq / sample_rate; }
+
+} // namespace detail
+
+// Passes everything unchanged
+inline BiquadCoefficients Identity() { return {1.0f, 0.0f, 0.0f, 0.0f, 0.0f}; }
+
+inline BiquadCoefficients Lowpass(float freq, float sample_rate, float q = 0.7071f)
+{
+  const double w = detail::Omega(freq, sample_rate);
+  const double cs = cos(w);
+  const double alpha = sin(w) / (2.0 * q);
+  return detail::Normalise((1.0 - cs) / 2.0, 1.0 - cs, (1.0 - cs) / 2.0, 1.0 + alpha, -2.0 * cs, 1.0 - alpha);
+}
+
+inline BiquadCoefficients Highpass(float freq, float sample_rate, float q = 0.7071f)
+{
+  const double w = detail::Omega(freq, sample_rate);
+  const double cs = cos(w);
+  const double alpha = sin(w) / (2.0 * q);
+  return detail::Normalise((1.0 + cs) / 2.0, -(1.0 + cs), (1.0 + cs) / 2.0, 1.0 + alpha, -2.0 * cs, 1.0 - alpha);
+}
+
+inline BiquadCoefficients Peak(float db_gain, float freq, float sample_rate, float q = 0.7071f)
+{
+  const double w = detail::Omega(freq, sample_rate);
+  const double cs = cos(w);
+  const double alpha = sin(w) / (2.0 * q);
+  const double a = pow(10.0, db_gain / 40.0);
+  return detail::Normalise(1.0 + alpha * a, -2.0 * cs, 1.0 - alpha * a, 1.0 + alpha / a, -2.0 * cs, 1.0 - alpha / a);
+}
+
+// Shelves have the cookbook's slope S = 1, the steepest with no overshoot,
+// where 2 sqrt(A) alpha reduces to sqrt(2A) sin(w), as in q's shelves
+inline BiquadCoefficients LowShelf(float db_gain, float freq, float sample_rate)
+{
+  const double w = detail::Omega(freq, sample_rate);
+  const double cs = cos(w);
+  const double a = pow(10.0, db_gain / 40.0);
+  const double k = sqrt(a + a) * sin(w);
+  return detail::Normalise(a * ((a + 1.0) - (a - 1.0) * cs + k), 2.0 * a * ((a - 1.0) - (a + 1.0) * cs),
+                           a * ((a + 1.0) - (a - 1.0) * cs - k), (a + 1.0) + (a - 1.0) * cs + k,
+                           -2.0 * ((a - 1.0) + (a + 1.0) * cs), (a + 1.0) + (a - 1.0) * cs - k);
+}
+
+inline BiquadCoefficients HighShelf(float db_gain, float freq, float sample_rate)
+{
+  const double w = detail::Omega(freq, sample_rate);
+  const double cs = cos(w);
+  const double a = pow(10.0, db_gain / 40.0);
+  const double k = sqrt(a + a) * sin(w);
+  return detail::Normalise(a * ((a + 1.0) + (a - 1.0) * cs + k), -2.0 * a * ((a - 1.0) + (a + 1.0) * cs),
+                           a * ((a + 1.0) + (a - 1.0) * cs - k), (a + 1.0) - (a - 1.0) * cs + k,
+                           2.0 * ((a - 1.0) - (a + 1.0) * cs), (a + 1.0) - (a - 1.0) * cs - k);
+}
+
+} // namespace biquad
+
+template <size_t Stages>
+class BiquadCascade
+{
+  static_assert(Stages > 0 && Stages <= 4, "a BiquadCascade has 1 to 4 sections");
+
+public:
+  static constexpr size_t kStages = Stages;
+
+  // Every section starts as Identity()
+  BiquadCascade()
+  {
+    for (size_t s = 0; s < Stages; s++)
+    {
+      SetStage(s, biquad::Identity());
+    }
+    Reset();
+#if HOTHOUSE_BIQUAD_CMSIS
+    arm_biquad_cascade_df2T_init_f32(&instance_, Stages, coefficients_, state_);
+#endif
+  }
+
+  BiquadCascade(const BiquadCascade&) = delete;
+  BiquadCascade& operator=(const BiquadCascade&) = delete;
+
+  // Takes effect from the next block; the state is kept, so a small change
+  // while running doesn't click
+  void SetStage(size_t stage, const BiquadCoefficients& c)
+  {
+    // CMSIS's layout, which adds the feedback terms: a1 and a2 negated
+    float* k = &coefficients_[5 * stage];
+    k[0] = c.b0;
+    k[1] = c.b1;
+    k[2] = c.b2;
+    k[3] = -c.a1;
+    k[4] = -c.a2;
+  }
+
+  // Clears the filter's memory
+  void Reset()
+  {
+    for (size_t i = 0; i < 2 * Stages; i++)
+    {
+      state_[i] = 0.0f;
+    }
+  }
+
+  bool Active() const { return true; }
+
+  void ProcessBlock(float* buf, size_t size)
+  {
+#if HOTHOUSE_BIQUAD_CMSIS
+    arm_biquad_cascade_df2T_f32(&instance_, buf, buf, size);
+#else
+    for (size_t s = 0; s < Stages; s++)
+    {
+      const float* k = &coefficients_[5 * s];
+      const float b0 = k[0], b1 = k[1], b2 = k[2], a1 = k[3], a2 = k[4];
+      float d1 = state_[2 * s];
+      float d2 = state_[2 * s + 1];
+      for (size_t i = 0; i < size; i++)
+      {
+        const float x = buf[i];
+        const float y = b0 * x + d1;
+        d1 = b1 * x + a1 * y + d2;
+        d2 = b2 * x + a2 * y;
+        buf[i] = y;
+      }
+      state_[2 * s] = d1;
+      state_[2 * s + 1] = d2;
+    }
+#endif
+  }
+
+private:
+  float coefficients_[5 * Stages];
+  float state_[2 * Stages];
+#if HOTHOUSE_BIQUAD_CMSIS
+  arm_biquad_cascade_df2T_instance_f32 instance_;
+#endif
+};
+
+} // namespace clevelandmusicco
+
+#endif
@@ -0,0 +1,164 @@
+// D-cache maintenance and per-buffer cache policy on the Seed
+//
+// The M7's D-cache is write-back over SDRAM and AXI SRAM (libDaisy's MPU
+// setup), which is what CPU-only buffers want: delay lines and slices
+// read and written in runs get whole-line bursts to the SDRAM. Anything
+// another bus master touches has to be kept coherent by hand. Before a
+// master reads a buffer the CPU wrote, clean it (CacheClean); before the
+// CPU reads what a master wrote, invalidate it (CacheInvalidate), having
+// cleaned and invalidated it before the master started (CacheCleanInvalidate)
+// so no dirty line lands on top later. The helpers round out to whole
+// 32-byte lines, so a buffer that shares a line with other data should be
+// aligned to kCacheLine at both ends. hothouse_mdma.h does all of this for
+// its own moves. On the host they do nothing.
+//
+// A buffer that a master and the CPU both touch often can instead be given
+// another policy with SetCachePolicy() (an MPU region of its own), from
+// main() before StartAudio():
+//   WriteBack     the default: fastest, maintain by hand
+//   WriteThrough  reads cached, writes go straight out: a master reading
+//                 what the CPU wrote needs no clean
+//   NonCacheable  no maintenance at all, every access goes to the bus
+// The MPU wants a power-of-two region aligned to its size, so such a
+// buffer is carved with Arena::Carve(count, policy) (hothouse_arena.h) or
+// declared with alignas(its size). Every DSY_SDRAM_BSS buffer in the tree
+// is CPU-only or moved through hothouse_mdma.h, and says which policy it
+// relies on where it is declared.
+
+#pragma once
+#ifndef HOTHOUSE_CACHE_H
+#define HOTHOUSE_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__arm__)
+#include "stm32h7xx.h"
+#endif
+
+namespace clevelandmusicco {
+
+constexpr size_t kCacheLine = 32;
+
+enum class CachePolicy
+{
+  WriteBack,
+  WriteThrough,
+  NonCacheable,
+};
+
+#if defined(__arm__)
+namespace cache_detail {
+
+// The whole lines an address range touches
+inline void LineSpan(const volatile void* p, size_t bytes, uint32_t*& start, int32_t& size)
+{
+  const uintptr_t first = (uintptr_t)p & ~(uintptr_t)(kCacheLine - 1);
+  const uintptr_t end = ((uintptr_t)p + bytes + kCacheLine - 1) & ~(uintptr_t)(kCacheLine - 1);
+  start = reinterpret_cast<uint32_t*>(first);
+  size = (int32_t)(end - first);
+}
+
+} // namespace cache_detail
+#endif
+
+// Writes the range's dirty lines out to memory
+inline void CacheClean(const volatile void* p, size_t bytes)
+{
+#if defined(__arm__)
+  uint32_t* start;
+  int32_t size;
+  cache_detail::LineSpan(p, bytes, start, size);
+  SCB_CleanDCache_by_Addr(start, size);
+#else
+  (void)p;
+  (void)bytes;
+#endif
+}
+
+// Drops the range's lines, so the next reads come from memory. Whatever
+// the CPU wrote to them and hadn't cleaned is lost.
+inline void CacheInvalidate(volatile void* p, size_t bytes)
+{
+#if defined(__arm__)
+  uint32_t* start;
+  int32_t size;
+  cache_detail::LineSpan(p, bytes, start, size);
+  SCB_InvalidateDCache_by_Addr(start, size);
+#else
+  (void)p;
+  (void)bytes;
+#endif
+}
+
+// Cleans the range, then drops it
+inline void CacheCleanInvalidate(volatile void* p, size_t bytes)
+{
+#if defined(__arm__)
+  uint32_t* start;
+  int32_t size;
+  cache_detail::LineSpan(p, bytes, start, size);
+  SCB_CleanInvalidateDCache_by_Addr(start, size);
+#else
+  (void)p;
+  (void)bytes;
+#endif
+}
+
+// MPU regions kFirstCacheRegion up belong to SetCachePolicy(); libDaisy's
+// own (SDRAM and the D2 DMA buffers) sit below them, and a higher region
+// wins where they overlap
+constexpr uint32_t kFirstCacheRegion = 8;
+constexpr uint32_t kCacheRegions = 8;
+
+// Gives bytes at base (a power of two from 32 bytes, base aligned to it)
+// policy, through an MPU region of its own. Returns false when the buffer
+// can't be a region or all kCacheRegions are taken; it keeps the policy it
+// had. Boot time only: the MPU is off while the region is written.
+inline bool SetCachePolicy(void* base, size_t bytes, CachePolicy policy)
+{
+  if (bytes < kCacheLine || (bytes & (bytes - 1)) != 0 || ((uintptr_t)base & (bytes - 1)) != 0)
+  {
+    return false;
+  }
+#if defined(__arm__)
+  static uint32_t regions_used = 0;
+  if (regions_used == kCacheRegions)
+  {
+    return false;
+  }
+  uint32_t size_field = 0;  // log2(bytes) - 1
+  while ((2u << size_field) < bytes)
+  {
+    ++size_field;
+  }
+
+  // TEX, C and B for normal memory: write-back read/write-allocate,
+  // write-through without write-allocate, or no caching
+  uint32_t tex = 1, cacheable = 1, bufferable = 1;
+  if (policy == CachePolicy::WriteThrough)
+  {
+    tex = 0;
+    bufferable = 0;
+  }
+  else if (policy == CachePolicy::NonCacheable)
+  {
+    cacheable = 0;
+    bufferable = 0;
+  }
+
+  CacheCleanInvalidate(base, bytes);
+  ARM_MPU_Disable();
+  ARM_MPU_SetRegion(ARM_MPU_RBAR(kFirstCacheRegion + regions_used, (uint32_t)(uintptr_t)base),
+                    ARM_MPU_RASR(1, ARM_MPU_AP_FULL, tex, 0, cacheable, bufferable, 0, size_field));
+  ARM_MPU_Enable(MPU_CTRL_PRIVDEFENA_Msk);
+  ++regions_used;
+#else
+  (void)policy;
+#endif
+  return true;
+}
+
+} // namespace clevelandmusicco
+
+#endif
@@ -0,0 +1,178 @@
+// Block stage composition: Chain for one pedal's in-place stages, and
+// EffectChain with a cycle budget for running engines in series
+//
+// Chain<A, B, ...> runs a pedal's stages over one buffer in place, each over
+// the whole block before the next. A stage has
+//
+//   bool Active() const             whether it runs this block
+//   void ProcessBlock(float* buf, size_t size)
+//
+// so a bypassed stage costs one test per block, not one per sample, and
+// every call is resolved at compile time for the compiler to inline.
+// FunctionStage<Process, IsActive> makes a stage of two plain functions.
+//
+// EffectChain<A, B, ...> runs each stage over the whole block before the
+// next, ping-ponging through one scratch buffer so the last stage lands in
+// the output. The stages are template parameters, so each Process() call is
+// resolved at compile time: no virtual dispatch, and nothing per sample but
+// the stages' own loops.
+//
+// An EffectChain stage is any class with
+//
+//   void     Process(const float* in, float* out, size_t size)
+//                                  in and out never alias
+//   uint32_t CyclesPerBlock() const
+//                                  measured cost of one block in its current
+//                                  mode (tools/bench, or the watchdog's worst)
+//   bool     Degrade()             switch to a cheaper mode; false when it
+//                                  has none left
+//
+// Fit() degrades stages, last first, until the chain's cycles fit the
+// budget, and returns false if they never do: the caller refuses that
+// combination. BlockBudget() turns the block period into cycles.
+
+#pragma once
+#ifndef HOTHOUSE_CHAIN_H
+#define HOTHOUSE_CHAIN_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <tuple>
+#include <utility>
+
+namespace clevelandmusicco {
+
+template <typename... Stages>
+class Chain
+{
+public:
+  explicit Chain(Stages&... stages) : stages_(stages...) {}
+
+  void ProcessBlock(float* buf, size_t size) { Run(buf, size, std::index_sequence_for<Stages...>()); }
+
+private:
+  template <size_t... I>
+  void Run(float* buf, size_t size, std::index_sequence<I...>)
+  {
+    // A braced list is evaluated in order, so the stages run in order
+    const int order[] = {0, (RunStage(std::get<I>(stages_), buf, size), 0)...};
+    (void)order;
+  }
+
+  template <typename Stage>
+  static void RunStage(Stage& stage, float* buf, size_t size)
+  {
+    if (stage.Active())
+    {
+      stage.ProcessBlock(buf, size);
+    }
+  }
+
+  std::tuple<Stages&...> stages_;
+};
+
+// A stage made of a block function and an optional test; both are template
+// arguments, so the calls are direct and can inline
+template <void (*Process)(float*, size_t), bool (*IsActive)() = nullptr>
+struct FunctionStage
+{
+  bool Active() const { return IsActive == nullptr || IsActive(); }
+  void ProcessBlock(float* buf, size_t size) { Process(buf, size); }
+};
+
+// Cycles in one block at the M7's clock, less the headroom (0 to 1) kept
+// for controls, LEDs and interrupts
+constexpr uint32_t BlockBudget(size_t block_size, float sample_rate, float headroom = 0.2f,
+                               float core_hz = 480e6f)
+{
+  return (uint32_t)(core_hz * (float)block_size / sample_rate * (1.0f - headroom));
+}
+
+template <size_t MaxBlock, typename... Stages>
+class EffectChain
+{
+  static_assert(sizeof...(Stages) > 0, "an EffectChain needs a stage");
+
+public:
+  static constexpr size_t kStages = sizeof...(Stages);
+
+  explicit EffectChain(Stages&... stages) : stages_(stages...) {}
+
+  // What one block costs with every stage in its current mode
+  uint32_t Cycles() const { return CyclesFrom<0>(); }
+
+  // Degrade until Cycles() <= budget; false if the stages run out first
+  bool Fit(uint32_t budget)
+  {
+    while (Cycles() > budget)
+    {
+      if (!DegradeFrom<kStages - 1>())
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // in and out must not alias; blocks over MaxBlock are run in pieces
+  void Process(const float* in, float* out, size_t size)
+  {
+    while (size > 0)
+    {
+      const size_t n = size < MaxBlock ? size : MaxBlock;
+      ProcessFrom<0>(in, out, n);
+      in += n;
+      out += n;
+      size -= n;
+    }
+  }
+
+private:
+  template <size_t I>
+  typename std::enable_if<(I < kStages), uint32_t>::type CyclesFrom() const
+  {
+    return std::get<I>(stages_).CyclesPerBlock() + CyclesFrom<I + 1>();
+  }
+
+  template <size_t I>
+  typename std::enable_if<(I == kStages), uint32_t>::type CyclesFrom() const
+  {
+    return 0;
+  }
+
+  // Stage I if it can still degrade, else the one before it
+  template <size_t I>
+  typename std::enable_if<(I > 0), bool>::type DegradeFrom()
+  {
+    return std::get<I>(stages_).Degrade() || DegradeFrom<I - 1>();
+  }
+
+  template <size_t I>
+  typename std::enable_if<(I == 0), bool>::type DegradeFrom()
+  {
+    return std::get<0>(stages_).Degrade();
+  }
+
+  // Stage I writes to out when an even number of stages follow it, so the
+  // last one always does, and to the scratch buffer otherwise
+  template <size_t I>
+  typename std::enable_if<(I < kStages)>::type ProcessFrom(const float* src, float* out, size_t n)
+  {
+    float* dst = ((kStages - 1 - I) % 2 == 0) ? out : scratch_;
+    std::get<I>(stages_).Process(src, dst, n);
+    ProcessFrom<I + 1>(dst, out, n);
+  }
+
+  template <size_t I>
+  typename std::enable_if<(I == kStages)>::type ProcessFrom(const float*, float*, size_t)
+  {
+  }
+
+  std::tuple<Stages&...> stages_;
+  float scratch_[MaxBlock];
+};
+
+} // namespace clevelandmusicco
+
+#endif
@@ -0,0 +1,76 @@
+// Commands from the main loop to the audio callback
+//
+// Control changes that reconfigure DSP state (pick a model, swap an IR,
+// change a mode) go through here instead of happening wherever the control
+// is read. The main loop posts typed commands into a SpscQueue, and the
+// callback drains them at the top of a block, before any DSP. Each command
+// carries a cost, in units the pedal picks. Each block runs commands in
+// order until the next one would take it past its budget, so the work a
+// block does for them is bounded. The rest wait for later blocks. A command
+// that costs more than the whole budget still runs, alone in its block, so
+// nothing waits forever.
+//
+//   enum { CMD_SELECT_IR, CMD_DELAY_PATTERN };
+//   main loop:  commands.Post(CMD_SELECT_IR, ir);
+//   callback:   commands.Drain(4, [](const Command& c) { ... });
+
+#pragma once
+#ifndef HOTHOUSE_COMMANDS_H
+#define HOTHOUSE_COMMANDS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hothouse_spsc.h"
+
+namespace clevelandmusicco {
+
+struct Command
+{
+  uint16_t type;  // The pedal's own enum
+  uint16_t cost;  // Against the callback's per-block budget
+  int32_t index;  // A model, an IR or a mode
+  float value;
+};
+
+template <size_t Size = 16>
+class CommandQueue
+{
+public:
+  // Main loop. False, dropping the command, if Size - 1 are waiting.
+  bool Post(uint16_t type, int32_t index = 0, float value = 0.0f, uint16_t cost = 1)
+  {
+    return queue_.Push({type, cost, index, value});
+  }
+
+  // Callback, at the top of a block: runs handler(command) on waiting
+  // commands in order while their costs fit in budget. Returns how many ran.
+  template <typename Handler>
+  size_t Drain(uint32_t budget, Handler&& handler)
+  {
+    size_t ran = 0;
+    uint32_t spent = 0;
+    while (held_ || queue_.Pop(next_))
+    {
+      held_ = true;
+      if (ran > 0 && spent + next_.cost > budget)
+      {
+        break;  // Kept for the next block
+      }
+      spent += next_.cost;
+      held_ = false;
+      handler(next_);
+      ran++;
+    }
+    return ran;
+  }
+
+private:
+  SpscQueue<Command, Size> queue_;
+  Command next_ = {};
+  bool held_ = false;  // next_ was popped but didn't fit
+};
+
+} // namespace clevelandmusicco
+
+#endif
@@ -0,0 +1,179 @@
+// Fixed-capacity containers for DSP state
+//
+// What a pedal would otherwise reach for std::vector for, without the
+// heap. StaticVector<T, N> holds up to N Ts in the object itself, so its
+// storage is wherever the object is (a static, a member, an arena carve)
+// and its size is known at link time; push_back() on a full one returns
+// false instead of growing. Span<T> is a pointer and a count over memory
+// someone else owns, most often a block carved from an Arena
+// (hothouse_arena.h, CarveSpan()) for a buffer whose size is only known
+// at boot, such as a convolution kernel.
+//
+// Neither allocates or throws, so both are safe in the audio callback.
+// A StaticVector built in uncleared memory must be constructed there with
+// placement new; a Span's memory is as its owner left it.
+//
+//   StaticVector<Kernel, 8> bank;
+//   Kernel* k = bank.emplace_back();        // nullptr when full
+//
+//   Span<float> fdl = arena.CarveSpan<float>(partitions * fftSize);
+//   if (fdl.empty()) { ... }                // the arena is used up
+
+#pragma once
+#ifndef HOTHOUSE_CONTAINERS_H
+#define HOTHOUSE_CONTAINERS_H
+
+#include <initializer_list>
+#include <new>
+#include <stddef.h>
+
+namespace clevelandmusicco {
+
+template <typename T>
+class Span
+{
+public:
+  Span() {}
+  Span(T* data, size_t size) : data_(data), size_(size) {}
+  template <size_t N>
+  Span(T (&array)[N]) : data_(array), size_(N) {}
+  // A Span<const T> from a Span<T>
+  template <typename U>
+  Span(const Span<U>& other) : data_(other.data()), size_(other.size()) {}
+
+  T* data() const { return data_; }
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  T* begin() const { return data_; }
+  T* end() const { return data_ + size_; }
+  T& operator[](size_t i) const { return data_[i]; }
+
+  // count elements from offset, cut to what there is
+  Span subspan(size_t offset, size_t count) const
+  {
+    if (offset > size_)
+    {
+      offset = size_;
+    }
+    return Span(data_ + offset, count < size_ - offset ? count : size_ - offset);
+  }
+
+private:
+  T* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+template <typename T, size_t N>
+class StaticVector
+{
+  static_assert(N > 0, "StaticVector needs room for something");
+
+public:
+  static constexpr size_t kCapacity = N;
+
+  StaticVector() {}
+  // The first N of items; the rest don't fit and are dropped
+  StaticVector(std::initializer_list<T> items)
+  {
+    for (const T& item : items)
+    {
+      push_back(item);
+    }
+  }
+  StaticVector(const StaticVector& other)
+  {
+    for (const T& item : other)
+    {
+      push_back(item);
+    }
+  }
+  StaticVector& operator=(const StaticVector& other)
+  {
+    if (this != &other)
+    {
+      clear();
+      for (const T& item : other)
+      {
+        push_back(item);
+      }
+    }
+    return *this;
+  }
+  ~StaticVector() { clear(); }
+
+  size_t size() const { return size_; }
+  static constexpr size_t capacity() { return N; }
+  bool empty() const { return size_ == 0; }
+  bool full() const { return size_ == N; }
+
+  T* data() { return reinterpret_cast<T*>(storage_); }
+  const T* data() const { return reinterpret_cast<const T*>(storage_); }
+  T* begin() { return data(); }
+  T* end() { return data() + size_; }
+  const T* begin() const { return data(); }
+  const T* end() const { return data() + size_; }
+  T& operator[](size_t i) { return data()[i]; }
+  const T& operator[](size_t i) const { return data()[i]; }
+  T& back() { return data()[size_ - 1]; }
+  const T& back() const { return data()[size_ - 1]; }
+
+  // False, doing nothing, when full
+  bool push_back(const T& item)
+  {
+    return emplace_back(item) != nullptr;
+  }
+
+  // The new element, or nullptr when full
+  template <typename... Args>
+  T* emplace_back(Args&&... args)
+  {
+    if (size_ == N)
+    {
+      return nullptr;
+    }
+    T* item = new (data() + size_) T(static_cast<Args&&>(args)...);
+    size_++;
+    return item;
+  }
+
+  void pop_back()
+  {
+    if (size_ > 0)
+    {
+      data()[--size_].~T();
+    }
+  }
+
+  // Grows with default-constructed Ts or shrinks to count. False, growing
+  // only to N, when count doesn't fit.
+  bool resize(size_t count)
+  {
+    while (size_ > count)
+    {
+      pop_back();
+    }
+    while (size_ < count && emplace_back())
+    {
+    }
+    return size_ == count;
+  }
+
+  void clear()
+  {
+    while (size_ > 0)
+    {
+      pop_back();
+    }
+  }
+
+  Span<T> span() { return Span<T>(data(), size_); }
+  Span<const T> span() const { return Span<const T>(data(), size_); }
+
+private:
+  alignas(T) unsigned char storage_[N * sizeof(T)];
+  size_t size_ = 0;
+};
+
+} // namespace clevelandmusicco
+
+#endif
@@ -0,0 +1,110 @@
+// Knob response curves, from tables built at compile time
+//
+// The curves the pedals put their knobs through, so each is evaluated the
+// same way everywhere and costs a table lookup instead of a log or a pow:
+//
+//   KnobLog(x)        log10(1 + 9x), 0 to 1: the curve CLAUDE.md
+//                     recommends for time-based controls
+//   KnobExp<Ratio>(x) Ratio^x, 1 to Ratio: an exponential range map, scaled
+//                     by its lowest value, e.g. 0.05f * KnobExp<200>(x)
+//                     for 0.05 to 10 Hz
+//
+// Each is a KnobCurve of kKnobCurvePoints worked out in double when the
+// pedal compiles (GCC folds log and pow in constant expressions) and read
+// with linear interpolation, as MixLaw() reads its table. KnobLog() is
+// within 7e-5 of the curve, KnobExp() within 6e-5 of it relative to the
+// value. The power curves (KnobSquare(), KnobCube()) are no tables: their
+// multiplies cost less than the lookup.
+//
+// A pedal with a curve of its own builds one the same way, from a type
+// with a static constexpr double At(double x):
+//
+//   struct Taper { static constexpr double At(double x) { return ...; } };
+//   constexpr KnobCurve<257> kTaper{Taper()};
+//   float y = kTaper(knob);
+
+#pragma once
+#ifndef HOTHOUSE_CURVES_H
+#define HOTHOUSE_CURVES_H
+
+#include <math.h>
+#include <stddef.h>
+
+namespace clevelandmusicco {
+
+constexpr size_t kKnobCurvePoints = 257;
+
+template <size_t Points = kKnobCurvePoints>
+struct KnobCurve
+{
+  static_assert(Points >= 2, "KnobCurve needs both ends");
+
+  template <typename Shape>
+  constexpr explicit KnobCurve(Shape) : y()
+  {
+    for (size_t i = 0; i < Points; i++)
+    {
+      y[i] = (float)Shape::At((double)i / (double)(Points - 1));
+    }
+  }
+
+  // The curve at x in [0, 1] (clamped)
+  float operator()(float x) const
+  {
+    const float pos = (x < 0.0f ? 0.0f : (x > 1.0f ? 1.0f : x)) * (float)(Points - 1);
+    size_t i = (size_t)pos;
+    if (i > Points - 2)
+    {
+      i = Points - 2;
+    }
+    const float f = pos - (float)i;
+    return y[i] + (y[i + 1] - y[i]) * f;
+  }
+
+  float y[Points];
+};
+
+namespace curves {
+
+struct Log
+{
+  static constexpr double At(double x) { return log10(1.0 + 9.0 * x); }
+};
+
+template <unsigned Ratio>
+struct Exp
+{
+  static constexpr double At(double x) { return pow((double)Ratio, x); }
+};
+
+constexpr KnobCurve<> kLog{Log()};
+
+} // namespace curves
+
+// log10(1 + 9x) for x in [0, 1]
+inline float KnobLog(float x)
+{
+  return curves::kLog(x);
+}
+
+// Ratio^x for x in [0, 1]: 1 at the bottom, Ratio at the top
+template <unsigned Ratio>
+inline float KnobExp(float x)
+{
+  static constexpr KnobCurve<> table{curves::Exp<Ratio>()};
+  return table(x);
+}
+
+inline float KnobSquare(float x)
+{
+  return x * x;
+}
+
+inline float KnobCube(float x)
+{
+  return x * x * x;
+}
+
+} // namespace clevelandmusicco
+
+#endif
@@ -0,0 +1,217 @@
+// Envelope follower and DC blocker kernels
+//
+// The two small recursions every pedal ends up writing for itself, in one
+// place and block-shaped. EnvelopeFollower is a peak follower: a one-pole
+// step towards |x|, with the attack coefficient when the level is rising and
+// the release one when it falls. Its coefficients are worked out when the
+// times change, not per sample, and it can run decimated: ProcessBlock()
+// reduces each run of decimation samples to its peak and steps once per
+// run, at the control rate the coefficients were computed for.
+//
+// DcBlocker is the first-order high-pass y = x - x[n-1] + pole * y[n-1],
+// its pole given outright or from a cutoff (DaisySP's DcBlock fixes it).
+// Process() is inline for a stage that has other per-sample work around
+// the blocker; ProcessBlock() runs a buffer in place with the state held
+// in registers.
+//
+//   follower.Init(8000.0f, 5.0f, 50.0f);
+//   follower.ProcessBlock(detector, count, envelope);  // count steps out
+//
+//   DcBlocker dc(0.995f);
+//   dc.ProcessBlock(buf, size);
+
+#pragma once
+#ifndef HOTHOUSE_ENVELOPE_H
+#define HOTHOUSE_ENVELOPE_H
+
+#include <math.h>
+#include <stddef.h>
+
+#include "hothouse_fastmath.h"
+
+namespace clevelandmusicco {
+
+class EnvelopeFollower
+{
+public:
+  // sampleRate is the rate of the samples passed in; with decimation above
+  // 1, ProcessBlock() steps once per that many, and the times are at
+  // sampleRate / decimation
+  void Init(float sampleRate, float attackMs, float releaseMs, size_t decimation = 1)
+  {
+    decimation_ = decimation > 0 ? decimation : 1;
+    step_rate_ = sampleRate / (float)decimation_;
+    attack_ms_ = -1.0f;
+    release_ms_ = -1.0f;
+    SetAttackRelease(attackMs, releaseMs);
+    Reset();
+  }
+
+  // Recomputes only the coefficient whose time changed, so it is cheap to
+  // call every block from a knob
+  void SetAttackRelease(float attackMs, float releaseMs)
+  {
+    if (attackMs != attack_ms_)
+    {
+      attack_ms_ = attackMs;
+      attack_coeff_ = Coefficient(attackMs);
+    }
+    if (releaseMs != release_ms_)
+    {
+      release_ms_ = releaseMs;
+      release_coeff_ = Coefficient(releaseMs);
+    }
+  }
+
+  // One step towards |input|, whatever the decimation
+  float Process(float input)
+  {
+    envelope_ = Step(envelope_, fabsf(input));
+    return envelope_;
+  }
+
+  // Follows size samples of in. Writes the envelope after each step to out,
+  // when given (it may be in itself), and returns the steps taken: size
+  // undecimated, or the runs completed, a partial run carrying over to the
+  // next block.
+  size_t ProcessBlock(const float* in, size_t size, float* out = nullptr)
+  {
+    float envelope = envelope_;
+    size_t steps = 0;
+    if (decimation_ == 1)
+    {
+      if (out)
+      {
+        for (size_t i = 0; i < size; i++)
+        {
+          envelope = Step(envelope, fabsf(in[i]));
+          out[i] = envelope;
+        }
+      }
+      else
+      {
+        for (size_t i = 0; i < size; i++)
+        {
+          envelope = Step(envelope, fabsf(in[i]));
+        }
+      }
+      steps = size;
+    }
+    else
+    {
+      float peak = peak_;
+      size_t count = count_;
+      for (size_t i = 0; i < size; i++)
+      {
+        const float level = fabsf(in[i]);
+        if (level > peak)
+        {
+          peak = level;
+        }
+        if (++count == decimation_)
+        {
+          envelope = Step(envelope, peak);
+          if (out)
+          {
+            out[steps] = envelope;
+          }
+          steps++;
+          peak = 0.0f;
+          count = 0;
+        }
+      }
+      peak_ = peak;
+      count_ = count;
+    }
+    envelope_ = envelope;
+    return steps;
+  }
+
+  float GetEnvelopeLevel() const { return envelope_; }
+
+  void Reset()
+  {
+    envelope_ = 0.0f;
+    peak_ = 0.0f;
+    count_ = 0;
+  }
+
+private:
+  float Coefficient(float ms) const
+  {
+    return 1.0f - fastmath::Exp(-1.0f / (ms * step_rate_ / 1000.0f));
+  }
+
+  float Step(float envelope, float level) const
+  {
+    if (level > envelope)
+    {
+      return envelope + attack_coeff_ * (level - envelope);
+    }
+    return envelope + release_coeff_ * (level - envelope);
+  }
+
+  size_t decimation_ = 1;
+  float step_rate_ = 48000.0f;
+  float attack_ms_ = -1.0f;
+  float release_ms_ = -1.0f;
+  float attack_coeff_ = 0.0f;
+  float release_coeff_ = 0.0f;
+  float envelope_ = 0.0f;
+  float peak_ = 0.0f;  // Of the run so far, decimated
+  size_t count_ = 0;
+};
+
+class DcBlocker
+{
+public:
+  explicit DcBlocker(float pole = 0.995f) : pole_(pole) {}
+
+  // The pole for a -3 dB corner at cutoffHz
+  void Init(float sampleRate, float cutoffHz)
+  {
+    SetPole(expf(-2.0f * (float)M_PI * cutoffHz / sampleRate));
+  }
+
+  void SetPole(float pole) { pole_ = pole; }
+
+  float Process(float x)
+  {
+    const float y = x - x1_ + pole_ * y1_;
+    x1_ = x;
+    y1_ = y;
+    return y;
+  }
+
+  // size samples of buf, in place
+  void ProcessBlock(float* buf, size_t size)
+  {
+    const float pole = pole_;
+    float x1 = x1_;
+    float y1 = y1_;
+    for (size_t i = 0; i < size; i++)
+    {
+      const float x = buf[i];
+      y1 = x - x1 + pole * y1;
+      x1 = x;
+      buf[i] = y1;
+    }
+    x1_ = x1;
+    y1_ = y1;
+  }
+
+  void Reset()
+  {
+    x1_ = 0.0f;
+    y1_ = 0.0f;
+  }
+
+private:
+  float pole_;
+  float x1_ = 0.0f;
+  float y1_ = 0.0f;
+};
+
+} // namespace clevelandmusicco
+
+#endif
@@ -0,0 +1,152 @@
+// Fast single-precision maths for the audio path
+//
+// libm on the Seed is written for correctness over the whole float range:
+// expf/logf/powf/tanhf/sinf each cost a call, range checks and errno
+// handling, and powf in particular runs to hundreds of cycles. These are
+// inline, branch-light replacements for audio use, with the error over
+// their stated domain measured against double-precision libm:
+//
+//   Exp2(x)     rel error < 2.5e-7   (x clamped to [-126, 126])
+//   Exp(x)      rel error < 2.5e-7 + 4.5e-8 |x|
+//   Log2(x)     abs error < 1.6e-7 + 6e-8 |log2(x)|  (x > 0; zero, negative
+//                                     and denormal x read as 2^-126)
+//   Log(x)      abs error < 1.2e-7 + 9e-8 |ln(x)|
+//   Pow(b, e)   rel error < 2.5e-7 + 1e-7 |e log2(b)|  (b > 0)
+//   Tanh(x)     abs error < 1.5e-7
+//   Sin/Cos(x)  abs error < 2e-7 + 1.3e-7 |x|  (the range reduction is in
+//                                     float, so keep phases wrapped)
+//   Sqrt(x)     exact (VSQRT, no errno branch); Rsqrt(x) within 1 ulp
+//   RsqrtEstimate(x)  rel error < 1.8e-3 (one Newton step, no VSQRT/VDIV)
+//
+// The bounds include float rounding; they're a few ulp, far below anything
+// audible, but the results aren't bit-identical to libm: swap them in where a
+// call runs per sample or per block, not in code whose output has to match
+// an original exactly.
+
+#pragma once
+#ifndef HOTHOUSE_FASTMATH_H
+#define HOTHOUSE_FASTMATH_H
+
+#include <stdint.h>
+#include <string.h>
+
+namespace fastmath {
+
+namespace detail {
+
+inline uint32_t Bits(float x)
+{
+  uint32_t bits;
+  memcpy(&bits, &x, sizeof(bits));
+  return bits;
+}
+
+inline float FromBits(uint32_t bits)
+{
+  float x;
+  memcpy(&x, &bits, sizeof(x));
+  return x;
+}
+
+// Nearest integer, halves away from zero; |x| < 2^31
+inline int Round(float x) { return (int)(x + (x < 0.0f ? -0.5f : 0.5f)); }
+
+// sin(2 pi t) for t in turns
+inline float SinTurns(float t)
+{
+  t -= (float)Round(t);  // [-0.5, 0.5]
+  if (t > 0.25f) {
+    t = 0.5f - t;
+  } else if (t < -0.25f) {
+    t = -0.5f - t;
+  }
+  // Taylor series on [-pi/2, pi/2] to x^11, truncation error < 6e-8
+  const float r = t * 6.28318531f;
+  const float r2 = r * r;
+  return r * (1.0f + r2 * (-1.66666667e-1f + r2 * (8.33333333e-3f
+         + r2 * (-1.98412698e-4f + r2 * (2.75573192e-6f + r2 * -2.50521084e-8f)))));
+}
+
+}  // namespace detail
+
+/** 2^x */
+inline float Exp2(float x)
+{
+  x = x < -126.0f ? -126.0f : (x > 126.0f ? 126.0f : x);
+  const int i = detail::Round(x);
+  const float f = x - (float)i;  // [-0.5, 0.5], exact
+  // Taylor series of 2^f to f^6, truncation error < 1.2e-7
+  const float p = 1.0f + f * (6.93147181e-1f + f * (2.40226507e-1f + f * (5.55041087e-2f
+                  + f * (9.61812911e-3f + f * (1.33335581e-3f + f * 1.54035304e-4f)))));
+  return p * detail::FromBits((uint32_t)(i + 127) << 23);
+}
+
+/** log2(x) for x > 0 */
+inline float Log2(float x)
+{
+  uint32_t bits = detail::Bits(x);
+  if ((int32_t)bits < 0x00800000) {
+    bits = 0x00800000;  // zero, negative or denormal: smallest normal
+  }
+  int e = (int)(bits >> 23) - 127;
+  float m = detail::FromBits((bits & 0x007FFFFF) | 0x3F800000);  // [1, 2)
+  if (m > 1.41421356f) {
+    m *= 0.5f;
+    e++;
+  }
+  // log2(m) = 2/ln(2) atanh(s), series to s^7 with |s| < 0.172
+  const float s = (m - 1.0f) / (m + 1.0f);
+  const float s2 = s * s;
+  return (float)e
+         + s * (2.88539008f + s2 * (9.61796694e-1f + s2 * (5.77078016e-1f + s2 * 4.12198583e-1f)));
+}
+
+/** e^x */
+inline float Exp(float x) { return Exp2(x * 1.44269504f); }
+
+/** ln(x) for x > 0 */
+inline float Log(float x) { return Log2(x) * 6.93147181e-1f; }
+
+/** base^exponent for base > 0 */
+inline float Pow(float base, float exponent) { return Exp2(exponent * Log2(base)); }
+
+/** tanh(x), exactly +-1 past |x| = 9 */
+inline float Tanh(float x)
+{
+  x = x < -9.0f ? -9.0f : (x > 9.0f ? 9.0f : x);
+  const float t = Exp2(x * 2.88539008f);  // e^(2x)
+  return (t - 1.0f) / (t + 1.0f);
+}
+
+/** sin(x), x in radians */
+inline float Sin(float x) { return detail::SinTurns(x * 1.59154943e-1f); }
+
+/** cos(x), x in radians */
+inline float Cos(float x) { return detail::SinTurns(x * 1.59154943e-1f + 0.25f); }
+
+/** sqrt(x) for x >= 0, one VSQRT (14 cycles) on the Seed */
+inline float Sqrt(float x)
+{
+#if defined(__arm__) && defined(__ARM_FP)
+  float root;
+  __asm__("vsqrt.f32 %0, %1" : "=t"(root) : "t"(x));
+  return root;
+#else
+  return __builtin_sqrtf(x);
+#endif
+}
+
+/** 1 / sqrt(x) for x > 0, VSQRT and VDIV */
+inline float Rsqrt(float x) { return 1.0f / Sqrt(x); }
+
+/** 1 / sqrt(x) for x > 0 from the exponent trick and one Newton step:
+    coarse, but a handful of single-cycle ops */
+inline float RsqrtEstimate(float x)
+{
+  float y = detail::FromBits(0x5F3759DF - (detail::Bits(x) >> 1));
+  return y * (1.5f - 0.5f * x * y * y);
+}
+
+}  // namespace fastmath
+
+#endif  // HOTHOUSE_FASTMATH_H
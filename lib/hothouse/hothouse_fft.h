@@ -0,0 +1,121 @@
+// FFT backends for the STFTs in hothouse_stft.h
+//
+// An STFT's FFT is ShyFFT (shy_fft.h, portable, any power-of-two size) or
+// one of these, which have its interface and bin layout: CmsisFFT, the
+// CMSIS-DSP rfft libDaisy ships (up to 4096 points, target only), and
+// SelectableFFT, both side by side for a boot-time benchmark to pick from.
+// A processor written against ShyFFT's bins works unchanged on either.
+
+#pragma once
+#ifndef HOTHOUSE_FFT_H
+#define HOTHOUSE_FFT_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "arm_math.h"
+#include "shy_fft.h"
+
+namespace clevelandmusicco {
+
+// arm_rfft_fast_f32 in ShyFFT's layout and scaling, so Fourier and its
+// processor see the same bins with either. Direct() leaves the real
+// parts of bins 0..N/2 in [0, N/2] and the imaginary parts of bins
+// 1..N/2-1, negated, in [N/2 + 1, N); Inverse() is ShyFFT's inverse,
+// which is N times the normalized one. Both may overwrite their input,
+// as ShyFFT's do.
+template <size_t N> class CmsisFFT
+{
+public:
+  void Init()
+  {
+    arm_rfft_fast_init_f32(&instance, N);
+  }
+
+  void Direct(float* input, float* output)
+  {
+    // CMSIS packs DC and Nyquist into [0] and [1], then
+    // interleaves the real and imaginary parts of bins 1..N/2-1
+    arm_rfft_fast_f32(&instance, input, scratch, 0);
+
+    output[0] = scratch[0];
+    output[N / 2] = scratch[1];
+    for (size_t k = 1; k < N / 2; k++)
+    {
+      output[k] = scratch[2 * k];
+      output[N / 2 + k] = -scratch[2 * k + 1];
+    }
+  }
+
+  void Inverse(float* input, float* output)
+  {
+    const float scale = (float)N;
+
+    scratch[0] = input[0] * scale;
+    scratch[1] = input[N / 2] * scale;
+    for (size_t k = 1; k < N / 2; k++)
+    {
+      scratch[2 * k] = input[k] * scale;
+      scratch[2 * k + 1] = -input[N / 2 + k] * scale;
+    }
+
+    arm_rfft_fast_f32(&instance, scratch, output, 1);
+  }
+
+private:
+  arm_rfft_fast_instance_f32 instance;
+  float scratch[N];
+};
+
+// ShyFFT and CmsisFFT side by side, forwarding to whichever Select()
+// picked; the caller benchmarks them once and keeps the faster.
+template <size_t N> class SelectableFFT
+{
+public:
+  enum Backend
+  {
+    SHY,
+    CMSIS,
+    BACKEND_LAST
+  };
+
+  void Init()
+  {
+    shy.Init();
+    cmsis.Init();
+  }
+
+  void Select(Backend backend)
+  {
+    selected = backend;
+  }
+
+  Backend Selected() const
+  {
+    return selected;
+  }
+
+  void Direct(float* input, float* output)
+  {
+    if (selected == CMSIS)
+      cmsis.Direct(input, output);
+    else
+      shy.Direct(input, output);
+  }
+
+  void Inverse(float* input, float* output)
+  {
+    if (selected == CMSIS)
+      cmsis.Inverse(input, output);
+    else
+      shy.Inverse(input, output);
+  }
+
+private:
+  ShyFFT<float, N, RotationPhasor> shy;
+  CmsisFFT<N> cmsis;
+  Backend selected = SHY;
+};
+} // namespace clevelandmusicco
+
+#endif
@@ -0,0 +1,38 @@
+// Half-precision storage for large DSP state
+//
+// clevelandmusicco::half is an IEEE binary16 storage type: half the memory
+// of a float, with an 11-bit significand (about 66 dB of resolution) and a
+// range of 6.1e-5 to 65504 in normal numbers. It is meant for buffers that
+// are mostly stored and loaded, not worked in: arithmetic on it promotes to
+// float, and each load and store is a single conversion, VCVTB/VCVTT on the
+// Seed's M7. Scale what goes in so it stays inside the range, and flush
+// what would fall out of the bottom (see kHalfMin and kHalfMax).
+//
+// On the Seed it is GCC's __fp16, which needs -mfp16-format=ieee; on the
+// host it is _Float16.
+
+#pragma once
+#ifndef HOTHOUSE_HALF_H
+#define HOTHOUSE_HALF_H
+
+namespace clevelandmusicco {
+
+#if defined(__arm__)
+#ifndef __ARM_FP16_FORMAT_IEEE
+#error "clevelandmusicco::half needs -mfp16-format=ieee"
+#endif
+typedef __fp16 half;
+#else
+typedef _Float16 half;
+#endif
+
+// The smallest normal half. Under it a value loses precision a bit at a
+// time, so a decay by a factor close to 1 can round back to where it was
+// and stall instead of reaching zero.
+constexpr float kHalfMin = 6.103515625e-5f;
+// The largest half; anything over it converts to infinity
+constexpr float kHalfMax = 65504.0f;
+
+} // namespace clevelandmusicco
+
+#endif
@@ -0,0 +1,177 @@
+// Mono looper over one buffer in SDRAM, streamed a block at a time
+//
+// Looper records, plays and overdubs one loop in a buffer the pedal carves
+// from the SDRAM arena (hothouse_arena.h). Process() works on whole blocks:
+// it splits a block into at most two contiguous spans where the loop wraps
+// and runs each span as one memcpy or one add loop, so it costs memory
+// bandwidth and nothing per sample but the arithmetic; there's no position
+// test or branch inside the loops.
+//
+// Press() steps it the way a one-switch looper does:
+//
+//   EMPTY        start recording
+//   RECORDING    close the loop and play it (a full buffer closes it too)
+//   PLAYING      overdub
+//   OVERDUBBING  stop overdubbing, keep playing
+//
+// and Clear() empties it. Closing the loop gives its last kFade samples to
+// a crossfade into its start, done once in the buffer, so the loop point
+// doesn't click and playback needs no fade of its own. A recording shorter
+// than two fades isn't a loop, and closing it empties the looper.
+
+#pragma once
+#ifndef HOTHOUSE_LOOPER_H
+#define HOTHOUSE_LOOPER_H
+
+#include <stddef.h>
+#include <string.h>
+
+namespace clevelandmusicco {
+
+class Looper
+{
+public:
+  enum State
+  {
+    EMPTY,
+    RECORDING,
+    PLAYING,
+    OVERDUBBING,
+  };
+
+  static constexpr size_t kFade = 480; // 10 ms at 48 kHz
+
+  // frames samples at buffer, carved by the pedal; needn't be cleared
+  void Init(float* buffer, size_t frames)
+  {
+    buffer_ = buffer;
+    capacity_ = frames;
+    Clear();
+  }
+
+  void Press()
+  {
+    switch (state_)
+    {
+    case EMPTY:
+      length_ = 0;
+      state_ = RECORDING;
+      break;
+    case RECORDING:
+      Close();
+      break;
+    case PLAYING:
+      state_ = OVERDUBBING;
+      break;
+    case OVERDUBBING:
+      state_ = PLAYING;
+      break;
+    }
+  }
+
+  void Clear()
+  {
+    state_ = EMPTY;
+    length_ = 0;
+    position_ = 0;
+  }
+
+  State GetState() const { return state_; }
+
+  // Loop length in samples, 0 until one is closed
+  size_t Length() const { return state_ == PLAYING || state_ == OVERDUBBING ? length_ : 0; }
+
+  // out = in plus the loop. Records in while RECORDING and adds it to the
+  // loop while OVERDUBBING. in and out may be the same buffer.
+  void Process(const float* in, float* out, size_t size)
+  {
+    if (state_ == EMPTY)
+    {
+      Copy(out, in, size);
+      return;
+    }
+
+    if (state_ == RECORDING)
+    {
+      const size_t n = size < capacity_ - length_ ? size : capacity_ - length_;
+      memcpy(buffer_ + length_, in, n * sizeof(float));
+      length_ += n;
+      Copy(out, in, size);
+      if (length_ == capacity_)
+      {
+        Close();
+      }
+      return;
+    }
+
+    while (size > 0)
+    {
+      const size_t n = size < length_ - position_ ? size : length_ - position_;
+      float* loop = buffer_ + position_;
+      if (state_ == OVERDUBBING)
+      {
+        for (size_t i = 0; i < n; i++)
+        {
+          const float x = in[i];
+          const float l = loop[i];
+          loop[i] = l + x;
+          out[i] = x + l;
+        }
+      }
+      else
+      {
+        for (size_t i = 0; i < n; i++)
+        {
+          out[i] = in[i] + loop[i];
+        }
+      }
+      in += n;
+      out += n;
+      size -= n;
+      position_ += n;
+      if (position_ == length_)
+      {
+        position_ = 0;
+      }
+    }
+  }
+
+private:
+  static void Copy(float* out, const float* in, size_t size)
+  {
+    if (out != in)
+    {
+      memcpy(out, in, size * sizeof(float));
+    }
+  }
+
+  // Folds the recording's last kFade samples into its start: at the loop
+  // point playback runs from just before length_ into what was just after it
+  void Close()
+  {
+    if (length_ < 2 * kFade)
+    {
+      Clear();
+      return;
+    }
+    length_ -= kFade;
+    const float* tail = buffer_ + length_;
+    for (size_t i = 0; i < kFade; i++)
+    {
+      const float t = ((float)i + 0.5f) / (float)kFade;
+      buffer_[i] = buffer_[i] * t + tail[i] * (1.0f - t);
+    }
+    position_ = 0;
+    state_ = PLAYING;
+  }
+
+  float* buffer_ = nullptr;
+  size_t capacity_ = 0;
+  size_t length_ = 0;
+  size_t position_ = 0;
+  State state_ = EMPTY;
+};
+
+} // namespace clevelandmusicco
+
+#endif
@@ -0,0 +1,287 @@
+// Background block copies and fills on the Seed's MDMA
+//
+// MdmaCopy() and MdmaFill() hand a memory move to one of the MDMA's
+// channels and return at once; the caller goes on with other work and asks
+// the MdmaTransfer it passed whether the data is in place (Done()) or waits
+// for it (Wait()) before touching the destination. Moves under
+// kMdmaMinBytes, and every move when all kMdmaChannels channels are busy,
+// run on the CPU inside the call instead, so a transfer is always complete
+// once Done() says so, whichever way it went: a caller never needs a
+// fallback of its own. On the host every move is a memcpy or a fill.
+//
+// Both calls may be made from the main loop and from the audio callback:
+// channels are claimed and released with an atomic mask. A transfer is
+// polled only by whoever started it, and must outlive the move (a fill's
+// word is read from it).
+//
+// The D-cache is kept coherent here (hothouse_cache.h): the source is
+// cleaned and the destination cleaned and invalidated before the start,
+// and the destination invalidated again once Done(). Those work in 32-byte
+// lines, so a destination that shares its first or last line with data the
+// CPU writes while the move is in flight should be line-aligned.
+//
+//   MdmaTransfer clearing;
+//   MdmaFill(clearing, buffer, 0, sizeof(buffer));
+//   ...
+//   clearing.Wait();   // before buffer is used again
+
+#pragma once
+#ifndef HOTHOUSE_MDMA_H
+#define HOTHOUSE_MDMA_H
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "hothouse_cache.h"
+
+#if defined(__arm__)
+#include "stm32h7xx.h"
+#endif
+
+namespace clevelandmusicco {
+
+// MDMA channels 0 to kMdmaChannels - 1 belong to this service (libDaisy
+// uses none of the 16)
+constexpr size_t kMdmaChannels = 8;
+// Below this the channel setup and cache maintenance cost more than the
+// CPU takes to do the move itself
+constexpr size_t kMdmaMinBytes = 512;
+
+class MdmaTransfer
+{
+public:
+  MdmaTransfer() {}
+  MdmaTransfer(const MdmaTransfer&) = delete;
+  MdmaTransfer& operator=(const MdmaTransfer&) = delete;
+
+  // True once the destination holds the data. Releases the channel.
+  bool Done();
+
+  // Spins until Done()
+  void Wait()
+  {
+    while (!Done())
+    {
+    }
+  }
+
+private:
+  friend bool MdmaCopy(MdmaTransfer&, void*, const void*, size_t);
+  friend bool MdmaFill(MdmaTransfer&, void*, uint32_t, size_t);
+
+  bool Begin(void* dst, const void* src, uint32_t word, size_t bytes);
+
+  int channel_ = -1;
+  void* dst_ = nullptr;
+  const void* src_ = nullptr;  // nullptr for a fill
+  size_t bytes_ = 0;
+  uint32_t word_ = 0;          // A fill's source
+};
+
+namespace mdma_detail {
+
+inline std::atomic<uint32_t>& Claims()
+{
+  static std::atomic<uint32_t> claims{0};  // Constant-initialised: no guard
+  return claims;
+}
+
+inline void CpuMove(void* dst, const void* src, uint32_t word, size_t bytes)
+{
+  if (src)
+  {
+    memcpy(dst, src, bytes);
+  }
+  else if (word == 0 || (((uintptr_t)dst | bytes) & 3) != 0)
+  {
+    memset(dst, (int)(word & 0xff), bytes);
+  }
+  else
+  {
+    uint32_t* out = static_cast<uint32_t*>(dst);
+    for (size_t i = 0; i < bytes / 4; ++i)
+    {
+      out[i] = word;
+    }
+  }
+}
+
+inline int Claim()
+{
+  std::atomic<uint32_t>& claims = Claims();
+  uint32_t taken = claims.load(std::memory_order_relaxed);
+  for (;;)
+  {
+    int channel = -1;
+    for (size_t c = 0; c < kMdmaChannels; ++c)
+    {
+      if ((taken & (1u << c)) == 0)
+      {
+        channel = (int)c;
+        break;
+      }
+    }
+    if (channel < 0)
+    {
+      return -1;
+    }
+    if (claims.compare_exchange_weak(taken, taken | (1u << channel), std::memory_order_acquire,
+                                     std::memory_order_relaxed))
+    {
+      return channel;
+    }
+  }
+}
+
+inline void Release(int channel)
+{
+  Claims().fetch_and(~(1u << channel), std::memory_order_release);
+}
+
+#if defined(__arm__)
+inline MDMA_Channel_TypeDef* Channel(int channel)
+{
+  return reinterpret_cast<MDMA_Channel_TypeDef*>(MDMA_Channel0_BASE + 0x40 * channel);
+}
+
+// ITCM and DTCM are reached over the MDMA's AHB port, the rest over AXI
+inline bool OnTcmBus(const void* p)
+{
+  const uintptr_t a = (uintptr_t)p;
+  return a < 0x00010000 || (a >= 0x20000000 && a < 0x20020000);
+}
+
+// Starts bytes from src (a fill's one word when fill) to dst on channel,
+// as repeated blocks of up to 64 KB. What the blocks don't cover, under one
+// unit a block, is done on the CPU first, so the cache maintenance after
+// it covers the whole destination.
+inline void Start(int channel, void* dst, const void* src, bool fill, size_t bytes)
+{
+  if ((RCC->AHB3ENR & RCC_AHB3ENR_MDMAEN) == 0)
+  {
+    RCC->AHB3ENR |= RCC_AHB3ENR_MDMAEN;
+    (void)RCC->AHB3ENR;  // The clock is on before the first register write
+  }
+
+  // Words when everything lines up, bytes otherwise
+  const bool words = (((uintptr_t)dst | (fill ? 0 : (uintptr_t)src) | bytes) & 3) == 0;
+  const size_t unit = words ? 4 : 1;
+  const size_t units = bytes / unit;
+
+  // The fewest blocks of at most 64 KB (BNDT), up to 4096 of them (BRC)
+  const size_t max_units = 65536 / unit;
+  size_t blocks = (units + max_units - 1) / max_units;
+  if (blocks > 4096)
+  {
+    blocks = 4096;
+  }
+  size_t block_units = units / blocks;
+  if (block_units > max_units)
+  {
+    block_units = max_units;
+  }
+  const size_t moved = blocks * block_units * unit;
+  if (moved < bytes)
+  {
+    CpuMove(static_cast<uint8_t*>(dst) + moved,
+            fill ? nullptr : static_cast<const uint8_t*>(src) + moved,
+            fill ? *static_cast<const uint32_t*>(src) : 0, bytes - moved);
+  }
+
+  CacheClean(src, fill ? 4 : moved);
+  CacheCleanInvalidate(dst, bytes);
+
+  MDMA_Channel_TypeDef* ch = Channel(channel);
+  ch->CCR = 0;
+  ch->CIFCR = MDMA_CIFCR_CTEIF | MDMA_CIFCR_CCTCIF | MDMA_CIFCR_CBRTIF | MDMA_CIFCR_CBTIF
+              | MDMA_CIFCR_CLTCIF;
+  const uint32_t size = words ? 2 : 0;  // SSIZE/DSIZE: 10 word, 00 byte
+  ch->CTCR = MDMA_CTCR_SWRM | MDMA_CTCR_TRGM_1                     // Repeated blocks on request
+             | (127u << MDMA_CTCR_TLEN_Pos)                        // 128-byte buffer transfers
+             | (size << MDMA_CTCR_SSIZE_Pos) | (size << MDMA_CTCR_DSIZE_Pos)
+             | (size << MDMA_CTCR_SINCOS_Pos) | (size << MDMA_CTCR_DINCOS_Pos)
+             | (fill ? 0 : MDMA_CTCR_SINC_1) | MDMA_CTCR_DINC_1;  // Fills read one word
+  ch->CBNDTR = ((uint32_t)(blocks - 1) << MDMA_CBNDTR_BRC_Pos)
+               | (uint32_t)(block_units * unit);
+  ch->CSAR = (uint32_t)(uintptr_t)src;
+  ch->CDAR = (uint32_t)(uintptr_t)dst;
+  ch->CBRUR = 0;
+  ch->CLAR = 0;
+  ch->CTBR = (OnTcmBus(src) ? MDMA_CTBR_SBUS : 0) | (OnTcmBus(dst) ? MDMA_CTBR_DBUS : 0);
+  ch->CCR = MDMA_CCR_PL_0 | MDMA_CCR_EN;
+  ch->CCR |= MDMA_CCR_SWRQ;
+}
+#endif
+
+} // namespace mdma_detail
+
+// Copies bytes from src to dst, which mustn't overlap. Returns true if the
+// MDMA has it, false if it is already done.
+inline bool MdmaCopy(MdmaTransfer& transfer, void* dst, const void* src, size_t bytes)
+{
+  return transfer.Begin(dst, src, 0, bytes);
+}
+
+// Fills bytes at dst with word (its low byte when dst or bytes isn't
+// word-aligned). Returns as MdmaCopy().
+inline bool MdmaFill(MdmaTransfer& transfer, void* dst, uint32_t word, size_t bytes)
+{
+  return transfer.Begin(dst, nullptr, word, bytes);
+}
+
+inline bool MdmaTransfer::Begin(void* dst, const void* src, uint32_t word, size_t bytes)
+{
+  Wait();  // A transfer reused before it was polled to the end
+  dst_ = dst;
+  src_ = src;
+  bytes_ = bytes;
+  word_ = word;
+#if defined(__arm__)
+  if (bytes >= kMdmaMinBytes)
+  {
+    channel_ = mdma_detail::Claim();
+  }
+  if (channel_ >= 0)
+  {
+    const bool fill = src == nullptr;
+    mdma_detail::Start(channel_, dst, fill ? &word_ : src, fill, bytes);
+    return true;
+  }
+#endif
+  mdma_detail::CpuMove(dst, src, word, bytes);
+  return false;
+}
+
+inline bool MdmaTransfer::Done()
+{
+  if (channel_ < 0)
+  {
+    return true;
+  }
+#if defined(__arm__)
+  MDMA_Channel_TypeDef* ch = mdma_detail::Channel(channel_);
+  const uint32_t status = ch->CISR;
+  if ((status & (MDMA_CISR_CTCIF | MDMA_CISR_TEIF)) == 0)
+  {
+    return false;
+  }
+  ch->CCR = 0;
+  ch->CIFCR = MDMA_CIFCR_CTEIF | MDMA_CIFCR_CCTCIF | MDMA_CIFCR_CBRTIF | MDMA_CIFCR_CBTIF
+              | MDMA_CIFCR_CLTCIF;
+  CacheInvalidate(dst_, bytes_);
+  if (status & MDMA_CISR_TEIF)
+  {
+    // A bus error (an address the MDMA can't reach): the CPU does it all
+    mdma_detail::CpuMove(dst_, src_, word_, bytes_);
+  }
+#endif
+  mdma_detail::Release(channel_);
+  channel_ = -1;
+  return true;
+}
+
+} // namespace clevelandmusicco
+
+#endif
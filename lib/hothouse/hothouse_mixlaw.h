@@ -0,0 +1,142 @@
+// The dry/wet mix law the pedals share, from a table, and its block ramp
+//
+// Mars and Earth mix with the same near-equal-power curve:
+//
+//   A = x (1 - x),  B = A (1 + 1.4186 A)
+//   wet = (B + x)^2,  dry = (B + 1 - x)^2
+//
+// which is 1 and 0 at the ends and about 0.71 each at the middle. MixLaw()
+// looks both gains up in a table of kMixLawPoints, worked out at compile
+// time in double, with linear interpolation between entries: one multiply
+// and two loads a gain, within 2e-5 of the curve itself.
+//
+// A new mix jumping straight to new gains zippers when it moves in steps,
+// as a knob read once a block does. MixRamp takes one mix a block and
+// ramps both gains linearly from where they were across the block.
+//
+//   ramp.SetMix(knob, size);
+//   for each sample: ramp.Next(); out = dry_in * ramp.Dry() + wet_in * ramp.Wet();
+
+#pragma once
+#ifndef HOTHOUSE_MIXLAW_H
+#define HOTHOUSE_MIXLAW_H
+
+#include <stddef.h>
+
+namespace clevelandmusicco {
+
+struct MixGains
+{
+  float wet, dry;
+};
+
+constexpr size_t kMixLawPoints = 257;
+
+namespace detail {
+
+constexpr double MixLawWet(double x)
+{
+  const double a = x * (1.0 - x);
+  const double c = a * (1.0 + 1.4186 * a) + x;
+  return c * c;
+}
+
+struct MixLawTable
+{
+  constexpr MixLawTable() : wet(), dry()
+  {
+    for (size_t i = 0; i < kMixLawPoints; i++)
+    {
+      const double x = (double)i / (double)(kMixLawPoints - 1);
+      wet[i] = (float)MixLawWet(x);
+      dry[i] = (float)MixLawWet(1.0 - x); // the curve mirrored
+    }
+  }
+  float wet[kMixLawPoints];
+  float dry[kMixLawPoints];
+};
+
+constexpr MixLawTable kMixLaw{};
+
+} // namespace detail
+
+// Wet and dry gains for mix in [0, 1] (clamped)
+inline MixGains MixLaw(float mix)
+{
+  const float pos = (mix < 0.0f ? 0.0f : (mix > 1.0f ? 1.0f : mix)) * (float)(kMixLawPoints - 1);
+  size_t i = (size_t)pos;
+  if (i > kMixLawPoints - 2)
+  {
+    i = kMixLawPoints - 2;
+  }
+  const float f = pos - (float)i;
+  const float* wet = detail::kMixLaw.wet + i;
+  const float* dry = detail::kMixLaw.dry + i;
+  return {wet[0] + (wet[1] - wet[0]) * f, dry[0] + (dry[1] - dry[0]) * f};
+}
+
+class MixRamp
+{
+public:
+  // Starts at mix with no ramp
+  void Init(float mix)
+  {
+    gains_ = MixLaw(mix);
+    step_ = {0.0f, 0.0f};
+    remaining_ = 0;
+    mix_ = mix;
+  }
+
+  // This block's mix, ramped to over size samples. The table is only read
+  // when the mix has changed.
+  void SetMix(float mix, size_t size)
+  {
+    if (mix == mix_ || size == 0)
+    {
+      return;
+    }
+    mix_ = mix;
+    const MixGains target = MixLaw(mix);
+    target_ = target;
+    step_ = {(target.wet - gains_.wet) / (float)size, (target.dry - gains_.dry) / (float)size};
+    remaining_ = size;
+  }
+
+  // Steps both gains by one sample
+  void Next()
+  {
+    if (remaining_ > 0)
+    {
+      gains_.wet += step_.wet;
+      gains_.dry += step_.dry;
+      if (--remaining_ == 0)
+      {
+        gains_ = target_; // land exactly on the table
+      }
+    }
+  }
+
+  // Jumps to where the ramp is headed, for a block nobody hears
+  void Finish()
+  {
+    if (remaining_ > 0)
+    {
+      gains_ = target_;
+      remaining_ = 0;
+    }
+  }
+
+  float Wet() const { return gains_.wet; }
+  float Dry() const { return gains_.dry; }
+
+private:
+  MixGains gains_ = {0.0f, 1.0f};
+  MixGains target_ = {0.0f, 1.0f};
+  MixGains step_ = {0.0f, 0.0f};
+  size_t remaining_ = 0;
+  float mix_ = 0.0f;
+};
+
+} // namespace clevelandmusicco
+
+#endif
@@ -0,0 +1,284 @@
+// Control-rate modulation matrix
+//
+// One place for what the pedals otherwise hand-roll: a few slow LFOs and
+// outside signals (an envelope level, an expression pedal, a tempo phase)
+// moving registered parameters by set amounts. Sources are numbered: the
+// matrix's own LFOs first (Lfo(i)), then Inputs the pedal writes once a
+// block with SetSource() (Input(i)), then kOne, a constant 1 that lets a
+// route add a fixed offset. A destination is a parameter's base value, set
+// from its knob, and the routes into it; Update() works every destination
+// out from its base once per block.
+//
+// Routes apply in the order they were connected. kAdd adds source times
+// amount, kScale multiplies by source then by amount, each after the
+// source's shape (as is, 0 to 1 from -1 to 1, or rectified). Venus's damp
+// drift, damp * |lfo| * 0.7 + 0.3, is a kScale and a kAdd from kOne:
+//
+//   ModMatrix<4, 1, 4> mod;
+//   mod.Init(sampleRate);
+//   mod.lfo(0).SetFreq(0.009f);
+//   mod.Connect(mod.Lfo(0), kDamp, 0.7f, ModShape::kRectified, ModOp::kScale);
+//   mod.Connect(mod.kOne, kDamp, 0.3f);
+//
+//   mod.Advance(size);                    // once a block, steps the LFOs
+//   mod.SetBase(kDamp, knob);
+//   mod.Update();
+//   float damp = mod.Value(kDamp);
+//
+// Advance() and Update() are apart so a pedal can step its LFOs where it
+// always did (after the audio, for the next block's controls) and work the
+// values out when its knobs are read. Each destination keeps the value it
+// had before the last Update() too: Ramp() fills a block with the sample
+// by sample step from one to the other, for a destination read at audio
+// rate, and Step() is that increment for a loop that keeps its own.
+//
+// Nothing allocates: the routes are a StaticVector, and Connect() on a
+// full one returns -1.
+
+#pragma once
+#ifndef HOTHOUSE_MODMATRIX_H
+#define HOTHOUSE_MODMATRIX_H
+
+#include <float.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hothouse_containers.h"
+
+namespace clevelandmusicco {
+
+// A phase accumulator read once a block: Process(size) steps over the block
+// and returns the value at its last sample, which is what size calls to
+// daisysp::Oscillator::Process() leave behind, with Oscillator's sine and
+// triangle. SetPeriod() sets it by the length of a cycle in samples, for a
+// TempoClock's Period() times a beat count, and Sync() starts a cycle.
+class ModLfo
+{
+public:
+  enum Waveform
+  {
+    WAVE_SIN,
+    WAVE_TRI,
+  };
+
+  void Init(float sampleRate)
+  {
+    sr_recip_ = 1.0f / sampleRate;
+    phase_ = 0.0f;
+    SetFreq(100.0f);
+    SetAmp(0.5f);
+    SetWaveform(WAVE_SIN);
+  }
+
+  void SetFreq(float freq) { phase_inc_ = freq * sr_recip_; }
+  void SetPeriod(float samples) { phase_inc_ = samples > 0.0f ? 1.0f / samples : 0.0f; }
+  void SetAmp(float amp) { amp_ = amp; }
+  void SetWaveform(uint8_t waveform) { waveform_ = waveform == WAVE_TRI ? WAVE_TRI : WAVE_SIN; }
+  void Sync() { phase_ = 0.0f; }
+
+  // Steps size samples and returns the value at the last of them
+  float Process(size_t size)
+  {
+    float at = phase_ + (size - 1) * phase_inc_;
+    at -= floorf(at);
+    phase_ += size * phase_inc_;
+    phase_ -= floorf(phase_);
+
+    float out;
+    if (waveform_ == WAVE_TRI)
+    {
+      const float t = -1.0f + 2.0f * at;
+      out = 2.0f * (fabsf(t) - 0.5f);
+    }
+    else
+    {
+      out = sinf(at * 2.0f * (float)M_PI);
+    }
+    return out * amp_;
+  }
+
+private:
+  float sr_recip_ = 1.0f / 48000.0f;
+  float phase_ = 0.0f;
+  float phase_inc_ = 0.0f;
+  float amp_ = 0.5f;
+  uint8_t waveform_ = WAVE_SIN;
+};
+
+enum class ModShape : uint8_t
+{
+  kBipolar,   // as it is
+  kUnipolar,  // 0.5 + 0.5 * source
+  kRectified, // |source|
+};
+
+enum class ModOp : uint8_t
+{
+  kAdd,   // value + shaped * amount
+  kScale, // value * shaped * amount
+};
+
+template <size_t Lfos, size_t Inputs, size_t Destinations, size_t Routes = 2 * Destinations>
+class ModMatrix
+{
+public:
+  static constexpr int kOne = (int)(Lfos + Inputs);
+  static constexpr int kSources = kOne + 1;
+
+  static constexpr int Lfo(size_t i) { return (int)i; }
+  static constexpr int Input(size_t i) { return (int)(Lfos + i); }
+
+  // The LFOs with SetAmp(1) and every source, base and value at rest: 0,
+  // and kOne at 1
+  void Init(float sampleRate)
+  {
+    for (size_t i = 0; i < Lfos; i++)
+    {
+      lfos_[i].Init(sampleRate);
+      lfos_[i].SetAmp(1.0f);
+    }
+    for (int i = 0; i < kOne; i++)
+    {
+      sources_[i] = 0.0f;
+    }
+    sources_[kOne] = 1.0f;
+    for (size_t d = 0; d < Destinations; d++)
+    {
+      base_[d] = 0.0f;
+      value_[d] = 0.0f;
+      previous_[d] = 0.0f;
+      min_[d] = -FLT_MAX;
+      max_[d] = FLT_MAX;
+    }
+    routes_.clear();
+  }
+
+  ModLfo& lfo(size_t i) { return lfos_[i]; }
+
+  // An input's value until the next SetSource(); on an LFO, until the next
+  // Advance()
+  void SetSource(int source, float value)
+  {
+    if (source >= 0 && source < kOne)
+    {
+      sources_[source] = value;
+    }
+  }
+  float Source(int source) const { return sources_[source]; }
+
+  // Update() clamps the destination to min..max
+  void SetRange(size_t dest, float min, float max)
+  {
+    min_[dest] = min;
+    max_[dest] = max;
+  }
+  void SetBase(size_t dest, float base) { base_[dest] = base; }
+
+  // The route's index, or -1 when there is no room or a number is out of
+  // range. A route starts enabled.
+  int Connect(int source, size_t dest, float amount, ModShape shape = ModShape::kBipolar,
+              ModOp op = ModOp::kAdd)
+  {
+    if (source < 0 || source >= kSources || dest >= Destinations)
+    {
+      return -1;
+    }
+    if (!routes_.push_back(Route{amount, (uint8_t)source, (uint8_t)dest, shape, op, true}))
+    {
+      return -1;
+    }
+    return (int)routes_.size() - 1;
+  }
+  void SetAmount(int route, float amount) { routes_[route].amount = amount; }
+  void SetEnabled(int route, bool enabled) { routes_[route].enabled = enabled; }
+
+  // Steps the LFOs over a block and leaves their values in their sources
+  void Advance(size_t size)
+  {
+    for (size_t i = 0; i < Lfos; i++)
+    {
+      sources_[i] = lfos_[i].Process(size);
+    }
+  }
+
+  // Every destination from its base and the enabled routes into it
+  void Update()
+  {
+    for (size_t d = 0; d < Destinations; d++)
+    {
+      previous_[d] = value_[d];
+      value_[d] = base_[d];
+    }
+    for (const Route& r : routes_)
+    {
+      if (!r.enabled)
+      {
+        continue;
+      }
+      float s = sources_[r.source];
+      if (r.shape == ModShape::kUnipolar)
+      {
+        s = 0.5f + 0.5f * s;
+      }
+      else if (r.shape == ModShape::kRectified)
+      {
+        s = fabsf(s);
+      }
+      float& v = value_[r.dest];
+      v = r.op == ModOp::kScale ? v * s * r.amount : v + s * r.amount;
+    }
+    for (size_t d = 0; d < Destinations; d++)
+    {
+      value_[d] = value_[d] < min_[d] ? min_[d] : (value_[d] > max_[d] ? max_[d] : value_[d]);
+    }
+  }
+
+  float Value(size_t dest) const { return value_[dest]; }
+  float Previous(size_t dest) const { return previous_[dest]; }
+
+  // The per-sample step from Previous() to Value() over size samples
+  float Step(size_t dest, size_t size) const
+  {
+    return size > 0 ? (value_[dest] - previous_[dest]) / (float)size : 0.0f;
+  }
+
+  // out[i] steps from Previous() to reach Value() at the block's last sample
+  void Ramp(size_t dest, float* out, size_t size) const
+  {
+    const float step = Step(dest, size);
+    float v = previous_[dest];
+    for (size_t i = 0; i < size; i++)
+    {
+      v += step;
+      out[i] = v;
+    }
+  }
+
+private:
+  struct Route
+  {
+    float amount;
+    uint8_t source;
+    uint8_t dest;
+    ModShape shape;
+    ModOp op;
+    bool enabled;
+  };
+
+  static_assert(Lfos + Inputs < 255, "ModMatrix numbers its sources in a byte");
+  static_assert(Destinations < 256, "ModMatrix numbers its destinations in a byte");
+
+  ModLfo lfos_[Lfos > 0 ? Lfos : 1];
+  float sources_[kSources];
+  float base_[Destinations];
+  float value_[Destinations];
+  float previous_[Destinations];
+  float min_[Destinations];
+  float max_[Destinations];
+  StaticVector<Route, Routes> routes_;
+};
+
+} // namespace clevelandmusicco
+
+#endif
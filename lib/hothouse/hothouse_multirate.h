@@ -0,0 +1,303 @@
+// FIR rate changers with their low-passes designed at compile time
+//
+// Resampler<Up, Down, Taps> changes the rate by Up / Down through a
+// Kaiser-windowed sinc dealt into Up polyphase branches, computing only the
+// samples it keeps; FirDecimator<Factor, Taps> and FirInterpolator<Factor,
+// Taps> are its integer cases. HalfbandDecimator<Pairs> and
+// HalfbandInterpolator<Pairs> are the 2:1 special case, where every other
+// tap of the low-pass is zero and the centre one is 0.5, so an output costs
+// Pairs multiply-adds instead of 2 * Pairs.
+//
+// The filter spec is a type with a cutoff, as a fraction of the lower of the
+// two Nyquist rates, and a Kaiser beta (ResamplerSpec, HalfbandSpec); the
+// coefficients are built from it when the pedal compiles, so changing a
+// factor or a spec never needs a table regenerated by hand. The designs call
+// sin, sqrt and cos in constant expressions, which GCC folds.
+//
+// Venus's 3:2 wet path, Earth's reverb rate (make REVERB_RATE) and Mars's
+// half-band model rates use these. The octave path's 6:1 in Earth and
+// BuzzBox (Util/Multirate.h) is a two-stage equiripple design for that one
+// factor, about half the multiply-adds of a single-stage Kaiser with the
+// same stop band, and stays as it is.
+
+#pragma once
+#ifndef HOTHOUSE_MULTIRATE_H
+#define HOTHOUSE_MULTIRATE_H
+
+#include <math.h>
+#include <stddef.h>
+
+namespace clevelandmusicco {
+
+// 7/8 of the lower Nyquist rate, beta 7: about -70 dB stop band
+struct ResamplerSpec
+{
+  static constexpr double cutoff = 0.875;
+  static constexpr double beta = 7.0;
+};
+
+// A half-band's cutoff is fixed at half the lower Nyquist rate; beta 8 gives
+// about -56 dB from 0.3 of the higher rate with 12 pairs
+struct HalfbandSpec
+{
+  static constexpr double beta = 8.0;
+};
+
+namespace multirate {
+
+// Modified Bessel function of the first kind, order 0, for the Kaiser
+// window; the series converges well within 32 terms for beta < 16
+constexpr double BesselI0(double x)
+{
+  double sum = 1;
+  double term = 1;
+  for (int k = 1; k < 32; k++)
+  {
+    term *= (x / (2 * k)) * (x / (2 * k));
+    sum += term;
+  }
+  return sum;
+}
+
+// Kaiser-windowed sinc low-pass at the upsampled rate, cutoff in cycles
+// per upsampled sample, dealt into Up phases of Taps / Up coefficients.
+// Scaled so each phase passes DC at unity, which makes up for the zeros
+// stuffed between input samples.
+template <size_t Up, size_t Taps>
+struct PolyphaseLowpass
+{
+  static const size_t length = Taps / Up;
+
+  constexpr PolyphaseLowpass(double cutoff, double beta) : coefficients()
+  {
+    double h[Taps] = {};
+    double sum = 0;
+    for (size_t k = 0; k < Taps; k++)
+    {
+      const double t = k - (Taps - 1) / 2.0;
+      const double r = 2 * t / (Taps - 1);
+      const double window = BesselI0(beta * sqrt(1 - r * r)) / BesselI0(beta);
+      const double x = 2 * cutoff * t;
+      const double sinc = x == 0 ? 1 : sin(M_PI * x) / (M_PI * x);
+      h[k] = 2 * cutoff * sinc * window;
+      sum += h[k];
+    }
+
+    for (size_t k = 0; k < Taps; k++)
+    {
+      coefficients[k % Up][k / Up] = (float)(h[k] * Up / sum);
+    }
+  }
+
+  float coefficients[Up][Taps / Up];
+};
+
+// The non-zero taps of a 4 * Pairs - 1 tap half-band low-pass, at offsets
+// +-1, +-3, ... from the centre, scaled so they sum to 0.25 and with the
+// centre's 0.5 pass DC at unity
+template <size_t Pairs>
+struct HalfbandLowpass
+{
+  constexpr HalfbandLowpass(double beta) : coefficients()
+  {
+    double h[Pairs] = {};
+    double sum = 0;
+    for (size_t j = 0; j < Pairs; j++)
+    {
+      const double t = 2.0 * j + 1;
+      const double r = t / (2.0 * Pairs - 1);
+      const double window = BesselI0(beta * sqrt(1 - r * r)) / BesselI0(beta);
+      // 0.5 sinc(t / 2), where sin(pi t / 2) is +-1 for odd t
+      h[j] = (j % 2 == 0 ? 1 : -1) / (M_PI * t) * window;
+      sum += h[j];
+    }
+
+    for (size_t j = 0; j < Pairs; j++)
+    {
+      coefficients[j] = (float)(h[j] * 0.25 / sum);
+    }
+  }
+
+  float coefficients[Pairs];
+};
+
+} // namespace multirate
+
+// Resamples by Up / Down: conceptually, stuffs Up - 1 zeros after each input
+// sample, low-passes and keeps every Down-th sample, computing only the kept
+// ones. Each process() call writes the outputs its inputs complete, so the
+// count per call varies by one with the phase.
+template <size_t Up, size_t Down, size_t Taps, typename Spec = ResamplerSpec>
+class Resampler
+{
+  static_assert(Taps % Up == 0, "Resampler taps must divide into Up phases");
+
+public:
+  typedef multirate::PolyphaseLowpass<Up, Taps> Lowpass;
+  static constexpr Lowpass lowpass{0.5 * Spec::cutoff / (Up > Down ? Up : Down), Spec::beta};
+
+  // Resamples size samples from in into out, returning how many it wrote:
+  // at most (size * Up + Down - 1) / Down + 1
+  size_t process(const float* in, size_t size, float* out)
+  {
+    size_t count = 0;
+    for (size_t n = 0; n < size; n++)
+    {
+      // Newest first, mirrored so the last length samples are contiguous
+      // from position
+      position = (position == 0 ? Lowpass::length : position) - 1;
+      history[position] = history[position + Lowpass::length] = in[n];
+
+      for (; phase < Up; phase += Down)
+      {
+        const float* h = lowpass.coefficients[phase];
+        const float* x = history + position;
+        float sum = 0;
+        for (size_t j = 0; j < Lowpass::length; j++)
+        {
+          sum += h[j] * x[j];
+        }
+        out[count++] = sum;
+      }
+      phase -= Up;
+    }
+    return count;
+  }
+
+  // Forgets the history, as after a restart of the stream
+  void clear()
+  {
+    for (float& sample : history)
+    {
+      sample = 0;
+    }
+    position = 0;
+    phase = 0;
+  }
+
+private:
+  float history[2 * Lowpass::length] = {};
+  size_t position = 0;
+  size_t phase = 0;
+};
+
+template <size_t Up, size_t Down, size_t Taps, typename Spec>
+constexpr typename Resampler<Up, Down, Taps, Spec>::Lowpass Resampler<Up, Down, Taps, Spec>::lowpass;
+
+// One output per Factor inputs, and Factor outputs per input
+template <size_t Factor, size_t Taps, typename Spec = ResamplerSpec>
+using FirDecimator = Resampler<1, Factor, Taps, Spec>;
+template <size_t Factor, size_t Taps, typename Spec = ResamplerSpec>
+using FirInterpolator = Resampler<Factor, 1, Taps, Spec>;
+
+// Newest-first history of the last 2 * Pairs samples, mirrored so they're
+// contiguous from the write position. Filter() is the half-band's
+// non-zero-centre phase over them.
+template <size_t Pairs, typename Spec = HalfbandSpec>
+class HalfbandHistory
+{
+public:
+  typedef multirate::HalfbandLowpass<Pairs> Lowpass;
+  static constexpr Lowpass lowpass{Spec::beta};
+
+  void Reset()
+  {
+    for (float& v : history_)
+    {
+      v = 0.0f;
+    }
+    pos_ = 0;
+  }
+
+  void Push(float x)
+  {
+    pos_ = (pos_ == 0 ? 2 * Pairs : pos_) - 1;
+    history_[pos_] = history_[pos_ + 2 * Pairs] = x;
+  }
+
+  float Filter() const
+  {
+    const float* x = history_ + pos_;
+    float sum = 0.0f;
+    for (size_t j = 0; j < Pairs; j++)
+    {
+      sum += lowpass.coefficients[j] * (x[Pairs - 1 - j] + x[Pairs + j]);
+    }
+    return sum;
+  }
+
+  // The sample Pairs - 1 pushes ago: where the other phase's lone centre
+  // tap lines up
+  float Centre() const { return history_[pos_ + Pairs - 1]; }
+
+private:
+  float history_[4 * Pairs] = {};
+  size_t pos_ = 0;
+};
+
+template <size_t Pairs, typename Spec>
+constexpr typename HalfbandHistory<Pairs, Spec>::Lowpass HalfbandHistory<Pairs, Spec>::lowpass;
+
+// Halves the rate: out[m] from in[2m * stride] and in[2m * stride + 1]...,
+// taken as separate even and odd sample streams so the caller can pass
+// either one interleaved signal (stride 2) or two phases (stride 1). Delays
+// by 2 * Pairs - 1 samples at the higher rate.
+template <size_t Pairs, typename Spec = HalfbandSpec>
+class HalfbandDecimator
+{
+public:
+  void Reset()
+  {
+    even_.Reset();
+    for (float& v : odd_)
+    {
+      v = 0.0f;
+    }
+    odd_pos_ = 0;
+  }
+
+  void Process(const float* even, const float* odd, size_t stride, float* out, size_t count)
+  {
+    for (size_t m = 0; m < count; m++)
+    {
+      even_.Push(even[m * stride]);
+      // The odd sample Pairs pairs ago
+      out[m] = even_.Filter() + 0.5f * odd_[odd_pos_];
+      odd_[odd_pos_] = odd[m * stride];
+      odd_pos_ = odd_pos_ + 1 == Pairs ? 0 : odd_pos_ + 1;
+    }
+  }
+
+private:
+  HalfbandHistory<Pairs, Spec> even_;
+  float odd_[Pairs] = {};
+  size_t odd_pos_ = 0;
+};
+
+// Doubles the rate: each in[m] makes an even and an odd output sample,
+// written to even[m * stride] and odd[m * stride] (stride 2: one interleaved
+// signal). Delays by 2 * Pairs - 1 samples at the higher rate.
+template <size_t Pairs, typename Spec = HalfbandSpec>
+class HalfbandInterpolator
+{
+public:
+  void Reset() { history_.Reset(); }
+
+  void Process(const float* in, float* even, float* odd, size_t stride, size_t count)
+  {
+    for (size_t m = 0; m < count; m++)
+    {
+      history_.Push(in[m]);
+      // Twice the taps make up for the zeros between input samples
+      even[m * stride] = 2.0f * history_.Filter();
+      odd[m * stride] = history_.Centre();
+    }
+  }
+
+private:
+  HalfbandHistory<Pairs, Spec> history_;
+};
+
+} // namespace clevelandmusicco
+
+#endif
@@ -0,0 +1,73 @@
+// Power-of-two ring buffer for delay lines
+//
+// Size must be a power of two, so every index wraps with a mask instead of
+// the divide a % costs (UDIV, up to 12 cycles on the M7). Indices are plain
+// size_t and may run past either end: operator[] and Delayed() mask them.
+//
+// Mirror = true keeps a second copy of the line straight after the first,
+// written with it, so any run of up to Size samples is contiguous in memory
+// (Window()): a FIR or a block copy over the history then needs no wrap
+// test. It costs twice the memory and a second store per Write().
+
+#pragma once
+#ifndef HOTHOUSE_RING_H
+#define HOTHOUSE_RING_H
+
+#include <stddef.h>
+
+namespace clevelandmusicco {
+
+template <typename T, size_t Size, bool Mirror = false>
+class RingBuffer
+{
+  static_assert(Size > 0 && (Size & (Size - 1)) == 0, "RingBuffer size must be a power of two");
+
+public:
+  static constexpr size_t kSize = Size;
+  static constexpr size_t kMask = Size - 1;
+
+  static size_t Wrap(size_t index) { return index & kMask; }
+
+  void Clear()
+  {
+    for (size_t i = 0; i < (Mirror ? 2 * Size : Size); i++)
+    {
+      line_[i] = T(0);
+    }
+    write_ = 0;
+  }
+
+  // Stores sample at WritePos() and moves it on by one
+  void Write(const T sample)
+  {
+    line_[write_] = sample;
+    line_[write_ + kMirrorOffset] = sample; // the same store unmirrored
+    write_ = (write_ + 1) & kMask;
+  }
+
+  // Where the next Write() goes: the newest sample is at WritePos() - 1
+  size_t WritePos() const { return write_; }
+
+  const T& operator[](size_t index) const { return line_[index & kMask]; }
+
+  // The sample written delay samples before the newest (0 = the newest)
+  const T& Delayed(size_t delay) const { return line_[(write_ - 1 - delay) & kMask]; }
+
+  // Mirror only: length (at most Size) consecutive samples, oldest first,
+  // the last of them delay samples before the newest
+  const T* Window(size_t delay, size_t length) const
+  {
+    static_assert(Mirror, "RingBuffer::Window() needs Mirror = true");
+    return &line_[(write_ - delay - length) & kMask];
+  }
+
+private:
+  static constexpr size_t kMirrorOffset = Mirror ? Size : 0;
+
+  T line_[Mirror ? 2 * Size : Size];
+  size_t write_ = 0;
+};
+
+} // namespace clevelandmusicco
+
+#endif
@@ -0,0 +1,59 @@
+// Single-producer single-consumer queue
+//
+// Hands items between the main loop and the audio callback without locks.
+// A fixed ring of Size slots (a power of two) holds up to Size - 1 items.
+// Push() only from one context and Pop() only from one other. Each side
+// writes only its own index, and the release/acquire pair makes an item's
+// contents visible before its slot is published.
+
+#pragma once
+#ifndef HOTHOUSE_SPSC_H
+#define HOTHOUSE_SPSC_H
+
+#include <atomic>
+#include <stddef.h>
+
+namespace clevelandmusicco {
+
+template <typename T, size_t Size>
+class SpscQueue
+{
+  static_assert((Size & (Size - 1)) == 0, "SpscQueue size must be a power of two");
+
+public:
+  // Producer. Returns false (dropping item) if the queue is full.
+  bool Push(const T& item)
+  {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    const size_t next = (head + 1) & (Size - 1);
+    if (next == tail_.load(std::memory_order_acquire))
+    {
+      return false;
+    }
+    items_[head] = item;
+    head_.store(next, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer. Returns false if the queue is empty.
+  bool Pop(T& item)
+  {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail == head_.load(std::memory_order_acquire))
+    {
+      return false;
+    }
+    item = items_[tail];
+    tail_.store((tail + 1) & (Size - 1), std::memory_order_release);
+    return true;
+  }
+
+private:
+  T items_[Size];
+  std::atomic<size_t> head_{0};
+  std::atomic<size_t> tail_{0};
+};
+
+} // namespace clevelandmusicco
+
+#endif
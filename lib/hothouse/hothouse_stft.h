@@ -0,0 +1,459 @@
+// Short-time Fourier transforms whose frames are worked outside the audio
+// callback
+//
+// Fourier is an overlap-add STFT: analysis, a processor on the spectrum,
+// and resynthesis (Venus's reverb). Analyzer is analysis only, a spectrum
+// handed to the processor every hop and nothing back (Simp's multi-pitch
+// estimator). Both take the frame size N and the FFT as template arguments
+// and the window, hop and buffers at construction, and neither allocates,
+// so either can be built in place in static storage. The FFT is ShyFFT or
+// a backend with its bin layout (hothouse_fft.h); with ShyFFT, the real
+// parts of bins 0..N/2 are in [0, N/2] and the imaginary parts of bins
+// 1..N/2-1 in [N/2 + 1, N).
+//
+// The audio callback only copies each block into an input ring and queues
+// the frames that complete in it; the main loop's service() windows and
+// transforms them. Scratch that lives only through one service() (Fourier's
+// out, Analyzer's frame) can be one buffer for every STFT serviced from the
+// same loop.
+
+#pragma once
+#ifndef HOTHOUSE_STFT_H
+#define HOTHOUSE_STFT_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "shy_fft.h"
+#include "hothouse_spsc.h"
+
+namespace clevelandmusicco {
+
+// Overlap-add STFT whose frames are transformed outside the audio
+// callback. write() copies a block into an input ring and queues each
+// frame that completes in it; service(), called from the main loop,
+// windows the frame out of the ring and runs forward(), the processor and
+// backward() on it; delay (stride - 1) samples after the frame completed,
+// read() adds it, windowed, into an output ring that it reads blocks
+// from. Per-callback work is then only the ring copies and one
+// overlap-add per hop, at the cost of about a hop of latency. Windows
+// come from a table of N samples of window, taken once. Nothing is
+// allocated, so a Fourier can be built in place in static storage.
+//
+// Frames complete on the original timeline of laps * 2 lanes that each
+// spent N samples writing and N reading, one sample overlapping: lane i's
+// first frame completes at sample N - 1 + i * stride, then one every
+// 2N - 1 samples. A frame service() has not finished by its first read is
+// dropped from the output and counted in late_frames.
+//
+// Alternatively, amortize() keeps the work in the audio callback: each
+// frame is split into the forward FFT, slices of the processor's bins
+// and the inverse FFT, and step(), called once per callback, runs the
+// next few of them, so a frame is spread over the callbacks of a hop.
+//
+// With stereo(), one analysis drives two resyntheses: the processor writes
+// the left channel's spectrum into out as before and the right's over its
+// in, in place (each bin after reading it), and each frame gets a second
+// inverse FFT and overlap-add, into the right channel's ring, that
+// read(left, right, size) reads. Left is then what mono would give.
+//
+// FFT is ShyFFT or another backend with its interface and bin layout
+// (see hothouse_fft.h). Overlap is the type the output rings are stored
+// in: T, or a narrower one such as half (hothouse_half.h) to save memory.
+// A narrower ring holds the frames already scaled to output level, so it
+// stays in range, at the cost of one more multiply per sample added.
+template <typename T, size_t N, typename FFT = ShyFFT<T, N, RotationPhasor>, typename Overlap = T> class Fourier
+{
+  static constexpr bool prescaled = !std::is_same<T, Overlap>::value;
+
+public:
+  // in is the analysis spectrum, only written to in stereo
+  void (*processor)(T* in, T* out);
+  // amortize()'s processor, over bins [begin, end) of the spectrum
+  void (*slice_processor)(T* in, T* out, size_t begin, size_t end) = nullptr;
+  // asked before each frame's forward FFT; if it returns false, the
+  // windowing and FFT are skipped and the processor gets no spectrum
+  // (its in holds whatever was last there), for processors that
+  // synthesize without one. Unset, every frame is analyzed.
+  bool (*analyze)() = nullptr;
+
+  // laps is at most max_laps; in and overlap are the input and output
+  // rings, of size (N + N / laps);
+  // middle and out hold one frame, of size N; window is anything callable
+  // on a phase in [0, 1), sampled once into window_table
+  template <typename Window>
+  Fourier(void (*processor)(T*, T*), FFT* fft, const Window& window, size_t laps, T* in, T* middle, T* out, Overlap* overlap)
+    : processor(processor), in(in), middle(middle), out(out), overlap(overlap), fft(fft), laps(laps < max_laps ? laps : max_laps),
+      stride(N / this->laps), delay(N / this->laps - 1), ring(N + N / this->laps)
+  {
+    for (size_t i = 0; i < this->laps * 2; i++)
+      countdowns[i] = N - 1 + i * stride;
+
+    for (size_t k = 0; k < N; k++)
+      window_table[k] = window((T)k / N);
+
+    memset(in, 0, sizeof(T) * ring);
+    memset(overlap, 0, sizeof(Overlap) * ring);
+  }
+
+  // writes a block of at most stride samples into the in ring, before
+  // read() of the same block
+  void write(const T* x, size_t size)
+  {
+    // the block's completed frames, in order: their last sample's offset
+    size_t completed[max_pending];
+    size_t num_completed = 0;
+
+    for (size_t i = 0; i < laps * 2; i++)
+    {
+      while (countdowns[i] < size)
+      {
+        size_t j = num_completed++;
+        for (; j > 0 && completed[j - 1] > countdowns[i]; j--)
+          completed[j] = completed[j - 1];
+        completed[j] = countdowns[i];
+        countdowns[i] += 2 * N - 1;
+      }
+      countdowns[i] -= size;
+    }
+
+    for (size_t j = 0; j < num_completed; j++)
+    {
+      // the frame's first sample, and where it is first read
+      const size_t last = in_position + completed[j];
+      jobs.Push((last + ring - (N - 1)) % ring); // never full
+      pending[pending_tail] = {(overlap_position + completed[j] + delay) % ring, frames_completed++};
+      pending_tail = (pending_tail + 1) % max_pending;
+    }
+
+    while (size > 0)
+    {
+      const size_t span = std::min(size, ring - in_position);
+      memcpy(in + in_position, x, sizeof(T) * span);
+      in_position = (in_position + span) % ring;
+      x += span;
+      size -= span;
+    }
+  }
+
+  // transforms and processes the queued frames, in order; call from the
+  // main loop (one context only). middle holds the last frame until read()
+  // overlap-adds it, which happens in the same callback as the next frame
+  // completes at the latest, so this must not run between a callback's
+  // write() and read().
+  void service()
+  {
+    size_t start;
+    while (jobs.Pop(start))
+    {
+      forward(start); // windows the frame at start into out, FTs it to middle
+      process(); // user-defined; ought to move info from middle to out buffer
+      backward(); // IFTs out to middle
+
+      frames_done.store(frames_done.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+  }
+
+  // splits each frame into pieces for step(): the forward FFT, slices
+  // runs of slice_processor over N / 2 bins, and the inverse FFT, spread
+  // over steps calls
+  void amortize(void (*processor)(T*, T*, size_t, size_t), size_t slices, size_t steps)
+  {
+    slice_processor = processor;
+    this->slices = slices;
+    pieces_per_step = (slices + 2 + steps - 1) / steps;
+  }
+
+  // runs the next pieces_per_step pieces of the queued frames, in order;
+  // call once per audio callback, after its write()s and before the
+  // next callback's (the queue is then used from one context)
+  void step()
+  {
+    for (size_t k = 0; k < pieces_per_step; k++)
+    {
+      if (!job_active)
+      {
+        if (!jobs.Pop(job_start))
+          return;
+        job_active = true;
+        job_piece = 0;
+      }
+
+      if (job_piece == 0)
+        forward(job_start);
+      else if (job_piece <= slices)
+      {
+        const size_t slice = job_piece - 1;
+        slice_processor(middle, out, slice * (N / 2) / slices, (slice + 1) * (N / 2) / slices);
+      }
+      else
+      {
+        backward();
+        frames_done.store(frames_done.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        job_active = false;
+        continue;
+      }
+      job_piece++;
+    }
+  }
+
+  inline void forward(const size_t start)
+  {
+    if (analyze && !analyze())
+      return;
+
+    const size_t span = std::min(N, ring - start);
+    for (size_t k = 0; k < span; k++)
+      out[k] = window_table[k] * in[start + k];
+    for (size_t k = span; k < N; k++)
+      out[k] = window_table[k] * in[k - span];
+    fft->Direct(out, middle); // analysis
+  }
+
+  inline void backward()
+  {
+    if (middle_right)
+      fft->Inverse(middle, middle_right); // the right channel's synthesis
+    fft->Inverse(out, middle); // synthesis
+  }
+
+  // executes user-defined callback
+  inline void process()
+  {
+    processor(middle, out);
+  }
+
+  // adds a right channel: middle_right holds one frame, of size N, and
+  // overlap_right is a second output ring, of size (N + N / laps). Call
+  // before the first write().
+  void stereo(T* middle_right, Overlap* overlap_right)
+  {
+    this->middle_right = middle_right;
+    this->overlap_right = overlap_right;
+    memset(middle_right, 0, sizeof(T) * N);
+    memset(overlap_right, 0, sizeof(Overlap) * ring);
+  }
+
+  // reads a block of reconstructed samples
+  void read(T* y, size_t size)
+  {
+    read(y, nullptr, size);
+  }
+
+  // reads a block of each channel; y_right is ignored, and may be null,
+  // unless stereo() was called
+  void read(T* y, T* y_right, size_t size)
+  {
+    if (!overlap_right)
+      y_right = nullptr;
+    const T scale = 1.0 / (N * laps / 2.0);
+
+    // overlap-add the frames due to start in this block
+    while (pending_head != pending_tail)
+    {
+      const size_t offset = (pending[pending_head].position + ring - overlap_position) % ring;
+      if (offset >= size)
+        break;
+
+      const uint32_t frame = pending[pending_head].frame;
+      pending_head = (pending_head + 1) % max_pending;
+
+      if ((int32_t)(frames_done.load(std::memory_order_acquire) - frame) > 0)
+      {
+        const size_t position = (overlap_position + offset) % ring;
+        overlapAdd(overlap, middle, position, prescaled ? scale : 1);
+        if (y_right)
+          overlapAdd(overlap_right, middle_right, position, prescaled ? scale : 1);
+      }
+      else
+        late_frames++;
+    }
+
+    if (y_right)
+      drain(overlap_right, y_right, size, prescaled ? 1 : scale);
+    drain(overlap, y, size, prescaled ? 1 : scale);
+    overlap_position = (overlap_position + size) % ring;
+  }
+
+private:
+  // adds a frame, windowed and times gain, into an output ring from
+  // position on
+  void overlapAdd(Overlap* target, const T* frame, size_t position, T gain)
+  {
+    const size_t span = std::min(N, ring - position);
+    Overlap* head = target + position;
+    for (size_t k = 0; k < span; k++)
+      head[k] += window_table[k] * frame[k] * gain;
+    for (size_t k = span; k < N; k++)
+      target[k - span] += window_table[k] * frame[k] * gain;
+  }
+
+  // reads size samples, scaled, out of an output ring from overlap_position
+  // on, clearing them behind it
+  void drain(Overlap* source, T* y, size_t size, T scale)
+  {
+    size_t position = overlap_position;
+    while (size > 0)
+    {
+      const size_t span = std::min(size, ring - position);
+      Overlap* head = source + position;
+      for (size_t k = 0; k < span; k++)
+        y[k] = head[k] * scale;
+      memset(head, 0, sizeof(Overlap) * span);
+      position = (position + span) % ring;
+      y += span;
+      size -= span;
+    }
+  }
+
+  T *in, *middle, *out;
+  Overlap* overlap;
+  // the right channel's frame and ring, set by stereo()
+  T* middle_right = nullptr;
+  Overlap* overlap_right = nullptr;
+
+  // a completed frame waiting for its first read
+  struct Pending
+  {
+    size_t position;
+    uint32_t frame;
+  };
+  static const size_t max_pending = 4;
+
+public:
+  static const size_t max_laps = 8;
+
+  FFT* fft;
+
+  size_t laps;
+  size_t stride;
+  size_t delay;
+  size_t ring;
+
+  // samples until each lane's next frame completes
+  size_t countdowns[max_laps * 2];
+  // window at k / N, for k < N
+  T window_table[N];
+
+  // next write into in, next read from overlap
+  size_t in_position = 0;
+  size_t overlap_position = 0;
+
+  // frames queued for service() (by first sample in the in ring); the
+  // audio side's list of them, and how many service() has finished
+  SpscQueue<size_t, 16> jobs;
+  Pending pending[max_pending];
+  size_t pending_head = 0;
+  size_t pending_tail = 0;
+  uint32_t frames_completed = 0;
+  std::atomic<uint32_t> frames_done{0};
+
+  // step()'s frame and its next piece
+  bool job_active = false;
+  size_t job_start = 0;
+  size_t job_piece = 0;
+  size_t slices = 1;
+  size_t pieces_per_step = 3;
+
+  uint32_t late_frames = 0;
+};
+
+// Analysis-only STFT: every hop samples, the last N are windowed and
+// transformed, and the spectrum goes to the processor passed to service().
+// write() copies a block into the ring and queues the end of each frame
+// that completes in it; service(), from the main loop, transforms them in
+// order. A frame service() reaches after the ring has wrapped over it is
+// skipped and counted in late_frames, and one that completes while the
+// queue is full is dropped, so a main loop that falls behind loses frames
+// rather than the audio side waiting. Ring, a power of two of at least N,
+// is how far behind it can fall: Ring - N samples.
+template <typename T, size_t N, typename FFT = ShyFFT<T, N, RotationPhasor>, size_t Ring = 2 * N> class Analyzer
+{
+  static_assert((Ring & (Ring - 1)) == 0 && Ring >= N, "Ring is a power of two of at least N");
+
+public:
+  // ring holds Ring samples, frame and spectrum N each; window is anything
+  // callable on a phase in [0, 1), sampled once into window_table
+  template <typename Window>
+  Analyzer(FFT* fft, const Window& window, size_t hop, T* ring, T* frame, T* spectrum)
+    : fft(fft), hop(hop), ring(ring), frame(frame), spectrum(spectrum)
+  {
+    for (size_t k = 0; k < N; k++)
+      window_table[k] = window((T)k / N);
+
+    reset();
+  }
+
+  // clears the ring; the first frame completes N samples on
+  void reset()
+  {
+    memset(ring, 0, sizeof(T) * Ring);
+    countdown = N;
+    written.store(0, std::memory_order_relaxed);
+    late_frames = 0;
+  }
+
+  // audio callback: a block of samples
+  void write(const T* x, size_t size)
+  {
+    uint32_t position = written.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < size; i++)
+    {
+      ring[position % Ring] = x[i];
+      position++;
+      if (--countdown == 0)
+      {
+        countdown = hop;
+        jobs.Push(position);
+      }
+    }
+    written.store(position, std::memory_order_release);
+  }
+
+  // main loop (one context only): calls processor(spectrum) on each queued
+  // frame, in order
+  template <typename Processor>
+  void service(Processor&& processor)
+  {
+    uint32_t end;
+    while (jobs.Pop(end))
+    {
+      for (size_t k = 0; k < N; k++)
+        frame[k] = window_table[k] * ring[(end - N + k) % Ring];
+
+      // the ring may have wrapped over the frame while it was copied
+      if (written.load(std::memory_order_acquire) - end > Ring - N)
+      {
+        late_frames++;
+        continue;
+      }
+
+      fft->Direct(frame, spectrum); // analysis
+      processor((const T*)spectrum);
+    }
+  }
+
+  FFT* fft;
+  size_t hop;
+
+  // window at k / N, for k < N
+  T window_table[N];
+
+  uint32_t late_frames = 0;
+
+private:
+  T *ring, *frame, *spectrum;
+
+  // samples until the next frame completes, and samples written so far
+  size_t countdown = N;
+  std::atomic<uint32_t> written{0};
+  // the end of each frame queued for service(), as a count of samples written
+  SpscQueue<uint32_t, 8> jobs;
+};
+
+} // namespace clevelandmusicco
+
+#endif
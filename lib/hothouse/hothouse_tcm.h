@@ -0,0 +1,41 @@
+// Placement of hot code and state in the Seed's tightly coupled memories
+//
+// ITCM (64K at 0x00000000) and DTCM (128K at 0x20000000) run at core clock
+// with no wait states and no cache to miss, where flash and QSPI code only
+// run fast while it stays in the I-cache. With `make TCM=1`, hothouse.mk
+// adds the hothouse_tcm.ld sections and the startup copy in hothouse.cpp,
+// and these macros put a function or an object there. Without it they are
+// empty, so the same source builds either way.
+//
+//   HOTHOUSE_ITCM          a function, e.g. the AudioCallback
+//   HOTHOUSE_ITCM_FLATTEN  a function with every call it makes inlined into
+//                          it, for templated kernels (RTNeural) that can't
+//                          be tagged themselves
+//   HOTHOUSE_DTCM          an initialised object (coefficients, small
+//                          state), copied from flash at boot
+//   HOTHOUSE_DTCM_BSS      a zero-initialised object, cleared at boot
+//
+// Both copies run before any static constructor, so tagged objects may
+// have constructors. `make tcm-report` lists what ended up in each region.
+
+#pragma once
+#ifndef HOTHOUSE_TCM_H
+#define HOTHOUSE_TCM_H
+
+#ifndef HOTHOUSE_TCM
+#define HOTHOUSE_TCM 0
+#endif
+
+#if HOTHOUSE_TCM
+#define HOTHOUSE_ITCM __attribute__((section(".itcm_text")))
+#define HOTHOUSE_ITCM_FLATTEN __attribute__((section(".itcm_text"), flatten))
+#define HOTHOUSE_DTCM __attribute__((section(".dtcm_data")))
+#define HOTHOUSE_DTCM_BSS __attribute__((section(".dtcm_bss")))
+#else
+#define HOTHOUSE_ITCM
+#define HOTHOUSE_ITCM_FLATTEN
+#define HOTHOUSE_DTCM
+#define HOTHOUSE_DTCM_BSS
+#endif
+
+#endif  // HOTHOUSE_TCM_H
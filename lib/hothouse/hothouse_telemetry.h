@@ -0,0 +1,377 @@
+// Framed binary telemetry over USB serial
+//
+// The reports (load meter, watchdog, memory, probes and the rest) post
+// fixed records here instead of printing, and the main loop drains them to
+// USB serial a bounded number of bytes at a time, so no pass of the loop
+// stalls formatting text or waiting on the host, and a report costs the
+// same whether anyone is listening or not. Post() is for the main loop and
+// PostFromAudio() for the audio callback; each has a SpscQueue of its own,
+// and a record that finds its queue full is dropped and counted, never
+// waited for. Drain() sends the callback's records first, then the main
+// loop's, then a DROPPED record when any were lost.
+//
+// On the wire a record is a frame:
+//   0xA5 0x5A  type  length  payload (length bytes)  CRC-16 (LE)
+// the CRC being CRC-16/CCITT-FALSE over type, length and payload. Payloads
+// are the little-endian structs below, at most kTelemetryPayload bytes; a
+// name or phase at the end of one runs to the end of the payload, without
+// a terminator. Text the log prints in between is plain ASCII, which never
+// holds 0xA5, so tools/hothouse_telemetry.py decodes a stream of both and
+// resynchronises on the next frame after a bad one.
+//
+// Types below kTelemetryUser are the library's; a pedal posts its own from
+// kTelemetryUser up.
+
+#pragma once
+#ifndef HOTHOUSE_TELEMETRY_H
+#define HOTHOUSE_TELEMETRY_H
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "hothouse_spsc.h"
+
+namespace clevelandmusicco {
+
+constexpr size_t kTelemetryPayload = 48;
+constexpr uint8_t kTelemetrySync[2] = {0xA5, 0x5A};
+// Sync, type and length ahead of the payload, the CRC after it
+constexpr size_t kTelemetryOverhead = 6;
+constexpr size_t kTelemetryMaxFrame = kTelemetryPayload + kTelemetryOverhead;
+
+enum TelemetryType : uint8_t
+{
+  TELEMETRY_LOAD = 1,         // TelemetryLoad
+  TELEMETRY_WATCHDOG,         // TelemetryWatchdog, one a mode with blocks
+  TELEMETRY_OVERRUN,          // TelemetryOverrun, from the callback
+  TELEMETRY_BOOT,             // TelemetryBoot
+  TELEMETRY_ALLOC,            // TelemetryAlloc
+  TELEMETRY_DENORMAL_BLOCKS,  // TelemetryDenormalBlocks
+  TELEMETRY_DENORMAL_WATCH,   // TelemetryDenormalWatch
+  TELEMETRY_MEMORY,           // TelemetryMemory
+  TELEMETRY_LATENCY,          // TelemetryLatency
+  TELEMETRY_PROBE_STATE,      // TelemetryProbeState
+  TELEMETRY_PROBE_TAP,        // TelemetryProbeTap
+  TELEMETRY_PROBE_DATA,       // TelemetryProbeData
+  TELEMETRY_NULL_TEST,        // TelemetryNullTest
+  TELEMETRY_DROPPED = 127,    // TelemetryDropped
+  kTelemetryUser = 128,
+};
+
+struct TelemetryLoad
+{
+  float average;  // Of the block period, since the last report
+  float peak;
+};
+
+struct TelemetryWatchdog
+{
+  uint8_t session;  // 0 the last, 1 this one
+  uint8_t mode;
+  uint16_t block_size;
+  uint32_t sample_rate;
+  uint32_t seconds;
+  uint32_t period_cycles;
+  uint32_t blocks;
+  uint32_t overruns;
+  uint32_t late_starts;
+  uint32_t worst_cycles;
+  uint32_t quality;  // Hothouse::Quality
+};
+
+struct TelemetryOverrun
+{
+  uint32_t mode;
+  uint32_t cycles;
+  uint32_t period_cycles;
+};
+
+struct TelemetryBoot
+{
+  uint32_t at_us;
+  uint32_t took_us;
+  char phase[kTelemetryPayload - 8];
+};
+
+struct TelemetryAlloc
+{
+  uint32_t count;
+  uint32_t first_caller;
+};
+
+struct TelemetryDenormalBlocks
+{
+  uint32_t flushed_in;
+  uint32_t flushed_out;
+  uint32_t invalid;
+};
+
+struct TelemetryDenormalWatch
+{
+  uint32_t subnormal;
+  uint32_t non_finite;
+  uint32_t count;
+  char name[kTelemetryPayload - 12];
+};
+
+// Zero for what this build doesn't measure
+struct TelemetryMemory
+{
+  uint32_t stack_used;
+  uint32_t stack_painted;
+  uint32_t heap_arena;
+  uint32_t heap_in_use;
+  uint32_t sram_data;
+  uint32_t sram_bss;
+  uint32_t dtcm_data;
+  uint32_t dtcm_bss;
+  uint32_t itcm;
+  uint32_t sdram_used;
+  uint32_t sdram_capacity;
+};
+
+// Samples, -1 for no click back
+struct TelemetryLatency
+{
+  int32_t through;
+  int32_t bare;
+  uint32_t sample_rate;
+  uint32_t block_size;
+};
+
+// One period of Hothouse::NullTest(): the peak difference, the mean squares
+// of the reference and of the difference, and the samples compared
+struct TelemetryNullTest
+{
+  float peak;
+  float signal;
+  float error;
+  uint32_t samples;
+};
+
+enum TelemetryProbeStates : uint8_t
+{
+  TELEMETRY_PROBE_ARMED,
+  TELEMETRY_PROBE_STOPPED,
+  TELEMETRY_PROBE_BEGIN,  // A dump of count taps follows
+  TELEMETRY_PROBE_END,
+};
+
+struct TelemetryProbeState
+{
+  uint8_t state;
+  uint8_t count;
+};
+
+struct TelemetryProbeTap
+{
+  uint8_t id;
+  uint8_t reserved[3];
+  uint32_t frames;
+  uint32_t rate_hz;
+  char name[kTelemetryPayload - 12];
+};
+
+// Samples from first on, as many as the length holds
+struct TelemetryProbeData
+{
+  uint8_t id;
+  uint8_t reserved[3];
+  uint32_t first;
+  float samples[(kTelemetryPayload - 8) / 4];
+};
+
+struct TelemetryDropped
+{
+  uint32_t count;  // Since the last DROPPED
+};
+
+static_assert(sizeof(TelemetryWatchdog) == 36, "TelemetryWatchdog has padding");
+static_assert(sizeof(TelemetryMemory) <= kTelemetryPayload, "TelemetryMemory is too long");
+static_assert(sizeof(TelemetryProbeData) == kTelemetryPayload, "TelemetryProbeData has padding");
+
+struct TelemetryRecord
+{
+  uint8_t type;
+  uint8_t length;
+  uint8_t payload[kTelemetryPayload];
+};
+
+// A payload with a string at its end, at offset: copies it in, cut to
+// fit, and returns the payload's length
+inline size_t TelemetryText(void* payload, size_t offset, const char* text)
+{
+  size_t n = strlen(text);
+  if (n > kTelemetryPayload - offset)
+  {
+    n = kTelemetryPayload - offset;
+  }
+  memcpy(static_cast<uint8_t*>(payload) + offset, text, n);
+  return offset + n;
+}
+
+// CRC-16/CCITT-FALSE, crc 0xFFFF or the CRC of the bytes before
+inline uint16_t TelemetryCrc(uint16_t crc, const uint8_t* data, size_t length)
+{
+  for (size_t i = 0; i < length; i++)
+  {
+    crc ^= (uint16_t)(data[i] << 8);
+    for (int bit = 0; bit < 8; bit++)
+    {
+      crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+  }
+  return crc;
+}
+
+// Records queued in main and audio queues of Records slots each (powers of
+// two, Records - 1 usable), framed into two TxBytes buffers by turns: one
+// in flight while the other fills
+template <size_t Records, size_t TxBytes = 512>
+class Telemetry
+{
+  static_assert(TxBytes >= 2 * kTelemetryMaxFrame, "Telemetry's buffer holds too few frames");
+
+public:
+  // Main loop. Returns false, counting it dropped, if the queue is full
+  // or the payload too long.
+  bool Post(uint8_t type, const void* payload, size_t length)
+  {
+    return Queue(main_, type, payload, length);
+  }
+
+  // The audio callback, as Post()
+  bool PostFromAudio(uint8_t type, const void* payload, size_t length)
+  {
+    return Queue(audio_, type, payload, length);
+  }
+
+  // Main loop, for a producer that paces itself on the queue (a dump): as
+  // Post(), but a full queue isn't a drop, and the same record can be
+  // offered again on a later pass
+  bool Offer(uint8_t type, const void* payload, size_t length)
+  {
+    return Queue(main_, type, payload, length, false);
+  }
+
+  // Main loop. Frames up to budget bytes of records (at least one frame's
+  // worth) and hands them to transmit(data, size), which returns false if
+  // the port is busy. A batch it refuses is offered again on the next call
+  // before anything new is framed, so this only ever copies and frames,
+  // never waits. A batch transmit() took stays untouched until the next
+  // one is taken: a port that accepts a transfer has finished the last.
+  // Returns the bytes taken this call.
+  template <typename Transmit>
+  size_t Drain(size_t budget, Transmit&& transmit)
+  {
+    if (pending_ == 0)
+    {
+      if (budget > TxBytes)
+      {
+        budget = TxBytes;
+      }
+      if (budget < kTelemetryMaxFrame)
+      {
+        budget = kTelemetryMaxFrame;
+      }
+      uint8_t* out = tx_[fill_];
+      TelemetryRecord record;
+      while (pending_ + kTelemetryMaxFrame <= budget && Next(record))
+      {
+        pending_ += Frame(record, out + pending_);
+      }
+      if (pending_ == 0)
+      {
+        return 0;
+      }
+    }
+    if (!transmit(tx_[fill_], pending_))
+    {
+      return 0;
+    }
+    const size_t sent = pending_;
+    pending_ = 0;
+    fill_ ^= 1;
+    return sent;
+  }
+
+  // Records lost to a full queue or an oversized payload, all told
+  uint32_t Dropped() const { return dropped_total_.load(std::memory_order_relaxed); }
+
+private:
+  bool Queue(SpscQueue<TelemetryRecord, Records>& queue, uint8_t type, const void* payload,
+             size_t length, bool drop_when_full = true)
+  {
+    TelemetryRecord record;
+    if (length > kTelemetryPayload)
+    {
+      Drop();
+      return false;
+    }
+    record.type = type;
+    record.length = (uint8_t)length;
+    memcpy(record.payload, payload, length);
+    if (!queue.Push(record))
+    {
+      if (drop_when_full)
+      {
+        Drop();
+      }
+      return false;
+    }
+    return true;
+  }
+
+  void Drop()
+  {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    dropped_total_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // The callback's records first: they are the ones a full queue loses
+  bool Next(TelemetryRecord& record)
+  {
+    if (audio_.Pop(record) || main_.Pop(record))
+    {
+      return true;
+    }
+    const uint32_t dropped = dropped_.exchange(0, std::memory_order_relaxed);
+    if (dropped == 0)
+    {
+      return false;
+    }
+    const TelemetryDropped lost = {dropped};
+    record.type = TELEMETRY_DROPPED;
+    record.length = sizeof(lost);
+    memcpy(record.payload, &lost, sizeof(lost));
+    return true;
+  }
+
+  static size_t Frame(const TelemetryRecord& record, uint8_t* out)
+  {
+    out[0] = kTelemetrySync[0];
+    out[1] = kTelemetrySync[1];
+    out[2] = record.type;
+    out[3] = record.length;
+    memcpy(out + 4, record.payload, record.length);
+    const uint16_t crc = TelemetryCrc(0xFFFF, out + 2, 2 + (size_t)record.length);
+    out[4 + record.length] = (uint8_t)(crc & 0xFF);
+    out[5 + record.length] = (uint8_t)(crc >> 8);
+    return kTelemetryOverhead + record.length;
+  }
+
+  SpscQueue<TelemetryRecord, Records> main_;
+  SpscQueue<TelemetryRecord, Records> audio_;
+  std::atomic<uint32_t> dropped_{0};  // Since the last DROPPED record
+  std::atomic<uint32_t> dropped_total_{0};
+
+  uint8_t tx_[2][TxBytes];
+  int fill_ = 0;        // The buffer being framed into, or offered
+  size_t pending_ = 0;  // Bytes in it waiting for transmit() to take them
+};
+
+} // namespace clevelandmusicco
+
+#endif
@@ -0,0 +1,354 @@
+// Tempo clock and block event scheduler for the audio callback
+//
+// TempoClock keeps a beat grid in samples: a period and the sample the
+// next beat falls on, stepped from one to the next by whole samples and a
+// carried fraction, so the grid never drifts off the tempo it was given.
+// The tempo comes from footswitch taps (Tap()) or a MIDI clock (MidiTick(),
+// 24 a beat), or is set outright (SetPeriod()). Everything runs in the
+// callback: taps from the controls it scans, MIDI bytes Post()ed to it
+// from the main loop (hothouse_commands.h), each at an offset into the
+// block it arrives in.
+//
+// EventScheduler takes one-shot events at sample times on the same clock
+// and, once a block, Split()s the block at them and at the clock's beats:
+// a stage gets contiguous runs handed to it, with the events between
+// them, instead of testing every sample for a boundary. Events() is the
+// same walk for code that only wants the events.
+//
+//   clock.Tap(0);                       // a tap at the block's start
+//   scheduler.Split(clock, size,
+//       [](size_t start, size_t count) { ... },  // a run of the block
+//       [](int id, size_t at) { ... });          // an event, kBeat for a beat
+//
+// Split() (or Events()) advances the clock by the block, so call exactly
+// one of them every callback, bypassed or not.
+
+#pragma once
+#ifndef HOTHOUSE_TEMPO_H
+#define HOTHOUSE_TEMPO_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace clevelandmusicco {
+
+class TempoClock
+{
+public:
+  static constexpr int kMidiTicksPerBeat = 24;
+
+  // Taps and MIDI beats outside minSeconds..maxSeconds don't set a tempo
+  void Init(float sampleRate, float minSeconds, float maxSeconds)
+  {
+    min_period_ = minSeconds * sampleRate;
+    max_period_ = maxSeconds * sampleRate;
+    now_ = 0;
+    Clear();
+  }
+
+  // A footswitch tap at offset into this block. Taps closer together than
+  // the longest period form a run; each after the first sets the period
+  // to the mean of the run's last few intervals and puts a beat on the
+  // tap. Returns true if it continued a run (so it was a tempo tap), false
+  // if it was the first of a new one.
+  bool Tap(size_t offset = 0)
+  {
+    const uint32_t at = now_ + (uint32_t)offset;
+    const uint32_t interval = at - last_tap_;
+    last_tap_ = at;
+    if (!tapping_ || (float)interval > max_period_ || (float)interval < min_period_)
+    {
+      tapping_ = true;
+      taps_ = 0;
+      return false;
+    }
+
+    tap_history_[taps_ % kTapHistory] = interval;
+    taps_++;
+    const int count = taps_ < kTapHistory ? taps_ : kTapHistory;
+    uint32_t sum = 0;
+    for (int i = 0; i < count; i++)
+    {
+      sum += tap_history_[i];
+    }
+    Start((float)sum / count, at);
+    return true;
+  }
+
+  // A MIDI timing clock (0xF8) at offset into this block. The period is
+  // the sum of the last kMidiTicksPerBeat intervals (fewer, scaled, until
+  // there are that many), and a beat falls on every 24th tick from the
+  // first after MidiStart(), or from the first tick heard.
+  void MidiTick(size_t offset = 0)
+  {
+    const uint32_t at = now_ + (uint32_t)offset;
+    const uint32_t interval = at - last_tick_;
+    last_tick_ = at;
+    if (!ticking_ || (float)interval * kMidiTicksPerBeat > max_period_)
+    {
+      // The first tick, or the clock came back after a gap
+      ticking_ = true;
+      ticks_ = 0;
+      intervals_ = 0;
+      tick_sum_ = 0;
+      Beat(at);
+      return;
+    }
+
+    tick_sum_ += interval;
+    if (intervals_ == kMidiTicksPerBeat)
+    {
+      tick_sum_ -= tick_history_[ticks_ % kMidiTicksPerBeat];
+    }
+    else
+    {
+      intervals_++;
+    }
+    tick_history_[ticks_ % kMidiTicksPerBeat] = interval;
+    ticks_ = (ticks_ + 1) % kMidiTicksPerBeat;
+
+    const float period = (float)tick_sum_ * kMidiTicksPerBeat / intervals_;
+    if (period >= min_period_)
+    {
+      period_ = period;
+    }
+    if (ticks_ == 0)
+    {
+      Sync(at);
+    }
+  }
+
+  // MIDI start (0xFA): the next tick is a downbeat
+  void MidiStart() { ticking_ = false; }
+
+  // MIDI stop (0xFC): no more beats until the clock or a tap starts them
+  void MidiStop()
+  {
+    ticking_ = false;
+    running_ = false;
+  }
+
+  // A fixed period in samples, with a beat at offset into this block
+  void SetPeriod(float samples, size_t offset = 0)
+  {
+    Start(samples, now_ + (uint32_t)offset);
+  }
+
+  // Forgets the tempo, e.g. when a knob takes the time back
+  void Clear()
+  {
+    tapping_ = false;
+    taps_ = 0;
+    ticking_ = false;
+    running_ = false;
+    period_ = 0.0f;
+  }
+
+  bool HasTempo() const { return period_ > 0.0f; }
+  // True while beats are being laid down
+  bool Running() const { return running_; }
+  // Samples a beat
+  float Period() const { return period_; }
+  // The sample time at the start of this block
+  uint32_t Now() const { return now_; }
+
+private:
+  friend class EventSchedulerBase;
+
+  static constexpr int kTapHistory = 3;
+
+  void Start(float period, uint32_t at)
+  {
+    period_ = period;
+    Beat(at);
+  }
+
+  // Puts the next beat at at, and the grid on from there
+  void Beat(uint32_t at)
+  {
+    next_beat_ = at;
+    beat_frac_ = 0.0f;
+    running_ = period_ > 0.0f;
+  }
+
+  // A MIDI beat at at: the grid's own beat nearest it moves onto it. If
+  // that one has already been given out, a little early, the grid goes on
+  // from at without giving it again.
+  void Sync(uint32_t at)
+  {
+    if (running_ && (float)(int32_t)(next_beat_ - at) > 0.5f * period_)
+    {
+      Beat(at);
+      StepBeat();
+    }
+    else
+    {
+      Beat(at);
+    }
+  }
+
+  // The next beat, if it falls before end
+  bool BeatBefore(uint32_t end, uint32_t& at) const
+  {
+    at = next_beat_;
+    return running_ && (int32_t)(end - next_beat_) > 0;
+  }
+
+  void StepBeat()
+  {
+    const float next = beat_frac_ + period_;
+    const uint32_t whole = (uint32_t)next;
+    next_beat_ += whole > 0 ? whole : 1;
+    beat_frac_ = next - (float)whole;
+  }
+
+  void Advance(size_t size) { now_ += (uint32_t)size; }
+
+  float min_period_ = 0.0f;
+  float max_period_ = 0.0f;
+  uint32_t now_ = 0;
+
+  float period_ = 0.0f;
+  bool running_ = false;
+  uint32_t next_beat_ = 0;
+  float beat_frac_ = 0.0f;
+
+  bool tapping_ = false;
+  uint32_t last_tap_ = 0;
+  int taps_ = 0;
+  uint32_t tap_history_[kTapHistory] = {};
+
+  bool ticking_ = false;
+  uint32_t last_tick_ = 0;
+  int ticks_ = 0;      // Since the last beat
+  int intervals_ = 0;  // In tick_history_, up to a beat's
+  uint32_t tick_sum_ = 0;
+  uint32_t tick_history_[kMidiTicksPerBeat] = {};
+};
+
+// The clock access EventScheduler's walk needs, outside the template
+class EventSchedulerBase
+{
+public:
+  // The id Split() and Events() pass for the clock's beats
+  static constexpr int kBeat = -1;
+
+protected:
+  static bool BeatBefore(const TempoClock& clock, uint32_t end, uint32_t& at)
+  {
+    return clock.BeatBefore(end, at);
+  }
+  static void StepBeat(TempoClock& clock) { clock.StepBeat(); }
+  static void Advance(TempoClock& clock, size_t size) { clock.Advance(size); }
+};
+
+template <size_t Capacity>
+class EventScheduler : public EventSchedulerBase
+{
+public:
+  // Schedules id (0 or more) for delay samples after the start of clock's
+  // current block. Events at the same time keep their order. Returns false,
+  // dropping it, when Capacity are already waiting.
+  bool Post(const TempoClock& clock, uint32_t delay, int id)
+  {
+    if (count_ == Capacity)
+    {
+      return false;
+    }
+    const uint32_t at = clock.Now() + delay;
+    size_t i = count_++;
+    while (i > 0 && (int32_t)(events_[i - 1].at - at) > 0)
+    {
+      events_[i] = events_[i - 1];
+      --i;
+    }
+    events_[i] = {at, id};
+    return true;
+  }
+
+  // Drops every waiting event with id
+  void Cancel(int id)
+  {
+    size_t kept = 0;
+    for (size_t i = 0; i < count_; ++i)
+    {
+      if (events_[i].id != id)
+      {
+        events_[kept++] = events_[i];
+      }
+    }
+    count_ = kept;
+  }
+
+  // Walks this block of size samples: run(start, count) over each stretch
+  // between events and event(id, offset) at each, in time order; a beat
+  // and an event at the same sample give the beat first. Then advances
+  // the clock.
+  template <typename Run, typename Event>
+  void Split(TempoClock& clock, size_t size, Run&& run, Event&& event)
+  {
+    const uint32_t start = clock.Now();
+    const uint32_t end = start + (uint32_t)size;
+    size_t pos = 0;
+    for (;;)
+    {
+      uint32_t beat;
+      const bool has_beat = BeatBefore(clock, end, beat);
+      const bool has_event = count_ > 0 && (int32_t)(end - events_[0].at) > 0;
+      if (!has_beat && !has_event)
+      {
+        break;
+      }
+      const bool beat_first = has_beat && (!has_event || (int32_t)(events_[0].at - beat) >= 0);
+      const uint32_t at = beat_first ? beat : events_[0].at;
+      // Anything due before the block (posted late) happens at its start
+      const size_t offset = (int32_t)(at - start) > 0 ? (size_t)(at - start) : 0;
+      if (offset > pos)
+      {
+        run(pos, offset - pos);
+        pos = offset;
+      }
+      if (beat_first)
+      {
+        StepBeat(clock);
+        event(kBeat, offset);
+      }
+      else
+      {
+        const int id = events_[0].id;
+        for (size_t i = 1; i < count_; ++i)
+        {
+          events_[i - 1] = events_[i];
+        }
+        --count_;
+        event(id, offset);
+      }
+    }
+    if (size > pos)
+    {
+      run(pos, size - pos);
+    }
+    Advance(clock, size);
+  }
+
+  // Split() with nothing to run between the events
+  template <typename Event>
+  void Events(TempoClock& clock, size_t size, Event&& event)
+  {
+    Split(clock, size, [](size_t, size_t) {}, event);
+  }
+
+private:
+  struct Pending
+  {
+    uint32_t at;
+    int id;
+  };
+
+  Pending events_[Capacity];
+  size_t count_ = 0;
+};
+
+} // namespace clevelandmusicco
+
+#endif
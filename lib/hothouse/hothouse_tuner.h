@@ -0,0 +1,148 @@
+// Chromatic tuner that stands in for a pedal's DSP while it is active
+//
+// While Active(), the pedal's callback hands its input to Process() and
+// returns: the outputs are muted and none of the pedal's own processing
+// runs. The input is decimated 6:1 to 8 kHz (FirDecimator, 36 taps: six
+// multiply-adds per input sample) and q's signal_conditioner and
+// pitch_detector run on that, so the tuner costs a fraction of any of the
+// pedals' effects. ShowOnLeds() shows the result:
+//
+//   no note        both off
+//   flat           LED 1, brighter the further off, up to 50 cents
+//   sharp          LED 2, likewise
+//   in tune        both full (within kInTune cents)
+//
+// Needs Q (q_lib/include) on the pedal's include path, as BuzzBox and Earth
+// have it. Enter and leave the tuner from the pedal's footswitch handling;
+// FS1 held for 2 s stays the bootloader in every pedal, so use FS2.
+
+#pragma once
+#ifndef HOTHOUSE_TUNER_H
+#define HOTHOUSE_TUNER_H
+
+#include <math.h>
+#include <stddef.h>
+
+#include <q/fx/signal_conditioner.hpp>
+#include <q/pitch/pitch_detector.hpp>
+
+#include "hothouse.h"
+#include "hothouse_fastmath.h"
+#include "hothouse_multirate.h"
+
+namespace clevelandmusicco {
+
+class Tuner
+{
+public:
+  static constexpr size_t kFactor = 6;
+  static constexpr float kLowest = 55.0f;  // A1, below a guitar's drop tunings
+  static constexpr float kHighest = 1400.0f;
+  static constexpr float kInTune = 3.0f;   // cents either side
+  static constexpr float kReference = 440.0f;
+
+  explicit Tuner(float sample_rate = 48000.0f)
+      : rate_(sample_rate / kFactor),
+        conditioner_{conditioner_config_, cycfi::q::frequency(kLowest), cycfi::q::frequency(kHighest), rate_},
+        detector_{cycfi::q::frequency(kLowest), cycfi::q::frequency(kHighest), rate_,
+                  cycfi::q::decibel(-45.0, cycfi::q::direct_unit)}
+  {
+  }
+
+  void Start()
+  {
+    detector_.reset();
+    frequency_ = 0.0f;
+    active_ = true;
+  }
+
+  void Stop() { active_ = false; }
+
+  bool Active() const { return active_; }
+
+  // Analyses in and writes silence to both outputs
+  void Process(const float* in, float* out_left, float* out_right, size_t size)
+  {
+    float bus[kChunk / kFactor + 1];
+    for (size_t done = 0; done < size; done += kChunk)
+    {
+      const size_t n = size - done < kChunk ? size - done : kChunk;
+      const size_t count = decimator_.process(in + done, n, bus);
+      for (size_t i = 0; i < count; i++)
+      {
+        Analyse(bus[i]);
+      }
+    }
+    for (size_t i = 0; i < size; i++)
+    {
+      out_left[i] = 0.0f;
+      out_right[i] = 0.0f;
+    }
+  }
+
+  // Hz, 0 while no note is held
+  float Frequency() const { return frequency_; }
+
+  // Nearest MIDI note to Frequency(), and how far off it is in cents
+  int Note() const { return (int)floorf(Semitones() + 0.5f) + 69; }
+  float Cents() const { return 100.0f * (Semitones() - (float)(Note() - 69)); }
+
+  void ShowOnLeds(Hothouse& hw) const
+  {
+    float flat = 0.0f;
+    float sharp = 0.0f;
+    if (frequency_ > 0.0f)
+    {
+      const float cents = Cents();
+      if (fabsf(cents) <= kInTune)
+      {
+        flat = sharp = 1.0f;
+      }
+      else
+      {
+        const float level = 0.2f + 0.8f * fminf(1.0f, fabsf(cents) / 50.0f);
+        (cents < 0.0f ? flat : sharp) = level;
+      }
+    }
+    hw.SetLed(Hothouse::LED_1, flat);
+    hw.SetLed(Hothouse::LED_2, sharp);
+  }
+
+private:
+  static constexpr size_t kChunk = 48;
+
+  float Semitones() const { return 12.0f * fastmath::Log2(frequency_ / kReference); }
+
+  void Analyse(float s)
+  {
+    s = conditioner_(s);
+    const bool gate = conditioner_.gate();
+    detector_(s);
+    if (!gate)
+    {
+      if (gate_)
+      {
+        detector_.reset();
+      }
+      frequency_ = 0.0f;
+    }
+    else if (detector_.get_frequency() > 0.0f)
+    {
+      frequency_ = detector_.get_frequency();
+    }
+    gate_ = gate;
+  }
+
+  float rate_;
+  cycfi::q::signal_conditioner::config conditioner_config_;
+  cycfi::q::signal_conditioner conditioner_;
+  cycfi::q::pitch_detector detector_;
+  FirDecimator<kFactor, 36> decimator_;
+  float frequency_ = 0.0f;
+  bool gate_ = false;
+  bool active_ = false;
+};
+
+} // namespace clevelandmusicco
+
+#endif
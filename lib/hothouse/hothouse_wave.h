@@ -0,0 +1,108 @@
+// Interpolated lookup tables of a shape, and the STFT windows
+//
+// Wave<T, Shape> samples Shape, a functor with a constexpr T operator()(T)
+// const, into a table at compile time and reads it back with linear
+// interpolation, so a constexpr Wave lives in flash and needs no filling
+// at boot. Hann is the window the STFTs in hothouse_stft.h are built with:
+//
+//   constexpr Wave<float, Hann> hann{};
+//   Fourier<float, 4096> fourier(processor, &fft, hann, 4, ...);
+
+#pragma once
+#ifndef HOTHOUSE_WAVE_H
+#define HOTHOUSE_WAVE_H
+
+#include <math.h>
+
+namespace clevelandmusicco {
+
+const int TABSIZE = 2048;
+
+// The Hann window over a phase in [0, 1)
+struct Hann
+{
+  constexpr float operator()(float phase) const
+  {
+    return 0.5 * (1 - cos(2 * 3.1415926535897932384626433832795 * phase));
+  }
+};
+
+// A table of Shape over [left, right), read periodically or, if not
+// periodic, clamped to its ends
+template <typename T, typename Shape, int TableSize = TABSIZE> class Wave
+{
+public:
+  constexpr Wave(T left = 0, T right = 1, bool periodic = true)
+    : table(), left(left), right(right), periodic(periodic), endpoint(Shape()(right))
+  {
+    for (int i = 0; i < TableSize; i++)
+    {
+      T phase = (T) i / TableSize;
+      table[i] = Shape()((1 - phase) * left + phase * right);
+    }
+  }
+
+#ifdef FUNCTIONAL
+  T lookup(T input) const
+  {
+    return Shape()(input);
+  }
+#else
+  T lookup(T input) const
+  {
+    T phase = (input - left) / (right - left);
+
+    // get value at endpoint if input is out of bounds
+    if (!periodic && (phase < 0 || phase >= 1))
+    {
+      if (phase < 0)
+        return none(0);
+      else
+        return endpoint;
+    }
+    else
+    {
+      phase += 1;
+      phase -= int(phase);
+
+      int center = (int)(phase * TableSize) % TableSize;
+      int after = (center + 1) % TableSize;
+
+      T disp = (phase * TableSize - center);
+      disp -= int(disp);
+
+      return linear(center, after, disp);
+    }
+  }
+#endif
+
+  T operator()(T phase) const
+  {
+    return lookup(phase);
+  }
+
+protected:
+  T table[TableSize];
+
+private:
+  T left; // input phases are interpreted as lying in [left, right)
+  T right;
+  bool periodic;
+
+  T endpoint; // if (this->periodic == false), provides a value for (*this)(right)
+
+  T none(int center) const
+  {
+    return table[center];
+  }
+
+  T linear(int center, int after, T disp) const
+  {
+    return table[center] * (1 - disp) + table[after] * disp;
+  }
+
+};
+
+} // namespace clevelandmusicco
+
+#endif
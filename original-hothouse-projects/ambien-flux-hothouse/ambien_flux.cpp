@@ -1,8 +1,16 @@
 #include "daisy_seed.h"
 #include "daisysp.h"
 #include "hothouse.h"
-#include <stdlib.h>  // For rand() and srand()
-#include <cmath>     // For logf()
+#include "hothouse_arena.h"
+#include "hothouse_curves.h"
+#include "hothouse_envelope.h"
+#include "slice_engine.h"
+#include "custom_bitcrush.h"
+#include "tape_wobble.h"
+#include "sparse_dust.h"
+#include "fast_random.h"
+#include <stdlib.h>
+#include <cmath>
 
 // Dust is included in daisysp.h - no separate include needed
 
@@ -27,19 +35,26 @@
 // - K5: SLICE LENGTH (100-500ms with logarithmic curve)
 // - K6: STUTTER (0-100% - random repetition/glitch probability)
 //
+// TOGGLE 3 MIDDLE - Envelope Mode:
+// - K3: ENVELOPE AMOUNT (0-100% - how far dynamics push count & length)
+// - K4: ENVELOPE ATTACK (1-200ms)
+// - K5: ENVELOPE RELEASE (10-1000ms)
+//
 // TOGGLE 3 DOWN - Lo-Fi Mode:
 // - K3: WOBBLE (0-100% - tape wow/flutter/uni-vibe character)
 // - K4: DUST (0-100% - vinyl crackle density & mix)
 // - K5: BIT CRUSH (0-100% - sample rate reduction)
-// - K6: (Unused - reserved for future expansion)
+// - K6: TAPE SPEED (first third half speed / middle normal / last third double)
 //
 // TOGGLE 1 - Capture/Playback Modes:
 // - UP: Forward capture → Forward playback
 // - MIDDLE: Backward capture → Reverse playback
 // - DOWN: Forward capture → Random playback direction per slice
 //
-// TOGGLE 2 - (Unused - reserved for future expansion)
-// TOGGLE 3 MIDDLE - (Unused - reserved for future expansion)
+// TOGGLE 2 - Envelope Direction:
+// - UP: Louder playing → more, longer slices
+// - MIDDLE: Inverted (louder → fewer, shorter slices)
+// - DOWN: Envelope off
 //
 // FOOTSWITCHES:
 // - FS1 TAP: Toggle bypass on/off
@@ -126,65 +141,46 @@ using namespace daisysp;
 using namespace clevelandmusicco;
 
 // ============================================================================
-// ENVELOPE FOLLOWER CLASS - OPTIONAL FEATURE (CURRENTLY DISABLED)
+// ENVELOPE SYSTEM
 // ============================================================================
-// This envelope follower system is fully implemented but commented out.
-// It would add dynamic control of slice length & count based on playing dynamics.
-// 
-// To enable:
-// 1. Uncomment this class
-// 2. Uncomment envelope-related sections marked "ENVELOPE SYSTEM" below
-// 3. Adds Toggle 2 (envelope direction) and Toggle 3 MIDDLE (envelope parameters)
-//
-/*
-class EnvelopeFollower {
-public:
-    EnvelopeFollower() : envelope_level_(0.0f), samplerate_(48000.0f), 
-                         attack_coeff_(0.0f), release_coeff_(0.0f) {}
-    
-    void Init(float samplerate, float attack_ms, float release_ms) {
-        samplerate_ = samplerate;
-        setAttackRelease(attack_ms, release_ms);
-    }
-    
-    void setAttackRelease(float attack_ms, float release_ms) {
-        attack_coeff_ = 1.0f - expf(-1.0f / (attack_ms * samplerate_ / 1000.0f));
-        release_coeff_ = 1.0f - expf(-1.0f / (release_ms * samplerate_ / 1000.0f));
-    }
-    
-    float Process(float input) {
-        float input_level = fabsf(input);
-        
-        if (input_level > envelope_level_) {
-            envelope_level_ += attack_coeff_ * (input_level - envelope_level_);
-        } else {
-            envelope_level_ += release_coeff_ * (input_level - envelope_level_);
-        }
-        
-        return envelope_level_;
-    }
-    
-    float GetEnvelopeLevel() const { return envelope_level_; }
-    void Reset() { envelope_level_ = 0.0f; }
-
-private:
-    float envelope_level_;
-    float samplerate_;
-    float attack_coeff_;
-    float release_coeff_;
-};
-*/
+// Dynamic control of slice length & count from playing dynamics.
+// Toggle 3 MIDDLE = envelope page (K3 amount, K4 attack, K5 release)
+// Toggle 2 = envelope direction (UP = louder -> more/longer, MIDDLE = inverted,
+// DOWN = off). The follower runs at 1 kHz (ENVELOPE_DECIMATION) and the K5
+// log curve comes from a table, so both cost next to nothing per block.
 
 // ============================================================================
 // CONSTANTS & CONFIGURATION
 // ============================================================================
 
+// SLICE_16BIT=1 (Makefile) stores slices as 16-bit, which fits 1s slices
+// in the SDRAM the 500ms float slices use
+#ifndef AMBIEN_SLICE_16BIT
+#define AMBIEN_SLICE_16BIT 0
+#endif
+
 #define MAX_SLICES 16
+#if AMBIEN_SLICE_16BIT
+#define MAX_SLICE_LENGTH 48000  // 1s @ 48kHz
+typedef int16_t SliceStorage;
+#else
 #define MAX_SLICE_LENGTH 24000  // 500ms @ 48kHz
+typedef float SliceStorage;
+#endif
 
 const float SAMPLE_RATE = 48000.0f;
+const size_t BLOCK_SIZE = 512;
+// The envelope follower steps on the peak of each 48 samples: 1 kHz
+const size_t ENVELOPE_DECIMATION = 48;
+// Block size per boot-time profile (hold both footswitches at power-up);
+// BLOCK_SIZE sizes the buffers
+const Hothouse::AudioProfileTable audio_profiles = {
+    {{128, SaiHandle::Config::SampleRate::SAI_48KHZ},
+     {256, SaiHandle::Config::SampleRate::SAI_48KHZ},
+     {BLOCK_SIZE, SaiHandle::Config::SampleRate::SAI_48KHZ}},
+    Hothouse::AUDIO_PROFILE_MAX_HEADROOM};
 const float MIN_SLICE_LENGTH_MS = 100.0f;
-const float MAX_SLICE_LENGTH_MS = 500.0f;
+const float MAX_SLICE_LENGTH_MS = MAX_SLICE_LENGTH * 1000.0f / SAMPLE_RATE;
 
 // ============================================================================
 // HARDWARE
@@ -198,45 +194,50 @@ Led led1, led2;
 // ============================================================================
 
 // Slice buffer array - stores captured audio slices
-float DSY_SDRAM_BSS sliceBuffers[MAX_SLICES][MAX_SLICE_LENGTH];
+// Carved from the shared SDRAM arena in main() (make SDRAM_ARENA_MB)
+SliceStorage (*sliceBuffers)[MAX_SLICE_LENGTH] = nullptr;
+static_assert(sizeof(SliceStorage) * MAX_SLICES * MAX_SLICE_LENGTH <= kSdramArenaBytes,
+              "slice buffers need a bigger SDRAM arena (SDRAM_ARENA_MB)");
 
-// Slice metadata
-int sliceLengths[MAX_SLICES];
+// Zero-crossing search window for click-free slicing
+const int MAX_ZERO_SEARCH = 1000;
 
-// Capture state
-int currentCaptureSlice = 0;
-int capturePosition = 0;
+// Flux's slicer rules, defined with the stutter system below
+struct FluxSlicePolicy
+{
+    int NextSlice(int current, int count);
+    bool Reverse();
+    int NextCapture(int current, int count);
+    int FadeLength(int length);
+    float FadeShape(float ramp) { return ramp; }  // Linear crossfade
+    float Decay(float volume) { return volume; }  // Slices never decay
+    bool Repeat();
+    void Started();
+    
+    // Stutter state
+    int repeatCount = 0;
+    int targetRepeats = 1;
+};
 
-// Zero-crossing detection for click-free slicing
-bool waitingForZeroCrossing = false;
-float previousCaptureSample = 0.0f;
-bool hasLeftZero = false;
-const int MAX_ZERO_SEARCH = 1000;
-int zeroSearchCount = 0;
+SliceEngine<MAX_SLICES, MAX_SLICE_LENGTH, FluxSlicePolicy, SliceStorage> HOTHOUSE_DTCM_BSS slicer;
 
-// Playback state
-int currentPlaybackSlice = 0;
-int playbackPosition = 0;
-bool hasContent = false;
-bool playbackReverse = false;
+FastRandom rng;  // Audio-path randomness (slice order, direction, stutter)
 
-// Stutter state
-int repeatCount = 0;
-int targetRepeats = 1;
+// Per-block staging between playback, feedback and capture
+float wetBlock[BLOCK_SIZE];
+float captureBlock[BLOCK_SIZE];
+float mixBlock[BLOCK_SIZE];
 
 // ============================================================================
 // DSP MODULES
 // ============================================================================
 
 CrossFade mix;
-OnePole lofi_filter;  // Low-pass filter for lo-fi downsampling
-OnePole dust_filter;  // Low-pass filter to soften dust crackle
-Dust dust;            // Sparse random impulses for vinyl crackle
-DelayLine<float, 4800> wobble_delay;  // 100ms max delay for wobble (@ 48kHz)
-Oscillator wobble_lfo;  // LFO for tape wow/flutter modulation
+CustomBitCrush bitcrush;  // Sample & hold downsampling + low-pass
+SparseDust dust;       // Sparse random impulses for vinyl crackle, 600Hz filtered
+TapeWobble wobble;     // LFO-modulated delay for tape wow/flutter
 
-// ENVELOPE SYSTEM - Uncomment to enable dynamic slice control
-// EnvelopeFollower envelope_follower;
+EnvelopeFollower envelope_follower;  // Input dynamics for T3 MIDDLE slicing
 
 // ============================================================================
 // CONTROL STATE
@@ -257,8 +258,7 @@ float knob_stutter;
 int toggle_mode;  // Toggle 1 - Capture/Playback mode
 int prev_toggle3_pos = 0;  // Track Toggle 3 position changes
 
-// ENVELOPE SYSTEM - Uncomment to enable
-// int toggle2_mode;  // Toggle 2 - Envelope direction (UP/MIDDLE/DOWN)
+int toggle2_mode;  // Toggle 2 - Envelope direction (UP/MIDDLE/DOWN = off)
 
 // Touch detection (BuzzBox pattern)
 float knobValues[6] = {0.0f};
@@ -271,59 +271,23 @@ float master_level;
 float lofi_wobble;
 float lofi_noise;
 float lofi_bitcrush;
+float lofi_speed;
 float lofi_age_mix;
 
-// ENVELOPE SYSTEM - Uncomment to enable
-// float env_amount;    // K3 in envelope mode
-// float env_attack;    // K4 in envelope mode
-// float env_release;   // K5 in envelope mode
-// float envelope_value = 0.0f;
+// Envelope Mode control variables
+float env_amount;    // K3 in envelope mode
+float env_attack;    // K4 in envelope mode
+float env_release;   // K5 in envelope mode
+float envelope_value = 0.5f;
 
 // Processed parameters
 int active_slice_count;
 float slice_length_ms;
 int slice_length_samples;
+float slice_length_source = -1.0f;  // base length slice_length_samples is from
 float slice_length_samples_smooth;
 float feedback_amount;
 
-// ============================================================================
-// LO-FI BIT CRUSHING
-// ============================================================================
-
-// Static variables for sample & hold state
-static float bitcrush_hold_sample = 0.0f;
-static int bitcrush_sample_counter = 0;
-
-float CustomBitCrush(float input, float amount)
-{
-    // If amount is 0, bypass processing completely
-    if (amount <= 0.0f) return input;
-    
-    // Map amount to downsample rate
-    // 0.0 = no downsample (bypassed above)
-    // 1.0 = heavy downsample (32 sample hold)
-    int downsample_rate = 1 + (int)(amount * amount * 31.0f);  // 1 to 32 samples
-    
-    // Set filter cutoff based on effective sample rate - MORE AGGRESSIVE
-    // Nyquist frequency = (48000 / downsample_rate) / 2
-    float effective_nyquist = (48000.0f / (float)downsample_rate) / 2.0f;
-    float cutoff = effective_nyquist * 0.5f;  // 50% of Nyquist for aggressive lo-fi character
-    if (cutoff > 18000.0f) cutoff = 18000.0f;
-    if (cutoff < 500.0f) cutoff = 500.0f;
-    lofi_filter.SetFrequency(cutoff);
-    
-    // Only update held sample at downsample rate
-    if (bitcrush_sample_counter >= downsample_rate) {
-        bitcrush_sample_counter = 0;
-        bitcrush_hold_sample = input;
-    }
-    
-    bitcrush_sample_counter++;
-    
-    // Apply low-pass filter to remove aliasing artifacts
-    return lofi_filter.Process(bitcrush_hold_sample);
-}
-
 // ============================================================================
 // CONTROL PROCESSING
 // ============================================================================
@@ -340,12 +304,18 @@ void UpdateControls()
     knobValues[4] = hw.GetKnobValue(Hothouse::KNOB_5);
     knobValues[5] = hw.GetKnobValue(Hothouse::KNOB_6);
     
-    // Detect knob movement for K3-K6 (BuzzBox pattern)
+    // Detect knob movement for K3-K6 (BuzzBox pattern). A touched knob's
+    // parameter then follows it only when the scan flags it as moved, so a
+    // resting knob's jitter doesn't rework what it feeds every block
+    bool knob_update[6] = {};
     for(int i = 2; i < 6; i++) {
         if (fabsf(knobValues[i] - knob_prev[i]) > KNOB_TOUCH_THRESHOLD) {
+            knob_update[i] = !knob_touched[i];
             knob_touched[i] = true;
             knob_prev[i] = knobValues[i];
         }
+        knob_update[i] = knob_update[i] ||
+                         (knob_touched[i] && hw.KnobChanged(static_cast<Hothouse::Knob>(i)));
     }
     
     // Check Toggle 3 position (0=Normal, 1=Envelope, 2=Lo-Fi)
@@ -356,10 +326,10 @@ void UpdateControls()
         prev_toggle3_pos = toggle3_pos;
         
         // Reset touch flags for K3-K6 so parameters don't jump on mode switch
-        knob_touched[2] = false;
-        knob_touched[3] = false;
-        knob_touched[4] = false;
-        knob_touched[5] = false;
+        knob_touched[2] = knob_update[2] = false;
+        knob_touched[3] = knob_update[3] = false;
+        knob_touched[4] = knob_update[4] = false;
+        knob_touched[5] = knob_update[5] = false;
         
         // Capture current knob positions so we can detect movement from here
         knob_prev[2] = knobValues[2];
@@ -373,8 +343,8 @@ void UpdateControls()
     // Read Toggle 1 for capture/playback mode
     toggle_mode = hw.GetToggleswitchPosition(Hothouse::TOGGLESWITCH_1);
     
-    // ENVELOPE SYSTEM - Uncomment to enable
-    // toggle2_mode = hw.GetToggleswitchPosition(Hothouse::TOGGLESWITCH_2);
+    // Read Toggle 2 for envelope direction
+    toggle2_mode = hw.GetToggleswitchPosition(Hothouse::TOGGLESWITCH_2);
     
     // Map controls based on shift mode
     float k1 = knobValues[0];
@@ -388,30 +358,27 @@ void UpdateControls()
     master_level = k1 * 2.0f;  // 0.0 - 2.0 (0dB to +6dB)
     knob_mix = k2;
     
-    // Toggle 3: UP = Normal Mode, DOWN = Lo-Fi Mode
+    // Toggle 3: UP = Normal Mode, MIDDLE = Envelope Mode, DOWN = Lo-Fi Mode
     if (shift_mode == 0) {
         // NORMAL MODE - Core slicing parameters
-        if (knob_touched[2]) knob_feedback = k3;
-        if (knob_touched[3]) knob_slice_count = k4;
-        if (knob_touched[4]) knob_slice_length = k5;
-        if (knob_touched[5]) knob_stutter = k6;
+        if (knob_update[2]) knob_feedback = k3;
+        if (knob_update[3]) knob_slice_count = k4;
+        if (knob_update[4]) knob_slice_length = k5;
+        if (knob_update[5]) knob_stutter = k6;
+        
+    } else if (shift_mode == 1) {
+        // ENVELOPE MODE - Dynamic control parameters
+        if (knob_update[2]) env_amount = k3;
+        if (knob_update[3]) env_attack = k4;
+        if (knob_update[4]) env_release = k5;
         
     } else {
         // LO-FI MODE - Degradation effects
-        if (knob_touched[2]) lofi_wobble = k3;
-        if (knob_touched[3]) lofi_noise = k4;
-        if (knob_touched[4]) lofi_bitcrush = k5;
+        if (knob_update[2]) lofi_wobble = k3;
+        if (knob_update[3]) lofi_noise = k4;
+        if (knob_update[4]) lofi_bitcrush = k5;
+        if (knob_update[5]) lofi_speed = k6;
     }
-    
-    // ENVELOPE SYSTEM - Uncomment to enable Toggle 3 MIDDLE mode
-    /*
-    else if (shift_mode == 1) {
-        // ENVELOPE MODE - Dynamic control parameters
-        if (knob_touched[2]) env_amount = k3;
-        if (knob_touched[3]) env_attack = k4;
-        if (knob_touched[4]) env_release = k5;
-    }
-    */
 }
 
 void UpdateButtons()
@@ -430,13 +397,10 @@ void UpdateButtons()
 void UpdateLEDs()
 {
     // LED1 - Effect active
-    led1.Set(bypass ? 0.0f : 1.0f);
+    hw.SetLed(Hothouse::LED_1, bypass ? 0.0f : 1.0f);
     
     // LED2 - Freeze indicator
-    led2.Set(is_frozen ? 1.0f : 0.0f);
-    
-    led1.Update();
-    led2.Update();
+    hw.SetLed(Hothouse::LED_2, hw.LoadLed(is_frozen ? 1.0f : 0.0f));
 }
 
 void ProcessParameters()
@@ -444,8 +408,7 @@ void ProcessParameters()
     float base_slice_count = knob_slice_count;
     float base_slice_length = knob_slice_length;
     
-    // ENVELOPE SYSTEM - Uncomment to enable dynamic modulation
-    /*
+    // Envelope modulation (Toggle 2 UP/MIDDLE, K3 in envelope mode)
     if (toggle2_mode != 2 && env_amount > 0.01f) {
         float env_mod = envelope_value;
         if (toggle2_mode == 1) env_mod = 1.0f - env_mod;
@@ -460,28 +423,36 @@ void ProcessParameters()
         if (base_slice_length < 0.0f) base_slice_length = 0.0f;
         if (base_slice_length > 1.0f) base_slice_length = 1.0f;
     }
-    */
-    
-    // Map K4 to slice count (1-16)
-    active_slice_count = (int)(base_slice_count * 15.999f) + 1;
     
     // Map K4 to slice count (1-16)
     active_slice_count = (int)(base_slice_count * 15.999f) + 1;
     if (active_slice_count < 1) active_slice_count = 1;
     if (active_slice_count > MAX_SLICES) active_slice_count = MAX_SLICES;
-    
-    // Map K5 to slice length (100-500ms) with logarithmic curve
-    float log_knob = logf(1.0f + 9.0f * base_slice_length) / logf(10.0f);
-    slice_length_ms = MIN_SLICE_LENGTH_MS + 
-                      (log_knob * (MAX_SLICE_LENGTH_MS - MIN_SLICE_LENGTH_MS));
-    
-    slice_length_samples = (int)((slice_length_ms / 1000.0f) * SAMPLE_RATE);
-    
-    if (slice_length_samples < 1) slice_length_samples = 1;
-    if (slice_length_samples > MAX_SLICE_LENGTH) slice_length_samples = MAX_SLICE_LENGTH;
+    slicer.SetSliceCount(active_slice_count);
+    
+    // Map K5 to slice length (100-500ms) with logarithmic curve, when K5 or
+    // the envelope has moved it
+    if (base_slice_length != slice_length_source) {
+        slice_length_source = base_slice_length;
+        float log_knob = KnobLog(base_slice_length);
+        slice_length_ms = MIN_SLICE_LENGTH_MS + 
+                          (log_knob * (MAX_SLICE_LENGTH_MS - MIN_SLICE_LENGTH_MS));
+        
+        slice_length_samples = (int)((slice_length_ms / 1000.0f) * SAMPLE_RATE);
+        
+        if (slice_length_samples < 1) slice_length_samples = 1;
+        if (slice_length_samples > MAX_SLICE_LENGTH) slice_length_samples = MAX_SLICE_LENGTH;
+    }
     
     // Map K3 to feedback
     feedback_amount = knob_feedback;
+    
+    // Map Lo-Fi K6 to tape speed: an octave down, normal or an octave up,
+    // with the wide middle third so normal is easy to find by hand
+    float speed = 1.0f;
+    if (lofi_speed < 0.333f) speed = 0.5f;
+    else if (lofi_speed > 0.667f) speed = 2.0f;
+    slicer.SetRate(speed);
 }
 
 // ============================================================================
@@ -496,8 +467,8 @@ int CalculateRepeatCount(float stutter_knob)
     
     float shuffle_probability = stutter_knob;
     
-    if ((rand() % 100) < (int)(shuffle_probability * 100.0f)) {
-        int subdivision_choice = rand() % 100;
+    if (rng.Below(100) < (int)(shuffle_probability * 100.0f)) {
+        int subdivision_choice = rng.Below(100);
         
         if (subdivision_choice < 40) {
             return 2;
@@ -513,238 +484,84 @@ int CalculateRepeatCount(float stutter_knob)
     return 1;
 }
 
-int GetNextSlice(int currentSlice, int sliceCount, float stutterKnob, int toggleMode, bool& reverseFlag)
+// ============================================================================
+// SLICE ORDER & CROSSFADE
+// ============================================================================
+
+int FluxSlicePolicy::NextSlice(int current, int count)
 {
     int nextSlice;
     
-    if (toggleMode == 2) {
-        nextSlice = rand() % sliceCount;
-        reverseFlag = (rand() % 2) == 0;
-    } else if (toggleMode == 1) {
-        nextSlice = currentSlice - 1;
+    if (toggle_mode == 2) {
+        nextSlice = rng.Below(count);
+    } else if (toggle_mode == 1) {
+        nextSlice = current - 1;
         if (nextSlice < 0) {
-            nextSlice = sliceCount - 1;
+            nextSlice = count - 1;
         }
-        reverseFlag = true;
     } else {
-        nextSlice = currentSlice + 1;
-        if (nextSlice >= sliceCount) {
+        nextSlice = current + 1;
+        if (nextSlice >= count) {
             nextSlice = 0;
         }
-        reverseFlag = false;
     }
     
     return nextSlice;
 }
 
-// ============================================================================
-// SLICE CAPTURE ENGINE
-// ============================================================================
-
-void InitializeSliceBuffers()
+bool FluxSlicePolicy::Reverse()
 {
-    for (int slice = 0; slice < MAX_SLICES; slice++) {
-        sliceLengths[slice] = 0;
-        for (int sample = 0; sample < MAX_SLICE_LENGTH; sample++) {
-            sliceBuffers[slice][sample] = 0.0f;
-        }
+    if (toggle_mode == 2) {
+        return rng.Coin();
+    } else if (toggle_mode == 1) {
+        return true;
     }
-    
-    currentCaptureSlice = 0;
-    currentPlaybackSlice = 0;
-    capturePosition = 0;
-    playbackPosition = 0;
-    hasContent = false;
-    playbackReverse = false;
-    
-    waitingForZeroCrossing = false;
-    previousCaptureSample = 0.0f;
-    hasLeftZero = false;
-    zeroSearchCount = 0;
+    return false;
 }
 
-void CaptureSlice(float input)
+int FluxSlicePolicy::NextCapture(int current, int count)
 {
-    // Skip capture if frozen - keeps current buffer contents
-    if (is_frozen) {
-        return;
+    if (toggle_mode == 2) {
+        return rng.Below(count);
     }
     
-    if (fabsf(input) > 0.01f) {
-        hasLeftZero = true;
-    }
-    
-    bool zeroCrossing = false;
-    if (hasLeftZero && 
-        ((previousCaptureSample > 0.0f && input <= 0.0f) ||
-         (previousCaptureSample < 0.0f && input >= 0.0f))) {
-        zeroCrossing = true;
-    }
-    
-    sliceBuffers[currentCaptureSlice][capturePosition] = input;
-    capturePosition++;
-    
-    previousCaptureSample = input;
-    
-    bool shouldFinalize = false;
-    
-    if (waitingForZeroCrossing) {
-        zeroSearchCount++;
-        
-        if (zeroCrossing) {
-            shouldFinalize = true;
-        } else if (zeroSearchCount >= MAX_ZERO_SEARCH) {
-            shouldFinalize = true;
-        } else if (capturePosition >= MAX_SLICE_LENGTH - 1) {
-            shouldFinalize = true;
-        }
-    } else if (capturePosition >= (int)slice_length_samples_smooth) {
-        waitingForZeroCrossing = true;
-        zeroSearchCount = 0;
-        hasLeftZero = false;
+    current++;
+    if (current >= count) {
+        current = 0;
     }
+    return current;
+}
+
+int FluxSlicePolicy::FadeLength(int length)
+{
+    // Variable crossfade: 15% of the slice, 5ms minimum
+    int fadeLength = length * 15 / 100;
+    if (fadeLength < 240) fadeLength = 240;
     
-    if (shouldFinalize) {
-        sliceLengths[currentCaptureSlice] = capturePosition;
-        
-        if (!hasContent) {
-            hasContent = true;
-            currentPlaybackSlice = currentCaptureSlice;
-            playbackPosition = 0;
-            repeatCount = 0;
-            targetRepeats = CalculateRepeatCount(knob_stutter);
-            
-            if (toggle_mode == 2) {
-                playbackReverse = (rand() % 2) == 0;
-            } else if (toggle_mode == 1) {
-                playbackReverse = true;
-            } else {
-                playbackReverse = false;
-            }
-        }
-        
-        if (toggle_mode == 2) {
-            currentCaptureSlice = rand() % active_slice_count;
-        } else {
-            currentCaptureSlice++;
-            if (currentCaptureSlice >= active_slice_count) {
-                currentCaptureSlice = 0;
-            }
-        }
-        
-        capturePosition = 0;
-        waitingForZeroCrossing = false;
-        zeroSearchCount = 0;
-        hasLeftZero = false;
-        previousCaptureSample = 0.0f;
+    if (fadeLength * 2 > length) {
+        fadeLength = length / 3;
+        if (fadeLength < 1) fadeLength = 1;
     }
+    return fadeLength;
 }
 
-// ============================================================================
-// SLICE PLAYBACK ENGINE
-// ============================================================================
+bool FluxSlicePolicy::Repeat()
+{
+    repeatCount++;
+    return repeatCount < targetRepeats;
+}
 
-float PlaybackSlice()
+void FluxSlicePolicy::Started()
 {
-    if (!hasContent) {
-        return 0.0f;
-    }
-    
-    if (currentPlaybackSlice == currentCaptureSlice) {
-        currentPlaybackSlice = GetNextSlice(currentPlaybackSlice, active_slice_count, knob_stutter, toggle_mode, playbackReverse);
-        playbackPosition = 0;
-        repeatCount = 0;
-        targetRepeats = CalculateRepeatCount(knob_stutter);
-    }
-    
-    if (sliceLengths[currentPlaybackSlice] == 0) {
-        return 0.0f;
-    }
-    
-    int readPosition;
-    if (playbackReverse) {
-        int sliceLen = sliceLengths[currentPlaybackSlice];
-        if (playbackPosition < sliceLen) {
-            readPosition = sliceLen - 1 - playbackPosition;
-        } else {
-            readPosition = 0;
-        }
-    } else {
-        readPosition = playbackPosition;
-    }
-    
-    if (readPosition < 0 || readPosition >= sliceLengths[currentPlaybackSlice]) {
-        readPosition = 0;
-    }
-    
-    float output = sliceBuffers[currentPlaybackSlice][readPosition];
-    
-    // Variable crossfade
-    static int lastPlayedSlice = -1;
-    static int fadeLength = 0;
-    
-    bool sliceChanged = (currentPlaybackSlice != lastPlayedSlice) || (playbackPosition == 0);
-    if (sliceChanged) {
-        lastPlayedSlice = currentPlaybackSlice;
-        int currentSliceLen = sliceLengths[currentPlaybackSlice];
-        fadeLength = currentSliceLen * 15 / 100;
-        if (fadeLength < 240) fadeLength = 240;
-        
-        if (fadeLength * 2 > currentSliceLen) {
-            fadeLength = currentSliceLen / 3;
-            if (fadeLength < 1) fadeLength = 1;
-        }
-    }
-    
-    float fadeEnvelope = 1.0f;
-    int currentSliceLen = sliceLengths[currentPlaybackSlice];
-    
-    if (playbackPosition < fadeLength) {
-        fadeEnvelope = (float)playbackPosition / (float)fadeLength;
-    }
-    
-    int fadeOutStart = currentSliceLen - fadeLength;
-    if (fadeOutStart > 0 && playbackPosition >= fadeOutStart) {
-        int fadeOutPos = playbackPosition - fadeOutStart;
-        float fadeOutEnvelope = 1.0f - ((float)fadeOutPos / (float)fadeLength);
-        if (fadeOutEnvelope < fadeEnvelope) {
-            fadeEnvelope = fadeOutEnvelope;
-        }
-    }
-    
-    output *= fadeEnvelope;
-    
-    playbackPosition++;
-    
-    if (playbackPosition >= sliceLengths[currentPlaybackSlice]) {
-        repeatCount++;
-        playbackPosition = 0;
-        
-        if (repeatCount >= targetRepeats) {
-            int nextSlice = GetNextSlice(currentPlaybackSlice, active_slice_count, knob_stutter, toggle_mode, playbackReverse);
-            
-            if (nextSlice == currentCaptureSlice) {
-                nextSlice = GetNextSlice(nextSlice, active_slice_count, knob_stutter, toggle_mode, playbackReverse);
-            }
-            
-            if (sliceLengths[nextSlice] > 0) {
-                currentPlaybackSlice = nextSlice;
-                playbackPosition = 0;
-            }
-            
-            repeatCount = 0;
-            targetRepeats = CalculateRepeatCount(knob_stutter);
-        }
-    }
-    
-    return output;
+    repeatCount = 0;
+    targetRepeats = CalculateRepeatCount(knob_stutter);
 }
 
 // ============================================================================
 // AUDIO CALLBACK
 // ============================================================================
 
-static void AudioCallback(AudioHandle::InputBuffer in,
+HOTHOUSE_ITCM static void AudioCallback(AudioHandle::InputBuffer in,
                           AudioHandle::OutputBuffer out,
                           size_t size)
 {
@@ -752,96 +569,92 @@ static void AudioCallback(AudioHandle::InputBuffer in,
     UpdateButtons();
     UpdateLEDs();
     ProcessParameters();
+
+    // Full CPU clock back before any DSP (make POWER_SAVE=1)
+    hw.SetBypassed(bypass);
+    if (!bypass) {
+        // Read a block from the playback engine
+        slicer.Playback(wetBlock, size);
+    }
+    
+    if (!bypass) {
+        // Apply lo-fi bit crushing to input BEFORE capture
+        // This affects what gets captured into slices (vintage sampler aesthetic)
+        // When lofi_bitcrush = 0, CustomBitCrush returns input unchanged
+        bitcrush.SetAmount(lofi_bitcrush);
+        bitcrush.Process(in[0], captureBlock, size);
+    }
     
     for (size_t i = 0; i < size; i++)
     {
         fonepole(slice_length_samples_smooth, (float)slice_length_samples, 0.0002f);
         
+        if (!bypass) {
+            // Apply feedback using processed input
+            captureBlock[i] += wetBlock[i] * feedback_amount;
+        }
+    }
+    
+    // Capture with feedback applied
+    // Skip capture if frozen - keeps current buffer contents
+    if (!bypass && !is_frozen) {
+        slicer.SetTargetLength((int)slice_length_samples_smooth);
+        slicer.Capture(captureBlock, size);
+    }
+    
+    // Follow the input at control rate; the slice parameters pick this
+    // up at the next block
+    if (toggle2_mode != 2) {
+        float attack_time = 1.0f + (env_attack * 199.0f);
+        float release_time = 10.0f + (env_release * 990.0f);
+        envelope_follower.SetAttackRelease(attack_time, release_time);
+        envelope_follower.ProcessBlock(in[0], size);
+        envelope_value = envelope_follower.GetEnvelopeLevel();
+    } else {
+        envelope_value = 0.5f;
+    }
+    
+    for (size_t i = 0; i < size; i++)
+    {
         float input = in[0][i];
         float dry_input = input;
         
-        // ENVELOPE SYSTEM - Uncomment to enable
-        /*
-        if (toggle2_mode != 2) {
-            float attack_time = 1.0f + (env_attack * 199.0f);
-            float release_time = 10.0f + (env_release * 990.0f);
-            envelope_follower.setAttackRelease(attack_time, release_time);
-            envelope_value = envelope_follower.Process(input);
-        } else {
-            envelope_value = 0.5f;
+        if (!bypass) {
+            float wet = wetBlock[i];
+            
+            // Dry/wet mix using CLEAN dry signal and processed wet
+            mix.SetPos(knob_mix);
+            mixBlock[i] = mix.Process(dry_input, wet);
         }
-        */
+    }
+    
+    // Apply wobble AFTER mix (tape wow/flutter / uni-vibe character)
+    // Wobble runs whenever lofi_wobble > 0 AND mix > 0
+    // Creates pitch modulation via LFO-modulated delay
+    if (!bypass && lofi_wobble > 0.0f && knob_mix > 0.01f) {
+        wobble.Process(mixBlock, size, lofi_wobble);
+    }
+    
+    // Apply dust AFTER wobble, BEFORE master level (vinyl-on-top aesthetic)
+    // Dust runs whenever lofi_noise > 0 AND mix > 0, regardless of toggle position
+    // This way dust only appears on the wet signal - dry signal stays completely clean
+    if (!bypass && lofi_noise > 0.0f && knob_mix > 0.01f) {
+        // Very conservative density: 0-2% range with progressive curve
+        float density = lofi_noise * lofi_noise * 0.02f;  // Squared curve, max 2%
+        dust.SetDensity(density);
         
+        // Progressive mix: starts very subtle, ramps up
+        float mix_amount = lofi_noise * lofi_noise * 0.05f;  // Max 5% mix
+        dust.Process(mixBlock, size, mix_amount);
+    }
+    
+    for (size_t i = 0; i < size; i++)
+    {
+        float input = in[0][i];
         float output;
         
         if (!bypass) {
-            // Apply lo-fi bit crushing to input BEFORE capture
-            // This affects what gets captured into slices (vintage sampler aesthetic)
-            // When lofi_bitcrush = 0, CustomBitCrush returns input unchanged
-            float processed_input = CustomBitCrush(input, lofi_bitcrush);
-            
-            // Read from playback engine
-            float wet = PlaybackSlice();
-            
-            // Apply feedback using processed input
-            float capture_input = processed_input + (wet * feedback_amount);
-            
-            // Capture with feedback applied
-            CaptureSlice(capture_input);
-            
-            // Dry/wet mix using CLEAN dry signal and processed wet
-            mix.SetPos(knob_mix);
-            output = mix.Process(dry_input, wet);
-            
-            // Apply wobble AFTER mix (tape wow/flutter / uni-vibe character)
-            // Wobble runs whenever lofi_wobble > 0 AND mix > 0
-            // Creates pitch modulation via LFO-modulated delay
-            if (lofi_wobble > 0.0f && knob_mix > 0.01f) {
-                // LFO rate: 0.5Hz to 6Hz with curve for musical control
-                // Low settings = slow tape drift, high settings = vibrato/uni-vibe
-                float lfo_rate = 0.5f + (lofi_wobble * lofi_wobble * 5.5f);  // 0.5Hz to 6Hz
-                wobble_lfo.SetFreq(lfo_rate);
-                
-                // Get LFO value (-1.0 to 1.0)
-                float lfo_value = wobble_lfo.Process();
-                
-                // Map to delay time: 2ms to 8ms range for noticeable pitch movement
-                // Progressive depth - more wobble at higher settings
-                float delay_depth_ms = 2.0f + (lofi_wobble * 6.0f);  // 2ms to 8ms
-                float center_delay_ms = 5.0f;  // Center point
-                float delay_time_ms = center_delay_ms + (lfo_value * delay_depth_ms * 0.5f);
-                
-                // Convert to samples
-                float delay_samples = (delay_time_ms / 1000.0f) * SAMPLE_RATE;
-                wobble_delay.SetDelay(delay_samples);
-                
-                // Write current output to delay
-                wobble_delay.Write(output);
-                
-                // Read modulated signal
-                float wobbled = wobble_delay.Read();
-                
-                // Reduced maximum mix for more usable knob range
-                // Max 50% wet instead of 100% - keeps more of the original character
-                float wobble_mix = lofi_wobble * lofi_wobble * 0.5f;  // Max 50% at full knob
-                output = output * (1.0f - wobble_mix) + wobbled * wobble_mix;
-            }
-            
-            // Apply dust AFTER wobble, BEFORE master level (vinyl-on-top aesthetic)
-            // Dust runs whenever lofi_noise > 0 AND mix > 0, regardless of toggle position
-            // This way dust only appears on the wet signal - dry signal stays completely clean
-            if (lofi_noise > 0.0f && knob_mix > 0.01f) {
-                // Very conservative density: 0-2% range with progressive curve
-                float density = lofi_noise * lofi_noise * 0.02f;  // Squared curve, max 2%
-                dust.SetDensity(density);
-                
-                float dust_signal = dust.Process();  // 0.0 to 1.0, sparse impulses
-                dust_signal = dust_filter.Process(dust_signal);  // 600Hz filter for warmth
-                
-                // Progressive mix: starts very subtle, ramps up
-                float mix_amount = lofi_noise * lofi_noise * 0.05f;  // Max 5% mix
-                output += (dust_signal - 0.5f) * mix_amount;
-            }
+            output = mixBlock[i];
             
             // Apply master level (controls everything: mix + dust)
             output *= master_level;
@@ -863,34 +676,28 @@ int main(void)
 {
     hw.Init(true);
     
-    srand(System::GetNow());
+    rng.Seed(System::GetNow());
+    dust.Seed(System::GetNow() ^ 0x9e3779b9u);
     
-    hw.SetAudioBlockSize(512);
+    hw.SelectAudioProfile(audio_profiles);
     
-    InitializeSliceBuffers();
+    sliceBuffers = sdramArena.Carve<SliceStorage[MAX_SLICE_LENGTH]>(MAX_SLICES);
+    slicer.Init(sliceBuffers);
+    slicer.SetSearchWindow(MAX_ZERO_SEARCH);
     
     mix.Init();
     
-    // Initialize lo-fi filter
-    lofi_filter.Init();
-    lofi_filter.SetFrequency(8000.0f);
-    
-    // Initialize dust filter (very low frequency for warm vinyl character)
-    dust_filter.Init();
-    dust_filter.SetFrequency(600.0f);  // Warm vinyl character
+    // Initialize lo-fi crusher and its filter
+    bitcrush.Init();
     
-    // Initialize dust for lo-fi crackle
+    // Initialize dust for lo-fi crackle (and its warm 600Hz filter)
     dust.Init();
     
     // Initialize wobble effect
-    wobble_delay.Init();
-    wobble_lfo.Init(SAMPLE_RATE);
-    wobble_lfo.SetWaveform(Oscillator::WAVE_SIN);  // Smooth sine wave for natural tape flutter
-    wobble_lfo.SetFreq(1.0f);  // Default 1Hz
-    wobble_lfo.SetAmp(1.0f);
+    wobble.Init(SAMPLE_RATE);
     
-    // ENVELOPE SYSTEM - Uncomment to enable
-    // envelope_follower.Init(SAMPLE_RATE, 50.0f, 100.0f);
+    // Initialize envelope follower
+    envelope_follower.Init(SAMPLE_RATE, 50.0f, 100.0f, ENVELOPE_DECIMATION);
     
     bypass = true;
     is_frozen = false;
@@ -903,8 +710,10 @@ int main(void)
     knob_stutter = 0.0f;
     toggle_mode = 0;
     
-    // ENVELOPE SYSTEM - Uncomment to enable
-    // toggle2_mode = 2;
+    toggle2_mode = 2;
+    env_amount = 0.0f;
+    env_attack = 0.25f;
+    env_release = 0.1f;
     
     // Initialize touch detection
     for (int i = 0; i < 6; i++) {
@@ -916,13 +725,12 @@ int main(void)
     lofi_wobble = 0.0f;
     lofi_noise = 0.0f;
     lofi_bitcrush = 0.0f;
+    lofi_speed = 0.5f;     // Normal speed
     lofi_age_mix = 0.0f;
     
     ProcessParameters();
     slice_length_samples_smooth = (float)slice_length_samples;
-    
-    repeatCount = 0;
-    targetRepeats = 1;
+    hw.BootMark("DSP");
     
     led1.Init(hw.seed.GetPin(Hothouse::LED_1), false);
     led2.Init(hw.seed.GetPin(Hothouse::LED_2), false);
@@ -930,16 +738,39 @@ int main(void)
     led2.Set(0.0f);
     led1.Update();
     led2.Update();
+    hw.StartLedService();
     
     hw.StartAdc();
     hw.StartAudio(AudioCallback);
     
     while(1)
     {
+        // CPU load over USB serial (make LOAD_METER=1)
+        hw.ServiceLoadMeter();
+        // Callback overruns over USB serial and into QSPI (make WATCHDOG=1)
+        hw.ServiceWatchdog();
+        // Time to each boot phase over USB serial (make BOOT_TIMING=1)
+        hw.ServiceBootTiming();
+        // Heap allocations inside the audio callback over USB serial (make ALLOC_CHECK=1)
+        hw.ServiceAllocCheck();
+        // Stack and heap high-water marks over USB serial (make MEMORY_REPORT=1)
+        hw.ServiceMemoryReport();
+        // Subnormals and NaNs in the audio callback (make DENORMAL_CHECK=1)
+        hw.ServiceDenormalCheck();
+        // Half the CPU clock after 5 s in bypass (make POWER_SAVE=1)
+        hw.ServicePower();
+        // Signal probes armed and dumped over USB serial (make PROBE=1)
+        hw.ServiceProbes();
+        // Round-trip latency through a loopback cable (make LATENCY_TEST=1)
+        hw.ServiceLatencyTest();
+        // The reports above as binary records over USB serial (make TELEMETRY=1)
+        hw.ServiceTelemetry();
+
         if(hw.switches[Hothouse::FOOTSWITCH_1].TimeHeldMs() >= 2000)
         {
             hw.StopAudio();
             hw.StopAdc();
+            hw.StopLedService();
             
             for(int i = 0; i < 3; i++) 
             {
@@ -959,6 +790,6 @@ int main(void)
             System::ResetToBootloader();
         }
         
-        System::Delay(100);
+        hw.IdleMs(100);
     }
 }
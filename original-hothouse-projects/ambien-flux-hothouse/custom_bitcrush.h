@@ -0,0 +1,106 @@
+// Custom Bit Crush
+// Sample-and-hold downsampler + low-pass for Flux's lo-fi page
+// (DaisySP's Decimator/Bitcrush is unreliable, see CLAUDE.md)
+
+#pragma once
+#ifndef CUSTOM_BITCRUSH_H
+#define CUSTOM_BITCRUSH_H
+
+#include <stddef.h>
+#include "daisysp.h"
+
+class CustomBitCrush
+{
+  public:
+    CustomBitCrush() {}
+    ~CustomBitCrush() {}
+
+    void Init()
+    {
+        filter_.Init();
+        filter_.SetFrequency(8000.0f);
+        amount_ = 0.0f;
+        downsample_rate_ = 0;
+        hold_sample_ = 0.0f;
+        sample_counter_ = 0;
+    }
+
+    /** Crush amount 0-1; call once per block. The filter is only
+        retuned when the quantised hold length actually changes. */
+    void SetAmount(float amount)
+    {
+        amount_ = amount;
+
+        // If amount is 0, bypass processing completely
+        if (amount <= 0.0f) return;
+
+        // Map amount to downsample rate
+        // 0.0 = no downsample (bypassed above)
+        // 1.0 = heavy downsample (32 sample hold)
+        int downsample_rate = 1 + (int)(amount * amount * 31.0f);  // 1 to 32 samples
+        if (downsample_rate == downsample_rate_) return;
+        downsample_rate_ = downsample_rate;
+
+        // Set filter cutoff based on effective sample rate - MORE AGGRESSIVE
+        // Nyquist frequency = (48000 / downsample_rate) / 2
+        float effective_nyquist = (48000.0f / (float)downsample_rate) / 2.0f;
+        float cutoff = effective_nyquist * 0.5f;  // 50% of Nyquist for aggressive lo-fi character
+        if (cutoff > 18000.0f) cutoff = 18000.0f;
+        if (cutoff < 500.0f) cutoff = 500.0f;
+        filter_.SetFrequency(cutoff);
+    }
+
+    float Process(float input)
+    {
+        if (amount_ <= 0.0f) return input;
+
+        // Only update held sample at downsample rate
+        if (sample_counter_ >= downsample_rate_) {
+            sample_counter_ = 0;
+            hold_sample_ = input;
+        }
+
+        sample_counter_++;
+
+        // Apply low-pass filter to remove aliasing artifacts
+        return filter_.Process(hold_sample_);
+    }
+
+    /** Crush a block; each held value is emitted as one run */
+    void Process(const float* in, float* out, size_t size)
+    {
+        if (amount_ <= 0.0f) {
+            for (size_t i = 0; i < size; i++) {
+                out[i] = in[i];
+            }
+            return;
+        }
+
+        size_t i = 0;
+        while (i < size) {
+            if (sample_counter_ >= downsample_rate_) {
+                sample_counter_ = 0;
+                hold_sample_ = in[i];
+            }
+
+            size_t run = (size_t)(downsample_rate_ - sample_counter_);
+            if (run > size - i) run = size - i;
+
+            for (size_t k = 0; k < run; k++) {
+                out[i + k] = filter_.Process(hold_sample_);
+            }
+
+            sample_counter_ += (int)run;
+            i += run;
+        }
+    }
+
+  private:
+    daisysp::OnePole filter_;  // Low-pass filter for lo-fi downsampling
+    float amount_ = 0.0f;
+    int downsample_rate_ = 0;
+    float hold_sample_ = 0.0f;
+    int sample_counter_ = 0;
+};
+
+#endif  // CUSTOM_BITCRUSH_H
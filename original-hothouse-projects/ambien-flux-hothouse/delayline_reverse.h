@@ -10,9 +10,14 @@
 #include <stdint.h>
 #include <math.h>
 
+#include "hothouse_ring.h"
+
+// max_size must be a power of two: the line is a clevelandmusicco::RingBuffer
 template <typename T, size_t max_size>
 class DelayLineReverse
 {
+    typedef clevelandmusicco::RingBuffer<T, max_size> Line;
+
   public:
     DelayLineReverse() {}
     ~DelayLineReverse() {}
@@ -29,12 +34,7 @@ class DelayLineReverse
         delay_ = 2400;      // Min reverse delay time
         fadetime_ = 2300;   // Crossfade time in samples
         
-        for(size_t i = 0; i < max_size; i++)
-        {
-            line_[i] = T(0);
-        }
-        
-        write_ptr_ = 0;
+        line_.Clear();
         read_ptr1_ = 0;
         read_ptr2_ = 0;
         head_diff_ = 0;
@@ -61,17 +61,16 @@ class DelayLineReverse
     /** Write sample to delay line */
     inline void Write(const T sample)
     {
-        line_[write_ptr_] = sample;
-        
-        // Advance write pointer forward
-        write_ptr_ = (write_ptr_ + 1) % max_size;
+        // Advances the write pointer forward
+        line_.Write(sample);
         
-        // Increment head difference
-        head_diff_ = (head_diff_ + 1) % delay_;
+        // Increment head difference (the divide only if SetDelay() shortened
+        // the delay past it)
+        head_diff_ = head_diff_ + 1 < delay_ ? head_diff_ + 1 : (head_diff_ + 1) % delay_;
         
         // Advance read pointers backward
-        read_ptr1_ = (read_ptr1_ - 1 + max_size) % max_size;
-        read_ptr2_ = (read_ptr2_ - 1 + max_size) % max_size;
+        read_ptr1_ = Line::Wrap(read_ptr1_ - 1);
+        read_ptr2_ = Line::Wrap(read_ptr2_ - 1);
         
         // Check if we need to start crossfading
         if (head_diff_ > (delay_ - fadetime_ - 1))
@@ -83,12 +82,12 @@ class DelayLineReverse
                 if(!playing_head_) 
                 {
                     // Jump ptr2 to position near write pointer
-                    read_ptr2_ = (write_ptr_ - 1 + max_size) % max_size;
+                    read_ptr2_ = Line::Wrap(line_.WritePos() - 1);
                 }
                 else
                 {
                     // Jump ptr1 to position near write pointer
-                    read_ptr1_ = (write_ptr_ - 1 + max_size) % max_size;
+                    read_ptr1_ = Line::Wrap(line_.WritePos() - 1);
                 }
             }
         }
@@ -136,12 +135,11 @@ class DelayLineReverse
 
   private:
     float  frac_;
-    size_t write_ptr_;
     size_t read_ptr1_;
     size_t read_ptr2_;
     size_t delay_;
     size_t head_diff_;
-    T      line_[max_size];
+    Line   line_;
     size_t fadetime_;
     bool   playing_head_;
     float  fade_pos_;
@@ -0,0 +1,99 @@
+// Sparse Dust
+// Event-scheduled vinyl crackle for Flux's lo-fi page
+
+#pragma once
+#ifndef SPARSE_DUST_H
+#define SPARSE_DUST_H
+
+#include <stddef.h>
+#include <math.h>
+#include "daisysp.h"
+#include "fast_random.h"
+#include "hothouse_fastmath.h"
+
+/** Same impulses as DaisySP's Dust (each sample fires with probability
+    density, at a uniform random height in [0, 1)) through a warm one-pole,
+    but scheduled: the gap to the next impulse is drawn once from the
+    geometric distribution, and the filter only runs until an impulse's
+    tail has decayed. Silent stretches cost one add per sample. */
+class SparseDust
+{
+  public:
+    SparseDust() {}
+    ~SparseDust() {}
+
+    void Init()
+    {
+        filter_.Init();
+        filter_.SetFrequency(600.0f);  // Warm vinyl character
+        density_ = 0.0f;
+        countdown_ = 0;
+        ringing_ = false;
+    }
+
+    void Seed(uint32_t seed) { random_.Seed(seed); }
+
+    /** Impulse probability per sample; a change redraws the pending gap */
+    void SetDensity(float density)
+    {
+        if (density == density_) return;
+        density_ = density;
+        countdown_ = NextGap();
+    }
+
+    /** Add (dust - 0.5) * mix_amount to a block, as the per-sample stage did */
+    void Process(float* buf, size_t size, float mix_amount)
+    {
+        const float offset = -0.5f * mix_amount;
+
+        size_t i = 0;
+        while (i < size) {
+            // Between impulses with the filter settled, dust is exactly 0
+            if (!ringing_ && countdown_ > 0) {
+                size_t run = size - i < (size_t)countdown_ ? size - i : (size_t)countdown_;
+                for (size_t k = 0; k < run; k++) {
+                    buf[i + k] += offset;
+                }
+                countdown_ -= (int)run;
+                i += run;
+                continue;
+            }
+
+            float impulse = 0.0f;
+            if (countdown_ == 0) {
+                impulse = random_.Uniform();
+                countdown_ = NextGap();
+            } else {
+                countdown_--;
+            }
+
+            float dust_signal = filter_.Process(impulse);
+            ringing_ = fabsf(dust_signal) > kTailThreshold;
+            buf[i] += dust_signal * mix_amount + offset;
+            i++;
+        }
+    }
+
+  private:
+    static constexpr float kTailThreshold = 1.0e-5f;  // -100 dB
+    static const int kMaxGap = 1 << 30;
+
+    /** Silent samples before the next impulse, P(gap = n) = (1 - p)^n p */
+    int NextGap()
+    {
+        if (density_ <= 0.0f) return kMaxGap;
+        if (density_ >= 1.0f) return 0;
+
+        float u = 1.0f - random_.Uniform();  // (0, 1]
+        float gap = fastmath::Log2(u) / fastmath::Log2(1.0f - density_);
+        return gap < (float)kMaxGap ? (int)gap : kMaxGap;
+    }
+
+    FastRandom random_;
+    daisysp::OnePole filter_;  // Low-pass filter to soften dust crackle
+    float density_ = 0.0f;
+    int countdown_ = 0;
+    bool ringing_ = false;
+};
+
+#endif  // SPARSE_DUST_H
@@ -0,0 +1,106 @@
+// Tape Wobble
+// LFO-modulated short delay for Flux's wow/flutter, modulated at control rate
+
+#pragma once
+#ifndef TAPE_WOBBLE_H
+#define TAPE_WOBBLE_H
+
+#include <stddef.h>
+#include "daisysp.h"
+
+/** Pitch wobble from a sine-modulated delay, mixed back over the input.
+    The LFO is evaluated once every kControlInterval samples and the delay
+    time is ramped linearly between those points, so the per-sample work
+    is one write, one interpolated read and the mix. */
+class TapeWobble
+{
+  public:
+    static const size_t kMaxDelay = 4800;        // 100ms max delay (@ 48kHz)
+    static const size_t kControlInterval = 16;   // LFO update period, samples
+
+    TapeWobble() {}
+    ~TapeWobble() {}
+
+    void Init(float sample_rate)
+    {
+        sample_rate_ = sample_rate;
+
+        for (size_t i = 0; i < kMaxDelay; i++) {
+            line_[i] = 0.0f;
+        }
+        write_ptr_ = 0;
+
+        lfo_.Init(sample_rate);
+        lfo_.SetWaveform(daisysp::Oscillator::WAVE_SIN);  // Smooth sine wave for natural tape flutter
+        lfo_.SetFreq(1.0f * kControlInterval);  // Default 1Hz
+        lfo_.SetAmp(1.0f);
+
+        delay_ = kCenterDelayMs / 1000.0f * sample_rate;
+    }
+
+    /** Wobble a block in place; amount is the 0-1 wobble knob */
+    void Process(float* buf, size_t size, float amount)
+    {
+        // LFO rate: 0.5Hz to 6Hz with curve for musical control
+        // Low settings = slow tape drift, high settings = vibrato/uni-vibe
+        float lfo_rate = 0.5f + (amount * amount * 5.5f);  // 0.5Hz to 6Hz
+        lfo_.SetFreq(lfo_rate * kControlInterval);  // One step per control interval
+
+        // Map to delay time: 2ms to 8ms range for noticeable pitch movement
+        // Progressive depth - more wobble at higher settings
+        float delay_depth_ms = 2.0f + (amount * 6.0f);  // 2ms to 8ms
+
+        // Reduced maximum mix for more usable knob range
+        // Max 50% wet instead of 100% - keeps more of the original character
+        float wobble_mix = amount * amount * 0.5f;  // Max 50% at full knob
+
+        size_t i = 0;
+        while (i < size) {
+            size_t run = size - i < kControlInterval ? size - i : kControlInterval;
+
+            // Get LFO value (-1.0 to 1.0) and the delay it asks for
+            float lfo_value = lfo_.Process();
+            float delay_time_ms = kCenterDelayMs + (lfo_value * delay_depth_ms * 0.5f);
+            float target = (delay_time_ms / 1000.0f) * sample_rate_;
+            float step = (target - delay_) / (float)run;
+
+            for (size_t k = 0; k < run; k++) {
+                delay_ += step;
+
+                // Write current output to delay, then read the modulated tap
+                line_[write_ptr_] = buf[i + k];
+                write_ptr_ = (write_ptr_ - 1 + kMaxDelay) % kMaxDelay;
+                float wobbled = Read(delay_);
+
+                buf[i + k] = buf[i + k] * (1.0f - wobble_mix) + wobbled * wobble_mix;
+            }
+
+            i += run;
+        }
+    }
+
+  private:
+    static constexpr float kCenterDelayMs = 5.0f;  // Center point
+
+    /** Linear interpolation, as DaisySP's DelayLine::Read() */
+    inline float Read(float delay) const
+    {
+        size_t whole = (size_t)delay;
+        float frac = delay - (float)whole;
+        if (whole >= kMaxDelay) {
+            whole = kMaxDelay - 1;
+        }
+
+        float a = line_[(write_ptr_ + whole) % kMaxDelay];
+        float b = line_[(write_ptr_ + whole + 1) % kMaxDelay];
+        return a + (b - a) * frac;
+    }
+
+    float sample_rate_ = 48000.0f;
+    float line_[kMaxDelay];
+    size_t write_ptr_ = 0;
+    float delay_ = 240.0f;
+    daisysp::Oscillator lfo_;  // LFO for tape wow/flutter modulation
+};
+
+#endif  // TAPE_WOBBLE_H
@@ -1,6 +1,15 @@
 #include "daisy_seed.h"
 #include "daisysp.h"
 #include "hothouse.h"
+#include "hothouse_arena.h"
+#include "hothouse_curves.h"
+#include "hothouse_fastmath.h"
+#include "hothouse_looper.h"
+#include "slice_engine.h"
+#include "fade_table.h"
+#include "crossover.h"
+#include "multiband_flanger.h"
+#include "fast_random.h"
 #include <stdlib.h>
 #include <cmath>
 
@@ -39,7 +48,9 @@
 // TOGGLE 1: Playback Direction
 //   UP: Forward / MIDDLE: Reverse / DOWN: Random per slice
 //
-// TOGGLE 2: (Currently unused - available for future features)
+// TOGGLE 2: Playback Voices
+//   UP: One slice at a time / MIDDLE: Lush, 2 overlapping detuned grains /
+//   DOWN: Lusher, 4 grains, one in four an octave up
 //
 // FOOTSWITCH 1 (FS1): Toggle Slicer (on/off)
 // FOOTSWITCH 2 (FS2): Toggle Spectral Flanger (on/off)
@@ -55,12 +66,47 @@ using namespace clevelandmusicco;
 // CONSTANTS
 // ============================================================================
 
+// CROSSOVER=1 (Makefile) splits the flanger bands with one complementary
+// crossover instead of three Svfs; K6 on Page 2 then has no effect
+#ifndef AMBIEN_CROSSOVER
+#define AMBIEN_CROSSOVER 0
+#endif
+
+// SLICE_16BIT=1 (Makefile) stores slices as 16-bit, which fits 1s slices
+// in the SDRAM the 500ms float slices use
+#ifndef AMBIEN_SLICE_16BIT
+#define AMBIEN_SLICE_16BIT 0
+#endif
+
+// LOOPER=1 (Makefile) adds a looper on FS2 holds, in SDRAM the slicer
+// leaves free (hothouse_looper.h)
+#ifndef AMBIEN_LOOPER
+#define AMBIEN_LOOPER 0
+#endif
+
 #define MAX_SLICES 16
+#if AMBIEN_SLICE_16BIT
+#define MAX_SLICE_LENGTH 48000  // 1s @ 48kHz
+typedef int16_t SliceStorage;
+#else
 #define MAX_SLICE_LENGTH 24000  // 500ms @ 48kHz
+typedef float SliceStorage;
+#endif
 
 const float SAMPLE_RATE = 48000.0f;
+const size_t BLOCK_SIZE = 512;
+// Block size per boot-time profile (hold both footswitches at power-up);
+// BLOCK_SIZE sizes the buffers
+const Hothouse::AudioProfileTable audio_profiles = {
+    {{128, SaiHandle::Config::SampleRate::SAI_48KHZ},
+     {256, SaiHandle::Config::SampleRate::SAI_48KHZ},
+     {BLOCK_SIZE, SaiHandle::Config::SampleRate::SAI_48KHZ}},
+    Hothouse::AUDIO_PROFILE_MAX_HEADROOM};
+// A band whose volume is at or below this (-40 dB, K1-K3 on Page 2 at
+// their minimum) is skipped: no split filter, no flanger, no share of the sum
+const float BAND_MUTE_VOLUME = 0.01f;
 const float MIN_SLICE_LENGTH_MS = 100.0f;
-const float MAX_SLICE_LENGTH_MS = 500.0f;
+const float MAX_SLICE_LENGTH_MS = MAX_SLICE_LENGTH * 1000.0f / SAMPLE_RATE;
 
 // ============================================================================
 // HARDWARE
@@ -73,39 +119,64 @@ Led led1, led2;
 // SLICE BUFFER SYSTEM (Full-spectrum only)
 // ============================================================================
 
-float DSY_SDRAM_BSS sliceBuffers[MAX_SLICES][MAX_SLICE_LENGTH];
-int sliceLengths[MAX_SLICES];
-float sliceVolumes[MAX_SLICES];  // Volume per slice (decays with each play)
-
-int currentCaptureSlice = 0;
-int capturePosition = 0;
-bool hasContent = false;
+// Carved from the shared SDRAM arena in main() (make SDRAM_ARENA_MB)
+SliceStorage (*sliceBuffers)[MAX_SLICE_LENGTH] = nullptr;
+static_assert(sizeof(SliceStorage) * MAX_SLICES * MAX_SLICE_LENGTH <= kSdramArenaBytes,
+              "slice buffers need a bigger SDRAM arena (SDRAM_ARENA_MB)");
+
+#if AMBIEN_LOOPER
+// The output is recorded and the loop added to it
+const size_t LOOP_LENGTH = 60 * 48000;  // 60s @ 48kHz
+const uint32_t LOOPER_HOLD_MS = 1000;   // FS2 held: next looper step
+const uint32_t LOOPER_CLEAR_MS = 3000;  // held on: clear the loop
+Looper looper;
+bool fs2_hold_handled = true;
+bool fs2_clear_handled = true;
+static_assert(sizeof(SliceStorage) * MAX_SLICES * MAX_SLICE_LENGTH + sizeof(float) * LOOP_LENGTH
+                  <= kSdramArenaBytes,
+              "the loop needs a bigger SDRAM arena (SDRAM_ARENA_MB)");
+#endif
 
-// Zero-crossing detection
-bool waitingForZeroCrossing = false;
-float previousCaptureSample = 0.0f;
-bool hasLeftZero = false;
 const int MAX_ZERO_SEARCH = 2400;  // 50ms @ 48kHz (increased from 1000/21ms)
-int zeroSearchCount = 0;
 
-// Playback state
-int currentPlaybackSlice = 0;
-int playbackPosition = 0;
-bool playbackReverse = false;
+// Ambien's slicer rules, defined with the playback direction below
+struct AmbienSlicePolicy
+{
+    int NextSlice(int current, int count);
+    bool Reverse();
+    int NextCapture(int current, int count);
+    int FadeLength(int length);
+    float FadeShape(float ramp);
+    float Decay(float volume);
+    bool Repeat() { return false; }
+    void Started() {}
+    float GrainPitch();
+};
+
+SliceEngine<MAX_SLICES, MAX_SLICE_LENGTH, AmbienSlicePolicy, SliceStorage> HOTHOUSE_DTCM_BSS slicer;
+
+FastRandom rng;  // Audio-path randomness (random playback direction, grain detune)
+
+// Per-block staging between the flanger, the slicer and the mix
+float flangedBlock[BLOCK_SIZE];
+float slicedBlock[BLOCK_SIZE];
 
 // ============================================================================
 // DSP MODULES
 // ============================================================================
 
 // Frequency splitting filters (guitar-optimized)
+#if AMBIEN_CROSSOVER
+ThreeBandCrossover bandSplit;  // Low <800Hz / Mid 800Hz-1kHz / High >1kHz
+#else
 Svf lowSplit;    // Low: 80-800Hz
 Svf midSplit;    // Mid: 800Hz-1kHz
 Svf highSplit;   // High: 1k-4kHz
+#endif
 
-// Flanger per band for phase modulation
-Flanger lowFlanger;
-Flanger midFlanger;
-Flanger highFlanger;
+// Flanger per band for phase modulation, one shared interleaved delay line
+enum { BAND_LOW, BAND_MID, BAND_HIGH, NUM_BANDS };
+MultiBandFlanger<NUM_BANDS> bandFlanger;
 
 // ============================================================================
 // CONTROL STATE
@@ -141,6 +212,7 @@ float knob_high_rate;
 
 // Toggles
 int toggle_mode;   // T1: playback direction
+int toggle_grains; // T2: playback voices (0=single slice, 1=2 grains, 2=4 grains)
 int toggle_page;   // T3: page selector (0=Page1, 1=Page2, 2=Page3)
 
 // Touch detection for page switching
@@ -156,9 +228,10 @@ int slice_length_samples;
 float slice_length_samples_smooth;
 float feedback_amount;
 float master_level_amount;
-int crossfade_length;
 
 float low_volume, mid_volume, high_volume;
+unsigned band_active = MultiBandFlanger<NUM_BANDS>::kAllBands;  // Bit per band, from the volumes
+unsigned band_rising = 0;  // Bands active this block that weren't the last
 float low_q, mid_q, high_q;
 float low_flanger_depth, mid_flanger_depth, high_flanger_depth;
 float low_flanger_rate, mid_flanger_rate, high_flanger_rate;
@@ -173,6 +246,7 @@ void UpdateControls()
     
     // Read toggles
     toggle_mode = hw.GetToggleswitchPosition(Hothouse::TOGGLESWITCH_1);
+    toggle_grains = hw.GetToggleswitchPosition(Hothouse::TOGGLESWITCH_2);
     toggle_page = hw.GetToggleswitchPosition(Hothouse::TOGGLESWITCH_3);
     
     // Detect page change
@@ -232,15 +306,45 @@ void UpdateButtons()
     
     if (hw.switches[Hothouse::FOOTSWITCH_2].RisingEdge()) {
         flanger_enabled = !flanger_enabled;
+#if AMBIEN_LOOPER
+        fs2_hold_handled = false;
+        fs2_clear_handled = false;
+#endif
     }
+
+#if AMBIEN_LOOPER
+    // A long FS2 hold steps the looper instead, undoing the press's toggle;
+    // holding on clears the loop
+    if (hw.switches[Hothouse::FOOTSWITCH_2].Pressed()) {
+        const uint32_t held = hw.switches[Hothouse::FOOTSWITCH_2].TimeHeldMs();
+        if (!fs2_hold_handled && held >= LOOPER_HOLD_MS) {
+            fs2_hold_handled = true;
+            flanger_enabled = !flanger_enabled;
+            looper.Press();
+        }
+        if (!fs2_clear_handled && held >= LOOPER_CLEAR_MS) {
+            fs2_clear_handled = true;
+            looper.Clear();
+        }
+    }
+#endif
 }
 
 void UpdateLEDs()
 {
-    led1.Set(slicer_enabled ? 1.0f : 0.0f);   // LED1: Slicer status
-    led2.Set(flanger_enabled ? 1.0f : 0.0f);  // LED2: Flanger status
-    led1.Update();
-    led2.Update();
+    hw.SetLed(Hothouse::LED_1, slicer_enabled ? 1.0f : 0.0f);   // LED1: Slicer status
+#if AMBIEN_LOOPER
+    // LED2 flashes fast while the looper records, slowly while it overdubs
+    if (looper.GetState() == Looper::RECORDING) {
+        hw.SetLedPattern(Hothouse::LED_2, Hothouse::LedPattern::Flash(200, 0.5f));
+        return;
+    }
+    if (looper.GetState() == Looper::OVERDUBBING) {
+        hw.SetLedPattern(Hothouse::LED_2, Hothouse::LedPattern::Flash(600, 0.5f));
+        return;
+    }
+#endif
+    hw.SetLed(Hothouse::LED_2, hw.LoadLed(flanger_enabled ? 1.0f : 0.0f));  // LED2: Flanger status
 }
 
 void ProcessParameters()
@@ -249,8 +353,9 @@ void ProcessParameters()
     active_slice_count = (int)(knob_slice_count * 15.999f) + 1;
     if (active_slice_count < 1) active_slice_count = 1;
     if (active_slice_count > MAX_SLICES) active_slice_count = MAX_SLICES;
+    slicer.SetSliceCount(active_slice_count);
     
-    float log_knob = logf(1.0f + 9.0f * knob_slice_length) / logf(10.0f);
+    float log_knob = KnobLog(knob_slice_length);
     slice_length_ms = MIN_SLICE_LENGTH_MS + (log_knob * (MAX_SLICE_LENGTH_MS - MIN_SLICE_LENGTH_MS));
     slice_length_samples = (int)((slice_length_ms / 1000.0f) * SAMPLE_RATE);
     if (slice_length_samples < 1) slice_length_samples = 1;
@@ -259,48 +364,50 @@ void ProcessParameters()
     feedback_amount = knob_feedback;
     master_level_amount = knob_master_level * 2.0f;
     
-    int currentSliceLen = sliceLengths[currentPlaybackSlice];
-    if (currentSliceLen > 0) {
-        crossfade_length = (int)(knob_crossfade * 0.5f * currentSliceLen);
-        if (crossfade_length < 960) crossfade_length = 960;  // 20ms minimum
-        if (crossfade_length * 2 > currentSliceLen) {
-            crossfade_length = currentSliceLen / 3;
-            if (crossfade_length < 1) crossfade_length = 1;
-        }
-    } else {
-        crossfade_length = 960;  // 20ms minimum
-    }
-    
     // Page 2: Band volumes and Q
     low_volume = knob_low_volume * 2.0f;
     mid_volume = knob_mid_volume * 2.0f;
     high_volume = knob_high_volume * 2.0f;
     
+    const float volumes[NUM_BANDS] = { low_volume, mid_volume, high_volume };
+    unsigned active = 0;
+    for (int band = 0; band < NUM_BANDS; band++) {
+        if (volumes[band] > BAND_MUTE_VOLUME) {
+            active |= 1u << band;
+        }
+    }
+    band_rising = active & ~band_active;
+    band_active = active;
+    
     low_q = 0.1f + (knob_low_q * 1.9f);
     mid_q = 0.1f + (knob_mid_q * 1.9f);
     high_q = 0.1f + (knob_high_q * 1.9f);
     
+#if AMBIEN_CROSSOVER
+    bandSplit.SetRes(low_q * 1.0f, mid_q * 0.7f);
+#else
     lowSplit.SetRes(low_q * 1.0f);    // 800Hz - full Q
     midSplit.SetRes(mid_q * 0.7f);    // 900Hz - reduce 30%
     highSplit.SetRes(high_q * 0.5f);  // 1000Hz - reduce 50%
+#endif
     
     // Page 3: Flanger settings
     low_flanger_depth = knob_low_depth;
     mid_flanger_depth = knob_mid_depth;
     high_flanger_depth = knob_high_depth;
     
-    low_flanger_rate = 0.05f * powf(200.0f, knob_low_rate);
-    mid_flanger_rate = 0.05f * powf(200.0f, knob_mid_rate);
-    high_flanger_rate = 0.05f * powf(200.0f, knob_high_rate);
+    low_flanger_rate = 0.05f * KnobExp<200>(knob_low_rate);
+    mid_flanger_rate = 0.05f * KnobExp<200>(knob_mid_rate);
+    high_flanger_rate = 0.05f * KnobExp<200>(knob_high_rate);
     
-    lowFlanger.SetLfoDepth(low_flanger_depth);
-    lowFlanger.SetLfoFreq(low_flanger_rate);
+    bandFlanger.SetLfoDepth(BAND_LOW, low_flanger_depth);
+    bandFlanger.SetLfoFreq(BAND_LOW, low_flanger_rate);
     
-    midFlanger.SetLfoDepth(mid_flanger_depth);
-    midFlanger.SetLfoFreq(mid_flanger_rate);
+    bandFlanger.SetLfoDepth(BAND_MID, mid_flanger_depth);
+    bandFlanger.SetLfoFreq(BAND_MID, mid_flanger_rate);
     
-    highFlanger.SetLfoDepth(high_flanger_depth);
-    highFlanger.SetLfoFreq(high_flanger_rate);
+    bandFlanger.SetLfoDepth(BAND_HIGH, high_flanger_depth);
+    bandFlanger.SetLfoFreq(BAND_HIGH, high_flanger_rate);
     
 }
 
@@ -308,287 +415,194 @@ void ProcessParameters()
 // PLAYBACK DIRECTION
 // ============================================================================
 
-int GetNextSlice(int current, int sliceCount, int mode, bool& reverseFlag)
+int AmbienSlicePolicy::NextSlice(int current, int count)
 {
-    int nextSlice;
-    
-    if (mode == 1) {
+    if (toggle_mode == 1) {
         // MIDDLE: Reverse
-        nextSlice = (current - 1 + sliceCount) % sliceCount;
-        reverseFlag = true;
-    } else if (mode == 2) {
-        // DOWN: Random direction per slice
-        nextSlice = (current + 1) % sliceCount;
-        reverseFlag = (rand() % 2) == 0;
-    } else {
-        // UP: Forward
-        nextSlice = (current + 1) % sliceCount;
-        reverseFlag = false;
+        return (current - 1 + count) % count;
     }
-    
-    return nextSlice;
+    // UP: Forward / DOWN: Random direction per slice
+    return (current + 1) % count;
 }
 
-// ============================================================================
-// SLICE BUFFER INITIALIZATION
-// ============================================================================
+bool AmbienSlicePolicy::Reverse()
+{
+    if (toggle_mode == 1) return true;
+    if (toggle_mode == 2) return rng.Coin();
+    return false;
+}
 
-void InitializeSliceBuffers()
+int AmbienSlicePolicy::NextCapture(int current, int count)
 {
-    for (int slice = 0; slice < MAX_SLICES; slice++) {
-        sliceLengths[slice] = 0;
-        sliceVolumes[slice] = 1.0f;  // Full volume initially
-        for (int sample = 0; sample < MAX_SLICE_LENGTH; sample++) {
-            sliceBuffers[slice][sample] = 0.0f;
-        }
+    current++;
+    if (current >= count) {
+        current = 0;
     }
-    
-    currentCaptureSlice = 0;
-    capturePosition = 0;
-    currentPlaybackSlice = 0;
-    playbackPosition = 0;
-    hasContent = false;
-    
-    waitingForZeroCrossing = false;
-    previousCaptureSample = 0.0f;
-    hasLeftZero = false;
-    zeroSearchCount = 0;
+    return current;
 }
 
 // ============================================================================
-// SLICE CAPTURE (Full-spectrum)
+// CROSSFADES AND DECAY
 // ============================================================================
 
-void CaptureSlice(float input)
+int AmbienSlicePolicy::FadeLength(int length)
 {
-    int target_length = (int)slice_length_samples_smooth;
-    if (target_length > MAX_SLICE_LENGTH) {
-        target_length = MAX_SLICE_LENGTH;
-    }
-    
-    if (waitingForZeroCrossing) {
-        zeroSearchCount++;
-        
-        const float ZERO_THRESHOLD = 0.01f;
-        
-        if (!hasLeftZero) {
-            if (fabsf(input) > ZERO_THRESHOLD) {
-                hasLeftZero = true;
-                previousCaptureSample = input;
-            }
-        } else {
-            bool crossingDetected = (previousCaptureSample > 0.0f && input <= 0.0f) || 
-                                   (previousCaptureSample < 0.0f && input >= 0.0f);
-            
-            if (crossingDetected || zeroSearchCount >= MAX_ZERO_SEARCH) {
-                sliceLengths[currentCaptureSlice] = capturePosition;
-                sliceVolumes[currentCaptureSlice] = 1.0f;  // Reset to full volume on new capture
-                
-                currentCaptureSlice++;
-                if (currentCaptureSlice >= active_slice_count) {
-                    currentCaptureSlice = 0;
-                }
-                
-                capturePosition = 0;
-                waitingForZeroCrossing = false;
-                hasLeftZero = false;
-                zeroSearchCount = 0;
-                hasContent = true;
-            }
-        }
-        
-        previousCaptureSample = input;
-        
-        if (capturePosition < MAX_SLICE_LENGTH) {
-            sliceBuffers[currentCaptureSlice][capturePosition] = input;
-            capturePosition++;
-        }
-        
-        return;
-    }
-    
-    sliceBuffers[currentCaptureSlice][capturePosition] = input;
-    capturePosition++;
-    
-    if (capturePosition >= target_length) {
-        waitingForZeroCrossing = true;
-        hasLeftZero = false;
-        zeroSearchCount = 0;
-        previousCaptureSample = input;
+    int crossfade_length = (int)(knob_crossfade * 0.5f * length);
+    if (crossfade_length < 960) crossfade_length = 960;  // 20ms minimum
+    if (crossfade_length * 2 > length) {
+        crossfade_length = length / 3;
+        if (crossfade_length < 1) crossfade_length = 1;
     }
+    return crossfade_length;
 }
 
-// ============================================================================
-// 4-VOICE PLAYBACK (Dry + 3 Phased Bands)
-// ============================================================================
+float AmbienSlicePolicy::FadeShape(float ramp)
+{
+    // sqrt for equal-power crossfades at slice boundaries (reduces clicks),
+    // read from the shared table instead of calling sqrtf() per sample
+    return equalPowerFade(ramp);
+}
 
-float PlaybackSlice()
+float AmbienSlicePolicy::Decay(float volume)
 {
-    if (!hasContent || sliceLengths[currentPlaybackSlice] <= 0) {
-        return 0.0f;
-    }
-    
-    // CRITICAL: Check for read/write conflict EVERY frame
-    // If we're reading from the slice that's currently being written,
-    // skip to the next slice immediately to prevent clicks
-    if (currentPlaybackSlice == currentCaptureSlice) {
-        int nextSlice = GetNextSlice(currentPlaybackSlice, active_slice_count, toggle_mode, playbackReverse);
-        
-        // Make sure we don't skip back to the same slice
-        if (nextSlice != currentCaptureSlice && sliceLengths[nextSlice] > 0) {
-            currentPlaybackSlice = nextSlice;
-            playbackPosition = 0;
-        }
+    // Decay slice volume based on feedback amount
+    // High feedback = slow decay, Low feedback = fast decay
+    // Formula: volume *= (0.5 + 0.45 * feedback)
+    // At 0% feedback: volume *= 0.5 (decays quickly - 50% per cycle)
+    // At 100% feedback: volume *= 0.95 (very slow decay - 5% per cycle)
+    float decay_factor = 0.5f + (0.45f * feedback_amount);
+    volume *= decay_factor;
+    
+    // If volume drops below threshold, consider it silent
+    if (volume < 0.001f) {
+        volume = 0.0f;
     }
-    
-    int sliceLength = sliceLengths[currentPlaybackSlice];
-    
-    // Calculate read position
-    int readPosition;
-    if (playbackReverse) {
-        readPosition = sliceLength - 1 - playbackPosition;
-        if (readPosition < 0) readPosition = 0;
-    } else {
-        readPosition = playbackPosition;
-    }
-    
-    if (readPosition >= sliceLength) readPosition = sliceLength - 1;
-    if (readPosition < 0) readPosition = 0;
-    
-    // Read sample from buffer (already filtered+flanged during capture)
-    float sample = sliceBuffers[currentPlaybackSlice][readPosition];
-    
-    // Apply equal-power crossfades at slice boundaries (reduces clicks)
-    // Use readPosition for fade calculations so they work correctly in reverse
-    float fadeEnvelope = 1.0f;
-    
-    if (readPosition < crossfade_length) {
-        // Fade in with sqrt for equal-power
-        fadeEnvelope = sqrtf((float)readPosition / (float)crossfade_length);
-    }
-    
-    int fadeOutStart = sliceLength - crossfade_length;
-    if (fadeOutStart > 0 && readPosition >= fadeOutStart) {
-        int fadeOutPos = readPosition - fadeOutStart;
-        // Fade out with sqrt for equal-power
-        float fadeOutEnvelope = sqrtf(1.0f - ((float)fadeOutPos / (float)crossfade_length));
-        if (fadeOutEnvelope < fadeEnvelope) {
-            fadeEnvelope = fadeOutEnvelope;
-        }
-    }
-    
-    // Apply crossfade envelope and slice volume
-    float output = sample * fadeEnvelope * sliceVolumes[currentPlaybackSlice];
-    
-    // Advance playback
-    playbackPosition++;
-    
-    if (playbackPosition >= sliceLength) {
-        playbackPosition = 0;
-        
-        // Decay slice volume based on feedback amount
-        // High feedback = slow decay, Low feedback = fast decay
-        // Formula: volume *= (0.5 + 0.45 * feedback)
-        // At 0% feedback: volume *= 0.5 (decays quickly - 50% per cycle)
-        // At 100% feedback: volume *= 0.95 (very slow decay - 5% per cycle)
-        float decay_factor = 0.5f + (0.45f * feedback_amount);
-        sliceVolumes[currentPlaybackSlice] *= decay_factor;
-        
-        // If volume drops below threshold, consider it silent
-        if (sliceVolumes[currentPlaybackSlice] < 0.001f) {
-            sliceVolumes[currentPlaybackSlice] = 0.0f;
-        }
-        
-        int nextSlice = GetNextSlice(currentPlaybackSlice, active_slice_count, toggle_mode, playbackReverse);
-        
-        if (nextSlice == currentCaptureSlice) {
-            nextSlice = GetNextSlice(nextSlice, active_slice_count, toggle_mode, playbackReverse);
-        }
-        
-        if (sliceLengths[nextSlice] > 0) {
-            currentPlaybackSlice = nextSlice;
-            playbackPosition = 0;
-        }
+    return volume;
+}
+
+float AmbienSlicePolicy::GrainPitch()
+{
+    // T2 MIDDLE: each grain detuned up to ~5 cents, for a chorus-like spread
+    // T2 DOWN: up to ~10 cents, and one grain in four an octave up
+    if (toggle_grains == 2) {
+        if (rng.Below(4) == 0) return 2.0f;
+        return 1.0f + 0.006f * (2.0f * rng.Uniform() - 1.0f);
     }
-    
-    return output;
+    return 1.0f + 0.003f * (2.0f * rng.Uniform() - 1.0f);
 }
 
 // ============================================================================
 // AUDIO CALLBACK
 // ============================================================================
 
-static void AudioCallback(AudioHandle::InputBuffer in,
-                          AudioHandle::OutputBuffer out,
-                          size_t size)
+// One block with the footswitch states fixed at compile time, so the
+// per-sample loops carry no mode tests
+template <bool Flanger, bool Slicer>
+HOTHOUSE_ITCM static void ProcessBlock(AudioHandle::InputBuffer in,
+                                       AudioHandle::OutputBuffer out,
+                                       size_t size)
 {
-    UpdateControls();
-    UpdateButtons();
-    UpdateLEDs();
-    
     // Only process parameters when at least one effect is enabled
-    if (slicer_enabled || flanger_enabled) {
+    if (Slicer || Flanger) {
         ProcessParameters();
     }
     
+    // STAGE 1: Spectral Flanger (if FS2 enabled). Muted bands are skipped;
+    // one coming back ramps up from silence across this block, as its
+    // filter and delay line have been standing still.
+    const unsigned active = band_active;
+    float band_gain[NUM_BANDS] = { low_volume, mid_volume, high_volume };
+    float band_step[NUM_BANDS] = {};
+    if (Flanger) {
+        for (int band = 0; band < NUM_BANDS; band++) {
+            if (band_rising & (1u << band)) {
+                band_step[band] = band_gain[band] / (float)size;
+                band_gain[band] = 0.0f;
+            }
+        }
+        band_rising = 0;
+    }
     for (size_t i = 0; i < size; i++)
     {
         fonepole(slice_length_samples_smooth, (float)slice_length_samples, 0.0002f);
         
         float input = in[0][i];
-        float output;
         
         // Start with clean input
-        float processedSignal = input;
         float flangedSignal = input;
         
-        // STAGE 1: Spectral Flanger (if FS2 enabled)
         float lowBand = 0.0f;
         float midBand = 0.0f;
         float highBand = 0.0f;
         
-        if (flanger_enabled) {
-            // Split input into 3 frequency bands
-            lowSplit.Process(input);
-            midSplit.Process(input);
-            highSplit.Process(input);
-            
-            lowBand = lowSplit.Low();
-            midBand = midSplit.Band();
-            highBand = highSplit.High();
+        if (Flanger && active) {
+            // Split input into 3 frequency bands. The crossover's splits
+            // feed each other, so it runs whole while any band sounds.
+#if AMBIEN_CROSSOVER
+            bandSplit.Process(input, lowBand, midBand, highBand);
+#else
+            if (active & (1u << BAND_LOW)) {
+                lowSplit.Process(input);
+                lowBand = lowSplit.Low();
+            }
+            if (active & (1u << BAND_MID)) {
+                midSplit.Process(input);
+                midBand = midSplit.Band();
+            }
+            if (active & (1u << BAND_HIGH)) {
+                highSplit.Process(input);
+                highBand = highSplit.High();
+            }
+#endif
             
             // Apply Flangers to each band
-            float lowFlanged = lowFlanger.Process(lowBand);
-            float midFlanged = midFlanger.Process(midBand);
-            float highFlanged = highFlanger.Process(highBand);
+            float bands[NUM_BANDS] = { lowBand, midBand, highBand };
+            float flanged[NUM_BANDS];
+            bandFlanger.Process(bands, flanged, active);
             
             // Sum the flanged bands with volume scaling
-            flangedSignal = (lowFlanged * low_volume) + (midFlanged * mid_volume) + (highFlanged * high_volume);
-            processedSignal = flangedSignal;
-        }
-        
-        // STAGE 2: Slicer - Capture (only if FS1 enabled)
-        if (slicer_enabled) {
-            CaptureSlice(processedSignal);
+            flangedSignal = 0.0f;
+            for (int band = 0; band < NUM_BANDS; band++) {
+                if (active & (1u << band)) {
+                    flangedSignal += flanged[band] * band_gain[band];
+                    band_gain[band] += band_step[band];
+                }
+            }
+        } else if (Flanger) {
+            flangedSignal = 0.0f;
         }
         
-        // STAGE 3: Slicer - Playback (if FS1 enabled)
-        float sliced = 0.0f;
-        if (slicer_enabled) {
-            sliced = PlaybackSlice();
+        flangedBlock[i] = flangedSignal;
+    }
+    
+    // STAGE 2-3: Slicer - Capture, then Playback (only if FS1 enabled)
+    if (Slicer) {
+        slicer.SetTargetLength((int)slice_length_samples_smooth);
+        slicer.Capture(flangedBlock, size);
+        if (toggle_grains == 0) {
+            slicer.Playback(slicedBlock, size);
+        } else {
+            slicer.SetGrainVoices(toggle_grains == 2 ? 4 : 2);
+            slicer.PlaybackGrains(slicedBlock, size);
         }
+    }
+    
+    for (size_t i = 0; i < size; i++)
+    {
+        float input = in[0][i];
+        float output;
         
         // STAGE 4: Combine everything
         // If slicer is off, use the flanged signal directly
-        float wet_signal = slicer_enabled ? sliced : flangedSignal;
+        float wet_signal = Slicer ? slicedBlock[i] : flangedBlock[i];
         
         // True bypass when both effects are off
-        if (!slicer_enabled && !flanger_enabled) {
+        if (!Slicer && !Flanger) {
             output = input;
         } else {
             // STAGE 5: Dry/wet mix
-            float wet_level = sqrtf(knob_mix);
-            float dry_level = sqrtf(1.0f - knob_mix);
+            float wet_level = fastmath::Sqrt(knob_mix);
+            float dry_level = fastmath::Sqrt(1.0f - knob_mix);
             output = (input * dry_level) + (wet_signal * wet_level);
             
             // STAGE 6: Master level
@@ -598,6 +612,55 @@ static void AudioCallback(AudioHandle::InputBuffer in,
         out[0][i] = output;
         out[1][i] = output;
     }
+
+#if AMBIEN_LOOPER
+    looper.Process(out[0], out[0], size);
+    memcpy(out[1], out[0], size * sizeof(float));
+#endif
+}
+
+typedef void (*BlockProcessor)(AudioHandle::InputBuffer, AudioHandle::OutputBuffer, size_t);
+
+// [flanger_enabled][slicer_enabled]
+const BlockProcessor block_processors[2][2] = {
+    {ProcessBlock<false, false>, ProcessBlock<false, true>},
+    {ProcessBlock<true, false>, ProcessBlock<true, true>}};
+
+template <bool Flanger, bool Slicer>
+HOTHOUSE_ITCM static void AudioCallback(AudioHandle::InputBuffer in,
+                                        AudioHandle::OutputBuffer out,
+                                        size_t size);
+
+const AudioHandle::AudioCallback audio_callbacks[2][2] = {
+    {AudioCallback<false, false>, AudioCallback<false, true>},
+    {AudioCallback<true, false>, AudioCallback<true, true>}};
+
+// The callback for one pair of footswitch states. When a footswitch
+// changes them it swaps in the matching callback for the blocks after this
+// one, and runs this block through the new states' processor
+template <bool Flanger, bool Slicer>
+HOTHOUSE_ITCM static void AudioCallback(AudioHandle::InputBuffer in,
+                                        AudioHandle::OutputBuffer out,
+                                        size_t size)
+{
+    UpdateControls();
+    UpdateButtons();
+    UpdateLEDs();
+
+    // Full CPU clock back before any DSP (make POWER_SAVE=1); a loop
+    // playing keeps it up
+    bool bypassed = !flanger_enabled && !slicer_enabled;
+#if AMBIEN_LOOPER
+    bypassed = bypassed && looper.GetState() == Looper::EMPTY;
+#endif
+    hw.SetBypassed(bypassed);
+
+    if (flanger_enabled != Flanger || slicer_enabled != Slicer) {
+        hw.ChangeAudioCallback(audio_callbacks[flanger_enabled][slicer_enabled]);
+        block_processors[flanger_enabled][slicer_enabled](in, out, size);
+        return;
+    }
+    ProcessBlock<Flanger, Slicer>(in, out, size);
 }
 
 // ============================================================================
@@ -607,12 +670,22 @@ static void AudioCallback(AudioHandle::InputBuffer in,
 int main(void)
 {
     hw.Init(true);
-    srand(System::GetNow());
-    hw.SetAudioBlockSize(512);
+    rng.Seed(System::GetNow());
+    hw.SelectAudioProfile(audio_profiles);
     
-    InitializeSliceBuffers();
+    sliceBuffers = sdramArena.Carve<SliceStorage[MAX_SLICE_LENGTH]>(MAX_SLICES);
+    slicer.Init(sliceBuffers);
+    slicer.SetSearchWindow(MAX_ZERO_SEARCH);
+#if AMBIEN_LOOPER
+    looper.Init(sdramArena.Carve<float>(LOOP_LENGTH), LOOP_LENGTH);
+#endif
     
     // Initialize DSP modules
+#if AMBIEN_CROSSOVER
+    bandSplit.Init(SAMPLE_RATE);
+    bandSplit.SetSplits(800.0f, 1000.0f);
+    bandSplit.SetRes(0.1f, 0.1f);
+#else
     lowSplit.Init(SAMPLE_RATE);
     lowSplit.SetFreq(800.0f);
     lowSplit.SetRes(0.1f);
@@ -624,15 +697,12 @@ int main(void)
     highSplit.Init(SAMPLE_RATE);
     highSplit.SetFreq(1000.0f);
     highSplit.SetRes(0.1f);
+#endif
     
-    lowFlanger.Init(SAMPLE_RATE);
-    lowFlanger.SetFeedback(0.85f);  // Increased for pronounced flanging
-    
-    midFlanger.Init(SAMPLE_RATE);
-    midFlanger.SetFeedback(0.85f);  // Increased for pronounced flanging
-    
-    highFlanger.Init(SAMPLE_RATE);
-    highFlanger.SetFeedback(0.85f);  // Increased for pronounced flanging
+    bandFlanger.Init(SAMPLE_RATE);
+    for (int band = 0; band < NUM_BANDS; band++) {
+        bandFlanger.SetFeedback(band, 0.85f);  // Increased for pronounced flanging
+    }
     
     // Initialize controls to safe defaults
     bypass = true;
@@ -660,6 +730,7 @@ int main(void)
     knob_high_rate = 0.2f;
     
     toggle_mode = 0;
+    toggle_grains = 0;
     toggle_page = 0;
     
     // Initialize touch detection
@@ -672,6 +743,7 @@ int main(void)
     
     ProcessParameters();
     slice_length_samples_smooth = (float)slice_length_samples;
+    hw.BootMark("DSP");
     
     led1.Init(hw.seed.GetPin(Hothouse::LED_1), false);
     led2.Init(hw.seed.GetPin(Hothouse::LED_2), false);
@@ -679,15 +751,37 @@ int main(void)
     led2.Set(0.0f);
     led1.Update();
     led2.Update();
+    hw.StartLedService();
     
     hw.StartAdc();
-    hw.StartAudio(AudioCallback);
+    hw.StartAudio(audio_callbacks[flanger_enabled][slicer_enabled]);
     
     while(1)
     {
+        // CPU load over USB serial (make LOAD_METER=1)
+        hw.ServiceLoadMeter();
+        // Callback overruns over USB serial and into QSPI (make WATCHDOG=1)
+        hw.ServiceWatchdog();
+        // Time to each boot phase over USB serial (make BOOT_TIMING=1)
+        hw.ServiceBootTiming();
+        // Heap allocations inside the audio callback over USB serial (make ALLOC_CHECK=1)
+        hw.ServiceAllocCheck();
+        // Stack and heap high-water marks over USB serial (make MEMORY_REPORT=1)
+        hw.ServiceMemoryReport();
+        // Subnormals and NaNs in the audio callback (make DENORMAL_CHECK=1)
+        hw.ServiceDenormalCheck();
+        // Half the CPU clock after 5 s in bypass (make POWER_SAVE=1)
+        hw.ServicePower();
+        // Signal probes armed and dumped over USB serial (make PROBE=1)
+        hw.ServiceProbes();
+        // Round-trip latency through a loopback cable (make LATENCY_TEST=1)
+        hw.ServiceLatencyTest();
+        // The reports above as binary records over USB serial (make TELEMETRY=1)
+        hw.ServiceTelemetry();
+
         // Hothouse DFU entry - QSPI compatible
         hw.CheckResetToBootloader();
         
-        System::Delay(100);
+        hw.IdleMs(100);
     }
 }
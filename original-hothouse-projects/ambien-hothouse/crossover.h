@@ -0,0 +1,109 @@
+// Three-Band Crossover
+// Complementary low/mid/high split for Ambien's spectral flanger
+
+#pragma once
+#ifndef CROSSOVER_H
+#define CROSSOVER_H
+
+#include <math.h>
+
+/** Two trapezoidal (TPT) state-variable low-passes in series, each band
+    taken as what the previous split passed minus what it kept:
+
+        low  = LP1(x)
+        mid  = LP2(x - low)
+        high = x - low - mid
+
+    The bands always sum back to the input exactly, whatever the split Qs.
+    Each split runs once per sample and only its low-pass is computed,
+    where the three DaisySP Svfs it replaces each ran every output twice. */
+class ThreeBandCrossover
+{
+  public:
+    ThreeBandCrossover() {}
+    ~ThreeBandCrossover() {}
+
+    void Init(float sample_rate)
+    {
+        sample_rate_ = sample_rate;
+        low_.Reset();
+        high_.Reset();
+        SetSplits(800.0f, 1000.0f);
+        SetRes(0.0f, 0.0f);
+    }
+
+    /** Low/mid and mid/high split frequencies in Hz */
+    void SetSplits(float low_mid, float mid_high)
+    {
+        low_.SetFreq(low_mid, sample_rate_);
+        high_.SetFreq(mid_high, sample_rate_);
+    }
+
+    /** Resonance of each split, 0-1 as for DaisySP's Svf::SetRes() */
+    void SetRes(float low_mid, float mid_high)
+    {
+        low_.SetRes(low_mid);
+        high_.SetRes(mid_high);
+    }
+
+    inline void Process(float in, float& low, float& mid, float& high)
+    {
+        low = low_.Process(in);
+        float rest = in - low;
+        mid = high_.Process(rest);
+        high = rest - mid;
+    }
+
+  private:
+    struct Split
+    {
+        void Reset()
+        {
+            ic1_ = 0.0f;
+            ic2_ = 0.0f;
+        }
+
+        void SetFreq(float freq, float sample_rate)
+        {
+            if (freq > sample_rate * 0.45f) freq = sample_rate * 0.45f;
+            g_ = tanf(3.14159265f * freq / sample_rate);
+            Update();
+        }
+
+        // Svf-style resonance 0-1 mapped to Q 0.5 (no overshoot) to 5
+        void SetRes(float res)
+        {
+            if (res < 0.0f) res = 0.0f;
+            if (res > 1.0f) res = 1.0f;
+            k_ = 2.0f * (1.0f - 0.9f * res);
+            Update();
+        }
+
+        void Update()
+        {
+            a1_ = 1.0f / (1.0f + g_ * (g_ + k_));
+            a2_ = g_ * a1_;
+            a3_ = g_ * a2_;
+        }
+
+        inline float Process(float in)
+        {
+            float v3 = in - ic2_;
+            float v1 = a1_ * ic1_ + a2_ * v3;
+            float v2 = ic2_ + a2_ * ic1_ + a3_ * v3;
+            ic1_ = 2.0f * v1 - ic1_;
+            ic2_ = 2.0f * v2 - ic2_;
+            return v2;
+        }
+
+        float g_ = 0.0f, k_ = 2.0f;
+        float a1_ = 1.0f, a2_ = 0.0f, a3_ = 0.0f;
+        float ic1_ = 0.0f, ic2_ = 0.0f;
+    };
+
+    float sample_rate_ = 48000.0f;
+    Split low_;
+    Split high_;
+};
+
+#endif  // CROSSOVER_H
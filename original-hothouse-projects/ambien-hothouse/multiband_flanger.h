@@ -0,0 +1,156 @@
+// Multi-Band Flanger
+// Per-band flangers sharing one interleaved delay line (Ambien spectral flanger)
+
+#pragma once
+#ifndef MULTIBAND_FLANGER_H
+#define MULTIBAND_FLANGER_H
+
+#include <stddef.h>
+#include <math.h>
+
+/** Independent flangers, one per crossover band, with the same voice
+    as DaisySP's Flanger (20 ms line, triangle LFO, feedback scaled by 0.97,
+    output = (in + delayed) / 2), but stored frame-interleaved: every band
+    writes the same row each sample, so the write touches one cache line
+    instead of Bands separate lines, and the LFOs run as arrays side by side.
+*/
+template <size_t Bands>
+class MultiBandFlanger
+{
+  public:
+    static const size_t kDelayLength = 960;  // 20 ms at 48kHz
+
+    MultiBandFlanger() {}
+    ~MultiBandFlanger() {}
+
+    void Init(float sample_rate)
+    {
+        sample_rate_ = sample_rate;
+
+        for (size_t i = 0; i < kDelayLength; i++) {
+            for (size_t b = 0; b < Bands; b++) {
+                line_[i][b] = 0.0f;
+            }
+        }
+        write_ptr_ = 0;
+
+        for (size_t b = 0; b < Bands; b++) {
+            SetFeedback(b, 0.2f);
+            lfo_amp_[b] = 0.0f;
+            SetDelay(b, 0.75f);
+            lfo_phase_[b] = 0.0f;
+            lfo_freq_[b] = 0.0f;
+            SetLfoFreq(b, 0.3f);
+            SetLfoDepth(b, 0.9f);
+        }
+    }
+
+    /** Feedback 0-1 */
+    void SetFeedback(size_t band, float feedback)
+    {
+        feedback_[band] = Clamp(feedback, 0.0f, 1.0f) * 0.97f;
+    }
+
+    /** LFO depth 0-1 (limited to 0.93) */
+    void SetLfoDepth(size_t band, float depth)
+    {
+        lfo_amp_[band] = Clamp(depth, 0.0f, 0.93f) * delay_[band];
+    }
+
+    /** LFO rate in Hz */
+    void SetLfoFreq(size_t band, float freq)
+    {
+        freq = 4.0f * freq / sample_rate_;
+        freq *= lfo_freq_[band] < 0.0f ? -1.0f : 1.0f;  // Keep the sweep direction
+        lfo_freq_[band] = Clamp(freq, -0.25f, 0.25f);
+    }
+
+    /** Centre delay 0-1, mapped to 0-20 ms */
+    void SetDelay(size_t band, float delay)
+    {
+        delay *= 0.98f;
+        delay_[band] = 1.0f + delay * 959.0f;
+        lfo_amp_[band] = fminf(lfo_amp_[band], delay_[band]);
+    }
+
+    /** Mask of every band, for Process() */
+    static const unsigned kAllBands = (1u << Bands) - 1;
+
+    /** Flange one frame: in[b] is band b's input, out[b] its output. Only
+        the bands set in active (bit b for band b) are run; a skipped band's
+        LFO holds still, it writes silence to its line and its out[] is
+        left alone, so it comes back as a band whose input was muted. */
+    inline void Process(const float* in, float* out, unsigned active = kAllBands)
+    {
+        // Read every band's head before the shared write, as each Flanger
+        // reads its own line before writing it
+        float delayed[Bands];
+        for (size_t b = 0; b < Bands; b++) {
+            if (active & (1u << b)) {
+                delayed[b] = Read(b, 1.0f + ProcessLfo(b) + delay_[b]);
+            }
+        }
+
+        float* row = line_[write_ptr_];
+        for (size_t b = 0; b < Bands; b++) {
+            if (active & (1u << b)) {
+                row[b] = in[b] + delayed[b] * feedback_[b];
+                out[b] = (in[b] + delayed[b]) * 0.5f;
+            } else {
+                row[b] = 0.0f;
+            }
+        }
+
+        write_ptr_ = (write_ptr_ - 1 + kDelayLength) % kDelayLength;
+    }
+
+  private:
+    static inline float Clamp(float x, float lo, float hi)
+    {
+        return x < lo ? lo : (x > hi ? hi : x);
+    }
+
+    /** Triangle LFO in [-1, 1] scaled by the band's depth */
+    inline float ProcessLfo(size_t b)
+    {
+        lfo_phase_[b] += lfo_freq_[b];
+
+        // Wrap around and flip direction
+        if (lfo_phase_[b] > 1.0f) {
+            lfo_phase_[b] = 1.0f - (lfo_phase_[b] - 1.0f);
+            lfo_freq_[b] *= -1.0f;
+        } else if (lfo_phase_[b] < -1.0f) {
+            lfo_phase_[b] = -1.0f - (lfo_phase_[b] + 1.0f);
+            lfo_freq_[b] *= -1.0f;
+        }
+
+        return lfo_phase_[b] * lfo_amp_[b];
+    }
+
+    /** Linearly interpolated read, delay in samples behind the write head */
+    inline float Read(size_t b, float delay) const
+    {
+        size_t whole = (size_t)delay;
+        float frac = delay - (float)whole;
+        if (whole >= kDelayLength) {
+            whole = kDelayLength - 1;
+        }
+
+        float a = line_[(write_ptr_ + whole) % kDelayLength][b];
+        float c = line_[(write_ptr_ + whole + 1) % kDelayLength][b];
+        return a + (c - a) * frac;
+    }
+
+    float sample_rate_ = 48000.0f;
+
+    float line_[kDelayLength][Bands];
+    size_t write_ptr_ = 0;
+
+    float feedback_[Bands];
+    float delay_[Bands];
+    float lfo_amp_[Bands];
+    float lfo_phase_[Bands];
+    float lfo_freq_[Bands];
+};
+
+#endif  // MULTIBAND_FLANGER_H
@@ -4,49 +4,95 @@
 #include <complex>
 #include <numbers>
 
+#include <gcem.hpp>
+
 #include "FastSqrt.h"
 
+// The voices a shifter computes: or them together for update()
+enum OctaveOutputs : unsigned
+{
+    OCTAVE_UP1 = 1,
+    OCTAVE_DOWN1 = 2,
+    OCTAVE_DOWN2 = 4,
+    OCTAVE_DOWN = OCTAVE_DOWN1 | OCTAVE_DOWN2, // Either needs down1's phase
+    OCTAVE_ALL = OCTAVE_UP1 | OCTAVE_DOWN,
+};
+
 //=============================================================================
 class BandShifter
 {
 public:
     BandShifter() = default;
 
-    BandShifter(float center, float sample_rate, float bw)
+    // Filter coefficients, computed in double precision and rounded to
+    // float. constexpr (gcem), so banks of them can be built at compile time;
+    // shared with the structure-of-arrays bank in OctaveGenerator.
+    struct Coefficients
+    {
+        float d0;
+        std::complex<float> d1;
+        std::complex<float> d2;
+        std::complex<float> c1;
+        std::complex<float> c2;
+    };
+
+    static constexpr Coefficients coefficients(float center, float sample_rate, float bw)
     {
         constexpr auto pi = std::numbers::pi_v<double>;
-        constexpr auto j = std::complex<double>(0, 1);
-
-        const auto w0 = pi * bw / sample_rate;
-        const auto cos_w0 = std::cos(w0);
-        const auto sin_w0 = std::sin(w0);
-        const auto sqrt_2 = std::sqrt(2.0);
-        const auto a0 = (1 + sqrt_2 * sin_w0 / 2);
-        const auto g = (1 - cos_w0) / (2 * a0);
-
-        const auto w1 = 2 * pi * center / sample_rate;
-        const auto e1 = std::exp(j * w1);
-        const auto e2 = std::exp(j * w1 * 2.0);
-
-        const auto d0 = g;
-        const auto d1 = e1 * 2.0 * g;
-        const auto d2 = e2 * g;
-        const auto c1 = e1 * (-2 * cos_w0) / a0;
-        const auto c2 = e2 * (1 - sqrt_2 * sin_w0 / 2) / a0;
-
-        _d0 = d0;
-        _d1 = std::complex<float>(d1.real(), d1.imag());
-        _d2 = std::complex<float>(d2.real(), d2.imag());
-        _c1 = std::complex<float>(c1.real(), c1.imag());
-        _c2 = std::complex<float>(c2.real(), c2.imag());
+
+        const double w0 = pi * bw / sample_rate;
+        const double cos_w0 = gcem::cos(w0);
+        const double sin_w0 = gcem::sin(w0);
+        const double sqrt_2 = gcem::sqrt(2.0);
+        const double a0 = (1 + sqrt_2 * sin_w0 / 2);
+        const double g = (1 - cos_w0) / (2 * a0);
+
+        // e1 = exp(j*w1), e2 = exp(j*2*w1)
+        const double w1 = 2 * pi * center / sample_rate;
+        const double e1_re = gcem::cos(w1);
+        const double e1_im = gcem::sin(w1);
+        const double e2_re = gcem::cos(w1 * 2.0);
+        const double e2_im = gcem::sin(w1 * 2.0);
+
+        const double c1_scale = -2 * cos_w0;
+        const double c2_scale = 1 - sqrt_2 * sin_w0 / 2;
+
+        Coefficients c{};
+        c.d0 = static_cast<float>(g);
+        c.d1 = std::complex<float>(static_cast<float>(e1_re * 2.0 * g), static_cast<float>(e1_im * 2.0 * g));
+        c.d2 = std::complex<float>(static_cast<float>(e2_re * g), static_cast<float>(e2_im * g));
+        c.c1 = std::complex<float>(static_cast<float>(e1_re * c1_scale / a0), static_cast<float>(e1_im * c1_scale / a0));
+        c.c2 = std::complex<float>(static_cast<float>(e2_re * c2_scale / a0), static_cast<float>(e2_im * c2_scale / a0));
+        return c;
     }
 
+    BandShifter(float center, float sample_rate, float bw)
+    {
+        const auto c = coefficients(center, sample_rate, bw);
+        _d0 = c.d0;
+        _d1 = c.d1;
+        _d2 = c.d2;
+        _c1 = c.c1;
+        _c2 = c.c2;
+    }
+
+    // Outputs not asked for keep their last values
+    template <unsigned Outputs = OCTAVE_ALL>
     void update(float sample)
     {
         update_filter(sample);
-        update_up1();
-        update_down1();
-        update_down2();
+        if constexpr ((Outputs & OCTAVE_UP1) != 0)
+        {
+            update_up1();
+        }
+        if constexpr ((Outputs & OCTAVE_DOWN) != 0)
+        {
+            update_down1();
+        }
+        if constexpr ((Outputs & OCTAVE_DOWN2) != 0)
+        {
+            update_down2();
+        }
     }
 
     float up1() const {
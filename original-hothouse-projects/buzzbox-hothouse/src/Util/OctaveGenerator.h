@@ -2,34 +2,212 @@
 
 #include "BandShifter.h"
 
+#include <array>
+
 #include <gcem.hpp>
 
+#include "hothouse_tcm.h"
+
 //=============================================================================
+// Bank of 80 BandShifters, stored structure-of-arrays: each coefficient and
+// state term is its own contiguous float array. update() runs all the band
+// filters in one branch-free pass, then the octave shifts of the bands not
+// culled (see setCullThreshold()). Per band this computes exactly what
+// BandShifter::update() does, for the outputs update() is asked for.
 class OctaveGenerator
 {
 public:
-    OctaveGenerator(float sample_rate)
+    static constexpr int num_bands = 80;
+
+    // Per-update decay of the culling envelope (of |y|^2): about 60 ms at
+    // the 8 kHz octave rate
+    static constexpr float cull_release = 0.996f;
+
+    // The bank's coefficients. Build them at compile time with
+    //   static constexpr auto coeffs = OctaveGenerator::coefficients(rate);
+    struct Coefficients
+    {
+        std::array<float, num_bands> d0;
+        std::array<float, num_bands> d1_re;
+        std::array<float, num_bands> d1_im;
+        std::array<float, num_bands> d2_re;
+        std::array<float, num_bands> d2_im;
+        std::array<float, num_bands> c1_re;
+        std::array<float, num_bands> c1_im;
+        std::array<float, num_bands> c2_re;
+        std::array<float, num_bands> c2_im;
+    };
+
+    static constexpr Coefficients coefficients(float sample_rate)
     {
-        for (int i = 0; i < 80; ++i)
+        Coefficients bank{};
+        for (int i = 0; i < num_bands; ++i)
         {
             const auto center = centerFreq(i);
             const auto bw = bandwidth(i);
-            _shifters.emplace_back(center, sample_rate, bw);
+            const auto c = BandShifter::coefficients(center, sample_rate, bw);
+            bank.d0[i] = c.d0;
+            bank.d1_re[i] = c.d1.real();
+            bank.d1_im[i] = c.d1.imag();
+            bank.d2_re[i] = c.d2.real();
+            bank.d2_im[i] = c.d2.imag();
+            bank.c1_re[i] = c.c1.real();
+            bank.c1_im[i] = c.c1.imag();
+            bank.c2_re[i] = c.c2.real();
+            bank.c2_im[i] = c.c2.imag();
+        }
+        return bank;
+    }
+
+    // Copies a coefficient table into the bank (the hot loop reads RAM)
+    explicit OctaveGenerator(const Coefficients& c)
+    {
+        for (int i = 0; i < num_bands; ++i)
+        {
+            _d0[i] = c.d0[i];
+            _d1_re[i] = c.d1_re[i];
+            _d1_im[i] = c.d1_im[i];
+            _d2_re[i] = c.d2_re[i];
+            _d2_im[i] = c.d2_im[i];
+            _c1_re[i] = c.c1_re[i];
+            _c1_im[i] = c.c1_im[i];
+            _c2_re[i] = c.c2_re[i];
+            _c2_im[i] = c.c2_im[i];
+            _down1_sign[i] = 1;
+            _down2_sign[i] = 1;
+        }
+    }
+
+    // Computes the table at run time, for a sample rate known only then
+    explicit OctaveGenerator(float sample_rate)
+        : OctaveGenerator(coefficients(sample_rate))
+    {
+    }
+
+    // Band culling: a band whose filter output envelope has dropped below
+    // threshold (linear amplitude) skips the octave maths, which is most of
+    // the cost; its filter keeps running so it comes back without a
+    // transient as soon as it picks up energy. Bands switch off at half the
+    // threshold (hysteresis). 0 (the default) runs every band.
+    void setCullThreshold(float threshold)
+    {
+        _cull_on = threshold * threshold;
+        _cull_off = 0.25f * _cull_on;
+    }
+
+    // Bands that ran the octave maths on the last update()
+    int activeBands() const
+    {
+        return _num_active;
+    }
+
+    // Outputs (OctaveOutputs, or'd) picks the voices to compute; the others
+    // read 0 and skip their maths, including the sub-octave phase tracking
+    // when no octave down is asked for. A voice switched back on may start
+    // with its sign flipped (the sign tracking has no fixed reference).
+    template <unsigned Outputs = OCTAVE_ALL>
+    HOTHOUSE_ITCM void update(float sample)
+    {
+        // Pass 1: every band's filter, its envelope, and the list of bands
+        // worth shifting. Branch-free.
+        int num_active = 0;
+        for (int i = 0; i < num_bands; ++i)
+        {
+            _active[num_active] = i;
+            num_active += updateFilter<(Outputs & OCTAVE_DOWN) != 0>(i, sample);
+        }
+        _num_active = num_active;
+
+        // Pass 2: octave shifts of the active bands
+        float up1 = 0;
+        float down1 = 0;
+        float down2 = 0;
+
+        for (int n = 0; n < num_active; ++n)
+        {
+            const int i = _active[n];
+            const float y_re = _y_re[i];
+            const float y_im = _y_im[i];
+
+            // Octave up, see BandShifter::update_up1()
+            const float mag2 = y_re*y_re + y_im*y_im;
+            const float inv_mag = fastInvSqrt(mag2);
+            if constexpr ((Outputs & OCTAVE_UP1) != 0)
+            {
+                up1 += (y_re*y_re - y_im*y_im) * inv_mag;
+            }
+
+            if constexpr ((Outputs & OCTAVE_DOWN) != 0)
+            {
+                // Octave down, see BandShifter::update_down1()
+                const float down1_sign = _down1_sign[i];
+                const float b_sign = (y_im < 0) ? -1.0f : 1.0f;
+                const float x = 0.5f * y_re * inv_mag;
+                const float c = fastSqrt(0.5f + x);
+                const float d = b_sign * fastSqrt(0.5f - x);
+                const float down1_re = down1_sign * (y_re*c + y_im*d);
+                if constexpr ((Outputs & OCTAVE_DOWN1) != 0)
+                {
+                    down1 += down1_re;
+                }
+
+                if constexpr ((Outputs & OCTAVE_DOWN2) != 0)
+                {
+                    const float prev_down1_im = _down1_im[i];
+                    const float down1_im = down1_sign * (y_im*c - y_re*d);
+                    _down1_im[i] = down1_im;
+
+                    const bool flip2 = (down1_re < 0) && (std::signbit(down1_im) != std::signbit(prev_down1_im));
+                    const float down2_sign = flip2 ? -_down2_sign[i] : _down2_sign[i];
+                    _down2_sign[i] = down2_sign;
+
+                    // Two octaves down, see BandShifter::update_down2()
+                    const float d1_sign = (down1_im < 0) ? -1.0f : 1.0f;
+                    const float x2 = 0.5f * down1_re * fastInvSqrt(down1_re*down1_re + down1_im*down1_im);
+                    const float c2 = fastSqrt(0.5f + x2);
+                    const float d2 = d1_sign * fastSqrt(0.5f - x2);
+                    down2 += down2_sign * (down1_re*c2 + down1_im*d2);
+                }
+            }
         }
+
+        _up1 = up1;
+        _down1 = down1;
+        _down2 = down2;
     }
 
-    void update(float sample)
+    // Warm-keeping while the octave is off: runs only the filters of the
+    // lowest bands (the narrowest, slowest to settle) and no octave
+    // maths. The outputs keep their last values.
+    void updateWarm(float sample, int bands)
     {
-        _up1 = 0;
-        _down1 = 0;
-        _down2 = 0;
+        for (int i = 0; i < bands; ++i)
+        {
+            updateFilter(i, sample);
+        }
+    }
 
-        for (auto& shifter : _shifters)
+    // Fast settle on engage after updateWarm(): clears the state the warm
+    // updates left stale, the filters above the warm bands and the octave
+    // shifts' phase tracking of all bands, so nothing rings from before
+    void settle(int warm_bands)
+    {
+        for (int i = 0; i < num_bands; ++i)
         {
-            shifter.update(sample);
-            _up1 += shifter.up1();
-            _down1 += shifter.down1();
-            _down2 += shifter.down2();
+            if (i >= warm_bands)
+            {
+                _s1_re[i] = 0;
+                _s1_im[i] = 0;
+                _s2_re[i] = 0;
+                _s2_im[i] = 0;
+                _y_re[i] = 0;
+                _y_im[i] = 0;
+                _down1_sign[i] = 1;
+                _envelope[i] = 0;
+                _band_on[i] = false;
+            }
+            _down1_im[i] = 0;
+            _down2_sign[i] = 1;
         }
     }
 
@@ -49,6 +227,39 @@ public:
     }
 
 private:
+    // One band's complex band-pass filter, down1 sign tracking (unless
+    // TrackDown1 is false) and culling envelope; returns whether the band is
+    // on
+    template <bool TrackDown1 = true>
+    bool updateFilter(int i, float sample)
+    {
+        // Complex band-pass filter, see BandShifter::update_filter()
+        const float prev_y_im = _y_im[i];
+        const float y_re = _s2_re[i] + _d0[i]*sample;
+        const float y_im = _s2_im[i];
+        _s2_re[i] = _s1_re[i] + _d1_re[i]*sample - (_c1_re[i]*y_re - _c1_im[i]*y_im);
+        _s2_im[i] = _s1_im[i] + _d1_im[i]*sample - (_c1_re[i]*y_im + _c1_im[i]*y_re);
+        _s1_re[i] = _d2_re[i]*sample - (_c2_re[i]*y_re - _c2_im[i]*y_im);
+        _s1_im[i] = _d2_im[i]*sample - (_c2_re[i]*y_im + _c2_im[i]*y_re);
+        _y_re[i] = y_re;
+        _y_im[i] = y_im;
+
+        if constexpr (TrackDown1)
+        {
+            const bool flip1 = (y_re < 0) && (std::signbit(y_im) != std::signbit(prev_y_im));
+            _down1_sign[i] = flip1 ? -_down1_sign[i] : _down1_sign[i];
+        }
+
+        // Peak-hold envelope of |y|^2 and hysteresis
+        const float mag2 = y_re*y_re + y_im*y_im;
+        const float decayed = _envelope[i] * cull_release;
+        const float envelope = mag2 > decayed ? mag2 : decayed;
+        _envelope[i] = envelope;
+        const bool on = _band_on[i] ? envelope >= _cull_off : envelope > _cull_on;
+        _band_on[i] = on;
+        return on;
+    }
+
     static constexpr float centerFreq(const int n)
     {
         return 480 * gcem::pow(2.0f, (0.027f * n)) - 420;
@@ -64,7 +275,37 @@ private:
         return 2.0f * (a*b) / (a+b);
     }
 
-    std::vector<BandShifter> _shifters;
+    // Coefficients
+    float _d0[num_bands];
+    float _d1_re[num_bands];
+    float _d1_im[num_bands];
+    float _d2_re[num_bands];
+    float _d2_im[num_bands];
+    float _c1_re[num_bands];
+    float _c1_im[num_bands];
+    float _c2_re[num_bands];
+    float _c2_im[num_bands];
+
+    // State. Of y and down1, only the imaginary parts are needed from one
+    // sample to the next, for the phase-wrap sign tracking; _y_re is
+    // scratch between the two passes.
+    float _s1_re[num_bands] = {};
+    float _s1_im[num_bands] = {};
+    float _s2_re[num_bands] = {};
+    float _s2_im[num_bands] = {};
+    float _y_re[num_bands] = {};
+    float _y_im[num_bands] = {};
+    float _down1_im[num_bands] = {};
+    float _down1_sign[num_bands];
+    float _down2_sign[num_bands];
+
+    // Culling
+    float _envelope[num_bands] = {};
+    bool _band_on[num_bands] = {};
+    int _active[num_bands];
+    int _num_active = 0;
+    float _cull_on = 0;
+    float _cull_off = 0;
 
     float _up1 = 0;
     float _down1 = 0;
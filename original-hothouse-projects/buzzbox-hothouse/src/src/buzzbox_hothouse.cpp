@@ -13,11 +13,17 @@
 #include "daisy_seed.h"
 #include "daisysp.h"
 #include "hothouse.h"
+#include "hothouse_chain.h"
+#include "hothouse_tuner.h"
 #include "buzzbox_hothouse.h"
+#include "settings_log.h"
+#include "preset_block.h"
+#include <cstring>
 
 #include <q/support/literals.hpp>
 #include <q/fx/biquad.hpp>
 #include "Util/Multirate.h"
+#include "Util/HilbertOctave.h"
 #include "Util/OctaveGenerator.h"
 namespace q = cycfi::q;
 using namespace q::literals;
@@ -36,16 +42,66 @@ Adsr autowah_adsr;
 Svf autowah_svf;
 ATone autowah_detector_hpf;  // High-pass filter for envelope detection (evens out frequency response)
 EnvelopeFollower envelopeFollower;
+FuzzProcessor fuzz;
+Oversampler4x fuzz_oversampler;
+
+// FUZZ_LOW_CPU=1 (Makefile) swaps the 4x fuzz for the 1x ADAA table shaper
+// while autowah and octave are both running
+#ifndef BUZZBOX_FUZZ_LOW_CPU
+#define BUZZBOX_FUZZ_LOW_CPU 0
+#endif
+#if BUZZBOX_FUZZ_LOW_CPU
+FuzzShaperADAA fuzz_low_cpu;
+#endif
+
+// Audio block staging for the stage chain
+constexpr size_t BLOCK_SIZE = 256;  // Larger block size for efficiency
+// Block size per boot-time profile (hold both footswitches at power-up);
+// BLOCK_SIZE sizes the buffers
+const Hothouse::AudioProfileTable audio_profiles = {
+    {{48, SaiHandle::Config::SampleRate::SAI_48KHZ},
+     {128, SaiHandle::Config::SampleRate::SAI_48KHZ},
+     {BLOCK_SIZE, SaiHandle::Config::SampleRate::SAI_48KHZ}},
+    Hothouse::AUDIO_PROFILE_MAX_HEADROOM};
+float wet_block[BLOCK_SIZE];        // The signal being run through the chain
+float pre_fuzz_block[BLOCK_SIZE];   // Signal entering the fuzz stage (for its gate)
+float oversampled_block[BLOCK_SIZE * OVERSAMPLING_FACTOR];
+
+// Signal probe (make PROBE=1): the fuzz's 4x output, before it is brought
+// back down, the last 0.5 s
+constexpr size_t PROBE_FRAMES = 96000;
+int probe_fuzz_4x = -1;
 
 // Octave processing objects
-static Decimator2 decimate;
+static Decimator2 HOTHOUSE_DTCM_BSS decimate;
 static Interpolator interpolate;
 static const auto sample_rate_temp = 48000;
-static OctaveGenerator octave(sample_rate_temp / resample_factor);
+static constexpr auto octave_coefficients = OctaveGenerator::coefficients(sample_rate_temp / resample_factor);
+static OctaveGenerator HOTHOUSE_DTCM_BSS octave(octave_coefficients);
 float octave_buff[6];
 float octave_buff_out[6];
 int octave_bin_counter = 0;
 
+// While the octave is off only the decimator and the lowest bands keep
+// running (updateWarm); engaging settles the rest and fades the octave
+// in, disengaging fades it out before the stage drops from the chain
+constexpr int OCTAVE_WARM_BANDS = 16;              // Up to ~215 Hz
+constexpr float OCTAVE_FADE_STEP = 1.0f / 240.0f;  // 5ms @ 48kHz
+float octave_fade = 0.0f;
+bool octave_running = false;  // Full bank ran on the last update
+
+// HILBERT_OCTAVE=1 (Makefile): with the down octave turned all the way
+// down, the octave up comes from one analytic signal (Util/HilbertOctave.h)
+// and the bank only keeps warm, as when the octave is off. A fraction of the
+// bank's cycles; chords intermodulate.
+#ifndef BUZZBOX_HILBERT_OCTAVE
+#define BUZZBOX_HILBERT_OCTAVE 0
+#endif
+#if BUZZBOX_HILBERT_OCTAVE
+static HilbertOctave octave_up_lite(sample_rate_temp / resample_factor);
+constexpr float HILBERT_DOWN_LEVEL = 0.02f;  // Down octave knob below this
+#endif
+
 // Control variables
 float knobValues[6] = {0.0f};
 float prevKnobValues[6] = {0.0f};
@@ -76,6 +132,77 @@ Led led1, led2;
 // First start flag for initialization
 bool first_start = true;
 
+// Working-state persistence: the page-dependent K4-K6 parameters as one
+// shared PresetBlock, saved once the controls have been still for
+// SETTINGS_SAVE_DELAY_MS. Recall goes through the SRAM shadow: the main
+// loop publishes a block, the callback takes it and glides to it.
+enum BuzzBoxParam {
+    PARAM_DRIVE,
+    PARAM_TONE_FREQ,
+    PARAM_GATE_THRESHOLD,
+    PARAM_AUTOWAH_SPEED,
+    PARAM_AUTOWAH_RANGE,
+    PARAM_AUTOWAH_THRESHOLD,
+    PARAM_OCTAVE_UP,
+    PARAM_OCTAVE_DOWN,
+    PARAM_OCTAVE_MIX,
+    NUM_PRESET_PARAMS
+};
+typedef PresetBlock<NUM_PRESET_PARAMS> BuzzBoxPreset;
+
+// Live value behind each BuzzBoxParam, in enum order
+float* const preset_params[NUM_PRESET_PARAMS] = {
+    &drive_amount,
+    &tone_freq,
+    &gate_threshold,
+    &autowah_speed,
+    &autowah_range,
+    &autowah_threshold,
+    &octave_up_level,
+    &octave_down_level,
+    &octave_mix,
+};
+
+const uint16_t PRESET_SCHEMA = 1;
+const int PRESET_RAMP_BLOCKS = 8;  // ~43ms glide at 256-sample blocks, scaled to the profile
+PresetShadow<NUM_PRESET_PARAMS> preset_shadow;
+PresetSmoother<NUM_PRESET_PARAMS> preset_smoother;
+bool preset_recalled = false;  // Callback took a preset; hold it until a knob moves
+
+const uint32_t SETTINGS_VERSION = 2;  // 2: PresetBlock layout
+const uint32_t SETTINGS_OFFSET = 0x7F0000;  // Top 64KB of the 8MB QSPI
+const uint32_t SETTINGS_SAVE_DELAY_MS = 1000;
+SettingsLog<BuzzBoxPreset> settings_log;
+
+BuzzBoxPreset currentPreset() {
+    BuzzBoxPreset p;
+    p.Init(PRESET_SCHEMA);
+    for (int i = 0; i < NUM_PRESET_PARAMS; i++) {
+        p.params[i] = *preset_params[i];
+    }
+    return p;
+}
+
+void applyAutowahSpeed() {
+    float attack_time = 0.01f + (autowah_speed * 0.19f);   // 10ms to 200ms
+    float release_time = 0.02f + (autowah_speed * 0.38f);  // 20ms to 400ms
+    autowah_adsr.SetAttackTime(attack_time);
+    autowah_adsr.SetReleaseTime(release_time);
+}
+
+// Callback only: picks up a newly published preset and steps the glide
+void processPresetRecall() {
+    const BuzzBoxPreset* recalled = preset_shadow.Take();
+    if (recalled) {
+        preset_smoother.Start(*recalled, first_start);  // Nothing to glide from at power-on
+        preset_recalled = true;
+        applyAutowahSpeed();
+    }
+    if (preset_smoother.Process()) {
+        applyAutowahSpeed();
+    }
+}
+
 void updateSwitch1() {
     // Switch 1: Autowah Placement
     // UP (0) = before fuzz, MIDDLE (1) = after fuzz, DOWN (2) = after everything
@@ -136,10 +263,7 @@ void updateSwitch3() {
             // Knob 4: Attack/Release Speed (linked)
             if (knob_touched[3]) {
                 autowah_speed = knobValues[3];
-                float attack_time = 0.01f + (autowah_speed * 0.19f);   // 10ms to 200ms
-                float release_time = 0.02f + (autowah_speed * 0.38f);  // 20ms to 400ms
-                autowah_adsr.SetAttackTime(attack_time);
-                autowah_adsr.SetReleaseTime(release_time);
+                applyAutowahSpeed();
             }
             // Knob 5: Filter Range (shifts base 300-2000Hz range)
             if (knob_touched[4]) {
@@ -168,12 +292,17 @@ void updateSwitch3() {
     }
 }
 
+// FS2 held for TUNER_HOLD_MS: the tuner, muted, in place of the effects
+// (Tuner, lib/hothouse/hothouse_tuner.h); any footswitch press leaves it
+constexpr uint32_t TUNER_HOLD_MS = 1000;
+Tuner tuner;
+bool fs2_hold_handled = true;  // No tuner from a switch held since boot
+bool fs2_autowah_before = false;
+bool fs2_octave_before = false;
+
 void UpdateLEDs() {
-    led1.Set(fuzz_enabled ? 1.0f : 0.0f);
-    led2.Set((autowah_enabled || octave_enabled) ? 1.0f : 0.0f);
-    
-    led1.Update();
-    led2.Update();
+    hw.SetLed(Hothouse::LED_1, fuzz_enabled ? 1.0f : 0.0f);
+    hw.SetLed(Hothouse::LED_2, hw.LoadLed((autowah_enabled || octave_enabled) ? 1.0f : 0.0f));
 }
 
 void ProcessControls() {
@@ -187,6 +316,16 @@ void ProcessControls() {
     knobValues[4] = hw.GetKnobValue(Hothouse::KNOB_5);
     knobValues[5] = hw.GetKnobValue(Hothouse::KNOB_6);
     
+    // A recalled preset holds until a knob actually moves from where it
+    // sits now
+    if (preset_recalled) {
+        for(int i = 3; i < 6; i++) {
+            knob_touched[i] = false;
+            prevKnobValues[i] = knobValues[i];
+        }
+        preset_recalled = false;
+    }
+    
     // Detect knob movement for touch-to-activate behavior
     // Only check knobs 4-6 (context-dependent knobs)
     for(int i = 3; i < 6; i++) {
@@ -234,6 +373,15 @@ void ProcessControls() {
     
     first_start = false;
     
+    if (tuner.Active()) {
+        if (hw.switches[Hothouse::FOOTSWITCH_1].RisingEdge()
+            || hw.switches[Hothouse::FOOTSWITCH_2].RisingEdge()) {
+            tuner.Stop();
+            fs2_hold_handled = true;
+        }
+        return;  // The tuner has the LEDs
+    }
+    
     // Footswitch 1: Fuzz On/Off
     if (hw.switches[Hothouse::FOOTSWITCH_1].RisingEdge()) {
         fuzz_enabled = !fuzz_enabled;
@@ -241,6 +389,9 @@ void ProcessControls() {
     
     // Footswitch 2: Autowah/Octave based on Switch 2
     if (hw.switches[Hothouse::FOOTSWITCH_2].RisingEdge()) {
+        fs2_hold_handled = false;
+        fs2_autowah_before = autowah_enabled;
+        fs2_octave_before = octave_enabled;
         switch(toggleValues[1]) {
             case 0: { // UP: Both
                 bool new_state = !(autowah_enabled || octave_enabled);
@@ -259,229 +410,410 @@ void ProcessControls() {
         }
     }
     
+    // A long FS2 hold starts the tuner instead, undoing the press's toggle
+    if (hw.switches[Hothouse::FOOTSWITCH_2].Pressed() && !fs2_hold_handled
+        && hw.switches[Hothouse::FOOTSWITCH_2].TimeHeldMs() >= TUNER_HOLD_MS) {
+        fs2_hold_handled = true;
+        autowah_enabled = fs2_autowah_before;
+        octave_enabled = fs2_octave_before;
+        tuner.Start();
+        return;
+    }
+    
     UpdateLEDs();
 }
 
-void AudioCallback(AudioHandle::InputBuffer in, AudioHandle::OutputBuffer out, size_t size) {
-    ProcessControls();
+// Autowah sweep update interval in samples (AUTOWAH_INTERVAL in the
+// Makefile). 1 = per sample. Larger values run the ADSR at control rate and
+// only recompute the SVF's coefficients (sinf/powf in SetFreq) once per
+// interval; the detector and filter still run every sample.
+#ifndef BUZZBOX_AUTOWAH_INTERVAL
+#define BUZZBOX_AUTOWAH_INTERVAL 1
+#endif
+constexpr int AUTOWAH_INTERVAL = BUZZBOX_AUTOWAH_INTERVAL;
+int autowah_tick = 0;
+
+// ANALYSIS_BUS=1 (Makefile) runs the autowah detector on the shared 8kHz
+// analysis bus instead of at 48kHz: the input-gained signal is decimated
+// once per 6 samples, the octave generator reads the same samples when it
+// sits directly after the input gain, and the detector HPF, envelope
+// follower and ADSR tick once per bus sample (AUTOWAH_INTERVAL is then
+// fixed at 6). The detector always listens to the pre-fuzz signal.
+#ifndef BUZZBOX_ANALYSIS_BUS
+#define BUZZBOX_ANALYSIS_BUS 0
+#endif
+#if BUZZBOX_ANALYSIS_BUS
+float analysis_bus[BLOCK_SIZE / resample_factor + 1];  // This block's 8kHz samples
+float analysis_bus_buff[6];
+size_t analysis_bus_count = 0;
+float autowah_envelope[BLOCK_SIZE / resample_factor + 1];  // The detector's envelope per bus sample
+int block_resample_phase = 0;  // octave_bin_counter at the start of the block
+static Decimator2 octave_decimate;  // Octave input when autowah sits before it
+#endif
+
+// Gate the ADSR from the detector envelope and sweep the SVF from it
+void updateAutowahSweep(float envelope) {
+    // Gate ADSR based on envelope level and threshold (lowered for HPF compensation)
+    // When threshold is at 0, gate is always open (static filter at sustain level)
+    bool gate;
+    if (autowah_threshold > 0.01f) {
+        float gate_level = 0.01f + (autowah_threshold * 0.11f); // 0.01 to 0.12
+        gate = (envelope > gate_level);
+    } else {
+        gate = true;  // Gate always open - static filter
+    }
+    float adsr_out = autowah_adsr.Process(gate);
     
-    // Global true bypass - if no effects are active, pass clean signal
-    bool any_effect_active = fuzz_enabled || autowah_enabled || octave_enabled;
+    // Map ADSR output to filter frequency with range control
+    // Base range: 300-2000Hz
+    // Range knob shifts this: CCW = 100-1100Hz, CW = 300-3000Hz
+    float range_min = 100.0f + (autowah_range * 200.0f);  // 100-300Hz
+    float range_max = 1100.0f + (autowah_range * 1900.0f); // 1100-3000Hz
     
-    if (!any_effect_active) {
-        // True bypass - pass input directly to output, no processing
-        for (size_t i = 0; i < size; i++) {
-            out[0][i] = in[0][i];
-            out[1][i] = in[1][i];
-        }
-        return;
+    float filter_freq = range_min + (adsr_out * (range_max - range_min));
+    
+    // Resonance is fixed at 0.7 (set in main)
+    autowah_svf.SetFreq(filter_freq);
+}
+
+// Process through SVF and use bandpass output with gain compensation
+inline float autowahFilter(float signal) {
+    autowah_svf.Process(signal);
+    return autowah_svf.Band() * 2.0f;  // Autowah makeup gain
+}
+
+// Autowah: the HPF'd envelope gates the ADSR, which sweeps the SVF bandpass
+float processAutowah(float signal) {
+    // High-pass filter for envelope detection (removes bass dominance)
+    float detection_signal = autowah_detector_hpf.Process(signal);
+    float envelope = envelopeFollower.Process(detection_signal);
+    
+    if (autowah_tick == 0) {
+        updateAutowahSweep(envelope);
+    }
+    if (++autowah_tick >= AUTOWAH_INTERVAL) {
+        autowah_tick = 0;
     }
     
-    // At least one effect is active - proceed with normal processing
+    return autowahFilter(signal);
+}
+
+// =============================================================================
+// BLOCK STAGES - the effect chain, run one whole block per stage
+// =============================================================================
+
+// STAGE 1: Input Gain (Knob 1) - affects everything
+void inputGainStage(float* buf, size_t size) {
+    const float input_gain = 0.5f + (knobValues[0] * 1.5f); // 0.5x to 2.0x
     for (size_t i = 0; i < size; i++) {
-        float input = in[0][i];
-        float signal = input;
-        
-        // STAGE 1: Input Gain (Knob 1) - affects everything
-        const float input_gain = 0.5f + (knobValues[0] * 1.5f); // 0.5x to 2.0x
-        signal *= input_gain;
-        
-        // STAGE 2: Autowah BEFORE fuzz (if placement is UP and enabled)
-        if (autowah_enabled && autowah_placement == 0) {
-            // High-pass filter for envelope detection (removes bass dominance)
-            float detection_signal = autowah_detector_hpf.Process(signal);
-            float envelope = envelopeFollower.Process(detection_signal);
-            
-            // Gate ADSR based on envelope level and threshold (lowered for HPF compensation)
-            // When threshold is at 0, gate is always open (static filter at sustain level)
-            bool gate;
-            if (autowah_threshold > 0.01f) {
-                float gate_level = 0.01f + (autowah_threshold * 0.11f); // 0.01 to 0.12
-                gate = (envelope > gate_level);
-            } else {
-                gate = true;  // Gate always open - static filter
-            }
-            float adsr_out = autowah_adsr.Process(gate);
-            
-            // Map ADSR output to filter frequency with range control
-            // Base range: 300-2000Hz
-            // Range knob shifts this: CCW = 100-1100Hz, CW = 300-3000Hz
-            float range_min = 100.0f + (autowah_range * 200.0f);  // 100-300Hz
-            float range_max = 1100.0f + (autowah_range * 1900.0f); // 1100-3000Hz
-            
-            float filter_freq = range_min + (adsr_out * (range_max - range_min));
-            
-            autowah_svf.SetFreq(filter_freq);
-            autowah_svf.SetRes(0.7f);
-            
-            // Process through SVF and use bandpass output with gain compensation
-            autowah_svf.Process(signal);
-            signal = autowah_svf.Band() * 2.0f;  // Autowah makeup gain
+        buf[i] *= input_gain;
+    }
+}
+
+#if BUZZBOX_ANALYSIS_BUS
+// STAGE 1b: Decimate the input-gained signal onto the 8kHz analysis bus,
+// on the octave's 6-sample grid
+void analysisBusStage(float* buf, size_t size) {
+    int phase = block_resample_phase;
+    analysis_bus_count = 0;
+    for (size_t i = 0; i < size; i++) {
+        analysis_bus_buff[phase] = buf[i];
+        if (phase == 5) {
+            std::span<const float, resample_factor> in_chunk(&(analysis_bus_buff[0]), resample_factor);
+            analysis_bus[analysis_bus_count++] = decimate(in_chunk);
+        }
+        if (++phase >= 6) {
+            phase = 0;
         }
+    }
+}
+
+// The octave generator's input once per 6 samples: the bus sample when
+// nothing sits between it and the input gain, its own decimation otherwise
+inline float octaveInput(size_t& bus_index) {
+    std::span<const float, resample_factor> in_chunk(&(octave_buff[0]), resample_factor);
+    if (autowah_enabled && autowah_placement == 0) {
+        return octave_decimate(in_chunk);
+    }
+    return analysis_bus[bus_index++];
+}
+
+// STAGES 2/5/6: Autowah, at whichever point T1 places it. The detector
+// runs over the whole bus block first; the sweep then updates once per bus
+// sample, at the sample its chunk ends on.
+void autowahStage(float* buf, size_t size) {
+    for (size_t k = 0; k < analysis_bus_count; k++) {
+        autowah_envelope[k] = autowah_detector_hpf.Process(analysis_bus[k]);
+    }
+    envelopeFollower.ProcessBlock(autowah_envelope, analysis_bus_count, autowah_envelope);
+
+    int phase = block_resample_phase;
+    size_t bus_index = 0;
+    for (size_t i = 0; i < size; i++) {
+        if (phase == 5) {
+            updateAutowahSweep(autowah_envelope[bus_index++]);
+        }
+        if (++phase >= 6) {
+            phase = 0;
+        }
+        buf[i] = autowahFilter(buf[i]);
+    }
+}
+#else
+// The octave generator's input once per 6 samples
+inline float octaveInput(size_t&) {
+    std::span<const float, resample_factor> in_chunk(&(octave_buff[0]), resample_factor);
+    return decimate(in_chunk);
+}
+
+// STAGES 2/5/6: Autowah, at whichever point T1 places it
+void autowahStage(float* buf, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        buf[i] = processAutowah(buf[i]);
+    }
+}
+
+// STAGE 1b: No analysis bus in this build
+inline void analysisBusStage(float*, size_t) {}
+#endif
+
+// STAGE 3: Octave processing
+void octaveStage(float* buf, size_t size) {
+    const float fade_target = octave_enabled ? 1.0f : 0.0f;
+    size_t bus_index = 0;
+    for (size_t i = 0; i < size; i++) {
+        // Buffer input for octave processing
+        octave_buff[octave_bin_counter] = buf[i];
         
-        // STAGE 3: Octave processing (if enabled)
-        if (octave_enabled) {
-            // Buffer input for octave processing
-            octave_buff[octave_bin_counter] = signal;
+        // Process octave every 6 samples
+        if (octave_bin_counter == 5) {
+            const float sample = octaveInput(bus_index);
             
-            // Process octave every 6 samples
-            if (octave_bin_counter == 5) {
-                std::span<const float, resample_factor> in_chunk(&(octave_buff[0]), resample_factor);
-                const auto sample = decimate(in_chunk);
-                
-                octave.update(sample);
+            float octave_signal;
+#if BUZZBOX_HILBERT_OCTAVE
+            // Always fed, so it has no stale state to ring when it takes over
+            octave_up_lite.update(sample);
+            if (octave_down_level < HILBERT_DOWN_LEVEL) {
+                octave.updateWarm(sample, OCTAVE_WARM_BANDS);
+                octave_running = false;
+                octave_signal = octave_up_lite.up1() * octave_up_level * 2.5f;
+            } else
+#endif
+            {
+                if (!octave_running) {
+                    octave.settle(OCTAVE_WARM_BANDS);
+                    octave_running = true;
+                }
+                octave.update<OCTAVE_UP1 | OCTAVE_DOWN1>(sample);
                 
                 // Mix up and down octaves with individual level controls
-                float octave_signal = octave.up1() * octave_up_level * 2.5f + 
-                                     octave.down1() * octave_down_level * 2.5f;
-                
-                auto out_chunk = interpolate(octave_signal);
-                for (size_t j = 0; j < out_chunk.size(); ++j) {
-                    // Mix octave with dry based on octave_mix
-                    octave_buff_out[j] = octave_buff[j] * (1.0f - octave_mix) + 
-                                        out_chunk[j] * octave_mix;
-                }
-            }
-            
-            // Use octave-processed signal if available
-            if (octave_bin_counter < 6) {
-                signal = octave_buff_out[octave_bin_counter];
+                octave_signal = octave.up1() * octave_up_level * 2.5f + 
+                                octave.down1() * octave_down_level * 2.5f;
             }
             
-            // Update bin counter
-            octave_bin_counter++;
-            if (octave_bin_counter >= 6) {
-                octave_bin_counter = 0;
+            auto out_chunk = interpolate(octave_signal);
+            for (size_t j = 0; j < out_chunk.size(); ++j) {
+                // Mix octave with dry based on octave_mix
+                octave_buff_out[j] = octave_buff[j] * (1.0f - octave_mix) + 
+                                    out_chunk[j] * octave_mix;
             }
         }
         
-        // STAGE 4: Fuzz (if enabled) - Always AGGRESSIVE type
-        if (fuzz_enabled) {
-            float fuzz_signal = signal;
-            
-            // Bass boost
-            static float bass_lpf = 0.0f;
-            const float bass_coeff = 0.05f;
-            bass_lpf = bass_lpf + bass_coeff * (fuzz_signal - bass_lpf);
-            fuzz_signal = fuzz_signal + (bass_lpf * 0.8f);
-            
-            // Drive control - combines gain and intensity
-            // Map 0-1 knob to gain (1-20x) and intensity (0-1) proportionally
-            const float gain = 1.0f + (drive_amount * 19.0f); // 1x to 20x
-            const float intensity = drive_amount; // 0 to 1
-            fuzz_signal *= gain;
-            
-            // Fuzz with oversampling - 4x for performance
-            std::vector<float> oversampled = Oversampling::upsample(fuzz_signal);
-            for (float& sample : oversampled) {
-                sample = Fuzz::process(sample, FuzzType::AGGRESSIVE, intensity);
-            }
-            fuzz_signal = Oversampling::downsample(oversampled);
-            
-            // Gate control - variable threshold
-            if (gate_threshold > 0.01f) {
-                static float gate_envelope = 0.0f;
-                const float gate_level = gate_threshold * 0.1f; // Scale threshold
-                const float gate_attack = 0.95f;
-                const float gate_release = 0.01f;
-                
-                float input_level = std::abs(signal); // Gate detects pre-fuzz level
-                
-                if (input_level > gate_level) {
-                    gate_envelope += gate_attack * (1.0f - gate_envelope);
-                } else {
-                    gate_envelope += gate_release * (0.0f - gate_envelope);
-                }
-                
-                fuzz_signal *= gate_envelope;
-            }
-            
-            // Tone control
-            tone.SetFreq(tone_freq);
-            fuzz_signal = tone.Process(fuzz_signal);
-            
-            signal = fuzz_signal;
+        // Use octave-processed signal, faded against the dry signal on
+        // engage/disengage
+        if (octave_fade == 1.0f && fade_target == 1.0f) {
+            buf[i] = octave_buff_out[octave_bin_counter];
+        } else {
+            octave_fade = fade_target > octave_fade
+                              ? fminf(octave_fade + OCTAVE_FADE_STEP, 1.0f)
+                              : fmaxf(octave_fade - OCTAVE_FADE_STEP, 0.0f);
+            buf[i] += (octave_buff_out[octave_bin_counter] - buf[i]) * octave_fade;
         }
         
-        // STAGE 5: Autowah AFTER fuzz (if placement is MIDDLE and enabled)
-        if (autowah_enabled && autowah_placement == 1) {
-            // High-pass filter for envelope detection (removes bass dominance)
-            float detection_signal = autowah_detector_hpf.Process(signal);
-            float envelope = envelopeFollower.Process(detection_signal);
+        // Update bin counter
+        octave_bin_counter++;
+        if (octave_bin_counter >= 6) {
+            octave_bin_counter = 0;
+        }
+    }
+}
+
+// Octave off: keeps the decimator, the lowest bands and the interpolator
+// (fed silence) ticking on the same 6-sample grid; buf is left untouched
+void octaveWarmStage(float* buf, size_t size) {
+    size_t bus_index = 0;
+    for (size_t i = 0; i < size; i++) {
+        octave_buff[octave_bin_counter] = buf[i];
+        
+        if (octave_bin_counter == 5) {
+            octave.updateWarm(octaveInput(bus_index), OCTAVE_WARM_BANDS);
+            octave_running = false;
             
-            // Gate ADSR based on envelope level and threshold (lowered for HPF compensation)
-            // When threshold is at 0, gate is always open (static filter at sustain level)
-            bool gate;
-            if (autowah_threshold > 0.01f) {
-                float gate_level = 0.01f + (autowah_threshold * 0.11f); // 0.01 to 0.12
-                gate = (envelope > gate_level);
-            } else {
-                gate = true;  // Gate always open - static filter
+            auto out_chunk = interpolate(0.0f);
+            for (size_t j = 0; j < out_chunk.size(); ++j) {
+                octave_buff_out[j] = octave_buff[j];
             }
-            float adsr_out = autowah_adsr.Process(gate);
-            
-            // Map ADSR output to filter frequency with range control
-            float range_min = 100.0f + (autowah_range * 200.0f);
-            float range_max = 1100.0f + (autowah_range * 1900.0f);
-            
-            float filter_freq = range_min + (adsr_out * (range_max - range_min));
-            
-            autowah_svf.SetFreq(filter_freq);
-            autowah_svf.SetRes(0.7f);
-            
-            // Process through SVF and use bandpass output with gain compensation
-            autowah_svf.Process(signal);
-            signal = autowah_svf.Band() * 2.0f;  // Autowah makeup gain
         }
         
-        // STAGE 6: Autowah AFTER everything (if placement is DOWN and enabled)
-        if (autowah_enabled && autowah_placement == 2) {
-            // High-pass filter for envelope detection (removes bass dominance)
-            float detection_signal = autowah_detector_hpf.Process(signal);
-            float envelope = envelopeFollower.Process(detection_signal);
+        octave_bin_counter++;
+        if (octave_bin_counter >= 6) {
+            octave_bin_counter = 0;
+        }
+    }
+}
+
+// STAGE 4: Fuzz - Always AGGRESSIVE type
+void fuzzStage(float* buf, size_t size) {
+    // Drive control - combines gain and intensity
+    // Map 0-1 knob to gain (1-20x) and intensity (0-1) proportionally
+    const float gain = 1.0f + (drive_amount * 19.0f); // 1x to 20x
+    const float intensity = drive_amount; // 0 to 1
+    
+    // Bass boost and drive; keep the pre-fuzz signal for the gate
+    static float bass_lpf = 0.0f;
+    const float bass_coeff = 0.05f;
+    for (size_t i = 0; i < size; i++) {
+        float fuzz_signal = buf[i];
+        pre_fuzz_block[i] = fuzz_signal;
+        bass_lpf = bass_lpf + bass_coeff * (fuzz_signal - bass_lpf);
+        fuzz_signal = fuzz_signal + (bass_lpf * 0.8f);
+        buf[i] = fuzz_signal * gain;
+    }
+    
+#if BUZZBOX_FUZZ_LOW_CPU
+    if (autowah_enabled && octave_enabled) {
+        // Everything is running - fuzz at 1x with the ADAA table
+        fuzz_low_cpu.SetIntensity(intensity);
+        fuzz_low_cpu.ProcessBlock(buf, size);
+    } else
+#endif
+    {
+        // Fuzz at 4x through the half-band oversampler
+        const size_t oversampled_size = size * OVERSAMPLING_FACTOR;
+        fuzz_oversampler.upsample(buf, oversampled_block, size);
+        fuzz.SetIntensity(intensity);
+        fuzz.ProcessBlock(oversampled_block, oversampled_size);
+        hw.Probe(probe_fuzz_4x, oversampled_block, oversampled_size);
+        fuzz_oversampler.downsample(oversampled_block, buf, size);
+    }
+    
+    // Gate control - variable threshold
+    if (gate_threshold > 0.01f) {
+        static float gate_envelope = 0.0f;
+        const float gate_level = gate_threshold * 0.1f; // Scale threshold
+        const float gate_attack = 0.95f;
+        const float gate_release = 0.01f;
+        
+        for (size_t i = 0; i < size; i++) {
+            float input_level = std::abs(pre_fuzz_block[i]); // Gate detects pre-fuzz level
             
-            // Gate ADSR based on envelope level and threshold (lowered for HPF compensation)
-            // When threshold is at 0, gate is always open (static filter at sustain level)
-            bool gate;
-            if (autowah_threshold > 0.01f) {
-                float gate_level = 0.01f + (autowah_threshold * 0.11f); // 0.01 to 0.12
-                gate = (envelope > gate_level);
+            if (input_level > gate_level) {
+                gate_envelope += gate_attack * (1.0f - gate_envelope);
             } else {
-                gate = true;  // Gate always open - static filter
+                gate_envelope += gate_release * (0.0f - gate_envelope);
             }
-            float adsr_out = autowah_adsr.Process(gate);
             
-            // Map ADSR output to filter frequency with range control
-            float range_min = 100.0f + (autowah_range * 200.0f);
-            float range_max = 1100.0f + (autowah_range * 1900.0f);
-            
-            float filter_freq = range_min + (adsr_out * (range_max - range_min));
-            
-            autowah_svf.SetFreq(filter_freq);
-            autowah_svf.SetRes(0.7f);
-            
-            // Process through SVF and use bandpass output with gain compensation
-            autowah_svf.Process(signal);
-            signal = autowah_svf.Band() * 2.0f;  // Autowah makeup gain
+            buf[i] *= gate_envelope;
         }
-        
-        // STAGE 6.5: FS2 Makeup Gain
-        // Compensate for volume loss from autowah bandpass and octave processing
-        // Only apply when FS2 effects are active and fuzz is bypassed
-        if ((autowah_enabled || octave_enabled) && !fuzz_enabled) {
-            signal *= 2.0f;  // Makeup gain for FS2 effects
+    }
+    
+    // Tone control
+    tone.SetFreq(tone_freq);
+    for (size_t i = 0; i < size; i++) {
+        buf[i] = tone.Process(buf[i]);
+    }
+}
+
+// STAGE 6.5: FS2 Makeup Gain
+// Compensate for volume loss from autowah bandpass and octave processing
+// Only used when FS2 effects are active and fuzz is bypassed
+void makeupGainStage(float* buf, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        buf[i] *= 2.0f;  // Makeup gain for FS2 effects
+    }
+}
+
+// STAGE 6.75: Master Anti-Aliasing Lowpass Filter
+// 8kHz lowpass removes all aliasing from octave/fuzz while preserving musical content
+void masterLowpassStage(float* buf, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        buf[i] = master_lowpass.Process(buf[i]);
+    }
+}
+
+// Which stages run this block, from the effect states and T1
+bool autowahBeforeFuzz() { return autowah_enabled && autowah_placement == 0; }  // T1 UP
+bool autowahAfterFuzz() { return autowah_enabled && autowah_placement != 0; }   // T1 MIDDLE/DOWN
+bool octaveSounding() { return octave_enabled || octave_fade > 0.0f; }
+bool octaveSilent() { return !octaveSounding(); }
+bool fuzzOn() { return fuzz_enabled; }
+bool makeupNeeded() { return (autowah_enabled || octave_enabled) && !fuzz_enabled; }
+
+// The chain, composed at compile time: each stage is tested once per block
+// and called directly, so its loop can be inlined into the callback
+namespace chainStage {
+FunctionStage<inputGainStage> inputGain;
+FunctionStage<analysisBusStage> analysisBus;
+FunctionStage<autowahStage, autowahBeforeFuzz> autowahFirst;
+FunctionStage<octaveStage, octaveSounding> octave;
+FunctionStage<octaveWarmStage, octaveSilent> octaveWarm;
+FunctionStage<fuzzStage, fuzzOn> fuzz;
+FunctionStage<autowahStage, autowahAfterFuzz> autowahLast;
+FunctionStage<makeupGainStage, makeupNeeded> makeupGain;
+FunctionStage<masterLowpassStage> masterLowpass;
+}
+Chain effectChain(chainStage::inputGain, chainStage::analysisBus, chainStage::autowahFirst,
+                  chainStage::octave, chainStage::octaveWarm, chainStage::fuzz,
+                  chainStage::autowahLast, chainStage::makeupGain, chainStage::masterLowpass);
+
+HOTHOUSE_ITCM void AudioCallback(AudioHandle::InputBuffer in, AudioHandle::OutputBuffer out, size_t size) {
+    processPresetRecall();
+    ProcessControls();
+
+    // Global true bypass - if no effects are active, pass clean signal
+    bool any_effect_active = fuzz_enabled || autowah_enabled || octave_enabled || octave_fade > 0.0f;
+
+    // Full CPU clock back before any DSP (make POWER_SAVE=1). The tuner and
+    // bypass's octave warm-up are light enough to run at half
+    hw.SetBypassed(!any_effect_active);
+
+    if (tuner.Active()) {
+        tuner.Process(in[0], out[0], out[1], size);
+        tuner.ShowOnLeds(hw);
+        return;
+    }
+    
+    if (!any_effect_active) {
+        // True bypass - pass input directly to output, no processing
+        for (size_t i = 0; i < size; i++) {
+            out[0][i] = in[0][i];
+            out[1][i] = in[1][i];
+            wet_block[i] = in[0][i];
         }
-        
-        // STAGE 6.75: Master Anti-Aliasing Lowpass Filter
-        // 8kHz lowpass removes all aliasing from octave/fuzz while preserving musical content
-        signal = master_lowpass.Process(signal);
-        
+#if BUZZBOX_ANALYSIS_BUS
+        block_resample_phase = octave_bin_counter;
+        analysisBusStage(wet_block, size);
+#endif
+        octaveWarmStage(wet_block, size);
+        return;
+    }
+    
+    // At least one effect is active - run the chain stage by stage
+    for (size_t i = 0; i < size; i++) {
+        wet_block[i] = in[0][i];
+    }
+#if BUZZBOX_ANALYSIS_BUS
+    block_resample_phase = octave_bin_counter;
+#endif
+    effectChain.ProcessBlock(wet_block, size);
+    
+    const float mix = knobValues[1];
+    const float level = knobValues[2];
+    for (size_t i = 0; i < size; i++) {
         // STAGE 7: Dry/Wet Mix (Knob 2)
-        const float mix = knobValues[1];
-        signal = input * (1.0f - mix) + signal * mix;
+        float signal = in[0][i] * (1.0f - mix) + wet_block[i] * mix;
         
         // STAGE 8: Output Level (Knob 3)
-        const float level = knobValues[2];
         signal *= level;
         
         out[0][i] = signal;
@@ -492,17 +824,32 @@ void AudioCallback(AudioHandle::InputBuffer in, AudioHandle::OutputBuffer out, s
 int main(void) {
     // CPU boost to 480MHz for better performance
     hw.Init(true);
-    hw.SetAudioBlockSize(256);  // Larger block size for efficiency
+    hw.SelectAudioProfile(audio_profiles);
     
     float samplerate = hw.AudioSampleRate();
     tone.Init(samplerate);
+    fuzz.Init(FuzzType::AGGRESSIVE);
+#if BUZZBOX_FUZZ_LOW_CPU
+    fuzz_low_cpu.Init();
+#endif
+    probe_fuzz_4x = hw.AddProbe("fuzz 4x", PROBE_FRAMES, samplerate * OVERSAMPLING_FACTOR);
+
+    // Skip the octave maths for bands below -70 dB; the octave sits after
+    // the fuzz and autowah, so this is still under their noise floor
+    octave.setCullThreshold(0.0003f);
     
     // Initialize master lowpass for anti-aliasing at 8kHz
     master_lowpass.Init(samplerate);
     master_lowpass.SetFreq(8000.0f);
     
     // Initialize ADSR for autowah envelope
-    autowah_adsr.Init(samplerate);
+#if BUZZBOX_ANALYSIS_BUS
+    const float detector_rate = samplerate / resample_factor;  // The 8kHz bus
+    autowah_adsr.Init(samplerate, resample_factor);  // Ticks once per bus sample
+#else
+    const float detector_rate = samplerate;
+    autowah_adsr.Init(samplerate, AUTOWAH_INTERVAL);  // Ticks once per sweep update
+#endif
     autowah_adsr.SetAttackTime(0.1f);
     autowah_adsr.SetTime(ADSR_SEG_DECAY, 0.15f);
     autowah_adsr.SetReleaseTime(0.2f);
@@ -515,11 +862,12 @@ int main(void) {
     
     // Initialize high-pass filter for autowah envelope detection
     // Removes bass frequencies to even out detection across frequency range
-    autowah_detector_hpf.Init(samplerate);
+    autowah_detector_hpf.Init(detector_rate);
     float detector_hpf_freq = 400.0f;  // Remove sub-400Hz from detection
     autowah_detector_hpf.SetFreq(detector_hpf_freq);
     
-    envelopeFollower.Init(samplerate, 5.0f, 50.0f); // Default medium sensitivity
+    envelopeFollower.Init(detector_rate, 5.0f, 50.0f); // Default medium sensitivity
+    hw.BootMark("DSP");
     
     // Initialize octave buffers
     for (int j = 0; j < 6; ++j) {
@@ -532,6 +880,7 @@ int main(void) {
     led2.Init(hw.seed.GetPin(Hothouse::LED_2), false);
     led1.Update();
     led2.Update();
+    hw.StartLedService();
     
     // Initialize control values
     for(int i = 0; i < 6; i++) {
@@ -560,15 +909,64 @@ int main(void) {
     autowah_placement = 0;
     first_start = true;
     
+    // Restore the last saved working state (defaults above otherwise);
+    // the first callback takes it from the shadow before reading controls
+    preset_smoother.Init(preset_params, PRESET_RAMP_BLOCKS * BLOCK_SIZE / hw.AudioBlockSize());
+    bool restored = settings_log.Init(hw.seed.qspi, SETTINGS_OFFSET, SETTINGS_VERSION, currentPreset());
+    if (restored && settings_log.GetSettings().Valid(PRESET_SCHEMA)) {
+        preset_shadow.Publish(settings_log.GetSettings());
+    }
+    BuzzBoxPreset pending_settings = currentPreset();
+    if (restored) {
+        pending_settings = settings_log.GetSettings();
+    }
+    uint32_t last_change_ms = System::GetNow();
+    hw.BootMark("settings");
+    
     hw.StartAdc();
     hw.StartAudio(AudioCallback);
     
     while(1)
     {
+        // CPU load over USB serial (make LOAD_METER=1)
+        hw.ServiceLoadMeter();
+        // Callback overruns over USB serial and into QSPI (make WATCHDOG=1)
+        hw.ServiceWatchdog();
+        // Time to each boot phase over USB serial (make BOOT_TIMING=1)
+        hw.ServiceBootTiming();
+        // Heap allocations inside the audio callback over USB serial (make ALLOC_CHECK=1)
+        hw.ServiceAllocCheck();
+        // Stack and heap high-water marks over USB serial (make MEMORY_REPORT=1)
+        hw.ServiceMemoryReport();
+        // Subnormals and NaNs in the audio callback (make DENORMAL_CHECK=1)
+        hw.ServiceDenormalCheck();
+        // Half the CPU clock after 5 s in bypass (make POWER_SAVE=1)
+        hw.ServicePower();
+        // Signal probes armed and dumped over USB serial (make PROBE=1)
+        hw.ServiceProbes();
+        // Round-trip latency through a loopback cable (make LATENCY_TEST=1)
+        hw.ServiceLatencyTest();
+        // The reports above as binary records over USB serial (make TELEMETRY=1)
+        hw.ServiceTelemetry();
+
+        // Debounced auto-save: stage once the parameters have been still
+        // for a second; the log programs one flash page per save here in
+        // the main loop, never in the callback
+        BuzzBoxPreset current = currentPreset();
+        if (std::memcmp(&current, &pending_settings, sizeof(current)) != 0) {
+            pending_settings = current;
+            last_change_ms = System::GetNow();
+        } else if (System::GetNow() - last_change_ms >= SETTINGS_SAVE_DELAY_MS
+                   && std::memcmp(&pending_settings, &settings_log.GetSettings(), sizeof(current)) != 0) {
+            settings_log.Save(pending_settings);
+        }
+        settings_log.Process();
+        
         if(hw.switches[Hothouse::FOOTSWITCH_1].TimeHeldMs() >= 2000)
         {
             hw.StopAudio();
             hw.StopAdc();
+            hw.StopLedService();
             
             for(int i = 0; i < 3; i++) 
             {
@@ -588,6 +986,6 @@ int main(void) {
             System::ResetToBootloader();
         }
         
-        System::Delay(100);
+        hw.IdleMs(10);
     }
 }
@@ -7,10 +7,14 @@
 #ifndef BUZZBOX_HOTHOUSE_H
 #define BUZZBOX_HOTHOUSE_H
 
-#include <vector>
+#include <array>
 #include <cmath>
 #include <algorithm>
 
+#include "hothouse_envelope.h"
+#include "hothouse_fastmath.h"
+#include "Util/Multirate.h"
+
 // =============================================================================
 // FUZZ MODULE - Aggressive Type Only
 // =============================================================================
@@ -23,7 +27,7 @@ enum class FuzzType {
 
 namespace Fuzz {
     inline float softClipping(float input, float gain) {
-        return std::tanh(input * gain);
+        return fastmath::Tanh(input * gain);
     }
     
     inline float asymmetricClip(float input, float intensity) {
@@ -36,26 +40,60 @@ namespace Fuzz {
             return softClipping(input, intensity) * neg_threshold;
         }
     }
+}
+
+// One fuzz instance: pre-emphasis, clip + harmonics, DC blocker,
+// de-emphasis and (for non-AGGRESSIVE types) the internal gate, with all
+// filter state held per instance. ProcessBlock() keeps the state in locals
+// for the whole block.
+class FuzzProcessor {
+public:
+    void Init(FuzzType type) {
+        type_ = type;
+        intensity_ = 0.0f;
+        state_ = State{};
+    }
     
-    inline float fuzzEffect(float input, float intensity, FuzzType type) {
-        static float dc_blocker_x1 = 0.0f;
-        static float dc_blocker_y1 = 0.0f;
-        static float gate_envelope = 0.0f;
-        static float pre_emphasis_state = 0.0f;
-        
+    // Intensity 0-1 (scaled by 10 into the clipper gain)
+    void SetIntensity(float intensity) { intensity_ = intensity * 10.0f; }
+    
+    float Process(float input) {
+        return Step(state_, input, intensity_, type_);
+    }
+    
+    // Fuzzes n samples of buf in place
+    void ProcessBlock(float* buf, size_t n) {
+        State state = state_;
+        const float intensity = intensity_;
+        const FuzzType type = type_;
+        for (size_t i = 0; i < n; ++i) {
+            buf[i] = Step(state, buf[i], intensity, type);
+        }
+        state_ = state;
+    }
+    
+private:
+    struct State {
+        clevelandmusicco::DcBlocker dc_blocker{0.997f};
+        float gate_envelope = 0.0f;
+        float pre_emphasis_state = 0.0f;
+        float de_emphasis_state = 0.0f;
+    };
+    
+    static inline float Step(State& s, float input, float intensity, FuzzType type) {
         float fuzzed = input;
         
         if (type == FuzzType::AGGRESSIVE) {
             const float emphasis_coeff = 0.7f;
-            float pre_emphasized = input + (input - pre_emphasis_state) * emphasis_coeff;
-            pre_emphasis_state = input;
+            float pre_emphasized = input + (input - s.pre_emphasis_state) * emphasis_coeff;
+            s.pre_emphasis_state = input;
             fuzzed = pre_emphasized;
         }
         
         if (type == FuzzType::AGGRESSIVE) {
-            fuzzed = asymmetricClip(fuzzed, intensity);
+            fuzzed = Fuzz::asymmetricClip(fuzzed, intensity);
         } else {
-            fuzzed = softClipping(fuzzed, intensity);
+            fuzzed = Fuzz::softClipping(fuzzed, intensity);
         }
         
         if (type == FuzzType::AGGRESSIVE) {
@@ -67,18 +105,14 @@ namespace Fuzz {
         }
         
         const float dynamicIntensity = intensity * (1.0f + 0.5f * std::abs(input));
-        fuzzed = softClipping(fuzzed, dynamicIntensity);
+        fuzzed = Fuzz::softClipping(fuzzed, dynamicIntensity);
         
-        const float dc_coeff = 0.997f;
-        float dc_blocked = fuzzed - dc_blocker_x1 + dc_coeff * dc_blocker_y1;
-        dc_blocker_x1 = fuzzed;
-        dc_blocker_y1 = dc_blocked;
+        float dc_blocked = s.dc_blocker.Process(fuzzed);
         
         if (type == FuzzType::AGGRESSIVE) {
-            static float de_emphasis_state = 0.0f;
             const float de_emphasis_coeff = 0.3f;
-            de_emphasis_state = de_emphasis_state + de_emphasis_coeff * (dc_blocked - de_emphasis_state);
-            dc_blocked = de_emphasis_state;
+            s.de_emphasis_state = s.de_emphasis_state + de_emphasis_coeff * (dc_blocked - s.de_emphasis_state);
+            dc_blocked = s.de_emphasis_state;
         }
         
         if (type == FuzzType::CLEAN) {
@@ -93,58 +127,167 @@ namespace Fuzz {
             float input_level = std::abs(input);
             
             if (input_level > gate_threshold) {
-                gate_envelope += gate_attack * (1.0f - gate_envelope);
+                s.gate_envelope += gate_attack * (1.0f - s.gate_envelope);
             } else {
-                gate_envelope += gate_release * (0.0f - gate_envelope);
+                s.gate_envelope += gate_release * (0.0f - s.gate_envelope);
             }
             
-            return dc_blocked * gate_envelope;
+            return dc_blocked * s.gate_envelope;
         }
     }
     
-    inline float process(float sample, FuzzType type, float intensity) {
-        return fuzzEffect(sample, intensity * 10.0f, type);
-    }
-}
+    FuzzType type_ = FuzzType::AGGRESSIVE;
+    float intensity_ = 0.0f;
+    State state_;
+};
 
 // =============================================================================
-// ENVELOPE FOLLOWER
+// LOW-CPU FUZZ - table waveshaper with antiderivative anti-aliasing
 // =============================================================================
 
-class EnvelopeFollower {
+// The AGGRESSIVE fuzz at 1x: the clip, harmonics and intensity-dependent
+// second clip collapsed into one static curve f(u) (taking the harmonics
+// from the pre-emphasized signal rather than the raw input), tabulated
+// with its antiderivative F for kDrives intensities. Each sample outputs
+// (F(u) - F(u1)) / (u - u1), first-order ADAA, which suppresses aliasing
+// roughly as well as the 4x oversampler for a fraction of the cost. The
+// emphasis, DC blocker and gate coefficients are the 192k ones re-derived
+// for 48k. Curves between table drives are blended linearly.
+class FuzzShaperADAA {
 public:
-    EnvelopeFollower() : envelope_level_(0.0f) {}
-    
-    void Init(float samplerate, float attack_ms, float release_ms) {
-        samplerate_ = samplerate;
-        setAttackRelease(attack_ms, release_ms);
+    static constexpr int kDrives = 16;
+    static constexpr int kPoints = 512;      // Cells across [-kRange, kRange]
+    static constexpr float kRange = 8.0f;    // Curve is flat beyond this
+
+    // Builds the tables (tanh-heavy, call once from main)
+    void Init() {
+        const float h = 2.0f * kRange / kPoints;
+        for (int d = 0; d < kDrives; ++d) {
+            const float intensity = 10.0f * d / (kDrives - 1);
+            float integral = 0.0f;
+            for (int i = 0; i <= kPoints; ++i) {
+                const float u = -kRange + h * i;
+                curve_[d][i] = Shape(u, intensity);
+                if (i > 0) {
+                    integral += 0.5f * h * (curve_[d][i - 1] + curve_[d][i]);
+                }
+                integral_[d][i] = integral;
+            }
+        }
+        x1_ = 0.0f;
+        u1_ = 0.0f;
+        dc_blocker_.Reset();
+        de_emphasis_ = 0.0f;
+        gate_envelope_ = 0.0f;
+        SetIntensity(0.0f);
     }
     
-    void setAttackRelease(float attack_ms, float release_ms) {
-        attack_coeff_ = 1.0f - std::exp(-1.0f / (attack_ms * samplerate_ / 1000.0f));
-        release_coeff_ = 1.0f - std::exp(-1.0f / (release_ms * samplerate_ / 1000.0f));
+    // Intensity 0-1, as FuzzProcessor::SetIntensity()
+    void SetIntensity(float intensity) {
+        float pos = intensity * (kDrives - 1);
+        if (pos < 0.0f) pos = 0.0f;
+        if (pos > kDrives - 1) pos = kDrives - 1;
+        d0_ = static_cast<int>(pos);
+        if (d0_ > kDrives - 2) d0_ = kDrives - 2;
+        w_ = pos - d0_;
+        F1_ = Integral(u1_);  // Keep the difference quotient on one curve
     }
     
-    float Process(float input) {
-        float input_level = std::abs(input);
-        
-        if (input_level > envelope_level_) {
-            envelope_level_ += attack_coeff_ * (input_level - envelope_level_);
-        } else {
-            envelope_level_ += release_coeff_ * (input_level - envelope_level_);
+    // Fuzzes n samples of buf in place at the base rate
+    void ProcessBlock(float* buf, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            const float input = buf[i];
+            
+            // Pre-emphasis (0.7 at 192k ~ 0.175 at 48k)
+            const float u = input + (input - x1_) * 0.175f;
+            x1_ = input;
+            
+            // First-order ADAA
+            const float F = Integral(u);
+            const float du = u - u1_;
+            float shaped;
+            if (std::abs(du) > 1.0e-4f) {
+                shaped = (F - F1_) / du;
+            } else {
+                shaped = Curve(0.5f * (u + u1_));
+            }
+            u1_ = u;
+            F1_ = F;
+            
+            // DC blocker (0.997 at 192k)
+            const float dc_blocked = dc_blocker_.Process(shaped);
+            
+            // De-emphasis (0.3 at 192k)
+            de_emphasis_ += 0.7599f * (dc_blocked - de_emphasis_);
+            
+            // Internal gate (attack 0.95 / release 0.01 at 192k)
+            if (std::abs(input) > 0.03f) {
+                gate_envelope_ += 0.99999f * (1.0f - gate_envelope_);
+            } else {
+                gate_envelope_ += 0.0394f * (0.0f - gate_envelope_);
+            }
+            
+            buf[i] = de_emphasis_ * gate_envelope_;
         }
-        
-        return envelope_level_;
     }
     
-    float GetEnvelopeLevel() const { return envelope_level_; }
-    void Reset() { envelope_level_ = 0.0f; }
-
 private:
-    float samplerate_;
-    float envelope_level_;
-    float attack_coeff_;
-    float release_coeff_;
+    // FuzzProcessor's AGGRESSIVE clip chain with input == pre-emphasized
+    static float Shape(float u, float intensity) {
+        float fuzzed = Fuzz::asymmetricClip(u, intensity);
+        fuzzed += 0.03f * (u * u);
+        fuzzed += 0.012f * (u * u * u * u);
+        fuzzed += 0.015f * (u * u * u);
+        const float dynamicIntensity = intensity * (1.0f + 0.5f * std::abs(u));
+        return Fuzz::softClipping(fuzzed, dynamicIntensity);
+    }
+    
+    // Table cell and offset for u, clamped to the table
+    static inline int Cell(float u, float& t) {
+        float pos = (u + kRange) * (kPoints / (2.0f * kRange));
+        if (pos < 0.0f) pos = 0.0f;
+        if (pos > kPoints - 1.0e-3f) pos = kPoints - 1.0e-3f;
+        const int i = static_cast<int>(pos);
+        t = pos - i;
+        return i;
+    }
+    
+    // f(u), blended between the two nearest drives
+    inline float Curve(float u) const {
+        float t;
+        const int i = Cell(u, t);
+        const float a = curve_[d0_][i] + t * (curve_[d0_][i + 1] - curve_[d0_][i]);
+        const float b = curve_[d0_ + 1][i] + t * (curve_[d0_ + 1][i + 1] - curve_[d0_ + 1][i]);
+        return a + w_ * (b - a);
+    }
+    
+    // F(u) of the drive blend: exact for the piecewise-linear curve inside
+    // the table, continued linearly past its ends
+    inline float Integral(float u) const {
+        return IntegralOf(d0_, u) + w_ * (IntegralOf(d0_ + 1, u) - IntegralOf(d0_, u));
+    }
+    
+    inline float IntegralOf(int d, float u) const {
+        const float h = 2.0f * kRange / kPoints;
+        if (u <= -kRange) return curve_[d][0] * (u + kRange);
+        if (u >= kRange) return integral_[d][kPoints] + curve_[d][kPoints] * (u - kRange);
+        float t;
+        const int i = Cell(u, t);
+        const float f0 = curve_[d][i];
+        const float f1 = curve_[d][i + 1];
+        return integral_[d][i] + h * t * (f0 + 0.5f * t * (f1 - f0));
+    }
+    
+    float curve_[kDrives][kPoints + 1];
+    float integral_[kDrives][kPoints + 1];
+    int d0_ = 0;
+    float w_ = 0.0f;
+    float x1_ = 0.0f;
+    float u1_ = 0.0f;
+    float F1_ = 0.0f;
+    clevelandmusicco::DcBlocker dc_blocker_{0.98805f};  // 0.997 at 192k
+    float de_emphasis_ = 0.0f;
+    float gate_envelope_ = 0.0f;
 };
 
 // =============================================================================
@@ -181,29 +324,109 @@ private:
 };
 
 // =============================================================================
-// OVERSAMPLING SYSTEM - Reduced to 4x for Performance
+// OVERSAMPLING SYSTEM - 4x polyphase half-band (2x twice)
 // =============================================================================
 
 constexpr int OVERSAMPLING_FACTOR = 4;
 
-namespace Oversampling {
-    inline std::vector<float> upsample(float input) {
-        std::vector<float> output(OVERSAMPLING_FACTOR, 0.0f);
-        output[0] = input;
-        for (int i = 1; i < OVERSAMPLING_FACTOR; ++i) {
-            output[i] = input * (1.0f - static_cast<float>(i) / OVERSAMPLING_FACTOR);
+// Half-band FIR: a 0.5 centre tap plus Pairs symmetric odd taps (the even
+// ones are zero). c[0] is the innermost pair. Applied to a newest-first
+// history of 2 * Pairs samples, it gives the sample halfway between h[Pairs]
+// and h[Pairs - 1].
+template <std::size_t Pairs>
+struct HalfbandTaps {
+    std::array<float, Pairs> c;
+
+    float operator()(const float* h) const {
+        float sum = 0.0f;
+        for (std::size_t i = 0; i < Pairs; ++i) {
+            sum += c[i] * (h[Pairs - 1 - i] + h[Pairs + i]);
         }
-        return output;
+        return sum;
     }
-    
-    inline float downsample(const std::vector<float>& input) {
-        float sum = 0.0f;
-        for (float sample : input) {
-            sum += sample;
+};
+
+// 48k -> 192k -> 48k around the fuzz. Each 2x step runs the half-band as
+// two polyphase branches, so only the non-zero odd taps are ever multiplied.
+// Fixed-size histories (HistoryBuffer, Util/Multirate.h), no allocation.
+class Oversampler4x {
+public:
+    // Input samples handled between history moves
+    static constexpr std::size_t max_chunk = 32;
+
+    // Upsamples n samples from in to 4n samples in out
+    void upsample(const float* in, float* out, std::size_t n) {
+        while (n > 0) {
+            const std::size_t chunk = n < max_chunk ? n : max_chunk;
+            for (std::size_t i = 0; i < chunk; ++i) {
+                up1_.push(in[i]);
+                const float* h1 = up1_.latest();
+                const float s0 = h1[12];
+                const float s1 = 2.0f * stage1(h1);
+
+                up2_.push(s0);
+                out[0] = up2_.latest()[4];
+                out[1] = 2.0f * stage2(up2_.latest());
+                up2_.push(s1);
+                out[2] = up2_.latest()[4];
+                out[3] = 2.0f * stage2(up2_.latest());
+                out += OVERSAMPLING_FACTOR;
+            }
+            up1_.commit();
+            up2_.commit();
+            in += chunk;
+            n -= chunk;
         }
-        return sum / input.size();
     }
-}
+
+    // Downsamples 4n samples from in to n samples in out
+    void downsample(const float* in, float* out, std::size_t n) {
+        while (n > 0) {
+            const std::size_t chunk = n < max_chunk ? n : max_chunk;
+            for (std::size_t i = 0; i < chunk; ++i) {
+                down2_even_.push(in[0]);
+                down2_odd_.push(in[1]);
+                const float s0 = 0.5f * down2_even_.latest()[3] + stage2(down2_odd_.latest());
+                down2_even_.push(in[2]);
+                down2_odd_.push(in[3]);
+                const float s1 = 0.5f * down2_even_.latest()[3] + stage2(down2_odd_.latest());
+
+                down1_even_.push(s0);
+                down1_odd_.push(s1);
+                out[i] = 0.5f * down1_even_.latest()[11] + stage1(down1_odd_.latest());
+                in += OVERSAMPLING_FACTOR;
+            }
+            down1_even_.commit();
+            down1_odd_.commit();
+            down2_even_.commit();
+            down2_odd_.commit();
+            out += chunk;
+            n -= chunk;
+        }
+    }
+
+private:
+    // 96000 Hz, Kaiser beta 7: flat (-0.05 dB) to 20 kHz, -45 dB at 28 kHz,
+    // below -76 dB from 30 kHz
+    static constexpr HalfbandTaps<12> stage1{{
+        0.3163637511f, -0.1003915687f, 0.05453258828f, -0.03346170672f,
+        0.021137199f, -0.01320476243f, 0.007952738124f, -0.004513210055f,
+        0.002347397838f, -0.001070848577f, 0.0003905097168f, -8.208760425e-05f
+    }};
+
+    // 192000 Hz, Kaiser beta 5: flat to 24 kHz, below -58 dB over 72-96 kHz
+    // (where stage 1's passband images land)
+    static constexpr HalfbandTaps<4> stage2{{
+        0.3034859976f, -0.0690199718f, 0.01720014577f, -0.001666171618f
+    }};
+
+    HistoryBuffer<23, max_chunk> up1_;
+    HistoryBuffer<7, max_chunk * 2> up2_;
+    HistoryBuffer<3, max_chunk * 2> down2_even_;
+    HistoryBuffer<7, max_chunk * 2> down2_odd_;
+    HistoryBuffer<11, max_chunk> down1_even_;
+    HistoryBuffer<23, max_chunk> down1_odd_;
+};
 
 // =============================================================================
 // PARAMETER RANGES
@@ -0,0 +1,54 @@
+// Fade Table
+// Precomputed equal-power (square-root) fade curve for slice crossfades
+
+#pragma once
+#ifndef FADE_TABLE_H
+#define FADE_TABLE_H
+
+#include <stddef.h>
+
+/** sqrt(x) on [0, 1] at Points + 1 evenly spaced positions, built at compile
+    time, read back with linear interpolation. Replaces the per-sample
+    sqrtf() in fade regions with one multiply, two loads and a lerp. */
+template <size_t Points>
+class FadeTable
+{
+  public:
+    constexpr FadeTable() : table_()
+    {
+        for (size_t i = 0; i <= Points; i++) {
+            table_[i] = (float)Sqrt((double)i / Points);
+        }
+    }
+
+    /** Fade gain for a ramp position in [0, 1] */
+    inline float operator()(float ramp) const
+    {
+        if (ramp <= 0.0f) return 0.0f;
+        if (ramp >= 1.0f) return 1.0f;
+
+        float index = ramp * Points;
+        size_t i = (size_t)index;
+        float frac = index - (float)i;
+        return table_[i] + (table_[i + 1] - table_[i]) * frac;
+    }
+
+  private:
+    // Newton's method; converges to double precision well within 64 steps
+    static constexpr double Sqrt(double x)
+    {
+        if (x <= 0.0) return 0.0;
+        double y = x < 1.0 ? 1.0 : x;
+        for (int k = 0; k < 64; k++) {
+            y = 0.5 * (y + x / y);
+        }
+        return y;
+    }
+
+    float table_[Points + 1];
+};
+
+/** Shared 1024-segment equal-power fade */
+constexpr FadeTable<1024> equalPowerFade{};
+
+#endif  // FADE_TABLE_H
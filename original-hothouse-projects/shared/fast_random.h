@@ -0,0 +1,61 @@
+// Fast Random
+// Small, callback-safe PRNG for audio-path randomness (slicers, dust)
+
+#pragma once
+#ifndef FAST_RANDOM_H
+#define FAST_RANDOM_H
+
+#include <stdint.h>
+
+/** Marsaglia's xorshift32 (the generator Venus uses for its phases): three
+    shifts and xors per draw, no locks or reentrancy structs like newlib's
+    rand(). Give each audio-path consumer its own instance and seed it
+    from System::GetNow() in main(), or it repeats every boot. */
+class FastRandom
+{
+  public:
+    FastRandom() {}
+    ~FastRandom() {}
+
+    /** Any seed; zero (the one state xorshift cannot leave) is remapped */
+    void Seed(uint32_t seed) { state_ = seed != 0 ? seed : kDefaultSeed; }
+
+    inline uint32_t Next()
+    {
+        state_ ^= state_ << 13;
+        state_ ^= state_ >> 17;
+        state_ ^= state_ << 5;
+        return state_;
+    }
+
+    /** Uniform integer in [0, n), n > 0, without bias: Lemire's
+        multiply-shift, redrawing the few products that would favour the
+        low results when n isn't a power of two (fewer than n in 2^32, so
+        almost never) */
+    inline int Below(int n)
+    {
+        const uint32_t range = (uint32_t)n;
+        uint64_t product = (uint64_t)Next() * range;
+        if ((uint32_t)product < range)
+        {
+            const uint32_t threshold = (0u - range) % range;
+            while ((uint32_t)product < threshold)
+            {
+                product = (uint64_t)Next() * range;
+            }
+        }
+        return (int)(product >> 32);
+    }
+
+    /** Fair coin */
+    inline bool Coin() { return (Next() >> 31) != 0; }
+
+    /** Uniform float in [0, 1) */
+    inline float Uniform() { return (float)(Next() >> 8) * (1.0f / 16777216.0f); }
+
+  private:
+    static const uint32_t kDefaultSeed = 2463534242u;
+    uint32_t state_ = kDefaultSeed;
+};
+
+#endif  // FAST_RANDOM_H
@@ -0,0 +1,140 @@
+// Preset Block
+// Versioned preset layout, lock-free shadow handoff and recall smoothing
+
+#pragma once
+#ifndef PRESET_BLOCK_H
+#define PRESET_BLOCK_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+/** One preset as it sits in flash and in RAM: a small header and a flat
+    array of float parameters, indexed by the pedal's own parameter enum.
+    schema identifies that enum (bump it when parameters are added,
+    removed or reordered); layout is this struct's own version. The same
+    block can be stored directly with SettingsLog. */
+template <size_t NumParams>
+struct PresetBlock
+{
+    static const uint16_t kLayoutVersion = 1;
+
+    uint16_t layout;
+    uint16_t schema;
+    uint32_t count;
+    float params[NumParams];
+
+    void Init(uint16_t pedal_schema)
+    {
+        layout = kLayoutVersion;
+        schema = pedal_schema;
+        count = NumParams;
+        for (size_t i = 0; i < NumParams; i++) {
+            params[i] = 0.0f;
+        }
+    }
+
+    bool Valid(uint16_t pedal_schema) const
+    {
+        return layout == kLayoutVersion && schema == pedal_schema && count == NumParams;
+    }
+};
+
+/** Hands presets from the main loop to the audio callback without locks
+    or copies on the audio side. Two SRAM shadows: the main loop fills the
+    one the callback is not using and publishes it with a release store;
+    the callback takes it with an acquire load and reads it in place. */
+template <size_t NumParams>
+class PresetShadow
+{
+  public:
+    typedef PresetBlock<NumParams> Block;
+
+    PresetShadow() {}
+    ~PresetShadow() {}
+
+    /** Main loop. Copies block into the idle shadow and publishes it.
+        Returns false (nothing written) while the callback has not taken
+        the previous one yet; publish again on a later pass. */
+    bool Publish(const Block& block)
+    {
+        int taken = taken_.load(std::memory_order_acquire);
+        if (live_.load(std::memory_order_relaxed) != taken) return false;
+
+        int slot = taken == 0 ? 1 : 0;
+        slots_[slot] = block;
+        live_.store(slot, std::memory_order_release);
+        return true;
+    }
+
+    /** Audio callback. The newly published block, or nullptr if nothing
+        new. The block stays valid until the next non-null Take(). */
+    const Block* Take()
+    {
+        int live = live_.load(std::memory_order_acquire);
+        if (live == taken_.load(std::memory_order_relaxed)) return nullptr;
+
+        taken_.store(live, std::memory_order_release);
+        return &slots_[live];
+    }
+
+  private:
+    Block slots_[2];
+    std::atomic<int> live_{-1};   // Last published slot
+    std::atomic<int> taken_{-1};  // Last slot the callback took
+};
+
+/** Glides a set of live parameters to a recalled preset over a fixed
+    number of audio blocks, so recall never steps a gain or a filter.
+    Runs in the callback; params point at the pedal's live values. */
+template <size_t NumParams>
+class PresetSmoother
+{
+  public:
+    PresetSmoother() {}
+    ~PresetSmoother() {}
+
+    void Init(float* const* params, int ramp_blocks)
+    {
+        params_ = params;
+        ramp_blocks_ = ramp_blocks;
+        remaining_ = 0;
+    }
+
+    /** Starts gliding from the current values to block's; with snap the
+        values jump (use at power-on, when there is nothing to glide from) */
+    void Start(const PresetBlock<NumParams>& block, bool snap = false)
+    {
+        for (size_t i = 0; i < NumParams; i++) {
+            target_[i] = block.params[i];
+            if (snap || ramp_blocks_ <= 1) {
+                *params_[i] = target_[i];
+                step_[i] = 0.0f;
+            } else {
+                step_[i] = (target_[i] - *params_[i]) / (float)ramp_blocks_;
+            }
+        }
+        remaining_ = snap ? 0 : ramp_blocks_;
+    }
+
+    /** Once per audio block; returns true while still gliding */
+    bool Process()
+    {
+        if (remaining_ <= 0) return false;
+
+        remaining_--;
+        for (size_t i = 0; i < NumParams; i++) {
+            *params_[i] = remaining_ > 0 ? *params_[i] + step_[i] : target_[i];
+        }
+        return true;
+    }
+
+  private:
+    float* const* params_ = nullptr;
+    int ramp_blocks_ = 1;
+    int remaining_ = 0;
+    float target_[NumParams];
+    float step_[NumParams];
+};
+
+#endif  // PRESET_BLOCK_H
@@ -0,0 +1,183 @@
+// Settings Log
+// Wear-levelled, append-only settings storage on the Seed's QSPI flash
+
+#pragma once
+#ifndef SETTINGS_LOG_H
+#define SETTINGS_LOG_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "daisy_seed.h"
+
+/** Replacement for PersistentStorage for settings that save while playing.
+    PersistentStorage erases a whole sector (tens of ms with the QSPI out
+    of memory-mapped mode) on every Save(). Here each save is appended as
+    one 256-byte page program into a ring of Sectors sectors, and a sector
+    is only erased when the log is about to wrap into it, one save in
+    every 16. The newest valid record (highest sequence) wins at boot.
+
+    Save() only stages the record in RAM. Process(), called from the main
+    loop, performs at most one flash operation per call (one page program
+    or one sector erase), so the audio interrupt keeps running throughout.
+    That holds as long as the callback is not itself fetched from QSPI:
+    with APP_TYPE = BOOT_QSPI any flash operation stalls code fetch. */
+template <typename Settings, uint32_t Sectors = 4>
+class SettingsLog
+{
+  public:
+    static const uint32_t kPageSize = 256;
+    static const uint32_t kSectorSize = 4096;
+    static const uint32_t kPagesPerSector = kSectorSize / kPageSize;
+    static const uint32_t kPages = Sectors * kPagesPerSector;
+
+    SettingsLog() {}
+    ~SettingsLog() {}
+
+    /** Scans the log at offset (sector aligned) for the newest record with
+        this version. Returns true if one was found, else uses defaults. */
+    bool Init(daisy::QSPIHandle& qspi, uint32_t offset, uint32_t version,
+              const Settings& defaults)
+    {
+        qspi_ = &qspi;
+        offset_ = offset & ~(kSectorSize - 1);
+        version_ = version;
+        settings_ = defaults;
+        staged_ = false;
+        erase_sector_ = -1;
+
+        bool found = false;
+        uint32_t newest = 0;
+        sequence_ = 0;
+        for (uint32_t page = 0; page < kPages; page++) {
+            const Record* rec = PageRecord(page);
+            if (Valid(rec) && (!found || rec->sequence > sequence_)) {
+                found = true;
+                newest = page;
+                sequence_ = rec->sequence;
+            }
+        }
+
+        if (found) {
+            settings_ = PageRecord(newest)->settings;
+            next_page_ = (newest + 1) % kPages;
+        } else {
+            next_page_ = 0;
+        }
+
+        // A used page here means a foreign or torn layout (or power was
+        // lost before the pre-erase). Erase from the next sector boundary,
+        // which never holds the newest record.
+        if (!Blank(next_page_)) {
+            if (next_page_ % kPagesPerSector != 0) {
+                next_page_ = ((next_page_ / kPagesPerSector + 1) % Sectors) * kPagesPerSector;
+            }
+            erase_sector_ = (int32_t)(next_page_ / kPagesPerSector);
+        }
+
+        return found;
+    }
+
+    /** The settings last loaded or saved */
+    const Settings& GetSettings() const { return settings_; }
+
+    /** Stages a save; nothing touches the flash until Process() */
+    void Save(const Settings& settings)
+    {
+        settings_ = settings;
+        staged_ = true;
+    }
+
+    /** True while a save or its follow-up erase is outstanding */
+    bool Busy() const { return staged_ || erase_sector_ >= 0; }
+
+    /** Main loop only. Does at most one page program or sector erase. */
+    void Process()
+    {
+        if (erase_sector_ >= 0) {
+            uint32_t start = offset_ + (uint32_t)erase_sector_ * kSectorSize;
+            qspi_->Erase(start, start + kSectorSize);
+            erase_sector_ = -1;
+            return;
+        }
+
+        if (!staged_) return;
+
+        Record rec;
+        memset(&rec, 0xff, sizeof(rec));
+        rec.magic = kMagic;
+        rec.version = version_;
+        rec.sequence = sequence_ + 1;
+        rec.size = sizeof(Settings);
+        rec.settings = settings_;
+        rec.checksum = Checksum(rec);
+
+        qspi_->Write(offset_ + next_page_ * kPageSize, sizeof(Record), (uint8_t*)&rec);
+        sequence_++;
+        staged_ = false;
+
+        // Erase the oldest sector as soon as the log is about to enter it,
+        // so the next save is again a single page program
+        next_page_ = (next_page_ + 1) % kPages;
+        if (next_page_ % kPagesPerSector == 0) {
+            erase_sector_ = (int32_t)(next_page_ / kPagesPerSector);
+        }
+    }
+
+  private:
+    static const uint32_t kMagic = 0x534c4f47;  // 'SLOG'
+
+    struct Record
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t sequence;
+        uint32_t size;
+        Settings settings;
+        uint32_t checksum;
+    };
+    static_assert(sizeof(Record) <= kPageSize, "Settings must fit one flash page");
+    static_assert(Sectors >= 2, "The log needs a sector to erase besides the newest");
+
+    const Record* PageRecord(uint32_t page) const
+    {
+        return reinterpret_cast<const Record*>(qspi_->GetData(offset_ + page * kPageSize));
+    }
+
+    bool Blank(uint32_t page) const
+    {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(PageRecord(page));
+        for (uint32_t i = 0; i < sizeof(Record); i++) {
+            if (bytes[i] != 0xff) return false;
+        }
+        return true;
+    }
+
+    bool Valid(const Record* rec) const
+    {
+        return rec->magic == kMagic && rec->version == version_
+               && rec->size == sizeof(Settings) && rec->checksum == Checksum(*rec);
+    }
+
+    /** FNV-1a over everything before the checksum */
+    static uint32_t Checksum(const Record& rec)
+    {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&rec);
+        uint32_t hash = 2166136261u;
+        for (size_t i = 0; i < offsetof(Record, checksum); i++) {
+            hash = (hash ^ bytes[i]) * 16777619u;
+        }
+        return hash;
+    }
+
+    daisy::QSPIHandle* qspi_ = nullptr;
+    uint32_t offset_ = 0;
+    uint32_t version_ = 0;
+    Settings settings_;
+    bool staged_ = false;
+    uint32_t sequence_ = 0;
+    uint32_t next_page_ = 0;
+    int32_t erase_sector_ = -1;
+};
+
+#endif  // SETTINGS_LOG_H
@@ -0,0 +1,128 @@
+// Sinc Table
+// Polyphase windowed-sinc interpolator for fractional-rate slice reads
+
+#pragma once
+#ifndef SINC_TABLE_H
+#define SINC_TABLE_H
+
+#include <stddef.h>
+
+/** Kaiser-windowed sinc split into Phases + 1 fractional offsets of Taps
+    coefficients each, built at compile time. A read at position p uses
+    the Taps samples from floor(p) - Taps / 2 + 1, with coefficients
+    interpolated between the two phases either side of p's fraction: 2 x
+    Taps multiply-adds whatever the rate, so every voice costs the same.
+
+    Cutoff is in cycles per source sample (0.5 = Nyquist). Reading faster
+    than 1:1 needs it scaled down by the rate to keep the aliases out,
+    which is why there are two shared tables below. Each phase is
+    normalised to unity DC gain. */
+template <int Taps, int Phases>
+class SincTable
+{
+  public:
+    static constexpr int kTaps = Taps;
+
+    /** Samples a read needs before and after floor(p) */
+    static constexpr int kBefore = Taps / 2 - 1;
+    static constexpr int kAfter = Taps / 2;
+
+    constexpr SincTable(double cutoff) : table_()
+    {
+        for (int p = 0; p <= Phases; p++) {
+            const double frac = (double)p / Phases;
+            double h[Taps] = {};
+            double sum = 0.0;
+            for (int j = 0; j < Taps; j++) {
+                const double t = (double)(j - kBefore) - frac;
+                const double x = 2.0 * cutoff * t;
+                const double sinc = x == 0.0 ? 1.0 : Sin(kPi * x) / (kPi * x);
+                const double r = t / (Taps / 2);
+                const double window = r * r >= 1.0 ? 0.0 : BesselI0(kBeta * Sqrt(1.0 - r * r)) / BesselI0(kBeta);
+                h[j] = sinc * window;
+                sum += h[j];
+            }
+            for (int j = 0; j < Taps; j++) {
+                table_[p][j] = (float)(h[j] / sum);
+            }
+        }
+    }
+
+    /** Interpolated sample at pos, reading src[floor(pos) - kBefore] to
+        src[floor(pos) + kAfter]; pos must be non-negative */
+    template <typename Sample, typename Format>
+    inline float Read(const Sample* src, float pos) const
+    {
+        const int index = (int)pos;
+        const float phase = (pos - (float)index) * Phases;
+        const int p = (int)phase;
+        const float t = phase - (float)p;
+        const float* lo = table_[p];
+        const float* hi = table_[p + 1];
+        const Sample* x = &src[index - kBefore];
+
+        float sum = 0.0f;
+        for (int j = 0; j < Taps; j++) {
+            sum += Format::Load(x[j]) * (lo[j] + (hi[j] - lo[j]) * t);
+        }
+        return sum;
+    }
+
+  private:
+    static constexpr double kPi = 3.14159265358979323846;
+    static constexpr double kBeta = 6.0;  // Kaiser, about -60 dB side lobes
+
+    // Taylor series after reducing to [-pi, pi]
+    static constexpr double Sin(double x)
+    {
+        while (x > kPi) x -= 2.0 * kPi;
+        while (x < -kPi) x += 2.0 * kPi;
+        double term = x;
+        double sum = x;
+        for (int k = 1; k < 24; k++) {
+            term *= -x * x / ((2.0 * k) * (2.0 * k + 1.0));
+            sum += term;
+        }
+        return sum;
+    }
+
+    // Newton's method, as in FadeTable
+    static constexpr double Sqrt(double x)
+    {
+        if (x <= 0.0) return 0.0;
+        double y = x < 1.0 ? 1.0 : x;
+        for (int k = 0; k < 64; k++) {
+            y = 0.5 * (y + x / y);
+        }
+        return y;
+    }
+
+    static constexpr double BesselI0(double x)
+    {
+        double sum = 1.0;
+        double term = 1.0;
+        for (int k = 1; k < 32; k++) {
+            const double f = x / (2.0 * k);
+            term *= f * f;
+            sum += term;
+        }
+        return sum;
+    }
+
+    float table_[Phases + 1][Taps];
+};
+
+template <int Taps, int Phases>
+constexpr int SincTable<Taps, Phases>::kTaps;
+template <int Taps, int Phases>
+constexpr int SincTable<Taps, Phases>::kBefore;
+template <int Taps, int Phases>
+constexpr int SincTable<Taps, Phases>::kAfter;
+
+/** 8 taps, 64 phases, 2 KB each. sincUnity is for rates up to 1:1; sincOctave
+    has its cutoff halved for reads up to twice the original speed. */
+typedef SincTable<8, 64> SliceSinc;
+constexpr SliceSinc sincUnity{0.45};
+constexpr SliceSinc sincOctave{0.225};
+
+#endif  // SINC_TABLE_H
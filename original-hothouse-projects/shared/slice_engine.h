@@ -0,0 +1,720 @@
+// Slice Engine
+// Shared capture/playback core for the Ambien slicers (Ambien, Ambien Flux)
+
+#pragma once
+#ifndef SLICE_ENGINE_H
+#define SLICE_ENGINE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#include "sinc_table.h"
+
+/** Ring of up to MaxSlices audio slices of at most MaxLen samples each.
+
+    Capture fills one slice at a time and closes it on the first zero
+    crossing after it reaches the target length (or when the search window
+    runs out), then moves on to the next capture slice. Playback reads a
+    different slice than the one being written, forward or reversed, with a
+    fade at each end and a per-slice volume. SetRate() plays slices
+    faster or slower than they were recorded, tape-style, reading
+    fractional positions through the shared sinc tables (sinc_table.h).
+
+    The sample storage is owned by the pedal so it can live in SDRAM
+    (DSY_SDRAM_BSS objects must not have constructors). Sample picks the
+    storage format, see SliceSample; conversion happens in the capture
+    and playback loops.
+
+    Policy supplies everything that differs between pedals:
+
+        int   NextSlice(int current, int count)    playback order
+        bool  Reverse()                            direction of the next slice
+        int   NextCapture(int current, int count)  capture order
+        int   FadeLength(int length)               fade in/out length of a slice
+        float FadeShape(float ramp)                envelope for a ramp in [0, 1)
+        float Decay(float volume)                  volume after each full play
+        bool  Repeat()                             true to play the slice again
+        void  Started()                            a new slice began playing
+
+    PlaybackGrains() is the lush alternative to Playback(): up to
+    kMaxGrains overlapping grains, each from its own slice, and it also
+    needs
+
+        float GrainPitch()                         read rate of the next grain
+*/
+/** Slice storage formats. float is stored as-is; int16_t holds Q15, half
+    the SDRAM and bandwidth per sample, saturating outside [-1, 1]. */
+template <typename T>
+struct SliceSample;
+
+template <>
+struct SliceSample<float>
+{
+    static inline float Store(float x) { return x; }
+    static inline float Load(float x) { return x; }
+
+    static inline void Store(float* dst, const float* src, size_t size)
+    {
+        memcpy(dst, src, size * sizeof(float));
+    }
+};
+
+template <>
+struct SliceSample<int16_t>
+{
+    static inline int16_t Store(float x)
+    {
+        if (x > 1.0f) x = 1.0f;
+        if (x < -1.0f) x = -1.0f;
+        return (int16_t)(x * 32767.0f + (x >= 0.0f ? 0.5f : -0.5f));
+    }
+
+    static inline float Load(int16_t x) { return (float)x * (1.0f / 32767.0f); }
+
+    static inline void Store(int16_t* dst, const float* src, size_t size)
+    {
+        for (size_t i = 0; i < size; i++) {
+            dst[i] = Store(src[i]);
+        }
+    }
+};
+
+template <int MaxSlices, int MaxLen, typename Policy, typename Sample = float>
+class SliceEngine
+{
+  public:
+    typedef Sample Slice[MaxLen];
+    typedef SliceSample<Sample> Format;
+
+    SliceEngine() {}
+    ~SliceEngine() {}
+
+    /** Pedal-specific hooks; public so the pedal can reach its state */
+    Policy policy;
+
+    /** Attach storage (contents may be uninitialised) and reset */
+    void Init(Slice* buffers)
+    {
+        buffers_ = buffers;
+        Reset();
+    }
+
+    /** Drop all slices and restart capture from slice 0. Only the
+        metadata is cleared: playback never reads past a slice's captured
+        length, so stale samples are unreachable and the buffers need no
+        zero fill. Cheap enough to call from the audio callback. */
+    void Reset()
+    {
+        for (int slice = 0; slice < MaxSlices; slice++) {
+            lengths_[slice] = 0;
+            volumes_[slice] = 1.0f;
+        }
+
+        capture_ = 0;
+        capture_pos_ = 0;
+        play_ = 0;
+        play_pos_ = 0;
+        SetFade(1);
+        reverse_ = false;
+        has_content_ = false;
+
+        searching_ = false;
+        left_zero_ = false;
+        search_count_ = 0;
+        previous_ = 0.0f;
+
+        grains_ = 0;
+        grain_countdown_ = 0;
+        grain_slice_ = 0;
+        grain_spawns_ = 0;
+    }
+
+    /** Number of slices in the ring, 1 to MaxSlices */
+    inline void SetSliceCount(int count)
+    {
+        count_ = count < 1 ? 1 : (count > MaxSlices ? MaxSlices : count);
+    }
+
+    /** Nominal slice length in samples; capture then waits for a zero crossing */
+    inline void SetTargetLength(int length)
+    {
+        target_ = length < 1 ? 1 : (length > MaxLen ? MaxLen : length);
+    }
+
+    /** Playback speed, 0.25 to 2; 1 reads the slices sample for sample */
+    inline void SetRate(float rate)
+    {
+        rate_ = rate < 0.25f ? 0.25f : (rate > 2.0f ? 2.0f : rate);
+    }
+
+    /** Longest wait for a zero crossing past the target length, in samples */
+    inline void SetSearchWindow(int samples) { search_window_ = samples; }
+
+    inline bool HasContent() const { return has_content_; }
+
+    /** Capture one sample into the current slice */
+    void Capture(float input)
+    {
+        if (searching_) {
+            search_count_++;
+
+            if (fabsf(input) > kZeroThreshold) {
+                left_zero_ = true;
+            }
+
+            bool crossed = left_zero_ && ((previous_ > 0.0f && input <= 0.0f) ||
+                                          (previous_ < 0.0f && input >= 0.0f));
+
+            if (crossed || search_count_ >= search_window_ || capture_pos_ >= MaxLen) {
+                FinishSlice();
+            }
+        }
+
+        previous_ = input;
+
+        if (capture_pos_ < MaxLen) {
+            buffers_[capture_][capture_pos_] = Format::Store(input);
+            capture_pos_++;
+        }
+
+        if (!searching_ && capture_pos_ >= target_) {
+            searching_ = true;
+            left_zero_ = false;
+            search_count_ = 0;
+        }
+    }
+
+    /** Play one sample from the current slice */
+    float Playback()
+    {
+        if (!has_content_) {
+            return 0.0f;
+        }
+
+        // Never read the slice that is being written
+        if (play_ == capture_) {
+            int next = policy.NextSlice(play_, count_);
+            if (next != capture_ && lengths_[next] > 0) {
+                StartSlice(next);
+            }
+        }
+
+        int length = lengths_[play_];
+        if (length <= 0) {
+            return 0.0f;
+        }
+
+        int read = reverse_ ? length - 1 - play_pos_ : play_pos_;
+        if (read >= length) read = length - 1;
+        if (read < 0) read = 0;
+
+        float output = Format::Load(buffers_[play_][read]) * Envelope(play_pos_, length) * volumes_[play_];
+
+        play_pos_++;
+
+        if (play_pos_ >= length) {
+            EndSlice();
+        }
+
+        return output;
+    }
+
+    /** Capture a block of samples. Runs up to the target length are
+        copied straight into the buffer; past it, one scan finds where the
+        slice ends and everything before that is copied in one go. */
+    void Capture(const float* in, size_t size)
+    {
+        size_t i = 0;
+        while (i < size) {
+            if (searching_) {
+                size_t run = ScanForEnd(&in[i], size - i);
+                Format::Store(&buffers_[capture_][capture_pos_], &in[i], run);
+                capture_pos_ += (int)run;
+                i += run;
+                if (i < size) {
+                    // in[i] ends the slice and starts the next one
+                    FinishSlice();
+                }
+                continue;
+            }
+
+            int room = target_ - capture_pos_;
+            if (room <= 0) {
+                Capture(in[i++]);
+                continue;
+            }
+
+            size_t run = size - i < (size_t)room ? size - i : (size_t)room;
+            Format::Store(&buffers_[capture_][capture_pos_], &in[i], run);
+            capture_pos_ += (int)run;
+            i += run;
+            previous_ = in[i - 1];
+
+            if (capture_pos_ >= target_) {
+                searching_ = true;
+                left_zero_ = false;
+                search_count_ = 0;
+            }
+        }
+    }
+
+    /** Play a block of samples. Between the fades a slice is read as one
+        contiguous run at constant gain; fades and slice changes fall back
+        to the per-sample path. */
+    void Playback(float* out, size_t size)
+    {
+        if (rate_ != 1.0f) {
+            PlaybackAtRate(out, size);
+            return;
+        }
+
+        size_t i = 0;
+        while (i < size) {
+            if (!has_content_ || play_ == capture_) {
+                out[i++] = Playback();
+                continue;
+            }
+
+            int length = lengths_[play_];
+            int flat_end = length - fade_ > 0 ? length - fade_ : length;
+            if (length <= 0 || play_pos_ < fade_ || play_pos_ >= flat_end) {
+                out[i++] = Playback();
+                continue;
+            }
+
+            int run = flat_end - play_pos_;
+            if ((size_t)run > size - i) run = (int)(size - i);
+
+            const float volume = volumes_[play_];
+            if (reverse_) {
+                // Walking SDRAM backwards gets one sample per access out of
+                // the bus; copy each piece forwards into the staging buffer
+                // (burst reads, ascending lines) and reverse it from there
+                const int end = length - play_pos_;
+                for (int done = 0; done < run; done += kStage) {
+                    const int n = run - done < kStage ? run - done : kStage;
+                    memcpy(stage_, &buffers_[play_][end - done - n], (size_t)n * sizeof(Sample));
+                    const Sample* src = &stage_[n - 1];
+                    for (int k = 0; k < n; k++) {
+                        out[i + done + k] = Format::Load(src[-k]) * volume;
+                    }
+                }
+            } else {
+                const Sample* src = &buffers_[play_][play_pos_];
+                for (int k = 0; k < run; k++) {
+                    out[i + k] = Format::Load(src[k]) * volume;
+                }
+            }
+
+            play_pos_ += run;
+            i += run;
+
+            if (play_pos_ >= length) {
+                EndSlice();
+            }
+        }
+    }
+
+    static constexpr int kMaxGrains = 4;
+
+    /** Grains sounding at once in PlaybackGrains(), 2 to kMaxGrains */
+    inline void SetGrainVoices(int voices)
+    {
+        voices = voices < 2 ? 2 : (voices > kMaxGrains ? kMaxGrains : voices);
+        if (voices != grain_voices_) {
+            grain_voices_ = voices;
+            grain_norm_ = sqrtf(2.0f / (float)voices);
+        }
+    }
+
+    /** Play a block as overlapping grains. A grain is a target-length
+        sin(pi t) window over one slice, read through the sinc tables in
+        its own direction (Reverse()) and at its own rate (GrainPitch());
+        a new one starts every target / voices samples, so the windows' squares sum to
+        voices / 2 and grain_norm_ brings the power back to one slice's.
+        Grain state is kept as arrays and each grain is mixed over a whole
+        run of the block, so the cost is linear in the grains sounding and
+        the inner loop has no branches. A slice decays once for every
+        voices grains read from the ring, as often as Playback() decays it. */
+    void PlaybackGrains(float* out, size_t size)
+    {
+        memset(out, 0, size * sizeof(float));
+
+        size_t i = 0;
+        while (i < size) {
+            if (grain_countdown_ <= 0) {
+                grain_countdown_ = GrainInterval();
+                SpawnGrain();
+            }
+
+            size_t run = size - i;
+            if ((size_t)grain_countdown_ < run) run = (size_t)grain_countdown_;
+
+            for (int g = 0; g < grains_; g++) {
+                const int n = grain_left_[g] < (int)run ? grain_left_[g] : (int)run;
+                MixGrain(g, &out[i], n);
+            }
+
+            // Retire finished grains, keeping the live ones packed at the front
+            for (int g = grains_ - 1; g >= 0; g--) {
+                if (grain_left_[g] <= 0) {
+                    RetireGrain(g);
+                }
+            }
+
+            grain_countdown_ -= (int)run;
+            i += run;
+        }
+    }
+
+  private:
+    static constexpr float kZeroThreshold = 0.01f;  // ~1% hysteresis
+    static constexpr int kStage = 128;              // Reverse staging, samples
+
+    /** Runs the zero-crossing search over a block without writing it.
+        Returns how many samples still belong to the current slice; if
+        that is less than size, the next sample closes it. */
+    size_t ScanForEnd(const float* in, size_t size)
+    {
+        const size_t room = (size_t)(MaxLen - capture_pos_);
+
+        for (size_t k = 0; k < size; k++) {
+            const float x = in[k];
+            search_count_++;
+
+            if (fabsf(x) > kZeroThreshold) {
+                left_zero_ = true;
+            }
+
+            bool crossed = left_zero_ && ((previous_ > 0.0f && x <= 0.0f) ||
+                                          (previous_ < 0.0f && x >= 0.0f));
+
+            if (crossed || search_count_ >= search_window_ || k >= room) {
+                return k;
+            }
+
+            previous_ = x;
+        }
+
+        return size;
+    }
+
+    void FinishSlice()
+    {
+        lengths_[capture_] = capture_pos_;
+        volumes_[capture_] = 1.0f;  // Full volume on every new capture
+
+        if (!has_content_) {
+            has_content_ = true;
+            StartSlice(capture_);
+        }
+
+        capture_ = policy.NextCapture(capture_, count_);
+        capture_pos_ = 0;
+        searching_ = false;
+        left_zero_ = false;
+        search_count_ = 0;
+    }
+
+    /** A slice played through: decay it and pick what plays next */
+    void EndSlice()
+    {
+        play_pos_ = 0;
+        volumes_[play_] = policy.Decay(volumes_[play_]);
+
+        if (!policy.Repeat()) {
+            int next = policy.NextSlice(play_, count_);
+            if (next == capture_) {
+                next = policy.NextSlice(next, count_);
+            }
+            if (lengths_[next] > 0) {
+                StartSlice(next);
+            }
+        }
+
+        SetFade(policy.FadeLength(lengths_[play_]));
+    }
+
+    void StartSlice(int slice)
+    {
+        play_ = slice;
+        play_pos_ = 0;
+        reverse_ = policy.Reverse();
+        SetFade(policy.FadeLength(lengths_[slice]));
+        policy.Started();
+    }
+
+    /** Source samples a fractional read can cover in a slice of length,
+        leaving the interpolator's taps inside it */
+    static inline int ReadSpan(int length)
+    {
+        return length - 1 - SliceSinc::kBefore - SliceSinc::kAfter;
+    }
+
+    /** Playback(block) at rate_ != 1. A slice lasts span / rate output
+        samples, play_pos_ counting them; the fades follow the read
+        position in the slice, so they speed up and slow down with it. */
+    void PlaybackAtRate(float* out, size_t size)
+    {
+        const SliceSinc& sinc = rate_ > 1.0f ? sincOctave : sincUnity;
+
+        size_t i = 0;
+        while (i < size) {
+            if (!has_content_) {
+                out[i++] = 0.0f;
+                continue;
+            }
+
+            // Never read the slice that is being written
+            if (play_ == capture_) {
+                int next = policy.NextSlice(play_, count_);
+                if (next != capture_ && lengths_[next] > 0) {
+                    StartSlice(next);
+                }
+            }
+
+            const int length = lengths_[play_];
+            const int span = ReadSpan(length);
+            const int frames = span > 0 ? (int)((float)span / rate_) + 1 : 0;
+            if (play_pos_ >= frames) {
+                // Too short for the taps, or the rate just went up
+                out[i++] = 0.0f;
+                if (length > 0) {
+                    EndSlice();
+                }
+                continue;
+            }
+
+            int run = frames - play_pos_;
+            if ((size_t)run > size - i) run = (int)(size - i);
+
+            const Sample* src = buffers_[play_];
+            const float volume = volumes_[play_];
+            const float start = reverse_ ? (float)(length - 1 - SliceSinc::kAfter) : (float)SliceSinc::kBefore;
+            const float step = reverse_ ? -rate_ : rate_;
+            for (int k = 0; k < run; k++) {
+                const float n = (float)(play_pos_ + k);
+                const float read = sinc.template Read<Sample, Format>(src, start + n * step);
+                out[i + k] = read * Envelope((int)(n * rate_), span + 1) * volume;
+            }
+
+            play_pos_ += run;
+            i += run;
+
+            if (play_pos_ >= frames) {
+                EndSlice();
+            }
+        }
+    }
+
+    inline int GrainInterval() const
+    {
+        const int interval = target_ / grain_voices_;
+        return interval < 1 ? 1 : interval;
+    }
+
+    /** Start a grain on the next slice in playback order that has audio,
+        skipping the one being written and any the ring has not filled yet */
+    void SpawnGrain()
+    {
+        if (!has_content_ || grains_ >= kMaxGrains) {
+            return;
+        }
+
+        int slice = grain_slice_;
+        for (int tries = 0; tries < count_; tries++) {
+            slice = policy.NextSlice(slice, count_);
+            if (slice != capture_ && lengths_[slice] >= 2) {
+                break;
+            }
+        }
+        grain_slice_ = slice;
+
+        const int length = lengths_[slice];
+        if (slice == capture_ || length < 2) {
+            return;
+        }
+
+        // voices intervals long, or as much as the slice holds at this rate
+        // with room for the interpolator's taps either side
+        const float pitch = policy.GrainPitch();
+        const int span = ReadSpan(length);
+        int frames = GrainInterval() * grain_voices_;
+        const int fit = span > 0 ? (int)((float)span / pitch) + 1 : 0;
+        if (frames > fit) frames = fit;
+        if (frames < 2) {
+            return;
+        }
+
+        const int g = grains_++;
+        grain_source_[g] = slice;
+        grain_sinc_[g] = pitch > 1.0f ? &sincOctave : &sincUnity;
+        if (policy.Reverse()) {
+            grain_start_[g] = (float)(length - 1 - SliceSinc::kAfter);
+            grain_step_[g] = -pitch;
+        } else {
+            grain_start_[g] = (float)SliceSinc::kBefore;
+            grain_step_[g] = pitch;
+        }
+        grain_done_[g] = 0;
+        grain_left_[g] = frames;
+        grain_gain_[g] = volumes_[slice] * grain_norm_;
+
+        // The window is a phasor turned by pi / frames per sample, centred
+        // on the samples so it starts and ends a half step off zero
+        const float w = (float)M_PI / (float)frames;
+        grain_sin_[g] = sinf(0.5f * w);
+        grain_cos_[g] = cosf(0.5f * w);
+        grain_turn_sin_[g] = sinf(w);
+        grain_turn_cos_[g] = cosf(w);
+
+        grain_decays_[g] = ++grain_spawns_ >= grain_voices_;
+        if (grain_decays_[g]) {
+            grain_spawns_ = 0;
+        }
+
+        policy.Started();
+    }
+
+    /** Add n samples of grain g to out */
+    inline void MixGrain(int g, float* out, int n)
+    {
+        const Sample* src = buffers_[grain_source_[g]];
+        const SliceSinc& sinc = *grain_sinc_[g];
+        const float start = grain_start_[g];
+        const float step = grain_step_[g];
+        const float gain = grain_gain_[g];
+        const float turn_sin = grain_turn_sin_[g];
+        const float turn_cos = grain_turn_cos_[g];
+        const int done = grain_done_[g];
+        float s = grain_sin_[g];
+        float c = grain_cos_[g];
+
+        for (int k = 0; k < n; k++) {
+            // From the start each time, so the read never drifts off the slice
+            const float pos = start + (float)(done + k) * step;
+            out[k] += sinc.template Read<Sample, Format>(src, pos) * s * gain;
+
+            const float next = s * turn_cos + c * turn_sin;
+            c = c * turn_cos - s * turn_sin;
+            s = next;
+        }
+
+        // Pull the phasor back onto the unit circle once per run
+        const float norm = 1.0f / sqrtf(s * s + c * c);
+        grain_sin_[g] = s * norm;
+        grain_cos_[g] = c * norm;
+        grain_done_[g] = done + n;
+        grain_left_[g] -= n;
+    }
+
+    void RetireGrain(int g)
+    {
+        if (grain_decays_[g]) {
+            const int slice = grain_source_[g];
+            volumes_[slice] = policy.Decay(volumes_[slice]);
+        }
+
+        const int last = --grains_;
+        grain_source_[g] = grain_source_[last];
+        grain_sinc_[g] = grain_sinc_[last];
+        grain_start_[g] = grain_start_[last];
+        grain_step_[g] = grain_step_[last];
+        grain_done_[g] = grain_done_[last];
+        grain_left_[g] = grain_left_[last];
+        grain_gain_[g] = grain_gain_[last];
+        grain_sin_[g] = grain_sin_[last];
+        grain_cos_[g] = grain_cos_[last];
+        grain_turn_sin_[g] = grain_turn_sin_[last];
+        grain_turn_cos_[g] = grain_turn_cos_[last];
+        grain_decays_[g] = grain_decays_[last];
+    }
+
+    /** Fade length is fixed per slice, so divide once when it is set */
+    inline void SetFade(int fade)
+    {
+        fade_ = fade < 1 ? 1 : fade;
+        fade_recip_ = 1.0f / (float)fade_;
+    }
+
+    /** Fade in over the first fade_ samples, out over the last fade_ */
+    inline float Envelope(int position, int length)
+    {
+        float ramp = 1.0f;
+
+        if (position < fade_) {
+            ramp = (float)position * fade_recip_;
+        }
+
+        int fade_out_start = length - fade_;
+        if (fade_out_start > 0 && position >= fade_out_start) {
+            float ramp_out = 1.0f - (float)(position - fade_out_start) * fade_recip_;
+            if (ramp_out < ramp) {
+                ramp = ramp_out;
+            }
+        }
+
+        return ramp < 1.0f ? policy.FadeShape(ramp) : 1.0f;
+    }
+
+    Slice* buffers_ = nullptr;
+    int lengths_[MaxSlices];
+    float volumes_[MaxSlices];  // Per-slice level, decays with each play
+
+    int count_ = 1;
+    int target_ = 1;
+    int search_window_ = 1000;
+
+    // Capture state
+    int capture_ = 0;
+    int capture_pos_ = 0;
+    bool has_content_ = false;
+
+    // Zero-crossing search
+    bool searching_ = false;
+    bool left_zero_ = false;
+    int search_count_ = 0;
+    float previous_ = 0.0f;
+
+    // Playback state
+    int play_ = 0;
+    int play_pos_ = 0;
+    int fade_ = 1;
+    float fade_recip_ = 1.0f;
+    bool reverse_ = false;
+    float rate_ = 1.0f;
+    Sample stage_[kStage];  // With the engine, so in DTCM when it is
+
+    // Grain playback, live grains packed at the front of each array
+    int grains_ = 0;
+    int grain_voices_ = 2;
+    float grain_norm_ = 1.0f;
+    int grain_countdown_ = 0;      // Samples to the next grain
+    int grain_slice_ = 0;          // Slice the last grain was read from
+    int grain_spawns_ = 0;
+    int grain_source_[kMaxGrains];
+    const SliceSinc* grain_sinc_[kMaxGrains];
+    float grain_start_[kMaxGrains];
+    float grain_step_[kMaxGrains];  // Read rate, negative in reverse
+    int grain_done_[kMaxGrains];
+    int grain_left_[kMaxGrains];
+    float grain_gain_[kMaxGrains];
+    float grain_sin_[kMaxGrains];   // Window phasor
+    float grain_cos_[kMaxGrains];
+    float grain_turn_sin_[kMaxGrains];
+    float grain_turn_cos_[kMaxGrains];
+    bool grain_decays_[kMaxGrains];
+};
+
+template <int MaxSlices, int MaxLen, typename Policy, typename Sample>
+constexpr float SliceEngine<MaxSlices, MaxLen, Policy, Sample>::kZeroThreshold;
+
+template <int MaxSlices, int MaxLen, typename Policy, typename Sample>
+constexpr int SliceEngine<MaxSlices, MaxLen, Policy, Sample>::kStage;
+
+template <int MaxSlices, int MaxLen, typename Policy, typename Sample>
+constexpr int SliceEngine<MaxSlices, MaxLen, Policy, Sample>::kMaxGrains;
+
+#endif  // SLICE_ENGINE_H
@@ -0,0 +1,209 @@
+// Multi Pitch
+// Harmonic-sum polyphonic pitch estimator on Simp's 8kHz analysis bus
+
+#pragma once
+#ifndef MULTI_PITCH_H
+#define MULTI_PITCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <math.h>
+#include "hothouse_stft.h"
+#include "hothouse_wave.h"
+#include "hothouse_spsc.h"
+#include "hothouse_fastmath.h"
+
+/** Estimates up to kMaxPitches simultaneous fundamentals per frame, for
+    chords. Frames are kFrameSize samples of the 8kHz bus (128 ms, 7.8 Hz
+    bins), one every kHop (32 ms), from the shared STFT's Analyzer
+    (hothouse_stft.h) on ShyFFT.
+
+    The work is deferred as in Venus's Fourier: Write(), in the audio
+    callback, only copies samples into the Analyzer's ring. Service(), in
+    the main loop, has it window and transform the completed frames, scores
+    each spectrum, and hands each Estimate back through a queue, which
+    Latest() drains in the callback. A frame the main loop reaches after the
+    ring has wrapped over it is skipped and counted in LateFrames().
+
+    Scoring is iterative harmonic summation: every semitone candidate from
+    kLowestNote to kHighestNote sums its first kHarmonics partials (peak of
+    the three nearest bins, weighted 1/h). The best candidate is taken if
+    its fundamental bin is itself a real peak, its partials are cancelled
+    from the spectrum, and the search repeats until kMaxPitches are found
+    or the best remaining score drops below kMinSalience of the first. The
+    frequency is refined by parabolic interpolation on the strongest of the
+    first four partials. */
+class MultiPitch
+{
+  public:
+    static const size_t kFrameSize = 1024;
+    static const size_t kHop = 256;
+    static const size_t kRing = 2048;  // kFrameSize plus four hops of slack
+    static constexpr float kRate = 8000.0f;
+    static constexpr float kBinHz = kRate / kFrameSize;
+    static const size_t kMaxPitches = 6;
+    static const int kLowestNote = 40;   // E2 (MIDI)
+    static const int kHighestNote = 88;  // E6
+    static const int kCandidates = kHighestNote - kLowestNote + 1;
+    static const int kHarmonics = 8;
+    static constexpr float kMinSalience = 0.2f;
+    static constexpr float kMinFundamental = 0.05f;  // Of the frame's peak bin
+
+    struct Estimate
+    {
+        size_t count;
+        float freq[kMaxPitches];
+        float salience[kMaxPitches];  // Score relative to the strongest pitch
+    };
+
+    MultiPitch() : analyzer_(&fft_, clevelandmusicco::Hann(), kHop, ring_, frame_, spectrum_) {}
+    ~MultiPitch() {}
+
+    void Init()
+    {
+        fft_.Init();
+        analyzer_.reset();
+        for (int c = 0; c < kCandidates; c++) {
+            candidate_hz_[c] = 440.0f * powf(2.0f, (kLowestNote + c - 69) / 12.0f);
+        }
+    }
+
+    /** Audio callback: this block's analysis bus samples */
+    void Write(const float* bus, size_t count) { analyzer_.write(bus, count); }
+
+    /** Main loop: analyses every queued frame */
+    void Service()
+    {
+        analyzer_.service([this](const float* spectrum) {
+            Estimate estimate;
+            Analyse(spectrum, estimate);
+            results_.Push(estimate);
+        });
+    }
+
+    /** Audio callback: the newest estimate, false if none since last call */
+    bool Latest(Estimate& estimate)
+    {
+        bool got = false;
+        while (results_.Pop(estimate)) {
+            got = true;
+        }
+        return got;
+    }
+
+    uint32_t LateFrames() const { return analyzer_.late_frames; }
+
+  private:
+    static const size_t kBins = kFrameSize / 2 + 1;
+
+    void Analyse(const float* spectrum, Estimate& estimate)
+    {
+        // ShyFFT layout: real parts in [0, N/2], imaginary in [N/2 + 1, N)
+        float peak = 0.0f;
+        magnitude_[0] = fabsf(spectrum[0]);
+        magnitude_[kBins - 1] = fabsf(spectrum[kFrameSize / 2]);
+        for (size_t k = 1; k < kBins - 1; k++) {
+            float re = spectrum[k];
+            float im = spectrum[kFrameSize / 2 + k];
+            magnitude_[k] = fastmath::Sqrt(re * re + im * im);
+            peak = fmaxf(peak, magnitude_[k]);
+        }
+
+        estimate.count = 0;
+        float first_score = 0.0f;
+        while (estimate.count < kMaxPitches) {
+            int best = -1;
+            float best_score = 0.0f;
+            for (int c = 0; c < kCandidates; c++) {
+                if (PartialPeak(candidate_hz_[c]) < kMinFundamental * peak) continue;
+                float score = HarmonicSum(candidate_hz_[c]);
+                if (score > best_score) {
+                    best_score = score;
+                    best = c;
+                }
+            }
+
+            if (best < 0) break;
+            if (estimate.count == 0) {
+                if (best_score <= 0.0f) break;
+                first_score = best_score;
+            } else if (best_score < kMinSalience * first_score) {
+                break;
+            }
+
+            estimate.freq[estimate.count] = Refine(candidate_hz_[best]);
+            estimate.salience[estimate.count] = best_score / first_score;
+            estimate.count++;
+            Cancel(candidate_hz_[best]);
+        }
+    }
+
+    /** Largest magnitude in the three bins nearest f */
+    float PartialPeak(float f) const
+    {
+        int k = (int)(f / kBinHz + 0.5f);
+        if (k < 1 || k >= (int)kBins - 1) return 0.0f;
+        return fmaxf(magnitude_[k], fmaxf(magnitude_[k - 1], magnitude_[k + 1]));
+    }
+
+    float HarmonicSum(float f0) const
+    {
+        float sum = 0.0f;
+        for (int h = 1; h <= kHarmonics; h++) {
+            sum += PartialPeak(f0 * h) / (float)h;
+        }
+        return sum;
+    }
+
+    /** Zeroes the bins under f0's partials so the next search skips them */
+    void Cancel(float f0)
+    {
+        for (int h = 1; h <= kHarmonics; h++) {
+            int k = (int)(f0 * h / kBinHz + 0.5f);
+            for (int j = k - 1; j <= k + 1; j++) {
+                if (j >= 0 && j < (int)kBins) magnitude_[j] = 0.0f;
+            }
+        }
+    }
+
+    /** f0 from the parabolic peak of its strongest partial among the first four */
+    float Refine(float f0) const
+    {
+        int best_h = 1;
+        int best_k = 0;
+        float best_mag = 0.0f;
+        for (int h = 1; h <= 4; h++) {
+            int k = (int)(f0 * h / kBinHz + 0.5f);
+            if (k < 1 || k >= (int)kBins - 1) break;
+            for (int j = k - 1; j <= k + 1; j++) {
+                if (j >= 1 && j < (int)kBins - 1 && magnitude_[j] > best_mag) {
+                    best_mag = magnitude_[j];
+                    best_k = j;
+                    best_h = h;
+                }
+            }
+        }
+        if (best_k == 0) return f0;
+
+        float a = magnitude_[best_k - 1];
+        float b = magnitude_[best_k];
+        float c = magnitude_[best_k + 1];
+        float denom = a - 2.0f * b + c;
+        float delta = denom != 0.0f ? 0.5f * (a - c) / denom : 0.0f;
+        return (best_k + delta) * kBinHz / best_h;
+    }
+
+    typedef ShyFFT<float, kFrameSize, RotationPhasor> FFT;
+
+    FFT fft_;
+    float ring_[kRing];
+    float frame_[kFrameSize];
+    float spectrum_[kFrameSize];
+    float magnitude_[kBins];
+    float candidate_hz_[kCandidates];
+
+    clevelandmusicco::Analyzer<float, kFrameSize, FFT, kRing> analyzer_;
+    clevelandmusicco::SpscQueue<Estimate, 4> results_;
+};
+
+#endif  // MULTI_PITCH_H
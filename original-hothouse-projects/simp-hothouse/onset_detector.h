@@ -0,0 +1,134 @@
+// Onset Detector
+// q::onset_gate pick-attack detection on Simp's 8kHz analysis bus
+
+#pragma once
+#ifndef ONSET_DETECTOR_H
+#define ONSET_DETECTOR_H
+
+#include <stddef.h>
+#include <math.h>
+#include <q/support/literals.hpp>
+#include <q/fx/envelope.hpp>
+#include <q/fx/onset_gate.hpp>
+#include <q/fx/differentiator.hpp>
+#include "Util/Multirate.h"
+#include "hothouse_fastmath.h"
+
+/** Detects pick attacks on the analysis bus so a voice can be excited
+    straight away, without waiting for the pitch detector's window: the
+    detector only needs the first couple of milliseconds of the attack, the
+    pitch tracker needs two periods.
+
+    The rectified bus drives a peak envelope follower (kRelease). From
+    silence, q's onset_gate fires when the envelope rises by more than
+    kOnsetDb within kAttackWidth, so a swell doesn't count, and stays open
+    until the envelope falls under kReleaseDb. A re-pick of a ringing
+    string never closes that gate, so while it is open an onset is also a
+    rise of kRetrigger times the level within kAttackWidth; the release is
+    long enough that one low E period of ripple (about 1.27 times) stays
+    under that. After an onset, kHoldOff must pass before the next one, so
+    one attack's bounces count once.
+
+    The velocity is the envelope's peak over the kVelocityWindow after
+    detection, in dB from kFloorDb (0) to kFullDb (1): at detection the
+    envelope is still on its way up, so its level then says more about how
+    early the attack was caught than how hard it was picked. The onset is
+    reported at the end of the window, about 2 ms into the attack.
+
+    Process() runs on every bus sample in the callback: a follower, a short
+    slope ring and a few compares per sample. */
+class OnsetDetector
+{
+  public:
+    static constexpr float kSampleRate = 48000.0f;
+    static constexpr float kRate = kSampleRate / resample_factor;  // 8kHz
+    static constexpr float kOnsetDb = -45.0f;
+    static constexpr float kReleaseDb = -60.0f;
+    static constexpr float kAttackWidth = 0.002f;  // Seconds
+    static constexpr float kRelease = 0.1f;        // Seconds
+    static constexpr float kRetrigger = 1.5f;      // +3.5 dB
+    static constexpr float kHoldOff = 0.05f;       // Seconds
+    static constexpr float kVelocityWindow = 0.0015f;  // Seconds
+    static constexpr float kFloorDb = -42.0f;
+    static constexpr float kFullDb = 0.0f;
+
+    OnsetDetector()
+        : envelope_{cycfi::q::duration(kRelease), kRate}
+        , gate_{cycfi::q::decibel(kOnsetDb, cycfi::q::direct_unit),
+                cycfi::q::decibel(kReleaseDb, cycfi::q::direct_unit),
+                cycfi::q::duration(kAttackWidth), kRate}
+        , rise_{cycfi::q::duration(kAttackWidth), kRate}
+    {
+    }
+    ~OnsetDetector() {}
+
+    void Init()
+    {
+        envelope_ = 0.0f;
+        open_ = false;
+        holdOff_ = 0;
+        window_ = 0;
+        peak_ = 0.0f;
+        velocity_ = 0.0f;
+    }
+
+    /** Audio callback: this block's analysis bus samples (kRate). Returns
+        true if an onset fell in them. */
+    bool Process(const float* bus, size_t count)
+    {
+        bool onset = false;
+        for (size_t i = 0; i < count; i++) {
+            float env = envelope_(fabsf(bus[i]));
+            float rise = rise_(env);
+            bool open = gate_(env);
+            bool attack = (open && !open_) || (open && rise > (kRetrigger - 1.0f) * (env - rise));
+            open_ = open;
+
+            if (window_ > 0) {
+                peak_ = fmaxf(peak_, env);
+                if (--window_ == 0) {
+                    onset = true;
+                    velocity_ = Velocity(peak_);
+                }
+            }
+            if (holdOff_ > 0) {
+                holdOff_--;
+            } else if (attack) {
+                holdOff_ = kHoldOffSamples;
+                window_ = kWindowSamples;
+                peak_ = env;
+            }
+        }
+        return onset;
+    }
+
+    /** 0..1, from the envelope's peak at the last onset */
+    float Velocity() const { return velocity_; }
+
+    /** True while the onset gate is open (since the last onset, until the
+        envelope falls under kReleaseDb) */
+    bool Open() const { return open_; }
+
+  private:
+    static const size_t kHoldOffSamples = (size_t)(kHoldOff * kRate);
+    static const size_t kWindowSamples = (size_t)(kVelocityWindow * kRate);
+
+    static float Velocity(float env)
+    {
+        float db = 6.02059991f * fastmath::Log2(env + 1.0e-9f);
+        float v = (db - kFloorDb) / (kFullDb - kFloorDb);
+        return v < 0.0f ? 0.0f : (v > 1.0f ? 1.0f : v);
+    }
+
+    cycfi::q::peak_envelope_follower envelope_;
+    cycfi::q::onset_gate gate_;
+    cycfi::q::slope rise_;  // The envelope's rise over kAttackWidth
+
+    bool open_ = false;
+    size_t holdOff_ = 0;
+    size_t window_ = 0;  // Samples left to find the attack's peak in
+    float peak_ = 0.0f;
+    float velocity_ = 0.0f;
+};
+
+#endif  // ONSET_DETECTOR_H
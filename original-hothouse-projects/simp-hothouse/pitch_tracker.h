@@ -0,0 +1,141 @@
+// Pitch Tracker
+// q::pitch_detector on an 8kHz decimated, conditioned input for Simp's voices
+
+#pragma once
+#ifndef PITCH_TRACKER_H
+#define PITCH_TRACKER_H
+
+#include <stddef.h>
+#include <q/support/literals.hpp>
+#include <q/pitch/pitch_detector.hpp>
+#include <q/fx/signal_conditioner.hpp>
+#include "Util/Multirate.h"
+
+/** Monophonic pitch tracking for the string voices, on Simp's 8kHz
+    analysis bus (the input decimated by resample_factor with the octave
+    path's Decimator2): q's signal_conditioner, then its pitch_detector.
+
+    Cost per Process() call is bounded: decimated samples queue up and at
+    most kMaxPerBlock of them are analysed per call, stopping early after
+    the one that completed a detector window (the bitstream autocorrelation,
+    the expensive step). The queue absorbs the backlog over the next calls.
+
+    The detector's window is two periods of kLowest (about 29 ms), so until
+    it confirms a pitch the tracker reports q's edge-pair prediction at
+    kPredictedConfidence. That needs two similar pulses after the onset:
+    host runs put the first estimate at about 28 ms for low E, 14 ms at
+    196 Hz and 6 ms at 330 Hz, with confirmation at about 32 ms. */
+class PitchTracker
+{
+  public:
+    static constexpr float kSampleRate = 48000.0f;
+    static constexpr float kRate = kSampleRate / resample_factor;  // 8kHz
+    static constexpr float kLowest = 70.0f;                        // Below drop D
+    static constexpr float kHighest = 1400.0f;                     // Past the 24th fret
+    static constexpr float kPredictedConfidence = 0.5f;
+    static const size_t kMaxPerBlock = 8;
+    static const size_t kQueueSize = 64;
+
+    PitchTracker()
+        : conditioner_{conditioner_config_, cycfi::q::frequency(kLowest),
+                       cycfi::q::frequency(kHighest), kRate}
+        , detector_{cycfi::q::frequency(kLowest), cycfi::q::frequency(kHighest), kRate,
+                    cycfi::q::decibel(-45.0, cycfi::q::direct_unit)}
+    {
+    }
+    ~PitchTracker() {}
+
+    void Init()
+    {
+        head_ = 0;
+        tail_ = 0;
+        Reset();
+    }
+
+    /** Audio callback: feed this block's analysis bus samples (kRate) */
+    void Process(const float* bus, size_t count)
+    {
+        for (size_t i = 0; i < count; i++) {
+            Push(bus[i]);
+        }
+
+        for (size_t n = 0; n < kMaxPerBlock && tail_ != head_; n++) {
+            float s = queue_[tail_];
+            tail_ = (tail_ + 1) % kQueueSize;
+            if (Analyse(s)) break;
+        }
+    }
+
+    /** Tracked frequency in Hz, 0 while no note is detected */
+    float Frequency() const { return frequency_; }
+
+    /** 0..1: the detector's periodicity once confirmed, kPredictedConfidence
+        for an early prediction, 0 with no note */
+    float Confidence() const { return confidence_; }
+
+    /** True while the conditioner's gate is open (a note is sounding) */
+    bool Gate() const { return gate_; }
+
+    void Reset()
+    {
+        detector_.reset();
+        frequency_ = 0.0f;
+        confidence_ = 0.0f;
+        gate_ = false;
+    }
+
+  private:
+    void Push(float s)
+    {
+        size_t next = (head_ + 1) % kQueueSize;
+        if (next == tail_) {
+            tail_ = (tail_ + 1) % kQueueSize;  // Full: drop the oldest
+        }
+        queue_[head_] = s;
+        head_ = next;
+    }
+
+    /** One 8kHz sample; returns true if it completed a detector window */
+    bool Analyse(float s)
+    {
+        s = conditioner_(s);
+        bool gate = conditioner_.gate();
+        if (gate_ && !gate) {
+            Reset();
+        }
+        gate_ = gate;
+
+        bool ready = detector_(s);
+        if (!gate_) return ready;
+
+        float f = detector_.get_frequency();
+        if (f > 0.0f) {
+            frequency_ = f;
+            confidence_ = detector_.periodicity();
+        } else {
+            // The raw edge-pair period; predict_frequency() would hold it
+            // back behind its median until the prediction repeats
+            const cycfi::q::period_detector& pd = detector_.get_period_detector();
+            float period = pd.predict_period();
+            if (period >= pd.minimum_period()) {
+                frequency_ = kRate / period;
+                confidence_ = kPredictedConfidence;
+            }
+        }
+        return ready;
+    }
+
+    cycfi::q::signal_conditioner::config conditioner_config_;
+    cycfi::q::signal_conditioner conditioner_;
+    cycfi::q::pitch_detector detector_;
+
+    float queue_[kQueueSize];
+    size_t head_ = 0;
+    size_t tail_ = 0;
+
+    float frequency_ = 0.0f;
+    float confidence_ = 0.0f;
+    bool gate_ = false;
+};
+
+#endif  // PITCH_TRACKER_H
@@ -3,33 +3,18 @@
 void SimpHothouse::Init(float sampleRate) {
     // Initialize hardware
     hw.Init();
-    hw.SetAudioBlockSize(4);
+    hw.SetAudioBlockSize(kAudioBlockSize);
     
     // Initialize Hothouse controls
     controls.Init(&hw);
     
     // Initialize string voices
-    voice1.Init(sampleRate);
-    voice2.Init(sampleRate);
-    voice3.Init(sampleRate);
-    voice4.Init(sampleRate);
-    
-    // Set initial voice parameters
-    voice1.SetBrightness(0.7f);
-    voice1.SetDamping(0.5f);
-    voice1.SetStructure(0.5f);
-    
-    voice2.SetBrightness(0.6f);
-    voice2.SetDamping(0.6f);
-    voice2.SetStructure(0.5f);
-    
-    voice3.SetBrightness(0.5f);
-    voice3.SetDamping(0.7f);
-    voice3.SetStructure(0.5f);
-    
-    voice4.SetBrightness(0.8f);
-    voice4.SetDamping(0.4f);
-    voice4.SetStructure(0.5f);
+    voices.Init(sampleRate, kAudioBlockSize);
+    for (size_t v = 0; v < voices.Size(); v++) {
+        voices.SetBrightness(v, 0.7f);
+        voices.SetDamping(v, 0.5f);
+        voices.SetStructure(v, 0.5f);
+    }
     
     // Initialize parameters
     dryWetMix = 0.5f;
@@ -42,9 +27,20 @@ void SimpHothouse::Init(float sampleRate) {
     // Initialize state
     currentFreq = 0.0f;
     lastFreq = 0.0f;
+    pitchConfidence = 0.0f;
     noteActive = false;
+    lastNote = -1;
+    lastVoice = 0;
+    glideTime = 0.0f;
+    refineSamples = 0;
     
-    // TODO: Initialize pitch detector when ready
+    // Pitch and onset detectors run on the 8kHz decimated input
+    busChunkCount = 0;
+    pitch.Init();
+    multiPitch.Init();
+    onset.Init();
+    polyNoteCount = 0;
+    polyVelocity = 1.0f;
 }
 
 void SimpHothouse::UpdateControls() {
@@ -58,29 +54,153 @@ void SimpHothouse::UpdateControls() {
     decay = controls.GetKnobValue(Hothouse::KNOB_5);
     structure = controls.GetKnobValue(Hothouse::KNOB_6);
     
-    // Update string voice parameters
-    voice1.SetBrightness(brightness);
-    voice1.SetDamping(decay);
-    voice1.SetStructure(structure);
+    // Toggle 2: portamento. UP = long, MIDDLE = short, DOWN = off (a new
+    // voice per note)
+    switch (controls.GetToggleswitchPosition(Hothouse::TOGGLESWITCH_2)) {
+        case Hothouse::TOGGLESWITCH_UP: glideTime = 0.25f; break;
+        case Hothouse::TOGGLESWITCH_MIDDLE: glideTime = 0.06f; break;
+        default: glideTime = 0.0f; break;
+    }
     
-    voice2.SetBrightness(brightness * 0.9f);
-    voice2.SetDamping(decay * 1.1f);
-    voice2.SetStructure(structure);
+    // Update string voice parameters, spread a little per voice
+    static const float brightnessSpread[4] = {1.0f, 0.9f, 0.8f, 1.1f};
+    static const float dampingSpread[4] = {1.0f, 1.1f, 1.2f, 0.9f};
+    for (size_t v = 0; v < voices.Size(); v++) {
+        voices.SetBrightness(v, brightness * brightnessSpread[v % 4]);
+        voices.SetDamping(v, decay * dampingSpread[v % 4]);
+        voices.SetStructure(v, structure);
+    }
+}
+
+void SimpHothouse::ServiceAnalysis() {
+#if SIMP_POLY
+    multiPitch.Service();
+#endif
+}
+
+// MIDI note number, A4 = 69: never negative in the tracker's range, so -1
+// can stand for no note
+static inline int MidiNote(float freq) {
+    return (int)roundf(69.0f + 12.0f * log2f(freq / 440.0f));
+}
+
+// A new voice on each pick attack, straight away: the onset detector
+// catches it about 2 ms in, long before the tracker has a pitch, so the
+// voice starts at the last tracked pitch and for kRefineSamples after, or
+// until the tracker confirms, each estimate retunes it without a retrigger.
+// After that, a change of tracked semitone glides the sounding voice there
+// with portamento on, otherwise it starts another voice and the previous
+// note keeps ringing in its own until stolen. So does a note the onset
+// detector missed (a swell, a soft re-pick), once the tracker finds it.
+void SimpHothouse::TriggerMono(bool picked, size_t size) {
+    noteActive = pitch.Gate();
+    pitchConfidence = pitch.Confidence();
+    float freq = pitch.Frequency();
+    if (freq > 0.0f) {
+        currentFreq = freq;
+    }
+    
+    if (picked) {
+        lastFreq = currentFreq > 0.0f ? currentFreq : kFirstGuessFreq;
+        lastVoice = voices.NoteOn(lastFreq, 0.2f + 0.8f * onset.Velocity());
+        lastNote = -1;
+        refineSamples = kRefineSamples;
+        return;
+    }
+    
+    if (refineSamples > 0) {
+        refineSamples = refineSamples > size ? refineSamples - size : 0;
+        if (pitchConfidence > PitchTracker::kPredictedConfidence) {
+            refineSamples = 0;  // Confirmed: this is the last retune
+        }
+        if (freq > 0.0f && voices.IsActive(lastVoice)) {
+            if (freq != lastFreq) {
+                voices.GlideTo(lastVoice, freq, 0.0f);
+                lastFreq = freq;
+            }
+            lastNote = MidiNote(freq);
+        }
+        return;
+    }
+    
+    if (noteActive && freq > 0.0f) {
+        int note = MidiNote(currentFreq);
+        if (note == lastNote) return;
+        if (lastNote >= 0 && glideTime > 0.0f && voices.IsActive(lastVoice)) {
+            voices.GlideTo(lastVoice, currentFreq, glideTime);
+        } else {
+            lastVoice = voices.NoteOn(currentFreq, 0.5f + 0.5f * pitchConfidence);
+        }
+        lastFreq = currentFreq;
+        lastNote = note;
+    } else if (!noteActive) {
+        lastNote = -1;
+    }
+}
+
+// A new voice for each pitch of a fresh estimate that was not in the last
+// one, so a held chord is not retriggered every frame. A pick attack
+// forgets the held pitches, so a re-strum of the same chord sounds again on
+// the next estimate, at the attack's velocity.
+void SimpHothouse::TriggerPoly(bool picked) {
+    if (picked) {
+        polyNoteCount = 0;
+        polyVelocity = 0.2f + 0.8f * onset.Velocity();
+    }
     
-    voice3.SetBrightness(brightness * 0.8f);
-    voice3.SetDamping(decay * 1.2f);
-    voice3.SetStructure(structure);
+    MultiPitch::Estimate estimate;
+    if (!multiPitch.Latest(estimate)) return;
     
-    voice4.SetBrightness(brightness * 1.1f);
-    voice4.SetDamping(decay * 0.9f);
-    voice4.SetStructure(structure);
+    int notes[MultiPitch::kMaxPitches];
+    for (size_t p = 0; p < estimate.count; p++) {
+        notes[p] = MidiNote(estimate.freq[p]);
+        bool held = false;
+        for (size_t q = 0; q < polyNoteCount; q++) {
+            held = held || notes[p] == polyNotes[q];
+        }
+        if (!held) {
+            voices.NoteOn(estimate.freq[p], polyVelocity * (0.5f + 0.5f * estimate.salience[p]));
+        }
+    }
+    for (size_t p = 0; p < estimate.count; p++) {
+        polyNotes[p] = notes[p];
+    }
+    polyNoteCount = estimate.count;
+    noteActive = estimate.count > 0;
 }
 
-void SimpHothouse::Process() {
-    // TODO: Implement audio processing
-    // 1. Detect pitch
-    // 2. Update voice frequencies
-    // 3. Trigger voices on note changes
-    // 4. Process voices
-    // 5. Mix and output
+void SimpHothouse::Process(const float* in, float* out, size_t size) {
+    for (size_t offset = 0; offset < size; offset += kMaxBlockSize) {
+        size_t n = size - offset < kMaxBlockSize ? size - offset : kMaxBlockSize;
+        
+        // 1. Decimate onto the analysis bus, detect onsets and pitch
+        size_t busCount = 0;
+        for (size_t i = 0; i < n; i++) {
+            busChunk[busChunkCount++] = in[offset + i];
+            if (busChunkCount == resample_factor) {
+                std::span<const float, resample_factor> chunk(busChunk, resample_factor);
+                busBlock[busCount++] = decimate(chunk);
+                busChunkCount = 0;
+            }
+        }
+        
+        bool picked = onset.Process(busBlock, busCount);
+        
+        // 2-3. Update and trigger voices
+#if SIMP_POLY
+        multiPitch.Write(busBlock, busCount);
+        TriggerPoly(picked);
+#else
+        pitch.Process(busBlock, busCount);
+        TriggerMono(picked, n);
+#endif
+        
+        // 4. Process voices (only the sounding ones)
+        voices.Render(synthBlock, n);
+        
+        // 5. Mix and output
+        for (size_t i = 0; i < n; i++) {
+            out[offset + i] = in[offset + i] * (1.0f - dryWetMix) + synthBlock[i] * dryWetMix;
+        }
+    }
 }
@@ -5,10 +5,21 @@
 #include "daisy_seed.h"
 #include "daisysp.h"
 #include "../lib/Hothouse.h"
+#include "pitch_tracker.h"
+#include "multi_pitch.h"
+#include "onset_detector.h"
+#include "voice_pool.h"
 
-// TODO: Add Q DSP library includes when integrated
-// #include "q/pitch/pitch_detector.hpp"
-// #include "q/fx/signal_conditioner.hpp"
+// String voices in the pool (compile time; ~4 KB of SRAM each)
+#ifndef SIMP_NUM_VOICES
+#define SIMP_NUM_VOICES 4
+#endif
+
+// SIMP_POLY=1 (Makefile POLY=1) triggers voices from the FFT multi-pitch
+// estimator instead of the monophonic tracker
+#ifndef SIMP_POLY
+#define SIMP_POLY 0
+#endif
 
 using namespace daisy;
 using namespace daisysp;
@@ -19,19 +30,34 @@ public:
     ~SimpHothouse() {}
     
     void Init(float sampleRate);
-    void Process();
+    void Process(const float* in, float* out, size_t size);
     void UpdateControls();
+    void ServiceAnalysis();  // Main loop: deferred multi-pitch frames
     
-private:
-    // Hardware
+    // Hardware (main starts audio on it)
     DaisySeed hw;
+    
+private:
     Hothouse controls;
     
-    // DSP - Pitch Detection
-    // TODO: Add FrequencyDetectorQ when ready
+    // DSP - Pitch Detection, on the 8kHz analysis bus
+    Decimator2 decimate;
+    float busChunk[resample_factor];
+    size_t busChunkCount;
+    PitchTracker pitch;
+    MultiPitch multiPitch;
+    OnsetDetector onset;
+    
+    void TriggerMono(bool picked, size_t size);
+    void TriggerPoly(bool picked);
     
     // DSP - String Synthesis
-    StringVoice voice1, voice2, voice3, voice4;
+    static constexpr size_t kAudioBlockSize = 4;
+    static constexpr size_t kMaxBlockSize = 48;
+    static_assert(kMaxBlockSize % resample_factor == 0, "Bus chunks must divide the render block");
+    float busBlock[kMaxBlockSize / resample_factor];  // At most this many per render block
+    VoicePool<SIMP_NUM_VOICES> voices;
+    float synthBlock[kMaxBlockSize];
     
     // Parameters
     float dryWetMix;
@@ -44,7 +70,20 @@ private:
     // State
     float currentFreq;
     float lastFreq;
+    float pitchConfidence;
     bool noteActive;
+    int lastNote;  // MIDI note the last voice was triggered on, -1 none
+    size_t lastVoice;  // Voice the mono tracker last played
+    float glideTime;   // Seconds; 0 = a new voice per note
+    size_t refineSamples;  // Left for the tracker to retune an onset's voice
+    int polyNotes[MultiPitch::kMaxPitches];  // MIDI notes of the last estimate
+    size_t polyNoteCount;
+    float polyVelocity;  // Of the last onset, for the notes it brings
+    
+    // An onset's voice starts at the last tracked pitch, or this before any
+    static constexpr float kFirstGuessFreq = 110.0f;
+    // Past the tracker's first estimate at low E (~28 ms)
+    static const size_t kRefineSamples = 2400;  // 50 ms
 };
 
 #endif // SIMP_HOTHOUSE_H
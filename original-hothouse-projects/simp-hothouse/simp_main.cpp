@@ -5,13 +5,11 @@ SimpHothouse simp;
 void AudioCallback(AudioHandle::InputBuffer in, 
                    AudioHandle::OutputBuffer out, 
                    size_t size) {
-    simp.Process();
+    simp.Process(in[0], out[0], size);
     
-    // TODO: Implement audio processing loop
-    // For now, pass through
+    // Mono synth to both outputs
     for (size_t i = 0; i < size; i++) {
-        out[0][i] = in[0][i];  // Left
-        out[1][i] = in[1][i];  // Right
+        out[1][i] = out[0][i];  // Right
     }
 }
 
@@ -25,6 +23,7 @@ int main(void) {
     // Main loop
     while(1) {
         simp.UpdateControls();
+        simp.ServiceAnalysis();
         System::Delay(10);  // 10ms control rate
     }
 }
@@ -0,0 +1,267 @@
+// String Bank
+// N Karplus-Strong strings in structure-of-arrays form, rendered together
+
+#pragma once
+#ifndef STRING_BANK_H
+#define STRING_BANK_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <math.h>
+#include "hothouse_fastmath.h"
+
+/** The string voices for Simp's pool, replacing one daisysp::StringVoice
+    object per voice. Every per-voice value (delay length, loop gain, filter
+    coefficients and states, excitation) sits in an array of N, and
+    Render() advances all the sounding strings a sample at a time in one
+    loop: per voice a sample is two adjacent reads of its delay line, a
+    one-pole lowpass, a first-order allpass and one write, with nothing
+    called. The lines share one write position, so the bank steps a single
+    index a sample for any number of voices.
+
+    A string is a delay of kDelaySize samples at most (47 Hz at 48kHz, past
+    the pitch tracker's 70 Hz floor), read with linear interpolation. In its
+    loop:
+    - damping sets the fundamental's decay (T60), kShortestDecay to
+      kLongestDecay seconds, at any pitch
+    - brightness sets the one-pole lowpass, how much faster than the
+      fundamental the highs die
+    - structure sets the allpass: 0.5 is a plain string, either side of it
+      stretches or squeezes the partials (dispersion)
+    Tune() works the lowpass, the length and the loop gain out from the
+    loop's response at the fundamental (a few trig calls a retune), so the
+    string stays in tune and decays as set at any pitch and setting: host
+    runs put every setting from 82 Hz to 1.3 kHz within 3 cents.
+
+    Trig() excites a string with one period of noise fed into its loop, at
+    the accent's level and through a lowpass at the brightness, so a pick
+    costs the same per sample as the rest of a note rather than a burst of
+    line writes. A period's noise has a mean, and the lowpass passes DC
+    whole, so the loop would hold it (as loud as the note itself, for a
+    short period) long after the note: over the next period the burst's
+    mean is taken back out, a constant across exactly one period, which is
+    DC alone. A retrigger keeps what is already in the line. */
+template <size_t N>
+class StringBank
+{
+  public:
+    static const size_t kDelaySize = 1024;  // 4 KB a string
+    static constexpr float kShortestDecay = 0.3f;  // Seconds, damping 0
+    static constexpr float kLongestDecay = 8.0f;   // Damping 1
+    static constexpr float kDcDecay = 16.0f;       // The slowest in the loop
+
+    StringBank() {}
+    ~StringBank() {}
+
+    void Init(float sample_rate)
+    {
+        sample_rate_ = sample_rate;
+        write_ = 0;
+        for (size_t v = 0; v < N; v++) {
+            for (size_t i = 0; i < kDelaySize; i++) {
+                line_[v][i] = 0.0f;
+            }
+            freq_[v] = 440.0f;
+            brightness_[v] = 0.5f;
+            decay_[v] = 1.0f;
+            allpass_[v] = 0.0f;
+            lp_[v] = 0.0f;
+            ap_in_[v] = 0.0f;
+            ap_out_[v] = 0.0f;
+            excite_[v] = 0;
+            excite_period_[v] = 1;
+            excite_dc_[v] = 0.0f;
+            excite_level_[v] = 0.0f;
+            excite_lp_[v] = 0.0f;
+            noise_[v] = 0x9e3779b9u * (uint32_t)(v + 1);
+            SetBrightness(v, 0.5f);
+            SetDamping(v, 0.5f);
+        }
+    }
+
+    /** Excites string v at freq with accent (0..1) */
+    void Trig(size_t v, float freq, float accent)
+    {
+        SetFreq(v, freq);
+        uint32_t period = (uint32_t)(sample_rate_ / freq_[v]);
+        excite_period_[v] = period < 1 ? 1 : period;
+        excite_[v] = 2 * excite_period_[v];
+        excite_level_[v] = accent;
+        excite_dc_[v] = 0.0f;
+    }
+
+    /** Retunes string v without exciting it */
+    void SetFreq(size_t v, float freq)
+    {
+        float lowest = sample_rate_ / (float)(kDelaySize - 2);
+        freq_[v] = freq < lowest ? lowest : freq;
+        Tune(v);
+    }
+
+    /** 0..1: how long the highs ring */
+    void SetBrightness(size_t v, float brightness)
+    {
+        brightness_[v] = Clamp(brightness);
+        excite_coeff_[v] = 0.1f + 0.9f * brightness_[v];
+        Tune(v);
+    }
+
+    /** 0..1: how long the string rings */
+    void SetDamping(size_t v, float damping)
+    {
+        decay_[v] = kShortestDecay * fastmath::Pow(kLongestDecay / kShortestDecay, Clamp(damping));
+        Tune(v);
+    }
+
+    /** 0..1: 0.5 harmonic, either side inharmonic */
+    void SetStructure(size_t v, float structure)
+    {
+        allpass_[v] = 0.8f * (Clamp(structure) - 0.5f);
+        Tune(v);
+    }
+
+    /** Writes the sum of the strings in voices[0..count) to out, and each
+        one's peak level over the block to peaks[k] */
+    void Render(float* out, size_t size, const size_t* voices, size_t count, float* peaks)
+    {
+        for (size_t k = 0; k < count; k++) {
+            peaks[k] = 0.0f;
+        }
+
+        for (size_t i = 0; i < size; i++) {
+            float sum = 0.0f;
+            for (size_t k = 0; k < count; k++) {
+                const size_t v = voices[k];
+                float* line = line_[v];
+
+                float read = (float)write_ - length_[v];
+                if (read < 0.0f) read += (float)kDelaySize;
+                size_t i0 = (size_t)read;
+                float frac = read - (float)i0;
+                float a = line[i0];
+                float b = line[(i0 + 1) & kMask];
+                float x = a + frac * (b - a);
+
+                lp_[v] += lowpass_[v] * (x - lp_[v]);
+                float y = allpass_[v] * (lp_[v] - ap_out_[v]) + ap_in_[v];
+                ap_in_[v] = lp_[v];
+                ap_out_[v] = y;
+
+                float s = y * gain_[v];
+                if (excite_[v] > 0) {
+                    if (--excite_[v] >= excite_period_[v]) {
+                        noise_[v] = noise_[v] * 1664525u + 1013904223u;
+                        float noise = (float)(int32_t)noise_[v] * 4.65661287e-10f;
+                        excite_lp_[v] += excite_coeff_[v] * (noise * excite_level_[v] - excite_lp_[v]);
+                        s += excite_lp_[v];
+                        excite_dc_[v] += excite_lp_[v];
+                        if (excite_[v] == excite_period_[v]) {
+                            excite_dc_[v] /= (float)excite_period_[v];
+                        }
+                    } else {
+                        s -= excite_dc_[v];
+                    }
+                }
+
+                line[write_] = s;
+                sum += s;
+                peaks[k] = fmaxf(peaks[k], fabsf(s));
+            }
+            out[i] = sum;
+            write_ = (write_ + 1) & kMask;
+        }
+    }
+
+  private:
+    static const size_t kMask = kDelaySize - 1;
+    static_assert((kDelaySize & kMask) == 0, "The delay size must be a power of two");
+
+    static float Clamp(float x) { return x < 0.0f ? 0.0f : (x > 1.0f ? 1.0f : x); }
+
+    // The delay length, lowpass and loop gain for v's frequency and
+    // settings. Works in the loop's response at the fundamental w: the
+    // lowpass c / (1 - d z^-1) (d = 1 - c), the allpass
+    // (a + z^-1) / (1 + a z^-1) and the interpolation (1 - f) + f z^-1.
+    void Tune(size_t v)
+    {
+        float period = sample_rate_ / freq_[v];
+        float w = 6.28318531f / period;
+        float sw = sinf(w);
+        float cw = cosf(w);
+
+        // The fundamental's loop gain for a 60 dB decay over decay_ seconds,
+        // and the most the loop gain itself may be: the lowpass passes DC
+        // whole, so DC decays at that gain alone
+        float target = fastmath::Exp(-6.90775528f * period / (decay_[v] * sample_rate_));
+        float most = fastmath::Exp(-6.90775528f * period / (kDcDecay * sample_rate_));
+
+        // The darkest lowpass that takes no more from the fundamental than
+        // the gain can make up alongside the interpolation's loss,
+        // |H(w)| = target / (most in_mag), or the fundamental would die
+        // faster than the decay (sooner the higher the note). In between,
+        // brightness (squared) sets how much faster the partials die. The
+        // interpolation's loss depends on the length, which depends on the
+        // lowpass, so this is worked out twice, the first time without it.
+        float bright = brightness_[v] * brightness_[v];
+        float a = allpass_[v];
+        float ap_delay = (atan2f(sw, a + cw) - atan2f(a * sw, 1.0f + a * cw)) / w;
+        float in_mag = 1.0f;
+        float c = 1.0f;
+        float f = 0.0f;
+        for (int pass = 0; pass < 2; pass++) {
+            float lp_target = fminf(target / (most * in_mag), 1.0f);
+            float g2 = lp_target * lp_target;
+            float b = 1.0f - g2;
+            float q = 1.0f - g2 * cw;
+            float darkest = 1.0f - b / (q + sqrtf(fmaxf(q * q - b * b, 0.0f)));
+            c = darkest + (1.0f - darkest) * bright;
+
+            // Phase delays at w, in samples; the length is what's left of
+            // the period, whole samples plus the fraction the
+            // interpolation spans
+            float d = 1.0f - c;
+            float lp_delay = atan2f(d * sw, 1.0f - d * cw) / w;
+            float length = period - lp_delay - ap_delay;
+            if (length < 1.0f) length = 1.0f;
+            float whole = floorf(length);
+            float t = tanf((length - whole) * w);
+            f = t / (sw + t * (1.0f - cw));
+            length_[v] = whole + f;
+            in_mag = sqrtf((1.0f - f) * (1.0f - f) + 2.0f * f * (1.0f - f) * cw + f * f);
+        }
+        lowpass_[v] = c;
+
+        // What the lowpass and the interpolation leave of the fundamental
+        // is made up, as far as the most
+        float d = 1.0f - c;
+        float lp_mag = c / sqrtf(1.0f - 2.0f * d * cw + d * d);
+        float gain = target / (lp_mag * in_mag);
+        gain_[v] = gain > most ? most : gain;
+    }
+
+    float line_[N][kDelaySize];
+    size_t write_ = 0;
+
+    float freq_[N];
+    float length_[N];  // Samples back from the write position
+    float gain_[N];
+    float brightness_[N];
+    float decay_[N];
+    float lowpass_[N];  // One-pole coefficient
+    float allpass_[N];  // First-order coefficient
+    float lp_[N];
+    float ap_in_[N];
+    float ap_out_[N];
+
+    uint32_t excite_[N];  // Samples of excitation left
+    uint32_t excite_period_[N];
+    float excite_dc_[N];  // The burst's sum, then its mean
+    float excite_level_[N];
+    float excite_coeff_[N];
+    float excite_lp_[N];
+    uint32_t noise_[N];
+
+    float sample_rate_ = 48000.0f;
+};
+
+#endif  // STRING_BANK_H
@@ -0,0 +1,154 @@
+// Voice Pool
+// Fixed-size string voice pool with oldest-steal allocation for Simp
+
+#pragma once
+#ifndef VOICE_POOL_H
+#define VOICE_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <math.h>
+#include "hothouse_fastmath.h"
+#include "string_bank.h"
+
+/** N Karplus-Strong voices, the strings of a StringBank (about 4 KB each,
+    so the 6-voice budget is ~24 KB of SRAM), allocated per note: a free
+    voice if there is one, otherwise the one started longest ago is stolen.
+    A voice is active from its trigger until its output has stayed below
+    kSilence for kQuietSamples; Render() hands the bank only the active
+    voices, so the cost follows the sounding notes rather than N.
+
+    Glide is per block: GlideTo() works out once (one Pow) the ratio that
+    takes the frequency to its target in a whole number of Render() blocks,
+    and each block then costs one multiply and a StringBank::SetFreq() (a
+    retune: a few trig calls) per gliding voice. */
+template <size_t N>
+class VoicePool
+{
+  public:
+    static constexpr float kSilence = 1.0e-4f;  // -80 dB
+    static const uint32_t kQuietSamples = 2048;  // ~43ms @ 48kHz
+
+    VoicePool() {}
+    ~VoicePool() {}
+
+    void Init(float sample_rate, size_t block_size)
+    {
+        bank_.Init(sample_rate);
+        for (size_t i = 0; i < N; i++) {
+            slots_[i].active = false;
+            slots_[i].started = 0;
+            slots_[i].quiet = 0;
+            slots_[i].freq = 440.0f;
+            slots_[i].glide_blocks = 0;
+        }
+        serial_ = 0;
+        block_rate_ = sample_rate / (float)block_size;
+    }
+
+    /** Starts a note and returns the voice index it went to */
+    size_t NoteOn(float freq, float accent)
+    {
+        size_t v = Allocate();
+        Slot& slot = slots_[v];
+        bank_.Trig(v, freq, accent);
+        slot.freq = freq;
+        slot.glide_blocks = 0;
+        slot.active = true;
+        slot.started = ++serial_;
+        slot.quiet = 0;
+        return v;
+    }
+
+    /** Slides voice v to freq over time seconds (0 jumps), without
+        retriggering it */
+    void GlideTo(size_t v, float freq, float time)
+    {
+        Slot& slot = slots_[v];
+        int blocks = (int)(time * block_rate_ + 0.5f);
+        if (blocks < 1) {
+            slot.freq = freq;
+            slot.glide_blocks = 0;
+            bank_.SetFreq(v, freq);
+            return;
+        }
+        slot.target = freq;
+        slot.glide_ratio = fastmath::Pow(freq / slot.freq, 1.0f / (float)blocks);
+        slot.glide_blocks = blocks;
+    }
+
+    /** Per-voice settings, 0..1 (see StringBank) */
+    void SetBrightness(size_t v, float brightness) { bank_.SetBrightness(v, brightness); }
+    void SetDamping(size_t v, float damping) { bank_.SetDamping(v, damping); }
+    void SetStructure(size_t v, float structure) { bank_.SetStructure(v, structure); }
+
+    bool IsActive(size_t v) const { return slots_[v].active; }
+
+    size_t ActiveVoices() const
+    {
+        size_t count = 0;
+        for (size_t i = 0; i < N; i++) {
+            count += slots_[i].active;
+        }
+        return count;
+    }
+
+    /** Writes the mix of the active voices to out */
+    void Render(float* out, size_t size)
+    {
+        size_t active[N];
+        size_t count = 0;
+        for (size_t v = 0; v < N; v++) {
+            Slot& slot = slots_[v];
+            if (!slot.active) continue;
+
+            if (slot.glide_blocks > 0) {
+                slot.freq = --slot.glide_blocks > 0 ? slot.freq * slot.glide_ratio : slot.target;
+                bank_.SetFreq(v, slot.freq);
+            }
+            active[count++] = v;
+        }
+
+        float peaks[N];
+        bank_.Render(out, size, active, count, peaks);
+
+        for (size_t k = 0; k < count; k++) {
+            Slot& slot = slots_[active[k]];
+            slot.quiet = peaks[k] < kSilence ? slot.quiet + (uint32_t)size : 0;
+            if (slot.quiet >= kQuietSamples) {
+                slot.active = false;
+            }
+        }
+    }
+
+    static constexpr size_t Size() { return N; }
+
+  private:
+    struct Slot
+    {
+        bool active;
+        uint32_t started;  // NoteOn serial, lowest = oldest
+        uint32_t quiet;    // Samples below kSilence
+        float freq;        // Current (gliding) frequency
+        float target;
+        float glide_ratio;  // Per-block frequency multiplier
+        int glide_blocks;   // Blocks left to target
+    };
+
+    size_t Allocate() const
+    {
+        size_t oldest = 0;
+        for (size_t i = 0; i < N; i++) {
+            if (!slots_[i].active) return i;
+            if (slots_[i].started < slots_[oldest].started) oldest = i;
+        }
+        return oldest;
+    }
+
+    StringBank<N> bank_;
+    Slot slots_[N];
+    uint32_t serial_ = 0;
+    float block_rate_ = 12000.0f;
+};
+
+#endif  // VOICE_POOL_H
@@ -0,0 +1,357 @@
+// Kernel Bench
+// Cycle counts of the pedals' reusable DSP kernels on the Seed, with each
+// kernel's state in DTCM, AXI SRAM and SDRAM in turn. Prints a table over
+// USB serial; connect a serial monitor to start it.
+
+#include "daisy_seed.h"
+
+#include <algorithm>
+#include <new>
+#include <utility>
+
+#include "cycle_profiler.h"
+#include "model_tiers.h"
+#include "model_bank.h"
+#include "ImpulseResponse/ImpulseResponse.h"
+#include "ImpulseResponse/ir_data.h"
+#include "ImpulseResponse/ir_prep.h"
+#include "Dattorro/Dattorro.hpp"
+#include "Util/OctaveGenerator.h"
+#include "Util/Multirate.h"
+#include "shy_fft.h"
+#include "slice_engine.h"
+
+using namespace daisy;
+
+#ifndef BENCH_DATTORRO_INPUT
+#define BENCH_DATTORRO_INPUT "dtcm"
+#endif
+#ifndef BENCH_DATTORRO_TANK
+#define BENCH_DATTORRO_TANK "axi"
+#endif
+
+DaisySeed hw;
+
+// Each kernel's object (and the buffers it works on) is built in turn in a
+// scratch arena in each region. 64K is half of DTCM; the stack shares the
+// rest.
+enum Region { DTCM, AXI, SDRAM, NUM_REGIONS };
+const char* const regionNames[NUM_REGIONS] = {"DTCM", "AXI", "SDRAM"};
+constexpr size_t kArenaBytes = 64 * 1024;
+
+alignas(32) uint8_t DTCM_MEM_SECTION dtcmArena[kArenaBytes];
+alignas(32) uint8_t axiArena[kArenaBytes];
+alignas(32) uint8_t DSY_SDRAM_BSS sdramArena[kArenaBytes];  // Write-back, as the pedals run it
+uint8_t* const arenas[NUM_REGIONS] = {dtcmArena, axiArena, sdramArena};
+
+const float kSampleRate = 48000.0f;
+const int kIterations = 200;  // blocks per measurement, after one to warm up
+
+// A guitar-ish test signal, so filters and envelopes see realistic levels
+float testInput[256];
+
+// Everything a kernel needs, built in an arena
+template <typename Kernel>
+Kernel* Place(Region region)
+{
+    static_assert(sizeof(Kernel) <= kArenaBytes, "kernel state overflows the bench arena");
+    return new (arenas[region]) Kernel();
+}
+
+// Average cycles per unit (sample, chunk or transform) of run(), which
+// processes `units` units per call, in tenths
+template <typename Run>
+uint32_t CyclesPer(Run&& run, int units)
+{
+    run();
+    uint64_t total = 0;
+    for (int i = 0; i < kIterations; i++) {
+        uint32_t start = cycleCount();
+        run();
+        total += cycleCount() - start;
+    }
+    return (uint32_t)(total * 10 / ((uint64_t)kIterations * units));
+}
+
+struct Row
+{
+    const char* kernel;
+    const char* unit;
+    uint32_t cycles[NUM_REGIONS];  // tenths, 0 where not measured
+    const char* note;
+};
+
+// Runs Bench::Measure(region) for every region
+template <typename Bench>
+Row MeasureAll(const char* kernel, const char* unit, const char* note = "")
+{
+    Row row = {kernel, unit, {0, 0, 0}, note};
+    for (int r = 0; r < NUM_REGIONS; r++) {
+        Bench* bench = Place<Bench>((Region)r);
+        bench->Init();
+        row.cycles[r] = bench->Measure();
+        bench->~Bench();
+    }
+    return row;
+}
+
+// Mars amp model: GRU(9) + dense, as AmpSlot runs it
+struct GruBench
+{
+    static constexpr int kBlock = 48;
+    MarsModelT<9> model;
+    float out[kBlock];
+
+    void Init() { loadModelWeights(model, model_bank[0]); }
+    uint32_t Measure()
+    {
+        return CyclesPer([this] { model.forwardBlock(testInput, out, kBlock); }, kBlock);
+    }
+};
+
+// Earth's plate reverb. Its delay lines are DattorroMemory's globals, so
+// only the object moves; the lines' regions are a build option.
+struct DattorroBench
+{
+    static constexpr int kBlock = 48;
+    Dattorro reverb{48000, 16, 4.0};
+    float left[kBlock], right[kBlock];
+
+    void Init()
+    {
+        reverb.setSampleRate(kSampleRate);
+        reverb.enableInputDiffusion(true);
+        reverb.setDecay(0.8f);
+    }
+    uint32_t Measure()
+    {
+        return CyclesPer([this] { reverb.processBlock(testInput, testInput, left, right, kBlock); },
+                         kBlock);
+    }
+};
+
+// Octave bank at the 8 kHz decimated rate, one update per decimated sample
+struct OctaveBench
+{
+    static constexpr int kBlock = 8;
+    OctaveGenerator octave{kSampleRate / resample_factor};
+    float out = 0.0f;
+
+    void Init() {}
+    uint32_t Measure()
+    {
+        return CyclesPer(
+            [this] {
+                for (int i = 0; i < kBlock; i++) {
+                    octave.update(testInput[i * resample_factor]);
+                    out += octave.up1() + octave.down1() + octave.down2();
+                }
+            },
+            kBlock);
+    }
+};
+
+// 48 kHz to 8 kHz decimator, one 48 sample block at a time
+struct DecimatorBench
+{
+    static constexpr int kChunks = 8;
+    Decimator2 decimate;
+    float out[kChunks];
+
+    void Init() {}
+    uint32_t Measure()
+    {
+        return CyclesPer([this] { decimate.decimate(testInput, out, kChunks); }, kChunks);
+    }
+};
+
+// Venus's frames, with their scratch buffers: 4096 points by default, 2048
+// at Eco quality
+template <bool Inverse, size_t Size = 4096>
+struct FFTBench
+{
+    static constexpr size_t kSize = Size;
+    ShyFFT<float, kSize, RotationPhasor> fft;
+    float in[kSize], out[kSize];
+
+    void Init()
+    {
+        fft.Init();
+        for (size_t i = 0; i < kSize; i++) {
+            in[i] = testInput[i % 256];
+        }
+    }
+    uint32_t Measure()
+    {
+        return CyclesPer(
+            [this] {
+                if (Inverse) {
+                    fft.Inverse(in, out);
+                } else {
+                    fft.Direct(in, out);
+                }
+            },
+            1);
+    }
+};
+
+// The Ambien slicers' engine, scaled down to fit the arena: 4 slices of
+// 50 ms, captured and played in sequence with a 5 ms fade
+struct BenchSlicePolicy
+{
+    int NextSlice(int current, int count) { return (current + 1) % count; }
+    bool Reverse() { return false; }
+    int NextCapture(int current, int count) { return (current + 1) % count; }
+    int FadeLength(int length) { return length < 480 ? length / 2 : 240; }
+    float FadeShape(float ramp) { return ramp; }
+    float Decay(float volume) { return volume; }
+    bool Repeat() { return false; }
+    void Started() {}
+};
+
+template <bool Playback>
+struct SliceBench
+{
+    static constexpr int kBlock = 48;
+    static constexpr int kSlices = 4;
+    static constexpr int kSliceLength = 2400;
+    typedef SliceEngine<kSlices, kSliceLength, BenchSlicePolicy, float> Engine;
+    Engine::Slice buffers[kSlices];
+    Engine engine;
+    float out[kBlock];
+
+    void Init()
+    {
+        engine.Init(buffers);
+        engine.SetSliceCount(kSlices);
+        engine.SetTargetLength(kSliceLength / 2);
+        engine.SetSearchWindow(kSliceLength / 4);
+        for (int i = 0; i < 4 * kSliceLength / kBlock; i++) {
+            engine.Capture(testInput, kBlock);  // so there is something to play
+        }
+    }
+    uint32_t Measure()
+    {
+        return CyclesPer(
+            [this] {
+                if (Playback) {
+                    engine.Playback(out, kBlock);
+                } else {
+                    engine.Capture(testInput, kBlock);
+                }
+            },
+            kBlock);
+    }
+};
+
+// Mars's cabinet IR. Its direct-form weights and history are in the object,
+// and the block path's kernels come from an arena over a pool of its own,
+// in AXI SRAM as Mars has it: measured once, and the block path at each
+// quality level's cut (Mars's irQuality).
+ImpulseResponse ir;
+alignas(32) uint8_t irPool[16 * 1024];
+clevelandmusicco::Arena irArena(irPool, sizeof(irPool));
+float irTaps[sizeof(ir_data1) / sizeof(ir_data1[0])];
+
+struct IrLevel
+{
+    float tailDb;
+    size_t maxTaps;
+    const char* note;
+};
+const IrLevel irLevels[] = {
+    {-40.0f, 256, "AXI SRAM, Eco: -40 dB or 256 taps"},
+    {-60.0f, kIrMaxLength, "AXI SRAM, Normal: -60 dB tail"},
+    {0.0f, kIrMaxLength, "AXI SRAM, High: uncut"},
+};
+
+Row MeasureImpulseResponse(bool block, const IrLevel& level = irLevels[1])
+{
+    static constexpr int kBlock = 64;  // kIrPartitionSize
+    static float out[kBlock];
+    ir.SetMode(IrMode::kUniform);
+    irArena.Reset();
+    const size_t size = sizeof(irTaps) / sizeof(irTaps[0]);
+    std::copy(ir_data1, ir_data1 + size, irTaps);
+    const size_t length = IrTruncate(irTaps, size,
+                                     std::min(IrEffectiveLength(irTaps, size, level.tailDb), level.maxTaps));
+    ir.Init(clevelandmusicco::Span<const float>(irTaps, length), irArena);
+    uint32_t cycles = block ? CyclesPer([] { ir.ProcessBlock(testInput, out, kBlock); }, kBlock)
+                            : CyclesPer(
+                                  [] {
+                                      for (int i = 0; i < kBlock; i++) {
+                                          out[i] = ir.Process(testInput[i]);
+                                      }
+                                  },
+                                  kBlock);
+    return {block ? "ImpulseResponse::ProcessBlock" : "ImpulseResponse::Process", "sample",
+            {0, cycles, 0}, block ? level.note : "state in AXI SRAM"};
+}
+
+const int kRows = 14;
+Row rows[kRows];
+
+void RunBenchmarks()
+{
+    int n = 0;
+    rows[n++] = MeasureImpulseResponse(false);
+    for (const IrLevel& level : irLevels) {
+        rows[n++] = MeasureImpulseResponse(true, level);
+    }
+    rows[n++] = MeasureAll<GruBench>("GRULayerT<9> + DenseT", "sample");
+    rows[n++] = MeasureAll<DattorroBench>("Dattorro::processBlock", "sample",
+                                          "lines: input " BENCH_DATTORRO_INPUT
+                                          ", tank " BENCH_DATTORRO_TANK);
+    rows[n++] = MeasureAll<OctaveBench>("OctaveGenerator::update", "update");
+    rows[n++] = MeasureAll<DecimatorBench>("Decimator2::decimate", "chunk");
+    rows[n++] = MeasureAll<FFTBench<false, 2048>>("ShyFFT<2048>::Direct", "frame", "Eco");
+    rows[n++] = MeasureAll<FFTBench<true, 2048>>("ShyFFT<2048>::Inverse", "frame", "Eco");
+    rows[n++] = MeasureAll<FFTBench<false>>("ShyFFT<4096>::Direct", "frame");
+    rows[n++] = MeasureAll<FFTBench<true>>("ShyFFT<4096>::Inverse", "frame");
+    rows[n++] = MeasureAll<SliceBench<false>>("SliceEngine::Capture", "sample");
+    rows[n++] = MeasureAll<SliceBench<true>>("SliceEngine::Playback", "sample");
+}
+
+void PrintTable()
+{
+    hw.PrintLine("kernel                         per      %10s %10s %10s  cycles", regionNames[DTCM],
+                 regionNames[AXI], regionNames[SDRAM]);
+    for (int i = 0; i < kRows; i++) {
+        const Row& row = rows[i];
+        char cells[NUM_REGIONS][16];
+        for (int r = 0; r < NUM_REGIONS; r++) {
+            if (row.cycles[r] > 0) {
+                snprintf(cells[r], sizeof(cells[r]), "%8lu.%lu", (unsigned long)(row.cycles[r] / 10),
+                         (unsigned long)(row.cycles[r] % 10));
+            } else {
+                snprintf(cells[r], sizeof(cells[r]), "%10s", "-");
+            }
+        }
+        hw.PrintLine("%-30s %-8s %s %s %s  %s", row.kernel, row.unit, cells[DTCM], cells[AXI],
+                     cells[SDRAM], row.note);
+    }
+}
+
+int main(void)
+{
+    hw.Init(true);  // CPU boost, as the pedals run
+    hw.StartLog(true);  // wait for a serial monitor
+    enableCycleCounter();
+
+    for (size_t i = 0; i < 256; i++) {
+        float t = i / kSampleRate;
+        testInput[i] = 0.3f * sinf(2.0f * 3.14159265f * 110.0f * t)
+                       + 0.1f * sinf(2.0f * 3.14159265f * 1375.0f * t);
+    }
+
+    RunBenchmarks();
+
+    // Print now and again, for a monitor that connects late
+    for (;;) {
+        PrintTable();
+        hw.PrintLine("(one sample at 48 kHz is %lu cycles)",
+                     (unsigned long)(System::GetSysClkFreq() / (uint32_t)kSampleRate));
+        hw.PrintLine("");
+        System::Delay(10000);
+    }
+}
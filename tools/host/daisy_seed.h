@@ -0,0 +1,633 @@
+// Host libDaisy
+// The part of libDaisy the pedals use, backed by the render harness
+
+#pragma once
+#ifndef HOST_DAISY_SEED_H
+#define HOST_DAISY_SEED_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <math.h>
+
+#include "host_io.h"
+
+// Memory placement is meaningless on the host
+#define DSY_SDRAM_BSS
+#define DSY_SDRAM_DATA
+#define DSY_QSPI_BSS
+#define DSY_DTCMRAM
+#define DTCM_MEM_SECTION
+#define FORCE_INLINE inline
+
+namespace daisy {
+
+enum GPIOPort { PORTA, PORTB, PORTC, PORTD, PORTE, PORTF, PORTG, PORTH, PORTI, PORTJ, PORTK, PORTX };
+
+/** A Seed pin. On the host every pin is (PORTX, Seed pin number), which is
+    how the harness addresses switches. */
+struct Pin
+{
+    GPIOPort port = PORTX;
+    uint8_t pin = 255;
+
+    constexpr Pin() {}
+    constexpr Pin(GPIOPort p, uint8_t n) : port(p), pin(n) {}
+    constexpr bool operator==(const Pin& other) const { return port == other.port && pin == other.pin; }
+};
+
+namespace seed {
+constexpr Pin D0(PORTX, 0), D1(PORTX, 1), D2(PORTX, 2), D3(PORTX, 3), D4(PORTX, 4), D5(PORTX, 5),
+    D6(PORTX, 6), D7(PORTX, 7), D8(PORTX, 8), D9(PORTX, 9), D10(PORTX, 10), D11(PORTX, 11),
+    D12(PORTX, 12), D13(PORTX, 13), D14(PORTX, 14), D15(PORTX, 15), D16(PORTX, 16),
+    D17(PORTX, 17), D18(PORTX, 18), D19(PORTX, 19), D20(PORTX, 20), D21(PORTX, 21),
+    D22(PORTX, 22), D23(PORTX, 23), D24(PORTX, 24), D25(PORTX, 25), D26(PORTX, 26),
+    D27(PORTX, 27), D28(PORTX, 28), D29(PORTX, 29), D30(PORTX, 30);
+constexpr Pin A0 = D15, A1 = D16, A2 = D17, A3 = D18, A4 = D19, A5 = D20, A6 = D21, A7 = D22,
+              A8 = D23, A9 = D24, A10 = D25, A11 = D28;
+}  // namespace seed
+
+/** Time is the audio clock: samples rendered by the harness, so footswitch
+    timing and tap tempo behave as they would at real time however fast the
+    render runs. GetTick() is the host's real clock. */
+class System
+{
+  public:
+    static uint32_t GetNow() { return (uint32_t)(host::NowUs() / 1000); }
+    static uint32_t GetUs() { return (uint32_t)host::NowUs(); }
+    static uint32_t GetTick() { return (uint32_t)(host::RealNs() / 5); }  // 200 MHz
+    static uint32_t GetSysClkFreq() { return 480000000; }
+    static uint32_t GetTickFreq() { return 200000000; }
+    static void Delay(uint32_t ms) { host::Delay((uint64_t)ms * 1000); }
+    static void DelayUs(uint32_t us) { host::Delay(us); }
+    static void DelayTicks(uint32_t ticks) { host::Delay(ticks / 200); }
+    static void ResetToBootloader() { host::Halt("reset to bootloader"); }
+};
+
+struct SaiHandle
+{
+    struct Config
+    {
+        enum class SampleRate { SAI_8KHZ, SAI_16KHZ, SAI_32KHZ, SAI_48KHZ, SAI_96KHZ };
+    };
+};
+
+struct AudioHandle
+{
+    typedef const float* const* InputBuffer;
+    typedef float** OutputBuffer;
+    typedef const float* InterleavingInputBuffer;
+    typedef float* InterleavingOutputBuffer;
+    typedef void (*AudioCallback)(InputBuffer in, OutputBuffer out, size_t size);
+    typedef void (*InterleavingAudioCallback)(InterleavingInputBuffer in,
+                                              InterleavingOutputBuffer out, size_t size);
+};
+
+struct AdcChannelConfig
+{
+    Pin pin;
+    void InitSingle(Pin p) { pin = p; }
+};
+
+/** Reads the harness's knob positions by channel, in the order the
+    channels were configured */
+class AdcHandle
+{
+  public:
+    enum OverSampling { OVS_NONE, OVS_4, OVS_8, OVS_16, OVS_32, OVS_64, OVS_128, OVS_256, OVS_512, OVS_1024 };
+
+    void Init(AdcChannelConfig* cfg, size_t num_channels, OverSampling ovs = OVS_32)
+    {
+        (void)ovs;
+        for (size_t i = 0; i < num_channels && i < host::kAdcChannels; i++) {
+            host::MapAdcChannel(i, cfg[i].pin.pin);
+        }
+    }
+    void Start() {}
+    void Stop() {}
+    uint16_t* GetPtr(uint8_t chn) { return host::AdcPtr(chn); }
+    float GetFloat(uint8_t chn) { return *host::AdcPtr(chn) / 65535.0f; }
+};
+
+/** libDaisy's one-pole knob smoothing */
+class AnalogControl
+{
+  public:
+    void Init(uint16_t* adcptr, float sr, bool flip = false, bool invert = false,
+              float slew_seconds = 0.002f)
+    {
+        adc_ = adcptr;
+        flip_ = flip;
+        invert_ = invert;
+        slew_seconds_ = slew_seconds;
+        SetSampleRate(sr);
+        val_ = 0.0f;
+    }
+    float Process()
+    {
+        float t = adc_ != nullptr ? *adc_ / 65535.0f : 0.0f;
+        if (flip_) t = 1.0f - t;
+        if (invert_) t = -t;
+        val_ += coeff_ * (t - val_);
+        return val_;
+    }
+    float Value() const { return val_; }
+    void SetSampleRate(float sr)
+    {
+        float c = 1.0f / (slew_seconds_ * sr * 0.5f);
+        coeff_ = c > 1.0f ? 1.0f : c;
+    }
+
+  private:
+    uint16_t* adc_ = nullptr;
+    float val_ = 0.0f;
+    float coeff_ = 1.0f;
+    float slew_seconds_ = 0.002f;
+    bool flip_ = false;
+    bool invert_ = false;
+};
+
+/** libDaisy's shift-register debounce, on the harness's pin states */
+class Switch
+{
+  public:
+    enum Type { TYPE_TOGGLE, TYPE_MOMENTARY };
+    enum Polarity { POLARITY_NORMAL, POLARITY_INVERTED };
+    enum Pull { PULL_UP, PULL_DOWN, PULL_NONE };
+
+    void Init(Pin pin, float update_rate = 0.0f, Type t = TYPE_MOMENTARY,
+              Polarity pol = POLARITY_INVERTED, Pull pu = PULL_UP)
+    {
+        (void)update_rate;
+        (void)t;
+        (void)pol;
+        (void)pu;
+        pin_ = pin.pin;
+        state_ = 0;
+        last_update_ = System::GetNow();
+        updated_ = false;
+        rising_edge_time_ = 0;
+    }
+    void Init(Pin pin, float update_rate, Type t, Polarity pol) { Init(pin, update_rate, t, pol, PULL_UP); }
+
+    void Debounce()
+    {
+        uint32_t now = System::GetNow();
+        updated_ = false;
+        if (now - last_update_ >= 1) {
+            last_update_ = now;
+            updated_ = true;
+            state_ = (uint8_t)((state_ << 1) | (host::PinPressed(pin_) ? 1 : 0));
+            if (state_ == 0x7f) rising_edge_time_ = now;
+        }
+    }
+    bool RisingEdge() const { return updated_ ? state_ == 0x7f : false; }
+    bool FallingEdge() const { return updated_ ? state_ == 0x80 : false; }
+    bool Pressed() const { return state_ == 0xff; }
+    bool RawState() { return host::PinPressed(pin_); }
+    float TimeHeldMs() const { return Pressed() ? (float)(System::GetNow() - rising_edge_time_) : 0.0f; }
+
+  private:
+    uint8_t pin_ = 255;
+    uint8_t state_ = 0;
+    bool updated_ = false;
+    uint32_t last_update_ = 0;
+    uint32_t rising_edge_time_ = 0;
+};
+
+class Led
+{
+  public:
+    void Init(Pin pin, bool invert, float samplerate = 1000.0f)
+    {
+        (void)invert;
+        (void)samplerate;
+        pin_ = pin.pin;
+    }
+    void Set(float val) { bright_ = val; }
+    void Update() { host::SetLed(pin_, bright_); }
+
+  private:
+    uint8_t pin_ = 255;
+    float bright_ = 0.0f;
+};
+
+/** The period-elapsed interrupt only: the harness calls it in audio time
+    after each block, at the rate the period and prescaler give */
+class TimerHandle
+{
+  public:
+    struct Config
+    {
+        enum class Peripheral { TIM_2, TIM_3, TIM_4, TIM_5 };
+        enum class CounterDir { UP, DOWN };
+        Peripheral periph = Peripheral::TIM_2;
+        CounterDir dir = CounterDir::UP;
+        uint32_t period = 0xffffffff;
+        bool enable_irq = false;
+    };
+    enum class Result { OK, ERR };
+    typedef void (*PeriodElapsedCallback)(void* data);
+
+    Result Init(const Config& config)
+    {
+        config_ = config;
+        return Result::OK;
+    }
+    Result Start()
+    {
+        if (config_.enable_irq) {
+            host::SetTimer((int)config_.periph, cb_, data_, GetFreq() / ((double)config_.period + 1));
+        }
+        return Result::OK;
+    }
+    Result Stop()
+    {
+        host::SetTimer((int)config_.periph, nullptr, nullptr, 0.0);
+        return Result::OK;
+    }
+    Result SetPeriod(uint32_t ticks)
+    {
+        config_.period = ticks;
+        return Result::OK;
+    }
+    Result SetPrescaler(uint32_t val)
+    {
+        prescaler_ = val;
+        return Result::OK;
+    }
+    uint32_t GetFreq() { return 200000000 / (prescaler_ + 1); }
+    uint32_t GetTick() { return 0; }
+    void SetCallback(PeriodElapsedCallback cb, void* data = nullptr)
+    {
+        cb_ = cb;
+        data_ = data;
+    }
+
+  private:
+    Config config_;
+    uint32_t prescaler_ = 0;
+    PeriodElapsedCallback cb_ = nullptr;
+    void* data_ = nullptr;
+};
+
+class GPIO
+{
+  public:
+    enum class Mode { INPUT, OUTPUT, OUTPUT_OD, ANALOG };
+    enum class Pull { NOPULL, PULLUP, PULLDOWN };
+    enum class Speed { LOW, MEDIUM, HIGH, VERY_HIGH };
+
+    void Init(Pin p, Mode m = Mode::INPUT, Pull pu = Pull::NOPULL, Speed sp = Speed::LOW)
+    {
+        (void)m;
+        (void)pu;
+        (void)sp;
+        pin_ = p.pin;
+    }
+    bool Read() { return host::PinPressed(pin_); }
+    void Write(bool) {}
+    void Toggle() {}
+
+  private:
+    uint8_t pin_ = 255;
+};
+
+/** The callback's load against its real-time budget, timed on the host's
+    clock */
+class CpuLoadMeter
+{
+  public:
+    void Init(float sample_rate, size_t block_size, float smoothing_hz = 1.0f)
+    {
+        block_ns_ = block_size * 1e9f / sample_rate;
+        smoothing_ = 1.0f - expf(-2.0f * 3.14159265f * smoothing_hz * block_size / sample_rate);
+        Reset();
+    }
+    void OnBlockStart() { start_ = host::RealNs(); }
+    void OnBlockEnd()
+    {
+        float load = (float)(host::RealNs() - start_) / block_ns_;
+        avg_ = first_ ? load : avg_ + smoothing_ * (load - avg_);
+        min_ = first_ || load < min_ ? load : min_;
+        max_ = first_ || load > max_ ? load : max_;
+        first_ = false;
+    }
+    float GetAvgCpuLoad() const { return avg_; }
+    float GetMinCpuLoad() const { return min_; }
+    float GetMaxCpuLoad() const { return max_; }
+    void Reset()
+    {
+        first_ = true;
+        avg_ = min_ = max_ = 0.0f;
+    }
+
+  private:
+    uint64_t start_ = 0;
+    float block_ns_ = 1e6f;
+    float smoothing_ = 0.01f;
+    float avg_ = 0.0f, min_ = 0.0f, max_ = 0.0f;
+    bool first_ = true;
+};
+
+/** 8 MB of NOR flash in RAM: erase sets bits, writes can only clear them */
+class QSPIHandle
+{
+  public:
+    enum Result { OK, ERR };
+
+    Result Erase(uint32_t start, uint32_t end)
+    {
+        if (end > host::kFlashSize || start > end) return ERR;
+        memset(host::Flash() + start, 0xFF, end - start);
+        return OK;
+    }
+    Result EraseSector(uint32_t address) { return Erase(address & ~0xFFFu, (address & ~0xFFFu) + 4096); }
+    Result Write(uint32_t address, uint32_t size, uint8_t* buffer)
+    {
+        if (address + size > host::kFlashSize) return ERR;
+        uint8_t* flash = host::Flash() + address;
+        for (uint32_t i = 0; i < size; i++) {
+            flash[i] &= buffer[i];
+        }
+        return OK;
+    }
+    void* GetData(uint32_t offset = 0) { return host::Flash() + offset; }
+};
+
+/** printf to the harness's stderr, one line per PrintLine */
+class Logger
+{
+  public:
+    static void StartLog(bool wait_for_pc = false) { (void)wait_for_pc; }
+    static void Print(const char* format, ...)
+    {
+        va_list args;
+        va_start(args, format);
+        host::Log(format, args, false);
+        va_end(args);
+    }
+    static void PrintLine(const char* format, ...)
+    {
+        va_list args;
+        va_start(args, format);
+        host::Log(format, args, true);
+        va_end(args);
+    }
+};
+
+/** USB serial in: the harness feeds uploads (Hothouse::StartUpload()) by
+ ** calling the receive callback itself. Out, transfers go to stderr with
+ ** the log's lines, as they share the port on the Seed. */
+class UsbHandle
+{
+  public:
+    enum UsbPeriph { FS_INTERNAL, FS_EXTERNAL, FS_BOTH };
+    enum class Result { OK, ERR };
+    typedef void (*ReceiveCallback)(uint8_t* buff, uint32_t* len);
+
+    void SetReceiveCallback(ReceiveCallback cb, UsbPeriph dev)
+    {
+        (void)dev;
+        receive_callback = cb;
+    }
+
+    Result TransmitInternal(uint8_t* buff, size_t size)
+    {
+        fwrite(buff, 1, size, stderr);
+        return Result::OK;
+    }
+
+    ReceiveCallback receive_callback = nullptr;
+};
+
+class DaisySeed
+{
+  public:
+    void Configure() {}
+    void Init(bool boost = false) { (void)boost; }
+    void DelayMs(size_t del) { System::Delay((uint32_t)del); }
+    Pin GetPin(uint8_t pin_idx) { return Pin(PORTX, pin_idx); }
+    void SetLed(bool) {}
+
+    void StartAudio(AudioHandle::AudioCallback cb) { host::StartAudio(cb, nullptr); }
+    void StartAudio(AudioHandle::InterleavingAudioCallback cb) { host::StartAudio(nullptr, cb); }
+    void ChangeAudioCallback(AudioHandle::AudioCallback cb) { host::StartAudio(cb, nullptr); }
+    void ChangeAudioCallback(AudioHandle::InterleavingAudioCallback cb) { host::StartAudio(nullptr, cb); }
+    void StopAudio() { host::StopAudio(); }
+
+    void SetAudioSampleRate(SaiHandle::Config::SampleRate samplerate)
+    {
+        static const float rates[] = {8000.0f, 16000.0f, 32000.0f, 48000.0f, 96000.0f};
+        host::SetSampleRate(rates[(int)samplerate]);
+    }
+    float AudioSampleRate() { return host::SampleRate(); }
+    void SetAudioBlockSize(size_t size) { host::SetBlockSize(size); }
+    size_t AudioBlockSize() { return host::BlockSize(); }
+    float AudioCallbackRate() { return host::SampleRate() / host::BlockSize(); }
+
+    static void StartLog(bool wait_for_pc = false) { Logger::StartLog(wait_for_pc); }
+    template <typename... Args>
+    static void Print(const char* format, Args... args) { Logger::Print(format, args...); }
+    template <typename... Args>
+    static void PrintLine(const char* format, Args... args) { Logger::PrintLine(format, args...); }
+
+    QSPIHandle qspi;
+    UsbHandle usb_handle;
+    AdcHandle adc;
+};
+
+/** libDaisy's PersistentStorage, on the RAM flash */
+template <typename SettingStruct>
+class PersistentStorage
+{
+  public:
+    enum class State { UNKNOWN = 0, FACTORY = 1, USER = 2 };
+
+    PersistentStorage(QSPIHandle& qspi) : qspi_(qspi) {}
+
+    void Init(const SettingStruct& defaults, uint32_t address_offset = 0)
+    {
+        default_settings_ = defaults;
+        settings_ = defaults;
+        address_offset_ = address_offset & ~0xFFFu;
+        const Stored* stored = (const Stored*)qspi_.GetData(address_offset_);
+        if (stored->state == (uint32_t)State::USER || stored->state == (uint32_t)State::FACTORY) {
+            state_ = (State)stored->state;
+            settings_ = stored->settings;
+        } else {
+            state_ = State::FACTORY;
+            StoreSettings();
+        }
+    }
+    State GetState() const { return state_; }
+    SettingStruct& GetSettings() { return settings_; }
+    void Save()
+    {
+        state_ = State::USER;
+        StoreSettings();
+    }
+    void RestoreDefaults()
+    {
+        settings_ = default_settings_;
+        state_ = State::FACTORY;
+        StoreSettings();
+    }
+
+  private:
+    struct Stored
+    {
+        uint32_t state;
+        SettingStruct settings;
+    };
+
+    void StoreSettings()
+    {
+        Stored stored;
+        stored.state = (uint32_t)state_;
+        stored.settings = settings_;
+        qspi_.Erase(address_offset_, address_offset_ + ((sizeof(Stored) + 4095) & ~4095u));
+        qspi_.Write(address_offset_, sizeof(Stored), (uint8_t*)&stored);
+    }
+
+    QSPIHandle& qspi_;
+    SettingStruct default_settings_;
+    SettingStruct settings_;
+    uint32_t address_offset_ = 0;
+    State state_ = State::UNKNOWN;
+};
+
+// USB MIDI with nothing plugged in
+
+enum MidiMessageType {
+    NoteOff,
+    NoteOn,
+    PolyphonicKeyPressure,
+    ControlChange,
+    ProgramChange,
+    ChannelPressure,
+    PitchBend,
+    SystemCommon,
+    SystemRealTime,
+    ChannelMode,
+    MessageLast,
+};
+
+enum SystemRealTimeType {
+    TimingClock,
+    SRTUndefined0,
+    Start,
+    Continue,
+    Stop,
+    SRTUndefined1,
+    ActiveSensing,
+    Reset,
+    SystemRealTimeLast,
+};
+
+struct NoteOnEvent
+{
+    int channel;
+    uint8_t note;
+    uint8_t velocity;
+};
+
+struct NoteOffEvent
+{
+    int channel;
+    uint8_t note;
+    uint8_t velocity;
+};
+
+struct ControlChangeEvent
+{
+    int channel;
+    uint8_t control_number;
+    uint8_t value;
+};
+
+struct MidiEvent
+{
+    MidiMessageType type;
+    int channel;
+    uint8_t data[2];
+    SystemRealTimeType srt_type;
+    NoteOnEvent AsNoteOn() { return {channel, data[0], data[1]}; }
+    NoteOffEvent AsNoteOff() { return {channel, data[0], data[1]}; }
+    ControlChangeEvent AsControlChange() { return {channel, data[0], data[1]}; }
+};
+
+struct MidiUsbTransport
+{
+    struct Config
+    {
+        enum Periph { INTERNAL, EXTERNAL, HOST };
+        Periph periph = INTERNAL;
+    };
+};
+
+class MidiUsbHandler
+{
+  public:
+    struct Config
+    {
+        MidiUsbTransport::Config transport_config;
+    };
+    void Init(Config) {}
+    void StartReceive() {}
+    void Listen() {}
+    bool HasEvents() { return false; }
+    MidiEvent PopEvent() { return MidiEvent{}; }
+};
+
+inline float fmap(float in, float min, float max) { return min + in * (max - min); }
+
+enum class Mapping { LINEAR, EXP, LOG };
+
+inline float fmap(float in, float min, float max, Mapping curve)
+{
+    switch (curve) {
+        case Mapping::EXP: return min + (in * in) * (max - min);
+        case Mapping::LOG: {
+            const float a = 1.f / log10f(max / min);
+            return min * powf(10, in / a);
+        }
+        default: return min + in * (max - min);
+    }
+}
+
+}  // namespace daisy
+
+// Cortex-M7 cycle counter, counting the host's real time at 480 MHz
+struct HostCycleCounter
+{
+    operator uint32_t() const { return (uint32_t)(host::RealNs() * 12 / 25); }
+    HostCycleCounter& operator=(uint32_t) { return *this; }
+};
+struct HostDWT
+{
+    uint32_t CTRL;
+    HostCycleCounter CYCCNT;
+};
+struct HostCoreDebug
+{
+    uint32_t DEMCR;
+};
+static HostDWT host_dwt;
+static HostCoreDebug host_core_debug;
+#define DWT (&host_dwt)
+#define CoreDebug (&host_core_debug)
+#define DWT_CTRL_CYCCNTENA_Msk 1u
+#define CoreDebug_DEMCR_TRCENA_Msk (1u << 24)
+static uint32_t SystemCoreClock = 480000000;
+
+// No data cache to keep coherent with the flash
+inline void SCB_InvalidateDCache_by_Addr(volatile void* addr, int32_t dsize)
+{
+    (void)addr;
+    (void)dsize;
+}
+
+#endif  // HOST_DAISY_SEED_H
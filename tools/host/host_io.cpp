@@ -0,0 +1,247 @@
+// Host IO
+// State shared by the host libDaisy (pedal thread) and the render harness
+
+#include "host_io.h"
+
+#include <atomic>
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include <thread>
+
+namespace host {
+
+namespace {
+
+std::atomic<AudioCallback> audio_cb{nullptr};
+std::atomic<InterleavingAudioCallback> interleaving_cb{nullptr};
+std::atomic<bool> audio_running{false};
+std::atomic<bool> lockstep{false};
+// Audio clock time the main loop sleeps until, 0 while it runs
+std::atomic<uint64_t> parked_until{0};
+
+float sample_rate = 48000.0f;
+size_t block_size = 48;
+
+// Audio clock: boot-time Delay()s plus samples rendered
+std::atomic<uint64_t> boot_us{0};
+std::atomic<uint64_t> samples{0};
+
+uint8_t adc_pins[kAdcChannels];
+
+// make RTSAN=1: the callback runs in a nonblocking context, so Clang's
+// RealtimeSanitizer stops the render at any allocation, lock or blocking
+// call it reaches, with a stack trace. The pedal's statics are set up in
+// its main(), outside it.
+#if HOST_RTSAN
+#define HOST_NONBLOCKING [[clang::nonblocking]]
+#else
+#define HOST_NONBLOCKING
+#endif
+
+HOST_NONBLOCKING void RunCallback(AudioCallback cb, const float* const* in, float** out, size_t size)
+{
+    cb(in, out, size);
+}
+
+HOST_NONBLOCKING void RunInterleavingCallback(InterleavingAudioCallback cb, const float* in, float* out,
+                                              size_t size)
+{
+    cb(in, out, size);
+}
+uint16_t knob_adc[kPins];  // By Seed pin
+uint16_t unmapped_adc = 0;
+std::atomic<bool> pins[kPins];
+float leds[kPins];
+
+uint8_t flash[kFlashSize];
+
+// TIM2..TIM5 period interrupts, in audio time
+struct Timer
+{
+    std::atomic<void (*)(void*)> cb{nullptr};
+    void* data = nullptr;
+    double rate_hz = 0.0;
+    uint64_t fired = 0;
+    uint64_t start_samples = 0;
+};
+Timer timers[4];
+
+const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+struct Init
+{
+    Init()
+    {
+        memset(adc_pins, 0xFF, sizeof(adc_pins));
+        memset(flash, 0xFF, sizeof(flash));
+        for (size_t i = 0; i < kPins; i++) {
+            knob_adc[i] = 0;
+            pins[i] = false;
+            leds[i] = 0.0f;
+        }
+    }
+} init;
+
+}  // namespace
+
+uint64_t NowUs()
+{
+    return boot_us.load() + samples.load() * 1000000ull / (uint64_t)sample_rate;
+}
+
+uint64_t RealNs()
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+void Delay(uint64_t us)
+{
+    if (!audio_running.load()) {
+        boot_us += us;
+        return;
+    }
+    uint64_t until = NowUs() + us;
+    parked_until = until;
+    while (NowUs() < until) {
+        if (lockstep.load()) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+    parked_until = 0;
+}
+
+void Halt(const char* why)
+{
+    fprintf(stderr, "[pedal] %s: main loop halted\n", why);
+    parked_until = UINT64_MAX;
+    for (;;) {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
+}
+
+void StartAudio(AudioCallback cb, InterleavingAudioCallback icb)
+{
+    audio_cb = cb;
+    interleaving_cb = icb;
+    audio_running = true;
+}
+
+void StopAudio() { audio_running = false; }
+
+void SetSampleRate(float rate) { sample_rate = rate; }
+float SampleRate() { return sample_rate; }
+void SetBlockSize(size_t size) { block_size = size; }
+size_t BlockSize() { return block_size; }
+
+void MapAdcChannel(size_t channel, uint8_t pin) { adc_pins[channel] = pin; }
+
+uint16_t* AdcPtr(size_t channel)
+{
+    uint8_t pin = channel < kAdcChannels ? adc_pins[channel] : 0xFF;
+    return pin < kPins ? &knob_adc[pin] : &unmapped_adc;
+}
+
+bool PinPressed(uint8_t pin) { return pin < kPins ? pins[pin].load() : false; }
+
+void SetLed(uint8_t pin, float brightness)
+{
+    if (pin < kPins) leds[pin] = brightness;
+}
+
+void SetTimer(int index, void (*cb)(void*), void* data, double rate_hz)
+{
+    if (index < 0 || index >= 4) return;
+    Timer& timer = timers[index];
+    timer.cb = nullptr;
+    timer.data = data;
+    timer.rate_hz = rate_hz;
+    timer.fired = 0;
+    timer.start_samples = samples.load();
+    timer.cb = rate_hz > 0.0 ? cb : nullptr;
+}
+
+uint8_t* Flash() { return flash; }
+
+void Log(const char* format, va_list args, bool newline)
+{
+    fputs("[pedal] ", stderr);
+    vfprintf(stderr, format, args);
+    if (newline) fputc('\n', stderr);
+}
+
+void SetKnob(uint8_t pin, float value)
+{
+    if (pin >= kPins) return;
+    value = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+    knob_adc[pin] = (uint16_t)(value * 65535.0f + 0.5f);
+}
+
+void SetPin(uint8_t pin, bool pressed)
+{
+    if (pin < kPins) pins[pin] = pressed;
+}
+
+float LedBrightness(uint8_t pin) { return pin < kPins ? leds[pin] : 0.0f; }
+
+void WaitForAudio()
+{
+    while (!audio_running.load()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+bool AudioRunning() { return audio_running.load(); }
+
+void SetLockstep(bool on) { lockstep = on; }
+
+void WaitForMainLoop()
+{
+    if (!lockstep.load()) return;
+    while (parked_until.load() <= NowUs()) {
+        std::this_thread::yield();
+    }
+}
+
+void RunBlock(const float* const* in, float** out, size_t size)
+{
+    if (audio_running.load()) {
+        AudioCallback cb = audio_cb.load();
+        InterleavingAudioCallback icb = interleaving_cb.load();
+        if (cb != nullptr) {
+            RunCallback(cb, in, out, size);
+        } else if (icb != nullptr) {
+            static float interleaved_in[2 * 4096];
+            static float interleaved_out[2 * 4096];
+            for (size_t i = 0; i < size; i++) {
+                interleaved_in[2 * i] = in[0][i];
+                interleaved_in[2 * i + 1] = in[1][i];
+            }
+            RunInterleavingCallback(icb, interleaved_in, interleaved_out, size);
+            for (size_t i = 0; i < size; i++) {
+                out[0][i] = interleaved_out[2 * i];
+                out[1][i] = interleaved_out[2 * i + 1];
+            }
+        }
+    } else {
+        for (size_t i = 0; i < size; i++) {
+            out[0][i] = out[1][i] = 0.0f;
+        }
+    }
+    samples += size;
+
+    for (Timer& timer : timers) {
+        void (*cb)(void*) = timer.cb.load();
+        if (cb == nullptr) continue;
+        uint64_t due = (uint64_t)((samples.load() - timer.start_samples) * timer.rate_hz / sample_rate);
+        for (; timer.fired < due && timer.cb.load() == cb; timer.fired++) {
+            cb(timer.data);
+        }
+    }
+}
+
+}  // namespace host
@@ -0,0 +1,71 @@
+// Host IO
+// What the host libDaisy asks of the render harness, and what it sets
+
+#pragma once
+#ifndef HOST_IO_H
+#define HOST_IO_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdarg.h>
+
+namespace host {
+
+typedef void (*AudioCallback)(const float* const* in, float** out, size_t size);
+typedef void (*InterleavingAudioCallback)(const float* in, float* out, size_t size);
+
+static const size_t kAdcChannels = 16;
+static const size_t kPins = 32;
+static const uint32_t kFlashSize = 8 * 1024 * 1024;
+
+// Pedal side (the host libDaisy)
+
+/** Audio clock in microseconds: Delay()s before audio starts plus the
+    samples rendered since */
+uint64_t NowUs();
+/** The host's monotonic clock in nanoseconds, for timing */
+uint64_t RealNs();
+/** Before StartAudio() this advances the audio clock; after it, waits for
+    the render to get there */
+void Delay(uint64_t us);
+/** Parks the pedal's main loop for good (no bootloader to reset into) */
+void Halt(const char* why);
+
+void StartAudio(AudioCallback cb, InterleavingAudioCallback interleaving_cb);
+void StopAudio();
+void SetSampleRate(float rate);
+float SampleRate();
+void SetBlockSize(size_t size);
+size_t BlockSize();
+
+void MapAdcChannel(size_t channel, uint8_t pin);
+uint16_t* AdcPtr(size_t channel);
+bool PinPressed(uint8_t pin);
+void SetLed(uint8_t pin, float brightness);
+/** Runs cb(data) rate_hz times a second of audio time; a null cb stops it */
+void SetTimer(int index, void (*cb)(void*), void* data, double rate_hz);
+uint8_t* Flash();
+void Log(const char* format, va_list args, bool newline);
+
+// Harness side
+
+/** Knob position 0..1 on a Seed pin */
+void SetKnob(uint8_t pin, float value);
+/** Switch contact closed (pressed) on a Seed pin */
+void SetPin(uint8_t pin, bool pressed);
+float LedBrightness(uint8_t pin);
+/** Blocks until the pedal has started audio */
+void WaitForAudio();
+/** In lockstep the harness runs a block only while the main loop is parked
+    in a Delay(), so the two interleave the same way on every render */
+void SetLockstep(bool on);
+/** In lockstep, blocks until the main loop is parked; otherwise returns */
+void WaitForMainLoop();
+bool AudioRunning();
+/** Runs one block through the pedal's callback, advances the clock and
+    fires the timers due by then */
+void RunBlock(const float* const* in, float** out, size_t size);
+
+}  // namespace host
+
+#endif  // HOST_IO_H
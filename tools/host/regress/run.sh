@@ -0,0 +1,67 @@
+#!/bin/sh
+# Golden-output regression suite for the host builds
+#
+#   regress/run.sh golden [pedal...]   render the references
+#   regress/run.sh check [pedal...]    render again and compare with them
+#   regress/run.sh run [pedal...]      render only, failing if a render does
+#                                      (make RTSAN=1 rtsan)
+#
+# Every pedal renders each script in regress/cases and in regress/<pedal>
+# over the harness's test pluck. References go to regress/golden (or
+# GOLDEN_DIR); tolerances are in regress/tolerances. The renders come
+# from build, or BUILD_DIR.
+
+cd "$(dirname "$0")/.." || exit 2
+mode=$1
+[ "$mode" = golden ] || [ "$mode" = check ] || [ "$mode" = run ] ||
+    { echo "usage: $0 golden|check|run [pedal...]" >&2; exit 2; }
+shift
+pedals=${*:-ambien ambien_flux buzzbox earth mars venus}
+golden=${GOLDEN_DIR:-regress/golden}
+build=${BUILD_DIR:-build}
+seconds=8
+
+tolerance() {
+    awk -v p="$1" -v c="$1/$2" '
+        { sub(/#.*/, "") }
+        $1 == c { tc = $2 }
+        $1 == p { tp = $2 }
+        END { print tc != "" ? tc : (tp != "" ? tp : "exact") }' regress/tolerances
+}
+
+failed=0
+for p in $pedals; do
+    if [ ! -x "$build/$p/render" ]; then
+        echo "$build/$p/render is missing: make all" >&2
+        exit 2
+    fi
+    for script in regress/cases/*.txt regress/"$p"/*.txt; do
+        [ -f "$script" ] || continue
+        name=$(basename "$script" .txt)
+        if [ "$mode" = golden ]; then
+            dir=$golden/$p
+        else
+            dir=$build/regress/$p
+        fi
+        mkdir -p "$dir"
+        printf '%-24s ' "$p/$name"
+        if ! "$build/$p/render" -d $seconds -s "$script" -o "$dir/$name.wav" > "$dir/$name.log" 2>&1; then
+            echo "FAIL  render failed, see $dir/$name.log"
+            failed=$((failed + 1))
+        elif [ "$mode" = golden ]; then
+            echo "written"
+        elif [ "$mode" = run ]; then
+            echo "ran"
+        elif [ ! -f "$golden/$p/$name.wav" ]; then
+            echo "FAIL  no reference: regress/run.sh golden $p"
+            failed=$((failed + 1))
+        elif ! "$build"/wavcmp "$golden/$p/$name.wav" "$dir/$name.wav" "$(tolerance "$p" "$name")"; then
+            failed=$((failed + 1))
+        fi
+    done
+done
+
+if [ $failed -ne 0 ]; then
+    echo "$failed failed"
+    exit 1
+fi
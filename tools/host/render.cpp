@@ -0,0 +1,286 @@
+// Host Render
+// Runs a pedal's unmodified AudioCallback over a WAV with scripted controls,
+// writes the result and reports the callback's cost
+
+#include <algorithm>
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "host_io.h"
+#include "wav.h"
+
+#ifndef HOST_PEDAL
+#define HOST_PEDAL "pedal"
+#endif
+
+// The pedal's own main(), renamed by the Makefile; it runs on its own thread
+// as the main loop, while the harness plays the audio interrupt
+int pedal_main();
+
+using host::Audio;
+
+namespace {
+
+// Hothouse wiring (lib/hothouse/hothouse.cpp), by Seed pin
+const uint8_t kKnobPins[6] = {16, 17, 18, 19, 20, 21};
+const uint8_t kToggleUpPins[3] = {9, 7, 5};
+const uint8_t kToggleDownPins[3] = {10, 8, 6};
+const uint8_t kFootswitchPins[2] = {25, 26};
+const uint8_t kLedPins[2] = {22, 23};
+const double kTapSeconds = 0.1;
+
+struct Event
+{
+    double time;
+    std::string control;
+    std::string value;
+};
+
+void Usage()
+{
+    fprintf(stderr,
+            "usage: render [-i in.wav] [-o out.wav] [-s script] [-t tail_s] [-d seconds] [-r] [-l]\n"
+            "  -i  input (PCM 16/24/32-bit or float, mono or stereo); default a test pluck\n"
+            "  -o  output, 32-bit float stereo at the pedal's rate\n"
+            "  -s  control script: lines of '<seconds> <control> <value>', where\n"
+            "      control is knob1..6 (0..1), toggle1..3 (up|middle|down),\n"
+            "      fs1/fs2 (down|up|tap) or adc<pin> (0..1, e.g. an expression input)\n"
+            "  -t  silence appended after the input (default 1 s)\n"
+            "  -d  length of the test pluck when there is no input (default 10 s)\n"
+            "  -r  pace blocks at real time with the main loop running free, instead of\n"
+            "      running blocks only while the main loop sleeps (repeatable renders)\n"
+            "  -l  loop the output back to the input a block late, a cable from output\n"
+            "      to input (for make LATENCY_TEST=1; the input file is ignored)\n");
+    exit(2);
+}
+
+// A low E string pluck every two seconds, about -12 dBFS
+Audio TestPluck(double seconds)
+{
+    Audio audio;
+    size_t frames = (size_t)(seconds * audio.rate);
+    audio.left.resize(frames);
+    audio.right.resize(frames);
+    const double f0 = 82.41;
+    for (size_t i = 0; i < frames; i++) {
+        double t = fmod(i / (double)audio.rate, 2.0);
+        double s = 0.0;
+        for (int h = 1; h <= 12; h++) {
+            s += sin(2.0 * M_PI * f0 * h * t) * exp(-t * (1.0 + 0.6 * h)) / h;
+        }
+        audio.left[i] = audio.right[i] = (float)(0.25 * s);
+    }
+    return audio;
+}
+
+std::vector<float> Resample(const std::vector<float>& in, float from, float to)
+{
+    if (from == to || in.empty()) return in;
+    size_t frames = (size_t)(in.size() * (double)to / from);
+    std::vector<float> out(frames);
+    for (size_t i = 0; i < frames; i++) {
+        double pos = i * (double)from / to;
+        size_t k = (size_t)pos;
+        double frac = pos - k;
+        float a = in[std::min(k, in.size() - 1)];
+        float b = in[std::min(k + 1, in.size() - 1)];
+        out[i] = (float)(a + (b - a) * frac);
+    }
+    return out;
+}
+
+bool ReadScript(const char* path, std::vector<Event>& events)
+{
+    FILE* f = fopen(path, "r");
+    if (f == nullptr) return false;
+    char line[256];
+    int number = 0;
+    while (fgets(line, sizeof(line), f) != nullptr) {
+        number++;
+        char* hash = strchr(line, '#');
+        if (hash != nullptr) *hash = '\0';
+        double time;
+        char control[32], value[32];
+        int fields = sscanf(line, "%lf %31s %31s", &time, control, value);
+        if (fields <= 0) continue;
+        if (fields != 3) {
+            fprintf(stderr, "%s:%d: expected '<seconds> <control> <value>'\n", path, number);
+            fclose(f);
+            return false;
+        }
+        if (strncmp(control, "fs", 2) == 0 && strcmp(value, "tap") == 0) {
+            events.push_back({time, control, "down"});
+            events.push_back({time + kTapSeconds, control, "up"});
+        } else {
+            events.push_back({time, control, value});
+        }
+    }
+    fclose(f);
+    std::stable_sort(events.begin(), events.end(),
+                     [](const Event& a, const Event& b) { return a.time < b.time; });
+    return true;
+}
+
+bool Apply(const Event& e)
+{
+    const std::string& c = e.control;
+    size_t digits = c.find_first_of("0123456789");
+    int index = digits != std::string::npos ? atoi(c.c_str() + digits) : -1;
+    if (c.compare(0, 4, "knob") == 0 && index >= 1 && index <= 6) {
+        host::SetKnob(kKnobPins[index - 1], (float)atof(e.value.c_str()));
+    } else if (c.compare(0, 6, "toggle") == 0 && index >= 1 && index <= 3) {
+        host::SetPin(kToggleUpPins[index - 1], e.value == "up");
+        host::SetPin(kToggleDownPins[index - 1], e.value == "down");
+        if (e.value != "up" && e.value != "middle" && e.value != "down") return false;
+    } else if (c.compare(0, 2, "fs") == 0 && index >= 1 && index <= 2) {
+        if (e.value != "down" && e.value != "up") return false;
+        host::SetPin(kFootswitchPins[index - 1], e.value == "down");
+    } else if (c.compare(0, 3, "adc") == 0 && index >= 0 && index < (int)host::kPins) {
+        host::SetKnob((uint8_t)index, (float)atof(e.value.c_str()));
+    } else {
+        return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    const char* in_path = nullptr;
+    const char* out_path = nullptr;
+    const char* script_path = nullptr;
+    double tail = 1.0;
+    double test_seconds = 10.0;
+    bool realtime = false;
+    bool loopback = false;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "-i" && has_value) in_path = argv[++i];
+        else if (arg == "-o" && has_value) out_path = argv[++i];
+        else if (arg == "-s" && has_value) script_path = argv[++i];
+        else if (arg == "-t" && has_value) tail = atof(argv[++i]);
+        else if (arg == "-d" && has_value) test_seconds = atof(argv[++i]);
+        else if (arg == "-r") realtime = true;
+        else if (arg == "-l") loopback = true;
+        else Usage();
+    }
+
+    Audio input;
+    if (in_path != nullptr) {
+        if (!host::ReadWav(in_path, input)) {
+            fprintf(stderr, "render: can't read %s (PCM or float WAV expected)\n", in_path);
+            return 1;
+        }
+    } else {
+        input = TestPluck(test_seconds);
+    }
+
+    std::vector<Event> events;
+    if (script_path != nullptr && !ReadScript(script_path, events)) {
+        fprintf(stderr, "render: can't read %s\n", script_path);
+        return 1;
+    }
+
+    // Knobs at noon, toggles up, footswitches released, then anything the
+    // script sets at time 0 so the pedal boots with it
+    for (int k = 0; k < 6; k++) {
+        host::SetKnob(kKnobPins[k], 0.5f);
+    }
+    for (int t = 0; t < 3; t++) {
+        host::SetPin(kToggleUpPins[t], true);
+    }
+    size_t next_event = 0;
+    for (; next_event < events.size() && events[next_event].time <= 0.0; next_event++) {
+        if (!Apply(events[next_event])) {
+            fprintf(stderr, "render: bad control '%s %s'\n", events[next_event].control.c_str(),
+                    events[next_event].value.c_str());
+            return 1;
+        }
+    }
+
+    host::SetLockstep(!realtime);
+    std::thread(pedal_main).detach();
+    host::WaitForAudio();
+
+    const float rate = host::SampleRate();
+    const size_t block = host::BlockSize();
+    if (input.rate != rate) {
+        fprintf(stderr, "render: resampling input from %.0f to %.0f Hz\n", input.rate, rate);
+    }
+    std::vector<float> in_left = Resample(input.left, input.rate, rate);
+    std::vector<float> in_right = Resample(input.right, input.rate, rate);
+    size_t frames = in_left.size() + (size_t)(tail * rate);
+    size_t blocks = (frames + block - 1) / block;
+    frames = blocks * block;
+    in_left.resize(frames, 0.0f);
+    in_right.resize(frames, 0.0f);
+
+    Audio output;
+    output.rate = rate;
+    output.left.resize(frames);
+    output.right.resize(frames);
+
+    const double budget_ns = block * 1e9 / rate;
+    double total_ns = 0.0, min_ns = 1e30, max_ns = 0.0;
+    size_t over_budget = 0;
+    auto wall_start = std::chrono::steady_clock::now();
+    for (size_t b = 0; b < blocks; b++) {
+        double now = (double)(b * block) / rate;
+        for (; next_event < events.size() && events[next_event].time <= now; next_event++) {
+            if (!Apply(events[next_event])) {
+                fprintf(stderr, "render: bad control '%s %s' ignored\n",
+                        events[next_event].control.c_str(), events[next_event].value.c_str());
+            }
+        }
+
+        size_t offset = b * block;
+        if (loopback) {
+            for (size_t i = 0; i < block; i++) {
+                in_left[offset + i] = b > 0 ? output.left[offset - block + i] : 0.0f;
+                in_right[offset + i] = b > 0 ? output.right[offset - block + i] : 0.0f;
+            }
+        }
+        const float* in[2] = {&in_left[offset], &in_right[offset]};
+        float* out[2] = {&output.left[offset], &output.right[offset]};
+        host::WaitForMainLoop();
+        uint64_t start = host::RealNs();
+        host::RunBlock(in, out, block);
+        double ns = (double)(host::RealNs() - start);
+
+        total_ns += ns;
+        min_ns = std::min(min_ns, ns);
+        max_ns = std::max(max_ns, ns);
+        over_budget += ns > budget_ns;
+
+        if (realtime) {
+            std::this_thread::sleep_until(wall_start + std::chrono::nanoseconds(
+                                                           (int64_t)((b + 1) * budget_ns)));
+        }
+    }
+
+    printf("pedal     %s\n", HOST_PEDAL);
+    printf("audio     %.0f Hz, %zu-sample blocks (%.3f ms budget), %.2f s rendered\n", rate, block,
+           budget_ns / 1e6, frames / rate);
+    printf("callback  %.1f ns/sample; per block min/avg/max %.1f/%.1f/%.1f us\n",
+           total_ns / frames, min_ns / 1e3, total_ns / blocks / 1e3, max_ns / 1e3);
+    printf("load      %.2f%% avg, %.2f%% peak of real time on this host; %zu blocks over budget\n",
+           100.0 * total_ns / blocks / budget_ns, 100.0 * max_ns / budget_ns, over_budget);
+    printf("leds      %.2f %.2f at the end\n", host::LedBrightness(kLedPins[0]),
+           host::LedBrightness(kLedPins[1]));
+
+    if (out_path != nullptr && !host::WriteWav(out_path, output)) {
+        fprintf(stderr, "render: can't write %s\n", out_path);
+        return 1;
+    }
+    fflush(stdout);
+    fflush(stderr);
+    _Exit(0);  // The pedal's main loop never returns
+}
@@ -0,0 +1,139 @@
+#!/usr/bin/env python3
+"""Worst-case CPU sweep over a pedal's controls in the host harness.
+
+Renders a pedal once for every combination of toggle positions (27),
+footswitches engaged (none, 1, 2, both) and knob positions, each knob
+taking every value in --knobs (by default 0 and 1, so 64 grid points),
+and reports each combination's callback cost from render's report. The
+footswitches are tapped just after boot, so the render is the pedal in
+that state throughout.
+
+The table, heaviest on average first, goes to build/sweep/<pedal>.txt;
+the --top heaviest rows are printed, then the worst combinations by
+average and by peak block. A render's peak block is one block, often
+its first, so it is noisier than the average. The figures are host times, so compare combinations with each
+other rather than with the Seed; with --ghz (the host's clock) they are
+also given in host cycles a sample. Run it on a quiet machine: anything
+else running shows up as load, which --repeat filters out. Work a pedal
+does in its main loop (Venus's STFT frames) isn't in the callback's
+figures. Build first with make all.
+
+Examples:
+  ./sweep.py buzzbox
+  ./sweep.py earth venus --knobs 0 0.5 1 -j 4
+  ./sweep.py mars --seconds 4 --ghz 3.2
+"""
+
+import argparse
+import itertools
+import os
+import re
+import subprocess
+import sys
+import tempfile
+from concurrent.futures import ThreadPoolExecutor
+
+PEDALS = ["ambien", "ambien_flux", "buzzbox", "earth", "mars", "venus"]
+TOGGLES = ["up", "middle", "down"]
+FOOTSWITCHES = [(), ("fs1",), ("fs2",), ("fs1", "fs2")]
+# After boot; a footswitch held at time 0 doesn't count as a press
+TAP_AT = 0.01
+
+CALLBACK = re.compile(r"callback\s+([\d.]+) ns/sample; per block min/avg/max ([\d.]+)/([\d.]+)/([\d.]+) us")
+LOAD = re.compile(r"load\s+([\d.]+)% avg, ([\d.]+)% peak")
+
+
+def script(toggles, footswitches, knobs):
+    lines = ["0 toggle%d %s" % (t + 1, p) for t, p in enumerate(toggles)]
+    lines += ["0 knob%d %g" % (k + 1, v) for k, v in enumerate(knobs)]
+    lines += ["%g %s tap" % (TAP_AT, fs) for fs in footswitches]
+    return "\n".join(lines) + "\n"
+
+
+def render(pedal, seconds, combo, repeat=1):
+    """The lightest of repeat renders: host interruptions only add time."""
+    results = [render_once(pedal, seconds, combo) for _ in range(repeat)]
+    return min(results, key=lambda r: r["ns"])
+
+
+def render_once(pedal, seconds, combo):
+    toggles, footswitches, knobs = combo
+    with tempfile.NamedTemporaryFile("w", suffix=".txt", delete=False) as f:
+        f.write(script(toggles, footswitches, knobs))
+    try:
+        result = subprocess.run(["build/%s/render" % pedal, "-d", str(seconds), "-t", "0", "-s", f.name],
+                                stdout=subprocess.PIPE, stderr=subprocess.DEVNULL, universal_newlines=True)
+    finally:
+        os.unlink(f.name)
+    callback = CALLBACK.search(result.stdout)
+    load = LOAD.search(result.stdout)
+    if result.returncode != 0 or callback is None or load is None:
+        sys.exit("%s: render failed for %s" % (pedal, describe(combo)))
+    return {
+        "combo": combo,
+        "ns": float(callback.group(1)),
+        "max_us": float(callback.group(4)),
+        "avg_load": float(load.group(1)),
+        "peak_load": float(load.group(2)),
+    }
+
+
+def describe(combo):
+    toggles, footswitches, knobs = combo
+    return "toggles %-6s %-6s %-6s  fs %-7s  knobs %s" % (
+        toggles + ("+".join(fs[2:] for fs in footswitches) or "-",
+                   " ".join("%g" % v for v in knobs)))
+
+
+def row(result, ghz):
+    cycles = "  %7.0f cyc/sample" % (result["ns"] * ghz) if ghz else ""
+    return "%s  %8.1f ns/sample%s  peak block %8.1f us  load %6.2f%% avg %7.2f%% peak" % (
+        describe(result["combo"]), result["ns"], cycles, result["max_us"], result["avg_load"], result["peak_load"])
+
+
+def sweep(pedal, args):
+    if not os.access("build/%s/render" % pedal, os.X_OK):
+        sys.exit("build/%s/render is missing: make all" % pedal)
+    combos = list(itertools.product(itertools.product(TOGGLES, repeat=3), FOOTSWITCHES,
+                                    itertools.product(args.knobs, repeat=6)))
+    print("%s: %d combinations" % (pedal, len(combos)), flush=True)
+    with ThreadPoolExecutor(args.jobs) as pool:
+        results = list(pool.map(lambda c: render(pedal, args.seconds, c, args.repeat), combos))
+    results.sort(key=lambda r: r["ns"], reverse=True)
+
+    os.makedirs("build/sweep", exist_ok=True)
+    with open("build/sweep/%s.txt" % pedal, "w") as f:
+        for r in results:
+            f.write(row(r, args.ghz) + "\n")
+    for r in results[:args.top]:
+        print("  " + row(r, args.ghz))
+    worst_peak = max(results, key=lambda r: r["max_us"])
+    lightest = results[-1]["ns"]
+    print("  worst average: %s  (%.1fx the lightest)" % (
+        describe(results[0]["combo"]), results[0]["ns"] / lightest if lightest > 0 else 0.0))
+    print("  worst peak:    %s  (%.2f%% of the block)" % (describe(worst_peak["combo"]), worst_peak["peak_load"]))
+    print("  table in build/sweep/%s.txt" % pedal)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("pedals", nargs="*", default=PEDALS, help="default: every pedal")
+    parser.add_argument("--knobs", nargs="+", type=float, default=[0.0, 1.0], help="each knob's positions")
+    parser.add_argument("--seconds", type=float, default=2.0, help="test pluck rendered for each (default 2)")
+    parser.add_argument("--repeat", type=int, default=1,
+                        help="renders of each, keeping the lightest (default 1; 3 filters out host blips)")
+    parser.add_argument("--top", type=int, default=10, help="rows printed per pedal (default 10)")
+    parser.add_argument("--ghz", type=float, help="the host's clock, to give cycles a sample")
+    parser.add_argument("-j", "--jobs", type=int, default=1,
+                        help="renders at once (default 1: parallel renders time each other's load)")
+    args = parser.parse_args()
+
+    os.chdir(os.path.dirname(os.path.abspath(__file__)))
+    for pedal in args.pedals:
+        if pedal not in PEDALS:
+            sys.exit("unknown pedal %s, expected one of: %s" % (pedal, " ".join(PEDALS)))
+        sweep(pedal, args)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,112 @@
+// block_balance_test
+// Mars's BlockBalance against DaisySP's per-sample Balance: the same
+// signal, balanced to a reference that steps between levels, through each,
+// at the block sizes of Mars's audio profiles. Prints how far BlockBalance's
+// output and gain are from Balance's, and fails when they drift past the
+// limits below.
+
+#include <math.h>
+#include <stdio.h>
+
+#include <vector>
+
+#include "Dynamics/balance.h"
+#include "block_balance.h"
+
+namespace {
+
+const float kRate = 48000.0f;
+const size_t kStep = 24000;  // samples at each level
+
+// The gain's largest error once a level has had 400 ms to settle. The
+// window stops 512 samples short of the next step: BlockBalance ramps a
+// block to the gain measured on the whole of it, so the block the step
+// lands in already moves. What is left is Balance's own ripple at twice
+// the signal's frequency, which a gain set a block at a time leaves out.
+const double kMaxSettledDb = 0.3;
+
+// Each case's lowest SNR of the output against Balance's, at any block
+// size: its worst figure over the three, less 2 dB. "together" is
+// Mars, where the reference is the signal before the tone stage; the rest
+// step one level against an unrelated other, where the linear ramp can't
+// follow Balance's gain swinging sample by sample for the block after.
+struct Case
+{
+    const char* name;
+    float sigLevels[4];
+    float compLevels[4];
+    double minSnrDb;
+};
+
+const Case kCases[] = {
+    {"together", {0.05f, 0.8f, 0.1f, 0.4f}, {0.03f, 0.5f, 0.06f, 0.25f}, 33.0},
+    {"reference steps", {0.5f, 0.5f, 0.5f, 0.5f}, {0.25f, 1.0f, 0.05f, 0.5f}, 33.0},
+    {"signal steps", {0.1f, 0.8f, 0.02f, 0.4f}, {0.5f, 0.5f, 0.5f, 0.5f}, 10.0},
+    {"both step", {0.5f, 0.05f, 0.9f, 0.2f}, {0.05f, 0.7f, 0.1f, 0.9f}, 8.5},
+};
+
+const size_t kBlockSizes[] = {256, 128, 48};
+
+struct Result
+{
+    double snrDb;
+    double maxGainDb;      // largest gain error anywhere
+    double maxSettledDb;   // largest gain error in each settled window
+};
+
+Result Run(const Case& c, size_t blockSize)
+{
+    const size_t length = 4 * kStep;
+    std::vector<float> sig(length), comp(length);
+    for (size_t i = 0; i < length; i++) {
+        const size_t level = i / kStep;
+        sig[i] = c.sigLevels[level] * sinf(2.0f * (float)M_PI * 220.0f * i / kRate);
+        comp[i] = c.compLevels[level] * sinf(2.0f * (float)M_PI * 331.0f * i / kRate);
+    }
+
+    daisysp::Balance ref;
+    ref.Init(kRate);
+    BlockBalance block;
+    block.Init(kRate);
+
+    double signal = 0.0, noise = 0.0;
+    Result r = {0.0, 0.0, 0.0};
+    for (size_t start = 0; start < length; start += blockSize) {
+        const size_t size = start + blockSize <= length ? blockSize : length - start;
+        block.Analyse(&sig[start], &comp[start], size);
+        for (size_t i = start; i < start + size; i++) {
+            const float gain = block.Next();
+            const float want = ref.Process(sig[i], comp[i]);
+            const float got = sig[i] * gain;
+            signal += (double)want * want;
+            noise += ((double)got - want) * ((double)got - want);
+
+            // Balance's gain is its output over its input; skip the zero
+            // crossings and the followers' first 50 ms
+            if (i < 2400 || fabsf(sig[i]) < 0.5f * c.sigLevels[i / kStep]) continue;
+            const double errorDb = fabs(20.0 * log10((double)got / want));
+            r.maxGainDb = fmax(r.maxGainDb, errorDb);
+            const size_t at = i % kStep;
+            if (at >= kStep - 4800 && at < kStep - 512) r.maxSettledDb = fmax(r.maxSettledDb, errorDb);
+        }
+    }
+    r.snrDb = 10.0 * log10(signal / noise);
+    return r;
+}
+
+}  // namespace
+
+int main()
+{
+    bool pass = true;
+    for (const Case& c : kCases) {
+        for (size_t blockSize : kBlockSizes) {
+            const Result r = Run(c, blockSize);
+            const bool ok = r.snrDb >= c.minSnrDb && r.maxSettledDb <= kMaxSettledDb;
+            pass = pass && ok;
+            printf("%s  %-16s %3zu-sample blocks: SNR %.1f dB, gain error max %.2f dB, settled %.4f dB\n",
+                   ok ? "ok  " : "FAIL", c.name, blockSize, r.snrDb, r.maxGainDb, r.maxSettledDb);
+        }
+    }
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,89 @@
+// control_snapshot_test
+// lib/hothouse's fixed-rate control path on the host libDaisy: knob moves
+// at the ADC reach Controls() after the next ServiceControls() scan, and
+// the change counts follow them. No pedal reads Controls().knobs, so the
+// regression renders can't see this.
+
+#include <math.h>
+#include <stdio.h>
+
+#include "daisy_seed.h"
+#include "host_io.h"
+#include "hothouse.h"
+
+using clevelandmusicco::Hothouse;
+
+namespace {
+
+int failures = 0;
+
+void Expect(bool ok, const char* what)
+{
+    printf("%s  %s\n", ok ? "ok  " : "FAIL", what);
+    if (!ok) failures++;
+}
+
+// Hothouse's knobs are on Seed pins 16 to 21
+const uint8_t kKnobPin = 16;
+
+// The ADC holds 16 bits
+bool Near(float value, float want) { return fabsf(value - want) < 1.0f / 65535.0f + 1e-6f; }
+
+bool AllKnobsNear(const Hothouse::ControlSnapshot& s, const float* want)
+{
+    for (size_t k = 0; k < Hothouse::KNOB_LAST; k++) {
+        if (!Near(s.knobs[k], want[k])) return false;
+    }
+    return true;
+}
+
+Hothouse hw;
+
+}  // namespace
+
+int main()
+{
+    float want[Hothouse::KNOB_LAST];
+    for (size_t k = 0; k < Hothouse::KNOB_LAST; k++) {
+        want[k] = 0.1f + 0.15f * k;
+        host::SetKnob(kKnobPin + k, want[k]);
+    }
+
+    hw.Init();
+    hw.SetControlRate(1000.0f);
+    Expect(AllKnobsNear(hw.Controls(), want), "SetControlRate() publishes the knobs as they are");
+
+    const uint32_t sequence = hw.Controls().sequence;
+    const uint32_t changes = hw.Controls().knob_changes[2];
+    want[2] = 0.9f;
+    host::SetKnob(kKnobPin + 2, want[2]);
+    Expect(!hw.ServiceControls() && hw.Controls().sequence == sequence,
+           "no scan before a control period has passed");
+
+    host::Delay(1000);
+    Expect(hw.ServiceControls(), "a scan once the period has passed");
+    Expect(AllKnobsNear(hw.Controls(), want), "a moved knob reaches the snapshot");
+    Expect(Near(hw.Controls().knobs[2], hw.GetKnobValue(Hothouse::KNOB_3)),
+           "the snapshot reads as GetKnobValue()");
+    Expect(hw.Controls().knob_changes[2] == changes + 1 && hw.Controls().sequence == sequence + 1,
+           "the move counts as a change");
+
+    // Within KNOB_CHANGE_TOLERANCE: the value follows, the count doesn't
+    want[2] = 0.902f;
+    host::SetKnob(kKnobPin + 2, want[2]);
+    host::Delay(1000);
+    hw.ServiceControls();
+    Expect(AllKnobsNear(hw.Controls(), want) && hw.Controls().knob_changes[2] == changes + 1,
+           "a move inside the tolerance reaches the value, not the count");
+
+    // Every knob to the other end
+    for (size_t k = 0; k < Hothouse::KNOB_LAST; k++) {
+        want[k] = 1.0f - want[k];
+        host::SetKnob(kKnobPin + k, want[k]);
+    }
+    host::Delay(1000);
+    hw.ServiceControls();
+    Expect(AllKnobsNear(hw.Controls(), want), "every knob reaches the snapshot");
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,203 @@
+// effect_chain_test
+// lib/hothouse's EffectChain with stub stages: that each stage runs once a
+// block in order, reading what the stage before it wrote and never the
+// buffer it writes, that the last lands in the output for any number of
+// stages and blocks over MaxBlock, and that Fit() degrades last stage first
+// and refuses a budget the stages can't reach.
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "hothouse_chain.h"
+
+using clevelandmusicco::BlockBudget;
+using clevelandmusicco::EffectChain;
+
+namespace {
+
+int failures = 0;
+
+void Expect(bool ok, const char* what)
+{
+    printf("%s  %s\n", ok ? "ok  " : "FAIL", what);
+    if (!ok) failures++;
+}
+
+// x * gain + offset, which composes differently in every order; costs one
+// entry of modes per block and degrades to the next
+struct Stage
+{
+    float gain = 1.0f;
+    float offset = 0.0f;
+    uint32_t modes[3] = {0, 0, 0};
+    size_t numModes = 1;
+    size_t mode = 0;
+
+    int calls = 0;
+    bool aliased = false;
+    const float* lastIn = nullptr;
+    float* lastOut = nullptr;
+
+    void Process(const float* in, float* out, size_t size)
+    {
+        calls++;
+        aliased = aliased || in == out;
+        lastIn = in;
+        lastOut = out;
+        for (size_t i = 0; i < size; i++) {
+            out[i] = in[i] * gain + offset;
+        }
+    }
+
+    uint32_t CyclesPerBlock() const { return modes[mode]; }
+
+    bool Degrade()
+    {
+        if (mode + 1 >= numModes) return false;
+        mode++;
+        return true;
+    }
+};
+
+const size_t kMaxBlock = 32;
+
+float input[100], output[100];
+
+void FillInput()
+{
+    for (size_t i = 0; i < 100; i++) {
+        input[i] = (float)i - 50.0f;
+    }
+    memset(output, 0, sizeof(output));
+}
+
+// The output against the stages applied by hand to every sample of size
+bool Matches(Stage* const* stages, size_t count, size_t size)
+{
+    for (size_t i = 0; i < size; i++) {
+        float want = input[i];
+        for (size_t s = 0; s < count; s++) {
+            want = want * stages[s]->gain + stages[s]->offset;
+        }
+        if (fabsf(output[i] - want) > 1e-4f * (1.0f + fabsf(want))) return false;
+    }
+    return true;
+}
+
+bool NoneAliased(Stage* const* stages, size_t count)
+{
+    for (size_t s = 0; s < count; s++) {
+        if (stages[s]->aliased) return false;
+    }
+    return true;
+}
+
+void TestBuffering()
+{
+    Stage a, b, c, d;
+    a.gain = 2.0f;
+    a.offset = 1.0f;
+    b.gain = -0.5f;
+    b.offset = 3.0f;
+    c.gain = 3.0f;
+    c.offset = -2.0f;
+    d.gain = 0.25f;
+    d.offset = 0.5f;
+    Stage* all[] = {&a, &b, &c, &d};
+
+    {
+        EffectChain<kMaxBlock, Stage> chain(a);
+        FillInput();
+        chain.Process(input, output, kMaxBlock);
+        Expect(Matches(all, 1, kMaxBlock) && a.lastOut == output, "1 stage writes the output");
+    }
+    {
+        EffectChain<kMaxBlock, Stage, Stage> chain(a, b);
+        FillInput();
+        chain.Process(input, output, kMaxBlock);
+        Expect(Matches(all, 2, kMaxBlock), "2 stages in order");
+        Expect(a.lastIn == input && a.lastOut != output && b.lastIn == a.lastOut &&
+                   b.lastOut == output,
+               "2 stages: the first to scratch, the second from it to the output");
+    }
+    {
+        EffectChain<kMaxBlock, Stage, Stage, Stage> chain(a, b, c);
+        FillInput();
+        chain.Process(input, output, kMaxBlock);
+        Expect(Matches(all, 3, kMaxBlock), "3 stages in order");
+        Expect(a.lastOut == output && b.lastIn == output && b.lastOut != output &&
+                   c.lastIn == b.lastOut && c.lastOut == output,
+               "3 stages: output, scratch, output");
+    }
+    {
+        a.calls = b.calls = c.calls = d.calls = 0;
+        a.aliased = b.aliased = c.aliased = d.aliased = false;
+        EffectChain<kMaxBlock, Stage, Stage, Stage, Stage> chain(a, b, c, d);
+        FillInput();
+        chain.Process(input, output, kMaxBlock);
+        Expect(Matches(all, 4, kMaxBlock) && d.lastOut == output, "4 stages in order");
+        Expect(NoneAliased(all, 4), "no stage reads the buffer it writes");
+        Expect(a.calls == 1 && b.calls == 1 && c.calls == 1 && d.calls == 1,
+               "each stage runs once a block");
+
+        // 100 samples in pieces of 32, 32, 32 and 4
+        FillInput();
+        chain.Process(input, output, 100);
+        Expect(Matches(all, 4, 100), "a block over MaxBlock is run in pieces");
+        Expect(a.calls == 5 && d.calls == 5, "100 samples in four pieces");
+        Expect(NoneAliased(all, 4), "no stage aliases across pieces");
+    }
+}
+
+void TestFit()
+{
+    Stage a, b, c;
+    const uint32_t costsA[] = {300, 200, 100};
+    const uint32_t costsB[] = {400, 250, 0};
+    const uint32_t costsC[] = {500, 100, 0};
+    memcpy(a.modes, costsA, sizeof(costsA));
+    memcpy(b.modes, costsB, sizeof(costsB));
+    memcpy(c.modes, costsC, sizeof(costsC));
+    a.numModes = 3;
+    b.numModes = 2;
+    c.numModes = 2;
+
+    EffectChain<kMaxBlock, Stage, Stage, Stage> chain(a, b, c);
+    Expect(chain.Cycles() == 1200, "Cycles() sums the stages' modes");
+
+    Expect(chain.Fit(1200) && a.mode == 0 && b.mode == 0 && c.mode == 0,
+           "a chain inside its budget is left alone");
+
+    // 1200 -> 800 with the last stage degraded; that covers 1000
+    Expect(chain.Fit(1000) && a.mode == 0 && b.mode == 0 && c.mode == 1 && chain.Cycles() == 800,
+           "the last stage degrades first");
+
+    // The last stage has nothing left, so the one before it goes next,
+    // 800 -> 650, and then the first, 650 -> 550
+    Expect(chain.Fit(650) && b.mode == 1 && a.mode == 0 && chain.Cycles() == 650,
+           "then the one before it, and no further than the budget needs");
+    Expect(chain.Fit(600) && a.mode == 1 && chain.Cycles() == 550, "then the first");
+
+    // 550 -> 450 at a's last mode, which is as cheap as the chain gets
+    Expect(!chain.Fit(400) && a.mode == 2 && b.mode == 1 && c.mode == 1 && chain.Cycles() == 450,
+           "a budget the stages can't reach is refused, every stage degraded");
+    Expect(chain.Fit(450), "the cheapest modes still fit their own cost");
+}
+
+void TestBudget()
+{
+    Expect(BlockBudget(48, 48000.0f) == 384000, "48 samples at 48 kHz, 20% headroom");
+    Expect(BlockBudget(256, 48000.0f, 0.0f) == 2560000, "256 samples at 48 kHz, no headroom");
+    Expect(BlockBudget(48, 96000.0f, 0.5f, 400e6f) == 100000, "at another clock");
+}
+
+}  // namespace
+
+int main()
+{
+    TestBuffering();
+    TestFit();
+    TestBudget();
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,110 @@
+// WAV files
+// Reading and writing for the render harness and wavcmp
+
+#include "wav.h"
+
+#include <algorithm>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+namespace host {
+
+static uint32_t ReadLE(const uint8_t* p, int bytes)
+{
+    uint32_t v = 0;
+    for (int i = 0; i < bytes; i++) {
+        v |= (uint32_t)p[i] << (8 * i);
+    }
+    return v;
+}
+
+bool ReadWav(const char* path, Audio& audio)
+{
+    FILE* f = fopen(path, "rb");
+    if (f == nullptr) return false;
+    std::vector<uint8_t> file;
+    uint8_t buf[65536];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+        file.insert(file.end(), buf, buf + n);
+    }
+    fclose(f);
+    if (file.size() < 12 || memcmp(&file[0], "RIFF", 4) != 0 || memcmp(&file[8], "WAVE", 4) != 0) {
+        return false;
+    }
+
+    int format = 0, channels = 0, bits = 0;
+    const uint8_t* data = nullptr;
+    size_t data_size = 0;
+    for (size_t pos = 12; pos + 8 <= file.size();) {
+        uint32_t size = ReadLE(&file[pos + 4], 4);
+        const uint8_t* chunk = &file[pos + 8];
+        if (memcmp(&file[pos], "fmt ", 4) == 0 && size >= 16) {
+            format = ReadLE(chunk, 2);
+            channels = ReadLE(chunk + 2, 2);
+            audio.rate = (float)ReadLE(chunk + 4, 4);
+            bits = ReadLE(chunk + 14, 2);
+            if (format == 0xFFFE && size >= 26) format = ReadLE(chunk + 24, 2);  // Extensible
+        } else if (memcmp(&file[pos], "data", 4) == 0) {
+            data = chunk;
+            data_size = std::min<size_t>(size, file.size() - (pos + 8));
+        }
+        pos += 8 + size + (size & 1);
+    }
+    if (data == nullptr || channels < 1 || !(format == 1 || format == 3)) return false;
+
+    int bytes = bits / 8;
+    size_t frames = data_size / (bytes * channels);
+    audio.left.resize(frames);
+    audio.right.resize(frames);
+    for (size_t i = 0; i < frames; i++) {
+        float s[2];
+        for (int c = 0; c < 2; c++) {
+            const uint8_t* p = data + (i * channels + std::min(c, channels - 1)) * bytes;
+            if (format == 3 && bits == 32) {
+                uint32_t u = ReadLE(p, 4);
+                memcpy(&s[c], &u, 4);
+            } else {
+                int32_t v = (int32_t)(ReadLE(p, bytes) << (32 - bits));
+                s[c] = v / 2147483648.0f;
+            }
+        }
+        audio.left[i] = s[0];
+        audio.right[i] = s[1];
+    }
+    return true;
+}
+
+static void WriteLE(FILE* f, uint32_t v, int bytes)
+{
+    for (int i = 0; i < bytes; i++) {
+        fputc((v >> (8 * i)) & 0xFF, f);
+    }
+}
+
+bool WriteWav(const char* path, const Audio& audio)
+{
+    FILE* f = fopen(path, "wb");
+    if (f == nullptr) return false;
+    uint32_t data_size = (uint32_t)(audio.left.size() * 2 * 4);
+    fwrite("RIFF", 1, 4, f);
+    WriteLE(f, 36 + data_size, 4);
+    fwrite("WAVEfmt ", 1, 8, f);
+    WriteLE(f, 16, 4);
+    WriteLE(f, 3, 2);  // IEEE float
+    WriteLE(f, 2, 2);
+    WriteLE(f, (uint32_t)audio.rate, 4);
+    WriteLE(f, (uint32_t)audio.rate * 8, 4);
+    WriteLE(f, 8, 2);
+    WriteLE(f, 32, 2);
+    fwrite("data", 1, 4, f);
+    WriteLE(f, data_size, 4);
+    for (size_t i = 0; i < audio.left.size(); i++) {
+        fwrite(&audio.left[i], 4, 1, f);
+        fwrite(&audio.right[i], 4, 1, f);
+    }
+    return fclose(f) == 0;
+}
+
+}  // namespace host
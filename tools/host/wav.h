@@ -0,0 +1,25 @@
+// WAV files
+// Reading and writing for the render harness and wavcmp
+
+#pragma once
+#ifndef HOST_WAV_H
+#define HOST_WAV_H
+
+#include <vector>
+
+namespace host {
+
+struct Audio
+{
+    float rate = 48000.0f;
+    std::vector<float> left, right;
+};
+
+/** Reads PCM 16/24/32-bit or float, mono (copied to both sides) or stereo */
+bool ReadWav(const char* path, Audio& audio);
+/** Writes 32-bit float stereo */
+bool WriteWav(const char* path, const Audio& audio);
+
+}  // namespace host
+
+#endif  // HOST_WAV_H
@@ -0,0 +1,64 @@
+// wavcmp
+// Compares a render with its reference: bit-exact, or at least a given SNR
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "wav.h"
+
+int main(int argc, char** argv)
+{
+    if (argc != 4) {
+        fprintf(stderr,
+                "usage: wavcmp reference.wav render.wav exact|<min SNR dB>\n"
+                "  exit status 0 when the render passes, 1 when it differs too much\n");
+        return 2;
+    }
+    host::Audio ref, out;
+    for (int i = 1; i <= 2; i++) {
+        if (!host::ReadWav(argv[i], i == 1 ? ref : out)) {
+            fprintf(stderr, "wavcmp: can't read %s\n", argv[i]);
+            return 2;
+        }
+    }
+    bool exact = strcmp(argv[3], "exact") == 0;
+    double min_snr = exact ? INFINITY : atof(argv[3]);
+
+    if (ref.rate != out.rate || ref.left.size() != out.left.size()) {
+        printf("FAIL  %.0f Hz x %zu frames, reference %.0f Hz x %zu\n", out.rate, out.left.size(),
+               ref.rate, ref.left.size());
+        return 1;
+    }
+
+    // Both channels; SNR of the reference against the difference
+    double signal = 0.0, noise = 0.0, max_diff = 0.0;
+    size_t differing = 0;
+    const std::vector<float>* refs[2] = {&ref.left, &ref.right};
+    const std::vector<float>* outs[2] = {&out.left, &out.right};
+    for (int c = 0; c < 2; c++) {
+        for (size_t i = 0; i < refs[c]->size(); i++) {
+            float r = (*refs[c])[i], o = (*outs[c])[i];
+            if (memcmp(&r, &o, sizeof(r)) == 0) continue;
+            double d = (double)o - r;
+            differing++;
+            noise += d * d;
+            max_diff = fmax(max_diff, fabs(d));
+        }
+        for (float r : *refs[c]) {
+            signal += (double)r * r;
+        }
+    }
+
+    double snr = differing == 0 ? INFINITY : 10.0 * log10(signal / noise);
+    bool pass = exact ? differing == 0 : !(snr < min_snr);
+    if (differing == 0) {
+        printf("%s  bit-exact\n", pass ? "ok  " : "FAIL");
+    } else {
+        printf("%s  %zu samples differ, max %.3g (%.1f dBFS), SNR %.1f dB (%s%s)\n",
+               pass ? "ok  " : "FAIL", differing, max_diff, 20.0 * log10(max_diff), snr,
+               exact ? "exact required" : "min ", exact ? "" : argv[3]);
+    }
+    return pass ? 0 : 1;
+}
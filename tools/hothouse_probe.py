@@ -0,0 +1,131 @@
+#!/usr/bin/env python3
+"""Arm a Hothouse pedal's signal probes and dump them to WAV over USB serial.
+
+The pedal must be built with make PROBE=1 and name its taps with
+Hothouse::AddProbe(); each keeps the last N frames of its signal in an
+SDRAM ring while armed. Arming clears the rings, and a dump stops them
+first, so what comes back is the N frames up to the moment of the dump.
+The pedal goes on playing throughout. Lines the pedal prints that aren't
+probe lines (the load meter, say) are shown as they arrive.
+
+The line format is in the probe note in hothouse.cpp; a pedal built with
+TELEMETRY=1 as well sends the same dump as binary records instead
+(hothouse_telemetry.h), which this reads too. Each tap is written as
+<prefix><name>.wav, mono 32-bit float at the tap's own rate. Needs
+pyserial.
+
+Examples:
+  tools/hothouse_probe.py /dev/ttyACM0 arm
+  tools/hothouse_probe.py /dev/ttyACM0 dump --prefix take1-
+"""
+
+import argparse
+import re
+import struct
+import sys
+import time
+import wave
+
+import serial
+
+import hothouse_telemetry as telemetry
+
+COMMANDS = {"arm": b"a", "dump": b"d", "stop": b"x"}
+# Between lines of a dump; the pedal prints a few dozen a main loop pass
+LINE_TIMEOUT = 2.0
+
+
+def events(port):
+    """The pedal's lines as (telemetry.TEXT, line) and its telemetry records
+    as (type, payload), until LINE_TIMEOUT passes without either."""
+    decoder = telemetry.Decoder()
+    deadline = time.monotonic() + LINE_TIMEOUT
+    while time.monotonic() < deadline:
+        for event in decoder.feed(port.read(4096)):
+            deadline = time.monotonic() + LINE_TIMEOUT
+            yield event
+    sys.exit("pedal: no reply")
+
+
+def write_wav(path, rate, samples):
+    # The wave module only writes PCM headers: patch in format 3, IEEE float
+    with wave.open(path, "wb") as w:
+        w.setnchannels(1)
+        w.setsampwidth(4)
+        w.setframerate(rate)
+        w.writeframes(struct.pack("<%df" % len(samples), *samples))
+    with open(path, "r+b") as f:
+        f.seek(20)
+        f.write(struct.pack("<H", 3))
+
+
+def add_samples(tap, first, samples):
+    if first != len(tap["data"]):
+        sys.exit("probe %s: lost a line at frame %d" % (tap["name"], len(tap["data"])))
+    tap["data"].extend(samples)
+
+
+def dump(port, prefix):
+    taps = {}
+    for kind, line in events(port):
+        if kind == telemetry.PROBE_TAP:
+            tap, frames, rate = struct.unpack_from("<B3xII", line)
+            taps[tap] = {"name": telemetry.name(line, 12), "frames": frames, "rate": rate, "data": []}
+            continue
+        if kind == telemetry.PROBE_DATA:
+            tap, first = struct.unpack_from("<B3xI", line)
+            add_samples(taps[tap], first, struct.unpack_from("<%df" % ((len(line) - 8) // 4), line, 8))
+            continue
+        if kind == telemetry.PROBE_STATE and line[0] == telemetry.PROBE_END:
+            break
+        if kind != telemetry.TEXT:
+            if kind != telemetry.PROBE_STATE:
+                print(telemetry.describe(kind, line))
+            continue
+        words = line.split(None, 5)
+        if words[0] != "probe" or len(words) < 2:
+            print(line)
+            continue
+        if words[1] == "tap" and len(words) == 6:
+            taps[int(words[2])] = {"name": words[5], "frames": int(words[3]), "rate": int(words[4]), "data": []}
+        elif words[1] == "data" and len(words) >= 4:
+            words = line.split()
+            add_samples(taps[int(words[2])], int(words[3]),
+                        [struct.unpack("<f", struct.pack("<I", int(word, 16)))[0] for word in words[4:]])
+        elif words[1] == "end":
+            break
+        elif words[1] != "begin":
+            print(line)
+
+    for tap in taps.values():
+        path = prefix + re.sub(r"[^A-Za-z0-9_.-]+", "_", tap["name"]) + ".wav"
+        write_wav(path, tap["rate"], tap["data"])
+        print("%s: %d frames at %d Hz" % (path, len(tap["data"]), tap["rate"]))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("port", help="the pedal's USB serial port")
+    parser.add_argument("command", choices=sorted(COMMANDS))
+    parser.add_argument("--prefix", default="", help="put before each tap's WAV file name")
+    args = parser.parse_args()
+
+    with serial.Serial(args.port, timeout=0.1) as port:
+        port.reset_input_buffer()
+        port.write(COMMANDS[args.command])
+        if args.command == "dump":
+            dump(port, args.prefix)
+            return
+        for kind, line in events(port):
+            if kind != telemetry.TEXT:
+                print(telemetry.describe(kind, line))
+                if kind == telemetry.PROBE_STATE:
+                    return
+                continue
+            print(line)
+            if line.startswith("probe "):
+                return
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,218 @@
+#!/usr/bin/env python3
+"""Decode a Hothouse pedal's binary telemetry from USB serial, or a capture.
+
+The pedal must be built with make TELEMETRY=1 (and the reports it should
+send: LOAD_METER=1, WATCHDOG=1, MEMORY_REPORT=1, NULL_TEST=1 and so on) and call
+hw.ServiceTelemetry() in its main loop. Each record is printed as a line,
+as the text reports would have said it; lines the pedal prints as text
+are shown as they arrive, and frames that fail their CRC are counted and
+skipped. The frame and record layouts are in lib/hothouse/hothouse_telemetry.h.
+Needs pyserial for a port, not for a file.
+
+A capture can be anything holding the stream, e.g. the host harness's
+stderr: build/<pedal>/render ... 2> capture.bin.
+
+Examples:
+  tools/hothouse_telemetry.py /dev/ttyACM0
+  tools/hothouse_telemetry.py --file capture.bin
+"""
+
+import argparse
+import math
+import struct
+import sys
+
+# hothouse_telemetry.h
+SYNC = b"\xa5\x5a"
+PAYLOAD = 48
+OVERHEAD = 6
+LOAD, WATCHDOG, OVERRUN, BOOT, ALLOC, DENORMAL_BLOCKS, DENORMAL_WATCH, MEMORY, LATENCY = range(1, 10)
+PROBE_STATE, PROBE_TAP, PROBE_DATA, NULL_TEST = range(10, 14)
+DROPPED = 127
+USER = 128
+PROBE_ARMED, PROBE_STOPPED, PROBE_BEGIN, PROBE_END = range(4)
+# Hothouse::Quality
+QUALITIES = ("Eco", "Normal", "High")
+# What Decoder yields for a line of text
+TEXT = -1
+
+
+def crc16(data, crc=0xFFFF):
+    """CRC-16/CCITT-FALSE, as TelemetryCrc()"""
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else crc << 1
+            crc &= 0xFFFF
+    return crc
+
+
+class Decoder:
+    """Splits the stream into records and text lines, in the order they came.
+
+    feed() returns (type, payload bytes) for each whole frame and (TEXT, line)
+    for each whole line. A frame with a bad CRC or length is skipped a byte at
+    a time until the next sync: 0xA5 never appears in the log's text.
+    """
+
+    def __init__(self):
+        self.pending = bytearray()
+        self.text = bytearray()
+        self.bad = 0
+
+    def feed(self, data):
+        self.pending += data
+        out = []
+        while self.pending:
+            start = self.pending.find(SYNC[0])
+            if start < 0:
+                self._text(self.pending, out)
+                self.pending = bytearray()
+                break
+            self._text(self.pending[:start], out)
+            del self.pending[:start]
+            if len(self.pending) < 4:
+                break
+            length = self.pending[3]
+            if self.pending[1] != SYNC[1] or length > PAYLOAD:
+                self._skip()
+                continue
+            if len(self.pending) < OVERHEAD + length:
+                break
+            frame = self.pending[: OVERHEAD + length]
+            if crc16(frame[2 : 4 + length]) != frame[4 + length] | frame[5 + length] << 8:
+                self._skip()
+                continue
+            out.append((frame[2], bytes(frame[4 : 4 + length])))
+            del self.pending[: OVERHEAD + length]
+        return out
+
+    def _skip(self):
+        self.bad += 1
+        del self.pending[0]
+
+    def _text(self, data, out):
+        self.text += data
+        while True:
+            end = self.text.find(b"\n")
+            if end < 0:
+                return
+            line = self.text[:end].decode(errors="replace").strip()
+            del self.text[: end + 1]
+            if line:
+                out.append((TEXT, line))
+
+
+def name(payload, offset):
+    return payload[offset:].decode(errors="replace")
+
+
+def describe(kind, payload):
+    """A record as a line of text"""
+    try:
+        if kind == LOAD:
+            avg, peak = struct.unpack("<ff", payload)
+            return "cpu avg %5.1f%%  peak %5.1f%%" % (avg * 100, peak * 100)
+        if kind == WATCHDOG:
+            session, mode, block, rate, seconds, period, blocks, overruns, late, worst, quality = struct.unpack(
+                "<BBHIIIIIIII", payload
+            )
+            return "watchdog %s: %u samples at %u Hz, %s quality, %u s  mode %2u  blocks %10u  overruns %6u  " \
+                "late %6u  worst %8u cycles %5.1f%%" % ("this session" if session else "last session", block, rate,
+                                                       QUALITIES[quality] if quality < len(QUALITIES) else "?",
+                                                       seconds, mode, blocks, overruns, late, worst,
+                                                       worst * 100.0 / (period or 1))
+        if kind == OVERRUN:
+            mode, cycles, period = struct.unpack("<III", payload)
+            return "overrun  mode %2u  %u cycles, %.1f%% of the block" % (mode, cycles, cycles * 100.0 / (period or 1))
+        if kind == BOOT:
+            at, took = struct.unpack_from("<II", payload)
+            return "boot  at %9.3f ms  took %9.3f ms  %s" % (at / 1000.0, took / 1000.0, name(payload, 8))
+        if kind == ALLOC:
+            return "alloc %u in the audio callback, first from 0x%08x" % struct.unpack("<II", payload)
+        if kind == DENORMAL_BLOCKS:
+            return "fpu blocks  %u flushed in, %u flushed out, %u invalid" % struct.unpack("<III", payload)
+        if kind == DENORMAL_WATCH:
+            subnormal, non_finite, count = struct.unpack_from("<III", payload)
+            return "  %-14s %u subnormal, %u nan or inf, of %u" % (name(payload, 12), subnormal, non_finite, count)
+        if kind == MEMORY:
+            m = struct.unpack("<11I", payload)
+            # Zeros are what the build doesn't measure: the host has no stack or heap figures
+            parts = [("stack %u most used, of %u painted", m[0:2]), ("heap %u, %u in use now", m[2:4]),
+                     ("sram %u .data, %u .bss", m[4:6]), ("dtcm %u data, %u bss", m[6:8]), ("itcm %u code", m[8:9]),
+                     ("sdram %u carved of %u", m[9:11])]
+            return "memory  " + ("  ".join(f % v for f, v in parts if any(v)) or "nothing measured in this build")
+        if kind == LATENCY:
+            through, bare, rate, block = struct.unpack("<iiII", payload)
+            if bare < 0:
+                return "latency  no click back: loop output 1 to input 1"
+            if through < 0:
+                return "latency  no click back through the pedal: set it fully wet"
+            ms = 1000.0 / (rate or 1)
+            return "latency  round trip %d samples (%.3f ms), codec alone %d (%.3f ms), pedal %+d (%+.3f ms), " \
+                "block %u" % (through, through * ms, bare, bare * ms, through - bare, (through - bare) * ms, block)
+        if kind == PROBE_STATE:
+            state, count = struct.unpack("<BB", payload)
+            return {PROBE_ARMED: "probe armed", PROBE_STOPPED: "probe stopped",
+                    PROBE_BEGIN: "probe begin %d" % count, PROBE_END: "probe end"}.get(state, "probe state %d" % state)
+        if kind == PROBE_TAP:
+            tap, frames, rate = struct.unpack_from("<B3xII", payload)
+            return "probe tap %d %u %u %s" % (tap, frames, rate, name(payload, 12))
+        if kind == PROBE_DATA:
+            tap, first = struct.unpack_from("<B3xI", payload)
+            return "probe data %d %u (%d samples)" % (tap, first, (len(payload) - 8) // 4)
+        if kind == NULL_TEST:
+            peak, signal, error, samples = struct.unpack("<fffI", payload)
+            if samples == 0:
+                return "null test  nothing compared: is the stage running?"
+            if error == 0:
+                return "null test  bit-exact over %u samples" % samples
+            snr = 10 * math.log10(signal / error) if signal > 0 else 0.0
+            return "null test  peak difference %.1f dBFS  snr %.1f dB  over %u samples" % (
+                20 * math.log10(peak), snr, samples)
+        if kind == DROPPED:
+            return "telemetry dropped %u records" % struct.unpack("<I", payload)
+    except struct.error:
+        return "record %d: bad length %d" % (kind, len(payload))
+    return "record %d: %s" % (kind, payload.hex())
+
+
+def chunks(args):
+    """The stream, in whatever pieces it arrives"""
+    if args.file:
+        with open(args.file, "rb") if args.file != "-" else sys.stdin.buffer as f:
+            while True:
+                data = f.read(4096)
+                if not data:
+                    return
+                yield data
+    import serial
+
+    with serial.Serial(args.port, timeout=0.1) as port:
+        while True:
+            data = port.read(4096)
+            if data:
+                yield data
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("port", nargs="?", help="the pedal's USB serial port")
+    parser.add_argument("--file", help="decode a capture instead (- for stdin)")
+    args = parser.parse_args()
+    if not args.port and not args.file:
+        parser.error("give a port or --file")
+
+    decoder = Decoder()
+    try:
+        for data in chunks(args):
+            for kind, payload in decoder.feed(data):
+                print(payload if kind == TEXT else describe(kind, payload), flush=True)
+    except KeyboardInterrupt:
+        pass
+    if decoder.bad:
+        print("telemetry: %d bytes skipped resynchronising" % decoder.bad, file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
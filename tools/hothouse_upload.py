@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+"""Upload a blob into a Hothouse pedal's QSPI slot over USB serial.
+
+The pedal must be built with make UPLOAD=1 and name its slots with
+Hothouse::StartUpload(); it goes on playing while the blob is written,
+a chunk per main loop pass, and checks what landed in QSPI against the
+blob's CRC-32 before the pedal may use it. Lines the pedal prints that
+aren't replies (the load meter, say) are shown as they arrive.
+
+The frames are lib/hothouse's UploadHeader and payload; see the protocol
+note in hothouse.cpp. Needs pyserial.
+
+Mars's slots: 0 = amp models (tools/mars_model_gen.py --blob), used as soon
+as the upload is good; 1 = cabinet IRs (tools/mars_ir_gen.py), used from
+the next power-up.
+
+Examples:
+  tools/hothouse_upload.py /dev/ttyACM0 0 models.bin
+  tools/hothouse_upload.py COM5 1 irs.bin
+"""
+
+import argparse
+import struct
+import sys
+import time
+import zlib
+
+import serial
+
+# hothouse.h
+UPLOAD_MAGIC = 0x50554848
+UPLOAD_CHUNK = 1024
+BEGIN, DATA, END, ABORT = 1, 2, 3, 4
+HEADER = struct.Struct("<IHHII")
+
+RETRIES = 3
+# The longest reply: a chunk that starts a sector waits for its erase
+REPLY_TIMEOUT = 2.0
+
+
+def frame(kind, seq=0, payload=b""):
+    return HEADER.pack(UPLOAD_MAGIC, kind, len(payload), seq, zlib.crc32(payload)) + payload
+
+
+def reply(port, seq):
+    """The pedal's "upload ok|error <seq> ..." for seq, or None on timeout."""
+    deadline = time.monotonic() + REPLY_TIMEOUT
+    while time.monotonic() < deadline:
+        line = port.readline().decode(errors="replace").strip()
+        if not line:
+            continue
+        words = line.split()
+        if len(words) >= 3 and words[0] == "upload" and words[2] == str(seq):
+            return words[1:]
+        print(line)
+    return None
+
+
+def send(port, kind, seq=0, payload=b""):
+    """Sends a frame until the pedal takes it; exits on a hard error."""
+    for _ in range(RETRIES):
+        port.write(frame(kind, seq, payload))
+        answer = reply(port, seq)
+        if answer is None:
+            continue  # Sent again: the pedal acknowledges a repeat
+        if answer[0] == "ok":
+            return
+        why = answer[2] if len(answer) > 2 else "?"
+        if why != "crc":
+            if kind not in (BEGIN, ABORT):
+                port.write(frame(ABORT))
+            sys.exit("pedal: %s" % why)
+    if kind != ABORT:
+        port.write(frame(ABORT))
+    sys.exit("pedal: no reply")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("port", help="the pedal's USB serial port")
+    parser.add_argument("slot", type=int, help="slot index, as the pedal numbers them")
+    parser.add_argument("blob")
+    args = parser.parse_args()
+
+    with open(args.blob, "rb") as f:
+        blob = f.read()
+    if not blob:
+        sys.exit("%s is empty" % args.blob)
+
+    with serial.Serial(args.port, timeout=0.1) as port:
+        port.reset_input_buffer()
+        send(port, BEGIN, 0, struct.pack("<III", args.slot, len(blob), zlib.crc32(blob)))
+        chunks = (len(blob) + UPLOAD_CHUNK - 1) // UPLOAD_CHUNK
+        start = time.monotonic()
+        for seq in range(chunks):
+            send(port, DATA, seq, blob[seq * UPLOAD_CHUNK:(seq + 1) * UPLOAD_CHUNK])
+            print("\r%d / %d KB" % ((seq + 1) * UPLOAD_CHUNK // 1024, chunks * UPLOAD_CHUNK // 1024), end="", flush=True)
+        print()
+        send(port, END)
+        print("%d bytes into slot %d in %.1f s, verified" % (len(blob), args.slot, time.monotonic() - start))
+
+
+if __name__ == "__main__":
+    main()
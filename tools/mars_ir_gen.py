@@ -0,0 +1,203 @@
+#!/usr/bin/env python3
+"""Write a Mars cabinet IR bank for QSPI (mars-hothouse/src/ir_qspi_bank.h).
+
+The pedal reads it at boot in place of ir_data.h's IRs: entry i is the cab
+TOGGLESWITCH_2 position i picks, and a bank may hold one to three. Load it
+with make program-irs, or with make UPLOAD=1 firmware through
+tools/hothouse_upload.py (slot 1) and a power cycle.
+
+Inputs, in bank order:
+
+  ir.wav               A PCM WAV (16, 24 or 32-bit); the first channel is
+                       used. It should be 48 kHz, as the pedal runs: other
+                       rates are written as they are, with a warning.
+
+  --from-header FILE   An ir_data.h: its ir_collection, in order.
+
+Each IR then goes through the pedal's preprocessing (ImpulseResponse/
+ir_prep.h), so the bank holds only the taps the convolver needs:
+
+  --min-phase          Convert to minimum phase: the same magnitude response
+                       with the energy as early as it goes, so the tail cut
+                       comes sooner. Any length; the pedal only converts IRs
+                       of up to 2048 samples itself (make IR_MIN_PHASE=1).
+
+  --tail-db DB         Cut each IR where the energy left after it is DB below
+                       its total, with a short fade-out (default -60, as the
+                       pedal does at boot; 0 keeps every sample).
+
+  --max-length N       Samples kept per IR before either step (default 8192,
+                       as many as the pedal prepares; 0 keeps everything).
+
+Examples:
+  tools/mars_ir_gen.py --from-header ImpulseResponse/ir_data.h -o irs.bin
+  tools/mars_ir_gen.py v30_sm57.wav greenback.wav -o irs.bin
+  tools/mars_ir_gen.py --min-phase --tail-db -70 v30_sm57.wav -o irs.bin
+"""
+
+import argparse
+import cmath
+import math
+import re
+import struct
+import sys
+import wave
+
+# ir_qspi_bank.h / model_qspi_bank.h
+QSPI_IR_BANK_MAGIC = 0x5249524D
+QSPI_IR_BANK_VERSION = 1
+HEADER = struct.Struct("<6I")
+ENTRY = struct.Struct("<II24s")
+MAX_IRS = 3
+MAX_LENGTH = 8192
+# ir_prep.h
+PREP_FLOOR = 1e-6
+TRUNCATE_FADE = 64
+
+
+def load_wav(path):
+    with wave.open(path, "rb") as w:
+        channels, width, rate, frames = w.getnchannels(), w.getsampwidth(), w.getframerate(), w.getnframes()
+        data = w.readframes(frames)
+    if width not in (2, 3, 4):
+        sys.exit("%s: %d-bit samples, need 16, 24 or 32-bit PCM" % (path, 8 * width))
+    if rate != 48000:
+        print("%s: %d Hz, not resampled to 48 kHz" % (path, rate), file=sys.stderr)
+    scale = float(1 << (8 * width - 1))
+    samples = []
+    for i in range(frames):
+        frame = data[i * channels * width:(i * channels + 1) * width]
+        samples.append(int.from_bytes(frame, "little", signed=True) / scale)
+    return samples
+
+
+def load_header(path):
+    with open(path) as f:
+        text = re.sub(r"//[^\n]*", "", f.read())
+    vectors = dict(re.findall(r"(?:const float|std::vector<float>)\s+(\w+)\s*(?:\[\s*\])?\s*=\s*\{([^}]*)\}", text))
+    collection = re.search(r"ir_collection\s*=\s*\{([^}]*)\}", text)
+    if not collection:
+        sys.exit("%s: no ir_collection" % path)
+    irs = []
+    for name in re.findall(r"\w+", collection.group(1)):
+        if name not in vectors:
+            sys.exit("%s: ir_collection names %s, which isn't defined" % (path, name))
+        irs.append((name, [float(v) for v in vectors[name].replace("f", "").split(",") if v.strip()]))
+    return irs
+
+
+def fft(x, inverse=False):
+    """Radix-2 complex FFT; len(x) a power of two. The inverse is scaled."""
+    n = len(x)
+    a = list(x)
+    j = 0
+    for i in range(1, n):
+        bit = n >> 1
+        while j & bit:
+            j ^= bit
+            bit >>= 1
+        j |= bit
+        if i < j:
+            a[i], a[j] = a[j], a[i]
+    size = 2
+    while size <= n:
+        half = size // 2
+        twiddles = [cmath.exp((1 if inverse else -1) * 2j * math.pi * k / size) for k in range(half)]
+        for start in range(0, n, size):
+            for k in range(half):
+                u = a[start + k]
+                v = a[start + k + half] * twiddles[k]
+                a[start + k] = u + v
+                a[start + k + half] = u - v
+        size *= 2
+    return [v / n for v in a] if inverse else a
+
+
+def minimum_phase(samples):
+    """Real cepstrum method, as IrMinimumPhase(): padded to 8x."""
+    n = 1024
+    while n < 8 * len(samples):
+        n *= 2
+    spectrum = fft(samples + [0.0] * (n - len(samples)))
+    floor = max(max(abs(v) for v in spectrum) * PREP_FLOOR, 1e-30)
+    cepstrum = fft([math.log(max(abs(v), floor)) for v in spectrum], True)
+    folded = [cepstrum[0].real] + [2 * v.real for v in cepstrum[1:n // 2]] + [cepstrum[n // 2].real] + [0.0] * (n // 2 - 1)
+    result = fft([cmath.exp(v) for v in fft(folded)], True)
+    return [v.real for v in result[:len(samples)]]
+
+
+def effective_length(samples, tail_db):
+    """As IrEffectiveLength(): the taps after it hold at most tail_db of the energy."""
+    if tail_db >= 0:
+        return len(samples)
+    limit = sum(v * v for v in samples) * 10 ** (tail_db / 10)
+    tail = 0.0
+    n = len(samples)
+    while n > 1 and tail + samples[n - 1] ** 2 <= limit:
+        tail += samples[n - 1] ** 2
+        n -= 1
+    return n
+
+
+def truncate(samples, length):
+    """As IrTruncate(): a half-cosine fade over the last taps kept."""
+    if length >= len(samples):
+        return samples
+    samples = samples[:length]
+    fade = min(TRUNCATE_FADE, length // 4)
+    for i in range(fade):
+        samples[length - 1 - i] *= 0.5 - 0.5 * math.cos(math.pi * (i + 1) / (fade + 1))
+    return samples
+
+
+def emit_blob(irs):
+    directory = []
+    data = b""
+    data_start = HEADER.size + ENTRY.size * len(irs)
+    for name, samples in irs:
+        directory.append(ENTRY.pack(data_start + len(data), len(samples), name.encode()[:24]))
+        data += struct.pack("<%df" % len(samples), *samples)
+    body = b"".join(directory) + data
+    hash = 2166136261
+    for byte in body:
+        hash = ((hash ^ byte) * 16777619) & 0xFFFFFFFF
+    header = HEADER.pack(QSPI_IR_BANK_MAGIC, QSPI_IR_BANK_VERSION, len(irs), HEADER.size + len(body), hash, 0)
+    return header + body
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("irs", nargs="*", help="ir.wav")
+    parser.add_argument("--from-header", help="ir_data.h")
+    parser.add_argument("--min-phase", action="store_true", help="convert each IR to minimum phase")
+    parser.add_argument("--tail-db", type=float, default=-60.0, help="cut the tail below this energy (0 = keep it)")
+    parser.add_argument("--max-length", type=int, default=MAX_LENGTH, help="samples kept per IR (0 = all)")
+    parser.add_argument("-o", "--output", default="irs.bin")
+    args = parser.parse_args()
+
+    irs = load_header(args.from_header) if args.from_header else []
+    for path in args.irs:
+        irs.append((path.split("/")[-1], load_wav(path)))
+    if not irs:
+        parser.error("no IRs given")
+    if len(irs) > MAX_IRS:
+        parser.error("%d IRs: TOGGLESWITCH_2 picks from %d" % (len(irs), MAX_IRS))
+    if args.max_length > 0:
+        irs = [(name, samples[:args.max_length]) for name, samples in irs]
+    prepared = []
+    for name, samples in irs:
+        if not samples:
+            sys.exit("%s: no samples" % name)
+        if args.min_phase:
+            samples = minimum_phase(samples)
+        kept = effective_length(samples, args.tail_db)
+        print("%s: %d of %d samples" % (name, kept, len(samples)), file=sys.stderr)
+        prepared.append((name, truncate(samples, kept)))
+    irs = prepared
+
+    with open(args.output, "wb") as f:
+        f.write(emit_blob(irs))
+
+
+if __name__ == "__main__":
+    main()
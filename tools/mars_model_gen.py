@@ -0,0 +1,392 @@
+#!/usr/bin/env python3
+"""Generate the Mars flash-resident amp model bank (model_bank.h).
+
+Each model becomes one static const GruModelWeights<H> entry (see
+mars-hothouse/src/model_weights.h), already laid out the way RTNeural's
+GRULayerT<float,1,H> / DenseT<float,H,1> flat setters read it, so the pedal
+never builds std::vectors at boot.
+
+Inputs, in bank order (TOGGLESWITCH_1 picks entries 1..3):
+
+  model.json[@level[@rate]]
+                       GuitarML / NeuralSeed training output. The PyTorch
+                       state_dict is transposed and its r/z gates swapped to
+                       RTNeural's z/r/h order, matching torch_helpers loadGRU.
+                       Optional @level sets levelAdjust (default 1.0), and
+                       @rate the ModelRate the pedal runs it at: native (the
+                       default), half (trained at 24 kHz) or double (a
+                       48 kHz capture oversampled to 96 kHz).
+                       A model trained with input_size 2 (audio, then the
+                       gain knob) is a conditioned model: the knob's column
+                       of weight_ih goes to gruCondition, and the pedal
+                       feeds it the knob instead of pre-gaining the input.
+
+  --from-header FILE   The legacy all_model_data_gru9_4count.h. Its vectors
+                       are already in RTNeural order and copied verbatim,
+                       in model_collection order. Commented-out models are
+                       ignored.
+
+  --from-bank FILE     A model_bank.h previously written by this script
+                       (float or Q15), e.g. to re-quantize or append models.
+                       Give it more than once to combine banks.
+
+  --q15                Emit GruModelWeightsQ15 entries: int16 weights with
+                       one float scale per gate row of H values, ~60% of the flash.
+
+  --blob               Write a QSPI bank (mars-hothouse/src/model_qspi_bank.h)
+                       instead of a header, for make program-models. Hidden
+                       sizes may be mixed: entry i of each size is amp i, as in
+                       the per-size banks. Weights stay float.
+
+Examples:
+  tools/mars_model_gen.py --from-header all_model_data_gru9_4count.h -o model_bank.h
+  tools/mars_model_gen.py fender57.json@0.9 klon.json@0.7 -o model_bank.h
+  tools/mars_model_gen.py plexi_gru16_24k.json@0.8@half -o model_bank_gru16.h
+  tools/mars_model_gen.py --q15 --from-bank model_bank.h -o model_bank.h
+  tools/mars_model_gen.py --blob --from-bank model_bank.h --from-bank model_bank_gru16.h -o models.bin
+"""
+
+import argparse
+import json
+import re
+import struct
+import sys
+
+FIELDS = ("gruKernel", "gruRecurrent", "gruBias", "denseWeights", "denseBias")
+
+# ModelRate in model_weights.h
+RATES = {"native": "MODEL_RATE_NATIVE", "half": "MODEL_RATE_HALF", "double": "MODEL_RATE_DOUBLE"}
+
+
+def strip_comments(text):
+    text = re.sub(r"/\*.*?\*/", "", text, flags=re.S)
+    return re.sub(r"//[^\n]*", "", text)
+
+
+def flatten(value):
+    if isinstance(value, list):
+        out = []
+        for v in value:
+            out.extend(flatten(v))
+        return out
+    return [float(value)]
+
+
+def parse_braces(literal):
+    """C++ brace initialiser -> nested lists of floats."""
+    return json.loads(literal.replace("{", "[").replace("}", "]"))
+
+
+def swap_rz(row, hidden):
+    """PyTorch gate order r|z|n -> RTNeural z|r|h."""
+    return row[hidden:2 * hidden] + row[:hidden] + row[2 * hidden:]
+
+
+def transpose(mat):
+    return [list(col) for col in zip(*mat)]
+
+
+def load_json(path, level, rate):
+    with open(path) as f:
+        data = json.load(f)
+    sd = data["state_dict"]
+    hidden = int(data.get("model_data", {}).get("hidden_size", len(sd["rec.weight_hh_l0"][0])))
+    w_ih = [swap_rz(r, hidden) for r in transpose(sd["rec.weight_ih_l0"])]
+    if len(w_ih) > 2:
+        sys.exit("%s: %d inputs, Mars models take audio and at most one knob" % (path, len(w_ih)))
+    w_hh = [swap_rz(r, hidden) for r in transpose(sd["rec.weight_hh_l0"])]
+    bias = [swap_rz(sd["rec.bias_ih_l0"], hidden), swap_rz(sd["rec.bias_hh_l0"], hidden)]
+    return {
+        "name": path,
+        "hidden": hidden,
+        "gruKernel": flatten(w_ih[0]),
+        "gruRecurrent": flatten(w_hh),
+        "gruBias": flatten(bias),
+        "denseWeights": flatten(sd["lin.weight"]),
+        "denseBias": flatten(sd["lin.bias"]),
+        "levelAdjust": level,
+        "rate": rate,
+        "gruCondition": flatten(w_ih[1]) if len(w_ih) > 1 else [0.0] * 3 * hidden,
+    }
+
+
+def load_header(path):
+    with open(path) as f:
+        text = strip_comments(f.read())
+
+    legacy = {
+        "rec_weight_ih_l0": "gruKernel",
+        "rec_weight_hh_l0": "gruRecurrent",
+        "rec_bias": "gruBias",
+        "lin_weight": "denseWeights",
+        "lin_bias": "denseBias",
+    }
+    models = {}
+    for name, field, value in re.findall(r"(\w+)\.(\w+)\s*=\s*([^;]+);", text):
+        entry = models.setdefault(name, {"name": name})
+        if field == "levelAdjust":
+            entry["levelAdjust"] = float(value)
+        elif field in legacy:
+            entry[legacy[field]] = flatten(parse_braces(value))
+
+    order = re.search(r"model_collection\s*=\s*\{([^}]*)\}", text)
+    names = [n.strip() for n in order.group(1).split(",") if n.strip()] if order else list(models)
+    bank = []
+    for name in names:
+        m = models[name]
+        m["hidden"] = len(m["denseWeights"])
+        bank.append(m)
+    return bank
+
+
+ROWS = {
+    "gruKernel": lambda h: 3,
+    "gruRecurrent": lambda h: 3 * h,
+    "gruBias": lambda h: 6,
+    "denseWeights": lambda h: 1,
+    "gruCondition": lambda h: 3,
+}
+
+
+def load_bank(path):
+    with open(path) as f:
+        text = f.read()
+    q15 = "GruModelWeightsQ15" in text
+    body = text[text.index("model_bank[] = {") + len("model_bank[] = {"):text.rindex("};")]
+    bank = []
+    for chunk in re.split(r"\n  // ", body)[1:]:
+        name, _, rest = chunk.partition("\n")
+        arrays = [flatten(parse_braces("[" + a.replace("f", "") + "]"))
+                  for a in re.findall(r"\{([^{}]*)\}", rest)]
+        scalars = [float(v.rstrip("f")) for v in re.findall(r"^    (-?[\d.e+-]+f),$", rest, flags=re.M)]
+        model = {"name": name.strip()}
+        if q15:
+            # 4 int16 arrays, their 4 scale arrays, dense bias, levelAdjust
+            # (then, for a conditioned model, gruCondition and its scales)
+            ints, scales, dense_bias = arrays[:4], arrays[4:8], arrays[8]
+            if len(arrays) > 10:
+                ints, scales = ints + [arrays[9]], scales + [arrays[10]]
+            for field, q, sc in zip(FIELDS[:4] + ("gruCondition",), ints, scales):
+                cols = len(q) // len(sc)
+                model[field] = [v * sc[i // cols] for i, v in enumerate(q)]
+            model["denseBias"] = dense_bias
+        else:
+            for field, values in zip(FIELDS + ("gruCondition",), arrays):
+                model[field] = values
+        model["levelAdjust"] = scalars[-1]
+        rate = re.search(r"^    (MODEL_RATE_\w+),$", rest, flags=re.M)
+        model["rate"] = rate.group(1) if rate else RATES["native"]
+        model["hidden"] = len(model["denseWeights"])
+        model.setdefault("gruCondition", [0.0] * 3 * model["hidden"])
+        bank.append(model)
+    return bank
+
+
+def quantize(values, rows):
+    cols = len(values) // rows
+    q, scales = [], []
+    for r in range(rows):
+        row = values[r * cols:(r + 1) * cols]
+        peak = max(abs(v) for v in row)
+        scale = peak / 32767.0 if peak > 0 else 1.0
+        scales.append(scale)
+        q.extend(max(-32767, min(32767, int(round(v / scale)))) for v in row)
+    return q, scales
+
+
+def check(model):
+    h = model["hidden"]
+    sizes = {
+        "gruKernel": 3 * h,
+        "gruRecurrent": h * 3 * h,
+        "gruBias": 2 * 3 * h,
+        "denseWeights": h,
+        "denseBias": 1,
+        "gruCondition": 3 * h,
+    }
+    model.setdefault("gruCondition", [0.0] * 3 * h)
+    for field, size in sizes.items():
+        if len(model[field]) != size:
+            sys.exit("%s: %s has %d values, expected %d" % (model["name"], field, len(model[field]), size))
+
+
+def c_float(v):
+    """A float literal C++ accepts: %.9g, with a point if it has none."""
+    text = "%.9g" % v
+    return text + ("f" if any(c in text for c in ".en") else ".0f")
+
+
+def emit_array(values, indent, per_line=6):
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append(indent + ", ".join(c_float(v) for v in values[i:i + per_line]))
+    return ",\n".join(lines)
+
+
+def emit_ints(values, indent, per_line=12):
+    return ",\n".join(indent + ", ".join("%d" % v for v in values[i:i + per_line])
+                      for i in range(0, len(values), per_line))
+
+
+def emit_entry_float(model, out):
+    for field in FIELDS:
+        out.append("    {")
+        out.append(emit_array(model[field], "      "))
+        out.append("    },")
+
+
+def emit_entry_q15(model, out):
+    h = model["hidden"]
+    scales = []
+    for field in FIELDS[:4]:
+        q, sc = quantize(model[field], ROWS[field](h))
+        scales.append(sc)
+        out.append("    {")
+        out.append(emit_ints(q, "      "))
+        out.append("    },")
+    for sc in scales:
+        out.append("    {")
+        out.append(emit_array(sc, "      "))
+        out.append("    },")
+    out.append("    {")
+    out.append(emit_array(model["denseBias"], "      "))
+    out.append("    },")
+
+
+def emit_condition(model, out, q15):
+    """gruCondition, after the rate; a snapshot model leaves it to zero-fill."""
+    out.append("    {")
+    if q15:
+        q, sc = quantize(model["gruCondition"], ROWS["gruCondition"](model["hidden"]))
+        out.append(emit_ints(q, "      "))
+        out.append("    },")
+        out.append("    {")
+        out.append(emit_array(sc, "      "))
+    else:
+        out.append(emit_array(model["gruCondition"], "      "))
+    out.append("    },")
+
+
+def emit(bank, source, q15=False):
+    hidden = bank[0]["hidden"]
+    weights_type = "GruModelWeightsQ15" if q15 else "GruModelWeights"
+    out = [
+        "// model_bank.h",
+        "//",
+        "// Generated by tools/mars_model_gen.py from %s - do not edit by hand." % source,
+        "// One entry per amp, stored in flash; loadModelWeights() copies an",
+        "// entry into a model slot.",
+        "",
+        "#pragma once",
+        "",
+        '#include "model_weights.h"',
+        "",
+        "static const %s<%d> model_bank[] = {" % (weights_type, hidden),
+    ]
+    for model in bank:
+        check(model)
+        if model["hidden"] != hidden:
+            sys.exit("%s: hidden size %d, bank uses %d" % (model["name"], model["hidden"], hidden))
+        out.append("  // %s" % model["name"])
+        out.append("  {")
+        if q15:
+            emit_entry_q15(model, out)
+        else:
+            emit_entry_float(model, out)
+        out.append("    %s," % c_float(model.get("levelAdjust", 1.0)))
+        out.append("    %s," % model.get("rate", RATES["native"]))
+        if any(model["gruCondition"]):
+            emit_condition(model, out, q15)
+        out.append("  },")
+    out.append("};")
+    out.append("")
+    out.append("static constexpr int model_bank_size = sizeof(model_bank) / sizeof(model_bank[0]);")
+    out.append("")
+    return "\n".join(out)
+
+
+# QspiBankHeader / QspiBankEntry in model_qspi_bank.h
+QSPI_BANK_MAGIC = 0x4B42524D
+QSPI_BANK_VERSION = 2
+HEADER = struct.Struct("<6I")
+ENTRY = struct.Struct("<iiII16s")
+RATE_VALUES = {name: i for i, name in enumerate(("MODEL_RATE_NATIVE", "MODEL_RATE_HALF", "MODEL_RATE_DOUBLE"))}
+
+
+def pack_weights(model):
+    """One GruModelWeights<H> as the struct lays it out: floats, the rate,
+    gruCondition, padding to RTNEURAL_DEFAULT_ALIGNMENT (8, as Mars builds)."""
+    values = []
+    for field in FIELDS:
+        values += model[field]
+    values.append(model.get("levelAdjust", 1.0))
+    data = struct.pack("<%df" % len(values), *values)
+    data += struct.pack("<i", RATE_VALUES[model.get("rate", RATES["native"])])
+    data += struct.pack("<%df" % len(model["gruCondition"]), *model["gruCondition"])
+    return data + b"\0" * (-len(data) % 8)
+
+
+def emit_blob(bank):
+    directory = []
+    data = b""
+    data_start = HEADER.size + ENTRY.size * len(bank)
+    amps = {}
+    for model in bank:
+        check(model)
+        h = model["hidden"]
+        if h not in (6, 9, 12, 16):
+            sys.exit("%s: hidden size %d has no Mars tier" % (model["name"], h))
+        amp = amps.get(h, 0)
+        amps[h] = amp + 1
+        weights = pack_weights(model)
+        name = model["name"].split("/")[-1].encode()[:16]
+        directory.append(ENTRY.pack(amp, h, data_start + len(data), len(weights), name))
+        data += weights
+    body = b"".join(directory) + data
+    hash = 2166136261
+    for byte in body:
+        hash = ((hash ^ byte) * 16777619) & 0xFFFFFFFF
+    header = HEADER.pack(QSPI_BANK_MAGIC, QSPI_BANK_VERSION, len(bank), HEADER.size + len(body), hash, 0)
+    return header + body
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("models", nargs="*", help="model.json[@levelAdjust[@rate]]")
+    parser.add_argument("--from-header", help="legacy all_model_data header")
+    parser.add_argument("--from-bank", action="append", default=[], help="existing model_bank.h")
+    parser.add_argument("--q15", action="store_true", help="emit int16 weights with per-row scales")
+    parser.add_argument("--blob", action="store_true", help="write a QSPI bank instead of a header")
+    parser.add_argument("-o", "--output", default="model_bank.h")
+    args = parser.parse_args()
+
+    bank = []
+    sources = []
+    for path in args.from_bank:
+        bank += load_bank(path)
+        sources.append(path.split("/")[-1])
+    if args.from_header:
+        bank += load_header(args.from_header)
+        sources.append(args.from_header.split("/")[-1])
+    for spec in args.models:
+        path, _, options = spec.partition("@")
+        level, _, rate = options.partition("@")
+        if rate and rate not in RATES:
+            parser.error("%s: rate must be one of %s" % (spec, ", ".join(RATES)))
+        bank.append(load_json(path, float(level) if level else 1.0, RATES[rate or "native"]))
+        sources.append(path.split("/")[-1])
+    if not bank:
+        parser.error("no models given")
+
+    if args.blob:
+        if args.q15:
+            parser.error("--blob banks are float only")
+        with open(args.output, "wb") as f:
+            f.write(emit_blob(bank))
+        return
+    with open(args.output, "w") as f:
+        f.write(emit(bank, ", ".join(sources), args.q15))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,184 @@
+#!/usr/bin/env python3
+"""Generate a Mars TCN model bank (tcn_bank.h).
+
+Each model becomes one static const TcnModelWeights<C,K,L> entry (see
+mars-hothouse/src/tcn_model.h), laid out the way TcnModelT::Load() copies
+it: conv weights as [out][tap][in] with the newest tap last, 1x1 weights as
+[out][in]. All models in a bank must share channels, kernel and dilations,
+since those are template parameters of the model that loads them.
+
+Input, in bank order:
+
+  model.json[@level]   A dilated causal Conv1D stack exported from PyTorch:
+
+                         {"architecture": "tcn",
+                          "config": {"channels": C, "kernel_size": K,
+                                     "dilations": [1, 2, 4, ...]},
+                          "state_dict": {
+                            "input.weight": [C][1][1], "input.bias": [C],
+                            "layers.<i>.conv.weight": [C][C][K],
+                            "layers.<i>.conv.bias": [C],
+                            "layers.<i>.mix.weight": [C][C][1],
+                            "layers.<i>.mix.bias": [C],
+                            "head.weight": [1][C][1], "head.bias": [1]}}
+
+                       Conv1d weights are PyTorch's [out][in][tap]. This is
+                       not a .nam file: NAM's WaveNet has gated layers and
+                       two layer arrays, so re-export a nano-sized capture
+                       in this shape first. Optional @level sets levelAdjust
+                       (default 1.0).
+
+Example:
+  tools/mars_tcn_gen.py nano_plexi.json@0.8 nano_jcm.json -o tcn_bank.h
+"""
+
+import argparse
+import json
+import sys
+
+
+def flatten(value):
+    if isinstance(value, list):
+        out = []
+        for v in value:
+            out.extend(flatten(v))
+        return out
+    return [float(value)]
+
+
+def conv_taps(weight):
+    """PyTorch Conv1d [out][in][tap] -> [out][tap][in]."""
+    return [[[w_in[k] for w_in in w_out] for k in range(len(w_out[0]))] for w_out in weight]
+
+
+def load_json(path, level):
+    with open(path) as f:
+        data = json.load(f)
+    if data.get("architecture") != "tcn":
+        sys.exit("%s: architecture is %r, expected \"tcn\"" % (path, data.get("architecture")))
+    config = data["config"]
+    sd = data["state_dict"]
+    channels = int(config["channels"])
+    kernel = int(config["kernel_size"])
+    dilations = [int(d) for d in config["dilations"]]
+    layers = []
+    for i in range(len(dilations)):
+        prefix = "layers.%d." % i
+        layers.append({
+            "conv": flatten(conv_taps(sd[prefix + "conv.weight"])),
+            "convBias": flatten(sd[prefix + "conv.bias"]),
+            "mix": flatten(sd[prefix + "mix.weight"]),
+            "mixBias": flatten(sd[prefix + "mix.bias"]),
+        })
+    return {
+        "name": path,
+        "channels": channels,
+        "kernel": kernel,
+        "dilations": dilations,
+        "inputWeights": flatten(sd["input.weight"]),
+        "inputBias": flatten(sd["input.bias"]),
+        "layers": layers,
+        "headWeights": flatten(sd["head.weight"]),
+        "headBias": flatten(sd["head.bias"]),
+        "levelAdjust": level,
+    }
+
+
+def check(model):
+    c, k = model["channels"], model["kernel"]
+    sizes = [
+        ("inputWeights", model["inputWeights"], c),
+        ("inputBias", model["inputBias"], c),
+        ("headWeights", model["headWeights"], c),
+        ("headBias", model["headBias"], 1),
+    ]
+    for i, layer in enumerate(model["layers"]):
+        sizes += [
+            ("layers.%d.conv" % i, layer["conv"], c * k * c),
+            ("layers.%d.convBias" % i, layer["convBias"], c),
+            ("layers.%d.mix" % i, layer["mix"], c * c),
+            ("layers.%d.mixBias" % i, layer["mixBias"], c),
+        ]
+    for field, values, size in sizes:
+        if len(values) != size:
+            sys.exit("%s: %s has %d values, expected %d" % (model["name"], field, len(values), size))
+
+
+def emit_array(values, indent, per_line=6):
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append(indent + ", ".join("%.9gf" % v for v in values[i:i + per_line]))
+    return ",\n".join(lines)
+
+
+def emit_braced(values, indent, out):
+    out.append(indent + "{")
+    out.append(emit_array(values, indent + "  "))
+    out.append(indent + "},")
+
+
+def emit(bank, source):
+    first = bank[0]
+    shape = (first["channels"], first["kernel"], first["dilations"])
+    out = [
+        "// tcn_bank.h",
+        "//",
+        "// Generated by tools/mars_tcn_gen.py from %s - do not edit by hand." % source,
+        "// One entry per amp, stored in flash; TcnModelT::Load() copies an",
+        "// entry into a model. Load them with:",
+        "//",
+        "//   TcnModelT<%d, %d, %s>" % (shape[0], shape[1], ", ".join(str(d) for d in shape[2])),
+        "",
+        "#pragma once",
+        "",
+        '#include "tcn_model.h"',
+        "",
+        "static const TcnModelWeights<%d, %d, %d> tcn_bank[] = {" % (shape[0], shape[1], len(shape[2])),
+    ]
+    for model in bank:
+        check(model)
+        if (model["channels"], model["kernel"], model["dilations"]) != shape:
+            sys.exit("%s: shape differs from %s, the first model in the bank"
+                     % (model["name"], first["name"]))
+        out.append("  // %s" % model["name"])
+        out.append("  {")
+        out.append("    {%s}," % ", ".join(str(d) for d in model["dilations"]))
+        emit_braced(model["inputWeights"], "    ", out)
+        emit_braced(model["inputBias"], "    ", out)
+        out.append("    {")
+        for layer in model["layers"]:
+            out.append("      {")
+            for field in ("conv", "convBias", "mix", "mixBias"):
+                emit_braced(layer[field], "        ", out)
+            out.append("      },")
+        out.append("    },")
+        emit_braced(model["headWeights"], "    ", out)
+        emit_braced(model["headBias"], "    ", out)
+        out.append("    %.9gf," % model.get("levelAdjust", 1.0))
+        out.append("  },")
+    out.append("};")
+    out.append("")
+    out.append("static constexpr int tcn_bank_size = sizeof(tcn_bank) / sizeof(tcn_bank[0]);")
+    out.append("")
+    return "\n".join(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("models", nargs="+", help="model.json[@levelAdjust]")
+    parser.add_argument("-o", "--output", default="tcn_bank.h")
+    args = parser.parse_args()
+
+    bank = []
+    sources = []
+    for spec in args.models:
+        path, _, level = spec.partition("@")
+        bank.append(load_json(path, float(level) if level else 1.0))
+        sources.append(path.split("/")[-1])
+
+    with open(args.output, "w") as f:
+        f.write(emit(bank, ", ".join(sources)))
+
+
+if __name__ == "__main__":
+    main()
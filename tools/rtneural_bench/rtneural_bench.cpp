@@ -0,0 +1,227 @@
+// RTNeural Bench
+// Cycles per sample of Mars's amp model and the GRU and LSTM sizes around
+// it on the Seed, for the RTNeural backend and alignment this build was made
+// with (see the Makefile), and of the TCN stacks in tcn_model.h beside them. Prints a table over USB serial; connect a serial
+// monitor to start it.
+
+#include "daisy_seed.h"
+
+#include <new>
+#include <vector>
+
+#include <RTNeural/RTNeural.h>
+
+#include "cycle_profiler.h"
+#include "model_bank.h"
+#include "tcn_model.h"
+#if !RTNEURAL_USE_EIGEN && !RTNEURAL_USE_XSIMD
+#include "model_tiers.h"  // MarsModelT: its maths provider is scalar only
+#endif
+
+using namespace daisy;
+
+#if RTNEURAL_USE_EIGEN
+#define BENCH_BACKEND "eigen"
+#elif RTNEURAL_USE_XSIMD
+#define BENCH_BACKEND "xsimd"
+#else
+#define BENCH_BACKEND "stl"
+#endif
+
+DaisySeed hw;
+
+const float kSampleRate = 48000.0f;
+const int kBlock = 48;        // forwardBlock() size, as Mars's callback runs it
+const int kIterations = 200;  // blocks per measurement, after one to warm up
+
+// A guitar-ish test signal, so the gates see realistic levels
+float testInput[kBlock];
+float testOutput[kBlock];
+
+// Weights for the sizes without a trained bank: small and fixed, so every
+// build times the same maths
+float NextWeight()
+{
+    static uint32_t state = 12345;
+    state = state * 1664525u + 1013904223u;
+    return ((float)(state >> 8) / 16777216.0f - 0.5f) * 0.6f;
+}
+
+std::vector<std::vector<float>> Weights(int rows, int cols)
+{
+    std::vector<std::vector<float>> w(rows, std::vector<float>(cols));
+    for (auto& row : w) {
+        for (auto& v : row) {
+            v = NextWeight();
+        }
+    }
+    return w;
+}
+
+template <typename Model, int H>
+void LoadGru(Model& model)
+{
+    auto& gru = model.template get<0>();
+    gru.setWVals(Weights(1, 3 * H));
+    gru.setUVals(Weights(H, 3 * H));
+    gru.setBVals(Weights(2, 3 * H));
+    auto& dense = model.template get<1>();
+    dense.setWeights(Weights(1, H));
+    const float bias = 0.0f;
+    dense.setBias(&bias);
+    model.reset();
+}
+
+template <typename Model, int H>
+void LoadLstm(Model& model)
+{
+    auto& lstm = model.template get<0>();
+    lstm.setWVals(Weights(1, 4 * H));
+    lstm.setUVals(Weights(H, 4 * H));
+    lstm.setBVals(Weights(1, 4 * H)[0]);
+    auto& dense = model.template get<1>();
+    dense.setWeights(Weights(1, H));
+    const float bias = 0.0f;
+    dense.setBias(&bias);
+    model.reset();
+}
+
+// Every weight pseudo-random, then the dilations the model was built for
+template <typename Model, int... Dilations>
+void LoadTcn(Model& model)
+{
+    static typename Model::Weights weights;
+    const int dilations[] = {Dilations...};
+    for (int l = 0; l < Model::num_layers; l++) {
+        weights.dilations[l] = dilations[l];
+    }
+    float* values = weights.inputWeights;
+    float* end = &weights.levelAdjust;
+    for (float* v = values; v < end; v++) {
+        *v = NextWeight();
+    }
+    model.Load(weights);
+}
+
+typedef TcnModelT<8, 3, 1, 2, 4, 8, 16, 32, 64, 128, 256> Tcn8;
+
+template <int H>
+using GruModel = RTNeural::ModelT<float, 1, 1, RTNeural::GRULayerT<float, 1, H>,
+                                  RTNeural::DenseT<float, H, 1>>;
+template <int H>
+using LstmModel = RTNeural::ModelT<float, 1, 1, RTNeural::LSTMLayerT<float, 1, H>,
+                                   RTNeural::DenseT<float, H, 1>>;
+
+// Average cycles per sample of forwardBlock() over kBlock samples, in tenths
+template <typename Model>
+uint32_t CyclesPerSample(Model& model)
+{
+    model.forwardBlock(testInput, testOutput, kBlock);
+    uint64_t total = 0;
+    for (int i = 0; i < kIterations; i++) {
+        uint32_t start = cycleCount();
+        model.forwardBlock(testInput, testOutput, kBlock);
+        total += cycleCount() - start;
+    }
+    return (uint32_t)(total * 10 / ((uint64_t)kIterations * kBlock));
+}
+
+struct Row
+{
+    const char* model;
+    uint32_t cycles;  // tenths
+    const char* note;
+};
+
+const int kMaxRows = 14;
+Row rows[kMaxRows];
+int numRows = 0;
+
+// Built one at a time in this union, so only the largest costs RAM
+union Models
+{
+    Models() {}
+    ~Models() {}
+    GruModel<9> mars;
+#if !RTNEURAL_USE_EIGEN && !RTNEURAL_USE_XSIMD
+    MarsModelT<9> marsShipped;
+#endif
+    GruModel<8> gru8;
+    GruModel<12> gru12;
+    GruModel<16> gru16;
+    LstmModel<8> lstm8;
+    LstmModel<12> lstm12;
+    LstmModel<16> lstm16;
+    TcnNanoT tcnNano;
+    Tcn8 tcn8;
+};
+Models models;
+
+template <typename Model, typename Load>
+void Measure(Model& slot, Load&& load, const char* name, const char* note = "")
+{
+    Model* model = new (&slot) Model();
+    load(*model);
+    rows[numRows++] = {name, CyclesPerSample(*model), note};
+    model->~Model();
+}
+
+void RunBenchmarks()
+{
+    Measure(models.mars, [](GruModel<9>& m) { loadModelWeights(m, model_bank[0]); },
+            "GRU 9 + dense (Mars)", "amp 1's weights, default maths");
+#if !RTNEURAL_USE_EIGEN && !RTNEURAL_USE_XSIMD
+    Measure(models.marsShipped, [](MarsModelT<9>& m) { loadModelWeights(m, model_bank[0]); },
+            "GRU 9 + dense (MarsModelT)", "as the firmware runs it: MarsMaths");
+#endif
+    Measure(models.gru8, LoadGru<GruModel<8>, 8>, "GRU 8 + dense");
+    Measure(models.gru12, LoadGru<GruModel<12>, 12>, "GRU 12 + dense");
+    Measure(models.gru16, LoadGru<GruModel<16>, 16>, "GRU 16 + dense");
+    Measure(models.lstm8, LoadLstm<LstmModel<8>, 8>, "LSTM 8 + dense");
+    Measure(models.lstm12, LoadLstm<LstmModel<12>, 12>, "LSTM 12 + dense");
+    Measure(models.lstm16, LoadLstm<LstmModel<16>, 16>, "LSTM 16 + dense");
+    Measure(models.tcnNano, LoadTcn<TcnNanoT, 1, 2, 4, 8, 16, 32, 64, 128, 256, 512>,
+            "TCN 4ch k3, 10 layers", "2047-sample receptive field");
+    Measure(models.tcn8, LoadTcn<Tcn8, 1, 2, 4, 8, 16, 32, 64, 128, 256>,
+            "TCN 8ch k3, 9 layers", "1023-sample receptive field");
+}
+
+void PrintTable()
+{
+    const uint32_t budget = System::GetSysClkFreq() / (uint32_t)kSampleRate;
+    hw.PrintLine("RTNeural backend %s, RTNEURAL_DEFAULT_ALIGNMENT %d", BENCH_BACKEND,
+                 RTNEURAL_DEFAULT_ALIGNMENT);
+    hw.PrintLine("model                          cycles/sample  of 48k  note");
+    for (int i = 0; i < numRows; i++) {
+        const Row& row = rows[i];
+        // Share of one sample period at 48 kHz, in tenths of a percent
+        const uint32_t share = row.cycles * 100 / budget;
+        hw.PrintLine("%-30s %10lu.%lu  %3lu.%lu%%  %s", row.model,
+                     (unsigned long)(row.cycles / 10), (unsigned long)(row.cycles % 10),
+                     (unsigned long)(share / 10), (unsigned long)(share % 10), row.note);
+    }
+}
+
+int main(void)
+{
+    hw.Init(true);  // CPU boost, as Mars runs
+    hw.StartLog(true);  // wait for a serial monitor
+    enableCycleCounter();
+
+    for (int i = 0; i < kBlock; i++) {
+        float t = i / kSampleRate;
+        testInput[i] = 0.3f * sinf(2.0f * 3.14159265f * 110.0f * t)
+                       + 0.1f * sinf(2.0f * 3.14159265f * 1375.0f * t);
+    }
+
+    RunBenchmarks();
+
+    // Print now and again, for a monitor that connects late
+    for (;;) {
+        PrintTable();
+        hw.PrintLine("(one sample at 48 kHz is %lu cycles)",
+                     (unsigned long)(System::GetSysClkFreq() / (uint32_t)kSampleRate));
+        hw.PrintLine("");
+        System::Delay(10000);
+    }
+}